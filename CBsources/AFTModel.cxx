@@ -25,6 +25,7 @@
 
 #include "mymath.hxx"
 #include "AFTModel.hxx"
+#include "timer_registry.hxx"
 
 using namespace CH_Matrix_Classes;
 
@@ -44,7 +45,8 @@ namespace ConicBundle {
   const CH_Matrix_Classes::Matrix&
     AFTModel::generate_aft_cand(
       CH_Matrix_Classes::Integer cand_id,
-      const CH_Matrix_Classes::Matrix& cand_y
+      const CH_Matrix_Classes::Matrix& cand_y,
+      bool for_evaluation
     ) {
     //check if the point exists already as candidate for the current AFT
     if ((cand_id == data.cand_id) && (data.cand_mid == data.modification_id)) {
@@ -90,7 +92,11 @@ namespace ConicBundle {
     }
 
     data.cand_mid = data.modification_id;
-    return  aft->transform_argument(data.aft_cand, data.cand_offset, cand_y);
+    //the model of the function may evaluate it while the argument is computed
+    AFTBlockEvaluator* block_eval = 0;
+    if ((for_evaluation) && (model) && (aft->get_fun_coeff() != 0.))
+      block_eval = cond_model_trafo()->get_aft_block_evaluator(data.cand_pid);
+    return  aft->transform_argument(data.aft_cand, data.cand_offset, cand_y, block_eval);
   }
 
   // *****************************************************************************
@@ -225,6 +231,7 @@ namespace ConicBundle {
     const Matrix& iny,
     Real nullstep_bound,
     Real relprec) {
+    CH_Tools::ScopedTimer scoped_timer("AFTModel::eval_function");
     if (cb_out(10)) {
       get_out() << "\n  entering  AFTModel::eval_function" << std::endl;
     }
@@ -236,7 +243,7 @@ namespace ConicBundle {
       data.dim = iny.dim();
     assert(data.dim == iny.dim());
 
-    const Matrix& cand_y = generate_aft_cand(y_id, iny);
+    const Matrix& cand_y = generate_aft_cand(y_id, iny, true);
 
     if ((aft->get_fun_coeff() == 0.) || (model == 0)) {
       //trivial solution, don't do the recursive call
@@ -352,6 +359,7 @@ namespace ConicBundle {
     Integer y_id,
     const Matrix& iny,
     Real relprec) {
+    CH_Tools::ScopedTimer scoped_timer("AFTModel::eval_model");
     if (cb_out(10)) {
       get_out() << "\n  entering  AFTModel::eval_model" << std::endl;
     }
@@ -419,6 +427,7 @@ namespace ConicBundle {
     const Matrix& iny,
     Real model_maxviol,
     BundleProxObject& H) {
+    CH_Tools::ScopedTimer scoped_timer("AFTModel::update_model");
     if (cb_out(10)) {
       get_out() << "\n  entering  AFTModel::update_model" << std::endl;
     }
@@ -522,6 +531,7 @@ namespace ConicBundle {
     BundleProxObject& H,
     Real& model_deviation,
     Real& model_curvature) {
+    CH_Tools::ScopedTimer scoped_timer("AFTModel::update_model");
     if (cb_out(10)) {
       get_out() << "\n  entering  AFTModel::update_model" << std::endl;
     }
@@ -698,7 +708,7 @@ namespace ConicBundle {
       if (data.cand_ub_fid < 0) {
         new_cand_ub_fid = data.cand_ub_mid = data.cand_ub_fid = -1;
       }
-      data.function_id = max(-1, max(data.center_ub_fid, data.cand_ub_fid));
+      data.function_id = max(Integer(-1), max(data.center_ub_fid, data.cand_ub_fid));
       if (data.aggregate_fid < 0) {
         data.aggregate_available = false;
         new_aggregate_id = data.aggregate_fid = -1;
@@ -847,7 +857,7 @@ namespace ConicBundle {
     }
 
 
-    const Matrix& my_y = generate_aft_cand(center_id, center_y);
+    const Matrix& my_y = generate_aft_cand(center_id, center_y, true);
 
     Real ub = CB_minus_infinity;
     Integer ub_fid = -1;
@@ -1195,6 +1205,7 @@ namespace ConicBundle {
     Real weightu,
     Real model_maxviol,
     const Indexmatrix* indices) {
+    CH_Tools::ScopedTimer scoped_timer("AFTModel::add_variable_metric");
     if ((!H.employ_variable_metric()) || (!H.get_use_local_metric())) {
       if (SumBlockModel::add_variable_metric(H, center_id, center_y, descent_step, weightu,
         model_maxviol, indices)) {
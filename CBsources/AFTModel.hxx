@@ -138,11 +138,18 @@ namespace ConicBundle {
         case @a data.aft_cand is initialized to dimension zero and a
         reference is returned to the input point @a cand_y itself.
 
+        If @a for_evaluation is true (in eval_function() and
+        recompute_center()) and the transformation is computed, the
+        model of the function is asked for an AFTBlockEvaluator that
+        evaluates the function together with the transformation, see
+        SumBlockModel::get_aft_block_evaluator().
+
      */
     const CH_Matrix_Classes::Matrix&
       generate_aft_cand(
         CH_Matrix_Classes::Integer cand_id,
-        const CH_Matrix_Classes::Matrix& cand_y
+        const CH_Matrix_Classes::Matrix& cand_y,
+        bool for_evaluation = false
       );
 
     /** @brief if a call to some function evaluation returned an increased function_id, this increases data.modification_id
@@ -239,20 +239,20 @@ namespace ConicBundle {
 
      /// returns the number of variables before modification
     int get_old_vardim() const {
-      return mdf.old_vardim();
+      return int(mdf.old_vardim());
     }
     /// returns the number of variables once all stored modifications have been performed
     int get_new_vardim() const {
-      return mdf.new_vardim();
+      return int(mdf.new_vardim());
     }
     /// returns the number of variables that are appended (due to later reassignmentds they may no longer be located at the end)
     int get_appended_vardim() const {
-      return mdf.appended_vardim();
+      return int(mdf.appended_vardim());
     }
 
     /// returns null if there are no index changes, otherwise the Indexmatrix pointed to is a vector whose i-th entry holds the old index of the new i-th variable (injective!), index values exceeding old_vardim() refer to newly appended variables  
     const int* get_map_to_old_variables() const {
-      return (mdf.map_to_old_variables()) == 0 ? 0 : (const int*)(mdf.map_to_old_variables()->get_store());
+      return mdf.int_map_to_old_variables();
     }
 
     /// incorporate the OracleModification @a m (it should only contain variable changes, but this is not checked!) into this one; calls Modification::incorporate
@@ -23,13 +23,164 @@
 
 
 #include <set>
+#include <algorithm>
 #include "AffineFunctionTransformation.hxx"
+#include "thread_placement.hxx"
+#include "thread_pool.hxx"
 
 
 using namespace CH_Matrix_Classes;
 
 namespace ConicBundle {
 
+  const Integer AffineFunctionTransformation::min_nz_rowwise;
+  const Integer AffineFunctionTransformation::min_nz_per_thread;
+
+  // *****************************************************************************
+  //                           aft_trafo_rows
+  // *****************************************************************************
+
+  // computes out(i)=base(i)+A(i,:)*y for the nonzero rows kbegin..kend-1 of
+  // the row representation of A (rowinfo is nrows by 3: index, #nonzeros, start)
+
+  static void aft_trafo_rows(Integer kbegin, Integer kend, Integer nrows,
+    const Integer* rowinfo, const Integer* rowindex, const Real* rowval,
+    const Real* y, const Real* base, Real* out) {
+    const Integer* rip = rowinfo + kbegin;
+    const Integer* nzp = rip + nrows;
+    const Integer* stp = nzp + nrows;
+    for (Integer k = kend - kbegin; --k >= 0;) {
+      Integer i = *rip++;
+      const Integer* ip = rowindex + *stp;
+      const Real* vp = rowval + *stp++;
+      Real d = (base) ? base[i] : 0.;
+      for (Integer j = *nzp++; --j >= 0;)
+        d += (*vp++) * y[*ip++];
+      out[i] = d;
+    }
+  }
+
+  // *****************************************************************************
+  //                           trafo_rows
+  // *****************************************************************************
+
+  void AffineFunctionTransformation::trafo_rows(Matrix& out_y,
+    const Matrix& in_y,
+    const Matrix* base) const {
+    assert(arg_trafo);
+    assert(out_y.rowdim() == arg_trafo->rowdim());
+    assert(in_y.rowdim() == arg_trafo->coldim());
+    const Indexmatrix& rowinfo = arg_trafo->get_rowinfo();
+    Integer nrows = rowinfo.rowdim();
+    Integer nz = arg_trafo->nonzeros();
+    const Integer* rip = rowinfo.get_store();
+    const Integer* rowindex = arg_trafo->get_rowindex().get_store();
+    const Real* rowval = arg_trafo->get_rowval().get_store();
+    const Real* yp = in_y.get_store();
+    const Real* bp = (base) ? base->get_store() : 0;
+    Real* op = out_y.get_store();
+
+    Integer nt = n_threads;
+    if (nt <= 0)
+      nt = Integer(CH_Tools::ThreadPlacement::n_processors());
+    nt = max(Integer(1), min(nt, nz / min_nz_per_thread));
+    if (nt == 1) {
+      aft_trafo_rows(0, nrows, nrows, rip, rowindex, rowval, yp, bp, op);
+      return;
+    }
+
+    //split the nonzero rows into nt blocks with roughly nz/nt nonzeros each
+    std::vector<Integer> kstart(std::size_t(nt + 1), nrows);
+    kstart[0] = 0;
+    const Integer* stp = rip + 2 * nrows;
+    for (Integer t = 1; t < nt; t++) {
+      Integer target = (nz / nt) * t;
+      kstart[std::size_t(t)] = Integer(std::lower_bound(stp + kstart[std::size_t(t - 1)], stp + nrows, target) - stp);
+    }
+    CH_Tools::ThreadPool::run(int(nt), [&kstart, nrows, rip, rowindex, rowval, yp, bp, op](int t) {
+      aft_trafo_rows(kstart[std::size_t(t)], kstart[std::size_t(t + 1)], nrows, rip, rowindex, rowval, yp, bp, op);
+    });
+  }
+
+  // *****************************************************************************
+  //                           trafo_blocks
+  // *****************************************************************************
+
+  int AffineFunctionTransformation::trafo_blocks(Matrix& out_y,
+    const Matrix& in_y,
+    const Matrix* base,
+    AFTBlockEvaluator& block_eval) const {
+    assert(arg_trafo);
+    assert(in_y.rowdim() == arg_trafo->coldim());
+    const Integer dim = arg_trafo->rowdim();
+    const Indexmatrix& rowinfo = arg_trafo->get_rowinfo();
+    Integer nrows = rowinfo.rowdim();
+    Integer nz = arg_trafo->nonzeros();
+    const Integer* rip = rowinfo.get_store();
+    const Integer* stp = rip + 2 * nrows;
+
+    //block b holds the nonzero rows kstart[b],...,kstart[b+1]-1 and the
+    //coordinates istart[b],...,istart[b+1]-1; the boundaries are the first
+    //nonzero rows with at least b*block_size coordinates plus nonzeros before them
+    Integer nblocks = max(Integer(1), (dim + nz) / block_size);
+    std::vector<Integer> kstart(std::size_t(nblocks + 1), nrows);
+    std::vector<Integer> istart(std::size_t(nblocks + 1), dim);
+    kstart[0] = 0;
+    istart[0] = 0;
+    for (Integer b = 1; b < nblocks; b++) {
+      Integer target = ((dim + nz) / nblocks) * b;
+      Integer lo = kstart[std::size_t(b - 1)];
+      Integer hi = nrows;
+      while (lo < hi) {
+        Integer mid = lo + (hi - lo) / 2;
+        if (rip[mid] + stp[mid] < target)
+          lo = mid + 1;
+        else
+          hi = mid;
+      }
+      kstart[std::size_t(b)] = lo;
+      istart[std::size_t(b)] = (lo < nrows) ? rip[lo] : dim;
+    }
+
+    if (block_eval.start_blocks(dim, nblocks))
+      return 1;
+
+    out_y.newsize(dim, 1); chk_set_init(out_y, 1);
+    const Integer* rowindex = arg_trafo->get_rowindex().get_store();
+    const Real* rowval = arg_trafo->get_rowval().get_store();
+    const Real* yp = in_y.get_store();
+    const Real* bp = (base) ? base->get_store() : 0;
+    Real* op = out_y.get_store();
+    AFTBlockEvaluator* bev = &block_eval;
+
+    auto do_block = [&kstart, &istart, nrows, rip, rowindex, rowval, yp, bp, op, bev](Integer b) {
+      Integer ibegin = istart[std::size_t(b)];
+      Integer iend = istart[std::size_t(b + 1)];
+      if (bp)
+        mat_xey(iend - ibegin, op + ibegin, bp + ibegin);
+      else
+        mat_xea(iend - ibegin, op + ibegin, 0.);
+      aft_trafo_rows(kstart[std::size_t(b)], kstart[std::size_t(b + 1)], nrows, rip, rowindex, rowval, yp, bp, op);
+      bev->evaluate_block(b, ibegin, iend, op + ibegin);
+    };
+
+    Integer nt = n_threads;
+    if (nt <= 0)
+      nt = Integer(CH_Tools::ThreadPlacement::n_processors());
+    nt = max(Integer(1), min(nt, nblocks));
+    if (nt == 1) {
+      for (Integer b = 0; b < nblocks; b++)
+        do_block(b);
+      return 0;
+    }
+    //task t gets the consecutive blocks (t*nblocks)/nt,...,((t+1)*nblocks)/nt-1
+    CH_Tools::ThreadPool::run(int(nt), [&do_block, nblocks, nt](int t) {
+      for (Integer b = (Integer(t) * nblocks) / nt; b < ((Integer(t) + 1) * nblocks) / nt; b++)
+        do_block(b);
+    });
+    return 0;
+  }
+
   // *****************************************************************************
   //                           ~AffineFunctionTransformation()
   // *****************************************************************************
@@ -100,10 +251,14 @@ namespace ConicBundle {
     arg_offset = in_arg_offset;
     arg_trafo = in_arg_trafo;
     model_calls_delete = in_model_calls_delete;
+    //transform_argument() and the transformation of minorants work on the
+    //rows, so build them now rather than within the first evaluation
+    if ((arg_trafo) && (arg_trafo->get_lazy_rowrep()))
+      arg_trafo->set_lazy_rowrep(false);
 
     Minorant* mnrt = new Minorant(true, fun_offset);
     if (linear_cost) {
-      mnrt->add_coeffs(linear_cost->dim(), linear_cost->get_store());
+      mnrt->add_coeffs(int(linear_cost->dim()), linear_cost->get_store());
       //mnrt->sparsify(1e-12*norm2(*linear_cost));
     }
     constant_minorant.init(mnrt, 0);
@@ -201,7 +356,8 @@ namespace ConicBundle {
   const Matrix&
     AffineFunctionTransformation::transform_argument(Matrix& out_y,
       Real& offset,
-      const Matrix& in_y) const {
+      const Matrix& in_y,
+      AFTBlockEvaluator* block_eval) const {
     offset = fun_offset;
     if (linear_cost)
       offset += ip(*linear_cost, in_y);
@@ -218,6 +374,23 @@ namespace ConicBundle {
       return out_y;
     }
 
+    if ((block_eval) && (trafo_blocks(out_y, in_y, arg_offset, *block_eval) == 0))
+      return out_y;
+
+    if (arg_trafo->nonzeros() >= min_nz_rowwise) {
+      //rows without nonzeros keep the offset, all others are overwritten
+      if ((out_y.rowdim() != arg_trafo->rowdim()) ||
+        (out_y.coldim() != 1) ||
+        (!sparse_argument_changes())) {
+        if (arg_offset)
+          out_y.init(*arg_offset);
+        else
+          out_y.init(arg_trafo->rowdim(), 1, 0.);
+      }
+      trafo_rows(out_y, in_y, arg_offset);
+      return out_y;
+    }
+
     if ((out_y.rowdim() == arg_trafo->rowdim()) &&
       (out_y.coldim() == 1) &&
       (sparse_argument_changes())) {
@@ -557,7 +730,7 @@ namespace ConicBundle {
         if (linear_cost) {
           *linear_cost = linear_cost->rows(*(gsmdf.map_to_old_variables()));
           Minorant* mnrt = new Minorant(true, fun_offset);
-          mnrt->add_coeffs(linear_cost->dim(), linear_cost->get_store());
+          mnrt->add_coeffs(int(linear_cost->dim()), linear_cost->get_store());
           //mnrt->sparsify(1e-12*norm2(*linear_cost));
           constant_minorant.init(mnrt, 0);
         }
@@ -595,7 +768,7 @@ namespace ConicBundle {
     aftmdf->apply_to_costs(linear_cost);
     Minorant* mnrt = new Minorant(true, fun_offset);
     if (linear_cost) {
-      mnrt->add_coeffs(linear_cost->dim(), linear_cost->get_store());
+      mnrt->add_coeffs(int(linear_cost->dim()), linear_cost->get_store());
       //mnrt->sparsify(1e-12*norm2(*linear_cost));
     }
     constant_minorant.init(mnrt, 0);
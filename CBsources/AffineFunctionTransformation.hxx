@@ -47,6 +47,39 @@ namespace ConicBundle {
   //@{
 
 
+  //-----------------------------------------------------------------------------
+  //                                AFTBlockEvaluator
+  //-----------------------------------------------------------------------------
+
+  /** @brief evaluates a function on blocks of coordinates of its argument while an AffineFunctionTransformation computes this argument, see AffineFunctionTransformation::transform_argument()
+
+      The transformed argument is computed in blocks of consecutive
+      coordinates. Right after the coordinates of a block are known,
+      the thread that computed them calls evaluate_block() for this
+      block, so the function is evaluated while they are still in
+      cache and no second pass over the argument is needed. The blocks
+      only depend on the transformation, not on the number of threads,
+      so an evaluator that combines the results of the blocks in their
+      order gets the same result for any number of threads.
+  */
+  class AFTBlockEvaluator {
+  public:
+    ///
+    virtual ~AFTBlockEvaluator() {
+    }
+
+    /// called before the first block with the dimension of the transformed argument and the number of blocks; if it returns nonzero, evaluate_block() is not called
+    virtual int start_blocks(CH_Matrix_Classes::Integer dim,
+      CH_Matrix_Classes::Integer n_blocks) = 0;
+
+    /// called once for each block 0<=@a block<n_blocks with the coordinates begin,...,end-1 of the transformed argument (@a y points to coordinate @a begin); different blocks may be evaluated concurrently
+    virtual void evaluate_block(CH_Matrix_Classes::Integer block,
+      CH_Matrix_Classes::Integer begin,
+      CH_Matrix_Classes::Integer end,
+      const CH_Matrix_Classes::Real* y) = 0;
+  };
+
+
   //-----------------------------------------------------------------------------
   //                                AffineFunctionTransformation
   //-----------------------------------------------------------------------------
@@ -73,7 +106,10 @@ namespace ConicBundle {
       If (some of) the pointers to matrices are specified, ownership of the
       matrix objects pointed to will be taken over by the
       AFT and the objects will be deleted by this class
-      at the end of their use.
+      at the end of their use. The AFT works on the rows of @a arg_trafo,
+      so if it was set to build its row representation on demand (see
+      CH_Matrix_Classes::Sparsemat::set_lazy_rowrep()), init() switches
+      this off and builds the rows right away.
 
       Note, if @a arg_offset and @a arg_trafo are both zero, then the argument
       does not change at all. If all three matrix pointers are zero, there is no
@@ -89,6 +125,14 @@ namespace ConicBundle {
   */
 
   class AffineFunctionTransformation : public CBout, public FunctionObject {
+  public:
+    /// for arg_trafo with at least this many nonzeros transform_argument() uses the row wise (multithreaded) product
+    static const CH_Matrix_Classes::Integer min_nz_rowwise = 100000;
+    /// when computing rows in parallel, each thread gets at least this many nonzeros
+    static const CH_Matrix_Classes::Integer min_nz_per_thread = 50000;
+    /// for an AFTBlockEvaluator the transformed argument is computed in blocks of about this many coordinates plus nonzeros of arg_trafo
+    static const CH_Matrix_Classes::Integer block_size = 50000;
+
   private:
     CH_Matrix_Classes::Real fun_coeff; ///< function value is multiplied by this 
     CH_Matrix_Classes::Real fun_offset;  ///< constant added in the end 
@@ -102,6 +146,19 @@ namespace ConicBundle {
 
     bool model_calls_delete; ///< tells the model whether it should delete this at the end of its use or just leave it alone (i.e., this AFT is then owned by someone else)
 
+    CH_Matrix_Classes::Integer n_threads; ///< maximum number of tasks used in transform_argument(), 0 uses the number of available processors
+
+    /// computes out_y(i)=base(i)+arg_trafo(i,:)*in_y (base==0 means zero) for the nonzero rows i of arg_trafo; the rows are partitioned by their nonzeros into at most n_threads tasks for CH_Tools::ThreadPool
+    void trafo_rows(CH_Matrix_Classes::Matrix& out_y,
+      const CH_Matrix_Classes::Matrix& in_y,
+      const CH_Matrix_Classes::Matrix* base) const;
+
+    /// computes out_y=base+arg_trafo*in_y (base==0 means zero) in blocks of consecutive coordinates and passes each block to @a block_eval right after it is computed; returns nonzero if block_eval->start_blocks() refused and nothing was computed
+    int trafo_blocks(CH_Matrix_Classes::Matrix& out_y,
+      const CH_Matrix_Classes::Matrix& in_y,
+      const CH_Matrix_Classes::Matrix* base,
+      AFTBlockEvaluator& block_eval) const;
+
   public:
     /// sets the parameters of the transformation. The ownership of objects pointed to is passed to *this (they will be deleted here). If *this is entered into an AFTModel, model_calls_delete==true tells the AFTModel to delete this AffineFunctionTransformation at the end.  
     virtual int init(CH_Matrix_Classes::Real fun_coeff = 1.,
@@ -119,7 +176,7 @@ namespace ConicBundle {
       CH_Matrix_Classes::Sparsemat* in_arg_trafo = 0,
       bool in_model_calls_delete = true,
       CBout* cbo = 0, int incr = -1) :
-      CBout(cbo, incr), linear_cost(0), arg_offset(0), arg_trafo(0) {
+      CBout(cbo, incr), linear_cost(0), arg_offset(0), arg_trafo(0), n_threads(0) {
       init(in_fun_coeff, in_fun_offset, in_linear_cost, in_arg_offset, in_arg_trafo, in_model_calls_delete);
     }
 
@@ -136,6 +193,24 @@ namespace ConicBundle {
       model_calls_delete = mcd;
     }
 
+    /** @brief set the maximum number of threads for transforming the argument (0 for the number of available processors, default 0)
+
+        If arg_trafo has sufficiently many nonzeros (see transform_argument()),
+        its rows are split into blocks of roughly equal numbers of nonzeros
+        and each block is computed by one of the persistent workers of
+        CH_Tools::ThreadPool (the first one by the calling thread), so no
+        threads are started per call. The result does not depend on the
+        number of threads.
+    */
+    void set_n_threads(CH_Matrix_Classes::Integer nt) {
+      n_threads = (nt < 0) ? 0 : nt;
+    }
+
+    /// returns the number of threads set (0 for the number of available processors)
+    CH_Matrix_Classes::Integer get_n_threads() const {
+      return n_threads;
+    }
+
     /// returns true if not the identity
     bool argument_changes() const {
       if ((arg_offset != 0) || (arg_trafo != 0)) return true; return false;
@@ -249,11 +324,27 @@ namespace ConicBundle {
         the value needed in objective_value() together with the result of the
         evaluation of the function for @a transformed_y in order to compute
         the transformed objective value.
+
+        If arg_trafo has at least AffineFunctionTransformation::min_nz_rowwise
+        nonzeros, the product is computed row by row and distributed over
+        up to get_n_threads() threads, see set_n_threads().
+
+        If @a block_eval is not NULL and arg_trafo is not the identity,
+        @a transformed_y is computed in blocks of consecutive coordinates
+        with about AffineFunctionTransformation::block_size coordinates
+        plus nonzeros each (a block starts with a row that has nonzeros).
+        The blocks are distributed over up to get_n_threads() threads,
+        and each block is passed to @a block_eval as soon as it is
+        computed (see AFTBlockEvaluator), so the function can be
+        evaluated together with the product. If @a block_eval is NULL or
+        refuses the blocks, or if arg_trafo is the identity, it is not
+        called and the argument is computed as before.
     */
     const CH_Matrix_Classes::Matrix&
       transform_argument(CH_Matrix_Classes::Matrix& transformed_y,
         CH_Matrix_Classes::Real& transformed_offset,
-        const CH_Matrix_Classes::Matrix& input_y) const;
+        const CH_Matrix_Classes::Matrix& input_y,
+        AFTBlockEvaluator* block_eval = 0) const;
 
 
     /** @brief given the modification aftmdf or if 0, gsmdf, compute the
@@ -27,6 +27,7 @@
 #include "mymath.hxx"
 #include "Bigmatrix.hxx"
 #include "sparssym.hxx"
+#include "timer_registry.hxx"
 
 
 using namespace CH_Matrix_Classes;
@@ -206,6 +207,8 @@ namespace ConicBundle {
 
 
   int Bigmatrix::lanczosmult(const Matrix& A, Matrix& B) const {
+    CH_Tools::ScopedTimer scoped_timer("Bigmatrix::lanczosmult");
+    CH_Tools::TimerRegistry::add_count("columns", A.coldim());
     assert(dim >= 0);
     assert(dim == A.rowdim());
     if (use_dense) {
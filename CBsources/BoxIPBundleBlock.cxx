@@ -420,13 +420,13 @@ namespace ConicBundle {
         if (scalub > 0) {
           s = scalub * .5;   //never mind what others want, no interaction
         } else {
-          s += (2 * vecdim + 1) * val;   //contribution to trace is now mu_dim*val
+          s += Real(2 * vecdim + 1) * val;   //contribution to trace is now mu_dim*val
         }
       } else {
         if (scalub > 0) {
           s = scalub * .5;  //never mind what others want, no interaction
         } else {
-          s = (2 * vecdim + 1) * val; //contribution to trace is now mu_dim*val
+          s = Real(2 * vecdim + 1) * val; //contribution to trace is now mu_dim*val
         }
       }
       x.init(lb, s * .5);
@@ -725,9 +725,9 @@ namespace ConicBundle {
     Real& ip_xz_dxdz,
     Real& ip_dxdz_xdzpdxz) const {
     assert(use_scaling || (ds == 0.));
-    const Real mu_xz = tr_xz / inmudim;
-    const Real mu_xdzpdxz = tr_xdzpdxz / inmudim;
-    const Real mu_dxdz = tr_dxdz / inmudim;
+    const Real mu_xz = tr_xz / Real(inmudim);
+    const Real mu_xdzpdxz = tr_xdzpdxz / Real(inmudim);
+    const Real mu_dxdz = tr_dxdz / Real(inmudim);
     const Real mu_at_one = mu_xz + mu_xdzpdxz + mu_dxdz;
 
     if (use_scaling) {
@@ -1598,9 +1598,9 @@ namespace ConicBundle {
       assert(trafotrace.rowdim() >= startindex_trace + vecdim);
       Real scaleval;
       Minorant* mp;
-      Integer nz;
+      int nz;
       const Real* coeffs;
-      const Integer* ind;
+      const int* ind;
       for (Integer i = 0; i < bundle_dim; i++) {
         Real xizinv = 1. / sqrt_xiz(i);
         globalbundle[unsigned(startindex_bundle + map_to_old(i))].get_scaleval_and_minorant(scaleval, mp);
@@ -1642,9 +1642,9 @@ namespace ConicBundle {
       assert(trafotrace.rowdim() >= startindex_trace + vecdim);
       Real scaleval;
       Minorant* mp;
-      Integer nz;
+      int nz;
       const Real* coeffs;
-      const Integer* ind;
+      const int* ind;
       for (Integer i = 0; i < bundle_dim - 1; i++) {
         Real xizinv = 1. / sqrt_xiz(i);
         globalbundle[unsigned(startindex_bundle + map_to_old(i))].get_scaleval_and_minorant(scaleval, mp);
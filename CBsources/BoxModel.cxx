@@ -27,6 +27,7 @@
 #include "BoxModel.hxx"
 #include "BoxModelParameters.hxx"
 #include "BundleIdProx.hxx"
+#include "timer_registry.hxx"
 
 using namespace CH_Tools;
 using namespace CH_Matrix_Classes;
@@ -47,6 +48,89 @@ namespace ConicBundle {
     nr_eval = 0;
     delete block;
     block = 0;
+    block_eval.set_data(0, 0, 0);
+    block_eval_id = -1;
+    block_eval_mid = -1;
+  }
+
+  // *****************************************************************************
+  //                            BoxBlockEvaluator
+  // *****************************************************************************
+
+  int BoxBlockEvaluator::start_blocks(Integer dim, Integer n_blocks) {
+    argument = 0;
+    if ((oracle == 0) || (dim != oracle->get_lower_bounds().rowdim()) || (dim != oracle->get_upper_bounds().rowdim()))
+      return 1;
+    decay = (old_switching->rowdim() == dim);
+    trace_switches = (decay) && (old_boxvec->dim() == dim);
+    boxvec.newsize(dim, 1); chk_set_init(boxvec, 1);
+    switching.newsize(dim, 1); chk_set_init(switching, 1);
+    ind.resize(std::size_t(dim));
+    blockval.init(n_blocks, 1, 0.);
+    blockbegin.init(n_blocks, 1, Integer(0));
+    blocknz.init(n_blocks, 1, Integer(-1));
+    return 0;
+  }
+
+  void BoxBlockEvaluator::evaluate_block(Integer block, Integer begin, Integer end, const Real* y) {
+    const Real* lp = oracle->get_lower_bounds().get_store() + begin;
+    const Real* up = oracle->get_upper_bounds().get_store() + begin;
+    Real* bp = boxvec.get_store() + begin;
+    Real* sp = switching.get_store() + begin;
+    int* ip = ind.data() + begin;
+    Real val = 0.;
+    if (trace_switches) {
+      const Real* obp = old_boxvec->get_store() + begin;
+      const Real* osp = old_switching->get_store() + begin;
+      for (Integer i = begin; i < end; i++, lp++, up++) {
+        Real d = (*y < 0) ? *lp : *up;
+        val += d * (*y++);
+        *bp++ = d;
+        *sp++ = .9 * (*osp++) + (((*obp++) != d) ? 1. : 0.);
+        if (d != 0.)
+          *ip++ = int(i);
+      }
+    } else {
+      const Real* osp = (decay) ? old_switching->get_store() + begin : 0;
+      for (Integer i = begin; i < end; i++, lp++, up++) {
+        Real d = (*y < 0) ? *lp : *up;
+        val += d * (*y++);
+        *bp++ = d;
+        *sp++ = (osp) ? .9 * (*osp++) : 0.;
+        if (d != 0.)
+          *ip++ = int(i);
+      }
+    }
+    blockval(block) = val;
+    blockbegin(block) = begin;
+    blocknz(block) = Integer(ip - ind.data()) - begin;
+    if (block == 0)
+      argument = y - end;
+  }
+
+  int BoxBlockEvaluator::get_result(const Matrix& y,
+    Real& val,
+    Integer& nz,
+    Matrix& cand_boxvec,
+    Matrix& coord_switching,
+    std::vector<int>& cand_ind) {
+    if ((argument == 0) || (argument != y.get_store()) || (y.dim() != boxvec.dim()) || (min(blocknz) < 0)) {
+      argument = 0;
+      return 1;
+    }
+    argument = 0;
+    val = sum(blockval);
+    nz = sum(blocknz);
+    swap(cand_boxvec, boxvec);
+    swap(coord_switching, switching);
+    cand_ind.clear();
+    if (2 * nz <= y.dim()) {
+      for (Integer b = 0; b < blocknz.dim(); b++) {
+        const int* ip = ind.data() + blockbegin(b);
+        cand_ind.insert(cand_ind.end(), ip, ip + blocknz(b));
+      }
+    }
+    return 0;
   }
 
   // *****************************************************************************
@@ -191,6 +275,7 @@ namespace ConicBundle {
     const Matrix& y,
     Real nullstep_bound,
     Real relprec) {
+    CH_Tools::ScopedTimer scoped_timer("BoxModel::evaluate_oracle");
     assert(relprec > 0.);
 
     CH_Tools::Microseconds start_eval = clock.time();
@@ -233,56 +318,79 @@ namespace ConicBundle {
     Matrix& cand_boxvec = data.cand_boxvec;
     Matrix& coord_switching = data.coord_switching;
 
-    bool trace_switches = true;
-    if (coord_switching.rowdim() != dim) {
-      coord_switching.init(dim, 1, 0.);
-      trace_switches = false;
-    } else {
-      coord_switching *= .9;
-    }
+    //if the box was evaluated while the AFT computed y, only the results are collected
+    Real val = 0;
+    Integer nz = 0;
+    bool block_eval_used = ((block_eval_id == y_id) && (block_eval_mid == data.get_modification_id()) &&
+      (block_eval.get_result(y, val, nz, cand_boxvec, coord_switching, cand_ind) == 0));
+    block_eval_id = -1;
+
+    if (!block_eval_used) {
+      bool trace_switches = true;
+      if (coord_switching.rowdim() != dim) {
+        coord_switching.init(dim, 1, 0.);
+        trace_switches = false;
+      } else {
+        coord_switching *= .9;
+      }
 
-    if (cand_boxvec.dim() != dim) {
-      cand_boxvec.init(olb);
-      trace_switches = false;
-    }
+      if (cand_boxvec.dim() != dim) {
+        cand_boxvec.init(olb);
+        trace_switches = false;
+      }
 
-    Real val = 0;
-    if (trace_switches) {
-      for (Integer i = 0; i < dim; i++) {
-        if (y(i) < 0) {
-          Real d = olb(i);
-          val += d * y(i);
-          if (cand_boxvec(i) != d) {
-            cand_boxvec(i) = d;
-            coord_switching(i) += 1.;
+      if (trace_switches) {
+        for (Integer i = 0; i < dim; i++) {
+          if (y(i) < 0) {
+            Real d = olb(i);
+            val += d * y(i);
+            if (cand_boxvec(i) != d) {
+              cand_boxvec(i) = d;
+              coord_switching(i) += 1.;
+            }
+          } else {
+            Real d = oub(i);
+            val += d * y(i);
+            if (cand_boxvec(i) != d) {
+              cand_boxvec(i) = d;
+              coord_switching(i) += 1.;
+            }
           }
-        } else {
-          Real d = oub(i);
-          val += d * y(i);
-          if (cand_boxvec(i) != d) {
+        }
+      } else {
+        for (Integer i = 0; i < dim; i++) {
+          if (y(i) < 0) {
+            Real d = olb(i);
+            val += d * y(i);
+            cand_boxvec(i) = d;
+          } else {
+            Real d = oub(i);
+            val += d * y(i);
             cand_boxvec(i) = d;
-            coord_switching(i) += 1.;
           }
         }
       }
-    } else {
-      for (Integer i = 0; i < dim; i++) {
-        if (y(i) < 0) {
-          Real d = olb(i);
-          val += d * y(i);
-          cand_boxvec(i) = d;
-        } else {
-          Real d = oub(i);
-          val += d * y(i);
-          cand_boxvec(i) = d;
-        }
+
+      //if at most half of the coordinates are nonzero, the minorant is stored sparsely
+      cand_ind.clear();
+      for (Integer i = 0; (i < dim) && (2 * Integer(cand_ind.size()) <= dim); i++) {
+        if (cand_boxvec(i) != 0.)
+          cand_ind.push_back(int(i));
       }
+      nz = Integer(cand_ind.size());
     }
 
     data.cand_ub_mid = data.get_modification_id();
     data.cand_ub = val;
     data.cand_relprec = relprec;
-    data.cand_minorant = MinorantPointer(new MatrixMinorant(0, cand_boxvec, 0, true), data.get_modification_id());
+    if (2 * nz > dim) {
+      data.cand_minorant = MinorantPointer(new MatrixMinorant(0, cand_boxvec, 0, true), data.get_modification_id());
+    } else {
+      cand_val.newsize(nz, 1); chk_set_init(cand_val, 1);
+      for (Integer k = 0; k < nz; k++)
+        cand_val(k) = cand_boxvec(cand_ind[std::size_t(k)]);
+      data.cand_minorant = MinorantPointer(new Minorant(true, 0., int(nz), cand_val.get_store(), cand_ind.data()), data.get_modification_id());
+    }
 
     eval_time += clock.time() - start_eval;
     start_eval = clock.time();
@@ -305,6 +413,17 @@ namespace ConicBundle {
     return (err > 0) ? err : ret_code;
   }
 
+  // *****************************************************************************
+  //                            get_aft_block_evaluator
+  // *****************************************************************************
+
+  AFTBlockEvaluator* BoxModel::get_aft_block_evaluator(Integer y_id) {
+    block_eval.set_data(oracle, &data.cand_boxvec, &data.coord_switching);
+    block_eval_id = y_id;
+    block_eval_mid = data.get_modification_id();
+    return &block_eval;
+  }
+
   // *****************************************************************************
   //                              evaluate_local_model
   // *****************************************************************************
@@ -27,7 +27,7 @@
 #define CONICBUNDLE_BOXMODEL_HXX
 
 /**  @file BoxModel.hxx
-    @brief Header declaring the class ConicBundle::BoxModel
+    @brief Header declaring the classes ConicBundle::BoxModel and ConicBundle::BoxBlockEvaluator
     @version 1.0
     @date 2014-07-23
     @author Christoph Helmberg
@@ -44,6 +44,62 @@ namespace ConicBundle {
   */
   //@{
 
+  /**@brief evaluates the support function of the box of a BoxOracle blockwise while an AffineFunctionTransformation computes its argument (see AFTBlockEvaluator); used by BoxModel
+
+     The maximizer over the box and the updated counts of switching
+     coordinates are computed into buffers of the evaluator, so the data
+     of BoxModel only changes if get_result() is called.
+   */
+
+  class BoxBlockEvaluator : public AFTBlockEvaluator {
+  private:
+    BoxOracle* oracle; ///< supplies the bounds
+    const CH_Matrix_Classes::Matrix* old_boxvec; ///< the maximizer of the previous evaluation
+    const CH_Matrix_Classes::Matrix* old_switching; ///< the switching counts of the previous evaluation
+    bool decay; ///< true if old_switching has the dimension of the argument and is multiplied by .9
+    bool trace_switches; ///< true if changes against old_boxvec are counted
+    const CH_Matrix_Classes::Real* argument; ///< the argument whose blocks were evaluated (set by block 0), NULL if there are none
+    CH_Matrix_Classes::Matrix boxvec; ///< the maximizer over the box
+    CH_Matrix_Classes::Matrix switching; ///< the updated switching counts
+    std::vector<int> ind; ///< the indices of the nonzeros of boxvec in a block start at the first coordinate of the block
+    CH_Matrix_Classes::Matrix blockval; ///< the part of the function value of each block
+    CH_Matrix_Classes::Indexmatrix blockbegin; ///< the first coordinate of each block
+    CH_Matrix_Classes::Indexmatrix blocknz; ///< the number of nonzeros of boxvec in each block, -1 if the block was not evaluated
+
+  public:
+    ///
+    BoxBlockEvaluator() : oracle(0), old_boxvec(0), old_switching(0), decay(false), trace_switches(false), argument(0) {
+    }
+
+    /// the oracle and the maximizer and switching counts of the previous evaluation; these must not change until get_result()
+    void set_data(BoxOracle* bo,
+      const CH_Matrix_Classes::Matrix* prev_boxvec,
+      const CH_Matrix_Classes::Matrix* prev_switching) {
+      oracle = bo;
+      old_boxvec = prev_boxvec;
+      old_switching = prev_switching;
+      argument = 0;
+    }
+
+    /// see AFTBlockEvaluator::start_blocks(); returns nonzero if no oracle is set or dim does not match its bounds
+    int start_blocks(CH_Matrix_Classes::Integer dim,
+      CH_Matrix_Classes::Integer n_blocks);
+
+    /// see AFTBlockEvaluator::evaluate_block()
+    void evaluate_block(CH_Matrix_Classes::Integer block,
+      CH_Matrix_Classes::Integer begin,
+      CH_Matrix_Classes::Integer end,
+      const CH_Matrix_Classes::Real* y);
+
+    /// if all blocks were evaluated for the argument @a y, this returns 0, the function value in @a val and the number of nonzeros of the maximizer in @a nz, swaps the maximizer into @a cand_boxvec and the switching counts into @a coord_switching and, if 2*nz<=y.dim(), stores the indices of the nonzeros in @a cand_ind; otherwise it returns 1 and nothing is changed; the blocks are used only once
+    int get_result(const CH_Matrix_Classes::Matrix& y,
+      CH_Matrix_Classes::Real& val,
+      CH_Matrix_Classes::Integer& nz,
+      CH_Matrix_Classes::Matrix& cand_boxvec,
+      CH_Matrix_Classes::Matrix& coord_switching,
+      std::vector<int>& cand_ind);
+  };
+
   /**@brief implements (as a derived class of ConeModel) a standard cutting plane model for a MatrixBoxOracle
    */
 
@@ -66,6 +122,20 @@ namespace ConicBundle {
     /// total number of oralce calls (to  MatrixBoxOracle::evaluate())
     CH_Matrix_Classes::Integer nr_eval;
 
+    //temporary variables of evaluate_oracle(), global only for memory management purposes
+    /// nonzero values of a sparse candidate minorant
+    CH_Matrix_Classes::Matrix cand_val;
+    /// indices of the nonzero values of a sparse candidate minorant
+    std::vector<int> cand_ind;
+
+    //--- evaluation together with the AFT, see get_aft_block_evaluator()
+    /// evaluates the box blockwise while the AFT computes its argument
+    BoxBlockEvaluator block_eval;
+    /// the point identifier the blocks are evaluated for (-1 if none)
+    CH_Matrix_Classes::Integer block_eval_id;
+    /// the modification id of data when the blocks were requested
+    CH_Matrix_Classes::Integer block_eval_mid;
+
     //--- augmented model solver
     /// describes the feasible convex combinations of the bundle vectors
     QPConeModelDataObject* block;
@@ -204,6 +274,9 @@ namespace ConicBundle {
       return oracle;
     }
 
+    /// see SumBlockModel::get_aft_block_evaluator()
+    AFTBlockEvaluator* get_aft_block_evaluator(CH_Matrix_Classes::Integer y_id);
+
     //start_augmodel   //as in ConeModel
 
     // make_model_aggregate         //as in ConeModel
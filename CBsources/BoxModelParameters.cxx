@@ -97,7 +97,8 @@ namespace ConicBundle {
         continue;
       }
       box_coords.concat_below(ind);
-      box_model.push_back(MinorantPointer(new Minorant(true, 0., 1, &val, &ind, 1., 0), modification_id));
+      int iind = int(ind);
+      box_model.push_back(MinorantPointer(new Minorant(true, 0., 1, &val, &iind, 1., 0), modification_id));
       box_coeff.concat_below(box_complvalues(ind) * aggr_scaleval);
       box_complvalues(ind) = 0.;
       i++;
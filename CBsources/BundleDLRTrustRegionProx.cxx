@@ -126,7 +126,7 @@ namespace ConicBundle {
     //compute the SVD
     Symmatrix S;
     rankadd(vecH, S, 1., 0., 1);
-    int retval = S.eig(indLinvHt, Dinv, false);
+    int retval = int(S.eig(indLinvHt, Dinv, false));
     if (retval) {
       if (cb_out())
         get_out() << "**** WARNING: BundleDLRTrustRegionProx::clean(...): S.eig failed and returned " << retval << " (order=" << S.rowdim() << ")" << std::endl;
@@ -169,7 +169,7 @@ namespace ConicBundle {
     //assert column vector
     assert(in_D.coldim() == 1);
     //assert matching dimsions
-    assert(vecH.rowdim() == in_D.rowdim());
+    assert(in_vecH.rowdim() == in_D.rowdim());
 
     D = in_D;
     D += weightu;
@@ -621,7 +621,7 @@ namespace ConicBundle {
     }
 
 
-    max_columns = min(max(y.dim() / 5, 30), y.dim());
+    max_columns = min(max(y.dim() / 5, Integer(30)), y.dim());
     //max_columns=min(y.dim(),50);
     needs_cleaning = false;
 
@@ -117,7 +117,7 @@ namespace ConicBundle {
     void compute_corr()
       //{ corr_val=sum(D)+CH_Matrix_Classes::sqr(norm2(vecH))-weightu*D.dim(); if (corr_val>D.dim()) corr_val=D.dim()/corr_val; else corr_val=1.;}
     {
-      corr_val = CH_Matrix_Classes::min(1., D.rowdim() / (sum(D) + CH_Matrix_Classes::sqr(norm2(vecH))));
+      corr_val = CH_Matrix_Classes::min(1., CH_Matrix_Classes::Real(D.rowdim()) / (sum(D) + CH_Matrix_Classes::sqr(norm2(vecH))));
     }
 
   public:
@@ -153,6 +153,16 @@ namespace ConicBundle {
       return weightu;
     }
 
+    /// returns the diagonal part of H including weightu
+    const CH_Matrix_Classes::Matrix& get_D() const {
+      return D;
+    }
+
+    /// returns the low rank part of H, H=D+vecH*transpose(vecH)
+    const CH_Matrix_Classes::Matrix& get_vecH() const {
+      return vecH;
+    }
+
     ///returns a correction factor for termination precision if the quadratic term is strong
     CH_Matrix_Classes::Real get_term_corr() const {
       return corr_val;
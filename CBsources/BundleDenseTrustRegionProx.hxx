@@ -103,7 +103,7 @@ namespace ConicBundle {
     void compute_corr()
       //{ corr_val=trace(H); if (corr_val>H.rowdim()) corr_val=H.rowdim()/corr_val; else corr_val=1.;}
     {
-      corr_val = CH_Matrix_Classes::min(1., H.rowdim() / (H.rowdim() * weightu + trace(H)));
+      corr_val = CH_Matrix_Classes::min(1., CH_Matrix_Classes::Real(H.rowdim()) / (CH_Matrix_Classes::Real(H.rowdim()) * weightu + trace(H)));
     }
 
   public:
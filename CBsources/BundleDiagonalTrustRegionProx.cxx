@@ -466,7 +466,7 @@ namespace ConicBundle {
     old_D = D;
 
     if (cb_out(2)) {
-      get_out() << "\nBDTR(" << sum(D) / D.dim() << "," << max(D) << "," << min(D) << ")";
+      get_out() << "\nBDTR(" << sum(D) / Real(D.dim()) << "," << max(D) << "," << min(D) << ")";
     }
 
     //damping
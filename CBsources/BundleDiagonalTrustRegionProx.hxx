@@ -97,7 +97,7 @@ namespace ConicBundle {
     void compute_corr()
       //{ corr_val=sum(D)-weightu*D.dim(); if (corr_val>D.dim()) corr_val=D.dim()/corr_val; else corr_val=1.;}
     {
-      corr_val = CH_Matrix_Classes::min(1., D.rowdim() / sum(D));
+      corr_val = CH_Matrix_Classes::min(1., CH_Matrix_Classes::Real(D.rowdim()) / sum(D));
     }
 
   public:
@@ -73,7 +73,7 @@ namespace ConicBundle {
           weight = 1.;
         else {
           Real d = sqrt(norm2subg);
-          if (d < dim * 1e-10)
+          if (d < Real(dim) * 1e-10)
             weight = 1.;
           else
             weight = max(d, 1e-4);
@@ -384,7 +384,7 @@ namespace ConicBundle {
         valuelevels.concat_below(weightinc);
       }
       if (valuelevels.rowdim() >= 3) {
-        weight = min(10. * weight, weight + sum(valuelevels) / valuelevels.rowdim());
+        weight = min(10. * weight, weight + sum(valuelevels) / Real(valuelevels.rowdim()));
         if (maxweight > 0.)
           weight = min(weight, maxweight);
         valuelevels.init(0, 1, 0.);
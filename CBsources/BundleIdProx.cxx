@@ -61,11 +61,13 @@ namespace ConicBundle {
     Indexmatrix* yfixed) {
 
 
-    Indexmatrix ind(y.dim(), 1);
+    Indexmatrix& ind = _fixed_ind;
+    ind.newsize(y.dim(), 1);
     ind.init(0, 0, 0.);
-    Matrix val(y.dim(), 1);
+    Matrix& val = _fixed_val;
+    val.newsize(y.dim(), 1);
     val.init(0, 0, 0.);
-    Matrix _y(y.dim(), 1); chk_set_init(_y, 1);
+    _y.newsize(y.dim(), 1); chk_set_init(_y, 1);
     Integer ydim = 0;
     if (yfixed) {
       for (Integer i = 0; i < yfixed->dim(); i++) {
@@ -156,10 +158,9 @@ namespace ConicBundle {
 
     //Matrix _
     d = _c;
-    Matrix tmpvec;
-    tmpvec.init(_b, -1 / weightu);
-    tmpvec += _y;
-    genmult(_A, tmpvec, d, 1., 1., 1);
+    _tmpvec.init(_b, -1 / weightu);
+    _tmpvec += _y;
+    genmult(_A, _tmpvec, d, 1., 1., 1);
     //Real _
     offset = _delta - ip(_b, _b) / 2. / weightu + ip(_b, _y);
 
@@ -230,7 +231,8 @@ namespace ConicBundle {
     Integer xdim = Integer(bundle.size());
     delta_d.init(xdim, 1, 0.);
     delta_Q.init(xdim, 0.);
-    Matrix tmpvec(xdim, 1, 0.);
+    Matrix& tmpvec = _tmpvec;
+    tmpvec.init(xdim, 1, 0.);
     delta_offset = delta_subg.offset();
 
     //--- for each y_index that needs updating 
@@ -74,6 +74,12 @@ namespace ConicBundle {
     /// for storing the offset of the constant minorant
     CH_Matrix_Classes::Real _delta;
 
+    //temporary variables of compute_QP_costs() and update_QP_costs(), global only for memory management purposes
+    CH_Matrix_Classes::Indexmatrix _fixed_ind;
+    CH_Matrix_Classes::Matrix _fixed_val;
+    CH_Matrix_Classes::Matrix _y;
+    CH_Matrix_Classes::Matrix _tmpvec;
+
     // CH_Matrix_Classes::Symmatrix last_Q;  ///< for testing updates 
     //CH_Matrix_Classes::Matrix last_d;     ///< for testing updates
     // CH_Matrix_Classes::Real last_offset;  ///< for testing updates
@@ -78,12 +78,12 @@ namespace ConicBundle {
   void BundleLowRankTrustRegionProx::init(const CH_Matrix_Classes::Matrix& in_vecH,
     const CH_Matrix_Classes::Matrix& in_lamH) {
     //assert column vector
-    assert(lamH.coldim() == 1);
+    assert(in_lamH.coldim() == 1);
     //assert matching dimsions
-    assert(vecH.coldim() == lamH.rowdim());
+    assert(in_vecH.coldim() == in_lamH.rowdim());
     //assert "orthogonality indicator"
-    assert(norm2(transpose(vecH) * vecH - Diag(Matrix(vecH.coldim(), 1, 1.))) < 1e-6);
-    assert(std::fabs(ip(vecH, vecH) - vecH.coldim()) < 1e-10 * max(1, vecH.coldim()));
+    assert(norm2(transpose(in_vecH) * in_vecH - Diag(Matrix(in_vecH.coldim(), 1, 1.))) < 1e-6);
+    assert(std::fabs(ip(in_vecH, in_vecH) - in_vecH.coldim()) < 1e-10 * max(Integer(1), in_vecH.coldim()));
 
     vecH = in_vecH;
     lamH = in_lamH;
@@ -579,7 +579,7 @@ namespace ConicBundle {
     }
 
 
-    max_columns = min(max(y.dim() / 5, 30), y.dim());
+    max_columns = min(max(y.dim() / 5, Integer(30)), y.dim());
     needs_cleaning = false;
 
     int err = 0;
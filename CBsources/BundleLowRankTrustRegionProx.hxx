@@ -122,7 +122,7 @@ namespace ConicBundle {
     void compute_corr()
       //{ corr_val=sum(lamH); if ((vecH.rowdim()>0)&&(corr_val>vecH.rowdim())) corr_val=vecH.rowdim()/corr_val; else corr_val=1.;}
     {
-      corr_val = CH_Matrix_Classes::min(1., vecH.rowdim() / (weightu * vecH.rowdim() + sum(lamH)));
+      corr_val = CH_Matrix_Classes::min(1., CH_Matrix_Classes::Real(vecH.rowdim()) / (weightu * CH_Matrix_Classes::Real(vecH.rowdim()) + sum(lamH)));
     }
 
   public:
@@ -159,6 +159,16 @@ namespace ConicBundle {
       return weightu;
     }
 
+    /// returns the orthonormal columns of the low rank representation
+    const CH_Matrix_Classes::Matrix& get_vecH() const {
+      return vecH;
+    }
+
+    /// returns the positive scalars of the low rank representation
+    const CH_Matrix_Classes::Matrix& get_lamH() const {
+      return lamH;
+    }
+
     ///returns a correction factor for termination precision if the quadratic term is strong
     CH_Matrix_Classes::Real get_term_corr() const {
       return corr_val;
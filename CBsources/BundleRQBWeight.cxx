@@ -107,7 +107,7 @@ namespace ConicBundle {
           weight = 1.;
         else {
           Real d = sqrt(norm2subg);
-          if (d < dim * 1e-10)
+          if (d < Real(dim) * 1e-10)
             weight = 1.;
           else
             weight = max(d, 1e-4);
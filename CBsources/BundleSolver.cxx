@@ -40,6 +40,7 @@
 #include "BundleDenseTrustRegionProx.hxx"
 #include "UQPSolver.hxx"
 #include "VariableMetricSVDSelection.hxx"
+#include "timer_registry.hxx"
 
 using namespace CH_Matrix_Classes;
 
@@ -172,6 +173,8 @@ namespace ConicBundle {
     center_relprec = 1e-3;
     center_gid = -1;
     center_gs_val = 0.;
+    old_center_y.init(0, 1, 0.);
+    old_center_y_id = -1;
 
     cand_id = -1;
     cand_y.init(0, 1, 0.);
@@ -479,7 +482,7 @@ namespace ConicBundle {
 
     if (ychanged)
       center_gid = -1;
-    int old_center_gid = center_gid;
+    Integer old_center_gid = center_gid;
     int status = groundset->ensure_feasibility(center_gid, center_y, ychanged, Hp, 1e-6);
     if (status) {
       if (cb_out()) {
@@ -540,6 +543,7 @@ namespace ConicBundle {
 
 
   int BundleSolver::variable_metric(const CH_Matrix_Classes::Indexmatrix* new_indices) {
+    CH_Tools::ScopedTimer scoped_timer("BundleSolver::variable_metric");
     if (!Hp->employ_variable_metric())
       return 0;
 
@@ -605,6 +609,7 @@ namespace ConicBundle {
     Real& center_ub,
     Real relprec,
     Real center_gs_val) {
+    CH_Tools::ScopedTimer scoped_timer("BundleSolver::eval_augmodel");
     //for testing
     //Integer dummy;
     //old_model_aggregate.clear();
@@ -625,6 +630,19 @@ namespace ConicBundle {
       }
       return -1;
     }
+    //the groundset may choose another solver now that the size of the model is known
+    QPSolverObject* confirmed_qp_solver = groundset->confirm_qp_solver(qp_solver);
+    if (confirmed_qp_solver != qp_solver) {
+      qp_solver->clear_model_data_ptr();
+      qp_solver = confirmed_qp_solver;
+      qp_solver->clear_model_data_ptr();
+      if (model->transform()->start_augmodel(*qp_solver, cand_id, cand_y)) {
+        if (cb_out()) {
+          get_out() << "\n**** WARNING BundleSolver::eval_augmodel(...): start_augmodel failed for the confirmed qp solver" << std::endl;
+        }
+        return -1;
+      }
+    }
     assert(qp_solver->get_model_data_ptr() != 0);
 
     CH_Tools::Microseconds solve_start;
@@ -719,6 +737,7 @@ namespace ConicBundle {
     Real center_gs_val,
     const MinorantPointer& delta_gs_subg,
     const Indexmatrix& delta_index) {
+    CH_Tools::ScopedTimer scoped_timer("BundleSolver::reeval_augmodel");
 
     CH_Tools::Microseconds solve_start;
     if (clockp) {
@@ -806,6 +825,7 @@ namespace ConicBundle {
   // is sufficiently close to a feasible model solution.
 
   int BundleSolver::solve_model() {
+    CH_Tools::ScopedTimer scoped_timer("BundleSolver::solve_model");
     assert(model);
     updatecnt = 0;
     retcode = 0;
@@ -1583,14 +1603,21 @@ namespace ConicBundle {
     bool no_changes = true;
     bool no_center = true;
     Integer old_center_id = center_id;
-    Matrix old_center = center_y;
+    //old_center_y still holds center_y if it was brought up to date by the
+    //previous modification, otherwise copy it
+    if ((center_id < 0) || (old_center_y_id != center_id))
+      old_center_y = center_y;
+    old_center_y_id = -1;
+    const Matrix& old_center = old_center_y;
     if (center_id >= 0) {
       if (!gsmdf.no_modification()) {
         gsmdf.apply_to_vars(center_y);
-        center_gid = -1;
-        if (groundset->is_feasible(center_gid, center_y)) {
+        //if the center was feasible before, only the coordinates affected by gsmdf need checking
+        if (groundset->is_feasible_after_modification(center_gid, center_y, gsmdf)) {
           center_id = ++point_id;
           no_center = false;
+        } else {
+          center_gid = -1;
         }
       } else {
         no_center = false;
@@ -1598,6 +1625,10 @@ namespace ConicBundle {
       if ((!no_center) && (model)) {
         retval = model->transform()->apply_modification(no_changes, gsmdf, funmdfmap, center_id, center_y, old_center_id, old_center);
       }
+      //applying gsmdf to the old center again costs about as much as gsmdf
+      //did for center_y and saves copying center_y in the next modification
+      if ((!no_center) && (gsmdf.apply_to_vars(old_center_y) == 0))
+        old_center_y_id = center_id;
     }
     if ((no_center) && (model)) {
       retval = model->transform()->apply_modification(no_changes, gsmdf, funmdfmap, -1, center_y, -1, old_center);
@@ -203,6 +203,10 @@ namespace ConicBundle {
     CH_Matrix_Classes::Integer center_gid;
     /// value of the groundset cost function in cand_y for center_gid
     CH_Matrix_Classes::Real center_gs_val;
+    /// the center before the latest modification, see apply_modification()
+    CH_Matrix_Classes::Matrix old_center_y;
+    /// if equal to center_id, old_center_y is a copy of center_y (-1 if not valid)
+    CH_Matrix_Classes::Integer old_center_y_id;
 
 
     /// point_id of the most recent candidate
@@ -24,6 +24,7 @@
 
 
 #include "MatrixCBSolver.hxx"
+#include "sumop.hxx"
 #include <algorithm>
 #include <map>
 
@@ -38,6 +39,37 @@ namespace ConicBundle {
   PrimalData::~PrimalData() {
   }
 
+  int PrimalData::aggregate_primal_data_batch(const std::vector<const PrimalData*>& primals, const DVector& factors) {
+    assert(primals.size() == factors.size());
+    int err = 0;
+    for (unsigned int i = 0; i < primals.size(); i++) {
+      if (primals[i] == 0)
+        continue;
+      if (aggregate_primal_data(*primals[i], factors[i]))
+        err++;
+    }
+    return err;
+  }
+
+  int PrimalDVector::aggregate_primal_data_batch(const std::vector<const PrimalData*>& primals, const DVector& factors) {
+    assert(primals.size() == factors.size());
+    std::vector<const Real*> a;
+    std::vector<Real> f;
+    a.reserve(primals.size());
+    f.reserve(primals.size());
+    for (unsigned int i = 0; i < primals.size(); i++) {
+      if ((primals[i] == 0) || (factors[i] == 0.))
+        continue;
+      const PrimalDVector* pd = dynamic_cast<const PrimalDVector*>(primals[i]);
+      if ((pd == 0) || (pd->size() != size()))
+        return PrimalData::aggregate_primal_data_batch(primals, factors);
+      a.push_back(pd->data());
+      f.push_back(factors[i]);
+    }
+    sumop_xpeya(Integer(size()), data(), Integer(a.size()), a.data(), f.data());
+    return 0;
+  }
+
   PrimalExtender::~PrimalExtender() {
   }
 
@@ -394,7 +426,7 @@ namespace ConicBundle {
     if (ind) {
       vind.resize(unsigned(ind->rowdim()));
       for (Integer i = 0; i < ind->rowdim(); i++) {
-        vind[unsigned(i)] = (*ind)[i];
+        vind[unsigned(i)] = int((*ind)[i]);
       }
     } else {
       vind.resize(unsigned(solver->get_dim()));
@@ -104,6 +104,17 @@ extern "C" {
     return p->solver->add_function(*cf, fun_factor, (FunctionTask)fun_task, aft, true);
   }
 
+  int cb_add_sparse_function(cb_problemp p, void* function_key, cb_sparse_functionp f,
+    cb_subgextp se, int primaldim, double fun_factor, int fun_task,
+    cb_affinefunctiontransformationp aft) {
+    assert(p);
+    if (p->funmap.find(function_key) != p->funmap.end()) return 1;
+    CFunction* cf = new CFunction(function_key, f, se, primaldim);
+    if (cf == 0) return 1;
+    p->funmap[function_key] = cf;
+    return p->solver->add_function(*cf, fun_factor, (FunctionTask)fun_task, aft, true);
+  }
+
   int cb_set_lower_bound(cb_problemp p, int i, double lb) {
     assert(p);
     return p->solver->set_lower_bound(i, lb);
@@ -141,7 +152,7 @@ extern "C" {
     Indexmatrix oi;
     int ret_code = p->solver->delete_variables(di, oi);
     for (int i = 0; i < oi.dim(); i++) {
-      map_to_old[i] = oi[i];
+      map_to_old[i] = int(oi[i]);
     }
     return ret_code;
   }
@@ -417,7 +428,7 @@ extern "C" {
     const Indexmatrix* ind = p->solver->get_fixed_active_bounds();
     if (ind) {
       for (int i = 0; i < ind->rowdim(); i++) {
-        indicator[i] = (*ind)[i];
+        indicator[i] = int((*ind)[i]);
       }
     } else {
       for (int i = 0; i < p->solver->get_dim(); i++) {
@@ -433,6 +444,22 @@ extern "C" {
     p->solver->set_out(&std::cout, pril);
   }
 
+  void cb_set_timing(cb_problemp p, int on) {
+    assert(p);
+    p->solver->set_timing(on != 0);
+  }
+
+  void cb_print_timing(cb_problemp p) {
+    assert(p);
+    p->solver->print_timing(std::cout);
+    std::cout.flush();
+  }
+
+  void cb_reset_timing(cb_problemp p) {
+    assert(p);
+    p->solver->reset_timing();
+  }
+
 
 }//end extern "C"
 
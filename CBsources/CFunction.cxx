@@ -34,11 +34,98 @@ namespace ConicBundle {
     function_key = fk;
     assert(fp != 0);
     oracle = fp;
+    sparse_oracle = 0;
     subgext = se;
     primaldim = prdim;
     max_new = 1;
   }
 
+  CFunction::CFunction(void* fk, cb_sparse_functionp fp, cb_subgextp se, int prdim) {
+    function_key = fk;
+    assert(fp != 0);
+    oracle = 0;
+    sparse_oracle = fp;
+    subgext = se;
+    primaldim = prdim;
+    max_new = 1;
+  }
+
+  int CFunction::evaluate_sparse(
+    const  Matrix& current_point,
+    double relprec,
+    double& obval,
+    std::vector<Minorant*>& mnrt
+  ) {
+    Integer dim = current_point.dim();
+    if (Integer(sparse_nnz.size()) < max_new)
+      sparse_nnz.resize(unsigned(max_new));
+    subg_vals.newsize(max_new, 1); chk_set_init(subg_vals, 1);
+    if (primaldim > 0) {
+      primal_buffer.newsize(primaldim, max_new); chk_set_init(primal_buffer, 1);
+    }
+    if (sparse_indices.size() == 0) {
+      //initial guess, the buffers grow as needed and are kept
+      sparse_indices.resize(unsigned(max_new * min(dim, Integer(1024)) + 1));
+    }
+
+    int n_new = 0;
+    int nnz = 0;
+    int ret_code = 0;
+    const double obval_in = obval;
+    for (int cnt = 0; cnt < 2; cnt++) {
+      if (sparse_coeffs.dim() < Integer(sparse_indices.size())) {
+        sparse_coeffs.newsize(Integer(sparse_indices.size()), 1); chk_set_init(sparse_coeffs, 1);
+      }
+      obval = obval_in;
+      n_new = 0;
+      nnz = int(sparse_indices.size());
+      ret_code = (*sparse_oracle)(
+        function_key,
+        const_cast<double*>(current_point.get_store()),
+        relprec,
+        int(max_new),
+        &obval,
+        &n_new,
+        subg_vals.get_store(),
+        &(sparse_nnz[0]),
+        &(sparse_indices[0]),
+        sparse_coeffs.get_store(),
+        &nnz,
+        (primaldim > 0) ? primal_buffer.get_store() : 0
+      );
+      if (nnz <= int(sparse_indices.size()))
+        break;
+      sparse_indices.resize(unsigned(nnz));
+    }
+    if (nnz > int(sparse_indices.size())) {
+      if (cb_out())
+        get_out() << "**** ERROR in CFunction::evaluate(): the sparse oracle asks for more than the enlarged capacity of " << sparse_indices.size() << " nonzeros" << std::endl;
+      return (ret_code != 0) ? ret_code : 1;
+    }
+
+    Integer start = 0;
+    for (Integer i = 0; i < n_new; i++) {
+      int nz = sparse_nnz[unsigned(i)];
+      if ((nz < 0) || (start + nz > nnz)) {
+        if (cb_out())
+          get_out() << "**** ERROR in CFunction::evaluate(): the nonzero counts of the sparse oracle exceed the number of nonzeros returned" << std::endl;
+        return (ret_code != 0) ? ret_code : 1;
+      }
+      const int* ind = &(sparse_indices[unsigned(start)]);
+      for (int j = 0; j < nz; j++) {
+        if ((ind[j] < 0) || (ind[j] >= dim)) {
+          if (cb_out())
+            get_out() << "**** ERROR in CFunction::evaluate(): the sparse oracle returned index " << ind[j] << " outside the range [0," << dim - 1 << "]" << std::endl;
+          return (ret_code != 0) ? ret_code : 1;
+        }
+      }
+      mnrt.push_back(new Minorant(false, subg_vals(i), nz, sparse_coeffs.get_store() + start, ind, 1., (primaldim > 0) ? new PrimalMatrix(primal_buffer.col(i)) : 0));
+      start += nz;
+    }
+
+    return ret_code;
+  }
+
   int CFunction::evaluate(
     const  Matrix& current_point,
     double relprec,
@@ -47,6 +134,8 @@ namespace ConicBundle {
     PrimalExtender*&
   ) {
     assert(mnrt.size() == 0);
+    if (oracle == 0)
+      return evaluate_sparse(current_point, relprec, obval, mnrt);
     Integer dim = current_point.dim();
     Matrix subg(dim, Integer(max_new)); chk_set_init(subg, 1);
     Matrix val(max_new, 1);             chk_set_init(val, 1);
@@ -59,7 +148,7 @@ namespace ConicBundle {
         function_key,
         const_cast<double*>(current_point.get_store()),
         relprec,
-        max_new,
+        int(max_new),
         &obval,
         &n_new,
         val.get_store(),
@@ -67,14 +156,14 @@ namespace ConicBundle {
         x.get_store()
         );
       for (Integer i = 0; i < n_new; i++) {
-        mnrt.push_back(new Minorant(false, val(i), dim, subg.get_store() + i * dim, 0, 1., new PrimalMatrix(x.col(i))));
+        mnrt.push_back(new Minorant(false, val(i), int(dim), subg.get_store() + i * dim, 0, 1., new PrimalMatrix(x.col(i))));
       }
     } else {
       ret_code = (*oracle)(
         function_key,
         const_cast<double*>(current_point.get_store()),
         relprec,
-        max_new,
+        int(max_new),
         &obval,
         &n_new,
         val.get_store(),
@@ -82,7 +171,7 @@ namespace ConicBundle {
         0
         );
       for (Integer i = 0; i < n_new; i++) {
-        mnrt.push_back(new Minorant(false, val(i), dim, subg.get_store() + i * dim));
+        mnrt.push_back(new Minorant(false, val(i), int(dim), subg.get_store() + i * dim));
       }
     }
 
@@ -160,7 +249,7 @@ namespace ConicBundle {
         function_key,
         0,
         n_coords,
-        const_cast<Integer*>(indices),
+        const_cast<int*>(indices),
         new_subgradient_values.get_store()
       );
     } else {
@@ -170,7 +259,7 @@ namespace ConicBundle {
         function_key,
         const_cast<double*>(xp->get_store()),
         n_coords,
-        const_cast<Integer*>(indices),
+        const_cast<int*>(indices),
         new_subgradient_values.get_store()
       );
     }
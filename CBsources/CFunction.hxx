@@ -54,13 +54,30 @@ namespace ConicBundle {
   private:
     void* function_key;  ///< identifier for c-code
     cb_functionp oracle; ///< c-function for evaluate
+    cb_sparse_functionp sparse_oracle; ///< c-function for evaluate returning sparse subgradients (used if oracle==0)
     cb_subgextp subgext; ///< c-function for subgradient extension
     CH_Matrix_Classes::Integer primaldim;   ///< length of primal vectors; uses PrimalMatrix
     CH_Matrix_Classes::Integer max_new;     ///< maximum number of new vectors per call
 
+    //--- buffers for sparse_oracle, kept over calls
+    std::vector<int> sparse_nnz; ///< number of nonzeros per subgradient
+    std::vector<int> sparse_indices; ///< indices of the nonzeros of all subgradients
+    CH_Matrix_Classes::Matrix sparse_coeffs; ///< values of the nonzeros of all subgradients
+    CH_Matrix_Classes::Matrix subg_vals; ///< values of the subgradients at the point
+    CH_Matrix_Classes::Matrix primal_buffer; ///< primal vectors of the subgradients
+
+    /// evaluation via sparse_oracle
+    int evaluate_sparse(const  CH_Matrix_Classes::Matrix& current_point,
+      double relprec,
+      double& objective_value,
+      std::vector<Minorant*>& minorants);
+
   public:
     ///constructor
     CFunction(void* fk, cb_functionp fp, cb_subgextp se = 0, int prdim = 0);
+
+    ///constructor for an oracle returning sparse subgradients
+    CFunction(void* fk, cb_sparse_functionp fp, cb_subgextp se = 0, int prdim = 0);
     ///destructor
     ~CFunction() {
     };
@@ -26,6 +26,7 @@
 #include "mymath.hxx"
 #include "ConeModel.hxx"
 #include "BundleIdProx.hxx"
+#include "timer_registry.hxx"
 
 using namespace CH_Tools;
 using namespace CH_Matrix_Classes;
@@ -73,6 +74,7 @@ namespace ConicBundle {
     const Matrix& y,
     Real nullstep_bound,
     Real relprec) {
+    CH_Tools::ScopedTimer scoped_timer("ConeModel::eval_function");
     assert(relprec > 0.);
 
     if (get_data()->dim < 0)
@@ -86,7 +88,7 @@ namespace ConicBundle {
 
     if (bundlehandler) {
       bundlehandler->clear_cand_minorants();
-      get_data()->max_old_minorants = max(get_data()->max_old_minorants, sumbundle_parameters->get_max_bundle_size());
+      get_data()->max_old_minorants = max(get_data()->max_old_minorants, Integer(sumbundle_parameters->get_max_bundle_size()));
     }
 
     int err = evaluate_oracle(y_id, y, nullstep_bound, relprec);
@@ -113,7 +115,7 @@ namespace ConicBundle {
       }
 
       //update old minorants if necessary
-      get_data()->max_old_minorants = max(get_data()->max_old_minorants, get_bundle_parameters()->get_max_bundle_size());
+      get_data()->max_old_minorants = max(get_data()->max_old_minorants, Integer(get_bundle_parameters()->get_max_bundle_size()));
       if (get_data()->max_old_minorants > 0) {
         MinorantPointer& cand_minorant = provide_cand_minorant();
         if ((!cand_minorant.valid()) || (get_data()->store_old_minorant(cand_minorant))) {
@@ -285,6 +287,7 @@ namespace ConicBundle {
     Integer y_id,
     const Matrix& y,
     Real relprec) {
+    CH_Tools::ScopedTimer scoped_timer("ConeModel::eval_model");
     CH_Tools::Microseconds evalmodel_start = clock.time();
 
 
@@ -349,6 +352,7 @@ namespace ConicBundle {
     const Matrix& y,
     Real model_maxviol,
     BundleProxObject& H) {
+    CH_Tools::ScopedTimer scoped_timer("ConeModel::update_model");
     CH_Tools::Microseconds update_start = clock.time();
     int err = 0;
 
@@ -399,6 +403,7 @@ namespace ConicBundle {
     BundleProxObject& H,
     Real& model_deviation,
     Real& model_curvature) {
+    CH_Tools::ScopedTimer scoped_timer("ConeModel::update_model");
 
     CH_Tools::Microseconds update_start = clock.time();
     assert(get_data());
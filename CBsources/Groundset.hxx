@@ -146,6 +146,23 @@ namespace ConicBundle {
       const CH_Matrix_Classes::Matrix& y,
       CH_Matrix_Classes::Real relprec = 1e-10) = 0;
 
+    /** @brief like is_feasible() for a point y that was obtained by mdf.apply_to_vars() from a point feasible for in_groundset_id, where @a mdf is the modification passed last to apply_modification()
+
+     If in_groundset_id is the groundset_id just before this
+     modification and the modification did not change the bounds or the
+     constraints of the remaining variables, only the coordinates
+     of y affected by the modification need to be checked (for appended
+     variables this makes the check independent of the number of
+     variables already present). The default implementation checks all
+     of y by is_feasible().
+    */
+    virtual bool is_feasible_after_modification(CH_Matrix_Classes::Integer& in_groundset_id,
+      const CH_Matrix_Classes::Matrix& y,
+      const GroundsetModification& /* mdf */,
+      CH_Matrix_Classes::Real relprec = 1e-10) {
+      return is_feasible(in_groundset_id, y, relprec);
+    }
+
     /** @brief if the groundset_id changed, it checks feasibility of y with respect to the given precision. If infeasible it replaces y by its projection with respect to the norm of Hp and sets ychanged to true.
 
      The routine is called by the internal bundle solver to check
@@ -179,6 +196,11 @@ namespace ConicBundle {
     virtual QPSolverObject* get_qp_solver(bool& solves_model_without_gs,
       BundleProxObject* Hp) = 0;
 
+    /// called after the model data of the subproblem has been entered into @a qp_solver as returned by get_qp_solver(); if the groundset prefers another solver for this model, it returns this one and the model data has to be entered anew, otherwise (default) @a qp_solver is returned
+    virtual QPSolverObject* confirm_qp_solver(QPSolverObject* qp_solver) {
+      return qp_solver;
+    }
+
     /// set parameters for the QP_Solver  
     virtual int set_qp_solver_parameters(QPSolverParametersObject* in_qpsp) = 0;
 
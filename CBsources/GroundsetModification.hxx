@@ -142,6 +142,11 @@ namespace ConicBundle {
       return mdf.no_modification();
     }
 
+    /// returns the number of leading variables whose index and bounds are not affected by the modification (0 for general reassignments or bound changes)
+    CH_Matrix_Classes::Integer unchanged_leading_vardim() const {
+      return mdf.unchanged_leading_vardim();
+    }
+
     /// if set to true, no deletions/reassignments may be present or specified in the future, only appensions are allowed 
     int set_append_to_old(bool append_only) {
       return mdf.set_append_to_old(append_only);
@@ -182,20 +187,20 @@ namespace ConicBundle {
 
      /// returns the number of variables before modification
     int get_old_vardim() const {
-      return mdf.old_vardim();
+      return int(mdf.old_vardim());
     }
     /// returns the number of variables once all stored modifications have been performed
     int get_new_vardim() const {
-      return mdf.new_vardim();
+      return int(mdf.new_vardim());
     }
     /// returns the number of variables that are appended (due to later reassignmentds they may no longer be located at the end)
     int get_appended_vardim() const {
-      return mdf.appended_vardim();
+      return int(mdf.appended_vardim());
     }
 
     /// returns null if there are no index changes, otherwise the Indexmatrix pointed to is a vector whose i-th entry holds the old index of the new i-th variable (injective!), index values exceeding old_vardim() refer to newly appended variables  
     const int* get_map_to_old_variables() const {
-      return (mdf.map_to_old_variables()) == 0 ? 0 : (const int*)(mdf.map_to_old_variables()->get_store());
+      return mdf.int_map_to_old_variables();
     }
 
     /// returns the change in the offste value of the groundset minorant
@@ -259,6 +264,11 @@ namespace ConicBundle {
       return mdf.map_to_old_variables();
     }
 
+    /// returns true if map_to_old_variables() is null or strictly increasing; then the index changes are fully described by deleted_var_indices() and the appended variables stay at the end
+    bool map_to_old_variables_increasing() const {
+      return mdf.map_to_old_variables_increasing();
+    }
+
     /// returns null if there were no deletions, otherwise the Indexmatrix pointed to is a vector holding the deleted old variable indices in increasing order   
     const CH_Matrix_Classes::Indexmatrix* deleted_var_indices() const {
       return mdf.deleted_var_indices();
@@ -29,6 +29,7 @@
 #include "LPGroundsetModification.hxx"
 #include "BundleIdProx.hxx"
 #include "MatrixCBSolver.hxx"
+#include "QPDirectKKTSolver.hxx"
 
 using namespace CH_Matrix_Classes;
 
@@ -54,6 +55,9 @@ namespace ConicBundle {
     CBout* cb) :
     CBout(cb), vm_selection(0) {
     qpsolver = new QPSolver(this);
+    qpselector.set_cbout(this);
+    qpselector.add_config("QPSolver");
+    qpselector.add_config("UQPSolver");
     LPGroundset::clear(0, in_groundset_id);
 
     LPGroundsetModification mdf(0, 0);
@@ -85,6 +89,12 @@ namespace ConicBundle {
     gs_minorant.init(new Minorant, groundset_id);
     gs_aggregate = gs_minorant;
     use_yfixing = false;
+    auto_select_qpsolver = false;
+    qpselector.clear_measurements();
+    uqpsolver.set_reuse_factor(false);
+    qpselected = 0;
+    qpselected_iter = 0;
+    qpselect_bundlesize = 0;
     yfixed.init(dim, 1, Integer(0));
     starting_point.init(dim, 1, 0.);
     c.init(0, 1, 0.);
@@ -116,12 +126,49 @@ namespace ConicBundle {
     if (inqpsolver) {
       delete qpsolver;
       qpsolver = inqpsolver;
+      qpselected = 0;
     }
     if (inqpparams)
       qpsolver->QPset_parameters(inqpparams);
     return 0;
   }
 
+  // *****************************************************************************
+  //                       LPGroundset::set_auto_select_KKTsolver()
+  // *****************************************************************************
+
+  int LPGroundset::set_auto_select_KKTsolver(bool auto_select) {
+    QPSolver* qps = dynamic_cast<QPSolver*>(qpsolver);
+    if ((qps == 0) || (qps->QPget_parameters() == 0)) {
+      if (cb_out())
+        get_out() << "**** WARNING in LPGroundset::set_auto_select_KKTsolver(): the qp solver is not a QPSolver, setting ignored" << std::endl;
+      return 1;
+    }
+    if (auto_select) {
+      QPKKTSolverAutoSelect* kkt = new QPKKTSolverAutoSelect(qps, 0);
+      kkt->add_default_solvers();
+      qps->QPget_parameters()->QPset_KKTsolver(kkt);
+    }
+    else
+      qps->QPget_parameters()->QPset_KKTsolver(new QPDirectKKTSolver(false, qps, 0));
+    return 0;
+  }
+
+  // *****************************************************************************
+  //                           LPGroundset::set_lazy_rowrep()
+  // *****************************************************************************
+
+  int LPGroundset::set_lazy_rowrep(bool lazy) {
+    QPSolver* qps = dynamic_cast<QPSolver*>(qpsolver);
+    if (qps == 0) {
+      if (cb_out())
+        get_out() << "**** WARNING in LPGroundset::set_lazy_rowrep(): the qp solver is not a QPSolver, setting ignored" << std::endl;
+      return 1;
+    }
+    qps->set_lazy_rowrep(lazy);
+    return 0;
+  }
+
   // *****************************************************************************
   //                           LPGroundset::get_lby()
   // *****************************************************************************
@@ -165,6 +212,25 @@ namespace ConicBundle {
     return true;
   }
 
+  // *****************************************************************************
+  //                  LPGroundset::is_feasible_after_modification()
+  // *****************************************************************************
+
+  bool LPGroundset::is_feasible_after_modification(Integer& gs_id, const Matrix& y, const GroundsetModification& mdf, Real relprec) {
+    if (gs_id == groundset_id)
+      return true;
+
+    if ((gs_id != modified_groundset_id) || (gs_id < 0))
+      return is_feasible(gs_id, y, relprec);
+
+    //the bounds of the leading unchanged variables still hold
+    if (!qpsolver->QPis_feasible_beyond(y, mdf.unchanged_leading_vardim(), relprec))
+      return false;
+
+    gs_id = groundset_id;
+    return true;
+  }
+
   // *****************************************************************************
   //                             ensure_feasibility
   // *****************************************************************************
@@ -189,7 +255,12 @@ namespace ConicBundle {
 
   QPSolverObject* LPGroundset::get_qp_solver(bool& qpwogs,
     BundleProxObject* inHp) {
-    if (qpsolver->QPprefer_UQPSolver(inHp)) {
+    if ((auto_select_qpsolver) && (!qpsolver->QPconstrained()) &&
+      (qpsolver->QPprefer_UQPSolver(inHp))) {
+      //both solve the entire subproblem, take the one that was faster so far
+      qpwogs = solve_model_without_gs = false;
+      qp_solver = auto_select_qp_solver();
+    } else if (qpsolver->QPprefer_UQPSolver(inHp)) {
       qpwogs = solve_model_without_gs = qpsolver->QPconstrained();
       qp_solver = &uqpsolver;
     } else {
@@ -200,6 +271,61 @@ namespace ConicBundle {
   }
 
 
+  // *****************************************************************************
+  //                             auto_select_qp_solver
+  // *****************************************************************************
+
+  QPSolverObject* LPGroundset::auto_select_qp_solver() {
+    //record the work spent by the previous selection since then
+    CH_Tools::Microseconds worktime;
+    Integer workiter;
+    if ((qpselected) && (qpselected->QPget_accumulated_work(worktime, workiter) == 0)) {
+      if ((workiter > qpselected_iter) && (worktime >= qpselected_time))
+        qpselector.record(Real(worktime - qpselected_time), workiter - qpselected_iter);
+    }
+    qpselected = 0;
+
+    //the bundle size is only known once the model is entered, see confirm_qp_solver()
+    Integer i = qpselector.get_choice(dim, qpselect_bundlesize);
+    return (i == 1) ? static_cast<QPSolverObject*>(&uqpsolver) : qpsolver;
+  }
+
+  // *****************************************************************************
+  //                             confirm_qp_solver
+  // *****************************************************************************
+
+  //the number of model variables in the data entered into qps
+  static Integer qp_model_size(QPSolverObject* qps) {
+    QPModelDataObject* md = qps->get_model_data_ptr();
+    QPModelBlockObject* mb = dynamic_cast<QPModelBlockObject*>(md);
+    if (mb)
+      return mb->dim_model();
+    UQPModelBlockObject* umb = dynamic_cast<UQPModelBlockObject*>(md);
+    if (umb)
+      return umb->xdim();
+    return 0;
+  }
+
+  QPSolverObject* LPGroundset::confirm_qp_solver(QPSolverObject* in_qp_solver) {
+    if ((!auto_select_qpsolver) || (solve_model_without_gs) || (in_qp_solver != qp_solver) ||
+      ((in_qp_solver != qpsolver) && (in_qp_solver != &uqpsolver)))
+      return in_qp_solver;
+
+    qpselect_bundlesize = qp_model_size(in_qp_solver);
+    Integer i = qpselector.select(dim, qpselect_bundlesize);
+    qpselected = (i == 1) ? static_cast<QPSolverObject*>(&uqpsolver) : qpsolver;
+    if (qpselected->QPget_accumulated_work(qpselected_time, qpselected_iter)) {
+      if (cb_out())
+        get_out() << "**** WARNING in LPGroundset::confirm_qp_solver(): the solver cannot report its work, switching off the automatic selection" << std::endl;
+      auto_select_qpsolver = false;
+      qpselected = 0;
+      return in_qp_solver;
+    }
+    qp_solver = qpselected;
+    return qp_solver;
+  }
+
+
   // *************************************************************************
   //                              candidate
   // *************************************************************************
@@ -233,7 +359,7 @@ namespace ConicBundle {
       //get candidate directly as the solution
       Real gsval;
       Matrix gsagg;
-      qpsolver->QPget_solution(augval_lb, augval_ub, newy, gsval, gsagg);
+      qp_solver->QPget_solution(augval_lb, augval_ub, newy, gsval, gsagg);
       cand_gs_val = gs_minorant.evaluate(-1, newy);
       gs_aggregate = MinorantPointer(new MatrixMinorant(gsval, gsagg, 0, true), groundset_id);
       MinorantPointer aggr(model_subg);
@@ -320,7 +446,6 @@ namespace ConicBundle {
     }
 
     //determine the rough structure of the scaling matrix
-    Matrix diagQ;
     const Matrix* Vp;
     Hp->get_precond(diagQ, Vp);
 
@@ -339,7 +464,7 @@ namespace ConicBundle {
       const Indexmatrix& ubindex = *p_ubindex; //=qpsolver->get_ubindex();
       const Matrix& uby = *p_uby;  //=qpsolver->get_uby();
       Real dummy;
-      Matrix subg(dim, 1); chk_set_init(subg, 1);
+      subg.newsize(dim, 1); chk_set_init(subg, 1);
       model_subg.get_minorant(dummy, subg, 0, 1., false);
       gs_minorant.get_minorant(dummy, subg, 0, 1., true);
       newy.init(subg, -1.);
@@ -374,15 +499,14 @@ namespace ConicBundle {
       int cnt_increased = 0;
 
       bool D_heuristic = Hp->employ_diagonal_bounds_scaling();
-      Matrix D_update;
       if (D_heuristic)
         D_update.init(dim, 1, 0.);
 
       //--- update subg, if necessary 
       //    (so that the step satisfies the box constraints)
-      Matrix update_value(dim, 1); chk_set_init(update_value, 1);
-      Indexmatrix update_index(dim, 1); chk_set_init(update_index, 1);
-      Matrix gs_aggr(dim, 1); chk_set_init(gs_aggr, 1);
+      update_value.newsize(dim, 1); chk_set_init(update_value, 1);
+      update_index.newsize(dim, 1); chk_set_init(update_index, 1);
+      gs_aggr.newsize(dim, 1); chk_set_init(gs_aggr, 1);
       Real aggrdummy;
       gs_aggregate.get_minorant(aggrdummy, gs_aggr, 0, 1., false);
       gs_minorant.get_minorant(aggrdummy, gs_aggr, 0, -1., true);
@@ -557,7 +681,7 @@ namespace ConicBundle {
 
       gs_minorant.get_minorant(dummy, gs_aggr, 0, 1., true);
       Minorant* minorant = new Minorant(true, gs_aggregate_offset);
-      minorant->add_coeffs(gs_aggr.dim(), gs_aggr.get_store());
+      minorant->add_coeffs(int(gs_aggr.dim()), gs_aggr.get_store());
       //minorant->sparsify(1e-12*std::sqrt(normsubg2));
       gs_aggregate.init(minorant, groundset_id);
       cand_gs_val = gs_aggregate.evaluate(-1, newy);
@@ -583,7 +707,8 @@ namespace ConicBundle {
 
       if (delta_groundset_aggregate) {
         Minorant* minorant = new Minorant(true, gs_aggregate_offset - old_subg_offset);
-        minorant->add_coeffs(update_value.dim(), update_value.get_store(), update_index.get_store());
+        std::vector<int> int_ind;
+        minorant->add_coeffs(int(update_value.dim()), update_value.get_store(), int_store(update_index, int_ind));
         delta_groundset_aggregate->init(minorant, groundset_id);
         delta_index->init(update_index);
       }
@@ -697,9 +822,9 @@ namespace ConicBundle {
     if (delta_groundset_aggregate) {
       delta_groundset_aggregate->scale(-1.);
       gs_aggregate.get_minorant(*delta_groundset_aggregate, 1.);
-      Integer nz;
+      int nz;
       const Real* valp;
-      const Integer* indp;
+      const int* indp;
       delta_groundset_aggregate->get_minorant()->get_coeffs(nz, valp, indp);
       if (indp != 0) {
         delta_index->init(nz, 1, indp);
@@ -712,7 +837,7 @@ namespace ConicBundle {
        minorant->add_coeffs(tmpvec.dim(),tmpvec.get_store());
        minorant->sparsify(1e-12*normsubg2);
        delta_groundset_aggregate->init(minorant,0);
-       Integer nz;
+       int nz;
        const Real* valp;
        const Integer *indp;
        minorant->get_coeffs(nz,valp,indp);
@@ -893,7 +1018,8 @@ namespace ConicBundle {
 
     int err = 0;
     dim = mdf.new_vardim();
-    yfixed.init(dim, 1, 0);
+    yfixed.init(dim, 1, Integer(0));
+    modified_groundset_id = groundset_id;
     groundset_id++;
     if (gs_minorant.apply_modification(mdf, groundset_id, 0, true)) {
       if (cb_out())
@@ -917,8 +1043,9 @@ namespace ConicBundle {
     if (err)
       return err;
 
-    int dummy = -1;
-    if (!is_feasible(dummy, starting_point)) {
+    //infeasibilities of the unchanged coordinates were reported before
+    Integer sp_gid = modified_groundset_id;
+    if (!is_feasible_after_modification(sp_gid, starting_point, mdf)) {
       if (cb_out())
         get_out() << "**** WARNING: Groundset::apply_modification(.): starting point is not feasible (but this is allowed)" << std::endl;
     }
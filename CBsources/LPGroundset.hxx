@@ -38,6 +38,7 @@
 #include "Groundset.hxx"
 #include "QPSolver.hxx"
 #include "UQPSolver.hxx"
+#include "QPKKTSolverAutoSelect.hxx"
 
 namespace ConicBundle {
 
@@ -76,6 +77,9 @@ namespace ConicBundle {
     /// nonnegative update counter for recognizing changes in the groundset description
     CH_Matrix_Classes::Integer groundset_id;
 
+    /// the groundset_id before the latest call to apply_modification(), see is_feasible_after_modification()
+    CH_Matrix_Classes::Integer modified_groundset_id;
+
     /// the starting point
     CH_Matrix_Classes::Matrix starting_point;
 
@@ -94,6 +98,16 @@ namespace ConicBundle {
     QPSolverObject* qp_solver; ///< the selected solver
     bool solve_model_without_gs; ///< selected varaint of solving the subproblem
 
+    bool auto_select_qpsolver; ///< if true, unconstrained subproblems preferring the UQPSolver are solved by the faster one of qpsolver and uqpsolver as measured by qpselector
+    QPAutoSelector qpselector; ///< the online selection between qpsolver (configuration 0) and uqpsolver (configuration 1)
+    QPSolverObject* qpselected; ///< the solver selected by qpselector in the latest call to confirm_qp_solver() whose work is not yet recorded, may be NULL
+    CH_Tools::Microseconds qpselected_time; ///< the accumulated work time of qpselected at its selection
+    CH_Matrix_Classes::Integer qpselected_iter; ///< the accumulated interior point iterations of qpselected at its selection
+    CH_Matrix_Classes::Integer qpselect_bundlesize; ///< the bundle size of the latest subproblem, used for guessing the choice in get_qp_solver()
+
+    /// records the work of the previous selection in qpselector and returns the solver qpselector is expected to choose for the next subproblem
+    QPSolverObject* auto_select_qp_solver();
+
 
     //data for describing the QP
     BundleProxObject* Hp;  ///< points to the quadratic cost matrix inside ensure_feasibility() and candidate(), otherwise ==NULL
@@ -114,6 +128,14 @@ namespace ConicBundle {
     CH_Matrix_Classes::Matrix old_diagonal; ///< used by the variable metric low rank heuristic 
     CH_Matrix_Classes::Symmatrix old_sym; ///< used by the variable metric heuristic 
 
+    //temporary variables of candidate(), global only for memory management purposes
+    CH_Matrix_Classes::Matrix diagQ; ///< diagonal of the scaling matrix
+    CH_Matrix_Classes::Matrix subg; ///< joint subgradient of the model and the ground set cost
+    CH_Matrix_Classes::Matrix gs_aggr; ///< coefficients of the new ground set aggregate
+    CH_Matrix_Classes::Matrix D_update; ///< increase of the diagonal scaling
+    CH_Matrix_Classes::Matrix update_value; ///< changes in the ground set aggregate
+    CH_Matrix_Classes::Indexmatrix update_index; ///< indices of these changes
+
   protected:
 
   public:
@@ -123,7 +145,8 @@ namespace ConicBundle {
 
     /// calls clear() with the same parameters
     LPGroundset(CBout* cb = 0) :CBout(cb), vm_selection(0) {
-      qpsolver = new QPSolver(cb); uqpsolver.set_cbout(cb); clear(0, 0);
+      qpsolver = new QPSolver(cb); uqpsolver.set_cbout(cb); qpselector.set_cbout(cb);
+      qpselector.add_config("QPSolver"); qpselector.add_config("UQPSolver"); clear(0, 0);
     }
 
     /// allows to specify the groundset in the constructor, zero is allowed everywhere
@@ -161,6 +184,18 @@ namespace ConicBundle {
     ///Set the qp solver's parameters to qpparams (if not null); if the second argument qpsolver is also given, the old solver is first discarded and replaced by this new solver and then the parameters are set (if given).  Any object passed here will be owned and deleted by *this. For correct continuaton a new qpsolver needs to have the same feasible set as the current solver but this must be ensured by the caller.  
     int set_qpsolver(QPSolverParametersObject* qpparams, QPSolverObject* qpsolver = 0);
 
+    /** @brief if true (default), the constraint matrix of the QPSolver only keeps its column representation unless a routine needs the rows, see QPSolver::set_lazy_rowrep()
+
+        @return 0 on success, 1 if the qp solver is not a QPSolver
+    */
+    int set_lazy_rowrep(bool lazy);
+
+    /** @brief if true, the QPSolver chooses its KKT solver online among those of QPKKTSolverAutoSelect::add_default_solvers() by measured times and iterations, if false it uses the QPDirectKKTSolver (default)
+
+        @return 0 on success, 1 if the qp solver is not a QPSolver
+    */
+    int set_auto_select_KKTsolver(bool auto_select);
+
     /// returns false if the feasible set is the entire space (unconstrained optimization), true otherwise. 
     bool constrained() const {
       return qpsolver->QPconstrained();
@@ -201,6 +236,12 @@ namespace ConicBundle {
       const CH_Matrix_Classes::Matrix& y,
       CH_Matrix_Classes::Real relprec = 1e-10);
 
+    /// returns true if still feasible, checks only the coordinates affected by the modification if possible, see Groundset::is_feasible_after_modification() 
+    virtual bool is_feasible_after_modification(CH_Matrix_Classes::Integer& in_groundset_id,
+      const CH_Matrix_Classes::Matrix& y,
+      const GroundsetModification& mdf,
+      CH_Matrix_Classes::Real relprec = 1e-10);
+
     /// makes y feasible if not so, see Groundset::ensure_feasibility()
     int ensure_feasibility(CH_Matrix_Classes::Integer& in_groundset_id,
       CH_Matrix_Classes::Matrix& y,
@@ -212,6 +253,14 @@ namespace ConicBundle {
     virtual QPSolverObject* get_qp_solver(bool& solves_model_without_gs,
       BundleProxObject* Hp);
 
+    /** @brief if the solver is selected automatically (see
+        set_auto_select_qpsolver()), the selection by qpselector is made
+        here for the dimension and the bundle size of the model data
+        just entered into @a qp_solver; if it chooses the other solver,
+        this one is returned and the model data has to be entered anew
+    */
+    virtual QPSolverObject* confirm_qp_solver(QPSolverObject* qp_solver);
+
     /// set parameters for the QP_Solver  
     int set_qp_solver_parameters(QPSolverParametersObject* /* in_qpsp */) {
       return 0;
@@ -224,7 +273,7 @@ namespace ConicBundle {
 
     /// stores the a new starting point irrespective of whether it is feasible or not and returns 0 if it feasible, 1 if it is infeasible
     virtual int set_starting_point(const CH_Matrix_Classes::Matrix& vec) {
-      starting_point = vec; int dummy = -1; return (is_feasible(dummy, vec) == false);
+      starting_point = vec; CH_Matrix_Classes::Integer dummy = -1; return (is_feasible(dummy, vec) == false);
     }
 
     /// computes the next ground set minorant and candidate, see Groundset::candidate()
@@ -273,6 +322,41 @@ namespace ConicBundle {
       use_yfixing = uyf;
     }
 
+    /// true if the UQPSolver may reuse factorizations of earlier steps, see UQPSolver::set_reuse_factor()
+    bool get_uqpsolver_reuse_factor() const {
+      return uqpsolver.get_reuse_factor();
+    }
+
+    /// set to true to allow the UQPSolver to solve later steps with the factorization of an earlier step as preconditioner, see UQPSolver::set_reuse_factor() (default false, reset by clear())
+    void set_uqpsolver_reuse_factor(bool reuse, CH_Matrix_Classes::Integer maxit = 5, CH_Matrix_Classes::Real relprec = 1e-6) {
+      uqpsolver.set_reuse_factor(reuse, maxit, relprec);
+    }
+
+    /// true if the choice between QPSolver and UQPSolver is made online by measured times, see set_auto_select_qpsolver()
+    bool get_auto_select_qpsolver() const {
+      return auto_select_qpsolver;
+    }
+
+    /** @brief set to true to choose between QPSolver and UQPSolver by measured times (default false)
+
+        If QPprefer_UQPSolver() of the general solver holds for an
+        unconstrained groundset, the subproblems are then solved by
+        either of the two solvers as decided by a QPAutoSelector based on
+        the dimension, the bundle size and the time and interior point
+        iterations measured for both in previous subproblems.
+        Switches of the selection are reported in the output and the
+        measurements may be inspected via get_qp_selector().
+    */
+    void set_auto_select_qpsolver(bool asq) {
+      auto_select_qpsolver = asq;
+      qpselected = 0;
+    }
+
+    /// gives access to the selector used if get_auto_select_qpsolver() is true (configuration 0 is the QPSolver, 1 the UQPSolver)
+    QPAutoSelector& get_qp_selector() {
+      return qpselector;
+    }
+
     /// delete old selector and set a new one (0 is allowed resulting in no local selector)
     int set_variable_metric_selection(VariableMetricSelection* vms = 0) {
       delete vm_selection; vm_selection = vms; return 0;
@@ -309,6 +393,7 @@ namespace ConicBundle {
       VariableMetricModel::set_cbout(cb, incr);
       qpsolver->set_cbout(this);
       uqpsolver.set_cbout(this);
+      qpselector.set_cbout(this);
     }
 
   };
@@ -27,6 +27,7 @@
 #include <limits>
 #include "mymath.hxx"
 #include "LanczMaxEig.hxx"
+#include "timer_registry.hxx"
 
 
 using namespace CH_Tools;
@@ -101,6 +102,7 @@ namespace CH_Matrix_Classes {
 
   int LanczMaxEig::compute(const Lanczosmatrix* bigmat, Matrix& eigval, Matrix& eigvec,
     Integer nreig, Integer in_blocksz, Integer maxj) {
+    CH_Tools::ScopedTimer scoped_timer("LanczMaxEig::compute");
     ncalls++;
     myout = &std::cout;
     print_level = 5;
@@ -138,10 +140,10 @@ namespace CH_Matrix_Classes {
         (*myout) << "LanczMaxEig: n=" << n << " nproposed=" << nproposed << std::endl;
       nchebit = 0;
       nreig = blocksz = nproposed + 1;
-      nblockmult = min(30, n / blocksz - 1);
-      mymaxj = max(max(n / 3, min(500, n)), min(n, max(nreig + nblockmult * blocksz, nreig + 2 * guessmult)));
+      nblockmult = min(Integer(30), n / blocksz - 1);
+      mymaxj = max(max(n / 3, min(Integer(500), n)), min(n, max(nreig + nblockmult * blocksz, nreig + 2 * guessmult)));
       //mymaxj=min(n,max(nreig+nblockmult*blocksz,nreig+2*guessmult));
-      nblockmult = min(min(10, nblockmult), (mymaxj - nreig) / blocksz - 1);
+      nblockmult = min(min(Integer(10), nblockmult), (mymaxj - nreig) / blocksz - 1);
 
       maxj = mymaxj;
       Integer maxmult = maxop;
@@ -173,7 +175,7 @@ namespace CH_Matrix_Classes {
 
     //--- initialize size parameters
 
-    Integer maxnblockmult = min(100, n / blocksz - 1);
+    Integer maxnblockmult = min(Integer(100), n / blocksz - 1);
     if ((choicenbmult < 0) && (choicencheb < 0)) {
       if (n < 300) maxnblockmult = 30; //expect to need this number of Lanczos steps per restart
       else if (n < 1000) maxnblockmult = 50;
@@ -186,10 +188,10 @@ namespace CH_Matrix_Classes {
       } else {
         nchebit = 0;
       }
-      nblockmult = min(10, maxnblockmult);
+      nblockmult = min(Integer(10), maxnblockmult);
     } else {
       if (choicenbmult <= 0)
-        nblockmult = min(10, maxnblockmult);
+        nblockmult = min(Integer(10), maxnblockmult);
       else
         nblockmult = min(choicenbmult, maxnblockmult);
       if (choicencheb < 0) {
@@ -202,7 +204,7 @@ namespace CH_Matrix_Classes {
       } else
         nchebit = choicencheb;
     }
-    mymaxj = max(max(n / 5, min(n, 500)), min(n, max(nreig + maxnblockmult * blocksz, nreig + 2 * guessmult)));
+    mymaxj = max(max(n / 5, min(n, Integer(500))), min(n, max(nreig + maxnblockmult * blocksz, nreig + 2 * guessmult)));
     nblockmult = min(nblockmult, (mymaxj - nreig) / blocksz - 1);
 
 
@@ -261,7 +263,7 @@ namespace CH_Matrix_Classes {
         time_mult_sum += time_mult;
         nmult += nproposed;
         if (nproposed >= 3) {
-          maxval = sum(d(Range(neigfound, neigfound + nproposed - 1))) / nproposed;
+          maxval = sum(d(Range(neigfound, neigfound + nproposed - 1))) / Real(nproposed);
         } else {
           maxval = d(neigfound + 1);
         }
@@ -549,7 +551,7 @@ namespace CH_Matrix_Classes {
     sectn(X, neigfound, blocksz, C, d, u, v, minval);
     nmult += nproposed;
     if (nproposed >= 3) {
-      maxval = sum(d(Range(neigfound, neigfound + nproposed - 1))) / nproposed;
+      maxval = sum(d(Range(neigfound, neigfound + nproposed - 1))) / Real(nproposed);
     } else {
       maxval = d(neigfound + 1);
     }
@@ -2138,9 +2140,9 @@ namespace CH_Matrix_Classes {
 #ifndef __unix
     Real coshpolval = cosh(::log(double(1. / (polval - ::sqrt(double(polval * polval - 1))))) / nchebit);
 #else
-    Real coshpolval = cosh(acosh(polval) / nchebit);
+    Real coshpolval = cosh(acosh(polval) / Real(nchebit));
 #endif
-    Real b = (2 * maxval + (coshpolval - 1.) * a) / (coshpolval / nchebit + 1.);
+    Real b = (2 * maxval + (coshpolval - 1.) * a) / (coshpolval / Real(nchebit) + 1.);
 
     Real ru, rv;
     //T0= ru = 1;
@@ -2349,7 +2351,7 @@ namespace CH_Matrix_Classes {
         continue;
       }
       do {
-        if (l_iter == 30) return l + 1;   //at most 30 iterations
+        if (l_iter == 30) return int(l + 1);   //at most 30 iterations
         l_iter++;
         l1 = l + 1;
 
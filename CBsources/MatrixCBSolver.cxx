@@ -37,11 +37,18 @@
 #include "BoxModel.hxx"
 #include "BundleIdProx.hxx"
 #include "BundleDiagonalTrustRegionProx.hxx"
+#include "BundleDenseTrustRegionProx.hxx"
+#include "BundleLowRankTrustRegionProx.hxx"
+#include "BundleDLRTrustRegionProx.hxx"
 #include "SumBundleParameters.hxx"
 #include "SumModelParameters.hxx"
 
 #include <algorithm>
 #include <map>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <limits>
 
 //------------------------------------------------------------
 
@@ -143,6 +150,7 @@ namespace ConicBundle {
     LPGroundsetModification* gs_modif;
     ModificationTreeData* root;
     FunctionMap  fun_model;
+    std::vector<const FunctionObject*> fun_order; ///< the functions in the order of add_function()
     Clock        myclock;
     std::vector<FunctionOracleWrapper*> wrappers;
 
@@ -257,6 +265,23 @@ namespace ConicBundle {
       return 0;
     }
 
+    /// returns true if modifications of the groundset or of the functions wait for being applied; nothing is changed
+    bool modifications_pending() {
+      FunObjModMap fomm;
+      if ((root) && (root->collect_subtree_modification(fomm)))
+        return true;
+      return (!gs_modif->no_modification()) || (fomm.size() > 0);
+    }
+
+    /// discards the minorants handed to the models by set_model_minorants() or load_state() that were not used
+    void clear_model_replays() {
+      for (unsigned int fi = 0; fi < fun_order.size(); fi++) {
+        NNCModel* nncm = dynamic_cast<NNCModel*>(fun_model[fun_order[fi]]->get_model());
+        if (nncm)
+          nncm->clear_replay();
+      }
+    }
+
     void clear(void) {
       if ((gs_modif) && (apply_modifications())) {
         if (cb_out()) {
@@ -270,6 +295,7 @@ namespace ConicBundle {
       if (root) {
         root->delete_descendants(fun_model);
         fun_model.clear();
+        fun_order.clear();
         delete root;
         root = 0;
       }
@@ -504,8 +530,10 @@ namespace ConicBundle {
 
         if (retval)
           delete mtd;
-        else
+        else {
           data_->fun_model[&function] = mtd;
+          data_->fun_order.push_back(&function);
+        }
       }
     }
 
@@ -850,6 +878,7 @@ namespace ConicBundle {
 
   //--------------------
   int MatrixCBSolver::solve(int maxsteps, bool stop_at_descent_steps) {
+    CH_Tools::ScopedTimer scoped_timer("MatrixCBSolver::solve");
     assert(data_);
 
     if (data_->cb_out(10)) {
@@ -864,6 +893,9 @@ namespace ConicBundle {
       return 1;
     }
 
+    //minorants of set_model_minorants() are only valid for the next center
+    data_->clear_model_replays();
+
     int status = data_->solver.solve(maxsteps, stop_at_descent_steps);
     if (status) {
       if (data_->cb_out()) {
@@ -1306,6 +1338,28 @@ namespace ConicBundle {
     return data_->groundset.set_qpsolver(qpparams, newqpsolver);
   }
 
+  int MatrixCBSolver::set_auto_select_qpsolver(bool auto_select) {
+    assert(data_);
+    data_->groundset.set_auto_select_qpsolver(auto_select);
+    return 0;
+  }
+
+  int MatrixCBSolver::set_auto_select_kktsolver(bool auto_select) {
+    assert(data_);
+    return data_->groundset.set_auto_select_KKTsolver(auto_select);
+  }
+
+  int MatrixCBSolver::set_uqpsolver_reuse_factor(bool reuse, Integer maxit, Real relprec) {
+    assert(data_);
+    data_->groundset.set_uqpsolver_reuse_factor(reuse, maxit, relprec);
+    return 0;
+  }
+
+  int MatrixCBSolver::set_lazy_constraint_rowrep(bool lazy) {
+    assert(data_);
+    return data_->groundset.set_lazy_rowrep(lazy);
+  }
+
   int MatrixCBSolver::set_new_center_point(const Matrix& center_point) {
     assert(data_);
     if (data_->gs_modif->new_vardim() != center_point.dim()) {
@@ -1322,7 +1376,9 @@ namespace ConicBundle {
       return 1;
     }
 
-    return data_->solver.set_new_center(&center_point);
+    int retval = data_->solver.set_new_center(&center_point);
+    data_->clear_model_replays();
+    return retval;
   }
 
   int MatrixCBSolver::adjust_multiplier(void) {
@@ -1349,7 +1405,7 @@ namespace ConicBundle {
       }
       return 1;
     }
-    return data_->groundset.get_dim();
+    return int(data_->groundset.get_dim());
   }
 
   int MatrixCBSolver::get_n_functions() const {
@@ -1359,22 +1415,22 @@ namespace ConicBundle {
 
   int MatrixCBSolver::get_n_oracle_calls() const {
     assert(data_);
-    return data_->solver.get_cntobjeval();
+    return int(data_->solver.get_cntobjeval());
   }
 
   int MatrixCBSolver::get_n_descent_steps() const {
     assert(data_);
-    return data_->solver.get_descent_steps();
+    return int(data_->solver.get_descent_steps());
   }
 
   int MatrixCBSolver::get_n_inner_iterations() const {
     assert(data_);
-    return data_->solver.get_suminnerit();
+    return int(data_->solver.get_suminnerit());
   }
 
   int MatrixCBSolver::get_n_inner_updates() const {
     assert(data_);
-    return data_->solver.get_sumupdatecnt();
+    return int(data_->solver.get_sumupdatecnt());
   }
 
   bool MatrixCBSolver::get_descent_step() const {
@@ -1480,11 +1536,644 @@ namespace ConicBundle {
     return out;
   }
 
+  void MatrixCBSolver::set_timing(bool on) {
+    CH_Tools::TimerRegistry::set_enabled(on);
+  }
+
+  std::ostream& MatrixCBSolver::print_timing(std::ostream& out) const {
+    return CH_Tools::TimerRegistry::print(out);
+  }
+
+  void MatrixCBSolver::reset_timing() {
+    CH_Tools::TimerRegistry::reset();
+  }
+
+  void MatrixCBSolver::get_timing(std::vector<CH_Tools::TimerEntry>& entries) const {
+    CH_Tools::TimerRegistry::get_entries(entries);
+  }
+
   const BundleSolver* MatrixCBSolver::get_solver(void) const {
     assert(data_);
     return &data_->solver;
   }
 
+  //------------------------------------------------------------
+  // support routines for save_state and load_state
+  //------------------------------------------------------------
+
+  // All numbers are written as 8 bytes with the least significant byte
+  // first, Real in the bit pattern of an IEEE 754 double, so that a
+  // snapshot can be read on machines of different byte order.
+
+  static const char cb_state_magic[8] = { 'C', 'B', 'S', 'T', 'A', 'T', 'E', '\0' };
+  static const long long cb_state_version = 2;
+
+  // the kinds of proximal terms in a snapshot
+  enum StateProxKind {
+    state_prox_id = 1,
+    state_prox_diagonal = 2,
+    state_prox_dense = 3,
+    state_prox_lowrank = 4,
+    state_prox_dlr = 5
+  };
+
+  static void write_state_uint(std::ostream& out, std::uint64_t u) {
+    char buf[8];
+    for (int k = 0; k < 8; k++) {
+      buf[k] = char(u & 0xffu);
+      u >>= 8;
+    }
+    out.write(buf, 8);
+  }
+
+  static std::uint64_t read_state_uint(std::istream& in) {
+    unsigned char buf[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    in.read(reinterpret_cast<char*>(buf), 8);
+    std::uint64_t u = 0;
+    for (int k = 8; --k >= 0;)
+      u = (u << 8) | buf[k];
+    return u;
+  }
+
+  static void write_state_int(std::ostream& out, long long i) {
+    write_state_uint(out, std::uint64_t(i));
+  }
+
+  static long long read_state_int(std::istream& in) {
+    return static_cast<long long>(read_state_uint(in));
+  }
+
+  static void write_state_real(std::ostream& out, Real d) {
+    static_assert((sizeof(Real) == sizeof(std::uint64_t)) && (std::numeric_limits<Real>::is_iec559), "save_state requires Real to be an IEEE 754 double");
+    std::uint64_t u;
+    std::memcpy(&u, &d, sizeof(u));
+    write_state_uint(out, u);
+  }
+
+  static Real read_state_real(std::istream& in) {
+    std::uint64_t u = read_state_uint(in);
+    Real d;
+    std::memcpy(&d, &u, sizeof(d));
+    return d;
+  }
+
+  /// a null pointer is written as row dimension -1
+  static void write_state_matrix(std::ostream& out, const Matrix* m) {
+    if (m == 0) {
+      write_state_int(out, -1);
+      return;
+    }
+    write_state_int(out, m->rowdim());
+    write_state_int(out, m->coldim());
+    for (Integer i = 0; i < m->dim(); i++)
+      write_state_real(out, (*m)(i));
+  }
+
+  /** returns 0 on success, @a present is false if a null pointer was
+      written; if @a nr_expected or @a nc_expected are not negative, the
+      dimensions have to match, all entries have to be finite */
+  static int read_state_matrix(std::istream& in, Matrix& m, bool& present,
+    long long nr_expected = -1, long long nc_expected = -1) {
+    long long nr = read_state_int(in);
+    present = (nr >= 0);
+    if (!present) {
+      m.init(0, 1, 0.);
+      return in.fail() ? 1 : 0;
+    }
+    long long nc = read_state_int(in);
+    const long long maxdim = std::numeric_limits<Integer>::max();
+    if ((in.fail()) || (nc < 0) || (nr > maxdim) || (nc > maxdim) ||
+      ((nc > 0) && (nr > maxdim / nc)) ||
+      ((nr_expected >= 0) && (nr != nr_expected)) ||
+      ((nc_expected >= 0) && (nc != nc_expected)))
+      return 1;
+    m.newsize(Integer(nr), Integer(nc));
+    for (Integer i = 0; (!in.fail()) && (i < m.dim()); i++) {
+      Real d = read_state_real(in);
+      if (!std::isfinite(d))
+        return 1;
+      m(i) = d;
+    }
+    chk_set_init(m, 1);
+    return in.fail() ? 1 : 0;
+  }
+
+  /// the dimension of the argument of the function of the model, i.e. after an affine function transformation
+  static Integer state_function_dim(const SumBlockModel* model, Integer dim) {
+    const AFTModel* aftmodel = model->get_aftmodel();
+    if ((aftmodel) && (aftmodel->get_aft()->to_dim() >= 0))
+      return aftmodel->get_aft()->to_dim();
+    return dim;
+  }
+
+  //--------------------
+  int MatrixCBSolver::save_state(std::ostream& out, PrimalDataSerializer* primal_serializer) const {
+    assert(data_);
+
+    if (data_->modifications_pending()) {
+      if (data_->cb_out()) {
+        data_->get_out() << "**** ERROR MatrixCBSolver::save_state(..): modifications of the problem are pending; save the state after solve() or before modifying the problem" << std::endl;
+      }
+      return 1;
+    }
+
+    //--- check that all parts of the state can be saved before writing anything
+    const BundleProxObject* prox = data_->solver.get_prox();
+    int proxkind = 0;
+    if (dynamic_cast<const BundleIdProx*>(prox))
+      proxkind = state_prox_id;
+    else if (dynamic_cast<const BundleDiagonalTrustRegionProx*>(prox))
+      proxkind = state_prox_diagonal;
+    else if (dynamic_cast<const BundleDenseTrustRegionProx*>(prox))
+      proxkind = state_prox_dense;
+    else if (dynamic_cast<const BundleLowRankTrustRegionProx*>(prox))
+      proxkind = state_prox_lowrank;
+    else if (dynamic_cast<const BundleDLRTrustRegionProx*>(prox))
+      proxkind = state_prox_dlr;
+    else {
+      if (data_->cb_out()) {
+        data_->get_out() << "**** ERROR MatrixCBSolver::save_state(..): the state of a user defined proximal term cannot be saved" << std::endl;
+      }
+      return 1;
+    }
+
+    Integer dim = data_->groundset.get_dim();
+    for (unsigned int fi = 0; fi < data_->fun_order.size(); fi++) {
+      if (data_->fun_model.find(data_->fun_order[fi]) == data_->fun_model.end()) {
+        if (data_->cb_out()) {
+          data_->get_out() << "**** ERROR MatrixCBSolver::save_state(..): function " << fi << " has no cutting model" << std::endl;
+        }
+        return 1;
+      }
+    }
+
+    const Matrix& center = data_->solver.get_center_y();
+
+    out.write(cb_state_magic, sizeof(cb_state_magic));
+    write_state_int(out, cb_state_version);
+    write_state_int(out, sizeof(Real));
+    write_state_int(out, dim);
+    write_state_matrix(out, data_->groundset.get_lby());
+    write_state_matrix(out, data_->groundset.get_uby());
+    write_state_matrix(out, (center.dim() == dim) ? &center : 0);
+    write_state_real(out, data_->solver.get_weight());
+    write_state_real(out, data_->solver.get_terminator()->get_termeps());
+
+    //--- proximal term
+    write_state_int(out, proxkind);
+    switch (proxkind) {
+    case state_prox_diagonal:
+    {
+      const BundleDiagonalTrustRegionProx* dp = dynamic_cast<const BundleDiagonalTrustRegionProx*>(prox);
+      write_state_real(out, dp->get_weightu());
+      write_state_matrix(out, &(dp->get_D()));
+      break;
+    }
+    case state_prox_dense:
+    {
+      const BundleDenseTrustRegionProx* dp = dynamic_cast<const BundleDenseTrustRegionProx*>(prox);
+      write_state_real(out, dp->get_weightu());
+      Matrix H(dp->get_H());
+      write_state_matrix(out, &H);
+      break;
+    }
+    case state_prox_lowrank:
+    {
+      const BundleLowRankTrustRegionProx* lp = dynamic_cast<const BundleLowRankTrustRegionProx*>(prox);
+      write_state_real(out, lp->get_weightu());
+      write_state_matrix(out, &(lp->get_vecH()));
+      write_state_matrix(out, &(lp->get_lamH()));
+      break;
+    }
+    case state_prox_dlr:
+    {
+      const BundleDLRTrustRegionProx* lp = dynamic_cast<const BundleDLRTrustRegionProx*>(prox);
+      write_state_real(out, lp->get_weightu());
+      write_state_matrix(out, &(lp->get_D()));
+      write_state_matrix(out, &(lp->get_vecH()));
+      break;
+    }
+    default:
+      break;
+    }
+
+    //--- cutting models
+    bool primal_lost = false;
+    write_state_int(out, Integer(data_->fun_order.size()));
+    for (unsigned int fi = 0; fi < data_->fun_order.size(); fi++) {
+      //models of other than FunctionOracle and MatrixFunctionOracle functions
+      //are not stored, load_state() rebuilds them by one oracle evaluation
+      const NNCModel* nncm = dynamic_cast<const NNCModel*>(data_->fun_model.find(data_->fun_order[fi])->second->get_model());
+      Real center_value;
+      MinorantBundle minorants;
+      if ((nncm == 0) || (nncm->get_model_minorants(center_value, minorants))) {
+        write_state_int(out, 0);
+        continue;
+      }
+      Integer fdim = state_function_dim(nncm, dim);
+      if (nncm->get_data()->get_dim() != fdim) {
+        if (data_->cb_out()) {
+          data_->get_out() << "**** ERROR MatrixCBSolver::save_state(..): the dimension=" << nncm->get_data()->get_dim() << " of the model of function " << fi << " does not match the dimension=" << fdim << " of its argument" << std::endl;
+        }
+        return 1;
+      }
+      write_state_int(out, 1);
+      write_state_real(out, center_value);
+      write_state_int(out, fdim);
+      write_state_int(out, Integer(minorants.size()));
+      for (unsigned int i = 0; i < minorants.size(); i++) {
+        MinorantPointer mp(minorants[i]);
+        Real scaleval;
+        Minorant* mnrt;
+        int n;
+        const Real* coeffs;
+        const int* indices;
+        if ((mp.get_scaleval_and_minorant(scaleval, mnrt)) || (mnrt == 0) ||
+          (mnrt->get_coeffs(n, coeffs, indices)) ||
+          ((indices == 0) && (n > fdim)) ||
+          ((indices) && (n > 0) && (indices[n - 1] >= fdim))) {
+          if (data_->cb_out()) {
+            data_->get_out() << "**** ERROR MatrixCBSolver::save_state(..): retrieving minorant " << i << " of function " << fi << " failed or its coefficients exceed the dimension" << std::endl;
+          }
+          return 1;
+        }
+        write_state_real(out, scaleval * mnrt->offset());
+        Integer nz = 0;
+        for (int j = 0; j < n; j++)
+          if (coeffs[j] != 0.)
+            nz++;
+        write_state_int(out, nz);
+        for (int j = 0; j < n; j++) {
+          if (coeffs[j] != 0.) {
+            write_state_int(out, (indices) ? indices[j] : j);
+            write_state_real(out, scaleval * coeffs[j]);
+          }
+        }
+
+        //primal data (its scaling by the MinorantPointer is stored separately)
+        const PrimalData* primal = mnrt->get_primal();
+        if (primal == 0) {
+          write_state_int(out, 0);
+        } else if (dynamic_cast<const PrimalMatrix*>(primal)) {
+          write_state_int(out, 1);
+          write_state_real(out, scaleval);
+          write_state_matrix(out, dynamic_cast<const PrimalMatrix*>(primal));
+        } else if (primal_serializer) {
+          write_state_int(out, 2);
+          write_state_real(out, scaleval);
+          if (primal_serializer->write_primal(out, *primal)) {
+            if (data_->cb_out()) {
+              data_->get_out() << "**** ERROR MatrixCBSolver::save_state(..): primal_serializer failed to write the primal data of minorant " << i << " of function " << fi << std::endl;
+            }
+            return 1;
+          }
+        } else {
+          primal_lost = true;
+          write_state_int(out, 0);
+        }
+      }
+    }
+
+    if ((primal_lost) && (data_->cb_out())) {
+      data_->get_out() << "**** WARNING MatrixCBSolver::save_state(..): primal data not of type PrimalMatrix is not saved without a PrimalDataSerializer" << std::endl;
+    }
+
+    if (out.fail()) {
+      if (data_->cb_out()) {
+        data_->get_out() << "**** ERROR MatrixCBSolver::save_state(..): writing to the output stream failed" << std::endl;
+      }
+      return 1;
+    }
+    return 0;
+  }
+
+  //--------------------
+  int MatrixCBSolver::load_state(std::istream& in, PrimalDataSerializer* primal_serializer) {
+    assert(data_);
+
+    char magic[sizeof(cb_state_magic)];
+    in.read(magic, sizeof(magic));
+    if ((in.fail()) || (std::memcmp(magic, cb_state_magic, sizeof(magic)) != 0)) {
+      if (data_->cb_out()) {
+        data_->get_out() << "**** ERROR MatrixCBSolver::load_state(..): input is not a state written by save_state()" << std::endl;
+      }
+      return 1;
+    }
+    long long version = read_state_int(in);
+    long long realsize = read_state_int(in);
+    if ((version != cb_state_version) || (realsize != sizeof(Real))) {
+      if (data_->cb_out()) {
+        data_->get_out() << "**** ERROR MatrixCBSolver::load_state(..): state version " << version << " with Real size " << realsize << " is not supported" << std::endl;
+      }
+      return 1;
+    }
+
+    if (data_->apply_modifications()) {
+      if (data_->cb_out()) {
+        data_->get_out() << "**** ERROR MatrixCBSolver::load_state(..): apply_modifications required before loading, but it failed" << std::endl;
+      }
+      return 1;
+    }
+
+    long long dim = read_state_int(in);
+    if (dim != data_->groundset.get_dim()) {
+      if (data_->cb_out()) {
+        data_->get_out() << "**** ERROR MatrixCBSolver::load_state(..): dimension=" << dim << " of the state does not match the current dimension=" << data_->groundset.get_dim() << std::endl;
+      }
+      return 1;
+    }
+
+    //--- read and check everything before changing anything
+    Matrix lb, ub, center, proxD, proxH, proxlam;
+    bool has_lb, has_ub, has_center, present;
+    int err = read_state_matrix(in, lb, has_lb, dim, 1);
+    err = err || read_state_matrix(in, ub, has_ub, dim, 1);
+    err = err || read_state_matrix(in, center, has_center, dim, 1);
+    Real weight = read_state_real(in);
+    Real termeps = read_state_real(in);
+    for (Integer i = 0; (!err) && (i < Integer(dim)); i++) {
+      if ((has_lb ? lb(i) : CB_minus_infinity) > (has_ub ? ub(i) : CB_plus_infinity))
+        err = 1;
+    }
+    if ((std::isnan(weight)) || (std::isnan(termeps)))
+      err = 1;
+
+    BundleProxObject* prox = data_->solver.get_prox();
+    Real proxweight = 0.;
+    long long proxkind = read_state_int(in);
+    bool prox_matches = false;
+    if ((!err) && (!in.fail())) {
+      switch (proxkind) {
+      case state_prox_id:
+        prox_matches = (dynamic_cast<BundleIdProx*>(prox) != 0);
+        break;
+      case state_prox_diagonal:
+        prox_matches = (dynamic_cast<BundleDiagonalTrustRegionProx*>(prox) != 0);
+        proxweight = read_state_real(in);
+        err = read_state_matrix(in, proxD, present, dim, 1) || (!present);
+        break;
+      case state_prox_dense:
+        prox_matches = (dynamic_cast<BundleDenseTrustRegionProx*>(prox) != 0);
+        proxweight = read_state_real(in);
+        err = read_state_matrix(in, proxH, present, dim, dim) || (!present);
+        break;
+      case state_prox_lowrank:
+        prox_matches = (dynamic_cast<BundleLowRankTrustRegionProx*>(prox) != 0);
+        proxweight = read_state_real(in);
+        err = read_state_matrix(in, proxH, present, dim, -1) || (!present);
+        err = err || read_state_matrix(in, proxlam, present, proxH.coldim(), 1) || (!present);
+        break;
+      case state_prox_dlr:
+        prox_matches = (dynamic_cast<BundleDLRTrustRegionProx*>(prox) != 0);
+        proxweight = read_state_real(in);
+        err = read_state_matrix(in, proxD, present, dim, 1) || (!present);
+        err = err || read_state_matrix(in, proxH, present, dim, -1) || (!present);
+        break;
+      default:
+        err = 1;
+        break;
+      }
+      if ((proxkind != state_prox_id) && (!(proxweight > 0.)))
+        err = 1;
+    }
+    if ((err) || (in.fail())) {
+      if (data_->cb_out()) {
+        data_->get_out() << "**** ERROR MatrixCBSolver::load_state(..): reading the bounds, the center or the proximal term failed or they are not consistent" << std::endl;
+      }
+      return 1;
+    }
+    if (!prox_matches) {
+      if (data_->cb_out()) {
+        data_->get_out() << "**** ERROR MatrixCBSolver::load_state(..): the stored proximal term is not of the type of the current one" << std::endl;
+      }
+      return 1;
+    }
+
+    long long nfun = read_state_int(in);
+    if ((in.fail()) || (nfun != Integer(data_->fun_order.size()))) {
+      if (data_->cb_out()) {
+        data_->get_out() << "**** ERROR MatrixCBSolver::load_state(..): reading the state failed or its number of functions does not match" << std::endl;
+      }
+      return 1;
+    }
+
+    //--- read the cutting models
+    std::vector< std::vector<Minorant*> > replay(static_cast<size_t>(nfun));
+    std::vector<Real> center_values(unsigned(nfun), 0.);
+    Matrix primal_mat;
+    std::vector<int> indices;
+    std::vector<double> values;
+    for (unsigned int fi = 0; (!err) && (fi < unsigned(nfun)); fi++) {
+      long long has_model = read_state_int(in);
+      if ((in.fail()) || (has_model < 0) || (has_model > 1)) {
+        err = 1;
+        break;
+      }
+      if (has_model == 0)
+        continue;
+      NNCModel* nncm = dynamic_cast<NNCModel*>(data_->fun_model[data_->fun_order[fi]]->get_model());
+      if (nncm == 0) {
+        if (data_->cb_out()) {
+          data_->get_out() << "**** ERROR MatrixCBSolver::load_state(..): function " << fi << " does not match the stored cutting model" << std::endl;
+        }
+        err = 1;
+        break;
+      }
+      center_values[fi] = read_state_real(in);
+      long long fdim = read_state_int(in);
+      long long nmnrts = read_state_int(in);
+      if ((in.fail()) || (!std::isfinite(center_values[fi])) ||
+        (fdim != state_function_dim(nncm, Integer(dim))) || (nmnrts < 0)) {
+        err = 1;
+        break;
+      }
+      for (long long i = 0; (!err) && (i < nmnrts); i++) {
+        Real offset = read_state_real(in);
+        long long nz = read_state_int(in);
+        if ((in.fail()) || (!std::isfinite(offset)) || (nz < 0) || (nz > fdim)) {
+          err = 1;
+          break;
+        }
+        indices.resize(size_t(nz));
+        values.resize(size_t(nz));
+        for (long long j = 0; (!err) && (j < nz); j++) {
+          long long index = read_state_int(in);
+          values[size_t(j)] = read_state_real(in);
+          //the indices are increasing and within the dimension of the function
+          if ((in.fail()) || (index < ((j > 0) ? indices[size_t(j - 1)] + 1 : 0)) ||
+            (index >= fdim) || (!std::isfinite(values[size_t(j)])))
+            err = 1;
+          else
+            indices[size_t(j)] = int(index);
+        }
+        if (err)
+          break;
+        PrimalData* primal = 0;
+        long long primalkind = read_state_int(in);
+        if ((primalkind < 0) || (primalkind > 2)) {
+          err = 1;
+          break;
+        }
+        if (primalkind != 0) {
+          Real scaleval = read_state_real(in);
+          if ((primalkind == 1) && (std::isfinite(scaleval)) &&
+            (read_state_matrix(in, primal_mat, present) == 0) && (present)) {
+            primal = new PrimalMatrix(primal_mat);
+          } else if ((primalkind == 2) && (std::isfinite(scaleval)) && (primal_serializer)) {
+            primal = primal_serializer->read_primal(in);
+          }
+          if (primal == 0) {
+            if (data_->cb_out()) {
+              data_->get_out() << "**** ERROR MatrixCBSolver::load_state(..): reading the primal data of minorant " << i << " of function " << fi << " failed" << (((primalkind == 2) && (primal_serializer == 0)) ? " (no PrimalDataSerializer given)" : "") << std::endl;
+            }
+            err = 1;
+            break;
+          }
+          if (scaleval != 1.)
+            primal->scale_primal_data(scaleval);
+        }
+        if (in.fail()) {
+          delete primal;
+          err = 1;
+          break;
+        }
+        replay[fi].push_back(new Minorant(true, offset, int(nz), nz ? &values[0] : 0, nz ? &indices[0] : 0, 1., primal));
+      }
+    }
+
+    if (err) {
+      if (data_->cb_out()) {
+        data_->get_out() << "**** ERROR MatrixCBSolver::load_state(..): reading the cutting models failed or they do not match the functions" << std::endl;
+      }
+      for (unsigned int fi = 0; fi < replay.size(); fi++)
+        for (unsigned int i = 0; i < replay[fi].size(); i++)
+          delete replay[fi][i];
+      return 1;
+    }
+
+    //--- restore the settings
+    const Matrix* old_lb = data_->groundset.get_lby();
+    const Matrix* old_ub = data_->groundset.get_uby();
+    for (Integer i = 0; i < Integer(dim); i++) {
+      Real bnd = has_lb ? lb(i) : CB_minus_infinity;
+      if (bnd != (old_lb ? (*old_lb)(i) : CB_minus_infinity))
+        err += set_lower_bound(int(i), bnd);
+      bnd = has_ub ? ub(i) : CB_plus_infinity;
+      if (bnd != (old_ub ? (*old_ub)(i) : CB_plus_infinity))
+        err += set_upper_bound(int(i), bnd);
+    }
+    if (termeps > 0.)
+      set_term_relprec(termeps);
+
+    switch (proxkind) {
+    case state_prox_diagonal:
+    {
+      BundleDiagonalTrustRegionProx* dp = dynamic_cast<BundleDiagonalTrustRegionProx*>(prox);
+      dp->set_weightu(proxweight);
+      proxD -= proxweight;
+      dp->set_D(proxD);
+      break;
+    }
+    case state_prox_dense:
+    {
+      BundleDenseTrustRegionProx* dp = dynamic_cast<BundleDenseTrustRegionProx*>(prox);
+      dp->set_weightu(proxweight);
+      Symmatrix H(proxH);
+      dp->init(H);
+      break;
+    }
+    case state_prox_lowrank:
+    {
+      BundleLowRankTrustRegionProx* lp = dynamic_cast<BundleLowRankTrustRegionProx*>(prox);
+      lp->set_weightu(proxweight);
+      lp->init(proxH, proxlam);
+      break;
+    }
+    case state_prox_dlr:
+    {
+      BundleDLRTrustRegionProx* lp = dynamic_cast<BundleDLRTrustRegionProx*>(prox);
+      lp->set_weightu(proxweight);
+      proxD -= proxweight;
+      lp->init(proxD, proxH);
+      break;
+    }
+    default:
+      break;
+    }
+
+    //--- hand the minorants to the models and set up the center
+    for (unsigned int fi = 0; fi < replay.size(); fi++) {
+      if (replay[fi].size() == 0)
+        continue;
+      dynamic_cast<NNCModel*>(data_->fun_model[data_->fun_order[fi]]->get_model())->set_replay(center_values[fi], replay[fi]);
+    }
+
+    if ((err == 0) && (has_center))
+      err = set_new_center_point(center);
+
+    //minorants not used in the center evaluation are discarded
+    data_->clear_model_replays();
+
+    if (weight > 0.)
+      set_next_weight(weight);
+
+    if (err) {
+      if (data_->cb_out()) {
+        data_->get_out() << "**** ERROR MatrixCBSolver::load_state(..): restoring bounds or center failed" << std::endl;
+      }
+      return 1;
+    }
+    return 0;
+  }
+
+  //--------------------
+  int MatrixCBSolver::set_model_minorants(const FunctionObject& function, double function_value, std::vector<Minorant*>& minorants) {
+    assert(data_);
+
+    int err = 0;
+    FunctionMap::iterator it = data_->fun_model.find(&function);
+    NNCModel* nncm = 0;
+    if (it == data_->fun_model.end()) {
+      if (data_->cb_out()) {
+        data_->get_out() << "**** ERROR MatrixCBSolver::set_model_minorants(...): cannot find this function object in this problem" << std::endl;
+      }
+      err = 1;
+    } else if ((nncm = dynamic_cast<NNCModel*>(it->second->get_model())) == 0) {
+      if (data_->cb_out()) {
+        data_->get_out() << "**** ERROR MatrixCBSolver::set_model_minorants(...): the function is not given by a FunctionOracle or MatrixFunctionOracle" << std::endl;
+      }
+      err = 1;
+    } else if (data_->apply_modifications()) {
+      if (data_->cb_out()) {
+        data_->get_out() << "**** ERROR MatrixCBSolver::set_model_minorants(...): apply_modifications failed" << std::endl;
+      }
+      err = 1;
+    }
+    if ((err == 0) && (minorants.size() > 0)) {
+      Integer fdim = state_function_dim(nncm, data_->groundset.get_dim());
+      for (unsigned int i = 0; (err == 0) && (i < minorants.size()); i++) {
+        int n;
+        const double* coeffs;
+        const int* indices;
+        if ((minorants[i] == 0) || (minorants[i]->get_coeffs(n, coeffs, indices)) ||
+          ((indices == 0) && (n > fdim)) ||
+          ((indices) && (n > 0) && (indices[n - 1] >= fdim))) {
+          if (data_->cb_out()) {
+            data_->get_out() << "**** ERROR MatrixCBSolver::set_model_minorants(...): minorant " << i << " is missing or exceeds the dimension=" << fdim << " of the function" << std::endl;
+          }
+          err = 1;
+        }
+      }
+    }
+    if (err) {
+      for (unsigned int i = 0; i < minorants.size(); i++)
+        delete minorants[i];
+      minorants.clear();
+      return 1;
+    }
+    return nncm->set_replay(function_value, minorants);
+  }
+
 
 } //end namespace ConicBundle
 
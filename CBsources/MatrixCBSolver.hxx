@@ -36,6 +36,7 @@
 
 #include "CBSolver.hxx"
 #include "matrix.hxx"
+#include "sumop.hxx"
 #include "UQPSolver.hxx"
 #include "BundleProxObject.hxx"
 #include "BundleData.hxx"
@@ -44,6 +45,7 @@
 #include "AffineFunctionTransformation.hxx"
 #include "SumBundleParametersObject.hxx"
 #include "BundleSolver.hxx"
+#include "timer_registry.hxx"
 
 //------------------------------------------------------------
 
@@ -275,6 +277,26 @@ or, more generally a matrix, then an approximate primal solution can be generate
       return 1;
     }
 
+    /// if all are PrimalMatrix objects of the same size, add them in one (for large data threaded) pass over *this, otherwise see PrimalData::aggregate_primal_data_batch()
+    int aggregate_primal_data_batch(const std::vector<const PrimalData*>& primals, const DVector& factors) {
+      assert(primals.size() == factors.size());
+      std::vector<const CH_Matrix_Classes::Real*> a;
+      std::vector<CH_Matrix_Classes::Real> f;
+      a.reserve(primals.size());
+      f.reserve(primals.size());
+      for (unsigned int i = 0; i < primals.size(); i++) {
+        if ((primals[i] == 0) || (factors[i] == 0.))
+          continue;
+        const PrimalMatrix* pd = dynamic_cast<const PrimalMatrix*>(primals[i]);
+        if ((pd == 0) || (pd->rowdim() != rowdim()) || (pd->coldim() != coldim()))
+          return PrimalData::aggregate_primal_data_batch(primals, factors);
+        a.push_back(pd->get_store());
+        f.push_back(factors[i]);
+      }
+      CH_Matrix_Classes::sumop_xpeya(dim(), get_store(), CH_Matrix_Classes::Integer(a.size()), a.data(), f.data());
+      return 0;
+    }
+
     /// multiply/scale *this with a nonnegative myfactor
     int scale_primal_data(double myfactor) {
       *this *= myfactor; return 0;
@@ -312,7 +334,13 @@ or, more generally a matrix, then an approximate primal solution can be generate
       assert(subg.coldim() == 1);
     }
 
-    /// initializaton by a Sparsemat column vector; if offset_at_origin==true, the offset gives the value at the origin (in contrast to the value at the current evaluation point)
+    /** @brief initializaton by a Sparsemat column vector; if offset_at_origin==true, the offset gives the value at the origin (in contrast to the value at the current evaluation point)
+
+        Only the column representation of @a subg is read. An oracle that
+        builds large sparse subgradients may therefore call
+        CH_Matrix_Classes::Sparsemat::set_lazy_rowrep(true) on @a subg
+        before initializing it, so that no row representation is generated.
+    */
     MatrixMinorant(CH_Matrix_Classes::Real offset,
       const CH_Matrix_Classes::Sparsemat& subg,
       PrimalData* primal = 0,
@@ -339,6 +367,26 @@ or, more generally a matrix, then an approximate primal solution can be generate
 
   };
 
+  /**@brief Interface for writing and reading user defined PrimalData in MatrixCBSolver::save_state() and MatrixCBSolver::load_state()
+
+     PrimalMatrix data is handled by the solver itself. For any other
+     type of primal data generated by the oracles a serializer has to be
+     supplied, otherwise the primal information of the stored minorants
+     is lost.
+  */
+  class PrimalDataSerializer {
+  public:
+    ///virtual destructor
+    virtual ~PrimalDataSerializer() {
+    }
+
+    /// write @a primal to @a out so that read_primal() can restore it; return 0 on success and nonzero if this type is not supported
+    virtual int write_primal(std::ostream& out, const PrimalData& primal) = 0;
+
+    /// read primal data as written by write_primal() and return a new object (the caller takes over) or 0 on failure
+    virtual PrimalData* read_primal(std::istream& in) = 0;
+  };
+
   /**@brief ModifiableOracle provides all oracles with a uniform interface for a modification routine and an on/off switch for internal correctness checks
    */
   class ModifiableOracleObject : public FunctionObject {
@@ -1738,6 +1786,76 @@ or, more generally a matrix, then an approximate primal solution can be generate
     int set_qp_solver(QPSolverParametersObject* qpparams,
       QPSolverObject* newqpsolver = 0);
 
+    /** @brief Set to true in order to choose between the internal UQPSolver and the general QP solver by measured solve times (default false)
+
+      This only affects unconstrained problems whose prox term would
+      otherwise result in using the UQPSolver, see
+      LPGroundset::set_auto_select_qpsolver(). The setting is reset by
+      clear().
+
+      @param[in] auto_select (bool)
+
+      @return
+        - 0 on success
+        - != 0 otherwise
+    */
+    int set_auto_select_qpsolver(bool auto_select);
+
+    /** @brief Set to true in order to let the internal QPSolver choose its KKT solver by measured solve times and iterations (default false)
+
+      The QPSolver then solves its KKT systems by a QPKKTSolverAutoSelect
+      choosing online, depending on the dimension and the bundle size,
+      among the direct solver and the iterative solvers of
+      QPKKTSolverAutoSelect::add_default_solvers(); with false the
+      QPDirectKKTSolver is used again. See
+      LPGroundset::set_auto_select_KKTsolver().
+
+      @param[in] auto_select (bool)
+
+      @return
+        - 0 on success
+        - != 0 otherwise (the internal solver is not a QPSolver)
+    */
+    int set_auto_select_kktsolver(bool auto_select);
+
+    /** @brief Set to true in order to allow the internal UQPSolver to reuse the factorization of earlier interior point steps (default false)
+
+      Later steps are then solved by preconditioned conjugate gradients
+      with the earlier factorization and the system is only factorized
+      anew if this needs more than @a maxit iterations for reaching the
+      relative residual precision @a relprec, see
+      UQPSolver::set_reuse_factor(). Solvers for the general QP are
+      configured via set_qp_solver(), e.g. by
+      QPDirectKKTSolver::set_reuse_factor(). The setting is reset by
+      clear().
+
+      @param[in] reuse (bool)
+
+      @param[in] maxit (Integer)
+
+      @param[in] relprec (Real)
+
+      @return
+        - 0 on success
+        - != 0 otherwise
+    */
+    int set_uqpsolver_reuse_factor(bool reuse, CH_Matrix_Classes::Integer maxit = 5, CH_Matrix_Classes::Real relprec = 1e-6);
+
+    /** @brief Set to false in order to keep the row representation of the matrix of the linear constraints (default true, i.e., it is only built if a routine needs it)
+
+      The default QP solver only multiplies the constraint matrix with
+      dense vectors, which is done via its columns, so without rows the
+      matrix needs about half the memory, see LPGroundset::set_lazy_rowrep().
+      The memory in use is reported by print_statistics().
+
+      @param[in] lazy (bool)
+
+      @return
+        - 0 on success
+        - != 0 if the QP solver does not support this
+    */
+    int set_lazy_constraint_rowrep(bool lazy);
+
     //@}
 
     //------------------------------------------------------------
@@ -1830,6 +1948,96 @@ or, more generally a matrix, then an approximate primal solution can be generate
 
     //@}
 
+    //------------------------------------------------------------
+    /**@name Saving and restoring the state of the solver */
+    //@{
+
+    /** @brief write the current state of the solver to @a out in a versioned binary format so that load_state() can resume the computation without reevaluating the oracles
+
+        The snapshot contains the bounds on the variables, the center of
+        stability, the weight, the termination precision, the proximal
+        term (BundleIdProx, BundleDiagonalTrustRegionProx,
+        BundleDenseTrustRegionProx, BundleLowRankTrustRegionProx or
+        BundleDLRTrustRegionProx) and, for each function in the order of
+        add_function(), the value in the center together with the
+        minorants of its cutting model. If the model contributes to a
+        SumBundle, only its local minorants are stored; the aggregate of
+        the SumBundle is not stored and is started anew from them, as in
+        the first evaluation of a new problem.
+
+        Only cutting models of functions given by FunctionOracle or
+        MatrixFunctionOracle interfaces (also behind an
+        AffineFunctionTransformation) are stored. For all other
+        functions (PSCOracle, SOCOracle, BoxOracle) the snapshot only
+        records that the model is missing and load_state() rebuilds it
+        by one evaluation of the oracle in the center; the value of such
+        a function in the center may then differ from the saved one
+        within the precision of the evaluation. If a user
+        defined proximal term is in use or if modifications of the
+        problem are still pending (they are applied by the next
+        solve()), nothing is written and an error is returned. The
+        solver is not changed.
+
+        The primal data of the minorants is written for PrimalMatrix
+        objects and, via @a primal_serializer, for any other type.
+        All numbers are stored in little endian byte order; data
+        written by @a primal_serializer is stored as given.
+
+        The problem description itself is not stored. Before calling
+        load_state() the same problem has to be set up again by
+        init_problem() and add_function() (in the same order).
+
+        @return 0 on success, nonzero otherwise
+    */
+    int save_state(std::ostream& out,
+      PrimalDataSerializer* primal_serializer = 0) const;
+
+    /** @brief read a snapshot written by save_state() into a solver that has been set up for the same problem
+
+        The whole snapshot is read and checked first: the dimensions
+        and the type of the proximal term have to match the current
+        setting, the bounds have to be consistent and each minorant
+        has to have increasing indices within the dimension of its
+        function. If any check fails, an error is returned and the
+        solver is not changed (except for applying pending
+        modifications). Otherwise the bounds, the weight and the
+        proximal term are restored, the stored minorants are handed to
+        the cutting models and the center is set via
+        set_new_center_point(). The models use the stored center values
+        and minorants instead of calling the oracles in this first
+        evaluation; only functions whose model was not stored (see
+        save_state()) call their oracle once. A subsequent solve()
+        continues from this state.
+
+        @return 0 on success, nonzero otherwise
+    */
+    int load_state(std::istream& in,
+      PrimalDataSerializer* primal_serializer = 0);
+
+    /** @brief hand minorants of @a function, e.g. known from an earlier computation, to its cutting model in one call
+
+        The minorants are taken over (@a minorants is empty on return).
+        They have to be minorants of the function as returned by its
+        oracle (without function factor) and @a function_value has to
+        be the value of the function in the point of the next call to
+        set_new_center_point(). In the evaluation of this point the
+        model uses the minorants instead of calling the oracle, unless
+        one of them exceeds @a function_value there; then they are
+        discarded and the oracle is called as usual. Minorants not
+        used by the next set_new_center_point() are discarded by it
+        or by solve().
+
+        This is only available for functions given by FunctionOracle
+        or MatrixFunctionOracle interfaces.
+
+        @return 0 on success, nonzero otherwise (the minorants are deleted then)
+    */
+    int set_model_minorants(const FunctionObject& function,
+      double function_value,
+      std::vector<Minorant*>& minorants);
+
+    //@}
+
     //------------------------------------------------------------
     /**@name Output */
     //@{
@@ -1901,6 +2109,26 @@ Column 1      2     3   4   5    6       7       8          9
     /// print a cryptic summary of computation times of important components
     std::ostream& print_statistics(std::ostream& out) const;
 
+    /** @brief switch the collection of the hierarchical timing and counting
+        statistics of CH_Tools::TimerRegistry on or off (default off)
+
+        The timers are nested along the calls from the solver through the
+        tree of function models down to the oracles, the quadratic
+        subproblem solver, its KKT systems and the Lanczos method. The
+        registry is shared by all solvers of the process and collects the
+        data of all threads.
+    */
+    void set_timing(bool on);
+
+    /// print the tree of timers and counters of CH_Tools::TimerRegistry
+    std::ostream& print_timing(std::ostream& out) const;
+
+    /// set all timers and counters of CH_Tools::TimerRegistry to zero
+    void reset_timing();
+
+    /// stores the tree of timers and counters of CH_Tools::TimerRegistry in depth first order
+    void get_timing(std::vector<CH_Tools::TimerEntry>& entries) const;
+
     const BundleSolver* get_solver(void) const;
 
     //@}
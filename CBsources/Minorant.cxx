@@ -26,6 +26,8 @@
 
 #include "CBSolver.hxx"
 #include "matrix.hxx"
+#include "thread_placement.hxx"
+#include "thread_pool.hxx"
 
 #include <algorithm>
 #include <map>
@@ -90,6 +92,9 @@ namespace ConicBundle {
     Integer nz_cnt;
     bool sparse;
     bool clean;
+#if (CONICBUNDLE_LONG_INDEX>=1)
+    std::vector<int> int_ind; ///< copy of the indices for get_coeffs(), only needed if Integer is not int
+#endif
 
 
     MinorantData(const Minorant::MinorantData& md, Real factor = 1., bool with_primal = false) :
@@ -110,7 +115,7 @@ namespace ConicBundle {
       offset = ofs;
       offset_at_origin = oao;
       maxindex = -1;
-      rne = max(rne, 0);
+      rne = max(rne, Integer(0));
       vecval.newsize(rne, 1);
       vecval.init(0, 1, 0.);
       vecind.init(0, 1, Integer(0));
@@ -129,7 +134,8 @@ namespace ConicBundle {
     int make_clean(Real tol = CB_minorant_zero_tolerance, Real spratio = CB_minorant_sparsity_ratio);
     int make_dense(Integer maxindex);
     int prepare_for_changes(Integer maxindex, Integer new_nz);
-    int reassign_coeffs(Integer nel, const Integer* map_to_old);
+    int reassign_coeffs(Integer nel, const int* map_to_old);
+    int delete_coeffs(Integer n_del, const int* del_ind);
     int scale(Real factor);
     Real norm_squared();
 
@@ -198,7 +204,7 @@ namespace ConicBundle {
     if (clean) {
       if (!sparse) {
         //nz_cnt is already determined but 
-        if (nz_cnt < (maxindex + 1) * spratio) {
+        if (Real(nz_cnt) < Real(maxindex + 1) * spratio) {
           //switch to sparse
           if (vecind.rowdim() == nz_cnt) {
             //all data available, shrink vecval;
@@ -216,6 +222,8 @@ namespace ConicBundle {
             return 0;
           }
           //here we need to compute vecind, this is done below, continue there
+          //and count the nonzeros again for the tolerance used there
+          clean = false;
         } else {
           return 0;
         }
@@ -270,7 +278,7 @@ namespace ConicBundle {
       } else {
         maxindex = -1;
       }
-      if (nz_cnt >= (maxindex + 1) * spratio) {
+      if (Real(nz_cnt) >= Real(maxindex + 1) * spratio) {
         //switch to dense representation
         vecval.enlarge_below(maxindex + 1 - nz_cnt, 0.);
         const Integer* const vecindp = vecind.get_store();
@@ -303,7 +311,7 @@ namespace ConicBundle {
       nz_cnt = cnt;
       vecind.init(0, 1, Integer(0));
     }
-    if (nz_cnt < (maxindex + 1) * spratio) {
+    if (Real(nz_cnt) < Real(maxindex + 1) * spratio) {
       //switch from dense to sparse
       //for this determine the indices first
       if (nz_cnt != vecind.rowdim()) {
@@ -386,7 +394,7 @@ namespace ConicBundle {
   int Minorant::MinorantData::prepare_for_changes(Integer new_maxind, Integer new_nz) {
     if (!sparse) {
       //
-      if ((new_maxind + 1) * CB_minorant_sparsity_ratio > max(maxindex, new_nz)) {
+      if (Real(new_maxind + 1) * CB_minorant_sparsity_ratio > Real(max(maxindex, new_nz))) {
         //switch to sparse
         if ((!clean) || (nz_cnt != vecind.dim())) {
           vecind.newsize(max(new_maxind, maxindex), 1); chk_set_init(vecind, 1);
@@ -425,7 +433,7 @@ namespace ConicBundle {
       new_maxind = maxindex;
     }
     int err = 0;
-    if ((new_maxind + 1) * CB_minorant_sparsity_ratio < new_nz + nz_cnt) {
+    if (Real(new_maxind + 1) * CB_minorant_sparsity_ratio < Real(new_nz + nz_cnt)) {
       err = make_dense(new_maxind);
     }
     clean = false;
@@ -470,7 +478,7 @@ namespace ConicBundle {
   //                               Minorant::MinorantData::reassign_coeffs
   // *****************************************************************************
 
-  int Minorant::MinorantData::reassign_coeffs(Integer nel, const Integer* map_to_old) {
+  int Minorant::MinorantData::reassign_coeffs(Integer nel, const int* map_to_old) {
     if ((!clean) && (make_clean()))
       return 1;
     normsqu = -1.;
@@ -506,7 +514,64 @@ namespace ConicBundle {
   }
 
   // *****************************************************************************
-  //                               Minorant::MinorantData::reassign_coeffs
+  //                               Minorant::MinorantData::delete_coeffs
+  // *****************************************************************************
+
+  int Minorant::MinorantData::delete_coeffs(Integer n_del, const int* del_ind) {
+    if ((!clean) && (make_clean()))
+      return 1;
+    if ((n_del <= 0) || (*del_ind > maxindex))
+      return 0;
+    normsqu = -1.;
+    Integer d = 0;
+    if (sparse) {
+      Integer* vind = vecind.get_store();
+      Real* vval = vecval.get_store();
+      Integer i = Integer(std::lower_bound(vind, vind + nz_cnt, Integer(*del_ind)) - vind);
+      Integer cnt = i;
+      for (; i < nz_cnt; i++) {
+        Integer ind = vind[i];
+        while ((d < n_del) && (del_ind[d] < ind))
+          d++;
+        if ((d < n_del) && (del_ind[d] == ind))
+          continue;
+        vind[cnt] = ind - d;
+        vval[cnt] = vval[i];
+        cnt++;
+      }
+      nz_cnt = cnt;
+      vecind.reduce_length(cnt);
+      vecval.reduce_length(cnt);
+      maxindex = (cnt > 0) ? vind[cnt - 1] : -1;
+    } else {
+      //only the part behind the first deleted index changes, keep nz_cnt
+      //up to date so that the minorant stays clean
+      Real* vval = vecval.get_store();
+      const Real abstol = CB_minorant_zero_tolerance * (1. + std::fabs(offset));
+      Integer cnt = *del_ind;
+      for (Integer i = cnt; i <= maxindex; i++) {
+        if ((d < n_del) && (del_ind[d] == i)) {
+          if (std::fabs(vval[i]) > abstol)
+            nz_cnt--;
+          d++;
+          continue;
+        }
+        vval[cnt++] = vval[i];
+      }
+      //entries beyond maxindex have to be zero
+      mat_xea(maxindex + 1 - cnt, vval + cnt, 0.);
+      maxindex = cnt - 1;
+      //the indices of the nonzeros are recomputed when needed
+      vecind.init(0, 1, Integer(0));
+      if (nz_cnt <= 0)
+        clean = false;
+    }
+
+    return 0;
+  }
+
+  // *****************************************************************************
+  //                               Minorant::MinorantData::scale
   // *****************************************************************************
 
   int Minorant::MinorantData::scale(Real factor) {
@@ -648,7 +713,7 @@ namespace ConicBundle {
   int Minorant::add_coeff(int ind, double val) {
     assert(ind >= 0);
     data->normsqu = -1.;
-    Integer new_maxind = max(data->maxindex, ind);
+    Integer new_maxind = max(data->maxindex, Integer(ind));
     int err = data->prepare_for_changes(new_maxind, 1);
     assert(!data->clean);
     if (data->sparse) {
@@ -685,14 +750,14 @@ namespace ConicBundle {
     }
     assert(coeff);
     assert(start_pos >= 0);
-    Integer new_maxind = max(nel + start_pos - 1, data->maxindex);
+    Integer new_maxind = max(Integer(nel + start_pos - 1), data->maxindex);
     data->make_dense(new_maxind);
     data->vecind.init(0, 1, Integer(0));
     data->clean = false;
     Real* vval = data->vecval.get_store() + start_pos;
     const Real* cval = coeff;
     if (start_pos <= data->maxindex) {
-      const Real* const vend = vval + min(nel, data->maxindex + 1 - start_pos);
+      const Real* const vend = vval + min(Integer(nel), data->maxindex + 1 - start_pos);
       while (vval != vend)
         (*vval++) += factor * (*cval++);
     }
@@ -721,8 +786,8 @@ namespace ConicBundle {
 
     //--- check whether a clean state can be kept and find new maxind
     Integer new_maxind = data->maxindex;
-    const Integer* const ipend = indices + nel;
-    const Integer* ip = indices;
+    const int* const ipend = indices + nel;
+    const int* ip = indices;
     if ((data->clean == true) && ((data->sparse) || (data->vecval.dim() == 0))) {
       while ((ip != ipend) && (new_maxind < *ip)) {
         new_maxind = *ip++;
@@ -749,7 +814,7 @@ namespace ConicBundle {
     data->prepare_for_changes(new_maxind, new_nz);
     if (data->sparse) {
       assert((data->nz_cnt == data->vecind.dim()) && (data->nz_cnt == data->vecval.dim()));
-      data->vecind.enlarge_below(Integer(nel), (const Integer*)indices);
+      data->vecind.enlarge_below(Integer(nel), indices);
       data->vecval.enlarge_below(Integer(nel), (const Real*)coeff, Real(factor));
       data->nz_cnt += nel;
     } else {
@@ -778,7 +843,7 @@ namespace ConicBundle {
 
   int Minorant::nonzeros() {
     data->make_clean();
-    return data->nz_cnt;
+    return int(data->nz_cnt);
   }
 
   // *****************************************************************************
@@ -790,11 +855,18 @@ namespace ConicBundle {
     if (!data->clean)
       err = data->make_clean();
     if (data->sparse) {
-      nel = data->nz_cnt;
+      nel = int(data->nz_cnt);
       coeffs = data->vecval.get_store();
+#if (CONICBUNDLE_LONG_INDEX>=1)
+      data->int_ind.resize(std::size_t(data->nz_cnt + 1));
+      for (Integer i = 0; i < data->nz_cnt; i++)
+        data->int_ind[std::size_t(i)] = int(data->vecind(i));
+      indices = &(data->int_ind[0]);
+#else
       indices = data->vecind.get_store();
+#endif
     } else {
-      nel = data->maxindex + 1;
+      nel = int(data->maxindex + 1);
       coeffs = data->vecval.get_store();
       indices = 0;
     }
@@ -807,7 +879,7 @@ namespace ConicBundle {
 
   double* Minorant::get_dense_coeff_store(int nel) {
     data->normsqu = -1.;
-    Integer new_maxind = max(nel - 1, data->maxindex);
+    Integer new_maxind = max(Integer(nel - 1), data->maxindex);
     data->make_dense(new_maxind);
     data->vecind.init(0, 1, Integer(0));
     data->clean = false;
@@ -823,6 +895,14 @@ namespace ConicBundle {
     return data->reassign_coeffs(nel, map_to_old);
   }
 
+  // *****************************************************************************
+  //                             delete_coeffs
+  // *****************************************************************************
+
+  int Minorant::delete_coeffs(int n_del, const int* del_ind) {
+    return data->delete_coeffs(n_del, del_ind);
+  }
+
   // *****************************************************************************
   //                             scale
   // *****************************************************************************
@@ -873,7 +953,8 @@ namespace ConicBundle {
     data->normsqu = -1.;
     if (mnrt.get_primal()) {
       if (data->primal == 0) {
-        if (data->nz_cnt != 0)
+        //coefficients without primal data (nz_cnt is only counted in the clean state)
+        if (data->maxindex >= 0)
           err0 = 1;
         data->primal = mnrt.get_primal()->clone_primal_data();
         if ((factor != 1.) && (data->primal))
@@ -884,21 +965,197 @@ namespace ConicBundle {
     }
     data->n_aggregated += mnrt.number_aggregated();
     int err1 = add_offset(mnrt.offset() * factor);
-    Integer n;
+    int n;
     const Real* cp;
-    const Integer* ip;
+    const int* ip;
     if (mnrt.get_coeffs(n, cp, ip))
       return 1;
     int err2 = add_coeffs(n, cp, ip, factor);
     return err0 + err1 + err2;
   }
 
+  // *****************************************************************************
+  //                            aggregate_batch()
+  // *****************************************************************************
+
+  // Minorant::aggregate_batch() accumulates the coefficients in chunks of
+  // this many coordinates, so that the chunk of the aggregate stays in
+  // cache while all minorants are added to it
+  static const Integer CB_minorant_aggregate_chunk = 2048;
+
+  // ... and uses one more thread for each such amount of work (coordinates
+  // of the dense minorants plus nonzeros of the sparse minorants)
+  static const Integer CB_minorant_aggregate_minwork_thread = 1 << 19;
+
+  /// the coefficient arrays of the minorants collected in Minorant::aggregate_batch()
+  struct MinorantAggregateTerms {
+    std::vector<const Real*> dval; ///< the dense coefficient arrays
+    std::vector<Integer> dlen;     ///< their lengths
+    std::vector<Real> dfac;        ///< their factors
+    std::vector<const Real*> sval; ///< the nonzero values of the sparse minorants
+    std::vector<const int*> sind;  ///< their indices in strictly increasing order
+    std::vector<Integer> snz;      ///< their number of nonzeros
+    std::vector<Real> sfac;        ///< their factors
+  };
+
+  // adds all terms to the coordinates lo,...,hi-1 of v 
+  static void minorant_aggregate_range(const MinorantAggregateTerms* terms,
+    Integer lo, Integer hi, Real* v) {
+    const std::size_t nd = terms->dval.size();
+    const std::size_t ns = terms->sval.size();
+
+    //position of the first index >= lo in each sparse minorant
+    std::vector<Integer> pos(ns);
+    for (std::size_t j = 0; j < ns; j++) {
+      const int* ind = terms->sind[j];
+      pos[j] = Integer(std::lower_bound(ind, ind + terms->snz[j], int(lo)) - ind);
+    }
+
+    for (Integer clo = lo; clo < hi; clo += CB_minorant_aggregate_chunk) {
+      const Integer chi = min(hi, clo + CB_minorant_aggregate_chunk);
+
+      //dense terms, four at a time if they cover the chunk
+      std::size_t j = 0;
+      while (j < nd) {
+        if ((j + 3 < nd) &&
+          (terms->dlen[j] >= chi) && (terms->dlen[j + 1] >= chi) &&
+          (terms->dlen[j + 2] >= chi) && (terms->dlen[j + 3] >= chi)) {
+          const Real* a0 = terms->dval[j];
+          const Real* a1 = terms->dval[j + 1];
+          const Real* a2 = terms->dval[j + 2];
+          const Real* a3 = terms->dval[j + 3];
+          const Real f0 = terms->dfac[j];
+          const Real f1 = terms->dfac[j + 1];
+          const Real f2 = terms->dfac[j + 2];
+          const Real f3 = terms->dfac[j + 3];
+          for (Integer i = clo; i < chi; i++)
+            v[i] += f0 * a0[i] + f1 * a1[i] + f2 * a2[i] + f3 * a3[i];
+          j += 4;
+          continue;
+        }
+        const Integer e = min(chi, terms->dlen[j]);
+        if (e > clo)
+          mat_xpeya(e - clo, v + clo, terms->dval[j] + clo, terms->dfac[j]);
+        j++;
+      }
+
+      //sparse terms
+      for (std::size_t k = 0; k < ns; k++) {
+        const int* ind = terms->sind[k];
+        const Real* val = terms->sval[k];
+        const Real f = terms->sfac[k];
+        const Integer nz = terms->snz[k];
+        Integer h = pos[k];
+        for (; (h < nz) && (ind[h] < chi); h++)
+          v[ind[h]] += f * val[h];
+        pos[k] = h;
+      }
+    }
+  }
+
+  int Minorant::aggregate_batch(const std::vector<const Minorant*>& mnrts, const DVector& factors) {
+    assert(mnrts.size() == factors.size());
+    int err = 0;
+
+    //--- offsets, primal data and the coefficient arrays of all minorants
+    MinorantAggregateTerms terms;
+    Integer new_maxind = data->maxindex;
+    Real add_ofs = 0.;
+    Integer work = 0;
+    std::vector<const PrimalData*> primals;
+    DVector pfactors;
+    //as in aggregate(), primal data arriving after coefficients without primal is an error;
+    //the coefficients of the batch count as aggregated once they are collected
+    bool coeffs_wo_primal = (data->primal == 0) && (data->maxindex >= 0);
+    for (std::size_t i = 0; i < mnrts.size(); i++) {
+      const Minorant* mnrt = mnrts[i];
+      const Real factor = factors[i];
+      if ((mnrt == 0) || (factor == 0.))
+        continue;
+      assert(mnrt != this);
+      if (mnrt->get_primal()) {
+        if (data->primal == 0) {
+          if (coeffs_wo_primal)
+            err++;
+          data->primal = mnrt->get_primal()->clone_primal_data();
+          if ((factor != 1.) && (data->primal))
+            data->primal->scale_primal_data(factor);
+        } else {
+          primals.push_back(mnrt->get_primal());
+          pfactors.push_back(factor);
+        }
+      }
+      data->n_aggregated += mnrt->number_aggregated();
+      add_ofs += mnrt->offset() * factor;
+      int n;
+      const Real* cp;
+      const int* ip;
+      if (mnrt->get_coeffs(n, cp, ip)) {
+        err++;
+        continue;
+      }
+      if (n == 0)
+        continue;
+      if (data->primal == 0)
+        coeffs_wo_primal = true;
+      if (ip == 0) {
+        terms.dval.push_back(cp);
+        terms.dlen.push_back(Integer(n));
+        terms.dfac.push_back(factor);
+        new_maxind = max(new_maxind, Integer(n - 1));
+      } else {
+        terms.sval.push_back(cp);
+        terms.sind.push_back(ip);
+        terms.snz.push_back(Integer(n));
+        terms.sfac.push_back(factor);
+        new_maxind = max(new_maxind, Integer(ip[n - 1]));
+      }
+      work += Integer(n);
+    }
+    //the primal data is aggregated in one call, see PrimalData::aggregate_primal_data_batch()
+    if (!primals.empty())
+      err += data->primal->aggregate_primal_data_batch(primals, pfactors);
+    err += add_offset(add_ofs);
+    if (work == 0)
+      return err;
+
+    //--- add all coefficients to the dense representation of this
+    data->normsqu = -1.;
+    const Integer old_maxind = data->maxindex;
+    data->make_dense(new_maxind);
+    data->vecind.init(0, 1, Integer(0));
+    data->clean = false;
+    data->maxindex = new_maxind;
+    Real* v = data->vecval.get_store();
+    //beyond the old maxindex the dense storage may hold outdated values
+    if (new_maxind > old_maxind)
+      mat_xea(new_maxind - old_maxind, v + old_maxind + 1, 0.);
+    const Integer dim = new_maxind + 1;
+
+    Integer nt = min(Integer(CH_Tools::ThreadPlacement::n_processors()),
+      min(work / CB_minorant_aggregate_minwork_thread + 1,
+        (dim + CB_minorant_aggregate_chunk - 1) / CB_minorant_aggregate_chunk));
+    if (nt <= 1) {
+      minorant_aggregate_range(&terms, 0, dim, v);
+      return err;
+    }
+    //each task adds to a range of whole chunks of the coordinates
+    Integer nchunks = (dim + CB_minorant_aggregate_chunk - 1) / CB_minorant_aggregate_chunk;
+    CH_Tools::ThreadPool::run(int(nt), [&terms, dim, nchunks, nt, v](int t) {
+      Integer lo = min(dim, ((nchunks * t) / nt) * CB_minorant_aggregate_chunk);
+      Integer hi = min(dim, ((nchunks * (t + 1)) / nt) * CB_minorant_aggregate_chunk);
+      minorant_aggregate_range(&terms, lo, hi, v);
+    });
+
+    return err;
+  }
+
   // *****************************************************************************
   //                            aggregate()
   // *****************************************************************************
 
   int Minorant::number_aggregated() const {
-    return data->n_aggregated;
+    return int(data->n_aggregated);
   }
 
   // *****************************************************************************
@@ -150,9 +150,9 @@ namespace ConicBundle {
       return true;
     if (mp->offset() != 0.)
       return false;
-    Integer n;
+    int n;
     const Real* cp;
-    const Integer* ip;
+    const int* ip;
     if (mp->get_coeffs(n, cp, ip))
       return false;
     if (n == 0)
@@ -271,6 +271,7 @@ namespace ConicBundle {
 
     md->evals.clear();
     Minorant* mp = md->get_minorant();
+    std::vector<int> int_ind;  //for passing indices to the int interface of Minorant
 
     //unless apply_costs==true appended values are assumed to be zero and are filled in afterwards
     if (apply_costs) {
@@ -278,7 +279,7 @@ namespace ConicBundle {
 
       const Matrix* costs = gsmdf.get_append_costs();
       if (costs) {
-        if (mp->add_coeffs(costs->dim(), costs->get_store(), 1., gsmdf.old_vardim())) {
+        if (mp->add_coeffs(int(costs->dim()), costs->get_store(), 1., int(gsmdf.old_vardim()))) {
           md->set_modification_id() = -1;
           return 1;
         }
@@ -286,7 +287,15 @@ namespace ConicBundle {
     }
 
     if (gsmdf.map_to_old_variables()) {
-      if (mp->reassign_coeffs(gsmdf.map_to_old_variables()->dim(), gsmdf.map_to_old_variables()->get_store())) {
+      if (gsmdf.map_to_old_variables_increasing()) {
+        //only deletions, this need not touch the coefficients in front of the first deleted index
+        const Indexmatrix* delind = gsmdf.deleted_var_indices();
+        if ((delind) && (delind->dim() > 0) &&
+          (mp->delete_coeffs(int(delind->dim()), int_store(*delind, int_ind)))) {
+          md->set_modification_id() = -1;
+          return 1;
+        }
+      } else if (mp->reassign_coeffs(int(gsmdf.map_to_old_variables()->dim()), int_store(*gsmdf.map_to_old_variables(), int_ind))) {
         md->set_modification_id() = -1;
         return 1;
       }
@@ -303,7 +312,7 @@ namespace ConicBundle {
         mp->scale_minorant(md->scaleval);
         md->scaleval = 1.;
       }
-      int status = mex->extend(*mp, int(gsmdf.appended_vardim()), (const int*)(gsmdf.new_var_indices()->get_store()));
+      int status = mex->extend(*mp, int(gsmdf.appended_vardim()), int_store(*gsmdf.new_var_indices(), int_ind));
       if (status) {
         md->set_modification_id() = -1;
         return status;
@@ -386,9 +395,9 @@ namespace ConicBundle {
       return 1;
     if (mp == 0)
       return 1;
-    Integer n;
+    int n;
     const Real* cp;
-    const Integer* ip;
+    const int* ip;
     if (mp->get_coeffs(n, cp, ip))
       return 1;
     Integer rdim = mat.rowdim();
@@ -418,7 +427,7 @@ namespace ConicBundle {
       offset = alpha * mp->offset();
       if ((skip_fixed == 0) || (skip_fixed->dim() == 0)) {
         if (ip == 0) {
-          n = min(n, rdim);
+          n = int(min(Integer(n), rdim));
           mat_xeya(n, matp, cp, alpha);
           mat_xea(rdim - n, matp + n, 0.);
         } else {
@@ -439,7 +448,7 @@ namespace ConicBundle {
         const Integer* sfp = skip_fixed->get_store();
         const Real* fvp = fixed_vals->get_store();
         if (ip == 0) {
-          n = min(n, rdim + sn);
+          n = int(min(Integer(n), rdim + sn));
           Integer skipi = 0;
           Integer k = 0;
           while ((k < sn) && (*sfp < n)) {
@@ -494,7 +503,7 @@ namespace ConicBundle {
       offset += alpha * mp->offset();
       if ((skip_fixed == 0) || (skip_fixed->dim() == 0)) {
         if (ip == 0) {
-          n = min(n, rdim);
+          n = int(min(Integer(n), rdim));
           mat_xpeya(n, matp, cp, alpha);
         } else {
           for (Integer h = n; --h >= 0;) {
@@ -510,7 +519,7 @@ namespace ConicBundle {
         const Integer* sfp = skip_fixed->get_store();
         const Real* fvp = fixed_vals->get_store();
         if (ip == 0) {
-          n = min(n, rdim + sn);
+          n = int(min(Integer(n), rdim + sn));
           Integer skipi = 0;
           Integer k = 0;
           while ((k < sn) && (*sfp < n)) {
@@ -607,9 +616,9 @@ namespace ConicBundle {
 
     out_mnrt->add_offset(in_mnrt->offset() * alpha);
 
-    Integer n;
+    int n;
     const Real* cp;
-    const Integer* ip;
+    const int* ip;
     if (in_mnrt->get_coeffs(n, cp, ip))
       return 1;
 
@@ -671,9 +680,9 @@ namespace ConicBundle {
 
     out_mnrt->add_offset(in_mnrt->offset() * alpha);
 
-    Integer n;
+    int n;
     const Real* cp;
-    const Integer* ip;
+    const int* ip;
     if (in_mnrt->get_coeffs(n, cp, ip))
       return 1;
 
@@ -686,12 +695,13 @@ namespace ConicBundle {
     //if provided_row_indices are given, reduce the elements to those needed
     Matrix tmpcp;
     Indexmatrix tmpip;
+    std::vector<int> int_ind;
     if (provided_row_indices) {
       Integer pdim = provided_row_indices->dim();
       if (ip == 0) {
         //dense case
         Integer cnt = 0;
-        tmpcp.newsize(min(pdim, n), 1); chk_set_init(tmpcp, 1);
+        tmpcp.newsize(min(pdim, Integer(n)), 1); chk_set_init(tmpcp, 1);
         const Integer* ind = provided_row_indices->get_store();
         Real* val = tmpcp.get_store();
         for (; (cnt < pdim) && (*ind < n); cnt++) {
@@ -699,18 +709,18 @@ namespace ConicBundle {
         }
         if (cnt == 0)
           return 0;
-        n = cnt;
+        n = int(cnt);
         tmpcp.reduce_length(n);
         cp = tmpcp.get_store();
-        ip = provided_row_indices->get_store();
+        ip = int_store(*provided_row_indices, int_ind);
       } else {
         //sparse case
         Integer cnt = 0;
-        tmpcp.newsize(min(pdim, n), 1); chk_set_init(tmpcp, 1);
-        tmpip.newsize(min(pdim, n), 1); chk_set_init(tmpip, 1);
+        tmpcp.newsize(min(pdim, Integer(n)), 1); chk_set_init(tmpcp, 1);
+        tmpip.newsize(min(pdim, Integer(n)), 1); chk_set_init(tmpip, 1);
         const Integer* pind = provided_row_indices->get_store();
         const Integer* const pind_end = pind + pdim;
-        const Integer* const ip_end = ip + n;
+        const int* const ip_end = ip + n;
         Real* val = tmpcp.get_store();
         Integer* ind = tmpip.get_store();
         while (ip != ip_end) {
@@ -734,11 +744,11 @@ namespace ConicBundle {
         }
         if (cnt == 0)
           return 0;
-        n = cnt;
+        n = int(cnt);
         tmpcp.reduce_length(n);
         tmpip.reduce_length(n);
         cp = tmpcp.get_store();
-        ip = tmpip.get_store();
+        ip = int_store(tmpip, int_ind);
       }
     }
 
@@ -749,7 +759,7 @@ namespace ConicBundle {
 
 
     Integer sp_nc = sp->coldim();
-    Real* tp = out_mnrt->get_dense_coeff_store(sp_nc);
+    Real* tp = out_mnrt->get_dense_coeff_store(int(sp_nc));
     Matrix tmpval(0, 1, 0.);
     if (tp == 0) {
       tmpval.init(sp_nc, 1, 0.);
@@ -824,12 +834,13 @@ namespace ConicBundle {
       for (Integer i = 0; i < ni_i; i++) {
         tmpval(i) = tmpval(*ip++);
       }
-      return out_mnrt->add_coeffs(ni_i, (const double*)(tmpval.get_store()),
-        (const int*)needed_col_indices->get_store());
+      std::vector<int> int_ind;
+      return out_mnrt->add_coeffs(int(ni_i), (const double*)(tmpval.get_store()),
+        int_store(*needed_col_indices, int_ind));
     }
 
     if (tp == tmpval.get_store())
-      return out_mnrt->add_coeffs(sp_nc, (const double*)(tmpval.get_store()));
+      return out_mnrt->add_coeffs(int(sp_nc), (const double*)(tmpval.get_store()));
 
     return 0;
   }
@@ -848,6 +859,8 @@ namespace ConicBundle {
     }
     int err = 0;
     if (factor > 0.) {
+      //--- collect the minorants to be added (if empty, the first one initializes *this)
+      std::vector<unsigned int> aggr_ind;
       for (unsigned int i = 0; i < minorants.size(); i++) {
         if (coeff(Integer(i)) == 0.)
           continue;
@@ -861,11 +874,56 @@ namespace ConicBundle {
           init(minorants[i], coeff(Integer(i)) * factor);
           continue;
         }
+        aggr_ind.push_back(i);
+      }
+
+      //--- add them all at once by Minorant::aggregate_batch()
+      unsigned int first = 0;
+      Real my_sv = 0.;
+      Minorant* my_mnrt = 0;
+      while (first < aggr_ind.size()) {
+        if ((prepare_for_changes(1., true)) ||
+          (md->get_scaleval_and_minorant(my_sv, my_mnrt))) {
+          if (cb_out())
+            get_out() << "**** ERROR: MinorantPointer::aggregate(..): preparing the aggregate for changes failed" << std::endl;
+          return err + 1;
+        }
+        if (my_sv != 0.)
+          break;
+        //a zero aggregate is replaced by the next minorant as in aggregate(const MinorantPointer&,double)
+        unsigned int i = aggr_ind[first++];
         if (aggregate(minorants[i], coeff(Integer(i)) * factor)) {
           if (cb_out())
             get_out() << "**** ERROR: MinorantPointer::aggregate(..): aggregating minorant " << i << " failed" << std::endl;
         }
       }
+      if (first < aggr_ind.size()) {
+        std::vector<const Minorant*> mnrts;
+        DVector weights;
+        mnrts.reserve(aggr_ind.size() - first);
+        weights.reserve(aggr_ind.size() - first);
+        for (unsigned int k = first; k < aggr_ind.size(); k++) {
+          unsigned int i = aggr_ind[k];
+          Real in_sv;
+          Minorant* in_mnrt;
+          if (minorants[i].md->get_scaleval_and_minorant(in_sv, in_mnrt)) {
+            if (cb_out())
+              get_out() << "**** ERROR: MinorantPointer::aggregate(..): aggregating minorant " << i << " failed" << std::endl;
+            continue;
+          }
+          Real w = coeff(Integer(i)) * factor * in_sv / my_sv;
+          if (w == 0.)
+            continue;
+          mnrts.push_back(in_mnrt);
+          weights.push_back(w);
+        }
+        if (my_mnrt->aggregate_batch(mnrts, weights)) {
+          if (cb_out())
+            get_out() << "**** ERROR: MinorantPointer::aggregate(..): minorant->aggregate_batch failed" << std::endl;
+          err++;
+        }
+        md->aggregated(Integer(mnrts.size()));
+      }
     }
     if (empty()) {
       init(new Minorant, 0, 1.);
@@ -938,16 +996,16 @@ namespace ConicBundle {
     if (ymult == 0.) {
       return 0.;
     }
-    Integer lenx;
+    int lenx;
     const Real* xval;
-    const Integer* xind;
+    const int* xind;
     xmnrt->get_coeffs(lenx, xval, xind);
     if (lenx == 0)
       return 0.;
 
-    Integer leny;
+    int leny;
     const Real* yval;
-    const Integer* yind;
+    const int* yind;
     ymnrt->get_coeffs(leny, yval, yind);
     if (leny == 0)
       return 0.;
@@ -965,9 +1023,9 @@ namespace ConicBundle {
     if (test) {
       Integer dim = max(lenx, leny);
       if (yind)
-        dim = max(dim, yind[leny - 1] + 1);
+        dim = max(dim, Integer(yind[leny - 1] + 1));
       if (xind)
-        dim = max(dim, xind[lenx - 1] + 1);
+        dim = max(dim, Integer(xind[lenx - 1] + 1));
       if (skip_fixed)
         dim = max(dim, (*skip_fixed)(skip_fixed->dim() - 1) + 1);
       if (ipdiag) {
@@ -1039,8 +1097,8 @@ namespace ConicBundle {
         return xmult * sum;
       }
       if ((xind != 0) && (yind != 0)) {
-        const Integer* const xend = xind + lenx;
-        const Integer* const yend = yind + leny;
+        const int* const xend = xind + lenx;
+        const int* const yend = yind + leny;
         const Integer* const send = skip_fixed->get_store() + skip_fixed->dim();
         const Integer* sind = skip_fixed->get_store();
         while (xind != xend) {
@@ -1073,11 +1131,11 @@ namespace ConicBundle {
 
       if (yind == 0) {
         const Real* h = xval; xval = yval; yval = h;
-        const Integer* k = xind; xind = yind; yind = k;
+        const int* k = xind; xind = yind; yind = k;
         swap(lenx, leny);
       }
 
-      const Integer* const yend = yind + leny;
+      const int* const yend = yind + leny;
       const Integer* sind = skip_fixed->get_store();
       const Integer* const send = sind + skip_fixed->dim();
       while (sind != send) {
@@ -1122,8 +1180,8 @@ namespace ConicBundle {
         return xmult * sum;
       }
       if ((xind != 0) && (yind != 0)) {
-        const Integer* const xend = xind + lenx;
-        const Integer* const yend = yind + leny;
+        const int* const xend = xind + lenx;
+        const int* const yend = yind + leny;
         const Integer* const send = skip_fixed->get_store() + skip_fixed->dim();
         const Integer* sind = skip_fixed->get_store();
         while (xind != xend) {
@@ -1156,11 +1214,11 @@ namespace ConicBundle {
 
       if (yind == 0) {
         const Real* h = xval; xval = yval; yval = h;
-        const Integer* k = xind; xind = yind; yind = k;
+        const int* k = xind; xind = yind; yind = k;
         swap(lenx, leny);
       }
 
-      const Integer* const yend = yind + leny;
+      const int* const yend = yind + leny;
       const Integer* sind = skip_fixed->get_store();
       const Integer* const send = sind + skip_fixed->dim();
       while (sind != send) {
@@ -1203,9 +1261,9 @@ namespace ConicBundle {
     if (xmult == 0.) {
       return 0.;
     }
-    Integer lenx;
+    int lenx;
     const Real* xval;
-    const Integer* xind;
+    const int* xind;
     xmnrt->get_coeffs(lenx, xval, xind);
     if (lenx <= 0)
       return 0.;
@@ -1216,7 +1274,7 @@ namespace ConicBundle {
 
     if (xind)
       return xmult * mat_ip_dense_sparse(vec.dim(), vec.get_store() + m_start, lenx, xval, xind, dval);
-    lenx = min(lenx, vec.dim());
+    lenx = int(min(Integer(lenx), vec.dim()));
     return xmult * mat_ip(lenx, xval, vec.get_store() + m_start, dval);
   }
 
@@ -1245,14 +1303,14 @@ namespace ConicBundle {
     if (std::fabs(xf - ymult * ymnrt->offset()) > abstol)
       return false;
 
-    Integer lenx;
+    int lenx;
     const Real* xval;
-    const Integer* xind;
+    const int* xind;
     xmnrt->get_coeffs(lenx, xval, xind);
 
-    Integer leny;
+    int leny;
     const Real* yval;
-    const Integer* yind;
+    const int* yind;
     ymnrt->get_coeffs(leny, yval, yind);
 
     if ((lenx != leny) || ((xind == 0) != (yind == 0)))
@@ -1280,7 +1338,7 @@ namespace ConicBundle {
       return false;
     }
     assert(yind != 0);
-    const Integer* const yend = yind + leny;
+    const int* const yend = yind + leny;
     while ((yind != yend) && (*yind == *xind++))
       yind++;
     if (yind != yend)
@@ -1308,9 +1366,9 @@ namespace ConicBundle {
       return 0;
     if (D == 0)
       return xmult * xmult * xmnrt->norm_squared();
-    Integer lenx;
+    int lenx;
     const Real* xval;
-    const Integer* xind;
+    const int* xind;
     xmnrt->get_coeffs(lenx, xval, xind);
 
     Real sum = 0.;
@@ -1324,7 +1382,7 @@ namespace ConicBundle {
         sum += d * d * (*dval++);
       }
     } else {
-      const Integer* const indend = xind + lenx;
+      const int* const indend = xind + lenx;
       const Real* const dval = D->get_store();
       while (xind != indend) {
         assert(*xind < D->dim());
@@ -1350,9 +1408,9 @@ namespace ConicBundle {
       return 0;
     if (D == 0)
       return xmult * xmult * xmnrt->norm_squared();
-    Integer lenx;
+    int lenx;
     const Real* xval;
-    const Integer* xind;
+    const int* xind;
     xmnrt->get_coeffs(lenx, xval, xind);
 
     Real sum = 0.;
@@ -1366,7 +1424,7 @@ namespace ConicBundle {
         sum += d * d / (*dval++);
       }
     } else {
-      const Integer* const indend = xind + lenx;
+      const int* const indend = xind + lenx;
       const Real* const dval = D->get_store();
       while (xind != indend) {
         assert(*xind < D->dim());
@@ -1403,9 +1461,9 @@ namespace ConicBundle {
 
     alpha *= xmult;
 
-    Integer lenx;
+    int lenx;
     const Real* xval;
-    const Integer* xind;
+    const int* xind;
     xmnrt->get_coeffs(lenx, xval, xind);
 
     if (thistrans) {
@@ -1629,9 +1687,9 @@ namespace ConicBundle {
 
     alpha *= xmult;
 
-    Integer lenx;
+    int lenx;
     const Real* xval;
-    const Integer* xind;
+    const int* xind;
     xmnrt->get_coeffs(lenx, xval, xind);
 
 
@@ -1843,9 +1901,9 @@ namespace ConicBundle {
       Minorant* xmnrt;
       md->get_scaleval_and_minorant(xmult, xmnrt);
 
-      Integer lenx;
+      int lenx;
       const Real* xval;
-      const Integer* xind;
+      const int* xind;
       xmnrt->get_coeffs(lenx, xval, xind);
 
       out << "[" << xmnrt->offset() * xmult << "; " << lenx;
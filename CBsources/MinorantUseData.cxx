@@ -179,7 +179,7 @@ namespace ConicBundle {
 
   Real MinorantUseData::coeff(CH_Matrix_Classes::Integer i) const {
     if (minorant)
-      return scaleval * minorant->coeff(i);
+      return scaleval * minorant->coeff(int(i));
     if (md)
       return scaleval * md->coeff(i);
     return CB_minus_infinity;
@@ -244,9 +244,9 @@ namespace ConicBundle {
         val = it->second;
       else {
         val = 0.;
-        Integer n;
+        int n;
         const Real* cp;
-        const Integer* ip;
+        const int* ip;
         if (minorant->get_coeffs(n, cp, ip)) {
           return CB_minus_infinity;
         }
@@ -59,6 +59,7 @@ namespace ConicBundle {
     var_append_costs = 0;
     var_del_ind = 0;
     var_map_to_old = 0;
+    var_map_increasing = true;
     var_new_ind = 0;
 
     row_set_rhslb = 0;
@@ -98,8 +99,8 @@ namespace ConicBundle {
     Real rhsub_def,
     Real cost_def) {
     append_only = false;
-    var_olddim = max(0, volddim);
-    row_olddim = max(0, rolddim);
+    var_olddim = max(Integer(0), volddim);
+    row_olddim = max(Integer(0), rolddim);
 
     enforce_bounds_consistency = ensure_bounds_consistency;
     enforce_start_val_box_feasibility = ensure_start_val_box_feasibility;
@@ -155,6 +156,7 @@ namespace ConicBundle {
     var_del_ind = 0;
     delete var_map_to_old;
     var_map_to_old = 0;
+    var_map_increasing = true;
     delete var_new_ind;
     var_new_ind = 0;
 
@@ -585,6 +587,7 @@ namespace ConicBundle {
         var_map_to_old = new Indexmatrix(0, 1, Integer(0));
       else
         var_map_to_old->init(0, 1, Integer(0));
+      var_map_increasing = true;
       if (var_del_ind == 0)
         var_del_ind = new Indexmatrix(Range(0, var_olddim - 1));
       else
@@ -645,6 +648,13 @@ namespace ConicBundle {
     }
 
     var_newdim = var_map_to_old->dim();
+    var_map_increasing = true;
+    for (Integer i = 1; i < var_newdim; i++) {
+      if ((*var_map_to_old)(i - 1) >= (*var_map_to_old)(i)) {
+        var_map_increasing = false;
+        break;
+      }
+    }
     if (var_append_lb)
       var_append_lb->delete_rows(append_del_ind);
     if (var_append_ub)
@@ -1580,7 +1590,9 @@ namespace ConicBundle {
           vars->concat_below(Matrix(var_append_dim, 1, start_val_default));
         }
         if ((enforce_start_val_box_feasibility) && ((lb) || (ub))) {
-          for (Integer i = 0; i < vars->dim(); i++) {
+          //without bound changes only the appended values need to be checked
+          Integer i = ((var_set_lb) || (var_set_ub)) ? 0 : var_olddim;
+          for (; i < vars->dim(); i++) {
             if ((lb) && ((*vars)(i) < (*lb)(i))) {
               (*vars)(i) = (*lb)(i);
               continue;
@@ -1594,7 +1606,18 @@ namespace ConicBundle {
     } //endif (var_append_dim>0)
 
     //now apply the map if needed
-    if (var_map_to_old) {
+    if ((var_map_to_old) && (var_map_increasing)) {
+      //only deletions, this may be done in place
+      assert(var_del_ind);
+      if (vars)
+        vars->delete_rows(*var_del_ind, true);
+      if (lb)
+        lb->delete_rows(*var_del_ind, true);
+      if (ub)
+        ub->delete_rows(*var_del_ind, true);
+      if (costs)
+        costs->delete_rows(*var_del_ind, true);
+    } else if (var_map_to_old) {
       if (vars)
         (*vars) = vars->rows(*var_map_to_old);
       if (lb)
@@ -1742,6 +1765,18 @@ namespace ConicBundle {
     return false;
   }
 
+  // *****************************************************************************
+  //                              Modification::unchanged_leading_vardim
+  // *****************************************************************************
+
+  Integer Modification::unchanged_leading_vardim() const {
+    if ((var_set_lb) || (var_set_ub) || (!var_map_increasing))
+      return 0;
+    if ((var_del_ind) && (var_del_ind->dim() > 0))
+      return (*var_del_ind)(0);
+    return var_olddim;
+  }
+
   // *****************************************************************************
   //                              Modification::set_append_to_old
   // *****************************************************************************
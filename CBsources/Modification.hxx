@@ -270,6 +270,8 @@ namespace ConicBundle {
     CH_Matrix_Classes::Indexmatrix* var_del_ind;
     ///the variables are rearranged so that the new index i had previously (after additions and before deletion) the index map_to_old(i) 
     CH_Matrix_Classes::Indexmatrix* var_map_to_old;
+    ///true if var_map_to_old is NULL or strictly increasing, i.e., the remaining variables keep their order
+    bool var_map_increasing;
     ///in the end the appended new variables have these positions 
     CH_Matrix_Classes::Indexmatrix* var_new_ind;
 
@@ -666,6 +668,8 @@ namespace ConicBundle {
 
      /// returns true if no modifications need to be executed
     bool no_modification() const;
+    /// returns the number of leading variables whose index and bounds are not affected by the modification (0 for general reassignments or bound changes)
+    CH_Matrix_Classes::Integer unchanged_leading_vardim() const;
     /// if set to true, no deletions/reassignments may be present or specified in the future, only appensions are allowed 
     int set_append_to_old(bool append_only);
     /// returns true if this only contains appending operations and incorporating this is done with respect to the old dimension 
@@ -720,6 +724,16 @@ namespace ConicBundle {
       return var_map_to_old;
     }
 
+    /// returns map_to_old_variables() as an int array for the OracleModification interface (null if there are no index changes)
+    const int* int_map_to_old_variables() const {
+      return (var_map_to_old == 0) ? 0 : CH_Matrix_Classes::int_store(*var_map_to_old, int_buffer);
+    }
+
+    /// returns true if map_to_old_variables() is null or strictly increasing; then the index changes are fully described by deleted_var_indices() and the appended variables stay at the end
+    bool map_to_old_variables_increasing() const {
+      return var_map_increasing;
+    }
+
     /// returns null if there were no deletions, otherwise the Indexmatrix pointed to is a vector holding the deleted old variable indices in increasing order   
     const CH_Matrix_Classes::Indexmatrix* deleted_var_indices() const {
       return var_del_ind;
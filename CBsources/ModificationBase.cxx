@@ -87,10 +87,10 @@ namespace ConicBundle {
       delete new_ind;
       new_ind = 0;
     }
-    append_del_ind.init(append_dim - cnt_append, 1, 0);
+    append_del_ind.init(append_dim - cnt_append, 1, Integer(0));
     if (del_ind == 0)
       del_ind = new Indexmatrix;
-    del_ind->init(olddim + cnt_append - input_map.dim(), 1, 0);
+    del_ind->init(olddim + cnt_append - input_map.dim(), 1, Integer(0));
 
 
     Integer vdii = 0;
@@ -109,6 +109,9 @@ namespace ConicBundle {
 
     //@}
 
+    /// buffer for passing index vectors through the int interface of OracleModification (only used if #CH_Matrix_Classes::Integer is not int)
+    mutable std::vector<int> int_buffer;
+
   public:
     //-----------------------------------------------------------------------
     /** @name Constructors and initialization
@@ -205,6 +205,7 @@ namespace ConicBundle {
     Integer child_add_dim = 0;   ///number of new parameters added to this oracle and its children (on top of old ones) in consequence of the current modifications (may e.g. be fewer than in add_dim due to resassignments)
     const Indexmatrix* child_map_to_old = 0;  ///the reassignment of the variables after the addition (on top of old ones)
     Indexmatrix tmp_map_to_old;
+    std::vector<int> int_map;  ///for passing maps to the int interface of OracleModification
 
     const OracleModification* in_om = 0;
     const AFTModification* in_aftm = 0;
@@ -219,11 +220,11 @@ namespace ConicBundle {
     }
     if (in_om != 0) {
       if (oraclemod == 0) {
-        oraclemod = in_om->new_initial_oraclemodification(aftmod.old_rowdim());
+        oraclemod = in_om->new_initial_oraclemodification(int(aftmod.old_rowdim()));
         if (aftmod.appended_rowdim() > 0)
-          oraclemod->add_append_variables(aftmod.appended_rowdim());
+          oraclemod->add_append_variables(int(aftmod.appended_rowdim()));
         if (aftmod.map_to_old_variables())
-          oraclemod->add_reassign_variables(int(aftmod.map_to_old_variables()->dim()), (const int*)(aftmod.map_to_old_variables()->get_store()));
+          oraclemod->add_reassign_variables(int(aftmod.map_to_old_variables()->dim()), int_store(*aftmod.map_to_old_variables(), int_map));
       }
       if (oraclemod->incorporate(*in_om)) {
         if (cb_out())
@@ -277,7 +278,7 @@ namespace ConicBundle {
             err++;
           }
           if ((oraclemod) && (in_om == 0)) {
-            if (oraclemod->add_append_variables(add_dim)) {
+            if (oraclemod->add_append_variables(int(add_dim))) {
               if (cb_out())
                 get_out() << "**** ERROR ModificationTreeData::update_subtree_modification(...): add_append_variables failed for appending new variables via the oracle modification" << std::endl;
               err++;
@@ -303,7 +304,7 @@ namespace ConicBundle {
               err++;
             }
             if ((oraclemod) && (in_om == 0)) {
-              if (oraclemod->add_reassign_variables(map_to_old->dim(), map_to_old->get_store())) {
+              if (oraclemod->add_reassign_variables(int(map_to_old->dim()), int_store(*map_to_old, int_map))) {
                 if (cb_out())
                   get_out() << "**** ERROR ModificationTreeData::update_subtree_modification(...): add_reassign_variables failed for reassigning variables via the oracle modification" << std::endl;
                 err++;
@@ -315,12 +316,12 @@ namespace ConicBundle {
             Indexmatrix delvar;
             const Indexmatrix* varmap = aftmod.map_to_old_variables();
             if (varmap) {
-              delvar.init(aftmod.old_vardim() + aftmod.appended_vardim(), 1, 1);
+              delvar.init(aftmod.old_vardim() + aftmod.appended_vardim(), 1, Integer(1));
               for (Integer i = 0; i < varmap->dim(); i++) {
                 delvar((*varmap)(i)) = 0;
               }
             } else {
-              delvar.init(aftmod.old_vardim() + aftmod.appended_vardim(), 1, 0);
+              delvar.init(aftmod.old_vardim() + aftmod.appended_vardim(), 1, Integer(0));
             }
             //test the rows that have to be tested
             Indexmatrix delrow(0, 0, Integer(0));
@@ -378,7 +379,7 @@ namespace ConicBundle {
                 err++;
               }
               if ((oraclemod) && (in_om == 0)) {
-                if (oraclemod->add_reassign_variables(child_map_to_old->dim(), child_map_to_old->get_store())) {
+                if (oraclemod->add_reassign_variables(int(child_map_to_old->dim()), int_store(*child_map_to_old, int_map))) {
                   if (cb_out())
                     get_out() << "**** ERROR ModificationTreeData::update_subtree_modification(...): add_reassign_variables failed for reassigning variables via the oracle modification after deletions" << std::endl;
                   err++;
@@ -409,14 +410,14 @@ namespace ConicBundle {
       }
       if ((oraclemod) && (in_om == 0)) {
         if (in_aftm->appended_rowdim() > 0) {
-          if (oraclemod->add_append_variables(in_aftm->appended_rowdim())) {
+          if (oraclemod->add_append_variables(int(in_aftm->appended_rowdim()))) {
             if (cb_out())
               get_out() << "**** ERROR ModificationTreeData::update_subtree_modification(...): add_append_variables failed for incorporated appending of variables via the oracle modification" << std::endl;
             err++;
           }
         }
         if (in_aftm->map_to_old_rows()) {
-          if (oraclemod->add_reassign_variables(in_aftm->map_to_old_rows()->dim(), in_aftm->map_to_old_rows()->get_store())) {
+          if (oraclemod->add_reassign_variables(int(in_aftm->map_to_old_rows()->dim()), int_store(*in_aftm->map_to_old_rows(), int_map))) {
             if (cb_out())
               get_out() << "**** ERROR ModificationTreeData::update_subtree_modification(...): add_reassign_variables failed for incorporated reassigning of variables via the oracle modification" << std::endl;
             err++;
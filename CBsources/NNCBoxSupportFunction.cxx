@@ -31,6 +31,17 @@ using namespace CH_Matrix_Classes;
 
 namespace ConicBundle {
 
+  // the coordinate of a maximizer of d*x over l<=x<=u, for d==0 the one closest to zero
+  static inline Real nnc_box_argmax(Real d, Real l, Real u) {
+    if (d < 0.)
+      return l;
+    if (d > 0.)
+      return u;
+    if (l <= 0.)
+      return (u >= 0.) ? 0. : u;
+    return l;
+  }
+
   //*****************************************************************************
   //                            NNCBoxSupportMinorantExtender
   //*****************************************************************************
@@ -57,7 +68,7 @@ namespace ConicBundle {
             val = 0.;
         }
         if (val != 0.) {
-          if (mnrt.add_coeff(ind, val)) {
+          if (mnrt.add_coeff(int(ind), val)) {
             err++;
             if (cb_out()) {
               get_out() << "**** WARNING: NNCBoxSupportMinorantExtender::extend(...): adding a new coefficint to the minorant failed for index=" << ind << std::endl;
@@ -110,28 +121,98 @@ namespace ConicBundle {
     const Real* yp = y.get_store();
     const Real* lp = lb.get_store();
     const Real* up = ub.get_store();
-    Matrix x(n, 1); chk_set_init(x, 1);
-    Real* xp = x.get_store();
-    for (Integer i = 0; i < n; i++, lp++, up++) {
+    xval.newsize(n, 1); chk_set_init(xval, 1);
+    xind.resize(std::size_t(n));
+    Real* xp = xval.get_store();
+    int* xip = xind.data();
+    for (Integer i = 0; i < n; i++) {
       Real d = *yp++;
-      if (d < 0.) {
-        val += d * (*lp);
-        (*xp++) = *lp;
-      } else if (d > 0.) {
-        val += d * (*up);
-        (*xp++) = *up;
-      } else {
-        if (*lp <= 0.) {
-          if (*up >= 0.)
-            (*xp++) = 0.;
-          else
-            (*xp++) = *up;
-        } else
-          (*xp++) = *lp;
-      }
+      Real x = nnc_box_argmax(d, *lp++, *up++);
+      if (d != 0.)
+        val += d * x;
+      (*xp++) = x;
+      if (x != 0.)
+        (*xip++) = int(i);
     }
     assert(minorants.size() == 0);
-    minorants.push_back(new Minorant(true, 0., n, x.get_store()));
+    Integer nz = Integer(xip - xind.data());
+    if (2 * nz > n) {
+      minorants.push_back(new Minorant(true, 0., int(n), xval.get_store()));
+      return 0;
+    }
+    //mostly zero, compress the values in place and return a sparse minorant
+    xp = xval.get_store();
+    for (Integer k = 0; k < nz; k++)
+      xp[k] = xp[xind[std::size_t(k)]];
+    minorants.push_back(new Minorant(true, 0., int(nz), xval.get_store(), xind.data()));
+    return 0;
+  }
+
+  //*****************************************************************************
+  //                            NNCBoxSupportBlockEvaluator
+  //*****************************************************************************
+
+  int NNCBoxSupportBlockEvaluator::start_blocks(Integer dim, Integer n_blocks) {
+    argument = 0;
+    if ((fun == 0) || (dim != fun->get_lower_bounds().rowdim()))
+      return 1;
+    xval.newsize(dim, 1); chk_set_init(xval, 1);
+    xind.resize(std::size_t(dim));
+    blockval.init(n_blocks, 1, 0.);
+    blockbegin.init(n_blocks, 1, Integer(0));
+    blocknz.init(n_blocks, 1, Integer(-1));
+    return 0;
+  }
+
+  void NNCBoxSupportBlockEvaluator::evaluate_block(Integer block, Integer begin, Integer end, const Real* y) {
+    const Real* lp = fun->get_lower_bounds().get_store() + begin;
+    const Real* up = fun->get_upper_bounds().get_store() + begin;
+    Real* xp = xval.get_store() + begin;
+    int* xip = xind.data() + begin;
+    Real val = 0.;
+    for (Integer i = begin; i < end; i++) {
+      Real d = *y++;
+      Real x = nnc_box_argmax(d, *lp++, *up++);
+      if (d != 0.)
+        val += d * x;
+      (*xp++) = x;
+      if (x != 0.)
+        (*xip++) = int(i);
+    }
+    blockval(block) = val;
+    blockbegin(block) = begin;
+    blocknz(block) = Integer(xip - xind.data()) - begin;
+    if (block == 0)
+      argument = y - end;
+  }
+
+  int NNCBoxSupportBlockEvaluator::get_result(const Matrix& y, Real& val, std::vector<Minorant*>& minorants) {
+    if ((argument == 0) || (argument != y.get_store()) || (y.dim() != xval.dim()) || (min(blocknz) < 0)) {
+      argument = 0;
+      return 1;
+    }
+    argument = 0;
+    Integer n = xval.dim();
+    val = sum(blockval);
+    Integer nz = sum(blocknz);
+    assert(minorants.size() == 0);
+    if (2 * nz > n) {
+      minorants.push_back(new Minorant(true, 0., int(n), xval.get_store()));
+      return 0;
+    }
+    //mostly zero, move the indices of the blocks to the front and compress the values in place
+    Real* xp = xval.get_store();
+    int* xip = xind.data();
+    Integer k = 0;
+    for (Integer b = 0; b < blocknz.dim(); b++) {
+      const int* bip = xind.data() + blockbegin(b);
+      for (Integer j = blocknz(b); --j >= 0; k++) {
+        int i = *bip++;
+        xip[k] = i;
+        xp[k] = xp[i];
+      }
+    }
+    minorants.push_back(new Minorant(true, 0., int(nz), xval.get_store(), xind.data()));
     return 0;
   }
 
@@ -27,7 +27,7 @@
 #define CONICBUNDLE_NNCBOXSUPPORTFUNCTION_HXX
 
 /**  @file NNCBoxSupportFunction.hxx
-    @brief Header declaring the classes ConicBundle::NNCBoxSupportFunction, ConicBundle::NNCBoxSupportMinorantExtender (part of an implementation of ConicBundle::FunctionModel)
+    @brief Header declaring the classes ConicBundle::NNCBoxSupportFunction, ConicBundle::NNCBoxSupportMinorantExtender, ConicBundle::NNCBoxSupportBlockEvaluator (part of an implementation of ConicBundle::FunctionModel)
     @version 1.0
     @date 2017-09-30
     @author Christoph Helmberg
@@ -38,6 +38,7 @@
 #include <map>
 #include "MatrixCBSolver.hxx"
 #include "NNCBoxSupportModification.hxx"
+#include "AffineFunctionTransformation.hxx"
 
 //------------------------------------------------------------
 
@@ -192,6 +193,10 @@ namespace ConicBundle {
     CH_Matrix_Classes::Matrix lb; ///< column vector of lower bounds
     CH_Matrix_Classes::Matrix ub; ///< column vector of upper bounds
 
+    //temporary variables of evaluate(), global only for memory management purposes
+    CH_Matrix_Classes::Matrix xval;  ///< values of the maximizer
+    std::vector<int> xind;           ///< indices of the nonzero values of the maximizer
+
     /// applies the NNCBoxSupportModfication mod to the current function
     int apply_modification(const NNCBoxSupportModification& mod);
 
@@ -213,7 +218,7 @@ namespace ConicBundle {
     /**@name Implementations of MatrixFunctionOracle routines */
     //@{
 
-    /// see MatrixFunctionOracle::evaluate()
+    /// see MatrixFunctionOracle::evaluate(); if at most half of the coordinates of the maximizer are nonzero, the minorant is returned in sparse form
     int evaluate(const  CH_Matrix_Classes::Matrix& current_point,
       CH_Matrix_Classes::Real relprec,
       CH_Matrix_Classes::Real& objective_value,
@@ -287,6 +292,52 @@ namespace ConicBundle {
 
   };
 
+  /**@brief evaluates an NNCBoxSupportFunction blockwise while an AffineFunctionTransformation computes its argument (see AFTBlockEvaluator); used by NNCModel
+
+     get_result() combines the blocks in their order into the value and
+     the minorant that NNCBoxSupportFunction::evaluate() returns for the
+     complete argument. The indices of the nonzeros of the maximizer are
+     collected within each block, so a sparse minorant is assembled
+     without another pass over all coordinates.
+   */
+
+  class NNCBoxSupportBlockEvaluator : public AFTBlockEvaluator {
+  private:
+    NNCBoxSupportFunction* fun; ///< the function evaluated
+    const CH_Matrix_Classes::Real* argument; ///< the argument whose blocks were evaluated (set by block 0), NULL if there are none
+    CH_Matrix_Classes::Matrix xval;  ///< values of the maximizer
+    std::vector<int> xind;           ///< the indices of the nonzero values of the maximizer in a block start at the first coordinate of the block
+    CH_Matrix_Classes::Matrix blockval; ///< the part of the function value of each block
+    CH_Matrix_Classes::Indexmatrix blockbegin; ///< the first coordinate of each block
+    CH_Matrix_Classes::Indexmatrix blocknz; ///< the number of nonzeros of the maximizer in each block, -1 if the block was not evaluated
+
+  public:
+    ///
+    NNCBoxSupportBlockEvaluator() : fun(0), argument(0) {
+    }
+
+    /// the function to evaluate by the next blocks
+    void set_function(NNCBoxSupportFunction* f) {
+      fun = f;
+      argument = 0;
+    }
+
+    /// see AFTBlockEvaluator::start_blocks(); returns nonzero if no function is set or dim does not match its bounds
+    int start_blocks(CH_Matrix_Classes::Integer dim,
+      CH_Matrix_Classes::Integer n_blocks);
+
+    /// see AFTBlockEvaluator::evaluate_block()
+    void evaluate_block(CH_Matrix_Classes::Integer block,
+      CH_Matrix_Classes::Integer begin,
+      CH_Matrix_Classes::Integer end,
+      const CH_Matrix_Classes::Real* y);
+
+    /// if all blocks were evaluated for the argument @a y, this returns 0 and the value and the minorant as NNCBoxSupportFunction::evaluate() for @a y; otherwise it returns 1 and nothing is computed; the blocks are used only once
+    int get_result(const CH_Matrix_Classes::Matrix& y,
+      CH_Matrix_Classes::Real& objective_value,
+      std::vector<Minorant*>& minorants);
+  };
+
 
 }
 
@@ -36,7 +36,7 @@ namespace ConicBundle {
   }
 
   void NNCIPBlock::clear(Integer dim) {
-    vecdim = max(dim, 0);
+    vecdim = max(dim, Integer(0));
     x.init(vecdim, 1, 0.);
     z.init(vecdim, 1, 0.);
 
@@ -201,9 +201,9 @@ namespace ConicBundle {
     const Real* zp = z.get_store();
     const Real* dxp = dx.get_store();
     const Real* dzp = dz.get_store();
-    const Real mu_xz = tr_xz / inmudim;
-    const Real mu_xdzpdxz = tr_xdzpdxz / inmudim;
-    const Real mu_dxdz = tr_dxdz / inmudim;
+    const Real mu_xz = tr_xz / Real(inmudim);
+    const Real mu_xdzpdxz = tr_xdzpdxz / Real(inmudim);
+    const Real mu_dxdz = tr_dxdz / Real(inmudim);
     const Real mu_at_one = mu_xz + mu_xdzpdxz + mu_dxdz;
     for (Integer i = 0; i < vecdim; i++) {
       NNC_nbh_stepsize(*xp++, *zp++, *dxp++, *dzp++,
@@ -427,9 +427,9 @@ namespace ConicBundle {
     assert(trafotrace.rowdim() >= startindex_trace + vecdim);
     Real scaleval;
     Minorant* mp;
-    Integer nz;
+    int nz;
     const Real* coeffs;
-    const Integer* ind;
+    const int* ind;
     for (Integer i = 0; i < vecdim; i++) {
       Real xizinv = 1. / xiz(i);
       globalbundle[unsigned(startindex_bundle + map_to_old(i))].get_scaleval_and_minorant(scaleval, mp);
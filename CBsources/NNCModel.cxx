@@ -27,6 +27,7 @@
 #include "NNCModel.hxx"
 #include "NNCModelParameters.hxx"
 #include "BundleIdProx.hxx"
+#include "timer_registry.hxx"
 
 using namespace CH_Tools;
 using namespace CH_Matrix_Classes;
@@ -40,6 +41,7 @@ namespace ConicBundle {
   void NNCModel::clear() {
     ConeModel::clear();
     data.clear();
+    clear_replay();
     delete model_selection;
     model_selection = new NNCModelParameters(this);
 
@@ -47,6 +49,9 @@ namespace ConicBundle {
     nr_eval = 0;
     delete block;
     block = 0;
+    block_eval.set_function(0);
+    block_eval_id = -1;
+    block_eval_mid = -1;
   }
 
   // *****************************************************************************
@@ -67,6 +72,7 @@ namespace ConicBundle {
   // *****************************************************************************
 
   NNCModel::~NNCModel() {
+    clear_replay();
     delete model_selection;
     delete block;
   }
@@ -188,6 +194,7 @@ namespace ConicBundle {
     const Matrix& y,
     Real nullstep_bound,
     Real relprec) {
+    CH_Tools::ScopedTimer scoped_timer("NNCModel::evaluate_oracle");
     assert(relprec > 0.);
 
     CH_Tools::Microseconds start_eval = clock.time();
@@ -201,12 +208,57 @@ namespace ConicBundle {
     int err = 0;
     std::vector<Minorant*> minorants;
     PrimalExtender* pep = 0;
-    nr_eval++;
-    preeval_time += clock.time() - start_eval;
-    start_eval = clock.time();
-    ret_code = oracle->evaluate(y, relprec, data.cand_ub,
-      minorants, pep);
-    eval_time += clock.time() - start_eval;
+    if (replay_minorants.size() > 0) {
+      //the restored minorants must not exceed the restored value in y,
+      //the one with largest value is put first as required for oracles
+      Real maxval = CB_minus_infinity;
+      unsigned int maxind = 0;
+      for (unsigned int j = 0; j < replay_minorants.size(); j++) {
+        Real val = replay_minorants[j]->offset();
+        if (replay_minorants[j]->offset_gives_value_at_origin()) {
+          int n;
+          const double* coeffs;
+          const int* indices;
+          replay_minorants[j]->get_coeffs(n, coeffs, indices);
+          for (int i = 0; i < n; i++) {
+            Integer ind = indices ? Integer(indices[i]) : Integer(i);
+            if (ind < y.dim())
+              val += coeffs[i] * y(ind);
+          }
+        }
+        if (val > maxval) {
+          maxval = val;
+          maxind = j;
+        }
+      }
+      if (maxval <= replay_ub + relprec * (std::fabs(replay_ub) + 1.)) {
+        std::swap(replay_minorants[0], replay_minorants[maxind]);
+        data.cand_ub = replay_ub;
+        minorants.swap(replay_minorants);
+        ret_code = 0;
+      } else {
+        if (cb_out())
+          get_out() << "**** WARNING: NNCModel::evaluate_oracle(): restored minorants exceed the restored function value, calling the oracle instead" << std::endl;
+        clear_replay();
+      }
+    }
+    if ((minorants.size() == 0) &&
+      (block_eval_id == y_id) && (block_eval_mid == data.get_modification_id())) {
+      //the oracle was evaluated while the AFT computed y
+      if (block_eval.get_result(y, data.cand_ub, minorants) == 0) {
+        nr_eval++;
+        ret_code = 0;
+      }
+    }
+    block_eval_id = -1;
+    if (minorants.size() == 0) {
+      nr_eval++;
+      preeval_time += clock.time() - start_eval;
+      start_eval = clock.time();
+      ret_code = oracle->evaluate(y, relprec, data.cand_ub,
+        minorants, pep);
+      eval_time += clock.time() - start_eval;
+    }
     start_eval = clock.time();
 
     if (ret_code) {
@@ -729,4 +781,66 @@ namespace ConicBundle {
   }
 
 
+
+  // *****************************************************************************
+  //                         get_model_minorants
+  // *****************************************************************************
+
+  int NNCModel::get_model_minorants(Real& center_value, MinorantBundle& minorants) const {
+    if ((data.get_center_modification_id() != data.get_modification_id()) ||
+      (!data.center_minorant.valid()))
+      return 1;
+    center_value = data.get_center_ub();
+    minorants.push_back(data.center_minorant);
+    for (unsigned int i = 0; i < data.bundle.size(); i++) {
+      if ((data.bundle[i].valid()) && (!(data.bundle[i] == data.center_minorant)))
+        minorants.push_back(data.bundle[i]);
+    }
+    return 0;
+  }
+
+  // *****************************************************************************
+  //                             set_replay
+  // *****************************************************************************
+
+  int NNCModel::set_replay(Real center_value, std::vector<Minorant*>& minorants) {
+    clear_replay();
+    if (minorants.size() == 0)
+      return 1;
+    replay_ub = center_value;
+    replay_minorants.swap(minorants);
+    return 0;
+  }
+
+  // *****************************************************************************
+  //                             clear_replay
+  // *****************************************************************************
+
+  // *****************************************************************************
+  //                            get_aft_block_evaluator
+  // *****************************************************************************
+
+  AFTBlockEvaluator* NNCModel::get_aft_block_evaluator(Integer y_id) {
+    block_eval_id = -1;
+    NNCBoxSupportFunction* boxfun = dynamic_cast<NNCBoxSupportFunction*>(oracle);
+    if ((boxfun == 0) || (replay_minorants.size() > 0))
+      return 0;
+    block_eval.set_function(boxfun);
+    block_eval_id = y_id;
+    block_eval_mid = data.get_modification_id();
+    return &block_eval;
+  }
+
+  // *****************************************************************************
+  //                            clear_replay
+  // *****************************************************************************
+
+  void NNCModel::clear_replay() {
+    for (unsigned int i = 0; i < replay_minorants.size(); i++)
+      delete replay_minorants[i];
+    replay_minorants.clear();
+    replay_ub = 0.;
+  }
+
+
 }
@@ -37,6 +37,7 @@
 #include "ConeModel.hxx"
 #include "NNCData.hxx"
 #include "NNCModelParametersObject.hxx"
+#include "NNCBoxSupportFunction.hxx"
 
 namespace ConicBundle {
 
@@ -66,6 +67,20 @@ namespace ConicBundle {
     /// total number of oralce calls (to  MatrixFunctionOracle::evaluate())
     CH_Matrix_Classes::Integer nr_eval;
 
+    //--- data for restoring the model without calling the oracle, see set_replay()
+    /// if not empty, these minorants replace the result of the next oracle call
+    std::vector<Minorant*> replay_minorants;
+    /// the function value to be used with replay_minorants
+    CH_Matrix_Classes::Real replay_ub;
+
+    //--- evaluation of an NNCBoxSupportFunction together with its AFT, see get_aft_block_evaluator()
+    /// evaluates the oracle blockwise while the AFT computes its argument
+    NNCBoxSupportBlockEvaluator block_eval;
+    /// the point identifier the blocks are evaluated for (-1 if none)
+    CH_Matrix_Classes::Integer block_eval_id;
+    /// the modification id of data when the blocks were requested
+    CH_Matrix_Classes::Integer block_eval_mid;
+
     //--- augmented model solver
     /// describes the feasible convex combinations of the bundle vectors
     QPConeModelDataObject* block;
@@ -199,6 +214,9 @@ namespace ConicBundle {
       return oracle;
     }
 
+    /// see SumBlockModel::get_aft_block_evaluator(); only an NNCBoxSupportFunction is evaluated blockwise
+    AFTBlockEvaluator* get_aft_block_evaluator(CH_Matrix_Classes::Integer y_id);
+
     //start_augmodel   //as in ConeModel
 
     // make_model_aggregate         //as in ConeModel
@@ -236,6 +254,31 @@ namespace ConicBundle {
 
     //@}
 
+    //----------------------------------------------------------------------
+    /** @name routines for saving and restoring the model (see MatrixCBSolver::save_state()) */
+    //@{
+
+    /// stores the function value in the center (without function factor) in @a center_value and appends the center minorant followed by the minorants of the bundle to @a minorants; returns nonzero if no up to date center evaluation is available
+    int get_model_minorants(CH_Matrix_Classes::Real& center_value,
+      MinorantBundle& minorants) const;
+
+    /** @brief the next call to evaluate_oracle() does not call the oracle but uses @a center_value and @a minorants instead
+
+       The minorants (they are taken over and deleted by *this) must have
+       the same meaning as those of MatrixFunctionOracle::evaluate() for
+       the point of the next evaluation. If one of them exceeds
+       @a center_value in this point, they are discarded and the oracle is
+       called as usual. This is used by MatrixCBSolver::load_state()
+       for setting up the model again without oracle calls.
+    */
+    int set_replay(CH_Matrix_Classes::Real center_value,
+      std::vector<Minorant*>& minorants);
+
+    /// deletes any minorants stored by set_replay()
+    void clear_replay();
+
+    //@}
+
     //----------------------------------------------------------------------
 
     /** @name overloaded SumBlockModel messages for direct get/set requestss */
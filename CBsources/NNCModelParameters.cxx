@@ -96,20 +96,20 @@ namespace ConicBundle {
       Real sumcoeffs = sum(modelcoeff);
       Real coeffzero = max(eps_Real, sumcoeffs * 1e-10);
       Real sumindicators = sum(indicators);
-      Real indicatorzero = max(eps_Real, 1e-3 * sumindicators / indicators.rowdim());
+      Real indicatorzero = max(eps_Real, 1e-3 * sumindicators / Real(indicators.rowdim()));
 
       //collect the new bundle and coefficients here and swap afterwards
       MinorantBundle newmodel;
-      Matrix newcoeff(modelcoeff.dim() + 1, 1, 0.);
+      newcoeff.newsize(modelcoeff.dim() + 1, 1);
       newcoeff.init(0, 1, 0.);
-      Matrix newindicator(modelcoeff.dim() + 1, 1, 0.);
+      newindicator.newsize(modelcoeff.dim() + 1, 1);
       newindicator.init(0, 1, 0.);
 
       //collect those that should be aggregated here and aggregate afterwards
       MinorantBundle aggrmodel;
-      Matrix aggrcoeff(modelcoeff.dim() + 1, 1, 0.);
+      aggrcoeff.newsize(modelcoeff.dim() + 1, 1);
       aggrcoeff.init(0, 1, 0.);
-      Matrix aggrindicator(modelcoeff.dim() + 1, 1, 0.);
+      aggrindicator.newsize(modelcoeff.dim() + 1, 1);
       aggrindicator.init(0, 1, 0.);
 
       //go through the old model, add the unaggregated ones with active indicator, aggregate the others if necessary
@@ -238,7 +238,7 @@ namespace ConicBundle {
     if (aggregate.valid())
       aggrval = aggregate.evaluate(y_id, y) / function_factor;
     else
-      aggrval = sum(tmpvec2) / tmpvec2.rowdim();
+      aggrval = sum(tmpvec2) / Real(tmpvec2.rowdim());
 
     //if the function is of penalty type AND the value in the candidate is 
     //negative for all new subgradients, do not change the model at all
@@ -252,7 +252,7 @@ namespace ConicBundle {
     // determine a maximal size of the model
     Integer max_heu_model_size = max_model_size;
     if (max_heu_model_size < 2) {
-      Real cutoff = max(eps_Real, 1e-6 * sum(modelcoeff) / modelcoeff.dim());
+      Real cutoff = max(eps_Real, 1e-6 * sum(modelcoeff) / Real(modelcoeff.dim()));
       Integer cnt = 0;
       for (Integer i = 0; i < modelcoeff.dim(); i++) {
         if (modelcoeff(i) > cutoff)
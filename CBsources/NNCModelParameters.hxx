@@ -64,6 +64,12 @@ namespace ConicBundle {
   */
   class NNCModelParameters : public NNCModelParametersObject {
   private:
+    //temporary variables of select_active_model(), global only for memory management purposes
+    CH_Matrix_Classes::Matrix newcoeff;      ///< coefficients of the minorants kept in the new model
+    CH_Matrix_Classes::Matrix newindicator;  ///< indicators of the minorants kept in the new model
+    CH_Matrix_Classes::Matrix aggrcoeff;     ///< coefficients of the minorants to be aggregated
+    CH_Matrix_Classes::Matrix aggrindicator; ///< indicators of the minorants to be aggregated
+
     /** @brief this implements update_rule 0 and 1: Add maximizing
        minorant, keep positive indicators if possible. Udate rule 1
        grows up to maximum size during null steps before aggregating
@@ -72,7 +72,7 @@ namespace ConicBundle {
               get_out() << "**** WARNING: PSCAffineMinorantExtender::extend(...): psd->primal_ip(...) failed for index=" << ind << std::endl;
             }
           } else {
-            if (mnrt.add_coeff(ind, value)) {
+            if (mnrt.add_coeff(int(ind), value)) {
               err++;
               if (cb_out()) {
                 get_out() << "**** WARNING: PSCAffineMinorantExtender::extend(...): adding a new coefficint to the minorant failed for index=" << ind << std::endl;
@@ -169,7 +169,7 @@ namespace ConicBundle {
       tmpsym.xetriu_yza(P, projected_Ritz_vectors);
 
       //---- determine maximum eigenvalue of tmpsym
-      int ret_val = tmpsym.eig(projected_Ritz_vectors, projected_Ritz_values, false);
+      int ret_val = int(tmpsym.eig(projected_Ritz_vectors, projected_Ritz_values, false));
       if (ret_val) {
         if (cb_out()) {
           get_out() << "**** WARNING: AMFMaxEigSolver::evaluate_projection(.....): eig returned " << ret_val << std::endl;
@@ -429,7 +429,7 @@ namespace ConicBundle {
         p = sdpp;
       }
     }
-    return new Minorant(true, cval, tmpvec.rowdim(), tmpvec.get_store(), 0, 1., p);
+    return new Minorant(true, cval, int(tmpvec.rowdim()), tmpvec.get_store(), 0, 1., p);
   }
 
   int  PSCAffineFunction::svec_projection(Matrix& svec_offset,
@@ -159,6 +159,14 @@ namespace ConicBundle {
        sparse part collected for the aggregate matrices of the model on a
        selected support as in SparsePSCPrimal.
 
+     - LowRankSparsePSCPrimal, for large orders where a dense \f$X\f$ does
+       not fit into memory. It keeps the aggregate in the factored form
+       \f$X\approx V\mbox{Diag}(d)V^T+S\f$ with the rank of \f$V\f$ bounded by
+       periodic recompression to the largest eigenvalues. The truncated part
+       is added to \f$S\f$, so \f$X\f$ is exact on the support of \f$S\f$
+       and the inner products with all \f$C\f$ and \f$A_i\f$ within this
+       support are formed correctly.
+
      - BlockPSCPrimal allows to represent the primal information of a diagonal
        block partition of the full \f$X\f$ by any choice of an PSCPrimal, in
        particular the ones given before. if \f$X\f$ is itself a block matrix,
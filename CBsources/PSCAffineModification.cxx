@@ -106,7 +106,7 @@ namespace ConicBundle {
 
     append_only = false;
 
-    var_olddim = max(0, volddim);
+    var_olddim = max(Integer(0), volddim);
     block_olddim = bolddim;
 
     var_newdim = var_olddim;
@@ -529,20 +529,20 @@ namespace ConicBundle {
 
      /// returns the number of variables before modification
     int get_old_vardim() const {
-      return old_vardim();
+      return int(old_vardim());
     }
     /// returns the number of variables once all stored modifications have been performed
     int get_new_vardim() const {
-      return new_vardim();
+      return int(new_vardim());
     }
     /// returns the number of variables that are appended (due to later reassignmentds they may no longer be located at the end)
     int get_appended_vardim() const {
-      return appended_vardim();
+      return int(appended_vardim());
     }
 
     /// returns null if there are no index changes, otherwise the Indexmatrix pointed to is a vector whose i-th entry holds the old index of the new i-th variable (injective!), index values exceeding old_vardim() refer to newly appended variables  
     const int* get_map_to_old_variables() const {
-      return (map_to_old_variables()) == 0 ? 0 : (const int*)(map_to_old_variables()->get_store());
+      return (var_map_to_old == 0) ? 0 : CH_Matrix_Classes::int_store(*var_map_to_old, int_buffer);
     }
 
     /** @brief add the modification specified in @a m on top of
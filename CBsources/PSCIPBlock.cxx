@@ -136,7 +136,7 @@ namespace ConicBundle {
   int PSCIPBlock::compute_Weig_Wvec() {
     int status = 0;
     if (Weig.rowdim() != rowdim) {
-      status = W.eig(Wvec, Weig, false);
+      status = int(W.eig(Wvec, Weig, false));
       if (status) {
         if (cb_out())
           get_out() << "\n**** WARNING PSCIPBlock::compute_Weig_Wvec(): W.eig failed and returned " << status << std::endl;
@@ -207,7 +207,7 @@ namespace ConicBundle {
 
 
   void PSCIPBlock::clear(Integer dim) {
-    rowdim = max(dim, 0);
+    rowdim = max(dim, Integer(0));
     vecdim = (rowdim * (rowdim + 1)) / 2;
     X.init(rowdim, 0.);
     Z.init(rowdim, 0.);
@@ -377,9 +377,9 @@ namespace ConicBundle {
     Real& ip_xz_xdzpdxz,
     Real& ip_xz_dxdz,
     Real& ip_dxdz_xdzpdxz) const {
-    const Real mu_xz = tr_xz / inmudim;
-    const Real mu_xdzpdxz = tr_xdzpdxz / inmudim;
-    const Real mu_dxdz = tr_dxdz / inmudim;
+    const Real mu_xz = tr_xz / Real(inmudim);
+    const Real mu_xdzpdxz = tr_xdzpdxz / Real(inmudim);
+    const Real mu_dxdz = tr_dxdz / Real(inmudim);
 
     genmult(dZ, tmpvec.init(X), tmpmat);
     genmult(Z, tmpvec.init(dX), tmpmat, 1., 1.);
@@ -654,7 +654,7 @@ namespace ConicBundle {
       tmpvec -= val0;
       lamX /= sum(lamX);
       Real devval = ip(lamX, tmpvec);
-      get_out() << " devval=" << devval << "(" << sum(tmpvec) / X.rowdim() << ")" << std::endl;
+      get_out() << " devval=" << devval << "(" << sum(tmpvec) / Real(X.rowdim()) << ")" << std::endl;
     }
 
     point_changed();
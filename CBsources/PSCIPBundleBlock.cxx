@@ -869,7 +869,7 @@ namespace ConicBundle {
     Real /* trace_rhs */) {
     PSCIPBlock::do_step(alpha);
 
-    int eigstat = X.eig(PX, lamX, false);
+    int eigstat = int(X.eig(PX, lamX, false));
     if (eigstat) {
       if (cb_out())
         get_out() << "**** WARNING PSCIPBlock::do_step(....): eigenvalue factorization failed and returned " << eigstat << std::endl;
@@ -1089,7 +1089,7 @@ namespace ConicBundle {
     //count candidates and reserve space
     Real threshold = minval * minval / nrmbnd / nrmbnd;
     Indexmatrix candpairs(vecdim, 2);
-    candpairs.init(0, 2, 0);
+    candpairs.init(0, 2, Integer(0));
     Indexmatrix candcnt(rowdim, 1, Integer(0));
     Indexmatrix delind(rowdim, 1);
     delind.init(0, 1, Integer(0));
@@ -1401,7 +1401,7 @@ namespace ConicBundle {
     Matrix& pscx_primalgrowth,
     Matrix& pscx_dualgrowth) {
     if (lamX.rowdim() != X.rowdim()) {
-      int eigstat = X.eig(PX, lamX, false);
+      int eigstat = int(X.eig(PX, lamX, false));
       if (eigstat) {
         if (cb_out())
           get_out() << "**** WARNING PSCIPBlock::get_pscx(....): eigenvalue factorization failed and returned " << eigstat << std::endl;
@@ -28,6 +28,7 @@
 #include "PSCModelParameters.hxx"
 #include "PSCVariableMetricSelection.hxx"
 #include "BundleIdProx.hxx"
+#include "timer_registry.hxx"
 
 using namespace CH_Tools;
 using namespace CH_Matrix_Classes;
@@ -103,6 +104,7 @@ namespace ConicBundle {
     const Matrix& y,
     Real nullstep_bound,
     Real relprec) {
+    CH_Tools::ScopedTimer scoped_timer("PSCModel::evaluate_oracle");
     assert(relprec > 0.);
 
     CH_Tools::Microseconds start_eval = clock.time();
@@ -307,7 +309,7 @@ namespace ConicBundle {
     //initialize the bundle if necessary
     if (data.bundlevecs.coldim() == 0) {
       assert(data.bundle_aggregate.empty());
-      Integer nc = min(data.topvecs.coldim() - 1, max(3, model_selection->get_max_model_size()));
+      Integer nc = min(data.topvecs.coldim() - 1, max(Integer(3), Integer(model_selection->get_max_model_size())));
       Indexmatrix ind;
       data.bundlevecs.init(data.topvecs.cols(Range(0, nc - 1)));
       data.primal_Ritzval = data.Ritz_values(0);
@@ -582,7 +584,7 @@ namespace ConicBundle {
       //assert(tmpmat.rowdim()==cand_y.rowdim());
       assert(tmpmat.coldim() == s2dim);
       for (Integer i = 0; i < s2dim; i++) {
-        bundle[cnt++].init(new Minorant(true, tmpvec(i), tmpmat.rowdim(), tmpmat.get_store() + i * tmpmat.rowdim()), data.get_modification_id());
+        bundle[cnt++].init(new Minorant(true, tmpvec(i), int(tmpmat.rowdim()), tmpmat.get_store() + i * tmpmat.rowdim()), data.get_modification_id());
         // if (cb_out(2)){
         //   get_out()<<" bundle["<<cnt-1<<"]=";
         //   bundle[cnt-1].display(get_out());
@@ -590,9 +592,11 @@ namespace ConicBundle {
       }
     } else {
       Integer dim = needed_indexsubset->dim();
+      std::vector<int> int_ind;
+      const int* indp = int_store(*needed_indexsubset, int_ind);
       assert((tmpmat.rowdim() == dim) && (tmpmat.coldim() == s2dim));
       for (Integer i = 0; i < s2dim; i++) {
-        bundle[cnt++].init(new Minorant(true, tmpvec(i), dim, tmpmat.get_store() + i * dim, needed_indexsubset->get_store()), data.get_modification_id());
+        bundle[cnt++].init(new Minorant(true, tmpvec(i), int(dim), tmpmat.get_store() + i * dim, indp), data.get_modification_id());
         // if (cb_out(2)){
         //   get_out()<<" bundle["<<cnt<<"]=";
         //   bundle[cnt-1].display(get_out());
@@ -24,6 +24,7 @@
 
 
 #include "PSCModelParameters.hxx"
+#include "PSCPrimal.hxx"
 
 using namespace CH_Matrix_Classes;
 
@@ -95,6 +96,22 @@ namespace ConicBundle {
           get_out() << "**** ERROR PSCModelParametersObject::get_minorant(......): oracle->generate_minorant failed to generate a minorant or returned one with offset_gives_value_at_origin()==false" << std::endl;
         return 1;
       }
+      if ((lowrank_primal_rank > 0) && (mnrt->get_primal() != 0) &&
+        (dynamic_cast<LowRankSparsePSCPrimal*>(mnrt->get_primal()) == 0)) {
+        //switch to the factored low rank representation on the same support
+        LowRankSparsePSCPrimal* lrp = 0;
+        const GramSparsePSCPrimal* gp = dynamic_cast<const GramSparsePSCPrimal*>(mnrt->get_primal());
+        if (gp) {
+          lrp = new LowRankSparsePSCPrimal(*gp, lowrank_primal_rank);
+          lrp->aggregate_Gram_matrix(gp->get_grammatrix(), 1.);
+        } else {
+          const SparsePSCPrimal* sp = dynamic_cast<const SparsePSCPrimal*>(mnrt->get_primal());
+          if (sp)
+            lrp = new LowRankSparsePSCPrimal(*sp, lowrank_primal_rank);
+        }
+        if (lrp)
+          mnrt->set_primal(lrp);
+      }
       if (mp.empty())
         mp.init(mnrt, modification_id);
       else
@@ -196,9 +213,9 @@ namespace ConicBundle {
         get_out() << " prim_Ritz=" << transpose(tmpvec);
       }
 
-      new_cutoffval = tmpvec(max(primalrank - 1, 0)) - .01 * diffval_center_aggregate;
+      new_cutoffval = tmpvec(max(primalrank - 1, Integer(0))) - .01 * diffval_center_aggregate;
     } else {
-      new_cutoffval = min(new_cutoffval, Ritz_values(min(Ritz_values.rowdim() - 1, max(primalrank, 0))) - .01 * diffval_center_aggregate);
+      new_cutoffval = min(new_cutoffval, Ritz_values(min(Ritz_values.rowdim() - 1, max(primalrank, Integer(0)))) - .01 * diffval_center_aggregate);
     }
 
     if (model_update != BundleModel::null_step) {
@@ -260,7 +277,7 @@ namespace ConicBundle {
       skpsz++;
     }
 
-    skippedsize = max(min(10, Ritz_values.dim() - activedim), min(20, skpsz));
+    skippedsize = max(min(Integer(10), Ritz_values.dim() - activedim), min(Integer(20), skpsz));
 
     topvecs.delete_cols(Range(activedim + skippedsize, topvecs.coldim() - 1));
     Ritz_values.reduce_length(topvecs.coldim());
@@ -292,9 +309,9 @@ namespace ConicBundle {
       } else if (update_rule == 4) {
         acceptval = cutoffval - 10 * gapsz;
       } else if (update_rule == 5) {
-        acceptval = cutoffval - n_nullsteps * gapsz;
+        acceptval = cutoffval - Real(n_nullsteps) * gapsz;
       } else if (update_rule == 6) {
-        acceptval = cutoffval - (5 + n_nullsteps) * gapsz;
+        acceptval = cutoffval - Real(5 + n_nullsteps) * gapsz;
       }
       if (cb_out(2)) {
         get_out() << " acceptval=" << acceptval;
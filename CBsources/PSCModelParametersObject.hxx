@@ -121,30 +121,55 @@ namespace ConicBundle {
 
     //bool enforce_separate_model; // when forming combined models for a sum of functions, enforce a separate model for this function
 
+    CH_Matrix_Classes::Integer lowrank_primal_rank; ///< if positive, sparse primal data of new minorants is converted to LowRankSparsePSCPrimal with this maximum rank
+
   public:
-    /// initialize BundleParameters to given values, if bp is a SumModleParametersObject alos set n_local_models to its values, otherwise leave it unchanged
+    /// initialize BundleParameters to given values, if bp is a PSCModelParametersObject also set lowrank_primal_rank to its value, otherwise leave it unchanged
     int init(const BundleParameters& bp) {
       BundleParameters::init(bp);
       const PSCModelParametersObject* mpo = dynamic_cast<const PSCModelParametersObject*>(&bp);
       if (mpo) {
         set_cbout(mpo, 0);
+        lowrank_primal_rank = mpo->lowrank_primal_rank;
       }
       return 0;
     }
 
     /// default constructor
     PSCModelParametersObject(const CBout* cb = 0, int cbinc = -1) :
-      CBout(cb, cbinc), BundleParameters() {
+      CBout(cb, cbinc), BundleParameters(), lowrank_primal_rank(0) {
     }
 
     /// copy constructor for BundleParameters
     PSCModelParametersObject(const BundleParameters& bp, const CBout* cb = 0, int cbinc = -1) :
-      CBout(cb, cbinc), BundleParameters(bp) {
+      CBout(cb, cbinc), BundleParameters(bp), lowrank_primal_rank(0) {
+      const PSCModelParametersObject* mpo = dynamic_cast<const PSCModelParametersObject*>(&bp);
+      if (mpo)
+        lowrank_primal_rank = mpo->lowrank_primal_rank;
     }
 
     ///copy constructor
     PSCModelParametersObject(const PSCModelParametersObject& sms) :
-      CBout(sms), BundleParameters(sms) {
+      CBout(sms), BundleParameters(sms), lowrank_primal_rank(sms.lowrank_primal_rank) {
+    }
+
+    /** @brief select the primal representation LowRankSparsePSCPrimal for large orders
+
+        If @a rank is positive, the primal data of each minorant generated
+        by get_minorant() is converted to a LowRankSparsePSCPrimal with
+        maximum rank @a rank, provided the generating PSCPrimal of the
+        oracle (see PSCAffineFunction) is a SparsePSCPrimal or a
+        GramSparsePSCPrimal; its support is kept. The aggregate then
+        stays in the factored form instead of collecting the Gram
+        matrices. Zero (the default) leaves the primal data unchanged.
+    */
+    void set_lowrank_primal_rank(CH_Matrix_Classes::Integer rank) {
+      lowrank_primal_rank = CH_Matrix_Classes::max(rank, CH_Matrix_Classes::Integer(0));
+    }
+
+    /// returns the maximum rank for converting primal data to LowRankSparsePSCPrimal (0 if switched off)
+    CH_Matrix_Classes::Integer get_lowrank_primal_rank() const {
+      return lowrank_primal_rank;
     }
 
     ///virtual destructor, implemented in PSCModelParameters.cxx
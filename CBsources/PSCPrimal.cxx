@@ -23,13 +23,289 @@
 
 
 
+#include <algorithm>
 #include "PSCPrimal.hxx"
+#include "sumop.hxx"
+#include "thread_pool.hxx"
 
 using namespace CH_Matrix_Classes;
 
 
 namespace ConicBundle {
 
+  // *************************************************************************
+  //                  DensePSCPrimal::aggregate_primal_data_batch
+  // *************************************************************************
+
+  int DensePSCPrimal::aggregate_primal_data_batch(const std::vector<const PrimalData*>& primals, const DVector& factors) {
+    assert(primals.size() == factors.size());
+    std::vector<const Real*> a;
+    std::vector<Real> f;
+    a.reserve(primals.size());
+    f.reserve(primals.size());
+    for (unsigned int i = 0; i < primals.size(); i++) {
+      if ((primals[i] == 0) || (factors[i] == 0.))
+        continue;
+      const DensePSCPrimal* pd = dynamic_cast<const DensePSCPrimal*>(primals[i]);
+      if ((pd == 0) || (pd->rowdim() != rowdim()))
+        return PrimalData::aggregate_primal_data_batch(primals, factors);
+      a.push_back(pd->get_store());
+      f.push_back(factors[i]);
+    }
+    //the lower triangle is stored columnwise in one array
+    sumop_xpeya((rowdim() * (rowdim() + 1)) / 2, get_store(), Integer(a.size()), a.data(), f.data());
+    return 0;
+  }
+
+  // *************************************************************************
+  //                  batch aggregation of sparse PSCPrimals
+  // *************************************************************************
+
+  // the summand factor*(sps+gram*gram^T) (gram may be 0) to be added on the support
+  struct SparsePSCPrimalBatchTerm {
+    const Sparsesym* sps;
+    const Matrix* gram;
+    Real factor;
+  };
+
+  // adds the summands lo,...,hi-1 to acc on the support of acc; with beta=1 these
+  // routines do not allocate memory, so this may run in a thread of its own
+  static void sparse_psc_primal_batch_range(const SparsePSCPrimalBatchTerm* terms,
+    Integer lo, Integer hi, Sparsesym* acc) {
+    for (Integer i = lo; i < hi; i++) {
+      acc->support_xbpeya(*terms[i].sps, terms[i].factor, 1.);
+      if ((terms[i].gram) && (terms[i].gram->dim() != 0))
+        support_rankadd(*terms[i].gram, *acc, terms[i].factor, 1.);
+    }
+  }
+
+  // adds all summands to S on its support; for large work each thread adds a
+  // consecutive range of summands with about the same work to its own copy of S
+  // with zero values, these are summed up afterwards
+  static void sparse_psc_primal_batch(Sparsesym& S, const std::vector<SparsePSCPrimalBatchTerm>& terms) {
+    const Integer n = Integer(terms.size());
+    if (n == 0)
+      return;
+    const Real snz = Real(S.nonzeros());
+    std::vector<Real> cumwork(std::size_t(n + 1), 0.);
+    for (Integer i = 0; i < n; i++) {
+      Real w = snz + Real(terms[i].sps->nonzeros());
+      if (terms[i].gram)
+        w += snz * Real(terms[i].gram->coldim());
+      cumwork[i + 1] = cumwork[i] + w;
+    }
+    const Integer nt = sumop_nthreads(cumwork[n], n);
+    if (nt <= 1) {
+      sparse_psc_primal_batch_range(terms.data(), 0, n, &S);
+      return;
+    }
+
+    std::vector<Integer> bounds(std::size_t(nt + 1), n);
+    bounds[0] = 0;
+    for (Integer t = 1; t < nt; t++)
+      bounds[t] = Integer(std::lower_bound(cumwork.begin(), cumwork.end(), (cumwork[n] * Real(t)) / Real(nt)) - cumwork.begin());
+
+    //the accumulators are allocated here, not in the threads (Memarray is not thread safe)
+    std::vector<Sparsesym> acc(std::size_t(nt - 1), S);
+    for (unsigned int t = 0; t < acc.size(); t++)
+      acc[t] *= 0.;
+
+    CH_Tools::ThreadPool::run(int(nt), [&terms, &bounds, &acc, &S](int t) {
+      sparse_psc_primal_batch_range(terms.data(), bounds[std::size_t(t)], bounds[std::size_t(t + 1)], (t == 0) ? &S : &acc[std::size_t(t - 1)]);
+    });
+    for (unsigned int t = 0; t < acc.size(); t++)
+      S.support_xbpeya(acc[t], 1., 1.);
+  }
+
+  // *************************************************************************
+  //                  SparsePSCPrimal::aggregate_primal_data_batch
+  // *************************************************************************
+
+  int SparsePSCPrimal::aggregate_primal_data_batch(const std::vector<const PrimalData*>& primals, const DVector& factors) {
+    assert(primals.size() == factors.size());
+    std::vector<SparsePSCPrimalBatchTerm> terms;
+    terms.reserve(primals.size());
+    for (unsigned int i = 0; i < primals.size(); i++) {
+      if ((primals[i] == 0) || (factors[i] == 0.))
+        continue;
+      const SparsePSCPrimal* pd = dynamic_cast<const SparsePSCPrimal*>(primals[i]);
+      if ((pd == 0) || (pd->rowdim() != rowdim()))
+        return PrimalData::aggregate_primal_data_batch(primals, factors);
+      SparsePSCPrimalBatchTerm term = { pd, 0, factors[i] };
+      terms.push_back(term);
+    }
+    sparse_psc_primal_batch(*this, terms);
+    return 0;
+  }
+
+  // *************************************************************************
+  //                GramSparsePSCPrimal::aggregate_primal_data_batch
+  // *************************************************************************
+
+  int GramSparsePSCPrimal::aggregate_primal_data_batch(const std::vector<const PrimalData*>& primals, const DVector& factors) {
+    assert(primals.size() == factors.size());
+    std::vector<SparsePSCPrimalBatchTerm> terms;
+    terms.reserve(primals.size());
+    for (unsigned int i = 0; i < primals.size(); i++) {
+      if ((primals[i] == 0) || (factors[i] == 0.))
+        continue;
+      assert(factors[i] >= 0.);
+      SparsePSCPrimalBatchTerm term = { 0, 0, factors[i] };
+      const GramSparsePSCPrimal* pd = dynamic_cast<const GramSparsePSCPrimal*>(primals[i]);
+      if (pd != 0) {
+        term.sps = pd;
+        term.gram = &(pd->gramblock);
+      } else {
+        term.sps = dynamic_cast<const SparsePSCPrimal*>(primals[i]);
+      }
+      if ((term.sps == 0) || (term.sps->rowdim() != rowdim()))
+        return PrimalData::aggregate_primal_data_batch(primals, factors);
+      terms.push_back(term);
+    }
+    sparse_psc_primal_batch(*this, terms);
+    return 0;
+  }
+
+
+  void LowRankSparsePSCPrimal::append_lowrank(const Matrix& P, const Matrix* eigs, double factor) {
+    assert(factor >= 0.);
+    if ((P.coldim() == 0) || (factor == 0.))
+      return;
+    assert(P.rowdim() == rowdim());
+    assert((eigs == 0) || (eigs->dim() == P.coldim()));
+    lowrank_vecs.concat_right(P);
+    if (eigs)
+      lowrank_eigs.concat_below(Matrix(*eigs, factor));
+    else
+      lowrank_eigs.concat_below(Matrix(P.coldim(), 1, factor));
+    if (lowrank_vecs.coldim() > 2 * maxrank)
+      compress(maxrank);
+  }
+
+  void LowRankSparsePSCPrimal::set_maxrank(Integer mr) {
+    maxrank = max(mr, Integer(1));
+    if (lowrank_vecs.coldim() > maxrank)
+      compress(maxrank);
+  }
+
+  int LowRankSparsePSCPrimal::compress(Integer rank) {
+    Integer k = lowrank_vecs.coldim();
+    if (k == 0)
+      return 0;
+
+    //W*W^T with W=V*Diag(sqrt(d)) is the low rank part, get its eigenvectors via W^T*W
+    Matrix W(lowrank_vecs);
+    Matrix tmpvec(lowrank_eigs);
+    W.scale_cols(tmpvec.sqrt());
+    Symmatrix G;
+    rankadd(W, G, 1., 0., 1);
+    Matrix U;
+    Matrix lam;
+    if (G.eig(U, lam, false))
+      return 1;
+    Matrix WU;
+    genmult(W, U, WU);
+
+    //keep the largest eigenvalues, the columns of WU have squared norm lam
+    Real tol = 1e-12 * max(lam(0), 0.);
+    Integer r = 0;
+    while ((r < min(rank, k)) && (lam(r) > tol))
+      r++;
+
+    //the truncated part is kept on the support of the sparse part
+    if (r < k)
+      support_rankadd(WU.cols(Range(r, k - 1)), *this, 1., 1.);
+
+    if (r == 0) {
+      lowrank_vecs.init(0, 0, 0.);
+      lowrank_eigs.init(0, 0, 0.);
+      return 0;
+    }
+    lowrank_eigs = lam.rows(Range(0, r - 1));
+    lowrank_vecs = WU.cols(Range(0, r - 1));
+    tmpvec = lowrank_eigs;
+    tmpvec.sqrt();
+    tmpvec.inv();
+    lowrank_vecs.scale_cols(tmpvec);
+    return 0;
+  }
+
+  int LowRankSparsePSCPrimal::assign_Gram_matrix(const Matrix& P) {
+    assert(P.rowdim() == rowdim());
+    *this *= 0.;
+    lowrank_vecs.init(0, 0, 0.);
+    lowrank_eigs.init(0, 0, 0.);
+    append_lowrank(P, 0, 1.);
+    return 0;
+  }
+
+  int LowRankSparsePSCPrimal::aggregate_primal_data(const PrimalData& it, double factor) {
+    assert(factor >= 0.);
+    const LowRankSparsePSCPrimal* lp = dynamic_cast<const LowRankSparsePSCPrimal*>(&it);
+    if (lp != 0) {
+      this->support_xbpeya(*lp, factor, 1.);
+      append_lowrank(lp->lowrank_vecs, &lp->lowrank_eigs, factor);
+      return 0;
+    }
+    const GramSparsePSCPrimal* gp = dynamic_cast<const GramSparsePSCPrimal*>(&it);
+    if (gp != 0) {
+      this->support_xbpeya(*gp, factor, 1.);
+      append_lowrank(gp->get_grammatrix(), 0, factor);
+      return 0;
+    }
+    const SparsePSCPrimal* ps = dynamic_cast<const SparsePSCPrimal*>(&it);
+    if (ps != 0) {
+      this->support_xbpeya(*ps, factor, 1.);
+      return 0;
+    }
+    return 1;
+  }
+
+  int LowRankSparsePSCPrimal::aggregate_Gram_matrix(const Matrix& P, double factor) {
+    assert(factor >= 0.);
+    append_lowrank(P, 0, factor);
+    return 0;
+  }
+
+  int LowRankSparsePSCPrimal::primal_ip(Real& value,
+    const SparseCoeffmatMatrix& A,
+    Integer column) const {
+    if ((column < 0) || (column >= A.coldim()) || (A.blockdim().dim() != 1) || (A.blockdim()(0) != rowdim()))
+      return 1;
+    const SparseCoeffmatVector* block = A.block(0);
+    if (block == 0) {
+      value = 0.;
+    } else {
+      SparseCoeffmatVector::const_iterator it = block->find(column);
+      if (it == block->end())
+        value = 0.;
+      else {
+        if (it->second->support_in(*this) == 0) {
+          return 1;
+        }
+        value = it->second->ip(*this);
+        if (lowrank_vecs.coldim() > 0)
+          value += it->second->gramip(lowrank_vecs, 0, &lowrank_eigs);
+      }
+    }
+    return 0;
+  }
+
+  int LowRankSparsePSCPrimal::Gram_ip(Real& value, const Matrix& P) const {
+    if (P.rowdim() != rowdim())
+      return 1;
+    Matrix tmpmat;
+    genmult(*this, P, tmpmat, 1., 0., 0);
+    value = ip(P, tmpmat);
+    if (lowrank_vecs.coldim() > 0) {
+      genmult(lowrank_vecs, P, tmpmat, 1., 0., 1);
+      Matrix tmpmat2(tmpmat);
+      tmpmat2.scale_rows(lowrank_eigs);
+      value += ip(tmpmat, tmpmat2);
+    }
+    return 0;
+  }
+
 
   BlockPSCPrimal::BlockPSCPrimal(const BlockPSCPrimal& pr, double factor) : PSCPrimal() {
     assert(factor >= 0.);
@@ -92,6 +368,37 @@ namespace ConicBundle {
     return 0;
   }
 
+  int BlockPSCPrimal::aggregate_primal_data_batch(const std::vector<const PrimalData*>& primals, const DVector& factors) {
+    assert(primals.size() == factors.size());
+    std::vector<const BlockPSCPrimal*> bp(primals.size(), 0);
+    for (unsigned int k = 0; k < primals.size(); k++) {
+      if ((primals[k] == 0) || (factors[k] == 0.))
+        continue;
+      bp[k] = dynamic_cast<const BlockPSCPrimal*>(primals[k]);
+      if (bp[k] == 0)
+        return PrimalData::aggregate_primal_data_batch(primals, factors);
+      assert(norm2(Xdim - bp[k]->Xdim) < 0.1);
+    }
+    //collect the corresponding blocks before changing anything
+    std::vector< std::vector<const PrimalData*> > blockprimals(primal.size(), std::vector<const PrimalData*>(primals.size(), 0));
+    unsigned int b = 0;
+    for (std::map<Integer, PSCPrimal*>::iterator i = primal.begin(); i != primal.end(); ++i, ++b) {
+      for (unsigned int k = 0; k < primals.size(); k++) {
+        if (bp[k] == 0)
+          continue;
+        std::map<Integer, PSCPrimal*>::const_iterator j = bp[k]->primal.find(i->first);
+        if ((j == bp[k]->primal.end()) || (j->second == 0))
+          return PrimalData::aggregate_primal_data_batch(primals, factors);
+        blockprimals[b][k] = j->second;
+      }
+    }
+    int err = 0;
+    b = 0;
+    for (std::map<Integer, PSCPrimal*>::iterator i = primal.begin(); i != primal.end(); ++i, ++b)
+      err += i->second->aggregate_primal_data_batch(blockprimals[b], factors);
+    return err;
+  }
+
   /// multiply this with myfactor and add itsfactor*P*P^T to this
   int BlockPSCPrimal::aggregate_Gram_matrix(const Matrix& P, double factor) {
     assert(sum(Xdim) == P.rowdim());
@@ -152,6 +459,16 @@ namespace ConicBundle {
           value += it->second->ip(*sp);
           continue;
         }
+        const LowRankSparsePSCPrimal* lp = dynamic_cast<const LowRankSparsePSCPrimal*>(pit->second);
+        if (lp) {
+          if (it->second->support_in(*lp) == 0) {
+            return 1;
+          }
+          value += it->second->ip(*lp);
+          if (lp->get_lowrank_vecs().coldim() > 0)
+            value += it->second->gramip(lp->get_lowrank_vecs(), 0, &lp->get_lowrank_eigs());
+          continue;
+        }
         return 1;
       }
     }
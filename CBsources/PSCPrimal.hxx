@@ -27,7 +27,7 @@
 #define CONICBUNDLE_PSCPRIMAL_HXX
 
 /**  @file PSCPrimal.hxx
-    @brief Header declaring the classes ConicBundle::PSCPrimal, ConicBundle::DensePSCPrimal, ConicBundle::SparsePSCPrimal, ConicBundle::GramSparsePSCPrimal, ConicBundle::BlockPSCPrimal (designed for ConicBundle::PSCOracle and ConicBundle::AffineMatrixFunction)
+    @brief Header declaring the classes ConicBundle::PSCPrimal, ConicBundle::DensePSCPrimal, ConicBundle::SparsePSCPrimal, ConicBundle::GramSparsePSCPrimal, ConicBundle::LowRankSparsePSCPrimal, ConicBundle::BlockPSCPrimal (designed for ConicBundle::PSCOracle and ConicBundle::AffineMatrixFunction)
     @version 1.0
     @date 2017-02-04
     @author Christoph Helmberg
@@ -141,6 +141,9 @@ namespace ConicBundle {
       return 0;
     }
 
+    /// if all are DensePSCPrimal objects of the same size, add them in one (for large data threaded) pass over *this, otherwise see PrimalData::aggregate_primal_data_batch()
+    virtual int aggregate_primal_data_batch(const std::vector<const PrimalData*>& primals, const DVector& factors);
+
     /// add factor*P*P^T to this
     virtual int aggregate_Gram_matrix(const CH_Matrix_Classes::Matrix& P, double factor = 1.) {
       CH_Matrix_Classes::rankadd(P, *this, factor, 1.); return 0;
@@ -211,6 +214,9 @@ namespace ConicBundle {
       return 0;
     }
 
+    /// if all are SparsePSCPrimal objects of the same order, add them on the support of this, for large data split among threads, otherwise see PrimalData::aggregate_primal_data_batch()
+    int aggregate_primal_data_batch(const std::vector<const PrimalData*>& primals, const DVector& factors);
+
     /// add factor*P*P^T on the support to this
     int aggregate_Gram_matrix(const CH_Matrix_Classes::Matrix& P, double factor = 1.) {
       CH_Matrix_Classes::support_rankadd(P, *this, factor, 1.); return 0;
@@ -305,7 +311,7 @@ namespace ConicBundle {
       if (pd != 0) {
         this->support_xbpeya(*pd, factor, 1.);
         if (pd->gramblock.dim() != 0)
-          CH_Matrix_Classes::support_rankadd(pd->gramblock, *this, factor);
+          CH_Matrix_Classes::support_rankadd(pd->gramblock, *this, factor, 1.);
         return 0;
       }
       const SparsePSCPrimal* ps = dynamic_cast<const SparsePSCPrimal*>(&it);
@@ -316,6 +322,9 @@ namespace ConicBundle {
       return 1;
     }
 
+    /// if all are GramSparsePSCPrimal or SparsePSCPrimal objects of the same order, add them like aggregate_primal_data() on the support of this, for large data split among threads, otherwise see PrimalData::aggregate_primal_data_batch()
+    int aggregate_primal_data_batch(const std::vector<const PrimalData*>& primals, const DVector& factors);
+
     /**@brief add factor*P*P^T to this, collecting
        all available information only in the sparse part, even the own Gram part.
 
@@ -364,6 +373,114 @@ namespace ConicBundle {
     }
   };
 
+  /** @brief represents a PSCPrimal in factored form \f$V\mbox{Diag}(d)V^T+S\f$ with a low rank part of bounded rank and a sparse symmetric matrix \f$S\f$ on a prespecified support
+
+      This is meant for large orders where a DensePSCPrimal is too big to
+      be stored. Aggregating primal information appends the new Gram
+      vectors to \f$V\f$. Once \f$V\f$ has more than twice the maximum
+      rank (see set_maxrank()) columns, it is recompressed to the
+      eigenvectors of the maxrank largest eigenvalues of the low rank
+      part. The truncated part is not lost entirely, its values on the
+      support of \f$S\f$ are added to \f$S\f$. Therefore the matrix is
+      exact on the support of \f$S\f$ and primal_ip() is exact for all
+      coefficient matrices within the support. Outside the support only
+      the low rank approximation is available.
+
+      LowRankSparsePSCPrimal is pubically derived from PSCPrimal _and_ CH_Matrix_Classes::Sparseym, so it may be used directly like a sparse symmetric matrix, but this does then _not_ include or involve the low rank part!
+   */
+
+  class LowRankSparsePSCPrimal : public PSCPrimal, public CH_Matrix_Classes::Sparsesym {
+  private:
+    CH_Matrix_Classes::Matrix lowrank_vecs; ///< the columns of \f$V\f$
+    CH_Matrix_Classes::Matrix lowrank_eigs; ///< the nonnegative diagonal \f$d\f$
+    CH_Matrix_Classes::Integer maxrank; ///< the rank of the low rank part after recompression
+
+    /// append the columns of P scaled by factor to the low rank part and recompress if there are too many
+    void append_lowrank(const CH_Matrix_Classes::Matrix& P, const CH_Matrix_Classes::Matrix* eigs, double factor);
+
+  public:
+    /// initialize to the given sparse symmetric matrix, the low rank part is zero; the support of sps is used in all operations
+    LowRankSparsePSCPrimal(const CH_Matrix_Classes::Sparsesym& sps, CH_Matrix_Classes::Integer in_maxrank = 20, double factor = 1.) : PSCPrimal(), CH_Matrix_Classes::Sparsesym(sps, factor) {
+      maxrank = CH_Matrix_Classes::max(in_maxrank, CH_Matrix_Classes::Integer(1));
+    }
+    /// copy constructor
+    LowRankSparsePSCPrimal(const LowRankSparsePSCPrimal& pr, double factor = 1.) :
+      PSCPrimal(),
+      CH_Matrix_Classes::Sparsesym(pr, factor),
+      lowrank_vecs(pr.lowrank_vecs),
+      lowrank_eigs(pr.lowrank_eigs, factor),
+      maxrank(pr.maxrank) {
+      assert(factor >= 0.);
+    }
+    ///
+    ~LowRankSparsePSCPrimal() {
+    }
+    /// assign the sparse symmetric matrix to this and set the low rank part to zero
+    LowRankSparsePSCPrimal& operator=(const CH_Matrix_Classes::Sparsesym& sdp) {
+      init(sdp); lowrank_vecs.init(0, 0, 0.); lowrank_eigs.init(0, 0, 0.); return *this;
+    }
+    /// copy the information
+    LowRankSparsePSCPrimal& operator=(const LowRankSparsePSCPrimal& sdp) {
+      init(sdp); lowrank_vecs = sdp.lowrank_vecs; lowrank_eigs = sdp.lowrank_eigs; maxrank = sdp.maxrank; return *this;
+    }
+
+    /// returns the matrix \f$V\f$ of the low rank part \f$V\mbox{Diag}(d)V^T\f$
+    const CH_Matrix_Classes::Matrix& get_lowrank_vecs() const {
+      return lowrank_vecs;
+    }
+
+    /// returns the vector \f$d\f$ of the low rank part \f$V\mbox{Diag}(d)V^T\f$
+    const CH_Matrix_Classes::Matrix& get_lowrank_eigs() const {
+      return lowrank_eigs;
+    }
+
+    /// returns the rank the low rank part is compressed to
+    CH_Matrix_Classes::Integer get_maxrank() const {
+      return maxrank;
+    }
+
+    /// sets the rank the low rank part is compressed to (at least 1); a smaller rank causes an immediate recompression
+    void set_maxrank(CH_Matrix_Classes::Integer mr);
+
+    /** @brief replaces the low rank part by its eigendecomposition restricted to
+        the (at most) @a rank largest eigenvalues; the truncated part is added to
+        the sparse part on its support
+    */
+    int compress(CH_Matrix_Classes::Integer rank);
+
+    /// returns a newly generated identical Object
+    PrimalData* clone_primal_data() const {
+      return new LowRankSparsePSCPrimal(*this);
+    }
+
+    /// Set the low rank part to \f$PP^T\f$ and set all values on the sparse support to zero (but keep this support even if it is zero now!)
+    int assign_Gram_matrix(const CH_Matrix_Classes::Matrix& P);
+
+    /**@brief add factor*it to this, where it may be a LowRankSparsePSCPrimal, a GramSparsePSCPrimal or a SparsePSCPrimal
+
+       The sparse part of it is added on the support of this, the low
+       rank or Gram part of it is appended to the low rank part of this.
+     */
+    int aggregate_primal_data(const PrimalData& it, double factor = 1.);
+
+    /// add factor*P*P^T to the low rank part of this
+    int aggregate_Gram_matrix(const CH_Matrix_Classes::Matrix& P, double factor = 1.);
+
+    /// multiply/scale *this with a nonnegative factor
+    virtual int scale_primal_data(double factor) {
+      assert(factor >= 0.); *this *= factor; lowrank_eigs *= factor; return 0;
+    }
+
+    /// if compatible evaluate value=ip(*this,A.column[i]), the coefficient matrix must be within the support of the sparse part
+    virtual int primal_ip(CH_Matrix_Classes::Real& value,
+      const SparseCoeffmatMatrix& A,
+      CH_Matrix_Classes::Integer column) const;
+
+    /// evaluate value=ip(*this,P*P^T) directly on the factors
+    int Gram_ip(CH_Matrix_Classes::Real& value,
+      const CH_Matrix_Classes::Matrix& P) const;
+  };
+
   /** @brief implements a block diagonal PSCPrimal consisting of several PSCPrimal blocks
 
       The partition is generated on construction and at this point the various kinds
@@ -402,6 +519,9 @@ namespace ConicBundle {
         (it must also be a BlockPSCPrimal with the same block partition) */
     virtual int aggregate_primal_data(const PrimalData& it, double factor = 1.);
 
+    /** add factors[i]*primals[i] to this for all i (they must also be BlockPSCPrimal objects with the same block partition); the PSCPrimal of each block aggregates the corresponding blocks by its aggregate_primal_data_batch() */
+    virtual int aggregate_primal_data_batch(const std::vector<const PrimalData*>& primals, const DVector& factors);
+
     /**@brief add factor*P*P^T to this
 
        The rows of P corresponding to each block are passed on the
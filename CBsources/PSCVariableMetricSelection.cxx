@@ -91,7 +91,7 @@ namespace ConicBundle {
     lamH.sqrt();
     Matrix Q1AQ2;   //=Q_1^T*A*Q2
     for (Integer k = 0; k < dim; k++) {
-      oracle->left_right_product(k, tmpQ1, tmpQ2, Q1AQ2);
+      oracle->left_right_product(int(k), tmpQ1, tmpQ2, Q1AQ2);
       const Real* lamp = lamH.get_store();
       for (Integer j = 0; j < skipdim; j++) {
         for (Integer i = 0; i < primdim; i++) {
@@ -125,7 +125,7 @@ namespace ConicBundle {
         dmax = max(dmax, S(i, i));
       }
       S /= dmax;
-      if ((retval = S.eig(tmpQ2, lamH, false))) {
+      if ((retval = int(S.eig(tmpQ2, lamH, false)))) {
         if (cb_out())
           get_out() << "**** ERROR: PSCVariableMetricSelection::add_variable_metric(): S.eig failed and returned " << retval << std::endl;
       }
@@ -175,7 +175,7 @@ namespace ConicBundle {
         old_lowrankH.concat_right(vecH);
         rankadd(old_lowrankH, S, 1., 0., 1);
         Matrix P, lam;
-        int retval = S.eig(tmpQ2, tmpvec, false);
+        int retval = int(S.eig(tmpQ2, tmpvec, false));
         if ((min(tmpvec) < -1e-6) || (retval)) {
           if (cb_out())
             get_out() << "**** WARNING: PSCVariableMetricSelection::add_variable_metric(...): S.eig failed for average with previous lowrank representation and returned " << retval << " (order=" << S.rowdim() << ") and minimum eigenvalue = " << min(tmpvec) << std::endl;
@@ -191,7 +191,7 @@ namespace ConicBundle {
         genmult(old_lowrankH, tmpQ2, vecH);
 
         if (cb_out(2)) {
-          get_out() << "\n lam1.dim=" << tmpvec.dim() << " max(lam1)=" << tmpvec(lam) << " sum(lam1)=" << sum(tmpvec) << " avg(lam1)=" << sum(tmpvec) / tmpvec.dim() << std::endl;
+          get_out() << "\n lam1.dim=" << tmpvec.dim() << " max(lam1)=" << tmpvec(lam) << " sum(lam1)=" << sum(tmpvec) << " avg(lam1)=" << sum(tmpvec) / Real(tmpvec.dim()) << std::endl;
         }
       }
 
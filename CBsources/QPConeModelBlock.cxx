@@ -599,7 +599,7 @@ namespace ConicBundle {
     // //TEST output end
 
     //primal side
-    Real initval = trace_rhs / mu_dim;
+    Real initval = trace_rhs / Real(mu_dim);
     for (unsigned i = 0; i < block.size(); i++) {
       block[i]->center_x(initval);
     }
@@ -622,7 +622,7 @@ namespace ConicBundle {
       si += block[i]->dim_bundle();
     }
     if (use_trace) {
-      trace_dual = max(add_val + 1., mu / initval - tracez / mu_dim);
+      trace_dual = max(add_val + 1., mu / initval - tracez / Real(mu_dim));
       modeldim = 0;
       for (unsigned i = 0; i < block.size(); i++) {
         block[i]->center_z(trace_dual, true);
@@ -699,9 +699,9 @@ namespace ConicBundle {
         ip_xz_xdzpdxz, ip_xz_dxdz, ip_dxdz_xdzpdxz);
     }
     if ((use_trace) && (ft != ObjectiveFunction)) {
-      const Real mu_xz = tr_xz / inmudim;
-      const Real mu_xdzpdxz = tr_xdzpdxz / inmudim;
-      const Real mu_dxdz = tr_dxdz / inmudim;
+      const Real mu_xz = tr_xz / Real(inmudim);
+      const Real mu_xdzpdxz = tr_xdzpdxz / Real(inmudim);
+      const Real mu_dxdz = tr_dxdz / Real(inmudim);
       const Real mu_at_one = mu_xz + mu_xdzpdxz + mu_dxdz;
 
       NNC_nbh_stepsize(trace_slack, trace_dual, trace_delta_slack, trace_delta_dual,
@@ -905,7 +905,7 @@ namespace ConicBundle {
         tmpvec.xpeya(trace_vec, ip(sysinv_trace, tmpvec) / (sys_trace + trsysitr));
         //apply as second step the block inverses
       }
-      int modelind = 0;
+      Integer modelind = 0;
       for (unsigned i = 0; i < block.size(); i++) {
         block[i]->apply_xizinv(tmpvec, modelind);
         modelind += block[i]->get_vecdim();
@@ -933,7 +933,7 @@ namespace ConicBundle {
     MinorantBundle& globalbundle,
     Integer startindex_bundle) {
     Matrix tmpmat;
-    int bundle_ind = startindex_bundle;
+    Integer bundle_ind = startindex_bundle;
 
     //modelpart
     for (unsigned i = 0; i < block.size(); i++) {
@@ -27,6 +27,7 @@
 #include <sstream>
 #include <fstream>
 #include "QPDirectKKTSolver.hxx"
+#include "timer_registry.hxx"
 
 using namespace CH_Matrix_Classes;
 
@@ -56,6 +57,14 @@ namespace ConicBundle {
     CABinvCt_inv.init(0, 0.);
     LinvC.init(0, 0, 0.);
     piv.init(0, 0, Integer(0));
+    sysmat.init(0, 0.);
+    factor_valid = false;
+    factor_current = false;
+    reuse_failed = false;
+
+    blocksolx.init(0, 0, 0.);
+    blocksoly.init(0, 0, 0.);
+    blocksolmodel.init(0, 0, 0.);
 
     QPKKTSolverObject::clear();
   }
@@ -225,12 +234,18 @@ namespace ConicBundle {
     Real Hfac,
     Real /* prec */,
     QPSolverParameters* /* params */) {
+    CH_Tools::ScopedTimer scoped_timer("QPDirectKKTSolver::QPinit_KKTsystem");
     dim = KKTdiagx.rowdim();
     assert((A == 0) || (A->rowdim() == KKTdiagy.dim()));
     assert((A == 0) || (A->coldim() == dim));
 
     int status = 0;
 
+    //solutions of previous block solves refer to the old system
+    blocksolx.init(0, 0, 0.);
+    blocksoly.init(0, 0, 0.);
+    blocksolmodel.init(0, 0, 0.);
+
     //------  prepare inverse of KKT Q if necessary
     if ((norm2(KKTdiagx) != 0)
       || ((Hp->is_DLR()) && (Diag_inv.rowdim() == 0))
@@ -297,120 +312,224 @@ namespace ConicBundle {
     }
 
 
-    //--------- build and factorize the AB or the ABC system matrix
+    //--------- build the AB or the ABC system matrix and factorize it unless an earlier factorization is reused
     if ((!status) && (Schur_complement.rowdim() > 0)) {
 
-      /// if not explicitly requested otherwise, first try to build the system for AB
-      if (!factorize_ABC) {
-
-        AQiAt_inv = Schur_complement;
+      sysmat = Schur_complement;
 
-        // add the diagonal blocks of the complementarity parts
-        if (Anr > 0) {
-          for (Integer i = 0; i < KKTdiagy.dim(); i++) {
-            AQiAt_inv(i, i) -= KKTdiagy(i);
-          }
+      // add the diagonal blocks of the complementarity parts
+      if (Anr > 0) {
+        for (Integer i = 0; i < KKTdiagy.dim(); i++) {
+          sysmat(i, i) -= KKTdiagy(i);
         }
-        if (model) {
-          status = model->add_localsys(AQiAt_inv, Anr, Anr + bsz);
-          if (status) {
-            if (cb_out()) {
-              get_out() << "**** ERROR in QPDirectKKTSolver::QPinit_KKTsystem(...): model->add_localsys(...) failed and returned " << status << std::endl;
-            }
+      }
+      if (model) {
+        status = model->add_localsys(sysmat, Anr, Anr + bsz);
+        if (status) {
+          if (cb_out()) {
+            get_out() << "**** ERROR in QPDirectKKTSolver::QPinit_KKTsystem(...): model->add_localsys(...) failed and returned " << status << std::endl;
           }
         }
+      }
 
-        LinvC.newsize(Anr + bsz, csz); chk_set_init(LinvC, 1);
-        CABinvCt_inv.newsize(csz); chk_set_init(CABinvCt_inv, 1);
-        if (csz > 0) {
-          Symmatrix tmpsym;
-          swap(AQiAt_inv, tmpsym);
-          for (Integer i = 0; i < LinvC.rowdim(); i++) {
-            for (Integer j = 0; j < LinvC.coldim(); j++) {
-              LinvC(i, j) = tmpsym(i, Anr + bsz + j);
-            }
-          }
-          AQiAt_inv.newsize(Anr + bsz); chk_set_init(AQiAt_inv, 1);
-          for (Integer i = 0; i < AQiAt_inv.rowdim(); i++) {
-            for (Integer j = i; j < AQiAt_inv.rowdim(); j++) {
-              AQiAt_inv(i, j) = -tmpsym(i, j);
-            }
-          }
-          // std::cout<<"AQiAt="<<AQiAt_inv;  //TEST output
-          status = AQiAt_inv.Chol_factor();
-          if (status) {
-            if (cb_out())
-              get_out() << "**** ERROR QPDirectKKTSolver::QPinit_KKTsystem(...): AQiAt_inv.Chol_factor(.) failed and returned " << status << std::endl;
-          } else {
-            status = AQiAt_inv.Chol_Lsolve(LinvC);
-            if (status) {
-              if (cb_out())
-                get_out() << "**** ERROR QPDirectKKTSolver::QPinit_KKTsystem(...): AQiAt_inv.Chol_Lsolve(.) failed and returned " << status << std::endl;
-              return status;
-            } else {
-              for (Integer i = 0; i < CABinvCt_inv.rowdim(); i++) {
-                for (Integer j = i; j < CABinvCt_inv.rowdim(); j++) {
-                  CABinvCt_inv(i, j) = tmpsym(Anr + bsz + i, Anr + bsz + j);
-                }
-              }
-              rankadd(LinvC, CABinvCt_inv, 1., 1., 1);
-              // std::cout<<"CABinvCt="<<CABinvCt_inv;   //TEST output
-              status = CABinvCt_inv.Chol_factor();
-              if (status) {
-                if (cb_out())
-                  get_out() << "**** ERROR QPDirectKKTSolver::QPinit_KKTsystem(...): CABinvCt_inv.Chol_factor(.) failed and returned " << status << std::endl;
-              }
-            }
-          }
+      if (!status) {
+        if (reuse_factor)
+          solve_stats.nsystems++;
+        if ((reuse_factor) && (factor_valid) && (!reuse_failed)) {
+          factor_current = false;
+          solve_stats.nreuse++;
         } else {
-          AQiAt_inv *= -1.;
-          // std::cout<<"AQiAt="<<AQiAt_inv;  //TEST output
-          status = AQiAt_inv.Chol_factor();
-          if ((status) && cb_out()) {
-            get_out() << "**** ERROR QPDirectKKTSolver::QPinit_KKTsystem(...): AQiAt_inv.Chol_factor(.) failed and returned " << status << std::endl;
+          status = factor_system();
+        }
+        //without reuse the system is only needed for the factorization
+        if (!reuse_factor)
+          sysmat.init(0, 0.);
+      }
+    }
+
+    return status;
+  }
+
+  // *************************************************************************
+  //                             factor_system
+  // *************************************************************************
+
+  int QPDirectKKTSolver::factor_system() {
+    int status = 0;
+    factor_valid = false;
+    factor_current = false;
+
+    /// if not explicitly requested otherwise, first try to factorize the system for AB
+    if (!factorize_ABC) {
+      const Integer abdim = Anr + bsz;
+
+      AQiAt_inv.newsize(abdim); chk_set_init(AQiAt_inv, 1);
+      for (Integer i = 0; i < abdim; i++) {
+        for (Integer j = i; j < abdim; j++) {
+          AQiAt_inv(i, j) = -sysmat(i, j);
+        }
+      }
+      LinvC.newsize(abdim, csz); chk_set_init(LinvC, 1);
+      CABinvCt_inv.newsize(csz); chk_set_init(CABinvCt_inv, 1);
+
+      // std::cout<<"AQiAt="<<AQiAt_inv;  //TEST output
+      status = AQiAt_inv.Chol_factor();
+      if (status) {
+        if (cb_out())
+          get_out() << "**** ERROR QPDirectKKTSolver::factor_system(): AQiAt_inv.Chol_factor(.) failed and returned " << status << std::endl;
+      } else if (csz > 0) {
+        for (Integer i = 0; i < abdim; i++) {
+          for (Integer j = 0; j < csz; j++) {
+            LinvC(i, j) = sysmat(i, abdim + j);
           }
         }
-        //if this failed try ABC
+        status = AQiAt_inv.Chol_Lsolve(LinvC);
         if (status) {
-          if (cb_out()) {
-            get_out() << "**** WARNING in QPDirectKKTSolver::QPinit_KKTsystem(...): solving AB with Cholesky failed, switching to factorize_ABC with Aasen " << std::endl;
+          if (cb_out())
+            get_out() << "**** ERROR QPDirectKKTSolver::factor_system(): AQiAt_inv.Chol_Lsolve(.) failed and returned " << status << std::endl;
+          return status;
+        }
+        for (Integer i = 0; i < csz; i++) {
+          for (Integer j = i; j < csz; j++) {
+            CABinvCt_inv(i, j) = sysmat(abdim + i, abdim + j);
           }
-          factorize_ABC = true;
-          status = 0;
         }
+        rankadd(LinvC, CABinvCt_inv, 1., 1., 1);
+        // std::cout<<"CABinvCt="<<CABinvCt_inv;   //TEST output
+        status = CABinvCt_inv.Chol_factor();
+        if (status) {
+          if (cb_out())
+            get_out() << "**** ERROR QPDirectKKTSolver::factor_system(): CABinvCt_inv.Chol_factor(.) failed and returned " << status << std::endl;
+        }
+      }
+      //if this failed try ABC
+      if (status) {
+        if (cb_out()) {
+          get_out() << "**** WARNING in QPDirectKKTSolver::factor_system(): solving AB with Cholesky failed, switching to factorize_ABC with Aasen " << std::endl;
+        }
+        factorize_ABC = true;
+        status = 0;
       }
+    }
 
+    if (factorize_ABC) {
+      if (reuse_factor)
+        AQiAt_inv = sysmat;
+      else
+        swap(AQiAt_inv, sysmat);
+      status = AQiAt_inv.Aasen_factor(piv);
+      if (status) {
+        if (cb_out())
+          get_out() << "**** ERROR QPDirectKKTSolver::factor_system(): AQiAt_inv.Aasen_factor(.) failed and returned " << status << std::endl;
+        return status;
+      }
+    }
 
-      if ((!status) && (factorize_ABC)) {
+    factor_valid = true;
+    factor_current = true;
+    return status;
+  }
 
-        AQiAt_inv = Schur_complement;
+  // *************************************************************************
+  //                             solve_factored
+  // *************************************************************************
 
-        // add the diagonal blocks of the complementarity parts
-        if (Anr > 0) {
-          for (Integer i = 0; i < KKTdiagy.dim(); i++) {
-            AQiAt_inv(i, i) -= KKTdiagy(i);
-          }
+  int QPDirectKKTSolver::solve_factored(Matrix& x) {
+    assert(x.rowdim() == Anr + bsz + csz);
+    int status = 0;
+    if (factorize_ABC) {
+      status = AQiAt_inv.Aasen_solve(x, piv);
+    } else {
+      const Integer sysdim = x.rowdim();
+      const Integer ncols = x.coldim();
+      if (csz > 0) {
+        const Integer abdim = Anr + bsz;
+        Matrix solab(abdim, ncols);
+        Matrix soltr(csz, ncols);
+        for (Integer j = 0; j < ncols; j++) {
+          mat_xey(abdim, solab.get_store() + j * abdim, x.get_store() + j * sysdim);
+          mat_xey(csz, soltr.get_store() + j * csz, x.get_store() + j * sysdim + abdim);
         }
-        if (model) {
-          status = model->add_localsys(AQiAt_inv, Anr, Anr + bsz);
-          if (status) {
-            if (cb_out()) {
-              get_out() << "**** ERROR in LowRank_QPDirectKKTSolver::QPinit_KKTsystem(...): model->add_localsys(...) failed and returned " << status << std::endl;
-            }
-          }
+        status = AQiAt_inv.Chol_Lsolve(solab);
+
+        genmult(LinvC, solab, soltr, 1., 1., 1, 0);
+        status = CABinvCt_inv.Chol_solve(soltr);
+        genmult(LinvC, soltr, solab, -1., 1.);
+        status = AQiAt_inv.Chol_Ltsolve(solab);
+
+        for (Integer j = 0; j < ncols; j++) {
+          mat_xeya(abdim, x.get_store() + j * sysdim, solab.get_store() + j * abdim, -1.);
+          mat_xey(csz, x.get_store() + j * sysdim + abdim, soltr.get_store() + j * csz);
         }
+      } else {
+        status = AQiAt_inv.Chol_solve(x);
+
+        x *= -1;
+      }
+    }
+    return status;
+  }
+
+  // *************************************************************************
+  //                             solve_system
+  // *************************************************************************
+
+  // If the factorization is not the one of sysmat, the solution obtained
+  // with it is improved by iterative refinement. In the interior point
+  // method the systems of consecutive iterations often differ little,
+  // so a few refinement steps (each one multiplication with sysmat and
+  // one solve with the factorization) are much cheaper than a new
+  // factorization. If refinement does not converge fast enough, the
+  // current system is factorized and this factorization is kept.
 
+  int QPDirectKKTSolver::solve_system(Matrix& x, Real prec) {
+    if (!reuse_factor)
+      return solve_factored(x);
+
+    CH_Tools::Microseconds start_time = stats_clock.time();
+    int status = 0;
+    if (factor_current) {
+      status = solve_factored(x);
+    } else {
+      Matrix rhs(x);
+      const Real termprec = prec * min(1., norm2(rhs));
+      status = solve_factored(x);
+      Matrix res;
+      Real oldresnorm = max_Real;
+      Integer k = 0;
+      bool converged = false;
+      while (!status) {
+        res.init(rhs);
+        genmult(sysmat, x, res, -1., 1.);
+        solve_stats.nmult++;
+        Real resnorm = norm2(res);
+        if (resnorm <= termprec) {
+          converged = true;
+          break;
+        }
+        if ((k >= reuse_maxit) || (resnorm > .5 * oldresnorm))
+          break;
+        oldresnorm = resnorm;
+        status = solve_factored(res);
+        x += res;
+        k++;
+      }
+      if (!converged) {
+        if (cb_out(2)) {
+          get_out() << " QPDirectKKTSolver::solve_system(): refinement with the earlier factorization stopped after " << k << " steps, factorizing the current system" << std::endl;
+        }
+        solve_stats.nfails++;
+        solve_stats.nreuse--;
+        reuse_failed = true;
+        status = factor_system();
         if (!status) {
-          status = AQiAt_inv.Aasen_factor(piv);
-          if (status) {
-            if (cb_out())
-              get_out() << "**** ERROR QPDirectKKTSolver::QPinit_KKTsystem(...): AQiAt_inv.Aasen_factor(.) failed and returned " << status << std::endl;
-            return status;
-          }
+          swap(x, rhs);
+          status = solve_factored(x);
         }
       }
     }
-
+    solve_stats.nsolves++;
+    solve_stats.solvetime += stats_clock.time() - start_time;
     return status;
   }
 
@@ -428,8 +547,9 @@ namespace ConicBundle {
     const Matrix& dualrhs,
     Real rhsmu,
     Real rhscorr,
-    Real /* prec */,
+    Real prec,
     QPSolverParameters* /* params */) {
+    CH_Tools::ScopedTimer scoped_timer("QPDirectKKTSolver::QPsolve_KKTsystem");
     assert(dualrhs.dim() == dim);
     assert(primalrhs.dim() == Anr);
     int status = 0;
@@ -483,27 +603,7 @@ namespace ConicBundle {
 
 
       ///-------------------       solve for the rhs 
-      if (factorize_ABC) {
-        status = AQiAt_inv.Aasen_solve(soly, piv);
-      } else {
-        if (csz > 0) {
-          Matrix soltr(csz, 1, soly.get_store() + Anr + bsz);
-          soly.reduce_length(Anr + bsz);
-          status = AQiAt_inv.Chol_Lsolve(soly);
-
-          genmult(LinvC, soly, soltr, 1., 1., 1, 0);
-          status = CABinvCt_inv.Chol_solve(soltr);
-          genmult(LinvC, soltr, soly, -1., 1.);
-          status = AQiAt_inv.Chol_Ltsolve(soly);
-
-          soly *= -1;
-          soly.concat_below(soltr);
-        } else {
-          status = AQiAt_inv.Chol_solve(soly);
-
-          soly *= -1;
-        }
-      }
+      status = solve_system(soly, prec);
 
       ///-------------------     extract the solution  
 
@@ -547,5 +647,169 @@ namespace ConicBundle {
 
 
 
+  // *************************************************************************
+  //                                apply_Qinv
+  // *************************************************************************
+
+  int QPDirectKKTSolver::apply_Qinv(Matrix& x) {
+    int status = 0;
+    if (Hp->is_DLR()) {
+      x.scale_rows(Diag_inv);
+      if (Vp) {
+        Matrix tmpmat;
+        genmult(*Vp, x, tmpmat, std::sqrt(Hfactor), 0., 1);
+        status = Qchol.Chol_solve(tmpmat);
+        Matrix tmp2;
+        genmult(*Vp, tmpmat, tmp2, std::sqrt(Hfactor));
+        tmp2.scale_rows(Diag_inv);
+        x -= tmp2;
+      }
+    } else {
+      if (Qchol.rowdim() == dim) {
+        status = Qchol.Chol_solve(x);
+      } else {
+        Matrix tmpvec;
+        for (Integer j = 0; j < x.coldim(); j++) {
+          tmpvec.init(x.rowdim(), 1, x.get_store() + j * x.rowdim());
+          Hp->apply_Hinv(tmpvec);
+          mat_xey(x.rowdim(), x.get_store() + j * x.rowdim(), tmpvec.get_store());
+        }
+      }
+    }
+    return status;
+  }
+
+  // *************************************************************************
+  //                          QPsolve_KKTsystem_block
+  // *************************************************************************
+
+  // solve the KKT System for all columns at once; this follows the steps
+  // of QPsolve_KKTsystem but applies each factorization to all columns in
+  // one sweep. The model right hand sides have to be formed column by
+  // column, the column of the step is formed last so that the model
+  // state matches the step passed on by computed_step()
+
+  int QPDirectKKTSolver::QPsolve_KKTsystem_block(Matrix& solx, Matrix& soly,
+    const Matrix& primalrhs,
+    const Matrix& dualrhs,
+    const Matrix& rhsmu,
+    const Matrix& rhscorr,
+    Integer stepcol,
+    Real prec,
+    QPSolverParameters* /* params */) {
+    const Integer ncols = dualrhs.coldim();
+    assert(dualrhs.rowdim() == dim);
+    assert((primalrhs.rowdim() == Anr) && (primalrhs.coldim() == ncols));
+    assert((rhsmu.dim() == ncols) && (rhscorr.dim() == ncols));
+    assert((0 <= stepcol) && (stepcol < ncols));
+    int status = 0;
+
+    blocksolx.init(0, 0, 0.);
+    blocksoly.init(0, 0, 0.);
+    blocksolmodel.init(0, 0, 0.);
+
+    solx.init(dualrhs);
+    soly.init(Anr, ncols, 0.);
+    status = apply_Qinv(solx);
+    //solx is the solution unless Anr+bsz+csz>0
+
+    if (Anr + bsz + csz > 0) {
+      //----------- form the right hand sides for Schur complement with the Q block
+      const Integer sysdim = Anr + bsz + csz;
+      Matrix sysrhs(sysdim, ncols, 0.);
+      Matrix tmpmat;
+      if (Anr > 0) {
+        tmpmat.init(primalrhs);
+        genmult(*A, solx, tmpmat, -1., 1.);
+        for (Integer j = 0; j < ncols; j++)
+          mat_xey(Anr, sysrhs.get_store() + j * sysdim, tmpmat.get_store() + j * Anr);
+      }
+      if (model) {
+        if (bsz > 0) {
+          tmpmat.init(bsz, ncols, 0.);
+          model->B_times(solx, tmpmat, -1., 0.);
+          for (Integer j = 0; j < ncols; j++)
+            mat_xey(bsz, sysrhs.get_store() + j * sysdim + Anr, tmpmat.get_store() + j * bsz);
+        }
+        Matrix tmpvec;
+        for (Integer k = 0; k < ncols; k++) {
+          Integer j = (k < stepcol) ? k : ((k == ncols - 1) ? stepcol : k + 1);
+          tmpvec.init(sysdim, 1, sysrhs.get_store() + j * sysdim);
+          model->add_localrhs(tmpvec, rhsmu(j), rhscorr(j), Anr, Anr + bsz, true);
+          mat_xey(sysdim, sysrhs.get_store() + j * sysdim, tmpvec.get_store());
+        }
+      }
+
+      ///-------------------       solve for the rhs 
+      status = solve_system(sysrhs, prec);
+
+      ///-------------------     extract the solution  
+
+      for (Integer j = 0; j < ncols; j++)
+        mat_xey(Anr, soly.get_store() + j * Anr, sysrhs.get_store() + j * sysdim);
+
+      solx.init(dualrhs);
+      if (model) {
+        blocksolmodel.init(bsz + csz, ncols, 0.);
+        for (Integer j = 0; j < ncols; j++)
+          mat_xey(bsz + csz, blocksolmodel.get_store() + j * (bsz + csz), sysrhs.get_store() + j * sysdim + Anr);
+        if (bsz > 0) {
+          tmpmat.init(bsz, ncols, 0.);
+          for (Integer j = 0; j < ncols; j++)
+            mat_xey(bsz, tmpmat.get_store() + j * bsz, blocksolmodel.get_store() + j * (bsz + csz));
+          model->B_times(tmpmat, solx, -1., 1., 1, 0);
+        }
+        Matrix solmodelx(bsz, 1, blocksolmodel.get_store() + stepcol * (bsz + csz));
+        Matrix solmodelconstr(csz, 1, blocksolmodel.get_store() + stepcol * (bsz + csz) + bsz);
+        model->computed_step(solmodelx, solmodelconstr);
+      }
+
+      // recover the Q block solution
+      if (Anr > 0)
+        genmult(*A, soly, solx, -1., 1., 1, 0);
+
+      int status2 = apply_Qinv(solx);
+      if (status2)
+        status = status2;
+    }
+
+    blocksolx.init(solx);
+    blocksoly.init(soly);
+
+    return status;
+  }
+
+  // *************************************************************************
+  //                          QPcombine_KKTsystem_block
+  // *************************************************************************
+
+  int QPDirectKKTSolver::QPcombine_KKTsystem_block(Matrix& solx, Matrix& soly,
+    const Matrix& coeff,
+    Real rhsmu,
+    Real rhscorr) {
+    if ((blocksolx.coldim() == 0) || (coeff.dim() != blocksolx.coldim()))
+      return 1;
+
+    genmult(blocksolx, coeff, solx);
+    if (Anr > 0)
+      genmult(blocksoly, coeff, soly);
+    else
+      soly.init(0, 1, 0.);
+
+    if ((model) && (blocksolmodel.coldim() == coeff.dim())) {
+      //bring the model into the state for this right hand side
+      Matrix tmpvec(Anr + bsz + csz, 1, 0.);
+      model->add_localrhs(tmpvec, rhsmu, rhscorr, Anr, Anr + bsz, true);
+      Matrix solmodel;
+      genmult(blocksolmodel, coeff, solmodel);
+      Matrix solmodelx(bsz, 1, solmodel.get_store());
+      Matrix solmodelconstr(csz, 1, solmodel.get_store() + bsz);
+      model->computed_step(solmodelx, solmodelconstr);
+    }
+
+    return 0;
+  }
+
+
 }
 
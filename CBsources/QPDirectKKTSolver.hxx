@@ -64,6 +64,15 @@ namespace ConicBundle {
        - if factorize_ABC==true, it uses Aasen on the indefinite remaining system
          of blocks A, B, and C.
 
+       With set_reuse_factor() the factorization of the AB or ABC system
+       of an earlier interior point iteration may be kept for later
+       systems. The systems are then solved by iterative refinement with
+       the old factorization, and the current system is only factorized
+       if the refinement does not converge fast enough. The Cholesky
+       factor of the H block is always computed anew, because the Schur
+       complement is formed with it. The number of reused systems is
+       reported in QPget_solve_stats().
+
        The most important routines of the model described in the QPModelBlockObject
        that are required here are
        (besides sizes and multiplications with the bundle matrix B)
@@ -104,9 +113,23 @@ namespace ConicBundle {
     CH_Matrix_Classes::Symmatrix CABinvCt_inv; ///< for forming partial Schur complements
     CH_Matrix_Classes::Matrix LinvC; ///< for partial Schur complement w.r.t. C block
     CH_Matrix_Classes::Indexmatrix piv; ///< pivot sequence for Aasen
+    CH_Matrix_Classes::Symmatrix sysmat; ///< the current system of ABC with Schur complement, factorized in AQiAt_inv (and CABinvCt_inv) or solved by refinement; only kept if reuse_factor is true
+    bool factor_valid; ///< true if AQiAt_inv (and CABinvCt_inv) hold the factorization of a system of the current KKT data
+    bool factor_current; ///< true if this factorization is the one of sysmat
+    bool reuse_failed; ///< true if refinement with an earlier factorization failed for the current KKT data, then all further systems are factorized
 
     //--- parameters for the solution method
     bool factorize_ABC; ///< if true, use Aasen to factor the ABC block
+    bool reuse_factor; ///< if true, the factorization of an earlier system is used for refinement, see set_reuse_factor()
+    CH_Matrix_Classes::Integer reuse_maxit; ///< maximum number of refinement steps per solve before refactorizing
+
+    QPKKT_SolveStats solve_stats; ///< counts the systems and the refinement steps if reuse_factor is true
+    CH_Tools::Clock stats_clock; ///< for taking the time of the solves
+
+    //--- solutions of the latest call to QPsolve_KKTsystem_block
+    CH_Matrix_Classes::Matrix blocksolx; ///< columns of solx
+    CH_Matrix_Classes::Matrix blocksoly; ///< columns of soly
+    CH_Matrix_Classes::Matrix blocksolmodel; ///< columns of the model and model constraint parts
 
     /// computes the Schur complement if Hp->is_DLR()==TRUE, i.e., the quadratic term is representable as diagonal plus low rank
     int compute_DLR_Schur_complement(CH_Matrix_Classes::Symmatrix& sc);
@@ -114,16 +137,48 @@ namespace ConicBundle {
     /// computes the Schur compelement if the quadratic term is only retrievable in dense form
     int compute_dense_Schur_complement(CH_Matrix_Classes::Symmatrix& sc);
 
+    /// overwrites each column of x by its product with the inverse of the (scaled) quadratic term plus KKTdiagx
+    int apply_Qinv(CH_Matrix_Classes::Matrix& x);
+
+    /// factorizes sysmat by Cholesky on the AB and C blocks or by Aasen (see factorize_ABC)
+    int factor_system();
+
+    /// overwrites each column of x by its product with the inverse of the factorized system
+    int solve_factored(CH_Matrix_Classes::Matrix& x);
+
+    /// overwrites each column of x by its product with the inverse of sysmat, refining with an earlier factorization up to precision prec if the current one is not available
+    int solve_system(CH_Matrix_Classes::Matrix& x, CH_Matrix_Classes::Real prec);
+
   public:
     /// reset data to empty
     virtual void clear();
 
     /// default constructor
     QPDirectKKTSolver(bool in_factorize_ABC = false, CBout* cb = 0, int cbinc = -1) :
-      QPKKTSolverObject(cb, cbinc), factorize_ABC(in_factorize_ABC) {
+      QPKKTSolverObject(cb, cbinc), factorize_ABC(in_factorize_ABC),
+      reuse_factor(false), reuse_maxit(5) {
       clear();
     }
 
+    /** @brief if set to true (default false), the factorization of an earlier system of the same bundle subproblem is used for solving later systems by iterative refinement
+
+        A solve stops refining once the residual norm drops below the
+        precision requested by the QP solver (as for the iterative KKT
+        solvers), and it factorizes the current system if this is not
+        achieved within @a maxit steps or the residual norm is not at
+        least halved in a step. This factorization is then used for the
+        following systems.
+    */
+    void set_reuse_factor(bool reuse, CH_Matrix_Classes::Integer maxit = 5) {
+      reuse_factor = reuse;
+      reuse_maxit = (maxit < 1) ? 1 : maxit;
+    }
+
+    /// returns true if factorizations of earlier systems may be reused, see set_reuse_factor()
+    bool get_reuse_factor() const {
+      return reuse_factor;
+    }
+
     /// virtual destructor
     virtual ~QPDirectKKTSolver();
 
@@ -152,6 +207,39 @@ namespace ConicBundle {
       CH_Matrix_Classes::Real prec,
       QPSolverParameters* params);
 
+    /// solve the KKTsystem for several right hand sides with one pass over the factorizations for all columns (see QPKKTSolverObject::QPsolve_KKTsystem_block())
+    virtual int QPsolve_KKTsystem_block(CH_Matrix_Classes::Matrix& solx,
+      CH_Matrix_Classes::Matrix& soly,
+      const CH_Matrix_Classes::Matrix& primalrhs,
+      const CH_Matrix_Classes::Matrix& dualrhs,
+      const CH_Matrix_Classes::Matrix& rhsmu,
+      const CH_Matrix_Classes::Matrix& rhscorr,
+      CH_Matrix_Classes::Integer stepcol,
+      CH_Matrix_Classes::Real prec,
+      QPSolverParameters* params);
+
+    /// combine the solutions of the latest QPsolve_KKTsystem_block() (see QPKKTSolverObject::QPcombine_KKTsystem_block())
+    virtual int QPcombine_KKTsystem_block(CH_Matrix_Classes::Matrix& solx,
+      CH_Matrix_Classes::Matrix& soly,
+      const CH_Matrix_Classes::Matrix& coeff,
+      CH_Matrix_Classes::Real rhsmu,
+      CH_Matrix_Classes::Real rhscorr);
+
+    /// the direct solver shares the factorizations among all columns
+    virtual bool QPsupports_block_solve() const {
+      return true;
+    }
+
+    /// if factorizations are reused (see set_reuse_factor()), the statistics count the systems, the reused ones and the refinement steps (as nmult), otherwise NULL
+    virtual const QPKKT_SolveStats* QPget_solve_stats() const {
+      return reuse_factor ? &solve_stats : 0;
+    }
+
+    /// reset the statistics returned by QPget_solve_stats()
+    virtual void QPclear_solve_stats() {
+      solve_stats.clear();
+    }
+
   };
 
   //@}
@@ -66,9 +66,13 @@ namespace ConicBundle {
     //---- call the solver
     assert(solver);
     Real termprec = prec * min(1., norm2(sysrhs));
+    const Real init_termprec = termprec;
     Integer ntries = 5;
     int status2;
+    Integer ncalls = 0;
+    stats_start_solve();
     do {
+      ncalls++;
       solver->set_maxit(maxit_bnd);
       status2 = solver->compute(*this, sol, termprec);
       maxit_bnd = max(maxit_bnd, 2 * solver->get_maxit());
@@ -85,6 +89,7 @@ namespace ConicBundle {
       && (solver->get_nmult() >= solver->get_maxit())
       && (--ntries > 0)
       );
+    stats_end_solve(init_termprec, ncalls - 1);
     if (status2) {
       if (cb_out()) {
         get_out() << "**** WARNING: QPIterativeKKTHASolver::QPsolve_KKTsystem(....): solver->compute failed and returned " << status2 << std::endl;
@@ -207,10 +207,14 @@ namespace ConicBundle {
       Matrix tmpvec;
       tmpvec.rand(sol.rowdim(), 1);
       tmpvec -= .5;
-      tmpvec *= (1e-6 * norm2(sol) / sol.dim());
+      tmpvec *= (1e-6 * norm2(sol) / Real(sol.dim()));
       sol += tmpvec;
     }
+    const Real init_termprec = termprec;
+    Integer ncalls = 0;
+    stats_start_solve();
     do {
+      ncalls++;
       if (recordstep >= 0) {
         xrecord.newsize(sysrhs.rowdim(), 100);
         xrecord.init(sysrhs.rowdim(), 0, 0.);
@@ -218,7 +222,7 @@ namespace ConicBundle {
       }
       solver->set_maxit(maxit_bnd);
       status2 = solver->compute(*this, sol, termprec, xsp, recordstep);
-      maxit_bnd = max(maxit_bnd, Integer(1.2 * solver->get_nmult()));
+      maxit_bnd = max(maxit_bnd, Integer(1.2 * Real(solver->get_nmult())));
 
       if (xsp) {
         xrecord.concat_right(sol);
@@ -239,6 +243,7 @@ namespace ConicBundle {
       && (solver->get_nmult() >= solver->get_maxit())
       && (--ntries > 0)
       );
+    stats_end_solve(init_termprec, ncalls - 1);
 
     if (status2) {
       if (cb_out()) {
@@ -24,6 +24,7 @@
 
 #include "QPIterativeKKTSolver.hxx"
 #include "lanczpol.hxx"
+#include "timer_registry.hxx"
 
 using namespace CH_Matrix_Classes;
 
@@ -102,6 +103,7 @@ namespace ConicBundle {
     Real Hfac,
     Real prec,
     QPSolverParameters* params) {
+    CH_Tools::ScopedTimer scoped_timer("QPIterativeKKTSolver::QPinit_KKTsystem");
     nmult = 0;
 
     Hfactor = Hfac;
@@ -137,6 +139,7 @@ namespace ConicBundle {
     Real rhscorr,
     Real prec,
     QPSolverParameters* /* params */) {
+    CH_Tools::ScopedTimer scoped_timer("QPIterativeKKTSolver::QPsolve_KKTsystem");
     maxit_bnd = max(Integer(100 * std::log(primalrhs.rowdim() + dualrhs.rowdim())), min(maxit_bnd, 2 * (primalrhs.rowdim() + dualrhs.rowdim())));
 
     //---- prepare the right hand side
@@ -158,11 +161,16 @@ namespace ConicBundle {
     //---- call the solver
     assert(solver);
     Real termprec = prec * min(1., norm2(sysrhs));
+    const Real init_termprec = termprec;
     Integer ntries = 5;
     int status2;
+    Integer ncalls = 0;
+    stats_start_solve();
     do {
+      ncalls++;
       solver->set_maxit(maxit_bnd);
       status2 = solver->compute(*this, sol, termprec);
+      CH_Tools::TimerRegistry::add_count("iterations", solver->get_nmult());
       maxit_bnd = max(maxit_bnd, 2 * solver->get_maxit());
       if ((solver->get_residual_norm() > 1.1 * solver->get_termprec()) && (solver->get_nmult() >= solver->get_maxit())) {
         if (termprec < 1e-7 * min(1., norm2(sysrhs)))
@@ -177,6 +185,7 @@ namespace ConicBundle {
       && (solver->get_nmult() >= solver->get_maxit())
       && (--ntries > 0)
       );
+    stats_end_solve(init_termprec, ncalls - 1);
 
     if (status2) {
       if (cb_out()) {
@@ -204,6 +213,38 @@ namespace ConicBundle {
     return std::abs(status1) + std::abs(status2) + std::abs(status3);
   }
 
+  // *************************************************************************
+  //                             stats_start_solve
+  // *************************************************************************
+
+  void QPIterativeKKTSolver::stats_start_solve() {
+    stats_start_nmult = nmult;
+    stats_start_precondtime = (precond ? precond->get_t_precond_mult() : CH_Tools::Microseconds(0));
+    stats_start_time = stats_clock.time();
+  }
+
+  // *************************************************************************
+  //                             stats_end_solve
+  // *************************************************************************
+
+  void QPIterativeKKTSolver::stats_end_solve(Real termprec, Integer nrestarts) {
+    assert(solver);
+    solve_stats.solvetime += stats_clock.time() - stats_start_time;
+    if (precond)
+      solve_stats.precondtime += precond->get_t_precond_mult() - stats_start_precondtime;
+    solve_stats.nsolves++;
+    solve_stats.nmult += nmult - stats_start_nmult;
+    solve_stats.nrestarts += nrestarts;
+    Real resnorm = solver->get_residual_norm();
+    if (resnorm > 1.1 * solver->get_termprec())
+      solve_stats.nfails++;
+    Real rhsnorm = norm2(sysrhs);
+    if ((rhsnorm > 0.) && (resnorm > 0.))
+      solve_stats.sum_log10_reduction += std::log10(rhsnorm / resnorm);
+    solve_stats.last_termprec = termprec;
+    solve_stats.last_resnorm = resnorm;
+  }
+
   // *************************************************************************
   //                             ItSys_mult
   // *************************************************************************
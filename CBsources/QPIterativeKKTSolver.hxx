@@ -98,13 +98,25 @@ namespace ConicBundle {
 
     CH_Matrix_Classes::Integer nmult; ///< holds number of calls to ItSys_mult, reset to 0 in QPinitKKTdata
 
+    QPKKT_SolveStats solve_stats; ///< cumulative statistics of the calls to QPsolve_KKTsystem, see QPget_solve_stats()
+    CH_Tools::Clock stats_clock; ///< for taking the time spent in the iterative solver
+    CH_Tools::Microseconds stats_start_time; ///< time at the start of the current solve
+    CH_Tools::Microseconds stats_start_precondtime; ///< preconditioner time at the start of the current solve
+    CH_Matrix_Classes::Integer stats_start_nmult; ///< value of nmult at the start of the current solve
+
+    /// to be called by QPsolve_KKTsystem() immediately before the iterative solver is invoked the first time
+    void stats_start_solve();
+
+    /// to be called by QPsolve_KKTsystem() after the iterative solver finished; termprec is the initially requested (absolute) precision, nrestarts the number of additional solver calls
+    void stats_end_solve(CH_Matrix_Classes::Real termprec, CH_Matrix_Classes::Integer nrestarts);
+
   public:
     /// reset data to empty but keep solver and preconditioner
     virtual void clear();
 
     /// default constructor
     QPIterativeKKTSolver(CH_Matrix_Classes::IterativeSolverObject* insolver, QPKKTPrecondObject* inprecond = 0, CBout* cb = 0, int cbinc = -1) :
-      CBout(cb, cbinc), QPKKTSolverObject(cb, cbinc), solver(insolver), precond(inprecond) {
+      CBout(cb, cbinc), QPKKTSolverObject(cb, cbinc), solver(insolver), precond(inprecond), stats_start_nmult(0) {
     }
 
     /// virtual destructor
@@ -170,6 +182,16 @@ namespace ConicBundle {
     virtual CH_Matrix_Classes::Integer QPget_system_size() {
       return KKTdiagx.rowdim() + KKTdiagy.rowdim() + (model ? (model->dim_model() + model->dim_constraints()) : 0);
     }
+
+    /// for evaluation purposes with iterative solvers, return the statistics collected over the calls to QPsolve_KKTsystem()
+    virtual const QPKKT_SolveStats* QPget_solve_stats() const {
+      return &solve_stats;
+    }
+
+    /// reset the statistics returned by QPget_solve_stats()
+    virtual void QPclear_solve_stats() {
+      solve_stats.clear();
+    }
   };
 
 
@@ -0,0 +1,469 @@
+/* ****************************************************************************
+
+    Copyright (C) 2026  ConicBundle contributors
+
+    ConicBundle, Version 1.a.2
+    File:  CBsources/QPKKTSolverAutoSelect.cxx
+    This file is part of ConciBundle, a C/C++ library for convex optimization.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+
+
+#include <iomanip>
+#include "QPKKTSolverAutoSelect.hxx"
+#include "QPDirectKKTSolver.hxx"
+#include "QPIterativeKKTHASolver.hxx"
+#include "QPIterativeKKTHAeqSolver.hxx"
+#include "QPKKTSubspaceHPrecond.hxx"
+#include "minres.hxx"
+
+using namespace CH_Matrix_Classes;
+using namespace CH_Tools;
+
+namespace ConicBundle {
+
+  // *****************************************************************************
+  //                              QPAutoSelector
+  // *****************************************************************************
+
+  QPAutoSelector::QPAutoSelector(CBout* cb, int cbinc) :
+    CBout(cb, cbinc) {
+    clear();
+  }
+
+  QPAutoSelector::~QPAutoSelector() {
+  }
+
+  void QPAutoSelector::clear() {
+    confname.clear();
+    ntrials = 2;
+    retry_interval = 50;
+    hysteresis = 0.85;
+    smoothing = 0.3;
+    clear_measurements();
+  }
+
+  void QPAutoSelector::clear_measurements() {
+    sizeclass.clear();
+    active = 0;
+    selected = -1;
+    nselect = 0;
+    nswitch = 0;
+    nused.assign(confname.size(), 0);
+  }
+
+  Integer QPAutoSelector::add_config(const char* name) {
+    confname.push_back(std::string(name));
+    nused.push_back(0);
+    for (std::map<std::pair<int, int>, SizeClass>::iterator it = sizeclass.begin(); it != sizeclass.end(); ++it)
+      it->second.stats.resize(confname.size());
+    return Integer(confname.size()) - 1;
+  }
+
+  std::pair<int, int> QPAutoSelector::size_key(Integer dim, Integer bundlesize) {
+    return std::pair<int, int>(log2class(dim), log2class(bundlesize + 1));
+  }
+
+  int QPAutoSelector::log2class(Integer n) {
+    int l = 0;
+    while (n > 1) {
+      n >>= 1;
+      l++;
+    }
+    return l;
+  }
+
+  Integer QPAutoSelector::choose(const SizeClass& sc, bool& retry) const {
+    const Integer nconf = get_nconfigs();
+    retry = false;
+
+    //first try each applicable configuration ntrials times
+    for (Integer i = 0; i < nconf; i++) {
+      const ConfigStats& cs = sc.stats[unsigned(i)];
+      if ((cs.applicable) && (cs.nmeas < ntrials))
+        return i;
+    }
+
+    //periodically measure the alternative used least recently
+    Integer choice = -1;
+    if ((retry_interval > 0) && (sc.nsel + 1 - sc.lastretry >= retry_interval)) {
+      retry = true;
+      for (Integer i = 0; i < nconf; i++) {
+        const ConfigStats& cs = sc.stats[unsigned(i)];
+        if ((i == sc.current) || (!cs.applicable))
+          continue;
+        if ((choice < 0) || (cs.lastuse < sc.stats[unsigned(choice)].lastuse))
+          choice = i;
+      }
+    }
+
+    return (choice < 0) ? sc.current : choice;
+  }
+
+  Integer QPAutoSelector::get_choice(Integer dim, Integer bundlesize) const {
+    if (get_nconfigs() == 0)
+      return -1;
+    std::map<std::pair<int, int>, SizeClass>::const_iterator it = sizeclass.find(size_key(dim, bundlesize));
+    if (it == sizeclass.end()) {
+      if ((active) && (active->stats[unsigned(active->current)].applicable))
+        return active->current;
+      return 0;
+    }
+    bool retry;
+    return choose(it->second, retry);
+  }
+
+  Integer QPAutoSelector::select(Integer dim, Integer bundlesize) {
+    const Integer nconf = get_nconfigs();
+    if (nconf == 0) {
+      active = 0;
+      return selected = -1;
+    }
+    std::pair<int, int> key = size_key(dim, bundlesize);
+    std::map<std::pair<int, int>, SizeClass>::iterator it = sizeclass.find(key);
+    if (it == sizeclass.end()) {
+      SizeClass sc;
+      sc.stats.resize(unsigned(nconf));
+      if ((active) && (active->stats[unsigned(active->current)].applicable))
+        sc.current = active->current;
+      it = sizeclass.insert(std::make_pair(key, sc)).first;
+      if (cb_out(2))
+        get_out() << " QPAutoSelector: new size class (dim~2^" << key.first << ", bundle~2^" << key.second << ") starts with " << confname[unsigned(sc.current)] << std::endl;
+    }
+    SizeClass& sc = it->second;
+    active = &sc;
+    bool retry;
+    Integer choice = choose(sc, retry);
+    nselect++;
+    sc.nsel++;
+    if (retry)
+      sc.lastretry = sc.nsel;
+
+    if ((choice != sc.current) && (cb_out(2)))
+      get_out() << " QPAutoSelector: trying " << confname[unsigned(choice)] << " instead of " << confname[unsigned(sc.current)] << std::endl;
+
+    nused[unsigned(choice)]++;
+    return selected = choice;
+  }
+
+  Integer QPAutoSelector::mark_inapplicable() {
+    if ((active == 0) || (selected < 0))
+      return -1;
+    SizeClass& sc = *active;
+    sc.stats[unsigned(selected)].applicable = false;
+    if (cb_out(1))
+      get_out() << " QPAutoSelector: " << confname[unsigned(selected)] << " is not applicable" << std::endl;
+    nused[unsigned(selected)]--;
+    selected = -1;
+    if (!sc.stats[unsigned(sc.current)].applicable) {
+      for (Integer i = 0; i < get_nconfigs(); i++) {
+        if (sc.stats[unsigned(i)].applicable) {
+          sc.current = i;
+          break;
+        }
+      }
+    }
+    if (sc.stats[unsigned(sc.current)].applicable) {
+      selected = sc.current;
+      nused[unsigned(selected)]++;
+    }
+    return selected;
+  }
+
+  void QPAutoSelector::record(Real seconds, Integer iterations) {
+    if ((active == 0) || (selected < 0))
+      return;
+    ConfigStats& cs = active->stats[unsigned(selected)];
+    if (cs.nmeas == 0) {
+      cs.time = seconds;
+      cs.iter = Real(iterations);
+    }
+    else {
+      cs.time += smoothing * (seconds - cs.time);
+      cs.iter += smoothing * (Real(iterations) - cs.iter);
+    }
+    cs.nmeas++;
+    cs.lastuse = active->nsel;
+    selected = -1;
+    update_choice();
+  }
+
+  void QPAutoSelector::record_failure() {
+    if ((active == 0) || (selected < 0))
+      return;
+    SizeClass& sc = *active;
+    Integer alt = -1;
+    for (Integer i = 0; i < get_nconfigs(); i++) {
+      if ((i != selected) && (sc.stats[unsigned(i)].applicable)) {
+        alt = i;
+        break;
+      }
+    }
+    if (alt >= 0) {
+      sc.stats[unsigned(selected)].applicable = false;
+      if (cb_out(1))
+        get_out() << " QPAutoSelector: " << confname[unsigned(selected)] << " failed and is excluded for this size class" << std::endl;
+      if (sc.current == selected)
+        sc.current = alt;
+    }
+    selected = -1;
+  }
+
+  bool QPAutoSelector::better(const ConfigStats& a, const ConfigStats& b) const {
+    if (a.time < hysteresis * b.time)
+      return true;
+    return (a.time <= b.time) && (a.iter < hysteresis * b.iter);
+  }
+
+  void QPAutoSelector::update_choice() {
+    SizeClass& sc = *active;
+    const Integer nconf = get_nconfigs();
+    //compare only once all applicable configurations have been tried
+    for (Integer i = 0; i < nconf; i++) {
+      const ConfigStats& cs = sc.stats[unsigned(i)];
+      if ((cs.applicable) && (cs.nmeas < ntrials))
+        return;
+    }
+    //among those that are better than the current one take the fastest
+    const ConfigStats& cur = sc.stats[unsigned(sc.current)];
+    Integer best = -1;
+    for (Integer i = 0; i < nconf; i++) {
+      const ConfigStats& cs = sc.stats[unsigned(i)];
+      if ((i == sc.current) || (!cs.applicable))
+        continue;
+      if ((cur.applicable) && (!better(cs, cur)))
+        continue;
+      if ((best < 0) || (cs.time < sc.stats[unsigned(best)].time))
+        best = i;
+    }
+    if (best < 0)
+      return;
+    const ConfigStats& bst = sc.stats[unsigned(best)];
+    if (cb_out(1)) {
+      get_out() << " QPAutoSelector: switching from " << confname[unsigned(sc.current)];
+      get_out() << " (" << cur.time << "s, " << cur.iter << " iter)";
+      get_out() << " to " << confname[unsigned(best)];
+      get_out() << " (" << bst.time << "s, " << bst.iter << " iter)" << std::endl;
+    }
+    sc.current = best;
+    nswitch++;
+  }
+
+  std::ostream& QPAutoSelector::print_statistics(std::ostream& out, int printlevel) const {
+    out << " QPAutoSelector: nselect=" << nselect << " nswitch=" << nswitch;
+    for (unsigned int i = 0; i < confname.size(); i++)
+      out << " " << confname[i] << "=" << nused[i];
+    out << "\n";
+    if (printlevel > 0) {
+      for (std::map<std::pair<int, int>, SizeClass>::const_iterator it = sizeclass.begin(); it != sizeclass.end(); ++it) {
+        const SizeClass& sc = it->second;
+        out << "  dim~2^" << it->first.first << " bundle~2^" << it->first.second;
+        out << " nsel=" << sc.nsel << " current=" << confname[unsigned(sc.current)] << "\n";
+        for (unsigned int i = 0; i < sc.stats.size(); i++) {
+          const ConfigStats& cs = sc.stats[i];
+          out << "   " << std::setw(20) << confname[i];
+          if (!cs.applicable) {
+            out << " not applicable\n";
+            continue;
+          }
+          out << " nmeas=" << cs.nmeas << " time=" << cs.time << " iter=" << cs.iter << "\n";
+        }
+      }
+    }
+    return out;
+  }
+
+
+  // *****************************************************************************
+  //                              QPKKTSolverAutoSelect
+  // *****************************************************************************
+
+  QPKKTSolverAutoSelect::QPKKTSolverAutoSelect(CBout* cb, int cbinc) :
+    QPKKTSolverObject() {
+    cursolver = 0;
+    nsystems = 0;
+    kkterror = false;
+    clear();
+    set_cbout(cb, cbinc);
+  }
+
+  QPKKTSolverAutoSelect::~QPKKTSolverAutoSelect() {
+    clear();
+    for (unsigned int i = 0; i < solver.size(); i++)
+      delete solver[i];
+  }
+
+  void QPKKTSolverAutoSelect::clear() {
+    flush_measurement();
+    QPKKTSolverObject::clear();
+    for (unsigned int i = 0; i < solver.size(); i++)
+      solver[i]->clear();
+  }
+
+  void QPKKTSolverAutoSelect::set_cbout(const CBout* cb, int incr) {
+    CBout::set_cbout(cb, incr);
+    selector.set_cbout(this, 0);
+    for (unsigned int i = 0; i < solver.size(); i++)
+      solver[i]->set_cbout(this, 0);
+  }
+
+  int QPKKTSolverAutoSelect::add_solver(QPKKTSolverObject* solverp, const char* name) {
+    if (solverp == 0)
+      return 0;
+    solverp->set_cbout(this, 0);
+    solver.push_back(solverp);
+    selector.add_config(name);
+    return 0;
+  }
+
+  int QPKKTSolverAutoSelect::add_default_solvers() {
+    int err = 0;
+    err |= add_solver(new QPDirectKKTSolver(false, this, 0), "QPDirectKKTSolver");
+    err |= add_solver(new QPIterativeKKTHASolver(new MinRes, new QPKKTSubspaceHPrecond(0, this, 0), this, 0), "QPIterativeKKTHASolver");
+    err |= add_solver(new QPIterativeKKTHAeqSolver(new MinRes, 0, this, 0), "QPIterativeKKTHAeqSolver");
+    return err;
+  }
+
+  void QPKKTSolverAutoSelect::flush_measurement() {
+    if (cursolver) {
+      if (kkterror)
+        selector.record_failure();
+      else
+        selector.record(Real(worktime), nsystems);
+    }
+    cursolver = 0;
+    worktime = 0;
+    nsystems = 0;
+    kkterror = false;
+  }
+
+  int QPKKTSolverAutoSelect::QPinit_KKTdata(QPSolverProxObject* inHp,
+    QPModelBlockObject* inmodel,
+    const Sparsemat* inA,
+    const Indexmatrix* ineq_indices
+  ) {
+    flush_measurement();
+    Hp = inHp;
+    model = inmodel;
+    A = inA;
+    eq_indices = ineq_indices;
+
+    Integer dim = 0;
+    {
+      Matrix D;
+      const Matrix* Vp;
+      Hp->get_precond(D, Vp);
+      dim = D.rowdim();
+    }
+    Microseconds start = clock.time();
+    Integer i = selector.select(dim, (inmodel ? inmodel->dim_model() : 0));
+    while (i >= 0) {
+      if (solver[unsigned(i)]->QPinit_KKTdata(Hp, model, A, eq_indices) == 0) {
+        cursolver = solver[unsigned(i)];
+        worktime = clock.time() - start;
+        return 0;
+      }
+      i = selector.mark_inapplicable();
+    }
+    if (cb_out())
+      get_out() << "**** WARNING in QPKKTSolverAutoSelect::QPinit_KKTdata(): none of the " << solver.size() << " solvers is applicable" << std::endl;
+    return 1;
+  }
+
+  int QPKKTSolverAutoSelect::QPinit_KKTsystem(const Matrix& KKTdiagx,
+    const Matrix& KKTdiagy,
+    Real Hfactor,
+    Real prec,
+    QPSolverParameters* params) {
+    if (cursolver == 0) {
+      if (cb_out())
+        get_out() << "**** ERROR in QPKKTSolverAutoSelect::QPinit_KKTsystem(): no solver initialized" << std::endl;
+      return 1;
+    }
+    Microseconds start = clock.time();
+    int err = cursolver->QPinit_KKTsystem(KKTdiagx, KKTdiagy, Hfactor, prec, params);
+    worktime += clock.time() - start;
+    nsystems++;
+    if (err)
+      kkterror = true;
+    return err;
+  }
+
+  int QPKKTSolverAutoSelect::QPsolve_KKTsystem(Matrix& solx,
+    Matrix& soly,
+    const Matrix& primalrhs,
+    const Matrix& dualrhs,
+    Real rhsmu,
+    Real rhscorr,
+    Real prec,
+    QPSolverParameters* params) {
+    if (cursolver == 0) {
+      if (cb_out())
+        get_out() << "**** ERROR in QPKKTSolverAutoSelect::QPsolve_KKTsystem(): no solver initialized" << std::endl;
+      return 1;
+    }
+    Microseconds start = clock.time();
+    int err = cursolver->QPsolve_KKTsystem(solx, soly, primalrhs, dualrhs, rhsmu, rhscorr, prec, params);
+    worktime += clock.time() - start;
+    if (err)
+      kkterror = true;
+    return err;
+  }
+
+  int QPKKTSolverAutoSelect::QPsolve_KKTsystem_block(Matrix& solx,
+    Matrix& soly,
+    const Matrix& primalrhs,
+    const Matrix& dualrhs,
+    const Matrix& rhsmu,
+    const Matrix& rhscorr,
+    Integer stepcol,
+    Real prec,
+    QPSolverParameters* params) {
+    if (cursolver == 0) {
+      if (cb_out())
+        get_out() << "**** ERROR in QPKKTSolverAutoSelect::QPsolve_KKTsystem_block(): no solver initialized" << std::endl;
+      return 1;
+    }
+    Microseconds start = clock.time();
+    int err = cursolver->QPsolve_KKTsystem_block(solx, soly, primalrhs, dualrhs, rhsmu, rhscorr, stepcol, prec, params);
+    worktime += clock.time() - start;
+    if (err)
+      kkterror = true;
+    return err;
+  }
+
+  int QPKKTSolverAutoSelect::QPcombine_KKTsystem_block(Matrix& solx,
+    Matrix& soly,
+    const Matrix& coeff,
+    Real rhsmu,
+    Real rhscorr) {
+    if (cursolver == 0)
+      return 1;
+    Microseconds start = clock.time();
+    int err = cursolver->QPcombine_KKTsystem_block(solx, soly, coeff, rhsmu, rhscorr);
+    worktime += clock.time() - start;
+    if (err)
+      kkterror = true;
+    return err;
+  }
+
+  void QPKKTSolverAutoSelect::QPclear_solve_stats() {
+    for (unsigned int i = 0; i < solver.size(); i++)
+      solver[i]->QPclear_solve_stats();
+  }
+
+}
@@ -0,0 +1,375 @@
+/* ****************************************************************************
+
+    Copyright (C) 2026  ConicBundle contributors
+
+    ConicBundle, Version 1.a.2
+    File:  CBsources/QPKKTSolverAutoSelect.hxx
+    This file is part of ConciBundle, a C/C++ library for convex optimization.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+
+#ifndef CONICBUNDLE_QPKKTSOLVERAUTOSELECT_HXX
+#define CONICBUNDLE_QPKKTSOLVERAUTOSELECT_HXX
+
+/**  @file QPKKTSolverAutoSelect.hxx
+    @brief Header declaring the classes ConicBundle::QPAutoSelector and ConicBundle::QPKKTSolverAutoSelect
+    @version 1.0
+    @date 2026-10-18
+    @author ConicBundle contributors
+*/
+
+#include <string>
+#include <map>
+#include "QPKKTSolverObject.hxx"
+
+namespace ConicBundle {
+
+
+  /** @ingroup ConstrainedQPSolver
+   */
+   //@{
+
+   /** @brief online selection of the fastest among several configurations (e.g. QP solvers or KKT solvers) based on measured times per bundle subproblem
+
+      The configurations are entered by add_config() and are referred to
+      by their index. Before each bundle subproblem select() is called
+      with the dimension of the problem and the size of the bundle, and
+      after the subproblem has been solved record() reports the time and
+      the number of interior point iterations it took.
+
+      Measurements are kept separately for size classes given by the
+      binary logarithms of dimension and bundle size (so a class covers
+      sizes up to a factor of two). Within a class each applicable
+      configuration is first tried on ntrials subproblems; afterwards the
+      current configuration is replaced by the fastest of those
+      alternatives that either take less than hysteresis times its
+      smoothed time per subproblem, or take no more time and less than
+      hysteresis times its smoothed number of interior point
+      iterations. The iteration counts vary less than the times, so
+      among configurations of similar speed the one needing fewer
+      iterations (typically the one with more accurate KKT solves) is
+      preferred. Every retry_interval subproblems the alternative
+      measured least recently is tried again so that changes in the
+      behavior are noticed. A new size class starts with the
+      configuration of the class used before.
+
+      Switches are reported with output level 1 and each selection
+      that deviates from the current configuration of the class (the
+      trials) with output level 2.
+   */
+  class QPAutoSelector : public virtual CBout {
+  private:
+    /// measurements of one configuration within a size class
+    struct ConfigStats {
+      CH_Matrix_Classes::Real time;  ///< smoothed seconds per subproblem
+      CH_Matrix_Classes::Real iter;  ///< smoothed interior point iterations per subproblem
+      CH_Matrix_Classes::Integer nmeas; ///< number of measurements
+      CH_Matrix_Classes::Integer lastuse; ///< value of the class counter at the latest measurement
+      bool applicable;  ///< false if the configuration reported that it cannot be used in this class
+
+      ConfigStats() : time(0.), iter(0.), nmeas(0), lastuse(-1), applicable(true) {
+      }
+    };
+
+    /// measurements and choice for one size class
+    struct SizeClass {
+      std::vector<ConfigStats> stats; ///< one entry per configuration
+      CH_Matrix_Classes::Integer current; ///< the configuration used if no trial is due
+      CH_Matrix_Classes::Integer nsel;  ///< number of calls to select() for this class
+      CH_Matrix_Classes::Integer lastretry; ///< value of nsel at the latest retry of an alternative
+
+      SizeClass() : current(0), nsel(0), lastretry(0) {
+      }
+    };
+
+    std::vector<std::string> confname;  ///< names of the configurations for output
+    std::map<std::pair<int, int>, SizeClass> sizeclass; ///< the size classes with measurements
+    SizeClass* active;   ///< the class of the latest call to select(), may be NULL
+    CH_Matrix_Classes::Integer selected; ///< the configuration returned by the latest call to select(), or -1
+
+    CH_Matrix_Classes::Integer ntrials; ///< number of measurements of each configuration before comparing
+    CH_Matrix_Classes::Integer retry_interval; ///< retry an alternative every this many subproblems in a class (no retries if <=0)
+    CH_Matrix_Classes::Real hysteresis; ///< switch only if the alternative takes less than this times the time (or, at no more time, the iterations) of the current
+    CH_Matrix_Classes::Real smoothing; ///< weight of a new measurement in the smoothed values
+
+    CH_Matrix_Classes::Integer nselect; ///< total number of calls to select()
+    CH_Matrix_Classes::Integer nswitch; ///< total number of switches of the current configuration of a class
+    std::vector<CH_Matrix_Classes::Integer> nused; ///< number of selections per configuration
+
+    /// returns the binary logarithm rounded down for n>=1 and 0 otherwise
+    static int log2class(CH_Matrix_Classes::Integer n);
+
+    /// returns the key of the size class of this dimension and bundle size
+    static std::pair<int, int> size_key(CH_Matrix_Classes::Integer dim,
+      CH_Matrix_Classes::Integer bundlesize);
+
+    /// returns the configuration to use next in this class; retry is set to true if this is due to the periodic retry
+    CH_Matrix_Classes::Integer choose(const SizeClass& sc, bool& retry) const;
+
+    /// true if configuration a should replace configuration b (by time or, at no more time, by iterations)
+    bool better(const ConfigStats& a, const ConfigStats& b) const;
+
+    /// updates the current configuration of the active class after a measurement
+    void update_choice();
+
+  public:
+    /// reset to no configurations and default parameters
+    void clear();
+
+    /// forget all measurements but keep the configurations and parameters
+    void clear_measurements();
+
+    /// default constructor
+    QPAutoSelector(CBout* cb = 0, int cbinc = -1);
+
+    /// virtual destructor
+    virtual ~QPAutoSelector();
+
+    /// add a further configuration and return its index; the first one is the initial choice
+    CH_Matrix_Classes::Integer add_config(const char* name);
+
+    /// the number of configurations
+    CH_Matrix_Classes::Integer get_nconfigs() const {
+      return CH_Matrix_Classes::Integer(confname.size());
+    }
+
+    /// the name of configuration i
+    const std::string& get_name(CH_Matrix_Classes::Integer i) const {
+      return confname[unsigned(i)];
+    }
+
+    /// set the number of measurements of each configuration before the choice is based on comparisons (at least 1, default 2)
+    void set_ntrials(CH_Matrix_Classes::Integer nt) {
+      ntrials = (nt < 1) ? 1 : nt;
+    }
+
+    /// every this many subproblems of a size class the alternative measured least recently is tried again (<=0 switches this off, default 50)
+    void set_retry_interval(CH_Matrix_Classes::Integer ri) {
+      retry_interval = ri;
+    }
+
+    /// the current configuration is only replaced by one whose smoothed time (or, at no more time, whose smoothed number of iterations) is less than this factor times its own (in (0,1], default 0.85)
+    void set_hysteresis(CH_Matrix_Classes::Real h) {
+      hysteresis = (h <= 0.) ? 0.85 : ((h > 1.) ? 1. : h);
+    }
+
+    /// weight of a new measurement in the exponentially smoothed times and iterations (in (0,1], default 0.3)
+    void set_smoothing(CH_Matrix_Classes::Real s) {
+      smoothing = (s <= 0.) ? 0.3 : ((s > 1.) ? 1. : s);
+    }
+
+    /// returns the configuration to be used for the next subproblem of this dimension and bundle size
+    CH_Matrix_Classes::Integer select(CH_Matrix_Classes::Integer dim,
+      CH_Matrix_Classes::Integer bundlesize);
+
+    /// returns the configuration select() would return for this dimension and bundle size without counting this as a selection (-1 if there are no configurations)
+    CH_Matrix_Classes::Integer get_choice(CH_Matrix_Classes::Integer dim,
+      CH_Matrix_Classes::Integer bundlesize) const;
+
+    /// the selected configuration turned out not to be applicable; it is excluded for this size class and the next candidate is returned (-1 if there is none)
+    CH_Matrix_Classes::Integer mark_inapplicable();
+
+    /// returns the configuration of the latest call to select() (or -1 if none)
+    CH_Matrix_Classes::Integer get_selected() const {
+      return selected;
+    }
+
+    /// enter the measurement of the subproblem solved with the selected configuration
+    void record(CH_Matrix_Classes::Real seconds,
+      CH_Matrix_Classes::Integer iterations);
+
+    /// the subproblem failed with the selected configuration; if another one is applicable, the selected one is excluded for this size class, otherwise the failure is ignored; no time is recorded in either case
+    void record_failure();
+
+    /// total number of calls to select()
+    CH_Matrix_Classes::Integer get_nselect() const {
+      return nselect;
+    }
+
+    /// total number of switches of the preferred configuration
+    CH_Matrix_Classes::Integer get_nswitch() const {
+      return nswitch;
+    }
+
+    /// output the number of selections per configuration and the measurements of each size class
+    std::ostream& print_statistics(std::ostream& out, int printlevel = 0) const;
+  };
+
+
+  /** @brief KKT solver that chooses among several KKT solvers the one that solves the bundle subproblems fastest
+
+      Use add_solver() to enter the solvers (the objects are deleted by
+      this class). At each call to QPinit_KKTdata() a QPAutoSelector
+      decides, based on the dimension of the prox term and the size of
+      the bundle, which solver is used for this subproblem; all further
+      calls are passed on to this solver. The time spent in these calls
+      and the number of calls to QPinit_KKTsystem() (i.e., of interior
+      point iterations) are recorded for the selector at the beginning
+      of the next subproblem. If the chosen solver reports that it is not
+      applicable, the next one is tried. If one of its calls returns an
+      error, the time of this subproblem is not recorded but the solver
+      is excluded for this size class via QPAutoSelector::record_failure(),
+      so a solver that fails fast cannot appear to be the fastest.
+
+      Install it via QPSolverParameters::QPset_KKTsolver(); for the
+      internal QPSolver of the LPGroundset with the solvers of
+      add_default_solvers() this is done by
+      MatrixCBSolver::set_auto_select_kktsolver().
+  */
+
+  class QPKKTSolverAutoSelect : public QPKKTSolverObject {
+  private:
+    std::vector<QPKKTSolverObject*> solver;  ///< solvers added via add_solver()
+    QPAutoSelector selector; ///< decides which solver to use
+    QPKKTSolverObject* cursolver; ///< the solver used for the current subproblem, may be NULL
+
+    CH_Tools::Clock clock; ///< for taking the time
+    CH_Tools::Microseconds worktime; ///< time spent in cursolver for the current subproblem
+    CH_Matrix_Classes::Integer nsystems; ///< number of calls to QPinit_KKTsystem() for the current subproblem
+    bool kkterror; ///< true if a call to cursolver returned an error for the current subproblem
+
+    /// passes the measurement of the current subproblem to the selector
+    void flush_measurement();
+
+  public:
+    /// reset data to empty, the solvers are kept
+    virtual void clear();
+
+    /// default constructor
+    QPKKTSolverAutoSelect(CBout* cb = 0, int cbinc = -1);
+
+    /// virtual destructor, deletes the solvers
+    virtual ~QPKKTSolverAutoSelect();
+
+    ///output settings, passed on to the selector and the solvers
+    virtual void set_cbout(const CBout* cb, int incr = -1);
+
+    /// add a solver (it will be deleted by this class); the first solver added is the initial choice
+    virtual int add_solver(QPKKTSolverObject* solver, const char* name);
+
+    /** @brief add the solvers of the library: QPDirectKKTSolver (initial
+        choice), QPIterativeKKTHASolver with MinRes and
+        QPKKTSubspaceHPrecond, and QPIterativeKKTHAeqSolver with MinRes
+
+        This is the set installed by LPGroundset::set_auto_select_KKTsolver().
+    */
+    virtual int add_default_solvers();
+
+    /// gives access to the parameters of the selection
+    QPAutoSelector& get_selector() {
+      return selector;
+    }
+
+    /// returns 1 if none of the solvers is applicable in the current data situation, otherwise the selected solver stores the data pointers and these need to stay valid throught the use of the other routines but are not deleted here
+    virtual int QPinit_KKTdata(QPSolverProxObject* Hp, ///< may not be be NULL
+      QPModelBlockObject* model, ///< may be NULL
+      const CH_Matrix_Classes::Sparsemat* A, ///< may be NULL
+      const CH_Matrix_Classes::Indexmatrix* eq_indices ///< if not NULL these rows of A correspond to equations
+    );
+
+    /// set up the primal dual KKT system for being solved for predictor and corrector rhs in QPsolve_KKTsystem
+    virtual int QPinit_KKTsystem(const CH_Matrix_Classes::Matrix& KKTdiagx,
+      const CH_Matrix_Classes::Matrix& KKTdiagy,
+      CH_Matrix_Classes::Real Hfactor,
+      CH_Matrix_Classes::Real prec,
+      QPSolverParameters* params);
+
+    /// solve the KKTsystem to precision prec for the given right hand sides that have been computed for the value rhsmu of the barrier parameter and in which a rhscorr fraction (out of [0,1] of the corrector term have been included; in iterative solvers solx and soly may be used as starting points
+    virtual int QPsolve_KKTsystem(CH_Matrix_Classes::Matrix& solx,
+      CH_Matrix_Classes::Matrix& soly,
+      const CH_Matrix_Classes::Matrix& primalrhs,
+      const CH_Matrix_Classes::Matrix& dualrhs,
+      CH_Matrix_Classes::Real rhsmu,
+      CH_Matrix_Classes::Real rhscorr,
+      CH_Matrix_Classes::Real prec,
+      QPSolverParameters* params);
+
+    /// passed on to the selected solver
+    virtual int QPsolve_KKTsystem_block(CH_Matrix_Classes::Matrix& solx,
+      CH_Matrix_Classes::Matrix& soly,
+      const CH_Matrix_Classes::Matrix& primalrhs,
+      const CH_Matrix_Classes::Matrix& dualrhs,
+      const CH_Matrix_Classes::Matrix& rhsmu,
+      const CH_Matrix_Classes::Matrix& rhscorr,
+      CH_Matrix_Classes::Integer stepcol,
+      CH_Matrix_Classes::Real prec,
+      QPSolverParameters* params);
+
+    /// passed on to the selected solver
+    virtual int QPcombine_KKTsystem_block(CH_Matrix_Classes::Matrix& solx,
+      CH_Matrix_Classes::Matrix& soly,
+      const CH_Matrix_Classes::Matrix& coeff,
+      CH_Matrix_Classes::Real rhsmu,
+      CH_Matrix_Classes::Real rhscorr);
+
+    /// passed on to the selected solver
+    virtual bool QPsupports_block_solve() const {
+      return (cursolver ? cursolver->QPsupports_block_solve() : false);
+    }
+
+    /// passed on to the selected solver
+    virtual CH_Matrix_Classes::Real QPget_blockH_norm() {
+      return (cursolver ? cursolver->QPget_blockH_norm() : blockH_norm);
+    }
+
+    /// passed on to the selected solver
+    virtual CH_Matrix_Classes::Real QPget_blockA_norm() {
+      return (cursolver ? cursolver->QPget_blockA_norm() : blockA_norm);
+    }
+
+    /// passed on to the selected solver
+    virtual CH_Matrix_Classes::Integer QPget_nmult() const {
+      return (cursolver ? cursolver->QPget_nmult() : 0);
+    }
+
+    /// passed on to the selected solver
+    virtual CH_Matrix_Classes::Real QPget_condition_number() {
+      return (cursolver ? cursolver->QPget_condition_number() : -1.);
+    }
+
+    /// passed on to the selected solver
+    virtual CH_Matrix_Classes::Integer QPget_precond_rank() {
+      return (cursolver ? cursolver->QPget_precond_rank() : -1);
+    }
+
+    /// passed on to the selected solver
+    virtual CH_Matrix_Classes::Integer QPget_system_size() {
+      return (cursolver ? cursolver->QPget_system_size() : 0);
+    }
+
+    /// passed on to the selected solver
+    virtual const QPKKT_SolveStats* QPget_solve_stats() const {
+      return (cursolver ? cursolver->QPget_solve_stats() : 0);
+    }
+
+    /// passed on to all solvers
+    virtual void QPclear_solve_stats();
+
+    /// output the statistics of the selector
+    std::ostream& print_statistics(std::ostream& out, int printlevel = 0) const {
+      return selector.print_statistics(out, printlevel);
+    }
+
+  };
+
+
+  //@}
+
+}
+
+#endif
+
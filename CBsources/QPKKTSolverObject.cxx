@@ -35,6 +35,50 @@ namespace ConicBundle {
   QPKKTSolverObject::~QPKKTSolverObject() {
   }
 
+  // *************************************************************************
+  //                         QPsolve_KKTsystem_block
+  // *************************************************************************
+
+  int QPKKTSolverObject::QPsolve_KKTsystem_block(Matrix& solx,
+    Matrix& soly,
+    const Matrix& primalrhs,
+    const Matrix& dualrhs,
+    const Matrix& rhsmu,
+    const Matrix& rhscorr,
+    Integer stepcol,
+    Real prec,
+    QPSolverParameters* params) {
+    const Integer ncols = dualrhs.coldim();
+    assert(primalrhs.coldim() == ncols);
+    assert((rhsmu.dim() == ncols) && (rhscorr.dim() == ncols));
+    assert((0 <= stepcol) && (stepcol < ncols));
+
+    solx.init(dualrhs.rowdim(), ncols, 0.);
+    soly.init(primalrhs.rowdim(), ncols, 0.);
+    int status = 0;
+    Matrix colx;
+    Matrix coly;
+    //the column of the step is solved last so that the model keeps its step
+    for (Integer k = 0; k < ncols; k++) {
+      Integer j = (k < stepcol) ? k : ((k == ncols - 1) ? stepcol : k + 1);
+      colx.init(dualrhs.rowdim(), 1, dualrhs.get_store() + j * dualrhs.rowdim());
+      coly.init(primalrhs.rowdim(), 1, primalrhs.get_store() + j * primalrhs.rowdim());
+      int err = QPsolve_KKTsystem(colx, coly,
+        Matrix(primalrhs.rowdim(), 1, primalrhs.get_store() + j * primalrhs.rowdim()),
+        Matrix(dualrhs.rowdim(), 1, dualrhs.get_store() + j * dualrhs.rowdim()),
+        rhsmu(j), rhscorr(j), prec, params);
+      if (err) {
+        if (cb_out())
+          get_out() << "**** WARNING in QPKKTSolverObject::QPsolve_KKTsystem_block(...): QPsolve_KKTsystem() failed for column " << j << " and returned " << err << std::endl;
+        status = err;
+      }
+      mat_xey(solx.rowdim(), solx.get_store() + j * solx.rowdim(), colx.get_store());
+      mat_xey(soly.rowdim(), soly.get_store() + j * soly.rowdim(), coly.get_store());
+    }
+
+    return status;
+  }
+
 
 }
 
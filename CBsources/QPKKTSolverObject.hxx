@@ -34,6 +34,7 @@
 
 #include "QPSolverObject.hxx"
 #include "QPModelBlockObject.hxx"
+#include "clock.hxx"
 
 namespace ConicBundle {
 
@@ -43,6 +44,74 @@ namespace ConicBundle {
    */
    //@{
 
+   /** @brief cumulative statistics on the calls to QPKKTSolverObject::QPsolve_KKTsystem() of iterative KKT solvers
+
+       The counters are accumulated over all solves since the last call
+       to clear() (see QPKKTSolverObject::QPclear_solve_stats()) and allow
+       to judge where the time goes and how precise the systems are
+       solved, in particular in the inexact mode of
+       QPSolverParameters::QPset_use_inexact_KKT().
+
+       The residual reduction of one solve is measured as the ratio of
+       the norm of the right hand side (the residual of the zero vector)
+       to the norm of the final residual.
+   */
+  class QPKKT_SolveStats {
+  public:
+    CH_Matrix_Classes::Integer nsolves;  ///< number of calls to QPsolve_KKTsystem
+    CH_Matrix_Classes::Integer nmult;    ///< number of system matrix vector multiplications within these calls
+    CH_Matrix_Classes::Integer nrestarts; ///< number of restarts due to reaching the iteration bound
+    CH_Matrix_Classes::Integer nfails;   ///< number of solves that ended above the requested precision
+    CH_Matrix_Classes::Real sum_log10_reduction; ///< sum over all solves of log10 of the residual reduction
+    CH_Matrix_Classes::Real last_termprec; ///< absolute termination precision requested in the latest solve
+    CH_Matrix_Classes::Real last_resnorm;  ///< residual norm achieved in the latest solve
+    CH_Tools::Microseconds solvetime;   ///< time spent in the iterative solver (including matrix multiplications and preconditioning)
+    CH_Tools::Microseconds precondtime; ///< part of solvetime spent in applying the preconditioner (if the preconditioner measures it)
+    CH_Matrix_Classes::Integer nsystems; ///< number of systems set up by QPinit_KKTsystem (only counted by solvers that may reuse factorizations)
+    CH_Matrix_Classes::Integer nreuse;   ///< number of these systems solved throughout with the factorization of an earlier system
+
+    /// constructor
+    QPKKT_SolveStats() {
+      clear();
+    }
+
+    /// reset all counters to zero
+    void clear() {
+      nsolves = nmult = nrestarts = nfails = 0;
+      nsystems = nreuse = 0;
+      sum_log10_reduction = 0.;
+      last_termprec = last_resnorm = 0.;
+      solvetime = precondtime = 0;
+    }
+
+    /// average number of matrix vector multiplications per solve
+    CH_Matrix_Classes::Real avg_nmult() const {
+      return (nsolves > 0) ? CH_Matrix_Classes::Real(nmult) / CH_Matrix_Classes::Real(nsolves) : 0.;
+    }
+
+    /// average log10 of the residual reduction per solve
+    CH_Matrix_Classes::Real avg_log10_reduction() const {
+      return (nsolves > 0) ? sum_log10_reduction / CH_Matrix_Classes::Real(nsolves) : 0.;
+    }
+
+    /// output in one line
+    friend std::ostream& operator<<(std::ostream& out, const QPKKT_SolveStats& s) {
+      out << " nsolves=" << s.nsolves;
+      out << " nmult=" << s.nmult;
+      out << " avgmult=" << s.avg_nmult();
+      out << " nrestarts=" << s.nrestarts;
+      out << " nfails=" << s.nfails;
+      out << " avgred=1e" << s.avg_log10_reduction();
+      out << " tsolve=" << s.solvetime;
+      out << " tprecond=" << s.precondtime;
+      if (s.nsystems > 0) {
+        out << " nsys=" << s.nsystems;
+        out << " nreuse=" << s.nreuse;
+      }
+      return out;
+    }
+  };
+
    /** @brief abstract class for setting up and solving the primal dual KKT System within QPSolverBasicStructures
 
        For initializing such a solver, first call QPinit_KKTdata(), whose
@@ -172,6 +241,50 @@ namespace ConicBundle {
       CH_Matrix_Classes::Real prec,
       QPSolverParameters* params) = 0;
 
+    /** @brief solve the KKTsystem to precision prec for several right hand sides at once
+
+        Column j of primalrhs and dualrhs is a right hand side that has
+        been computed for the value rhsmu(j) of the barrier parameter and
+        includes a rhscorr(j) fraction of the corrector term; the
+        solutions are returned in the corresponding columns of solx and
+        soly. Only the step of column stepcol is communicated to the
+        model. As long as the system is not changed, the step of any
+        linear combination of the columns may be installed afterwards by
+        QPcombine_KKTsystem_block() without solving again.
+
+        The default implementation calls QPsolve_KKTsystem() for each
+        column separately. Solvers that share the work among the
+        columns (e.g. the triangular sweeps over a factorization)
+        return true in QPsupports_block_solve().
+    */
+    virtual int QPsolve_KKTsystem_block(CH_Matrix_Classes::Matrix& solx,
+      CH_Matrix_Classes::Matrix& soly,
+      const CH_Matrix_Classes::Matrix& primalrhs,
+      const CH_Matrix_Classes::Matrix& dualrhs,
+      const CH_Matrix_Classes::Matrix& rhsmu,
+      const CH_Matrix_Classes::Matrix& rhscorr,
+      CH_Matrix_Classes::Integer stepcol,
+      CH_Matrix_Classes::Real prec,
+      QPSolverParameters* params);
+
+    /** @brief set solx and soly to the linear combination with coefficients coeff of the columns computed in the latest call to QPsolve_KKTsystem_block() and communicate the corresponding step to the model, whose right hand side is then the one for barrier parameter rhsmu and corrector fraction rhscorr
+
+        Returns 0 on success and 1 if this is not supported, in which
+        case the system has to be solved anew by QPsolve_KKTsystem().
+    */
+    virtual int QPcombine_KKTsystem_block(CH_Matrix_Classes::Matrix& /* solx */,
+      CH_Matrix_Classes::Matrix& /* soly */,
+      const CH_Matrix_Classes::Matrix& /* coeff */,
+      CH_Matrix_Classes::Real /* rhsmu */,
+      CH_Matrix_Classes::Real /* rhscorr */) {
+      return 1;
+    }
+
+    /// returns true if QPsolve_KKTsystem_block() solves several right hand sides at less than the cost of separate solves and supports QPcombine_KKTsystem_block()
+    virtual bool QPsupports_block_solve() const {
+      return false;
+    }
+
     /// for judging violation this returns (an estimate of) the norm of the H-row in the latest system
     virtual CH_Matrix_Classes::Real QPget_blockH_norm() {
       return blockH_norm;
@@ -201,6 +314,15 @@ namespace ConicBundle {
     virtual CH_Matrix_Classes::Integer QPget_system_size() {
       return 0;
     }
+
+    /// for evaluation purposes with iterative solvers, return the statistics collected over the calls to QPsolve_KKTsystem() (returns NULL if not supplied, e.g. for direct solvers)
+    virtual const QPKKT_SolveStats* QPget_solve_stats() const {
+      return 0;
+    }
+
+    /// reset the statistics returned by QPget_solve_stats()
+    virtual void QPclear_solve_stats() {
+    }
   };
 
 
@@ -35,6 +35,10 @@ namespace ConicBundle {
   QPKKTSubspaceHPrecond::QPKKTSubspaceHPrecond(CH_Matrix_Classes::Integer inmethod, CBout* cb, int cbinc) :
     CBout(cb, cbinc) {
     method = inmethod;
+    sketch_rank = 0;
+    sketch_reuse_tol = .5;
+    sketch_ngen = 0;
+    sketch_nreuse = 0;
   }
 
   QPKKTSubspaceHPrecond::~QPKKTSubspaceHPrecond() {
@@ -59,6 +63,9 @@ namespace ConicBundle {
 
     Hp->get_precond(diagH, Vp);
     subspace.init(0, 0, 0.);
+    sketch_prod.init(0, 0, 0.);
+    sketch_ngen = 0;
+    sketch_nreuse = 0;
     last_nmult = 0;
     max_sigma = -1.;
 
@@ -68,6 +75,103 @@ namespace ConicBundle {
   }
 
 
+  // *************************************************************************
+  //                       orthonormalize_columns
+  // *************************************************************************
+
+  // replaces M by an orthonormal basis of the range of its columns
+  static void orthonormalize_columns(Matrix& M) {
+    Matrix tmp(M);
+    Indexmatrix piv;
+    Integer r = tmp.QR_factor(piv);
+    M.init(tmp.rowdim(), r, 0.);
+    for (Integer i = 0; i < r; i++)
+      M(i, i) = 1.;
+    tmp.Q_times(M, r);
+  }
+
+  // *************************************************************************
+  //                             lowrank_times
+  // *************************************************************************
+
+  int QPKKTSubspaceHPrecond::lowrank_times(const Matrix& subsp,
+    Matrix& result,
+    const Matrix& KKTdiagy) {
+    int status = 0;
+    result.init(Diag_inv.rowdim(), subsp.coldim(), 0.);
+    Integer start_row = 0;
+    if (model) {
+      tmpmat = subsp.rows(Range(start_row, start_row + model->dim_model() - 1));
+      status += model->prepare_BCSchur_JLprecond(result, tmpmat);
+      start_row += model->dim_model();
+    }
+    if (Vp) {
+      tmpmat = subsp.rows(Range(start_row, start_row + Vp->coldim() - 1));
+      genmult(*Vp, tmpmat, result, std::sqrt(Hfactor), 1.);
+      start_row += Vp->coldim();
+    }
+    if ((A) && (SchurComplAineq) &&
+      ((eq_indices == 0) || (eq_indices->rowdim() < A->rowdim()))) {
+      tmpmat.init(A->rowdim(), subsp.coldim(), 0.);
+      Integer row = 0;
+      Integer eqnr = (eq_indices) ? eq_indices->rowdim() : 0;
+      for (Integer i = 0; i < eqnr; i++) {
+        Integer ii = (*eq_indices)(i);
+        for (; row < ii; row++) {
+          mat_xeya(tmpmat.coldim(), tmpmat.get_store() + row, tmpmat.rowdim(), subsp.get_store() + start_row + row - i, subsp.rowdim(), 1. / std::sqrt(KKTdiagy(row)));
+        }
+        row++;
+      }
+      for (; row < tmpmat.rowdim(); row++) {
+        mat_xeya(tmpmat.coldim(), tmpmat.get_store() + row, tmpmat.rowdim(), subsp.get_store() + start_row + row - eqnr, subsp.rowdim(), 1. / std::sqrt(KKTdiagy(row)));
+      }
+      genmult(*A, tmpmat, result, 1., 1., 1);
+      start_row += A->rowdim() - eqnr;
+    }
+    assert(start_row == subsp.rowdim());
+    return status;
+  }
+
+  // *************************************************************************
+  //                        lowrank_transposed_times
+  // *************************************************************************
+
+  int QPKKTSubspaceHPrecond::lowrank_transposed_times(const Matrix& glob,
+    Matrix& result,
+    const Matrix& KKTdiagy) {
+    int status = 0;
+    //the transposed result is collected in keepvecs by appending columns
+    keepvecs.init(glob.coldim(), 0, 0.);
+    if (model) {
+      tmpmat.init(glob);
+      status += model->prepare_BCSchur_JLprecond(tmpmat, keepvecs, true);
+      assert(keepvecs.coldim() == model->dim_model());
+    }
+    if (Vp) {
+      genmult(glob, *Vp, tmpmat, std::sqrt(Hfactor), 0., 1);
+      keepvecs.concat_right(tmpmat);
+    }
+    if ((A) && (SchurComplAineq) &&
+      ((eq_indices == 0) || (eq_indices->rowdim() < A->rowdim()))) {
+      Integer eqnr = (eq_indices) ? eq_indices->rowdim() : 0;
+      genmult(*A, glob, rotmat);
+      tmpmat.init(glob.coldim(), A->rowdim() - eqnr, 0.);
+      Integer eqi = 0;
+      Integer col = 0;
+      for (Integer row = 0; row < A->rowdim(); row++) {
+        if ((eqi < eqnr) && ((*eq_indices)(eqi) == row)) {
+          eqi++;
+          continue;
+        }
+        mat_xeya(tmpmat.rowdim(), tmpmat.get_store() + col * tmpmat.rowdim(), 1, rotmat.get_store() + row, rotmat.rowdim(), 1. / std::sqrt(KKTdiagy(row)));
+        col++;
+      }
+      keepvecs.concat_right(tmpmat);
+    }
+    result.init(keepvecs, 1., 1);
+    return status;
+  }
+
   // *************************************************************************
   //                               init_system
   // *************************************************************************
@@ -193,14 +297,14 @@ namespace ConicBundle {
         //method  12   ...   JL preconditioning, normal distribution N(0,1/cols)
 
         //safeguarded Dasgupta/Gupta bound version of JL 
-        Integer ncols = min(min(nrows, Diag_inv.rowdim()), min(Integer(200. * log(Real(Diag_inv.rowdim())) + .5), max(nrows / 3, 20)));
+        Integer ncols = min(min(nrows, Diag_inv.rowdim()), min(Integer(200. * log(Real(Diag_inv.rowdim())) + .5), max(nrows / 3, Integer(20))));
         //correct by experience from last iteration
-        ncols = min(min(ncols, nrows), max(3, min(3 + 2 * eigvals.rowdim(), Integer(std::sqrt(last_nmult * (last_nmult / 4. + nrows / 4.)) - (last_nmult / 2.) + .5))));
+        ncols = min(min(ncols, nrows), max(Integer(3), min(3 + 2 * eigvals.rowdim(), Integer(std::sqrt(Real(last_nmult) * (Real(last_nmult) / 4. + Real(nrows) / 4.)) - (Real(last_nmult) / 2.) + .5))));
 
 
         assert(ncols <= nrows);
 
-        if ((ncols > .9 * nrows) || (method % 10 == 0)) {
+        if ((Real(ncols) > .9 * Real(nrows)) || (method % 10 == 0)) {
           //==>  special case: full/exact precondtioning <==
           subspace.init_diag(nrows, 1.);
           if (cb_out(3)) {
@@ -212,7 +316,7 @@ namespace ConicBundle {
           case 1:
           {
             // use Johnson Lindenstrauss scaling in the version of Achlioptas 2001
-            Real scal = std::sqrt(3. / Real(max(ncols, 1)));
+            Real scal = std::sqrt(3. / Real(max(ncols, Integer(1))));
             subspace.init(nrows, ncols, 0.);
             for (Integer j = 0; j < ncols; j++) {
               for (Integer i = 0; i < nrows; i++) {
@@ -255,16 +359,16 @@ namespace ConicBundle {
         // method 21 ... randomized subspace is regenerated for every system
 
         //safeguarded Dasgupta/Gupta bound version of JL 
-        Integer ncols = min(min(nrows, Diag_inv.rowdim()), min(Integer(200. * log(Real(Diag_inv.rowdim())) + .5), max(nrows / 3, 20)));
+        Integer ncols = min(min(nrows, Diag_inv.rowdim()), min(Integer(200. * log(Real(Diag_inv.rowdim())) + .5), max(nrows / 3, Integer(20))));
 
         //correct by experience from last iteration
-        ncols = min(min(ncols, nrows), max(3, min(3 + 2 * eigvals.rowdim(), Integer(std::sqrt(last_nmult * (last_nmult / 4. + nrows / 4.)) - (last_nmult / 2.) + .5))));
+        ncols = min(min(ncols, nrows), max(Integer(3), min(3 + 2 * eigvals.rowdim(), Integer(std::sqrt(Real(last_nmult) * (Real(last_nmult) / 4. + Real(nrows) / 4.)) - (Real(last_nmult) / 2.) + .5))));
 
         assert(ncols < nrows);
 
         //------  generate random columns
         if ((subspace.coldim() == 0) || (method % 10 == 1)) {
-          if (ncols > .9 * nrows) {
+          if (Real(ncols) > .9 * Real(nrows)) {
             subspace.init_diag(nrows, 1.);
 
             if (cb_out(3)) {
@@ -281,7 +385,7 @@ namespace ConicBundle {
         } else {
           tmpmat.init(subspace);
           Integer r = tmpmat.QR_factor(pivlowrank);
-          add_cols = max(3, min(ncols, Integer(sqrt(last_nmult) / 2.)) - subspace.coldim());
+          add_cols = max(Integer(3), min(ncols, Integer(sqrt(last_nmult) / 2.)) - subspace.coldim());
           subspace.rand_normal(tmpmat.rowdim(), add_cols, 0., 1.);
           ncols = tmpmat.QR_concat_right(subspace, pivlowrank, r);
           if (cb_out(3)) {
@@ -303,7 +407,7 @@ namespace ConicBundle {
       case 3:
       {
         //======== proposed/constructed projection for low rank approximation
-        Real minval = pow(10., (method % 10) * .5);
+        Real minval = pow(10., Real(method % 10) * .5);
         if (cb_out(3)) {
           get_out() << " sing_est[" << method << "](" << minval << ";";
         }
@@ -394,6 +498,22 @@ namespace ConicBundle {
         break;
       }
 
+      case 5:
+      {
+        //======== randomized range finder of fixed rank, reused while the sketched product drifts little
+
+        // method 50 ... Gaussian test matrix
+        // method 51 ... sparse Achlioptas {-1,0,1} test matrix
+
+        // the subspace is generated or kept after the multiplication
+        // with the subspace below, because this needs the inverted diagonal
+        if (subspace.rowdim() != nrows) {
+          subspace.init(nrows, 0, 0.);
+          sketch_prod.init(0, 0, 0.);
+        }
+        break;
+      }
+
       }  //end switch subspace selection
     } //endif (nrows>0)  subspace selection
 
@@ -410,37 +530,72 @@ namespace ConicBundle {
       if (cb_out(3))
         get_out() << " project " << subspace.coldim() << "(" << subspace.rowdim() << ")";
 
-      lowrank.init(Diag_inv.rowdim(), subspace.coldim(), 0.);
-      Integer start_row = 0;
-      if (model) {
-        tmpmat = subspace.rows(Range(start_row, start_row + model->dim_model() - 1));
-        model->prepare_BCSchur_JLprecond(lowrank, tmpmat);
-        start_row += model->dim_model();
-      }
-      if (Vp) {
-        tmpmat = subspace.rows(Range(start_row, start_row + Vp->coldim() - 1));
-        genmult(*Vp, tmpmat, lowrank, std::sqrt(Hfactor), 1.);
-        start_row += Vp->coldim();
+      lowrank_times(subspace, lowrank, KKTdiagy);
+    }
+
+    if ((method / 10 == 5) && (nrows > 0)) {
+      //------ randomized range finder: decide on reuse and generate the subspace if needed
+      Integer ncols = sketch_rank;
+      if (ncols <= 0)
+        ncols = min(Integer(200. * log(Real(Diag_inv.rowdim())) + .5), max(nrows / 3, Integer(20)));
+      ncols = min(ncols, min(nrows, Diag_inv.rowdim()));
+
+      tmpvec.init(Diag_inv);
+      tmpvec.sqrt();
+
+      bool regenerate = ((subspace.coldim() == 0) ||
+        (sketch_prod.rowdim() != lowrank.rowdim()) ||
+        (sketch_prod.coldim() != lowrank.coldim()));
+      Real drift = -1.;
+      if (!regenerate) {
+        //relative drift of the sketched product W^(1/2)*F*subspace since its generation
+        tmpmat.init(lowrank);
+        tmpmat.scale_rows(tmpvec);
+        Real nrm = norm2(sketch_prod);
+        tmpmat -= sketch_prod;
+        drift = norm2(tmpmat) / max(nrm, 1e-100);
+        regenerate = (drift > sketch_reuse_tol);
       }
-      if ((A) && (SchurComplAineq) &&
-        ((eq_indices == 0) || (eq_indices->rowdim() < A->rowdim()))) {
-        tmpmat.init(A->rowdim(), subspace.coldim(), 0.);
-        Integer row = 0;
-        Integer eqnr = (eq_indices) ? eq_indices->rowdim() : 0;
-        for (Integer i = 0; i < eqnr; i++) {
-          Integer ii = (*eq_indices)(i);
-          for (; row < ii; row++) {
-            mat_xeya(tmpmat.coldim(), tmpmat.get_store() + row, tmpmat.rowdim(), subspace.get_store() + start_row + row - i, subspace.rowdim(), 1. / std::sqrt(KKTdiagy(row)));
+
+      if (regenerate) {
+        if (Real(ncols) > .9 * Real(nrows)) {
+          subspace.init_diag(nrows, 1.);
+        } else {
+          //test matrix Omega
+          if (method % 10 == 1) {
+            tmpmat.init(nrows, ncols, 0.);
+            for (Integer j = 0; j < ncols; j++) {
+              for (Integer i = 0; i < nrows; i++) {
+                Integer r = Integer(mat_randgen.unif_long(6));
+                if (r == 0)
+                  tmpmat(i, j) = -1.;
+                else if (r == 1)
+                  tmpmat(i, j) = 1.;
+              }
+            }
+          } else {
+            tmpmat.rand_normal(nrows, ncols, 0., 1.);
           }
-          row++;
+          //Q = orthonormalized W^(1/2)*F*Omega
+          lowrank_times(tmpmat, rotmat, KKTdiagy);
+          rotmat.scale_rows(tmpvec);
+          orthonormalize_columns(rotmat);
+          //subspace = orthonormalized transpose(F)*W^(1/2)*Q
+          rotmat.scale_rows(tmpvec);
+          lowrank_transposed_times(rotmat, subspace, KKTdiagy);
+          orthonormalize_columns(subspace);
         }
-        for (; row < tmpmat.rowdim(); row++) {
-          mat_xeya(tmpmat.coldim(), tmpmat.get_store() + row, tmpmat.rowdim(), subspace.get_store() + start_row + row - eqnr, subspace.rowdim(), 1. / std::sqrt(KKTdiagy(row)));
-        }
-        genmult(*A, tmpmat, lowrank, 1., 1., 1);
-        start_row += A->rowdim() - ((eq_indices == 0) ? 0 : eq_indices->rowdim());
+        lowrank_times(subspace, lowrank, KKTdiagy);
+        sketch_prod.init(lowrank);
+        sketch_prod.scale_rows(tmpvec);
+        sketch_ngen++;
+      } else {
+        sketch_nreuse++;
       }
 
+      if (cb_out(3)) {
+        get_out() << " sketch-precond " << (regenerate ? "new" : "reused") << " drift=" << drift << " ncols=" << subspace.coldim() << " (" << sketch_ngen << "," << sketch_nreuse << ")";
+      }
     }
 
     t_comp_lowrank = clock.time() - t_gen_subspace;
@@ -483,7 +638,7 @@ namespace ConicBundle {
       }
       tmpsym *= 1. / maxdiag;
       int retcode;
-      if ((retcode = tmpsym.eig(eigvecs, eigvals, false))) {
+      if ((retcode = int(tmpsym.eig(eigvecs, eigvals, false)))) {
         if (cb_out())
           get_out() << "**** ERROR: QPKKTSubspaceHPrecond::init_system(): tmpsym.eig failed for preconditioning method " << method << " and returned " << retcode << " for matrix " << tmpsym << ", which is A*A' for A=" << lowrank << std::endl;
         status++;
@@ -565,14 +720,14 @@ namespace ConicBundle {
       if (eigvals.rowdim() > 0) {
         //--- if subspace is used, update subspace   (??? check for enlargements ???)
         if (method == 20) {
-          if (subspace.coldim() > subspace.rowdim() * .9) {
+          if (Real(subspace.coldim()) > Real(subspace.rowdim()) * .9) {
             subspace.init_diag(subspace.rowdim(), 1.);
             if (cb_out(3)) {
               get_out() << " subspupd rdim=" << subspace.rowdim() << " cdim=" << subspace.coldim() << " identity";
             }
           } else {
             Real eigthresh = max(10., exp(.1 * log(max(eigvals)) + .9 * log(max(1e-12, min(eigvals)))));
-            Integer keep = min(3, eigvals.rowdim());
+            Integer keep = min(Integer(3), eigvals.rowdim());
             //Real eigthresh=exp(log(max(eigvals))/3.+log(max(1e-12,min(eigvals)))*2./3.);
             if (method == 60) {
               eigthresh = 10;
@@ -656,7 +811,7 @@ namespace ConicBundle {
       for (Integer i = 0; i < eigvals.rowdim(); i++) {
         sum += std::log(eigvals(i));
       }
-      sum /= Diag_inv.rowdim();
+      sum /= Real(Diag_inv.rowdim());
       return min(Diag_inv) * std::exp(sum);
     }
     return min(Diag_inv);
@@ -81,6 +81,18 @@ namespace ConicBundle {
           "3i" uses the minmum value 10^i for including a column.
           31 is the recommended version.
 
+       - 50 ... randomized range finder of controllable rank (see
+          set_sketch_rank()): for the low rank factor F of the Schur
+          complemented part and the inverted diagonal W the product
+          Y=W^(1/2)*F*Omega with a Gaussian Omega is orthonormalized to
+          Q and the subspace is the orthonormalized F^T*W^(1/2)*Q. It is
+          kept over several systems as long as the sketched product
+          W^(1/2)*F*subspace drifts little (see set_sketch_reuse_tol());
+          then only this product and the small eigenvalue problem are
+          recomputed for each system
+
+       - 51 ... as 50 but with a sparse Achlioptas {-1,0,1} sketch
+
        The most important routines of the model described in the
        QPModelBlockObject that are required here are (besides sizes and
        multiplications with the bundle matrix B)
@@ -126,12 +138,27 @@ namespace ConicBundle {
 
     CH_Matrix_Classes::Matrix Q; ///< [only used in testing] QR factorization of D^(-.5)*lowrank*eigvecs
 
+    CH_Matrix_Classes::Integer sketch_rank;   ///< for method 5x: number of columns of the sketch, <=0 selects it automatically
+    CH_Matrix_Classes::Real sketch_reuse_tol; ///< for method 5x: the subspace is reused while the sketched product drifted relatively by at most this
+    CH_Matrix_Classes::Matrix sketch_prod;    ///< for method 5x: the sketched product W^(1/2)*F*subspace at the time the subspace was generated
+    CH_Matrix_Classes::Integer sketch_ngen;   ///< for method 5x: number of sketch generations since init_data()
+    CH_Matrix_Classes::Integer sketch_nreuse; ///< for method 5x: number of systems reusing the previous sketch since init_data()
+
     CH_Tools::Clock clock; ///< for taking the time spent in various parts
     CH_Tools::Microseconds t_gen_subspace;  ///< time spent in generating the subspace
     CH_Tools::Microseconds t_comp_lowrank;  ///< time spent in generating the lowrank matrix by multiplying with subspace
     CH_Tools::Microseconds t_comp_svd;   ///< time spent in computing the singular value decomposition
     CH_Tools::Microseconds t_precond_mult;   ///< time spent in multiplying with the preconditioner
 
+    /// result = F*subsp for the low rank factor F of the Schur complemented part (model, Vp, inequalities of A if Schur complemented)
+    int lowrank_times(const CH_Matrix_Classes::Matrix& subsp,
+      CH_Matrix_Classes::Matrix& result,
+      const CH_Matrix_Classes::Matrix& KKTdiagy);
+
+    /// result = transpose(F)*glob for the same F as in lowrank_times()
+    int lowrank_transposed_times(const CH_Matrix_Classes::Matrix& glob,
+      CH_Matrix_Classes::Matrix& result,
+      const CH_Matrix_Classes::Matrix& KKTdiagy);
 
   public:
     // reset data to empty
@@ -165,6 +192,26 @@ namespace ConicBundle {
     //returns M2^{-1}vec; default: M2=I
     //virtual int precondM2(CH_Matrix_Classes::Matrix& /* vec */) {return 0;}
 
+    ///for method 5x set the number of columns of the randomized sketch; a value <=0 (default) chooses it automatically
+    void set_sketch_rank(CH_Matrix_Classes::Integer rank) {
+      sketch_rank = rank;
+    }
+
+    ///for method 5x the subspace is regenerated once the sketched product W^(1/2)*F*subspace differs from the one at its generation by more than this relative tolerance in Frobenius norm (>0, default .5)
+    int set_sketch_reuse_tol(CH_Matrix_Classes::Real tol) {
+      if (tol <= 0.) return 1; sketch_reuse_tol = tol; return 0;
+    }
+
+    ///for method 5x return the number of sketch generations since the last call to init_data()
+    CH_Matrix_Classes::Integer get_sketch_ngen() const {
+      return sketch_ngen;
+    }
+
+    ///for method 5x return the number of systems that reused the sketch since the last call to init_data()
+    CH_Matrix_Classes::Integer get_sketch_nreuse() const {
+      return sketch_nreuse;
+    }
+
     ///if the method admits this, let the subspace be chosen externally
     virtual int set_subspace(const CH_Matrix_Classes::Matrix& insubspace) {
       if (method / 10 == 3) subspace = insubspace; return 0;
@@ -23,6 +23,7 @@
 
 
 
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 #include <fstream>
@@ -30,6 +31,7 @@
 #include "LPGroundsetModification.hxx"
 #include "BundleIdProx.hxx"
 #include "QPDirectKKTSolver.hxx"
+#include "timer_registry.hxx"
 
 using namespace CH_Matrix_Classes;
 
@@ -39,15 +41,24 @@ namespace ConicBundle {
   //                       QPSolver::determine_indices
   // *************************************************************************
 
-  int QPSolver::determine_indices(QPProblemData& qpd) {
+  int QPSolver::determine_indices(QPProblemData& qpd, Integer n_unchanged) {
     assert(qpd.lby.dim() == qpd.dim);
     assert(qpd.uby.dim() == qpd.dim);
-    qpd.lbindex.newsize(qpd.dim, 1);
-    qpd.lbindex.init(0, 1, Integer(0));
-    qpd.ubindex.newsize(qpd.dim, 1);
-    qpd.ubindex.init(0, 1, Integer(0));
+    n_unchanged = max(Integer(0), min(n_unchanged, qpd.dim));
+    if (n_unchanged > 0) {
+      //keep the leading indices
+      const Integer* lbi = qpd.lbindex.get_store();
+      qpd.lbindex.reduce_length(Integer(std::lower_bound(lbi, lbi + qpd.lbindex.dim(), n_unchanged) - lbi));
+      const Integer* ubi = qpd.ubindex.get_store();
+      qpd.ubindex.reduce_length(Integer(std::lower_bound(ubi, ubi + qpd.ubindex.dim(), n_unchanged) - ubi));
+    } else {
+      qpd.lbindex.newsize(qpd.dim, 1);
+      qpd.lbindex.init(0, 1, Integer(0));
+      qpd.ubindex.newsize(qpd.dim, 1);
+      qpd.ubindex.init(0, 1, Integer(0));
+    }
     int err = 0;
-    for (Integer i = 0; i < qpd.dim; i++) {
+    for (Integer i = n_unchanged; i < qpd.dim; i++) {
       if (qpd.lby(i) > CB_minus_infinity)
         qpd.lbindex.concat_below(i);
       if (qpd.uby(i) < CB_plus_infinity)
@@ -141,6 +152,7 @@ namespace ConicBundle {
         }
       }
       preproc_data.A = original_data.A.cols(preproc_indices);
+      sync_lazy_rowrep(preproc_data.A);
       err = determine_indices(preproc_data);
       if ((err) && (cb_out())) {
         get_out() << "**** ERROR in QPSolver::preprocess_data(...): determine_indices failed and returned " << err << std::endl;
@@ -326,6 +338,7 @@ namespace ConicBundle {
     original_data.groundset_c.init(original_data.dim, 1, 0.);
     original_data.groundset_gamma = 0.;
     original_data.A.init(0, original_data.dim);
+    sync_lazy_rowrep(original_data.A);
     original_data.rhslb.init(0, 1, 0.);
     original_data.rhsub.init(0, 1, 0.);
     original_data.rhslbindex.init(0, 1, Integer(0));
@@ -371,6 +384,7 @@ namespace ConicBundle {
     QPSolverProxObject* inHp,
     const MinorantPointer& /* gs_aggr */,
     Indexmatrix* yfixed) {
+    CH_Tools::ScopedTimer scoped_timer("QPSolver::QPsolve");
     assert(get_model_data_ptr() != 0);
     assert(upper_bound > lower_bound);
 
@@ -538,6 +552,7 @@ namespace ConicBundle {
     Indexmatrix* yfixed,
     const MinorantPointer& delta_gs_aggr,
     const Indexmatrix& /* delta_index */) {
+    CH_Tools::ScopedTimer scoped_timer("QPSolver::QPupdate");
     assert(false); ///currently this does not work and does not make sesne, because the groundset_aggregate is fully included and cannot be added or changed from outside
 
     assert(get_model_data_ptr() != 0);
@@ -658,6 +673,7 @@ namespace ConicBundle {
   int QPSolver::QPresolve(Real lower_bound,
     Real upper_bound,
     Real relprec) {
+    CH_Tools::ScopedTimer scoped_timer("QPSolver::QPresolve");
     assert(get_model_data_ptr() != 0);
     assert(original_data.Hp);
 
@@ -730,23 +746,33 @@ namespace ConicBundle {
   // *************************************************************************
 
   bool QPSolver::QPis_feasible(const Matrix& y, Real relprec) {
+    return QPis_feasible_beyond(y, 0, relprec);
+  }
+
+  // *************************************************************************
+  //                             QPSolver::is_feasible_beyond
+  // *************************************************************************
+
+  bool QPSolver::QPis_feasible_beyond(const Matrix& y, Integer n_unchanged, Real relprec) {
     //check dimension
     if (y.dim() != original_data.dim) {
       return false;
     }
 
-    //check bounds
+    //check bounds, lbindex and ubindex are sorted increasingly
     if (original_data.lbindex.dim() > 0) {
-      for (Integer i = 0; i < original_data.lbindex.dim(); i++) {
-        Integer ind = original_data.lbindex(i);
+      const Integer* const lbind = original_data.lbindex.get_store();
+      for (Integer i = Integer(std::lower_bound(lbind, lbind + original_data.lbindex.dim(), n_unchanged) - lbind); i < original_data.lbindex.dim(); i++) {
+        Integer ind = lbind[i];
         if (y(ind) < original_data.lby(ind)) {
           return false;
         }
       }
     }
     if (original_data.ubindex.dim() > 0) {
-      for (Integer i = 0; i < original_data.ubindex.dim(); i++) {
-        Integer ind = original_data.ubindex(i);
+      const Integer* const ubind = original_data.ubindex.get_store();
+      for (Integer i = Integer(std::lower_bound(ubind, ubind + original_data.ubindex.dim(), n_unchanged) - ubind); i < original_data.ubindex.dim(); i++) {
+        Integer ind = ubind[i];
         if (y(ind) > original_data.uby(ind)) {
           return false;
         }
@@ -929,6 +955,7 @@ namespace ConicBundle {
     Real upperbound,
     Real relprec,
     Real skip_factor) {
+    CH_Tools::ScopedTimer scoped_timer("QPSolver::solve");
     assert(inHp);
     assert(original_data.dim == inc.rowdim());
     assert(1 == inc.coldim());
@@ -1058,7 +1085,9 @@ namespace ConicBundle {
       if (err)
         return err;
     }
-    int retval = determine_indices(original_data);
+    //the modification may have replaced A by an eager matrix
+    sync_lazy_rowrep(original_data.A);
+    int retval = determine_indices(original_data, mdf.unchanged_leading_vardim());
     if (retval) {
       if (cb_out())
         get_out() << "**** ERROR: QPSolver::apply_modification(): determine_indices() failed and retured" << retval << std::endl;
@@ -1066,6 +1095,22 @@ namespace ConicBundle {
     return retval;
   }
 
+  // *************************************************************************
+  //                       QPSolver::QPprint_statistics
+  // *************************************************************************
+
+  std::ostream& QPSolver::QPprint_statistics(std::ostream& out, int /* printlevel */) {
+    if (original_data.A.rowdim() == 0)
+      return out;
+    std::size_t colbytes, rowbytes;
+    original_data.A.get_memory_usage(colbytes, rowbytes);
+    out << " QPSolver constraints " << original_data.A.rowdim() << "x" << original_data.A.coldim();
+    out << " nz " << original_data.A.nonzeros();
+    out << " bytes columns " << colbytes << " rows " << rowbytes;
+    out << ((lazy_rowrep) ? " (lazy)" : "") << std::endl;
+    return out;
+  }
+
 
   // *************************************************************************
   //                       QPSolver::mfile_data
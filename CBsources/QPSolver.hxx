@@ -192,6 +192,14 @@ namespace ConicBundle {
     std::map<MinorantPointer, MinorantPointer> preproc_bundle_projection; ///< stores the transformed minorants of the bundle
 
     QPProblemData* qp_data; ///< either points to original_data or to fixing_data
+
+    bool lazy_rowrep; ///< if true (default), the constraint matrices build their row representation only on demand, see set_lazy_rowrep()
+
+    /// gives A the setting of lazy_rowrep unless it already has it (so a row representation built on demand is kept)
+    void sync_lazy_rowrep(CH_Matrix_Classes::Sparsemat& A) const {
+      if (A.get_lazy_rowrep() != lazy_rowrep)
+        A.set_lazy_rowrep(lazy_rowrep);
+    }
     //@}
 
     /** @name the solution data of the last solve in the original data space
@@ -220,8 +228,8 @@ namespace ConicBundle {
      */
      //@{
 
-     /// given lby,uby,rhslb,rhsub compute lbindex,ubindex,rhslbindex,rhsubindex
-    int determine_indices(QPProblemData& qpd);
+     /// given lby,uby,rhslb,rhsub compute lbindex,ubindex,rhslbindex,rhsubindex; the entries of lbindex,ubindex below n_unchanged are assumed to be correct already
+    int determine_indices(QPProblemData& qpd, CH_Matrix_Classes::Integer n_unchanged = 0);
 
     /// initialize preproc_data for 
     int preprocess_data(const CH_Matrix_Classes::Matrix& center_y,
@@ -321,7 +329,7 @@ namespace ConicBundle {
     /// default constructor
     QPSolver(CBout* cb = 0, int cbinc = -1) :
       CBout(cb, cbinc), QPSolverBasicStructures(0, cb) {
-      original_data.Hp = 0; preproc_data.Hp = 0; QPclear();
+      original_data.Hp = 0; preproc_data.Hp = 0; lazy_rowrep = true; QPclear();
     }
 
     ~QPSolver() {
@@ -385,9 +393,15 @@ namespace ConicBundle {
       CH_Matrix_Classes::Real& gsaggr_offset,
       CH_Matrix_Classes::Matrix& gsaggr_gradient);
 
-    /// currently it does nothing
-    std::ostream& QPprint_statistics(std::ostream& out, int /* printlevel*/ = 0) {
-      return out;
+    /// if there are constraints, it reports the memory held by the two representations of the constraint matrix
+    std::ostream& QPprint_statistics(std::ostream& out, int /* printlevel*/ = 0);
+
+    /// time for computing the coefficients and solving plus the interior point iterations, both summed over all calls
+    int QPget_accumulated_work(CH_Tools::Microseconds& time,
+      CH_Matrix_Classes::Integer& iterations) const {
+      time = QPcoeff_time + QPsolve_time;
+      iterations = QPget_sum_iter();
+      return 0;
     }
 
     /// return a new modification object on the heap that is initialized for modification of *this  
@@ -402,6 +416,11 @@ namespace ConicBundle {
     bool QPis_feasible(const CH_Matrix_Classes::Matrix& y,
       CH_Matrix_Classes::Real relprec = 1e-10);
 
+    /// check feasiblity of y, but the bounds only for the coordinates from n_unchanged on (the constraints are always checked)
+    bool QPis_feasible_beyond(const CH_Matrix_Classes::Matrix& y,
+      CH_Matrix_Classes::Integer n_unchanged,
+      CH_Matrix_Classes::Real relprec = 1e-10);
+
     /// makes y feasible if not so, see Groundset::ensure_feasibility()
     int QPensure_feasibility(CH_Matrix_Classes::Matrix& y,
       bool& ychanged,
@@ -455,6 +474,26 @@ namespace ConicBundle {
       return original_data.A;
     }
 
+    /** @brief if true (default), the constraint matrix only keeps its column representation and builds the rows only if a routine needs them, see CH_Matrix_Classes::Sparsemat::set_lazy_rowrep()
+
+        The interior point method and the default KKT solver only
+        multiply the constraint matrix with dense vectors, which is done
+        via the columns, so the row representation would just double the
+        memory. Some preconditioners of the iterative KKT solvers read
+        the rows; they are then built once and kept until the next
+        modification of the constraints.
+    */
+    void set_lazy_rowrep(bool lazy) {
+      lazy_rowrep = lazy;
+      sync_lazy_rowrep(original_data.A);
+      sync_lazy_rowrep(preproc_data.A);
+    }
+
+    /// returns true if the constraint matrix builds its row representation only on demand
+    bool get_lazy_rowrep() const {
+      return lazy_rowrep;
+    }
+
     /// returns the constraint lower bounds
     const CH_Matrix_Classes::Matrix& get_rhslb() const {
       return original_data.rhslb;
@@ -27,6 +27,7 @@
 #include <sstream>
 #include <fstream>
 #include "QPSolverBasicStructures.hxx"
+#include "timer_registry.hxx"
 
 using namespace CH_Matrix_Classes;
 
@@ -44,6 +45,7 @@ namespace ConicBundle {
     } else {
       paramsp = params;
     }
+    QPsum_iter = 0;
     QPIclear();
   }
 
@@ -62,6 +64,7 @@ namespace ConicBundle {
 
     large_predictor_cnt = 0;
     iter = 0;
+    block_predcorr = false;
 
     x.init(0, 1, 0.);
     y.init(0, 1, 0.);
@@ -595,7 +598,7 @@ namespace ConicBundle {
     //first do centering, only by linesearch 
     if (centering) {
       QPlinesearch(stepsize);
-      Real smu = (tr_xz + stepsize * (tr_xdzpdxz + stepsize * tr_dxdz)) / mudim;
+      Real smu = (tr_xz + stepsize * (tr_xdzpdxz + stepsize * tr_dxdz)) / Real(mudim);
       mu = smu;
       //mu=.5*mu+.5*smu;
       //mu=.9*mu+.1*smu;
@@ -606,9 +609,9 @@ namespace ConicBundle {
       return 0;
     }
 
-    const Real mu_xz = tr_xz / mudim;
-    const Real mu_xdzpdxz = tr_xdzpdxz / mudim;
-    const Real mu_dxdz = tr_dxdz / mudim;
+    const Real mu_xz = tr_xz / Real(mudim);
+    const Real mu_xdzpdxz = tr_xdzpdxz / Real(mudim);
+    const Real mu_dxdz = tr_dxdz / Real(mudim);
     const Real mu_at_one = mu_xz + mu_xdzpdxz + mu_dxdz;
 
     Real nrmsqr_xz = 0.;
@@ -678,10 +681,10 @@ namespace ConicBundle {
     }
 
 
-    Real omu = tr_xz / mudim;
+    Real omu = tr_xz / Real(mudim);
     assert(omu > 0);
-    Real gmu = max(eps_Real * tr_xz, (tr_xz + tr_xdzpdxz)) / mudim;
-    Real nmu = max(eps_Real * tr_xz, (tr_xz + tr_xdzpdxz + tr_dxdz)) / mudim;
+    Real gmu = max(eps_Real * tr_xz, (tr_xz + tr_xdzpdxz)) / Real(mudim);
+    Real nmu = max(eps_Real * tr_xz, (tr_xz + tr_xdzpdxz + tr_dxdz)) / Real(mudim);
 
     Real otheta = std::sqrt(nrmsqr_xz) / omu;
     last_theta = otheta;
@@ -694,11 +697,11 @@ namespace ConicBundle {
     }
 
     //form the polynomial of the squared distance to the central path minus neighborhood threshold
-    Real q0 = nrmsqr_xz - sqr(theta / mudim * tr_xz);
-    Real q1 = 2. * ip_xz_xdzpdxz - 2 * sqr(theta / mudim) * tr_xz * tr_xdzpdxz;
-    Real q2 = nrmsqr_xdzpdxz + 2. * ip_xz_dxdz - sqr(theta / mudim) * (sqr(tr_xdzpdxz) + 2 * tr_xz * tr_dxdz);
-    Real q3 = 2. * ip_dxdz_xdzpdxz - 2 * sqr(theta / mudim) * tr_xdzpdxz * tr_dxdz;
-    Real q4 = nrmsqr_dxdz - sqr(theta * tr_dxdz / mudim);
+    Real q0 = nrmsqr_xz - sqr(theta / Real(mudim) * tr_xz);
+    Real q1 = 2. * ip_xz_xdzpdxz - 2 * sqr(theta / Real(mudim)) * tr_xz * tr_xdzpdxz;
+    Real q2 = nrmsqr_xdzpdxz + 2. * ip_xz_dxdz - sqr(theta / Real(mudim)) * (sqr(tr_xdzpdxz) + 2 * tr_xz * tr_dxdz);
+    Real q3 = 2. * ip_dxdz_xdzpdxz - 2 * sqr(theta / Real(mudim)) * tr_xdzpdxz * tr_dxdz;
+    Real q4 = nrmsqr_dxdz - sqr(theta * tr_dxdz / Real(mudim));
 
     //Real maxnrmq=max(std::fabs(q0),max(std::fabs(q1),max(std::fabs(q2),max(std::fabs(q3),std::fabs(q4)))));
 
@@ -734,7 +737,7 @@ namespace ConicBundle {
 
     Real qsv = (((q4 * stepsize + q3) * stepsize + q2) * stepsize + q1) * stepsize + q0;
     Real dqsv = ((dq3 * stepsize + dq2) * stepsize + dq1) * stepsize + dq0;
-    Real smu = (tr_xz + stepsize * (tr_xdzpdxz + stepsize * tr_dxdz)) / mudim;
+    Real smu = (tr_xz + stepsize * (tr_xdzpdxz + stepsize * tr_dxdz)) / Real(mudim);
     Real sqrnrm = nrmsqr_xz + stepsize * (2 * ip_xz_xdzpdxz + stepsize * (nrmsqr_xdzpdxz + 2 * ip_xz_dxdz + stepsize * (2 * ip_dxdz_xdzpdxz + stepsize * nrmsqr_dxdz)));
     if (((smu < 0.) || (sqrnrm < 0.)) && (cb_out())) {
       get_out() << "**** WARNING in QPSolverBasicStructures::QPselect_localstep_mu(...): squared distance to central path at step computes to " << sqrnrm << " with mu =" << smu << " (both need to be positive)" << std::endl;
@@ -878,9 +881,9 @@ namespace ConicBundle {
       }
     }
 
-    const Real mu_xz = tr_xz / mudim;
-    const Real mu_xdzpdxz = tr_xdzpdxz / mudim;
-    const Real mu_dxdz = tr_dxdz / mudim;
+    const Real mu_xz = tr_xz / Real(mudim);
+    const Real mu_xdzpdxz = tr_xdzpdxz / Real(mudim);
+    const Real mu_dxdz = tr_dxdz / Real(mudim);
     const Real mu_at_one = mu_xz + mu_xdzpdxz + mu_dxdz;
 
     Real nrmsqr_xz = 0.;
@@ -950,10 +953,10 @@ namespace ConicBundle {
     }
 
 
-    Real omu = tr_xz / mudim;
+    Real omu = tr_xz / Real(mudim);
     assert(omu > 0);
-    Real gmu = max(eps_Real * tr_xz, (tr_xz + tr_xdzpdxz)) / mudim;
-    Real nmu = max(eps_Real * tr_xz, (tr_xz + tr_xdzpdxz + tr_dxdz)) / mudim;
+    Real gmu = max(eps_Real * tr_xz, (tr_xz + tr_xdzpdxz)) / Real(mudim);
+    Real nmu = max(eps_Real * tr_xz, (tr_xz + tr_xdzpdxz + tr_dxdz)) / Real(mudim);
 
     Real otheta = std::sqrt(nrmsqr_xz) / omu;
     last_theta = otheta;
@@ -966,11 +969,11 @@ namespace ConicBundle {
     }
 
     //form the polynomial of the squared distance to the central path minus neighborhood threshold
-    Real q0 = nrmsqr_xz - sqr(theta / mudim * tr_xz);
-    Real q1 = 2. * ip_xz_xdzpdxz - 2 * sqr(theta / mudim) * tr_xz * tr_xdzpdxz;
-    Real q2 = nrmsqr_xdzpdxz + 2. * ip_xz_dxdz - sqr(theta / mudim) * (sqr(tr_xdzpdxz) + 2 * tr_xz * tr_dxdz);
-    Real q3 = 2. * ip_dxdz_xdzpdxz - 2 * sqr(theta / mudim) * tr_xdzpdxz * tr_dxdz;
-    Real q4 = nrmsqr_dxdz - sqr(theta * tr_dxdz / mudim);
+    Real q0 = nrmsqr_xz - sqr(theta / Real(mudim) * tr_xz);
+    Real q1 = 2. * ip_xz_xdzpdxz - 2 * sqr(theta / Real(mudim)) * tr_xz * tr_xdzpdxz;
+    Real q2 = nrmsqr_xdzpdxz + 2. * ip_xz_dxdz - sqr(theta / Real(mudim)) * (sqr(tr_xdzpdxz) + 2 * tr_xz * tr_dxdz);
+    Real q3 = 2. * ip_dxdz_xdzpdxz - 2 * sqr(theta / Real(mudim)) * tr_xdzpdxz * tr_dxdz;
+    Real q4 = nrmsqr_dxdz - sqr(theta * tr_dxdz / Real(mudim));
 
     Real maxnrmq = max(std::fabs(q0), max(std::fabs(q1), max(std::fabs(q2), max(std::fabs(q3), std::fabs(q4)))));
 
@@ -982,7 +985,7 @@ namespace ConicBundle {
     //if centering is requested or otheta is still outside
     if ((centering) || (otheta > 1 - 1e-6)) {
       QPlinesearch(stepsize);
-      Real smu = (tr_xz + stepsize * (tr_xdzpdxz + stepsize * tr_dxdz)) / mudim;
+      Real smu = (tr_xz + stepsize * (tr_xdzpdxz + stepsize * tr_dxdz)) / Real(mudim);
       Real sqrnrm = nrmsqr_xz + stepsize * (2 * ip_xz_xdzpdxz + stepsize * (nrmsqr_xdzpdxz + 2 * ip_xz_dxdz + stepsize * (2 * ip_dxdz_xdzpdxz + stepsize * nrmsqr_dxdz)));
       next_theta = std::sqrt(sqrnrm) / smu;
       // if ((next_theta>.99)||(stepsize<0.01))
@@ -1416,7 +1419,7 @@ namespace ConicBundle {
       //std::cout<<" frs["<<lbstep<<","<<ubstep<<"]("<<qsv<<","<<dqsv<<")";
     }
 
-    Real smu = (tr_xz + stepval * (tr_xdzpdxz + stepval * tr_dxdz)) / mudim;
+    Real smu = (tr_xz + stepval * (tr_xdzpdxz + stepval * tr_dxdz)) / Real(mudim);
     Real sqrnrm = nrmsqr_xz + stepval * (2 * ip_xz_xdzpdxz + stepval * (nrmsqr_xdzpdxz + 2 * ip_xz_dxdz + stepval * (2 * ip_dxdz_xdzpdxz + stepval * nrmsqr_dxdz)));
     if (((smu < 0.) || (sqrnrm < 0.)) && (cb_out())) {
       get_out() << "**** WARNING in QPSolverBasicStructures::QPselect_step_mu(...): squared distance to central path at step computes to " << sqrnrm << " with mu =" << smu << " (both need to be positive)" << std::endl;
@@ -1454,7 +1457,7 @@ namespace ConicBundle {
         }
       }
       assert((stepval > 0.) && (stepval <= 1.));
-      smu = (tr_xz + stepval * (tr_xdzpdxz + stepval * tr_dxdz)) / mudim;
+      smu = (tr_xz + stepval * (tr_xdzpdxz + stepval * tr_dxdz)) / Real(mudim);
       sqrnrm = nrmsqr_xz + stepval * (2 * ip_xz_xdzpdxz + stepval * (nrmsqr_xdzpdxz + 2 * ip_xz_dxdz + stepval * (2 * ip_dxdz_xdzpdxz + stepval * nrmsqr_dxdz)));
     }
 
@@ -1466,10 +1469,10 @@ namespace ConicBundle {
     if ((otheta > nbh_ubnd + 1e-6) && (stepval > 1e-2) && (otheta - stheta < 0.01 * stepval * (otheta - nbh_ubnd))) {
       q0 = nrmsqr_xz - sqr(theta * omu);
       assert(q0 <= 1e-8 * omu);
-      q1 = 2. * ip_xz_xdzpdxz - 2 * sqr(theta / mudim) * tr_xz * tr_xdzpdxz;
-      q2 = nrmsqr_xdzpdxz + 2. * ip_xz_dxdz - sqr(theta / mudim) * (sqr(tr_xdzpdxz) + 2 * tr_xz * tr_dxdz);
-      q3 = 2. * ip_dxdz_xdzpdxz - 2 * sqr(theta / mudim) * tr_xdzpdxz * tr_dxdz;
-      q4 = nrmsqr_dxdz - sqr(theta * tr_dxdz / mudim);
+      q1 = 2. * ip_xz_xdzpdxz - 2 * sqr(theta / Real(mudim)) * tr_xz * tr_xdzpdxz;
+      q2 = nrmsqr_xdzpdxz + 2. * ip_xz_dxdz - sqr(theta / Real(mudim)) * (sqr(tr_xdzpdxz) + 2 * tr_xz * tr_dxdz);
+      q3 = 2. * ip_dxdz_xdzpdxz - 2 * sqr(theta / Real(mudim)) * tr_xdzpdxz * tr_dxdz;
+      q4 = nrmsqr_dxdz - sqr(theta * tr_dxdz / Real(mudim));
       if (cb_out(3)) {
         get_out() << " stheta(" << stepval << ")=" << stheta << ">" << nbh_ubnd;
         get_out() << " th-q0=" << q0 << " q1=" << q1 << " q2=" << q2 << " q3=" << q3 << " q4=" << q4 << std::endl;
@@ -1550,7 +1553,7 @@ namespace ConicBundle {
       stepval = bestx;
       qsv = bestval;
       dqsv = dq0 + stepval * (dq1 + stepval * (dq2 + stepval * dq3));
-      smu = (tr_xz + stepval * (tr_xdzpdxz + stepval * tr_dxdz)) / mudim;
+      smu = (tr_xz + stepval * (tr_xdzpdxz + stepval * tr_dxdz)) / Real(mudim);
       sqrnrm = nrmsqr_xz + stepval * (2 * ip_xz_xdzpdxz + stepval * (nrmsqr_xdzpdxz + 2 * ip_xz_dxdz + stepval * (2 * ip_dxdz_xdzpdxz + stepval * nrmsqr_dxdz)));
       if (((smu < 0.) || (sqrnrm < 0.)) && (cb_out())) {
         get_out() << "**** WARNING in QPSolverBasicStructures::QPselect_step_mu(...): squared distance to central path at step computes to " << sqrnrm << " with mu =" << smu << " (both need to be positive)" << std::endl;
@@ -1689,8 +1692,8 @@ namespace ConicBundle {
 
     Real thresholdmu = min(mu, last_mu);
 
-    Real omu = tr_xz / mudim;
-    Real nmu = (tr_xz + stepsize * (tr_xdzpdxz + stepsize * tr_dxdz)) / mudim;
+    Real omu = tr_xz / Real(mudim);
+    Real nmu = (tr_xz + stepsize * (tr_xdzpdxz + stepsize * tr_dxdz)) / Real(mudim);
 
     if (paramsp->QPget_use_predictor_corrector())
       mu = omu;
@@ -1938,8 +1941,53 @@ namespace ConicBundle {
     //Matrix solx;
     //Matrix soly;
 
+    //--- if the KKT solver handles several right hand sides at little
+    //    extra cost and the previous corrector was a pure centering step,
+    //    solve the predictor together with the centering right hand side
+    //    for mu=block_mu; if the corrector again turns out to be a pure
+    //    centering step (no_dxdz), it is the linear combination of the two
+    //    columns and needs no further solve
+    const bool use_block = (use_predcorr) && (block_predcorr) &&
+      (!paramsp->QPget_use_socqp()) &&
+      (paramsp->QPget_KKTsolver()->QPsupports_block_solve());
+    const Real block_mu = (next_mu > 0.) ? next_mu : 1.;
+
+    int solve_status = 0;
     //std::cout<<" pc="<<use_predcorr<<" mu="<<(use_predcorr?0.:next_mu)<<std::endl;
-    if (paramsp->QPget_KKTsolver()->QPsolve_KKTsystem(solx, soly, primal_rhs, dual_rhs, use_predcorr ? 0. : next_mu, 0., prec, paramsp)) {
+    if (use_block) {
+      const Integer xdim = dual_rhs.rowdim();
+      const Integer ydim = primal_rhs.rowdim();
+      Matrix block_dualrhs(xdim, 2);
+      mat_xey(xdim, block_dualrhs.get_store(), dual_rhs.get_store());
+      mat_xey(xdim, block_dualrhs.get_store() + xdim, dual_rhs.get_store());
+      Matrix block_primalrhs(ydim, 2);
+      mat_xey(ydim, block_primalrhs.get_store(), primal_rhs.get_store());
+      mat_xey(ydim, block_primalrhs.get_store() + ydim, primal_rhs.get_store());
+      for (Integer i = 0; i < slacklb.dim(); i++) {
+        block_dualrhs(QPget_lbind()(i), 1) += block_mu / slacklb(i);
+      }
+      for (Integer i = 0; i < slackub.dim(); i++) {
+        block_dualrhs(QPget_ubind()(i), 1) -= block_mu / slackub(i);
+      }
+      for (Integer i = 0; i < rhsslacklb.dim(); i++) {
+        Integer ind = QPget_rhsubind()(i);
+        block_primalrhs(ind, 1) -= block_mu / rhsslacklb(i) * KKTdiagy(ind);
+      }
+      for (Integer i = 0; i < rhsslackub.dim(); i++) {
+        Integer ind = QPget_rhslbind()(i);
+        block_primalrhs(ind, 1) += block_mu / rhsslackub(i) * KKTdiagy(ind);
+      }
+      Matrix block_mus(2, 1, 0.);
+      block_mus(1) = block_mu;
+      Matrix blocksolx;
+      Matrix blocksoly;
+      solve_status = paramsp->QPget_KKTsolver()->QPsolve_KKTsystem_block(blocksolx, blocksoly, block_primalrhs, block_dualrhs, block_mus, Matrix(2, 1, 0.), 0, prec, paramsp);
+      solx.init(xdim, 1, blocksolx.get_store());
+      soly.init(ydim, 1, blocksoly.get_store());
+    } else {
+      solve_status = paramsp->QPget_KKTsolver()->QPsolve_KKTsystem(solx, soly, primal_rhs, dual_rhs, use_predcorr ? 0. : next_mu, 0., prec, paramsp);
+    }
+    if (solve_status) {
       if (cb_out(1)) {
         get_out() << "*** WARNING: QPSolverBasicStructures::QPpredcorr_step(): QPsolve_system() failed for predictor" << std::endl;
       }
@@ -2113,6 +2161,7 @@ namespace ConicBundle {
       }
 
       QPlinesearch_time += clock.time() - time_linesearch;
+      block_predcorr = no_dxdz;
 
 
       if (cb_out(3)) {
@@ -2166,9 +2215,19 @@ namespace ConicBundle {
         assert(dummy == Hfactor);
       }
 
+      //a pure centering corrector combines the predictor and the centering column
+      bool combined = false;
+      if ((use_block) && (no_dxdz)) {
+        Matrix coeff(2, 1);
+        coeff(1) = next_mu / block_mu;
+        coeff(0) = 1. - coeff(1);
+        combined = (paramsp->QPget_KKTsolver()->QPcombine_KKTsystem_block(solx, soly, coeff, next_mu, 0.) == 0);
+      }
+
       //keep old solution as starting point
       //std::cout<<" dxdz="<<(no_dxdz?0.:1.)<<" mu="<<next_mu<<std::endl;
-      if (paramsp->QPget_KKTsolver()->QPsolve_KKTsystem(solx, soly, primal_rhs, dual_rhs, next_mu, no_dxdz ? 0. : 1., prec, paramsp)) {
+      if ((!combined) &&
+        (paramsp->QPget_KKTsolver()->QPsolve_KKTsystem(solx, soly, primal_rhs, dual_rhs, next_mu, no_dxdz ? 0. : 1., prec, paramsp))) {
         if (cb_out(1)) {
           get_out() << "*** WARNING: QPSolverBasicStructures::QPpredcorr_step(): QPsolve_system() failed for corrector" << std::endl;
         }
@@ -2368,6 +2427,24 @@ namespace ConicBundle {
   }
 
 
+  // *************************************************************************
+  //                            inexact_prec
+  // *************************************************************************
+
+  // forcing sequence for the inexact interior point mode
+
+  Real QPSolverBasicStructures::QPinexact_prec(Real exact_prec) const {
+    if (!paramsp->QPget_use_inexact_KKT())
+      return exact_prec;
+    Real eta_min = paramsp->QPget_inexact_eta_min();
+    Real eta_max = paramsp->QPget_inexact_eta_max();
+    Real nbh_ubnd = paramsp->QPget_nbh_ub();
+    //without neighborhood information treat the point as badly centered
+    Real theta = (next_theta < 0.) ? nbh_ubnd : next_theta;
+    Real eta = eta_max - (eta_max - eta_min) * min(1., theta / nbh_ubnd);
+    return max(exact_prec, min(1e-2, eta * mu));
+  }
+
   // *************************************************************************
   //                            iterate
   // *************************************************************************
@@ -2444,6 +2521,8 @@ namespace ConicBundle {
     do {
 
       iter++;
+      QPsum_iter++;
+      CH_Tools::TimerRegistry::add_count("iterations");
 
       old_x = x;
       old_y = y;
@@ -2455,7 +2534,7 @@ namespace ConicBundle {
       old_mu = mu;
 
       //prec=min(1e-6,min(0.01*max(n2dualviol,n2primalviol),min(0.5*prec,1e-3*mu)));
-      prec = min(1e-6, 1e-3 * mu);
+      prec = QPinexact_prec(min(1e-6, 1e-3 * mu));
 
       last_mu = mu;
       status = QPpredcorr_step(alpha, prec, mu,
@@ -2565,6 +2644,10 @@ namespace ConicBundle {
           get_out() << " tps=" << QPprecsolve_time;
           get_out() << " tmm=" << QPmatmult_time;
           get_out() << std::endl;
+          if (paramsp->QPget_KKTsolver()->QPget_solve_stats()) {
+            get_out() << "    KKT:" << *(paramsp->QPget_KKTsolver()->QPget_solve_stats());
+            get_out() << " prec=" << prec << std::endl;
+          }
         }
 
         // get_out()<<"    iter="<<iter;
@@ -2670,6 +2753,8 @@ namespace ConicBundle {
       ) {
 
       iter++;
+      QPsum_iter++;
+      CH_Tools::TimerRegistry::add_count("iterations");
 
       old_x = x;
       old_y = y;
@@ -2710,7 +2795,7 @@ namespace ConicBundle {
         //prec=max(eps_Real*mu,min(1e-6,min(0.01*max(n2dualviol,n2primalviol),min(0.5*prec,1e-3*mu))));
         prec = max(eps_Real * mu, min(1e-6, min(max(1e-8, 0.01 * max(n2dualviol, n2primalviol)), min(0.9 * prec, 1e-3 * mu))));
       } else {
-        prec = min(1e-2 * mu, 1e-6);
+        prec = QPinexact_prec(min(1e-2 * mu, 1e-6));
       }
 
       bool use_predcorr = (next_theta <= paramsp->QPget_nbh_lb()) && (paramsp->QPget_use_predictor_corrector());
@@ -2869,6 +2954,10 @@ namespace ConicBundle {
           get_out() << " tps=" << QPprecsolve_time;
           get_out() << " tmm=" << QPmatmult_time;
           get_out() << std::endl;
+          if (paramsp->QPget_KKTsolver()->QPget_solve_stats()) {
+            get_out() << "    KKT:" << *(paramsp->QPget_KKTsolver()->QPget_solve_stats());
+            get_out() << " prec=" << prec << std::endl;
+          }
         }
 
         // get_out()<<"    iter="<<iter;
@@ -3047,6 +3136,7 @@ namespace ConicBundle {
     last_theta = -1.;
     next_theta = -1.;
     large_predictor_cnt = 0;
+    block_predcorr = false;
 
 
     //----  initialize primal and dual starting point if necessary
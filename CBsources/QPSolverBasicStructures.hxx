@@ -396,6 +396,7 @@ namespace ConicBundle {
     CH_Matrix_Classes::Matrix old_rhszlb;     ///< old dual variables to the lower bounds on the constraints
     CH_Matrix_Classes::Matrix old_rhszub;     ///< old dual variables to the upper bounds on the constraints
     CH_Matrix_Classes::Real old_mu; ///< old barrier parameter
+    bool block_predcorr; ///< if true, the latest corrector was a pure centering step and the next predictor is solved together with the centering right hand side
 
 
 
@@ -435,6 +436,9 @@ namespace ConicBundle {
       bool centering                    ///< if true, go for a feasible centered point for the current (or maybe even larger) mu 
     );
 
+    /// in the inexact mode of QPSolverParameters::QPset_use_inexact_KKT() return the KKT precision by the forcing sequence eta_k*mu, otherwise (or if looser) exact_prec
+    CH_Matrix_Classes::Real QPinexact_prec(CH_Matrix_Classes::Real exact_prec) const;
+
     /// call QPpredcorr_step repeatedly until termination
     int QPiterate();
 
@@ -454,6 +458,7 @@ namespace ConicBundle {
     mutable CH_Tools::Microseconds QPprecsolve_time; ///< time spent in preconditioning solves
     mutable CH_Tools::Microseconds QPmatmult_time; ///< time spent in matrix vector multiplications
     mutable CH_Tools::Microseconds QP_time; ///< time spent in preparing the preconditioner
+    CH_Matrix_Classes::Integer QPsum_iter; ///< interior point iterations summed over all calls to QPiterate()
 
   public:
     /// default constructor
@@ -589,6 +594,11 @@ namespace ConicBundle {
     virtual CH_Matrix_Classes::Integer QPget_iter() const {
       return iter;
     }
+
+    /// return the number of iterations summed over all calls
+    CH_Matrix_Classes::Integer QPget_sum_iter() const {
+      return QPsum_iter;
+    }
   };
 
 
@@ -34,6 +34,7 @@
 
 
 #include "QPModelDataObject.hxx"
+#include "clock.hxx"
 
 namespace ConicBundle {
 
@@ -250,6 +251,13 @@ namespace ConicBundle {
     virtual bool QPis_feasible(const CH_Matrix_Classes::Matrix& y,
       CH_Matrix_Classes::Real relprec = 1e-10) = 0;
 
+    /// like QPis_feasible(), but the bounds of the first n_unchanged coordinates of y are known to hold (e.g. after a modification that only appended or deleted variables), so only those of the remaining coordinates need checking; by default all of y is checked
+    virtual bool QPis_feasible_beyond(const CH_Matrix_Classes::Matrix& y,
+      CH_Matrix_Classes::Integer /* n_unchanged */,
+      CH_Matrix_Classes::Real relprec = 1e-10) {
+      return QPis_feasible(y, relprec);
+    }
+
     /// makes y feasible if it is not feasible for the groundset of the QP, see Groundset::ensure_feasibility()
     virtual int QPensure_feasibility(CH_Matrix_Classes::Matrix& y,
       bool& ychanged,
@@ -271,6 +279,12 @@ namespace ConicBundle {
     /// allows to output some implementation dependent statistics on run time behaviour
     virtual std::ostream& QPprint_statistics(std::ostream& out, int printlevel = 0) = 0;
 
+    /// if supported (returns 0), time and interior point iterations summed over all calls that solved a QP; the differences between two calls allow to compare solvers on the same problems (see LPGroundset::set_auto_select_qpsolver())
+    virtual int QPget_accumulated_work(CH_Tools::Microseconds& /* time */,
+      CH_Matrix_Classes::Integer& /* iterations */) const {
+      return 1;
+    }
+
   };
 
 
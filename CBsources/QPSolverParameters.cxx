@@ -55,6 +55,9 @@ namespace ConicBundle {
     nbh_ub = .9;
     nbh_lb = .6;
     use_socqp = false;
+    use_inexact_KKT = false;
+    inexact_eta_min = 1e-3;
+    inexact_eta_max = 0.1;
   }
 
 
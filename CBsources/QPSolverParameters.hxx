@@ -73,6 +73,10 @@ namespace ConicBundle {
 
     bool use_socqp; ///< default false, set to true if the quadratic part should be modelled via a second order cone
 
+    bool use_inexact_KKT; ///< default false, set to true if iterative KKT solvers should only be asked for the precision of the forcing sequence, see QPset_use_inexact_KKT()
+    CH_Matrix_Classes::Real inexact_eta_min; ///< lower bound on the forcing term in the inexact mode, used for badly centered points
+    CH_Matrix_Classes::Real inexact_eta_max; ///< upper bound on the forcing term in the inexact mode, used for well centered points
+
     /// blocked copy constructor 
     QPSolverParameters(const QPSolverParameters& /*params*/);
 
@@ -147,6 +151,18 @@ namespace ConicBundle {
     bool QPget_use_socqp() const {
       return use_socqp;
     }
+    /// get this variable value
+    bool QPget_use_inexact_KKT() const {
+      return use_inexact_KKT;
+    }
+    /// get this variable value
+    CH_Matrix_Classes::Real QPget_inexact_eta_min() const {
+      return inexact_eta_min;
+    }
+    /// get this variable value
+    CH_Matrix_Classes::Real QPget_inexact_eta_max() const {
+      return inexact_eta_max;
+    }
 
 
     /// set this variable value
@@ -209,6 +225,33 @@ namespace ConicBundle {
       use_socqp = s; return 0;
     }
 
+    /** @brief if set to true (default: false), the interior point method only asks for inexact solutions of the KKT systems
+
+        In each interior point iteration k with barrier parameter mu_k
+        the KKT system is then solved to the (relative) residual
+        precision eta_k*mu_k (but never looser than 1e-2 and never
+        tighter than in the exact mode) with forcing term
+
+        eta_k = eta_max - (eta_max-eta_min)*min(1,theta_k/nbh_ub),
+
+        where theta_k is the current neighborhood value of the
+        central path (see QPset_nbh_bounds()). Thus well centered
+        points allow loose solves in early iterations while points
+        close to the boundary of the neighborhood get tight solves.
+        Whenever the step size collapses, the exact rule is used as a
+        safeguard. Only iterative KKT solvers profit from this, direct
+        solvers ignore the precision.
+    */
+    int QPset_use_inexact_KKT(bool inexact) {
+      use_inexact_KKT = inexact; return 0;
+    }
+
+    /// set the bounds on the forcing term for the inexact mode (see QPset_use_inexact_KKT()); ensures 0<=eta_min<=eta_max<1; default 0.001 and 0.1
+    int QPset_inexact_eta_bounds(CH_Matrix_Classes::Real eta_min, CH_Matrix_Classes::Real eta_max) {
+      if ((eta_min < 0.) || (eta_max >= 1.) || (eta_min > eta_max)) return 1;
+      inexact_eta_min = eta_min; inexact_eta_max = eta_max; return 0;
+    }
+
     /// set to true/false if switching to the unconstrained solver is allowed or not
     int QPset_allow_UQPSolver(bool allow) {
       allow_unconstrained = allow; return 0;
@@ -250,7 +250,7 @@ namespace ConicBundle {
       }
       //orthogonalize once more
       bundlevecs.QR_factor();
-      tmpmat.init(bundlevecs.rowdim(), min(bundlevecs.coldim(), max(2, max_columns)), 0.);
+      tmpmat.init(bundlevecs.rowdim(), min(bundlevecs.coldim(), max(Integer(2), max_columns)), 0.);
       for (Integer i = 0; i < tmpmat.coldim(); i++)
         tmpmat(i, i) = 1.;
       bundlevecs.Q_times(tmpmat, bundlevecs.coldim());
@@ -288,7 +288,7 @@ namespace ConicBundle {
   }
 
   void SOCIPBlock::clear(Integer dim) {
-    vecdim = max(dim, 0);
+    vecdim = max(dim, Integer(0));
     x.init(vecdim, 1, 0.);
     z.init(vecdim, 1, 0.);
 
@@ -459,9 +459,9 @@ namespace ConicBundle {
     assert(SOCIPBlocktestsoc(x) > eps_Real);
     assert(SOCIPBlocktestsoc(z) > eps_Real);
 
-    const Real mu_xz = tr_xz / inmudim;
-    const Real mu_xdzpdxz = tr_xdzpdxz / inmudim;
-    const Real mu_dxdz = tr_dxdz / inmudim;
+    const Real mu_xz = tr_xz / Real(inmudim);
+    const Real mu_xdzpdxz = tr_xdzpdxz / Real(inmudim);
+    const Real mu_dxdz = tr_dxdz / Real(inmudim);
 
     tmpvec.init(dx);
     apply_F(tmpvec);
@@ -27,6 +27,7 @@
 #include "SOCModel.hxx"
 #include "BundleIdProx.hxx"
 #include "SOCModelParameters.hxx"
+#include "timer_registry.hxx"
 
 using namespace CH_Tools;
 using namespace CH_Matrix_Classes;
@@ -72,6 +73,9 @@ namespace ConicBundle {
     nr_eval = 0;
     delete block;
     block = 0;
+    block_eval.set_function(0);
+    block_eval_id = -1;
+    block_eval_mid = -1;
   }
 
   // *****************************************************************************
@@ -96,6 +100,21 @@ namespace ConicBundle {
     delete block;
   }
 
+  // *****************************************************************************
+  //                            get_aft_block_evaluator
+  // *****************************************************************************
+
+  AFTBlockEvaluator* SOCModel::get_aft_block_evaluator(Integer y_id) {
+    block_eval_id = -1;
+    SOCSupportFunction* socfun = dynamic_cast<SOCSupportFunction*>(oracle);
+    if (socfun == 0)
+      return 0;
+    block_eval.set_function(socfun);
+    block_eval_id = y_id;
+    block_eval_mid = data.get_modification_id();
+    return &block_eval;
+  }
+
   // *****************************************************************************
   //                            evaluate_oracle
   // *****************************************************************************
@@ -105,6 +124,7 @@ namespace ConicBundle {
     const Matrix& y,
     Real nullstep_bound,
     Real relprec) {
+    CH_Tools::ScopedTimer scoped_timer("SOCModel::evaluate_oracle");
     assert(relprec > 0.);
 
     CH_Tools::Microseconds start_eval = clock.time();
@@ -130,8 +150,14 @@ namespace ConicBundle {
     preeval_time += clock.time() - start_eval;
     start_eval = clock.time();
 
-    ret_code = oracle->evaluate(y, SOCval_relprec, data.cand_SOCval,
-      data.cand_SOCvec, pep);
+    //the oracle may already have been evaluated while the AFT computed y
+    if ((block_eval_id == y_id) && (block_eval_mid == data.get_modification_id()) &&
+      (block_eval.get_result(y, data.cand_SOCval, data.cand_SOCvec) == 0))
+      ret_code = 0;
+    else
+      ret_code = oracle->evaluate(y, SOCval_relprec, data.cand_SOCval,
+        data.cand_SOCvec, pep);
+    block_eval_id = -1;
     eval_time += clock.time() - start_eval;
     start_eval = clock.time();
 
@@ -176,7 +202,7 @@ namespace ConicBundle {
     data.cand_ub_mid = data.get_modification_id();
 
     //update old SOCvecs 
-    data.SOCvecs_max = max(data.SOCvecs_max, model_selection->get_max_bundle_size());
+    data.SOCvecs_max = max(data.SOCvecs_max, Integer(model_selection->get_max_bundle_size()));
     if (data.store_SOCvec(data.cand_SOCvec)) {
       if (cb_out())
         get_out() << "**** WARNING SOCModel::eval_function(): data.store_SOCvec() failed" << std::endl;
@@ -411,13 +437,15 @@ namespace ConicBundle {
     if (needed_indexsubset == 0) {
       //assert(tmpmat.rowdim()==cand_y.rowdim());
       for (Integer i = 0; i < xdim; i++) {
-        bundle[cnt++].init(new Minorant(true, tmpvec(i), tmpmat.rowdim(), tmpmat.get_store() + i * tmpmat.rowdim()), data.get_modification_id());
+        bundle[cnt++].init(new Minorant(true, tmpvec(i), int(tmpmat.rowdim()), tmpmat.get_store() + i * tmpmat.rowdim()), data.get_modification_id());
       }
     } else {
       Integer dim = needed_indexsubset->dim();
+      std::vector<int> int_ind;
+      const int* indp = int_store(*needed_indexsubset, int_ind);
       assert(tmpmat.rowdim() == dim);
       for (Integer i = 0; i < xdim; i++) {
-        bundle[cnt++].init(new Minorant(true, tmpvec(i), dim, tmpmat.get_store() + i * dim, needed_indexsubset->get_store()), data.get_modification_id());
+        bundle[cnt++].init(new Minorant(true, tmpvec(i), int(dim), tmpmat.get_store() + i * dim, indp), data.get_modification_id());
       }
     }
     assert(Integer(cnt) == xdim);
@@ -488,7 +516,7 @@ namespace ConicBundle {
       // generate data.primalvec
       data.primalvec.newsize(data.bundlevecs.rowdim() + 1, 1); chk_set_init(data.primalvec, 1);
       data.primalvec(0) = tmpvec(0);
-      tmpvec.delete_rows(Indexmatrix(1, 1, 0), true);
+      tmpvec.delete_rows(Indexmatrix(1, 1, Integer(0)), true);
       Matrix tmpv;
       genmult(data.bundlevecs, tmpvec, tmpv);
       mat_xey(tmpv.rowdim(), data.primalvec.get_store() + 1, tmpv.get_store());
@@ -651,7 +679,7 @@ namespace ConicBundle {
       retval = model_selection->init(bp);
     }
     if (model_selection->get_max_bundle_size() >= 2) {
-      data.SOCvecs_max = max(data.SOCvecs_max, model_selection->get_max_bundle_size());
+      data.SOCvecs_max = max(data.SOCvecs_max, Integer(model_selection->get_max_bundle_size()));
     }
     return retval;
   }
@@ -36,6 +36,7 @@
 #include "ConeModel.hxx"
 #include "SOCData.hxx"
 #include "SOCModelParametersObject.hxx"
+#include "SOCSupportFunction.hxx"
 
 namespace ConicBundle {
 
@@ -82,6 +83,14 @@ namespace ConicBundle {
     /// total number of oralce calls (to  MatrixFunctionOracle::evaluate())
     CH_Matrix_Classes::Integer nr_eval;
 
+    //--- evaluation of a SOCSupportFunction together with its AFT, see get_aft_block_evaluator()
+    /// evaluates the oracle blockwise while the AFT computes its argument
+    SOCSupportBlockEvaluator block_eval;
+    /// the point identifier the blocks are evaluated for (-1 if none)
+    CH_Matrix_Classes::Integer block_eval_id;
+    /// the modification id of data when the blocks were requested
+    CH_Matrix_Classes::Integer block_eval_mid;
+
     //--- augmented modle solver
     /// describes the feasible convex combinations of the bundle vectors for the bundle subproblem
     QPConeModelDataObject* block;
@@ -220,6 +229,9 @@ namespace ConicBundle {
       return oracle;
     }
 
+    /// see SumBlockModel::get_aft_block_evaluator(); only a SOCSupportFunction is evaluated blockwise
+    AFTBlockEvaluator* get_aft_block_evaluator(CH_Matrix_Classes::Integer y_id);
+
     //start_augmodel   //as in ConeModel
 
     // make_model_aggregate         //as in ConeModel
@@ -61,7 +61,7 @@ namespace ConicBundle {
     assert((SOCvecs.coldim() == 0) || (cand_SOCvec.rowdim() == SOCvecs.rowdim() + 1));
 
     Integer SOCdim = cand_SOCvec.rowdim();
-    Integer max_columns = max_model_size > 2 ? max_model_size - 1 : max(2, SOCdim - 1);
+    Integer max_columns = max_model_size > 2 ? max_model_size - 1 : max(Integer(2), SOCdim - 1);
 
     Matrix tmpvec;
     modelvecs.init(0, 0, 0.);
@@ -125,7 +125,7 @@ namespace ConicBundle {
       }
       //orthogonalize once more
       modelvecs.QR_factor();
-      tmpmat.init(modelvecs.rowdim(), min(modelvecs.coldim(), max(2, max_columns)), 0.);
+      tmpmat.init(modelvecs.rowdim(), min(modelvecs.coldim(), max(Integer(2), max_columns)), 0.);
       for (Integer i = 0; i < tmpmat.coldim(); i++)
         tmpmat(i, i) = 1.;
       modelvecs.Q_times(tmpmat, modelvecs.coldim());
@@ -68,7 +68,7 @@ namespace ConicBundle {
 
   Minorant* SOCSupportFunction::generate_minorant(const Matrix& SOCvec) {
     assert(socdim == SOCvec.dim());
-    return new Minorant(true, 0., SOCvec.dim(), SOCvec.get_store());
+    return new Minorant(true, 0., int(SOCvec.dim()), SOCvec.get_store());
   }
 
   int SOCSupportFunction::extract_SOCvector(Matrix& vec, const Minorant* mnrt) {
@@ -219,6 +219,50 @@ namespace ConicBundle {
     return 0;
   }
 
+  //*****************************************************************************
+  //                            SOCSupportBlockEvaluator
+  //*****************************************************************************
+
+  int SOCSupportBlockEvaluator::start_blocks(Integer dim, Integer n_blocks) {
+    argument = 0;
+    if ((fun == 0) || (dim != fun->get_socdim()) || (dim < 1))
+      return 1;
+    xval.newsize(dim, 1); chk_set_init(xval, 1);
+    blocksq.init(n_blocks, 1, 0.);
+    blockdone.init(n_blocks, 1, Integer(0));
+    return 0;
+  }
+
+  void SOCSupportBlockEvaluator::evaluate_block(Integer block, Integer begin, Integer end, const Real* y) {
+    Real* xp = xval.get_store() + begin;
+    Real sq = 0.;
+    for (Integer i = begin; i < end; i++) {
+      Real d = *y++;
+      *xp++ = d;
+      if (i > 0)
+        sq += d * d;
+    }
+    blocksq(block) = sq;
+    blockdone(block) = 1;
+    if (block == 0)
+      argument = y - end;
+  }
+
+  int SOCSupportBlockEvaluator::get_result(const Matrix& y, Real& val, Matrix& x) {
+    if ((argument == 0) || (argument != y.get_store()) || (y.dim() != xval.dim()) || (min(blockdone) == 0)) {
+      argument = 0;
+      return 1;
+    }
+    argument = 0;
+    Real n2 = std::sqrt(sum(blocksq));
+    val = xval(0) + n2;
+    if (n2 > 1e-10)
+      xval /= n2;
+    xval(0) = 1.;
+    swap(x, xval);
+    return 0;
+  }
+
   int SOCSupportFunction::apply_modification(const SOCSupportModification& mod) {
     int err = 0;
 
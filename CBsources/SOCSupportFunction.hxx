@@ -27,7 +27,7 @@
 #define CONICBUNDLE_SOCSUPPORTFUNCTION_HXX
 
 /**  @file SOCSupportFunction.hxx
-    @brief Header declaring the classes ConicBundle::SOCSupportFunction, ConicBundle::AMFMinorantExtender (part of an implementation of ConicBundle::FunctionModel)
+    @brief Header declaring the classes ConicBundle::SOCSupportFunction, ConicBundle::SOCSupportMinorantExtender, ConicBundle::SOCSupportBlockEvaluator (part of an implementation of ConicBundle::FunctionModel)
     @version 1.0
     @date 2017-09-30
     @author Christoph Helmberg
@@ -38,6 +38,7 @@
 #include <map>
 #include "SOCSupportModification.hxx"
 #include "SOCOracle.hxx"
+#include "AffineFunctionTransformation.hxx"
 
 //------------------------------------------------------------
 
@@ -293,6 +294,49 @@ namespace ConicBundle {
 
   };
 
+  /**@brief evaluates a SOCSupportFunction blockwise while an AffineFunctionTransformation computes its argument (see AFTBlockEvaluator); used by SOCModel
+
+     The blocks copy the argument into the maximizer and sum the squares
+     of its coordinates 1,...,socdim-1. get_result() combines these sums
+     in the order of the blocks and scales the maximizer, so only this
+     last step needs another pass over the coordinates.
+   */
+
+  class SOCSupportBlockEvaluator : public AFTBlockEvaluator {
+  private:
+    SOCSupportFunction* fun; ///< the function evaluated
+    const CH_Matrix_Classes::Real* argument; ///< the argument whose blocks were evaluated (set by block 0), NULL if there are none
+    CH_Matrix_Classes::Matrix xval; ///< the maximizer before scaling
+    CH_Matrix_Classes::Matrix blocksq; ///< the sum of squares of each block (without coordinate 0)
+    CH_Matrix_Classes::Indexmatrix blockdone; ///< 1 if the block was evaluated, 0 otherwise
+
+  public:
+    ///
+    SOCSupportBlockEvaluator() : fun(0), argument(0) {
+    }
+
+    /// the function to evaluate by the next blocks
+    void set_function(SOCSupportFunction* f) {
+      fun = f;
+      argument = 0;
+    }
+
+    /// see AFTBlockEvaluator::start_blocks(); returns nonzero if no function is set or dim does not match its cone
+    int start_blocks(CH_Matrix_Classes::Integer dim,
+      CH_Matrix_Classes::Integer n_blocks);
+
+    /// see AFTBlockEvaluator::evaluate_block()
+    void evaluate_block(CH_Matrix_Classes::Integer block,
+      CH_Matrix_Classes::Integer begin,
+      CH_Matrix_Classes::Integer end,
+      const CH_Matrix_Classes::Real* y);
+
+    /// if all blocks were evaluated for the argument @a y, this returns 0 and the value and the SOC vector as SOCSupportFunction::evaluate() for @a y; otherwise it returns 1 and nothing is computed; the blocks are used only once
+    int get_result(const CH_Matrix_Classes::Matrix& y,
+      CH_Matrix_Classes::Real& objective_value,
+      CH_Matrix_Classes::Matrix& SOCvec);
+  };
+
 
   //@}
 
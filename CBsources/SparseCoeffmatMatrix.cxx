@@ -113,7 +113,7 @@ namespace ConicBundle {
         get_out() << "**** ERROR: SparseCoeffmatMatrix::init(.....): in_col_dim=" << in_col_dim << " but should be nonnegative, setting to zero" << std::endl;
       err++;
     }
-    col_dim = max(0, in_col_dim);
+    col_dim = max(Integer(0), in_col_dim);
     for (Integer i = 0; i < block_dim.dim(); i++) {
       if (block_dim(i) < 0) {
         if (cb_out())
@@ -23,6 +23,7 @@
 
 
 
+#include <algorithm>
 #include <sstream>
 #include <fstream>
 #include "mymath.hxx"
@@ -382,7 +383,7 @@ namespace ConicBundle {
         if ((gsmdf.get_map_to_old_variables() == 0)
           || (omdf->get_map_to_old_variables() == 0)
           || (gsmdf.get_new_vardim() != omdf->get_new_vardim())
-          || (sum(*(gsmdf.map_to_old_variables()) - Indexmatrix(omdf->get_new_vardim(), 1, gsmdf.get_map_to_old_variables())) != 0)) {
+          || (!std::equal(gsmdf.get_map_to_old_variables(), gsmdf.get_map_to_old_variables() + gsmdf.get_new_vardim(), omdf->get_map_to_old_variables()))) {
           if (cb_out())
             get_out() << "**** ERROR SumBlockModel::apply_modification(.......): map_to_old_variables of the ground set does not match map_to_old_variables of the OracleModification" << std::endl;
           err++;
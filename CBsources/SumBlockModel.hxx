@@ -318,6 +318,17 @@ namespace ConicBundle {
     /// like BundleModel::transform() this allows SumBlockModel routines to use a given transformation automatically
     SumBlockModel* sbm_transform();
 
+    /** @brief AFTModel calls this before computing the transformed argument for the point with (AFT point) identifier @a y_id; if the result is not NULL, the function is evaluated blockwise by it during the transformation (see AffineFunctionTransformation::transform_argument()), and the next call to eval_function() for @a y_id uses this evaluation instead of calling the oracle
+
+        The default returns NULL, models of oracles that can be evaluated
+        coordinate by coordinate (NNCBoxSupportFunction, BoxOracle,
+        SOCSupportFunction) return an AFTBlockEvaluator that belongs to
+        the model.
+    */
+    virtual AFTBlockEvaluator* get_aft_block_evaluator(CH_Matrix_Classes::Integer /* y_id */) {
+      return 0;
+    }
+
 
 
     /** @brief returns the model aggregate if available.
@@ -305,8 +305,8 @@ namespace ConicBundle {
   //                                bundle_size
   // *****************************************************************************
 
-  Integer SumBundle::bundle_size(FunctionTask ft) const {
-    return Integer(bdata[ft].bundle.size());
+  int SumBundle::bundle_size(FunctionTask ft) const {
+    return int(bdata[ft].bundle.size());
   }
 
 
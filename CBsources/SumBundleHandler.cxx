@@ -90,7 +90,7 @@ namespace ConicBundle {
     }
 
     if (max_bundle_size < max_model_size) {
-      max_bundle_size = max(bi->bundle_size, max(50, 2 * max_model_size));
+      max_bundle_size = max(bi->bundle_size, max(Integer(50), 2 * max_model_size));
     }
 
     const SumBundleParametersObject* insbp = dynamic_cast<const SumBundleParametersObject*>(bp);
@@ -99,8 +99,8 @@ namespace ConicBundle {
       bi->sbp = dynamic_cast<SumBundleParametersObject*>(insbp->clone_BundleParameters());
     }
 
-    bi->sbp->set_max_model_size(max_model_size);
-    bi->sbp->set_max_bundle_size(max_bundle_size);
+    bi->sbp->set_max_model_size(int(max_model_size));
+    bi->sbp->set_max_bundle_size(int(max_bundle_size));
     bi->sbp->set_cbout(this, 0);
 
     if (bi->bundle_size > max_bundle_size) {
@@ -554,7 +554,7 @@ namespace ConicBundle {
       //reorder and shrink if required assuming cyclic order for age of minorants
       if ((aggr_index != bi->aggr_index) || (Integer(sumbundle->get_bundle(ft).size()) > bi->sbp->get_max_bundle_size())) {
         Integer ind = bi->new_index; //newest entry in the bundle
-        Integer mapind = min(Integer(sumbundle->get_bundle(ft).size()), bi->sbp->get_max_bundle_size());
+        Integer mapind = min(Integer(sumbundle->get_bundle(ft).size()), Integer(bi->sbp->get_max_bundle_size()));
         bi->map_to_old.init(mapind, 1, Integer(0));
         bi->new_index = --mapind;
         for (Integer i = mapind; i >= 0; i--, ind--) {
@@ -1703,7 +1703,7 @@ namespace ConicBundle {
       int get_latest_minorants(MinorantBundle& latest_minorants,
         Integer max_number) {
         assert(bi->sbp);
-        bi->sbp->set_max_bundle_size(max(bi->sbp->get_max_bundle_size(), max_number));
+        bi->sbp->set_max_bundle_size(int(max(Integer(bi->sbp->get_max_bundle_size()), max_number)));
         if (bi->bundle_size <= max_number)
           latest_minorants = sumbundle->get_bundle(ft);
         else if (bi->bundle_size > 0) {
@@ -65,7 +65,7 @@ namespace ConicBundle {
       max_model_size = 2;
     }
     if (max_bundle_size < max_model_size) {
-      max_bundle_size = max(Integer(minorants.size()), max(max_model_size, 50));
+      max_bundle_size = int(max(Integer(minorants.size()), Integer(max(max_model_size, 50))));
     }
 
     if (cb_out(1))
@@ -270,7 +270,7 @@ namespace ConicBundle {
       max_model_size = 2;
     }
     if (max_bundle_size < max_model_size) {
-      max_bundle_size = max(Integer(minorants.size()), max(max_model_size, 50));
+      max_bundle_size = int(max(Integer(minorants.size()), Integer(max(max_model_size, 50))));
     }
 
     //collect the indices of the model minorants, the aggregate is always included
@@ -26,6 +26,7 @@
 #include "mymath.hxx"
 #include "SumModelParameters.hxx"
 #include "BundleIdProx.hxx"
+#include "timer_registry.hxx"
 
 using namespace CH_Matrix_Classes;
 
@@ -208,6 +209,7 @@ namespace ConicBundle {
     const Matrix& y,
     Real nullstep_bound,
     Real relprec) {
+    CH_Tools::ScopedTimer scoped_timer("SumModel::eval_function");
     if (cb_out(10)) {
       get_out() << "\n  entering  SumModel::eval_function" << std::endl;
     }
@@ -231,7 +233,7 @@ namespace ConicBundle {
       bundlehandler->clear_cand_minorants();
 
     //compute a quick lower bound on each subfunction
-    Matrix fun_lb(Integer(modelmap.size()), 1, CB_minus_infinity);
+    fun_lb.init(Integer(modelmap.size()), 1, CB_minus_infinity);
     Integer i = 0;
     for (ModelMap::iterator it = modelmap.begin(); it != modelmap.end(); it++, i++) {
       fun_lb(i) = it->second->model()->lb_function(y_id, y);
@@ -328,6 +330,7 @@ namespace ConicBundle {
     Integer y_id,
     const Matrix& y,
     Real relprec) {
+    CH_Tools::ScopedTimer scoped_timer("SumModel::eval_model");
     if (cb_out(10)) {
       get_out() << "\n  entering  SumModel::eval_model" << std::endl;
     }
@@ -431,6 +434,7 @@ namespace ConicBundle {
     const Matrix& y,
     Real model_maxviol,
     BundleProxObject& H) {
+    CH_Tools::ScopedTimer scoped_timer("SumModel::update_model");
     if (bundlehandler != 0) {
       Real model_deviation = 0;
       Real model_curvature = 0;
@@ -507,6 +511,7 @@ namespace ConicBundle {
     BundleProxObject& H,
     Real& model_deviation,
     Real& model_curvature) {
+    CH_Tools::ScopedTimer scoped_timer("SumModel::update_model");
     if (cb_out(10)) {
       get_out() << "\n  entering  SumModel::update_model" << std::endl;
     }
@@ -659,7 +664,7 @@ namespace ConicBundle {
         }
         return 1;
       }
-      mdata.function_id = max(-1, max(mdata.center_ub_fid, mdata.cand_ub_fid));
+      mdata.function_id = max(Integer(-1), max(mdata.center_ub_fid, mdata.cand_ub_fid));
       if ((mdata.function_id < 0) || (mdata.center_ub_fid != mdata.function_id)) {
         center_changed = true;
       }
@@ -1077,6 +1082,7 @@ namespace ConicBundle {
     Real weightu,
     Real model_maxviol,
     const Indexmatrix* indices) {
+    CH_Tools::ScopedTimer scoped_timer("SumModel::add_variable_metric");
     if ((!H.employ_variable_metric()) || (!H.get_use_local_metric())) {
       if (SumBlockModel::add_variable_metric(H, y_id, y, descent_step, weightu,
         model_maxviol, indices)) {
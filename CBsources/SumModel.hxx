@@ -192,6 +192,9 @@ namespace ConicBundle {
     /// the minorant in the center (if collected explicitly)
     MinorantPointer center_minorant;
 
+    /// temporary variable of eval_function(), global only for memory management purposes
+    CH_Matrix_Classes::Matrix fun_lb;
+
 
     //===================  quadratic subproblems ==================
     /// collects the blocks of the submodels 
@@ -167,7 +167,7 @@ namespace ConicBundle {
     {
       // select at_most_k_local_models sorted by average deviation contribution
       // but skip all those whose deviation contribution is almost zero
-      Real avgcurv = max(eps_Real, sum(weighted_curvature) / weighted_curvature.dim());
+      Real avgcurv = max(eps_Real, sum(weighted_curvature) / Real(weighted_curvature.dim()));
       if (cb_out(2)) {
         get_out() << " avgcurv=" << avgcurv;
       }
@@ -0,0 +1,417 @@
+/* ****************************************************************************
+
+    Copyright (C) 2026  ConicBundle contributors
+
+    ConicBundle, Version 1.a.2
+    File:  CBsources/TriangleSeparator.cxx
+    This file is part of ConciBundle, a C/C++ library for convex optimization.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+
+
+#include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <queue>
+#include <thread>
+#include "TriangleSeparator.hxx"
+#include "CMsymsparse.hxx"
+#include "thread_pool.hxx"
+
+
+using namespace CH_Matrix_Classes;
+
+namespace ConicBundle {
+
+  /// a triangle (j and k carry the signs) with the value of its left hand side, sorted by the value and then by the indices
+  class TriangleSeparatorCandidate {
+  public:
+    Real lhs;
+    Integer i, j, k;
+
+    TriangleSeparatorCandidate(Real l, Integer ii, Integer jj, Integer kk) :lhs(l), i(ii), j(jj), k(kk) {
+    }
+
+    bool operator<(const TriangleSeparatorCandidate& tc) const {
+      if (lhs != tc.lhs) return (lhs < tc.lhs);
+      if (i != tc.i) return (i < tc.i);
+      if (j != tc.j) return (j < tc.j);
+      return (k < tc.k);
+    }
+  };
+
+  /// the data shared by all threads of TriangleSeparator::separate(), in plain arrays because the Memarray based matrices must not be allocated in threads
+  class TriangleSeparatorData {
+  public:
+    Integer n;             ///< order of X
+    Integer chunk;         ///< tile size
+    const Real* gt;        ///< the Gram factor in row major order, row i starts at gt+i*r
+    Integer r;             ///< number of columns of the Gram factor
+    const Integer* colbeg; ///< entries of column c of the sparse part are colbeg[c],...,colbeg[c+1]-1
+    const Integer* colrow; ///< row indices of the sparse entries (both triangles)
+    const Real* colval;    ///< values of the sparse entries
+    const Integer* tiles;  ///< work unit u is the pair of tiles tiles[2*u],tiles[2*u+1]
+    Integer ntiles;        ///< number of work units
+  };
+
+  // *************************************************************************
+  //                       triangle_fill_tile
+  // *************************************************************************
+
+  // x(i,c-c0)=x_ic for 0<=i<nrows and c0<=c<c1, stored so that for fixed i
+  // the entries are contiguous in c; the Gram part is formed by dot
+  // products of the rows of G, the sparse part is added by columns
+
+  static void triangle_fill_tile(const TriangleSeparatorData& d,
+    Integer nrows,
+    Integer c0,
+    Integer c1,
+    Real* x) {
+    const Integer b = c1 - c0;
+    const Integer r = d.r;
+    for (Integer i = 0; i < nrows; i++) {
+      const Real* gi = d.gt + i * r;
+      Real* xi = x + i * b;
+      for (Integer c = c0; c < c1; c++) {
+        const Real* gc = d.gt + c * r;
+        Real sum = 0.;
+        for (Integer l = 0; l < r; l++)
+          sum += gi[l] * gc[l];
+        xi[c - c0] = sum;
+      }
+    }
+    if (d.colbeg) {
+      for (Integer c = c0; c < c1; c++) {
+        for (Integer e = d.colbeg[c]; e < d.colbeg[c + 1]; e++) {
+          if (d.colrow[e] < nrows)
+            x[d.colrow[e] * b + c - c0] += d.colval[e];
+        }
+      }
+    }
+  }
+
+  // *************************************************************************
+  //                       triangle_separate_tiles
+  // *************************************************************************
+
+  // each thread fetches pairs of tiles J<=K from next_tile and keeps the at
+  // most max_n best candidates with j in J and k in K in its own heap; the
+  // threshold is only tightened locally, so the union of all heaps contains
+  // the overall best ones. The value of a candidate is the one computed in
+  // the vectorized loop, so candidates tying with the threshold are compared
+  // exactly and ordered by their indices
+
+  static void triangle_separate_tiles(const TriangleSeparatorData* d,
+    std::atomic<Integer>* next_tile,
+    std::size_t max_n,
+    Real threshold,
+    std::vector<TriangleSeparatorCandidate>* result) {
+    std::priority_queue<TriangleSeparatorCandidate> heap;
+    const Integer n = d->n;
+    const Integer chunk = d->chunk;
+    std::vector<Real> vmin(std::size_t(chunk), 0.);
+    Real* vm = &vmin[0];
+    std::vector<Real> tileJ;
+    std::vector<Real> tileK;
+
+    Integer u;
+    while ((u = (*next_tile)++) < d->ntiles) {
+      const Integer j0 = d->tiles[2 * u] * chunk;
+      const Integer j1 = min(n, j0 + chunk);
+      const Integer k0 = d->tiles[2 * u + 1] * chunk;
+      const Integer k1 = min(n, k0 + chunk);
+      const Integer bj = j1 - j0;
+      const Integer bk = k1 - k0;
+
+      //rows i<j<j1 of the columns J and K suffice
+      tileJ.resize(std::size_t(j1 * bj));
+      triangle_fill_tile(*d, j1, j0, j1, &tileJ[0]);
+      const Real* xK = &tileJ[0];
+      if (k0 != j0) {
+        tileK.resize(std::size_t(j1 * bk));
+        triangle_fill_tile(*d, j1, k0, k1, &tileK[0]);
+        xK = &tileK[0];
+      }
+
+      for (Integer j = j0; j < j1; j++) {
+        const Integer kstart = max(k0, j + 1);
+        if (kstart >= k1)
+          continue;
+        const Integer kn = k1 - kstart;
+        const Real* xjk = xK + j * bk + (kstart - k0);
+        for (Integer i = 0; i < j; i++) {
+          const Real xij = tileJ[std::size_t(i * bj + j - j0)];
+          const Real* xik = xK + i * bk + (kstart - k0);
+
+          //minimum over the four sign patterns, branch free so that it vectorizes
+          //min(xij+xik+xjk,xij-xik-xjk)=xij-|xik+xjk|
+          //min(-xij+xik-xjk,-xij-xik+xjk)=-xij-|xik-xjk|
+          for (Integer h = 0; h < kn; h++) {
+            Real v1 = xij - std::fabs(xik[h] + xjk[h]);
+            Real v2 = -xij - std::fabs(xik[h] - xjk[h]);
+            vm[h] = (v1 < v2) ? v1 : v2;
+          }
+
+          for (Integer h = 0; h < kn; h++) {
+            if (vm[h] > threshold)
+              continue;
+            //a tie with the threshold only counts if it replaces a candidate with larger indices
+            const bool full = (heap.size() == max_n);
+            if ((vm[h] == threshold) && (!full))
+              continue;
+            //the signs of the minimum as in the enumeration order (1,1),(1,-1),(-1,1),(-1,-1)
+            const Real b = xik[h];
+            const Real c = xjk[h];
+            Integer signj = 1;
+            Integer signk = (b + c > 0.) ? -1 : 1;
+            if (-xij - std::fabs(b - c) < xij - std::fabs(b + c)) {
+              signj = -1;
+              signk = (b - c > 0.) ? -1 : 1;
+            }
+            TriangleSeparatorCandidate cand(vm[h], i, signj * j, signk * (kstart + h));
+            if (full) {
+              if (!(cand < heap.top()))
+                continue;
+              heap.pop();
+            }
+            heap.push(cand);
+            if (heap.size() == max_n)
+              threshold = heap.top().lhs;
+          }
+        }
+      }
+    }
+
+    result->reserve(heap.size());
+    while (heap.size() > 0) {
+      result->push_back(heap.top());
+      heap.pop();
+    }
+  }
+
+  // *************************************************************************
+  //                             clear
+  // *************************************************************************
+
+  void TriangleSeparator::clear() {
+    n_threads = 0;
+    chunk_size = 256;
+    nnodes = 0;
+    tri_ind.init(0, 3, Integer(0));
+    tri_lhs.init(0, 1, 0.);
+  }
+
+  // *************************************************************************
+  //                             TriangleSeparator
+  // *************************************************************************
+
+  TriangleSeparator::TriangleSeparator(const CBout* cb, int incr) :CBout(cb, incr) {
+    clear();
+  }
+
+  // *************************************************************************
+  //                             ~TriangleSeparator
+  // *************************************************************************
+
+  TriangleSeparator::~TriangleSeparator() {
+  }
+
+  // *************************************************************************
+  //                             separate
+  // *************************************************************************
+
+  int TriangleSeparator::separate(const Matrix& gram,
+    const Sparsesym* sparse_part,
+    Integer in_nnodes,
+    Integer max_n,
+    Real min_violation) {
+    tri_ind.init(0, 3, Integer(0));
+    tri_lhs.init(0, 1, 0.);
+
+    if ((in_nnodes < 0) || (gram.rowdim() < in_nnodes) || ((sparse_part) && (sparse_part->rowdim() < in_nnodes))) {
+      if (cb_out())
+        get_out() << "**** ERROR TriangleSeparator::separate(...): the matrices have fewer rows than nnodes=" << in_nnodes << std::endl;
+      return 1;
+    }
+    nnodes = in_nnodes;
+    if ((nnodes < 3) || (max_n <= 0))
+      return 0;
+
+    //--- the Gram factor in row major order and the sparse part by columns
+    TriangleSeparatorData d;
+    d.n = nnodes;
+    d.chunk = chunk_size;
+    d.r = gram.coldim();
+    std::vector<Real> gt(std::size_t(nnodes * max(d.r, Integer(1))), 0.);
+    for (Integer l = 0; l < d.r; l++) {
+      const Real* gcol = gram.get_store() + l * gram.rowdim();
+      for (Integer i = 0; i < nnodes; i++)
+        gt[std::size_t(i * d.r + l)] = gcol[i];
+    }
+    d.gt = &gt[0];
+    std::vector<Integer> colbeg;
+    std::vector<Integer> colrow;
+    std::vector<Real> colval;
+    d.colbeg = 0;
+    d.colrow = 0;
+    d.colval = 0;
+    if ((sparse_part) && (sparse_part->nonzeros() > 0)) {
+      Indexmatrix I, J;
+      Matrix val;
+      sparse_part->get_edge_rep(I, J, val);
+      colbeg.assign(std::size_t(nnodes + 1), 0);
+      for (Integer h = 0; h < I.dim(); h++) {
+        if ((I(h) >= nnodes) || (J(h) >= nnodes))
+          continue;
+        colbeg[std::size_t(J(h) + 1)]++;
+        if (I(h) != J(h))
+          colbeg[std::size_t(I(h) + 1)]++;
+      }
+      for (Integer c = 0; c < nnodes; c++)
+        colbeg[std::size_t(c + 1)] += colbeg[std::size_t(c)];
+      colrow.resize(std::size_t(max(colbeg[std::size_t(nnodes)], Integer(1))));
+      colval.resize(colrow.size());
+      std::vector<Integer> fill(colbeg.begin(), colbeg.end() - 1);
+      for (Integer h = 0; h < I.dim(); h++) {
+        if ((I(h) >= nnodes) || (J(h) >= nnodes))
+          continue;
+        Integer e = fill[std::size_t(J(h))]++;
+        colrow[std::size_t(e)] = I(h);
+        colval[std::size_t(e)] = val(h);
+        if (I(h) != J(h)) {
+          e = fill[std::size_t(I(h))]++;
+          colrow[std::size_t(e)] = J(h);
+          colval[std::size_t(e)] = val(h);
+        }
+      }
+      d.colbeg = &colbeg[0];
+      d.colrow = &colrow[0];
+      d.colval = &colval[0];
+    }
+
+    //--- the work units are the pairs of tiles J<=K
+    Integer nb = (nnodes + chunk_size - 1) / chunk_size;
+    std::vector<Integer> tiles;
+    tiles.reserve(std::size_t(nb * (nb + 1)));
+    for (Integer jt = 0; jt < nb; jt++) {
+      for (Integer kt = jt; kt < nb; kt++) {
+        tiles.push_back(jt);
+        tiles.push_back(kt);
+      }
+    }
+    d.tiles = &tiles[0];
+    d.ntiles = Integer(tiles.size() / 2);
+
+    //--- run the threads
+    Integer nt = n_threads;
+    if (nt <= 0)
+      nt = Integer(std::thread::hardware_concurrency());
+    nt = max(Integer(1), min(nt, d.ntiles));
+
+    std::atomic<Integer> next_tile(0);
+    std::vector< std::vector<TriangleSeparatorCandidate> > results(static_cast<std::size_t>(nt));
+    const Real bound = -1. - min_violation;
+    CH_Tools::ThreadPool::run(int(nt), [&d, &next_tile, max_n, bound, &results](int t) {
+      triangle_separate_tiles(&d, &next_tile, std::size_t(max_n), bound, &results[std::size_t(t)]);
+    });
+
+    //--- merge the candidates of all threads
+    std::vector<TriangleSeparatorCandidate> all;
+    for (unsigned int t = 1; t < results.size(); t++)
+      results[0].insert(results[0].end(), results[t].begin(), results[t].end());
+    all.swap(results[0]);
+    std::sort(all.begin(), all.end());
+    if (all.size() > std::size_t(max_n))
+      all.erase(all.begin() + max_n, all.end());
+
+    tri_ind.init(Integer(all.size()), 3, Integer(0));
+    tri_lhs.init(Integer(all.size()), 1, 0.);
+    for (Integer t = 0; t < Integer(all.size()); t++) {
+      tri_ind(t, 0) = all[std::size_t(t)].i;
+      tri_ind(t, 1) = all[std::size_t(t)].j;
+      tri_ind(t, 2) = all[std::size_t(t)].k;
+      tri_lhs(t) = all[std::size_t(t)].lhs;
+    }
+
+    return 0;
+  }
+
+  // *************************************************************************
+  //                             get_triangle
+  // *************************************************************************
+
+  int TriangleSeparator::get_triangle(Integer t,
+    Integer& i,
+    Integer& j,
+    Integer& k,
+    Integer& signj,
+    Integer& signk,
+    Real& lhs) const {
+    if ((t < 0) || (t >= tri_ind.rowdim()))
+      return 1;
+    i = tri_ind(t, 0);
+    j = std::abs(tri_ind(t, 1));
+    k = std::abs(tri_ind(t, 2));
+    signj = (tri_ind(t, 1) < 0) ? -1 : 1;
+    signk = (tri_ind(t, 2) < 0) ? -1 : 1;
+    lhs = tri_lhs(t);
+    return 0;
+  }
+
+  // *************************************************************************
+  //                             get_coeffmats
+  // *************************************************************************
+
+  int TriangleSeparator::get_coeffmats(SparseCoeffmatMatrix& scm,
+    const Indexmatrix& block_dim,
+    Integer block,
+    const Indexmatrix* selected) const {
+    if ((block < 0) || (block >= block_dim.dim()) || (block_dim(block) < nnodes)) {
+      if (cb_out())
+        get_out() << "**** ERROR TriangleSeparator::get_coeffmats(...): block " << block << " does not exist or is smaller than nnodes=" << nnodes << std::endl;
+      return 1;
+    }
+    Integer ncols = selected ? selected->dim() : tri_ind.rowdim();
+
+    Indexmatrix indi(3, 1, Integer(0));
+    Indexmatrix indj(3, 1, Integer(0));
+    Matrix val(3, 1, 0.);
+    CoeffmatVector cmv;
+    cmv.reserve(std::size_t(ncols));
+    for (Integer c = 0; c < ncols; c++) {
+      Integer t = selected ? (*selected)(c) : c;
+      Integer i, j, k, signj, signk;
+      Real lhs;
+      if (get_triangle(t, i, j, k, signj, signk, lhs)) {
+        if (cb_out())
+          get_out() << "**** ERROR TriangleSeparator::get_coeffmats(...): selected triangle " << t << " does not exist" << std::endl;
+        return 1;
+      }
+      indi(0) = i; indj(0) = j; val(0) = .5 * Real(signj);
+      indi(1) = i; indj(1) = k; val(1) = .5 * Real(signk);
+      indi(2) = j; indj(2) = k; val(2) = .5 * Real(signj * signk);
+      cmv.push_back(new CMsymsparse(Sparsesym(block_dim(block), 3, indi, indj, val)));
+    }
+
+    Indexmatrix block_ind(ncols, 1, block);
+    Indexmatrix col_ind(ncols, 1, Integer(0));
+    for (Integer c = 0; c < ncols; c++)
+      col_ind(c) = c;
+    return scm.init(block_dim, ncols, &block_ind, &col_ind, &cmv);
+  }
+
+}
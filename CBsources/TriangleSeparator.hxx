@@ -0,0 +1,186 @@
+/* ****************************************************************************
+
+    Copyright (C) 2026  ConicBundle contributors
+
+    ConicBundle, Version 1.a.2
+    File:  CBsources/TriangleSeparator.hxx
+    This file is part of ConciBundle, a C/C++ library for convex optimization.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+
+#ifndef CONICBUNDLE_TRIANGLESEPARATOR_HXX
+#define CONICBUNDLE_TRIANGLESEPARATOR_HXX
+
+/**  @file TriangleSeparator.hxx
+    @brief Header declaring the class ConicBundle::TriangleSeparator
+    @version 1.0
+    @date 2026-10-18
+    @author ConicBundle contributors
+*/
+
+#include "CBout.hxx"
+#include "PSCPrimal.hxx"
+#include "SparseCoeffmatMatrix.hxx"
+
+namespace ConicBundle {
+
+  /**@ingroup implemented_psc_oracle
+   */
+   //@{
+
+  /** @brief separates the most violated triangle inequalities of max-cut
+      for a primal matrix given by a Gram factor plus a sparse part, as
+      generated by GramSparsePSCPrimal
+
+      For nodes 0<=i<j<k<n and signs signj, signk in {-1,1} the triangle
+      inequality reads
+
+      signj*x_ij + signk*x_ik + signj*signk*x_jk >= -1.
+
+      The routine separate() determines (at most) the requested number of
+      inequalities whose left hand side is smallest and below
+      -1-min_violation for the matrix X = G*G^T + S. X is never formed.
+      The indices are partitioned into tiles of get_chunk_size()
+      consecutive indices. For a pair of tiles J<=K the entries x_ij and
+      x_ik, x_jk with i<j, j in J and k in K are computed by dot products
+      of the rows of G plus the entries of S into two buffers of
+      get_chunk_size() columns, in which for fixed (i,j) the values x_ik
+      and x_jk are contiguous in k. The minimum over the four sign
+      patterns is then computed branch free for all k of the tile (this
+      loop is vectorized by the compiler), followed by a scan for values
+      below the current threshold. So each thread needs only
+      O(nnodes*get_chunk_size()) storage. The pairs of tiles are
+      distributed dynamically over get_n_threads() threads, each keeping
+      its own bounded heap of the best candidates; these are merged at
+      the end. The result is sorted by nondecreasing left hand side
+      and, for ties, by the indices; candidates tying with the cut off
+      are also decided by the indices, so the result depends neither on
+      the number of threads nor on the tile size.
+
+      get_coeffmats() generates the CMsymsparse coefficient matrices of
+      selected inequalities in one step in the form required by
+      PSCAffineModification::add_append_vars().
+  */
+
+  class TriangleSeparator : public CBout {
+  private:
+    CH_Matrix_Classes::Integer n_threads; ///< number of threads, 0 uses std::thread::hardware_concurrency()
+    CH_Matrix_Classes::Integer chunk_size; ///< number of indices per tile, i.e., of k indices evaluated at once in the vectorized loop
+
+    CH_Matrix_Classes::Integer nnodes; ///< order of the matrix of the last call to separate()
+
+    CH_Matrix_Classes::Indexmatrix tri_ind; ///< row t holds i, signj*j, signk*k of triangle t
+    CH_Matrix_Classes::Matrix tri_lhs;      ///< the value of the left hand side of triangle t
+
+  public:
+    /// reset to the default values
+    void clear();
+
+    /// calls clear()
+    TriangleSeparator(const CBout* cb = 0, int incr = -1);
+
+    ///
+    ~TriangleSeparator();
+
+    /// set the number of threads (0 for std::thread::hardware_concurrency(), default 0)
+    void set_n_threads(CH_Matrix_Classes::Integer nt) {
+      n_threads = (nt < 0) ? 0 : nt;
+    }
+    /// returns the number of threads set (0 for std::thread::hardware_concurrency())
+    CH_Matrix_Classes::Integer get_n_threads() const {
+      return n_threads;
+    }
+
+    /// set the number of indices per tile, i.e., of k indices evaluated at once in the vectorized loop (default 256)
+    void set_chunk_size(CH_Matrix_Classes::Integer cs) {
+      chunk_size = (cs < 8) ? 8 : cs;
+    }
+    /// returns the number of indices per tile
+    CH_Matrix_Classes::Integer get_chunk_size() const {
+      return chunk_size;
+    }
+
+    /** @brief find at most max_n triangle inequalities with left hand side below -1-min_violation for X=gram*gram^T+sparse_part restricted to the first nnodes indices
+
+        @param[in] gram
+            Gram factor G with (at least) nnodes rows
+
+        @param[in] sparse_part
+            may be 0, otherwise the sparse symmetric part S of order >= nnodes
+
+        @param[in] nnodes
+            only the leading principal nnodes x nnodes submatrix is considered
+
+        @param[in] max_n
+            maximum number of inequalities returned
+
+        @param[in] min_violation
+            only inequalities violated by more than this are returned
+
+        @return 0 on success, nonzero on errors (dimension mismatch)
+    */
+    int separate(const CH_Matrix_Classes::Matrix& gram,
+      const CH_Matrix_Classes::Sparsesym* sparse_part,
+      CH_Matrix_Classes::Integer nnodes,
+      CH_Matrix_Classes::Integer max_n,
+      CH_Matrix_Classes::Real min_violation = 1e-3);
+
+    /// calls separate() for the Gram matrix and the sparse part of @a primal
+    int separate(const GramSparsePSCPrimal& primal,
+      CH_Matrix_Classes::Integer nnodes,
+      CH_Matrix_Classes::Integer max_n,
+      CH_Matrix_Classes::Real min_violation = 1e-3) {
+      return separate(primal.get_grammatrix(), &primal, nnodes, max_n, min_violation);
+    }
+
+    /// number of triangle inequalities found in the last call to separate()
+    CH_Matrix_Classes::Integer get_n_triangles() const {
+      return tri_ind.rowdim();
+    }
+
+    /// retrieve triangle t (sorted by nondecreasing lhs, i.e., most violated first) and its left hand side value; returns 1 if t is out of range
+    int get_triangle(CH_Matrix_Classes::Integer t,
+      CH_Matrix_Classes::Integer& i,
+      CH_Matrix_Classes::Integer& j,
+      CH_Matrix_Classes::Integer& k,
+      CH_Matrix_Classes::Integer& signj,
+      CH_Matrix_Classes::Integer& signk,
+      CH_Matrix_Classes::Real& lhs) const;
+
+    /** @brief forms the coefficient matrices for the triangles listed in selected (or all found if selected==0) as columns of @a scm
+
+        Column c of @a scm gets in block @a block the CMsymsparse matrix
+        A with <A,X> = signj*x_ij + signk*x_ik + signj*signk*x_jk
+        (the off-diagonal entries are 1/2 times the signs) of the c-th
+        selected triangle, so that @a scm can be passed to
+        PSCAffineModification::add_append_vars() as in the max-cut
+        example mc_triangle.cxx.
+
+        @return 0 on success, nonzero if indices are out of range
+    */
+    int get_coeffmats(SparseCoeffmatMatrix& scm,
+      const CH_Matrix_Classes::Indexmatrix& block_dim,
+      CH_Matrix_Classes::Integer block,
+      const CH_Matrix_Classes::Indexmatrix* selected = 0) const;
+
+  };
+
+  //@}
+
+}
+
+#endif
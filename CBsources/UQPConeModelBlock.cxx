@@ -400,12 +400,13 @@ namespace ConicBundle {
       Real tapia_factor = (old_mu > 0.) ? current_mu / old_mu : 1.;
 
       nncx_activity->newsize(nnc_dim, 1); chk_set_init(*nncx_activity, 1);
-      Matrix dual_tapia(nnc_dim, 1); chk_set_init(dual_tapia, 1);
+      Matrix& dual_tapia = tmp_dual_tapia;
+      dual_tapia.newsize(nnc_dim, 1); chk_set_init(dual_tapia, 1);
       for (Integer i = 0; i < nnc_dim; i++) {
         (*nncx_activity)(i) = nncx(i) / old_x(i);
         dual_tapia(i) = z(i) / old_z(i);
       }
-      Indexmatrix sind;
+      Indexmatrix& sind = tmp_sind;
       sortindex(nncx, sind, false);
       Integer i0 = sind(0);
 
@@ -554,7 +555,7 @@ namespace ConicBundle {
     }
 
 
-    int eigstat = Xp[unsigned(psci)].eig(pscx_vecs, pscx_eigs, false);
+    int eigstat = int(Xp[unsigned(psci)].eig(pscx_vecs, pscx_eigs, false));
     if (eigstat) {
       if (cb_out())
         get_out() << "**** WARNING UQPConeModelBlock::get_pscx(....): eigenvalue factorization for semidefinite Xp[" << psci << "] failed and returned " << eigstat << std::endl;
@@ -1334,11 +1335,11 @@ namespace ConicBundle {
   //returns 0 on success, 1 on failure
 
   int UQPConeModelBlock::starting_x(Matrix& qp_x) {
-    Real initval = b / mu_dim;
+    Real initval = b / Real(mu_dim);
     s = 0;
     if (A.rowdim() > 0) {
       if ((box_dim > 0) && (!box_scaling))
-        initval = b / (mu_dim - 2 * lb.rowdim());
+        initval = b / Real(mu_dim - 2 * lb.rowdim());
       x.init(A, initval);
       x.transpose();
       if (less_or_equal)
@@ -1356,7 +1357,7 @@ namespace ConicBundle {
       if (box_scaling) {
         Real s = b * .5;
         if (!box_scaleub) {
-          s = (2 * lb.rowdim() + 1) * initval; //contribution to trace is now mu_dim*val
+          s = Real(2 * lb.rowdim() + 1) * initval; //contribution to trace is now mu_dim*val
         }
         mat_xeya(lb.rowdim(), x.get_store() + box_start, lb.get_store(), .5 * s);
         mat_xpeya(ub.rowdim(), x.get_store() + box_start, ub.get_store(), .5 * s);
@@ -1527,7 +1528,7 @@ namespace ConicBundle {
     restart_factor = min(max(0.9, sqrt(1 - min(1., sqrt(normdc / normc)))), 0.99999);
     if (A.rowdim() > 0) {
       A.transpose();
-      xbpeya(x, A, (b - b * restart_factor) / mu_dim, restart_factor);
+      xbpeya(x, A, (b - b * restart_factor) / Real(mu_dim), restart_factor);
       A.transpose();
     }
 
@@ -1537,7 +1538,7 @@ namespace ConicBundle {
     }
 
     if (less_or_equal) {
-      s = s * restart_factor + (b - b * restart_factor) / mu_dim;
+      s = s * restart_factor + (b - b * restart_factor) / Real(mu_dim);
     }
 
     mat_xey(x.rowdim(), qp_x.get_store() + qp_xstart, x.get_store());
@@ -1622,7 +1623,7 @@ namespace ConicBundle {
     dy += (1. - restart_factor) * .1;
     dy = max(dy, 1e-5);
     z += tmpvec;
-    if (A.rowdim() > 0.) {
+    if (A.rowdim() > 0) {
       A.transpose();
       z.xpeya(A, dy);
       A.transpose();
@@ -1753,6 +1754,158 @@ namespace ConicBundle {
     return 0;
   }
 
+  // ****************************************************************************
+  //                        max_psc_order
+  // ****************************************************************************
+
+  Integer UQPConeModelBlock::max_psc_order() const {
+    Integer order = 0;
+    for (unsigned int i = 0; i < Xp.size(); i++)
+      order = max(order, Xp[i].rowdim());
+    return order;
+  }
+
+  // ****************************************************************************
+  //                        prepare_xinv_kron_z
+  // ****************************************************************************
+
+  //compute Xinv and add the diagonal of the term of add_xinv_kron_z to diagQ
+
+  int UQPConeModelBlock::prepare_xinv_kron_z(Matrix& diagQ) {
+    Integer dind = qp_xstart;
+    for (Integer i = 0; i < nnc_dim; i++) {
+      diagQ(dind) += z(i) / x(i);
+      dind++;
+    }
+    for (Integer i = 0; i < soc_dim.dim(); i++) {
+      const Real* xp = x.get_store() + dind - qp_xstart;
+      const Real* zp = z.get_store() + dind - qp_xstart;
+      Real xs = xp[0] * xp[0];
+      for (Integer j = 1; j < soc_dim(i); j++) {
+        xs -= xp[j] * xp[j];
+      }
+      Real xzip = mat_ip(soc_dim(i), xp, zp);
+      diagQ(dind) += (-xzip + 2 * xp[0] * zp[0]) / xs;
+      for (Integer j = 1; j < soc_dim(i); j++) {
+        diagQ(dind + j) += (xzip - 2 * zp[j] * xp[j]) / xs;
+      }
+      dind += soc_dim(i);
+    }
+    for (unsigned int i = 0; i < Xp.size(); i++) {
+      tmpsymmat = Xp[i];
+      if (tmpsymmat.Chol_factor(1e-20)) {
+        if (cb_out()) get_out() << "*** WARNING: UQPConeModelBlock::prepare_xinv_kron_z: factorizing Xp[" << i << "] failed" << std::endl;
+        return 1;
+      }
+      tmpsymmat.Chol_inverse(Xinv[i]);
+      //diagonal of (Xinv skron Z) in svec order
+      const Symmatrix& Xi = Xinv[i];
+      const Symmatrix& Zi = Zp[i];
+      for (Integer j = 0; j < Xi.rowdim(); j++) {
+        diagQ(dind++) += Xi(j, j) * Zi(j, j);
+        for (Integer k = j + 1; k < Xi.rowdim(); k++) {
+          diagQ(dind++) += .5 * (Xi(j, j) * Zi(k, k) + Xi(k, k) * Zi(j, j)) + Xi(j, k) * Zi(j, k);
+        }
+      }
+    }
+    if (box_dim > 0) {
+      if (!box_scaling) {
+        for (Integer i = 0; i < lb.rowdim(); i++, dind++) {
+          diagQ(dind) += z(dind) / (x(dind) - lb(i)) + uz(i) / (ub(i) - x(dind));
+        }
+      } else {
+        Real xval = x(box_start + lb.rowdim());
+        Real lastval = 0.;
+        for (Integer i = 0; i < lb.rowdim(); i++, dind++) {
+          Real lval = z(dind) / (x(dind) - xval * lb(i));
+          Real uval = uz(i) / (ub(i) * xval - x(dind));
+          diagQ(dind) += lval + uval;
+          lastval += lb(i) * lb(i) * lval + ub(i) * ub(i) * uval;
+        }
+        lastval += z(dind) / x(dind);
+        if (box_scaleub)
+          lastval += box_uz / (b - x(dind));
+        diagQ(dind) += lastval;
+      }
+    }
+
+    return 0;
+  }
+
+  // ****************************************************************************
+  //                        add_xinv_kron_z_times
+  // ****************************************************************************
+
+  //qp_out+=(term of add_xinv_kron_z)*qp_vec, requires prepare_xinv_kron_z
+
+  int UQPConeModelBlock::add_xinv_kron_z_times(Matrix& qp_out, const Matrix& qp_vec) {
+    Integer dind = qp_xstart;
+    for (Integer i = 0; i < nnc_dim; i++) {
+      qp_out(dind) += z(i) / x(i) * qp_vec(dind);
+      dind++;
+    }
+    for (Integer i = 0; i < soc_dim.dim(); i++) {
+      const Real* xp = x.get_store() + dind - qp_xstart;
+      const Real* zp = z.get_store() + dind - qp_xstart;
+      const Real* vp = qp_vec.get_store() + dind;
+      Real* op = qp_out.get_store() + dind;
+      Integer sd = soc_dim(i);
+      Real xs = xp[0] * xp[0];
+      for (Integer j = 1; j < sd; j++) {
+        xs -= xp[j] * xp[j];
+      }
+      Real xzip = mat_ip(sd, xp, zp);
+      Real xv = mat_ip(sd - 1, xp + 1, vp + 1);
+      Real zv = mat_ip(sd - 1, zp + 1, vp + 1);
+      Real d0 = (-xzip + 2 * xp[0] * zp[0]) * vp[0];
+      for (Integer j = 1; j < sd; j++) {
+        Real s0j = -zp[0] * xp[j] + xp[0] * zp[j];
+        d0 += s0j * vp[j];
+        op[j] += (s0j * vp[0] + xzip * vp[j] - xp[j] * zv - zp[j] * xv) / xs;
+      }
+      op[0] += d0 / xs;
+      dind += sd;
+    }
+    for (unsigned int i = 0; i < Xp.size(); i++) {
+      //svec((Xinv*V*Z+Z*V*Xinv)/2)
+      Integer order = Xp[i].rowdim();
+      sveci(qp_vec, tmpsymmat, 1., false, dind, -1, order);
+      tmpmat2.init(tmpsymmat);
+      genmult(Xinv[i], tmpmat2, tmpmat);
+      genmult(Zp[i], tmpmat, tmpmat2, 1., 0., 1);
+      tmpsymmat.init(tmpmat2);
+      svec(tmpsymmat, qp_out, 1., true, dind);
+      dind += (order * (order + 1)) / 2;
+    }
+    if (box_dim > 0) {
+      if (!box_scaling) {
+        for (Integer i = 0; i < lb.rowdim(); i++, dind++) {
+          qp_out(dind) += (z(dind) / (x(dind) - lb(i)) + uz(i) / (ub(i) - x(dind))) * qp_vec(dind);
+        }
+      } else {
+        Real xval = x(box_start + lb.rowdim());
+        Real lastval = 0.;
+        Integer lastind = dind + lb.rowdim();
+        Real lastvec = qp_vec(lastind);
+        Real lastout = 0.;
+        for (Integer i = 0; i < lb.rowdim(); i++, dind++) {
+          Real lval = z(dind) / (x(dind) - xval * lb(i));
+          Real uval = uz(i) / (ub(i) * xval - x(dind));
+          Real offdiag = -(lb(i) * lval + ub(i) * uval);
+          qp_out(dind) += (lval + uval) * qp_vec(dind) + offdiag * lastvec;
+          lastout += offdiag * qp_vec(dind);
+          lastval += lb(i) * lb(i) * lval + ub(i) * ub(i) * uval;
+        }
+        lastval += z(dind) / x(dind);
+        if (box_scaleub)
+          lastval += box_uz / (b - x(dind));
+        qp_out(dind) += lastout + lastval * lastvec;
+      }
+    }
+
+    return 0;
+  }
+
   // ****************************************************************************
   //                           add_local_sys
   // ****************************************************************************
@@ -137,6 +137,10 @@ namespace ConicBundle {
     std::vector<CH_Matrix_Classes::Symmatrix> old_Zp; ///< previous value of Zp
     CH_Matrix_Classes::Real last_alpha; ///< most recent value of step size alpha
 
+    //---- temporary variables of get_nncx(), global only for memory management purposes
+    CH_Matrix_Classes::Matrix tmp_dual_tapia;   ///< ratios of the dual values to their previous values
+    CH_Matrix_Classes::Indexmatrix tmp_sind;    ///< sorting index of nncx
+
     //---- for forming or testing the corrector the old step is copied here
     CH_Matrix_Classes::Matrix zcorr;   ///< value used in corrector of z
     CH_Matrix_Classes::Matrix uzcorr;  ///< value used in corrector of uz
@@ -155,6 +159,8 @@ namespace ConicBundle {
     mutable CH_Matrix_Classes::Matrix tmpsvec; ///< temporary variable to reduce reallocations
     mutable CH_Matrix_Classes::Symmatrix tmpsymmat; ///< temporary variable to reduce reallocations
     mutable CH_Matrix_Classes::Symmatrix dX; ///< temporary variable to reduce reallocations
+    mutable CH_Matrix_Classes::Matrix tmpmat;  ///< temporary variable to reduce reallocations
+    mutable CH_Matrix_Classes::Matrix tmpmat2; ///< temporary variable to reduce reallocations
 
     //the Block has to memorize and update its local x,y,z variables 
     //(and all additional ones that are not visible to the outside)
@@ -398,6 +404,16 @@ namespace ConicBundle {
     /// add the system term corresponding to (xinv kron z) (that arises from solving the linearized perturbed complementarity system x*z =0 or =mu*I for dx in the preferred search direction) to the diagonal block corresponding to qpx_range x qpx_range
     int add_xinv_kron_z(CH_Matrix_Classes::Symmatrix& barQ);
 
+    /// returns the maximum order of the positive semidefinite blocks (0 if there are none)
+    CH_Matrix_Classes::Integer max_psc_order() const;
+
+    /// computes Xinv and adds the diagonal of the system term of add_xinv_kron_z() to @a diagQ, see UQPModelBlockObject::prepare_xinv_kron_z()
+    int prepare_xinv_kron_z(CH_Matrix_Classes::Matrix& diagQ);
+
+    /// adds the product of the system term of add_xinv_kron_z() with @a qp_vec to @a qp_out, see UQPModelBlockObject::add_xinv_kron_z_times()
+    int add_xinv_kron_z_times(CH_Matrix_Classes::Matrix& qp_out,
+      const CH_Matrix_Classes::Matrix& qp_vec);
+
     /** @brief add the local system informatoin
 
       on input:
@@ -173,6 +173,12 @@ namespace ConicBundle {
     //returns 0 on success, 1 on failure
 
     //virtual int add_xinv_kron_z(CH_Matrix_Classes::Symmatrix& barQ)=0;
+
+    //virtual CH_Matrix_Classes::Integer max_psc_order() const=0;
+
+    //virtual int prepare_xinv_kron_z(CH_Matrix_Classes::Matrix& diagQ)=0;
+
+    //virtual int add_xinv_kron_z_times(CH_Matrix_Classes::Matrix& qp_out,const CH_Matrix_Classes::Matrix& qp_vec)=0;
     //add the system term corresponding to (xinv kron z)
     //(that arises from solving the linearized perturbed complementarity system
     // x*z =0 or =mu*I for dx in the preferred search direction)
@@ -163,6 +163,28 @@ namespace ConicBundle {
     /// add the system term corresponding to (xinv kron z) (that arises from solving the linearized perturbed complementarity system x*z =0 or =mu*I for dx in the preferred search direction) to the diagonal block corresponding to qpx_range x qpx_range
     virtual int add_xinv_kron_z(CH_Matrix_Classes::Symmatrix& barQ) = 0;
 
+    /// returns the maximum order of the positive semidefinite blocks (0 if there are none)
+    virtual CH_Matrix_Classes::Integer max_psc_order() const = 0;
+
+    /** @brief prepares add_xinv_kron_z_times() for the current point and adds the diagonal of the system term of add_xinv_kron_z() to @a diagQ
+
+        This allows to solve the system with barQ matrix free, e.g., by a
+        preconditioned conjugate gradient method (see UQPSolver). The
+        vector @a diagQ has the dimension of qp_x and is updated in the
+        local range only.
+    */
+    virtual int prepare_xinv_kron_z(CH_Matrix_Classes::Matrix& diagQ) = 0;
+
+    /** @brief adds the product of the system term of add_xinv_kron_z() with @a qp_vec to @a qp_out without forming the term
+
+        prepare_xinv_kron_z() must have been called for the current point.
+        For positive semidefinite blocks the product with
+        (Xinv skron Z) is computed as svec(Xinv*V*Z+Z*V*Xinv)/2 in O(order^3)
+        operations instead of the O(order^4) of the explicit matrix.
+    */
+    virtual int add_xinv_kron_z_times(CH_Matrix_Classes::Matrix& qp_out,
+      const CH_Matrix_Classes::Matrix& qp_vec) = 0;
+
     /** @brief add the local system informatoin
 
       on input:
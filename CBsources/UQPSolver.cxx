@@ -27,6 +27,7 @@
 #include <sstream>
 #include <fstream>
 #include "UQPSolver.hxx"
+#include "timer_registry.hxx"
 
 
 using namespace CH_Matrix_Classes;
@@ -37,6 +38,11 @@ namespace ConicBundle {
   void UQPSolver::set_defaults() {
     termeps = 1e-7;
     maxiter = 100;
+    matfree_order = 60;
+    matfree_relprec = 1e-10;
+    reuse_factor = false;
+    reuse_maxit = 5;
+    reuse_relprec = 1e-6;
   }
 
   void UQPSolver::clear() {
@@ -61,6 +67,14 @@ namespace ConicBundle {
     Qplus.init(0, 0.);
     LinvAt.init(0, 0, 0.);
     sysdy.init(0, 0.);
+    matfree_state = 0;
+    matfree_failed = false;
+    Qplus_factored = false;
+    reuse_failed = false;
+    sysdiag.init(0, 1, 0.);
+    sysrhs = 0;
+    cgsol.init(0, 1, 0.);
+    tmpmat.init(0, 0, 0.);
     rd.init(0, 1, 0.);
     rhs.init(0, 1, 0.);
     xcorr.init(0, 1, 0.);
@@ -68,6 +82,9 @@ namespace ConicBundle {
 
     sum_iter = 0;
     sum_choliter = 0;
+    sum_cgiter = 0;
+    sum_factor = 0;
+    sum_reuse = 0;
     clock.start();
     sum_choltime = 0;
   }
@@ -86,11 +103,95 @@ namespace ConicBundle {
     model_block->suggest_mu(ip_xz, mu_dim, sigma, dx, dy, rhs_residual);
     sigma = max(0.01, sigma);
     sigma = min(1., sigma);
-    mu = ip_xz / mu_dim;
+    mu = ip_xz / Real(mu_dim);
     mu = min(oldmu, sigma * mu);
   }
 
 
+  // *************************************************************************
+  //                            ItSys_mult
+  // *************************************************************************
+
+  int UQPSolver::ItSys_mult(const Matrix& in_vec, Matrix& out_vec) {
+    genmult(Q, in_vec, out_vec);
+    return model_block->add_xinv_kron_z_times(out_vec, in_vec);
+  }
+
+  // *************************************************************************
+  //                            ItSys_precondM1
+  // *************************************************************************
+
+  int UQPSolver::ItSys_precondM1(Matrix& vec) {
+    if (matfree_state == 3)
+      return Qplus.Chol_solve(vec);
+    vec /= sysdiag;
+    return 0;
+  }
+
+  // *************************************************************************
+  //                            solve_system
+  // *************************************************************************
+
+  // in the matrix free state this tries a preconditioned conjugate gradient
+  // solve first; if it does not reach the precision within an iteration
+  // budget comparable to the cost of the dense factorization, the dense
+  // system is formed and factorized and used for the rest of this call
+  // to iterate(); when reusing the factorization of an earlier step as
+  // preconditioner, the budget is reuse_maxit and the new factorization
+  // is used for the rest of the step only
+
+  int UQPSolver::solve_system(Matrix& v) {
+    if ((matfree_state == 1) || (matfree_state == 3)) {
+      Real termprec = ((matfree_state == 1) ? matfree_relprec : reuse_relprec) * norm2(v);
+      if (termprec == 0.) {
+        return 0;
+      }
+      sysrhs = &v;
+      cgsol.init(0, 1, 0.);
+      if (matfree_state == 1)
+        pcg.set_maxit(max(Integer(10), Q.rowdim() / (4 * (y.dim() + 3))));
+      else
+        pcg.set_maxit(reuse_maxit);
+      int err = pcg.compute(*this, cgsol, termprec);
+      sysrhs = 0;
+      sum_cgiter += pcg.get_nmult();
+      CH_Tools::TimerRegistry::add_count("cg iterations", pcg.get_nmult());
+      if ((err == 0) && (pcg.get_residual_norm() <= termprec)) {
+        swap(v, cgsol);
+        return 0;
+      }
+      if (matfree_state == 1) {
+        if (cb_out(1)) {
+          get_out() << "*** WARNING: UQPSolver::solve_system(): matrix free solve stopped after " << pcg.get_nmult() << " iterations with residual norm " << pcg.get_residual_norm() << ", switching to the factorization" << std::endl;
+        }
+        matfree_failed = true;
+      } else {
+        if (cb_out(2)) {
+          get_out() << " UQPSolver::solve_system(): solve with earlier factorization stopped after " << pcg.get_nmult() << " iterations with residual norm " << pcg.get_residual_norm() << ", refactorizing" << std::endl;
+        }
+        reuse_failed = true;
+      }
+      matfree_state = 2;
+      Qplus_factored = false;
+      Qplus = Q;
+      if (model_block->add_xinv_kron_z(Qplus)) {
+        if (cb_out(1)) {
+          get_out() << "*** WARNING: UQPSolver::solve_system(): collecting system matrix failed " << std::endl;
+        }
+        return 3;
+      }
+      sum_factor++;
+      if (Qplus.Chol_factor(eps_Real)) {
+        if (cb_out(1)) {
+          get_out() << "*** WARNING: UQPSolver::solve_system(): factorizing system matrix failed" << std::endl;
+        }
+        return 2;
+      }
+      Qplus_factored = true;
+    }
+    return Qplus.Chol_solve(v);
+  }
+
   // *************************************************************************
   //                            predcorr_step
   // *************************************************************************
@@ -99,30 +200,78 @@ namespace ConicBundle {
 
   int UQPSolver::predcorr_step(Real& alpha) {
     status = 0;
-    Indexmatrix piv;
 
-    //--- build Q-part of system matrix
-    Qplus = Q;
-    if (model_block->add_xinv_kron_z(Qplus)) {
-      if (cb_out(1)) {
-        get_out() << "*** WARNING: UQPSolver::predcorr_step(): collecting system matrix failed " << std::endl;
+    //--- decide on solving the Q-part of the system matrix matrix free or
+    //    with the factorization of an earlier step as preconditioner
+    //    (if so, LinvAt holds barQinv*transpose(A) instead of L^-1*transpose(A)
+    //    for the entire step, even if solve_system() falls back to the factorization)
+    const bool matfree = (!matfree_failed) && (matfree_order > 0) && (model_block->max_psc_order() >= matfree_order);
+    const bool reuse = (!matfree) && (reuse_factor) && (!reuse_failed) && (Qplus_factored) && (Qplus.rowdim() == Q.rowdim());
+    const bool iterative = matfree || reuse;
+    matfree_state = matfree ? 1 : (reuse ? 3 : 0);
+
+    if (iterative) {
+      //--- collect the diagonal of the Q-part as preconditioner 
+      sysdiag.init(Q.rowdim(), 1, 0.);
+      for (Integer i = 0; i < Q.rowdim(); i++)
+        sysdiag(i) = Q(i, i);
+      if (model_block->prepare_xinv_kron_z(sysdiag)) {
+        if (cb_out(1)) {
+          get_out() << "*** WARNING: UQPSolver::predcorr_step(): preparing matrix free system failed " << std::endl;
+        }
+        status = 3;
+        return status;
+      }
+      for (Integer i = 0; i < sysdiag.dim(); i++) {
+        if (sysdiag(i) <= 0.)
+          sysdiag(i) = 1.;
       }
-      status = 3;
-      return status;
-    }
 
-    Symmatrix barQ(Qplus);                   //TEST
+      if (y.dim() > 0) {
+        //LinvAt=barQinv*transpose(A)
+        xbpeya(LinvAt, A, 1., 0., 1);
+        for (Integer j = 0; j < LinvAt.coldim(); j++) {
+          tmpvec = LinvAt.col(j);
+          if ((status = solve_system(tmpvec))) {
+            if (cb_out(1)) {
+              get_out() << "*** WARNING: UQPSolver::predcorr_step(): solving system for column " << j << " failed" << std::endl;
+            }
+            return status;
+          }
+          mat_xey(tmpvec.dim(), LinvAt.get_store() + j * LinvAt.rowdim(), tmpvec.get_store());
+        }
 
-    //--- factorize Q-part of system matrix and compute system for y
-    if (Qplus.Chol_factor(eps_Real)) {
-      if (cb_out(1)) {
-        get_out() << "*** WARNING: UQPSolver::predcorr_step(): factorizing system matrix failed" << std::endl;
+        //sysdy=A*barQinv*transpose(A)
+        genmult(A, LinvAt, tmpmat);
+        sysdy.init(tmpmat);
+      }
+    } else {
+
+      //--- build Q-part of system matrix
+      Qplus = Q;
+      if (model_block->add_xinv_kron_z(Qplus)) {
+        if (cb_out(1)) {
+          get_out() << "*** WARNING: UQPSolver::predcorr_step(): collecting system matrix failed " << std::endl;
+        }
+        status = 3;
+        return status;
       }
-      //cout<<barQ<<std::endl;
-      //cout<<Q<<std::endl;
-      status = 2;
-      return status;
-    }
+
+      //Symmatrix barQ(Qplus);                   //TEST
+
+      //--- factorize Q-part of system matrix and compute system for y
+      Qplus_factored = false;
+      sum_factor++;
+      if (Qplus.Chol_factor(eps_Real)) {
+        if (cb_out(1)) {
+          get_out() << "*** WARNING: UQPSolver::predcorr_step(): factorizing system matrix failed" << std::endl;
+        }
+        //cout<<barQ<<std::endl;
+        //cout<<Q<<std::endl;
+        status = 2;
+        return status;
+      }
+      Qplus_factored = true;
 
     //Symmatrix barQinv;                        //TEST
     //Matrix barQinvmat(Diag(Matrix(Qplus.dim(),1,1.)));//TEST
@@ -130,13 +279,14 @@ namespace ConicBundle {
     //barQinv.init(barQinvmat);//TEST
     //std::cout<<"  norm2(barQinv*barQ-Diag(Matrix(Qplus.dim(),1,1.)))="<<norm2(barQinv*barQ-Diag(Matrix(Qplus.dim(),1,1.)))<<std::endl;//TEST
 
-    if (y.dim() > 0) {
-      //LinvAt=L^-1*transpose(A)
-      xbpeya(LinvAt, A, 1., 0., 1);
-      Qplus.Chol_Lsolve(LinvAt);
+      if (y.dim() > 0) {
+        //LinvAt=L^-1*transpose(A)
+        xbpeya(LinvAt, A, 1., 0., 1);
+        Qplus.Chol_Lsolve(LinvAt);
 
-      //sysdy=LiAt'*LiAt
-      rankadd(LinvAt, sysdy, 1., 0., 1);
+        //sysdy=LiAt'*LiAt
+        rankadd(LinvAt, sysdy, 1., 0., 1);
+      }
     }
     //std::cout<<"  norm2(sysdy-A*barQinv*transpose(A))="<<norm2(sysdy-A*barQinv*transpose(A))<<std::endl;//TEST
 
@@ -150,7 +300,8 @@ namespace ConicBundle {
 
       //rhs= A*barQinv*rd-(b-Ax)
       tmpvec = rd;
-      Qplus.Chol_Lsolve(tmpvec);
+      if (!iterative)
+        Qplus.Chol_Lsolve(tmpvec);
       genmult(LinvAt, tmpvec, rhs, 1., 0., 1);
       rhs -= b;
       genmult(A, x, rhs, 1., 1.);
@@ -194,7 +345,12 @@ namespace ConicBundle {
       dx = rd;
     }
     tmpvec.init(dx, -1.);
-    Qplus.Chol_solve(dx);
+    if ((status = solve_system(dx))) {
+      if (cb_out(1)) {
+        get_out() << "*** WARNING: UQPSolver::predcorr_step(): solving for the predictor failed" << std::endl;
+      }
+      return status;
+    }
     /// tmpvec = -(c-At*(y+dy)-Q(x+dx));
     genmult(Q, dx, tmpvec, 1., 1.);
 
@@ -235,7 +391,8 @@ namespace ConicBundle {
     // dy = sysinv*( barQinv*xcorr+rhs) 
     if (y.dim() > 0) {
       tmpvec = xcorr;
-      Qplus.Chol_Lsolve(tmpvec);
+      if (!iterative)
+        Qplus.Chol_Lsolve(tmpvec);
       genmult(LinvAt, tmpvec, dy, 1., 0., 1);
       dy += rhs;
       sysdy.Chol_solve(dy, piv);
@@ -248,9 +405,16 @@ namespace ConicBundle {
     }
     tmpvec.init(dx, -1.);
     dx += xcorr;
-    Qplus.Chol_solve(dx);
+    if ((status = solve_system(dx))) {
+      if (cb_out(1)) {
+        get_out() << "*** WARNING: UQPSolver::predcorr_step(): solving for the corrector failed" << std::endl;
+      }
+      return status;
+    }
     //tmpvec=-(c-At*y-Qx-At*dy)-z+Q*dx;
     genmult(Q, dx, tmpvec, 1., 1.);
+    if (matfree_state == 3)
+      sum_reuse++;
 
     //--- compute dz and do the line search 
     alpha = 1.;
@@ -288,6 +452,9 @@ namespace ConicBundle {
   // loop till convergence to optimal solution
 
   int UQPSolver::iterate() {
+    matfree_failed = false;
+    reuse_failed = false;
+    Qplus_factored = false;
     //std::cout<<" norm2(A*x-b)="<<norm2(A*x-b);          //TEST
     //std::cout<<" norm2(Q*x-c+transpose(A)*y-z)="<<norm2(Q*x-c+transpose(A)*y-z)<<std::endl; //TEST
     //cout<<"Q=";Q.display(std::cout);
@@ -363,6 +530,7 @@ namespace ConicBundle {
 
       iter++;
       sum_iter++;
+      CH_Tools::TimerRegistry::add_count("iterations");
 
       //--- find the step direction
       sum_choliter++;
@@ -494,6 +662,7 @@ namespace ConicBundle {
   // call starting_point and loop till convergence to optimal solution
 
   int UQPSolver::solve(const Symmatrix& Qin, const Matrix& cin, Real offsetin) {
+    CH_Tools::ScopedTimer scoped_timer("UQPSolver::solve");
     Q = Qin;
     c = cin;
     offset = offsetin;
@@ -639,6 +808,9 @@ namespace ConicBundle {
   std::ostream& UQPSolver::print_statistics(std::ostream& out) const {
     out << " qpit " << sum_iter;
     out << " qpcit " << sum_choliter << " qpctime " << sum_choltime;
+    out << " qpcgit " << sum_cgiter;
+    if (reuse_factor)
+      out << " qpfact " << sum_factor << " qpreuse " << sum_reuse;
     out << " QPScoeff " << QPcoeff_time;
     out << " QPSsolve " << QPsolve_time << "\n";
 
@@ -656,6 +828,7 @@ namespace ConicBundle {
     QPSolverProxObject* inHp,
     const MinorantPointer& in_gs_aggr,
     Indexmatrix* yfixed) {
+    CH_Tools::ScopedTimer scoped_timer("UQPSolver::QPsolve");
     assert(get_model_data_ptr() != 0);
 
     Hp = dynamic_cast<BundleProxObject*>(inHp);
@@ -763,6 +936,7 @@ namespace ConicBundle {
     Indexmatrix* yfixed,
     const MinorantPointer& delta_gs_subg,
     const Indexmatrix& delta_index) {
+    CH_Tools::ScopedTimer scoped_timer("UQPSolver::QPupdate");
     assert(get_model_data_ptr() != 0);
     assert(Hp);
 
@@ -936,6 +1110,7 @@ namespace ConicBundle {
   int UQPSolver::QPresolve(Real lower_bound,
     Real upper_bound,
     Real relprec) {
+    CH_Tools::ScopedTimer scoped_timer("UQPSolver::QPresolve");
     set_termbounds(lower_bound, upper_bound);
     set_termeps(relprec);
     CH_Tools::Microseconds solve_start = clock.time();
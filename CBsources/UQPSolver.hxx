@@ -37,6 +37,7 @@
 #include "UQPModelBlock.hxx"
 #include "clock.hxx"
 #include "Groundset.hxx"
+#include "pcg.hxx"
 
 namespace ConicBundle {
 
@@ -158,7 +159,7 @@ namespace ConicBundle {
 
    */
 
-  class UQPSolver : public virtual UQPModelPointer, public virtual QPSolverObject {
+  class UQPSolver : public virtual UQPModelPointer, public virtual QPSolverObject, public CH_Matrix_Classes::IterativeSystemObject {
   private:
     /// the current/latest prox term, mainly needed for computing the QP cost matrices and possibly for delivering the solution later in QPget_solution
     BundleProxObject* Hp;
@@ -180,6 +181,11 @@ namespace ConicBundle {
     CH_Matrix_Classes::Real upperbound; ///< upper bound on the final objective value
     CH_Matrix_Classes::Real termeps;   ///< termination precision
     CH_Matrix_Classes::Integer maxiter; ///< upper limit on the number of interior poitn iterations (none if <0)
+    CH_Matrix_Classes::Integer matfree_order; ///< if a positive semidefinite block has at least this order, the system is solved matrix free (never if <=0)
+    CH_Matrix_Classes::Real matfree_relprec; ///< relative residual precision of the matrix free solves
+    bool reuse_factor; ///< if true, the factorization of an earlier step serves as preconditioner in later steps, see set_reuse_factor()
+    CH_Matrix_Classes::Integer reuse_maxit; ///< conjugate gradient iterations allowed per solve with the factorization of an earlier step before refactorizing
+    CH_Matrix_Classes::Real reuse_relprec; ///< relative residual precision of the solves with the factorization of an earlier step
 
     //--- global variables
     CH_Matrix_Classes::Matrix x;         ///< current model x as one joint vector
@@ -197,12 +203,22 @@ namespace ConicBundle {
     bool run_starting_point;         ///< in restarting go back to the starting point
 
     CH_Matrix_Classes::Integer iter;     ///< counts number o iterations
-    CH_Matrix_Classes::Integer status;   ///< termination status of last call to solve or update
+    int status;                          ///< termination status of last call to solve or update
 
     //--- temporary variables, global only for memory managment purposes
     CH_Matrix_Classes::Symmatrix Qplus;   ///< L*L^T factorization of Q+blockdiag
     CH_Matrix_Classes::Matrix LinvAt;     ///< =L^-1*A^T
     CH_Matrix_Classes::Symmatrix sysdy;   ///< system matrix for dy
+    CH_Matrix_Classes::Indexmatrix piv;   ///< pivoting permutation of the Cholesky factorization of sysdy
+    int matfree_state;  ///< 0 if Qplus holds the factorization, 1 if the system is solved matrix free, 2 if Qplus holds the factorization after the matrix free solve failed, 3 if the system is solved by conjugate gradients preconditioned with the factorization of an earlier step in Qplus
+    bool Qplus_factored; ///< true if Qplus holds a factorization computed in the current call to iterate()
+    bool matfree_failed; ///< true if a matrix free solve failed during the current call to iterate()
+    bool reuse_failed; ///< true if a solve with the factorization of an earlier step failed during the current call to iterate(), then all further steps are factorized
+    CH_Matrix_Classes::Matrix sysdiag;    ///< diagonal of Q+blockdiag, used as preconditioner in the matrix free solve
+    const CH_Matrix_Classes::Matrix* sysrhs; ///< right hand side of the current matrix free solve
+    CH_Matrix_Classes::Matrix cgsol;      ///< solution of the current matrix free solve
+    CH_Matrix_Classes::Matrix tmpmat;     ///< temporary matrix for reducing reallocations
+    CH_Matrix_Classes::PCG pcg;           ///< the conjugate gradient solver for the matrix free solve
     CH_Matrix_Classes::Matrix rd;         ///< dual slack rd=c-Qx-At*y (=-z if feasible)
     CH_Matrix_Classes::Matrix xcorr;      ///< correction value for x
     mutable CH_Matrix_Classes::Matrix tmpvec;  ///< temporary vector for reducing reallocations      
@@ -213,6 +229,9 @@ namespace ConicBundle {
     //--- statistics
     CH_Matrix_Classes::Integer sum_iter;    ///< sum over all interior point iterations
     CH_Matrix_Classes::Integer sum_choliter; ///< sum over Cholesky facotrizations 
+    CH_Matrix_Classes::Integer sum_cgiter; ///< sum over the iterations of matrix free solves
+    CH_Matrix_Classes::Integer sum_factor; ///< sum over the factorizations of Qplus
+    CH_Matrix_Classes::Integer sum_reuse; ///< sum over the steps solved with the factorization of an earlier step
     CH_Tools::Clock clock; ///< for timing
     CH_Tools::Microseconds sum_choltime;  ///< sum of time spent in Cholesky
     CH_Tools::Microseconds QPcoeff_time;  ///< time spent in computing the QP coefficients
@@ -224,6 +243,8 @@ namespace ConicBundle {
     void select_new_mu(const CH_Matrix_Classes::Matrix& dx,
       const CH_Matrix_Classes::Matrix& dy,
       const CH_Matrix_Classes::Matrix& rhs_residual);
+    /// sets v=(Q+blockdiag)^{-1}*v by the Cholesky factorization or the matrix free solve (depending on matfree_state)
+    int solve_system(CH_Matrix_Classes::Matrix& v);
     /// carry out a predictor corrector step 
     int predcorr_step(CH_Matrix_Classes::Real& alpha);
     /// calls predcorr_step interatively until termination
@@ -277,12 +298,58 @@ namespace ConicBundle {
       maxiter = mi;
     }
 
+    /** @brief positive semidefinite blocks of at least this order switch to the matrix free solution of the system (<=0 for never)
+
+        For large positive semidefinite blocks forming and factorizing
+        Q+(Xinv skron Z) costs O(order^6). Instead, the system may be
+        solved by a preconditioned conjugate gradient method that
+        multiplies by (Xinv skron Z) via svec(Xinv*V*Z+Z*V*Xinv)/2. If
+        the conjugate gradient method does not reach the precision
+        within a number of iterations comparable in cost to the dense
+        factorization, the solver falls back to the dense factorization
+        for the rest of the current call.
+    */
+    void set_matfree_order(CH_Matrix_Classes::Integer order) {
+      matfree_order = order;
+    }
+    /// returns the order of positive semidefinite blocks from which on the system is solved matrix free, see set_matfree_order()
+    CH_Matrix_Classes::Integer get_matfree_order() const {
+      return matfree_order;
+    }
+
+    /** @brief if set to true (default false), later interior point steps solve with the factorization of an earlier step as preconditioner
+
+        Towards the end of the interior point method the system
+        Q+(Xinv kron Z) changes only a little from step to step. Instead
+        of forming and factorizing it anew, the system is then solved by
+        conjugate gradients preconditioned with the latest factorization.
+        If these do not reach the relative residual precision @a relprec
+        within @a maxit iterations, the current system is factorized and
+        this factorization is used from then on. The interior point
+        method tolerates the inexact steps, so @a relprec may be much
+        looser than the precision of the matrix free solves. The number
+        of steps solved this way is reported in print_statistics().
+    */
+    void set_reuse_factor(bool reuse, CH_Matrix_Classes::Integer maxit = 5, CH_Matrix_Classes::Real relprec = 1e-6) {
+      reuse_factor = reuse;
+      reuse_maxit = (maxit < 1) ? 1 : maxit;
+      reuse_relprec = (relprec <= 0.) ? 1e-6 : relprec;
+    }
+    /// returns the relative residual precision of solves with the factorization of an earlier step, see set_reuse_factor()
+    CH_Matrix_Classes::Real get_reuse_relprec() const {
+      return reuse_relprec;
+    }
+    /// returns true if the factorization of earlier steps may be reused, see set_reuse_factor()
+    bool get_reuse_factor() const {
+      return reuse_factor;
+    }
+
     /// return the number of iterations of the last solve
     CH_Matrix_Classes::Integer get_iter() const {
       return iter;
     }
     /// return the status of the last solve
-    CH_Matrix_Classes::Integer get_status() const {
+    int get_status() const {
       return status;
     }
     /// return the termination precision
@@ -339,6 +406,17 @@ namespace ConicBundle {
     ///output some statistical information on performance
     std::ostream& print_statistics(std::ostream& out) const;
 
+    /// for the matrix free solve: returns the right hand side
+    const CH_Matrix_Classes::Matrix& ItSys_rhs() {
+      return *sysrhs;
+    }
+
+    /// for the matrix free solve: returns out_vec=(Q+blockdiag)*in_vec
+    int ItSys_mult(const CH_Matrix_Classes::Matrix& in_vec, CH_Matrix_Classes::Matrix& out_vec);
+
+    /// for the matrix free solve: divides vec by the diagonal of Q+blockdiag
+    int ItSys_precondM1(CH_Matrix_Classes::Matrix& vec);
+
     ///save the current settings and values
     std::ostream& save(std::ostream& out) const;
 
@@ -459,6 +537,14 @@ namespace ConicBundle {
       return print_statistics(out);
     }
 
+    /// time for computing the coefficients and solving plus the interior point iterations, both summed over all calls
+    int QPget_accumulated_work(CH_Tools::Microseconds& time,
+      CH_Matrix_Classes::Integer& iterations) const {
+      time = QPcoeff_time + QPsolve_time;
+      iterations = sum_iter;
+      return 0;
+    }
+
 
   };
 
@@ -167,6 +167,30 @@ namespace ConicBundle {
     return retval;
   }
 
+  Integer UQPSumModelBlock::max_psc_order() const {
+    Integer order = 0;
+    for (unsigned int i = 0; i < blocks.size(); i++) {
+      order = max(order, blocks[i]->max_psc_order());
+    }
+    return order;
+  }
+
+  int UQPSumModelBlock::prepare_xinv_kron_z(Matrix& diagQ) {
+    int retval = 0;
+    for (unsigned int i = 0; i < blocks.size(); i++) {
+      retval |= blocks[i]->prepare_xinv_kron_z(diagQ);
+    }
+    return retval;
+  }
+
+  int UQPSumModelBlock::add_xinv_kron_z_times(Matrix& qp_out, const Matrix& qp_vec) {
+    int retval = 0;
+    for (unsigned int i = 0; i < blocks.size(); i++) {
+      retval |= blocks[i]->add_xinv_kron_z_times(qp_out, qp_vec);
+    }
+    return retval;
+  }
+
 
   int UQPSumModelBlock::add_local_sys(Symmatrix& sysdy, Matrix& rhs) {
     int retval = 0;
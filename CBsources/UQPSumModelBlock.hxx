@@ -128,6 +128,16 @@ namespace ConicBundle {
     /// add this for all subblocks
     int add_xinv_kron_z(CH_Matrix_Classes::Symmatrix& barQ);
 
+    /// returns the maximum order of the positive semidefinite blocks (0 if there are none)
+    CH_Matrix_Classes::Integer max_psc_order() const;
+
+    /// prepares add_xinv_kron_z_times() and adds the diagonal of the system term of add_xinv_kron_z() to @a diagQ, see UQPModelBlockObject::prepare_xinv_kron_z()
+    int prepare_xinv_kron_z(CH_Matrix_Classes::Matrix& diagQ);
+
+    /// adds the product of the system term of add_xinv_kron_z() with @a qp_vec to @a qp_out, see UQPModelBlockObject::add_xinv_kron_z_times()
+    int add_xinv_kron_z_times(CH_Matrix_Classes::Matrix& qp_out,
+      const CH_Matrix_Classes::Matrix& qp_vec);
+
 
     /// add this for all subblocks
     int add_local_sys(CH_Matrix_Classes::Symmatrix& sysdy, CH_Matrix_Classes::Matrix& rhs);
@@ -186,7 +186,7 @@ namespace ConicBundle {
       return 0;
     int err = 0;
     dim = mdf.new_vardim();
-    yfixed.init(dim, 1, 0);
+    yfixed.init(dim, 1, Integer(0));
     groundset_id++;
     if (gs_aggregate.apply_modification(mdf, groundset_id, 0, true)) {
       if (cb_out())
@@ -205,7 +205,7 @@ namespace ConicBundle {
     //   err++;
     // }
 
-    int dummy = -1;
+    Integer dummy = -1;
     if (!is_feasible(dummy, starting_point)) {
       if (cb_out())
         get_out() << "**** WARNING: UnconstrainedGroundset::apply_modification(.): starting point is not feasible (but this is allowed)" << std::endl;
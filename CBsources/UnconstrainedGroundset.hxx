@@ -185,7 +185,7 @@ namespace ConicBundle {
 
     /// stores the a new starting point irrespective of whether it is feasible or not and returns 0 if it feasible, 1 if it is infeasible
     virtual int set_starting_point(const CH_Matrix_Classes::Matrix& vec) {
-      starting_point = vec; int dummy = -1; return (is_feasible(dummy, vec) == false);
+      starting_point = vec; CH_Matrix_Classes::Integer dummy = -1; return (is_feasible(dummy, vec) == false);
     }
 
     /** @brief for a given model aggregate compute the groundset aggregate and the resulting (feasible) candidate
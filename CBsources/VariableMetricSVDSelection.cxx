@@ -24,12 +24,127 @@
 
 
 #include "VariableMetricSVDSelection.hxx"
+#include "timer_registry.hxx"
 
 using namespace CH_Matrix_Classes;
 
 namespace ConicBundle {
 
 
+  //*****************************************************************************
+  //                    VariableMetricSVDSelection::orthonormalize
+  //*****************************************************************************
+
+  void VariableMetricSVDSelection::orthonormalize(Matrix& A) {
+    Integer r = A.QR_factor(svd_piv);
+    svd_test.init_diag(r, 1.);
+    svd_test.enlarge_below(A.rowdim() - r, 0.);
+    A.Q_times(svd_test, r);
+    swap(A, svd_test);
+  }
+
+  //*****************************************************************************
+  //                    VariableMetricSVDSelection::leading_SVD
+  //*****************************************************************************
+
+  int VariableMetricSVDSelection::leading_SVD(Matrix& P,
+    Matrix& lamsqu,
+    const Matrix& M,
+    Real relbound,
+    Real minnorm,
+    Matrix* MtP) {
+    CH_Tools::ScopedTimer timer("VariableMetricSVDSelection::leading_SVD");
+
+    Integer dim = M.rowdim();
+    Integer k = M.coldim();
+    Integer l = svd_rank + svd_oversampling;
+    bool randomized = ((svd_rank > 0) && (l < k));
+    int retval = 0;
+
+    if (!randomized) {
+      //exact via transpose(M)*M=Q*Sigma^2*transpose(Q)
+      rankadd(M, svd_gram, 1., 0., 1);
+    } else {
+      //randomized range finder for M, svd_range = orthonormal basis of the range
+      svd_B.rand_normal(k, l, 0., 1., 0);
+      genmult(M, svd_B, svd_range);
+      for (Integer i = 0; i < svd_power_iterations; i++) {
+        orthonormalize(svd_range);
+        genmult(M, svd_range, svd_B, 1., 0., 1);
+        orthonormalize(svd_B);
+        genmult(M, svd_B, svd_range);
+      }
+      orthonormalize(svd_range);
+      //M is approximated by svd_range*svd_B with svd_B=transpose(svd_range)*M
+      genmult(svd_range, M, svd_B, 1., 0., 1);
+      rankadd(svd_B, svd_gram, 1., 0.);
+    }
+
+    Real scale = 1.;
+    for (Integer i = 1; i < svd_gram.rowdim(); i++)
+      scale = max(scale, svd_gram(i, i));
+    svd_gram /= scale;
+
+    if (svd_gram.rowdim() == 0) {
+      lamsqu.init(0, 1, 0.);
+    } else {
+      retval = int(svd_gram.eig(svd_vecs, lamsqu, false));
+      if ((min(lamsqu) < -1e-6) || (retval)) {
+        if (cb_out())
+          get_out() << "**** WARNING: VariableMetricSVDSelection::leading_SVD(............): S.eig failed and returned " << retval << " (order=" << svd_gram.rowdim() << ") and min eigenvalue=" << min(lamsqu) << std::endl;
+      }
+      lamsqu *= scale;
+    }
+
+    if ((lamsqu.dim() == 0) || (norm2(lamsqu) < minnorm)) {
+      //"nothing left", no contribution here
+      P.init(dim, 0, 0.);
+      lamsqu.init(0, 1, 0.);
+      if (MtP)
+        MtP->init(k, 0, 0.);
+      svd_quality = 0.;
+      return retval;
+    }
+
+    Real lmaxbound = relbound * lamsqu(0);
+    Integer cnt = 1;
+    Integer maxdir = lamsqu.dim();
+    if (randomized)            //the oversampling directions are discarded
+      maxdir = min(maxdir, svd_rank);
+    while ((cnt < maxdir) && (lamsqu(cnt) > lmaxbound))
+      cnt++;
+    if (cnt < lamsqu.dim()) {
+      lamsqu.reduce_length(cnt);
+      svd_vecs.delete_cols(Range(cnt, svd_vecs.coldim() - 1));
+    }
+
+    if (!randomized) {
+      svd_test.init(lamsqu);
+      svd_test.sqrt();         // now svd_test == Sigma
+      if (MtP) {
+        *MtP = svd_vecs;
+        MtP->scale_cols(svd_test);  // transpose(M)*P = Q*Sigma
+      }
+      svd_test.inv();
+      svd_vecs.scale_cols(svd_test);  // now svd_vecs <- Q*Sigma^{-1} 
+      genmult(M, svd_vecs, P);  // P = M * Q*Sigma^{-1}
+    } else {
+      genmult(svd_range, svd_vecs, P);
+      if (MtP)
+        genmult(svd_B, svd_vecs, *MtP, 1., 0., 1);
+    }
+
+    Real frobsqu = mat_ip(dim * k, M.get_store());
+    svd_quality = (frobsqu > 0.) ? min(1., sum(lamsqu) / frobsqu) : 1.;
+
+    if (cb_out(2)) {
+      get_out() << " leading_SVD(" << (randomized ? "randomized" : "exact") << "): cols=" << k << " rank=" << lamsqu.dim() << " captured=" << svd_quality << std::endl;
+    }
+
+    return retval;
+  }
+
+
   //*****************************************************************************
   //                    VariableMetricSVDSelection::vecH_weighted_SVDs
   //*****************************************************************************
@@ -183,39 +298,9 @@ namespace ConicBundle {
       // std::cout<<"   "<<transpose(tmpmat);
 
       //compute the SVD and the model basis
-      rankadd(tmpmat, tmpsym, 1., 0., 1);
-
-      Real scale = 1.;
-      for (Integer j = 1; j < tmpsym.rowdim(); j++)
-        scale = max(scale, tmpsym(j, j));
-      tmpsym /= scale;
-
-      int retval = tmpsym.eig(lamvecs, lambda, false);
-      if ((min(lambda) < -1e-6) || (retval)) {
+      if (leading_SVD(modelbasis, lambda, tmpmat, 1e-3, max(1e-10, 1e-6 * std::sqrt(activenormsqr(i))))) {
         if (cb_out())
-          get_out() << "**** WARNING: VariableMetricSVDSelection::vecH_weighted_SVDs(............): S.eig failed for i=" << i << " and returned " << retval << " (order=" << tmpsym.rowdim() << ") and min eigenvalue=" << min(lambda) << std::endl;
-
-      }
-
-      lambda *= scale;
-      if (norm2(lambda) < max(1e-10, 1e-6 * std::sqrt(activenormsqr(i)))) {
-        //"nothing left" after orthogonalization, no contribution here
-        modelbasis.init(dim, 0, 0.);
-      } else {
-        Real lmaxbound = 1e-3 * lambda(0);
-        Integer cnt = 1;
-        Integer maxdir = lambda.dim();
-        while ((cnt < maxdir) && (lambda(cnt) > lmaxbound))
-          cnt++;
-        if (cnt < lambda.dim()) {
-          lambda.reduce_length(cnt);
-          lamvecs.delete_cols(Range(cnt, lamvecs.coldim() - 1));
-        }
-        lambda.sqrt();         // now lambda == Sigma
-        lambda.inv();
-        lamvecs.scale_cols(lambda);  //now modelbasis <- Q*Sigma^{-1} 
-
-        genmult(tmpmat, lamvecs, modelbasis);  // vecH <- P = V * Q*Sigma^{-1}
+          get_out() << "**** WARNING: VariableMetricSVDSelection::vecH_weighted_SVDs(............): leading_SVD failed for i=" << i << std::endl;
       }
 
       //find approximate diagonal weights
@@ -262,7 +347,7 @@ namespace ConicBundle {
     for (Integer i = 1; i < tmpsym.rowdim(); i++)
       scale = max(scale, tmpsym(i, i));
     tmpsym /= scale;
-    int retval = tmpsym.eig(lamvecs, lambda, false);
+    int retval = int(tmpsym.eig(lamvecs, lambda, false));
     if ((min(lambda) < -1e-6) || (retval)) {
       if (cb_out())
         get_out() << "**** WARNING: VariableMetricSVDSelection::vecH_weighted_SVDs(............): S.eig failed and returned " << retval << " (order=" << tmpsym.rowdim() << ") and min eigenvalue=" << min(lambda) << std::endl;
@@ -337,7 +422,7 @@ namespace ConicBundle {
     if (cb_out(2)) {
       get_out() << "\n wSVDs.dim=" << lambda.dim();
       if (lambda.dim() > 0)
-        get_out() << " max(lam0)=" << max(lambda) << " sum(lam0)=" << sum(lambda) << " avg(vecHSq)=" << sum(lambda) / lambda.dim();
+        get_out() << " max(lam0)=" << max(lambda) << " sum(lam0)=" << sum(lambda) << " avg(vecHSq)=" << sum(lambda) / Real(lambda.dim());
       //genmult(Vspace,vecH,tmpmat,1.,0.,1);
       //get_out()<<" orthogonality="<<norm2(tmpmat)<<std::endl;
 
@@ -421,43 +506,11 @@ namespace ConicBundle {
       }
 
       //determine main directions via SVD
-
-      rankadd(modelbasis, tmpsym, 1., 0., 1);
-
-      Real scale = 1.;
-      for (Integer i = 1; i < tmpsym.rowdim(); i++)
-        scale = max(scale, tmpsym(i, i));
-      tmpsym /= scale;
-
-      int retval = tmpsym.eig(tmpmat, lam, false);
-      if ((min(lam) < -1e-6) || (retval)) {
+      if (leading_SVD(tmpmat, lam, modelbasis, 1e-3, max(1e-10, 1e-6 * std::sqrt(aggregate.dual_norm_squared()) / function_factor))) {
         if (cb_out())
-          get_out() << "**** WARNING: VariableMetricSVDSelection::vecH_weighted_SVD(............): S.eig failed and returned " << retval << " (order=" << tmpsym.rowdim() << ") and min eigenvalue=" << min(lam) << std::endl;
-
-      }
-
-      lam *= scale;
-      if (norm2(lam) < max(1e-10, 1e-6 * std::sqrt(aggregate.dual_norm_squared()) / function_factor)) {
-        //"nothing left" after orthogonalization, no contribution here
-        modelbasis.init(dim, 0, 0.);
-      } else {
-        Real lmaxbound = 1e-3 * lam(0);
-        Integer cnt = 1;
-        Integer maxdir = lam.dim();
-        while ((cnt < maxdir) && (lam(cnt) > lmaxbound))
-          cnt++;
-        if (cnt < lam.dim()) {
-          lam.reduce_length(cnt);
-          tmpmat.delete_cols(Range(cnt, modelbasis.coldim() - 1));
-        }
-        lam.sqrt();         // now lam == Sigma
-        lam.inv();
-        tmpmat.scale_cols(lam);  //now modelbasis <- Q*Sigma^{-1} 
-
-        genmult(modelbasis, tmpmat, vecH);  // vecH <- P = V * Q*Sigma^{-1}
-        swap(modelbasis, vecH);
-        vecH.init(dim, 0, 0.);
+          get_out() << "**** WARNING: VariableMetricSVDSelection::vecH_weighted_SVD(............): leading_SVD failed" << std::endl;
       }
+      swap(modelbasis, tmpmat);
 
 
 
@@ -633,40 +686,15 @@ namespace ConicBundle {
       bundlediff.delete_cols(Range(bcnt, bundlediff.coldim() - 1));
       genmult(modelbasis, bundlediff, tmpmat, 1., 0., 1);
       genmult(modelbasis, tmpmat, bundlediff, -1., 1.);
-      rankadd(bundlediff, tmpsym, 1., 0., 1);
-      Real scale = 1.;
-      for (Integer i = 1; i < tmpsym.rowdim(); i++)
-        scale = max(scale, tmpsym(i, i));
-      tmpsym /= scale;
-      int retval = tmpsym.eig(tmpmat, lam, false);
-      if ((min(lam) < -1e-6) || (retval)) {
+      Matrix local_vecH;
+      if (leading_SVD(local_vecH, lam, bundlediff, relprec, max(1e-10, 1e-6 * aggrnorm))) {
         if (cb_out())
-          get_out() << "**** WARNING: VariableMetricSVDSelection::vecH_weighted_SVD(............): S.eig failed and returned " << retval << " (order=" << tmpsym.rowdim() << ") and min eigenvalue=" << min(lam) << std::endl;
-
+          get_out() << "**** WARNING: VariableMetricSVDSelection::vecH_weighted_SVD(............): leading_SVD failed" << std::endl;
       }
-      lam *= scale;
-      if (norm2(lam) < max(1e-10, 1e-6 * aggrnorm)) {
+      if (lam.rowdim() == 0) {
         //"nothing left" after orthogonalization, no contribution here
         continue;
       }
-      Real lmaxbound = relprec * lam(0);
-      //Real lmaxbound=1e-6*lam(0);
-      Integer cnt = 1;
-      Integer maxdir = lam.dim();
-      while ((cnt < maxdir) && (lam(cnt) > lmaxbound))
-        cnt++;
-      if (cnt < lam.dim()) {
-        lam.reduce_length(cnt);
-        tmpmat.delete_cols(Range(cnt, tmpmat.coldim() - 1));
-      }
-      if (lam.rowdim() == 0)
-        continue;
-      lam.sqrt();         // now lam == Sigma
-      lam.inv();
-      tmpmat.scale_cols(lam);  //now modelbasis <- Q*Sigma^{-1} 
-
-      Matrix local_vecH;
-      genmult(bundlediff, tmpmat, local_vecH);  // vecH <- P = V * Q*Sigma^{-1}
 
       genmult(local_vecH, bundlediff, tmpmat, 1., 0., 1);
       tmpmat %= tmpmat;
@@ -706,7 +734,7 @@ namespace ConicBundle {
     for (Integer i = 1; i < tmpsym.rowdim(); i++)
       scale = max(scale, tmpsym(i, i));
     tmpsym /= scale;
-    int retval = tmpsym.eig(tmpmat, lam, false);
+    int retval = int(tmpsym.eig(tmpmat, lam, false));
     if ((min(lam) < -1e-6) || (retval)) {
       if (cb_out())
         get_out() << "**** WARNING: VariableMetricSVDSelection::vecH_orthogonal_to_model(............): S.eig failed and returned " << retval << " (order=" << tmpsym.rowdim() << ") and min eigenvalue=" << min(lam) << std::endl;
@@ -786,7 +814,7 @@ namespace ConicBundle {
     if (cb_out(2)) {
       get_out() << "\n orthlam0.dim=" << lam.dim();
       if (lam.dim() > 0)
-        get_out() << " max(lam0)=" << max(lam) << " sum(lam0)=" << sum(lam) << " avg(vecHSq)=" << sum(lam) / lam.dim();
+        get_out() << " max(lam0)=" << max(lam) << " sum(lam0)=" << sum(lam) << " avg(vecHSq)=" << sum(lam) / Real(lam.dim());
       //genmult(Vspace,vecH,tmpmat,1.,0.,1);
       //get_out()<<" orthogonality="<<norm2(tmpmat)<<std::endl;
 
@@ -863,43 +891,11 @@ namespace ConicBundle {
       }
 
       //determine main directions via SVD
-
-      rankadd(modelbasis, tmpsym, 1., 0., 1);
-
-      Real scale = 1.;
-      for (Integer i = 1; i < tmpsym.rowdim(); i++)
-        scale = max(scale, tmpsym(i, i));
-      tmpsym /= scale;
-
-      int retval = tmpsym.eig(tmpmat, lam, false);
-      if ((min(lam) < -1e-6) || (retval)) {
+      if (leading_SVD(tmpmat, lam, modelbasis, 1e-6, max(1e-10, 1e-6 * std::sqrt(aggregate.dual_norm_squared()) / function_factor))) {
         if (cb_out())
-          get_out() << "**** WARNING: VariableMetricSVDSelection::vecH_orthogonal_to_modelSVD(............): S.eig failed and returned " << retval << " (order=" << tmpsym.rowdim() << ") and min eigenvalue=" << min(lam) << std::endl;
-
-      }
-
-      lam *= scale;
-      if (norm2(lam) < max(1e-10, 1e-6 * std::sqrt(aggregate.dual_norm_squared()) / function_factor)) {
-        //"nothing left" after orthogonalization, no contribution here
-        modelbasis.init(dim, 0, 0.);
-      } else {
-        Real lmaxbound = 1e-6 * lam(0);
-        Integer cnt = 1;
-        Integer maxdir = lam.dim();
-        while ((cnt < maxdir) && (lam(cnt) > lmaxbound))
-          cnt++;
-        if (cnt < lam.dim()) {
-          lam.reduce_length(cnt);
-          tmpmat.delete_cols(Range(cnt, modelbasis.coldim() - 1));
-        }
-        lam.sqrt();         // now lam == Sigma
-        lam.inv();
-        tmpmat.scale_cols(lam);  //now modelbasis <- Q*Sigma^{-1} 
-
-        genmult(modelbasis, tmpmat, vecH);  // vecH <- P = V * Q*Sigma^{-1}
-        swap(modelbasis, vecH);
-        vecH.init(dim, 0, 0.);
+          get_out() << "**** WARNING: VariableMetricSVDSelection::vecH_orthogonal_to_modelSVD(............): leading_SVD failed" << std::endl;
       }
+      swap(modelbasis, tmpmat);
 
 
 
@@ -951,48 +947,16 @@ namespace ConicBundle {
 
     //std::cout<<" maxabsQ="<<max(abs(bundlediff));
 
-    rankadd(bundlediff, tmpsym, 1., 0., 1);
-
-
-    //std::cout<<" norm2(tmpsym-transpose(tmpmat)*tmpmat)="<<norm2(tmpsym-transpose(tmpmat)*tmpmat)<<std::endl;
-
-    Real scale = 1.;
-    for (Integer i = 1; i < tmpsym.rowdim(); i++)
-      scale = max(scale, tmpsym(i, i));
-    tmpsym /= scale;
-
-    int retval = tmpsym.eig(tmpmat, lam, false);
-
-    //std::cout<<" norm2(tmpsym-tmpmat*Diag(lam)*transpose(tmpmat))="<<norm2(tmpsym-tmpmat*Diag(lam)*transpose(tmpmat))<<std::endl;
-
-    if ((min(lam) < -1e-6) || (retval)) {
+    if (leading_SVD(vecH, lam, bundlediff, relprec, max(1e-10, 1e-6 * std::sqrt(aggregate.dual_norm_squared()) / function_factor))) {
       if (cb_out())
-        get_out() << "**** WARNING: VariableMetricSVDSelection::vecH_orthogonal_to_modelSVD(............): S.eig failed and returned " << retval << " (order=" << tmpsym.rowdim() << ") and min eigenvalue=" << min(lam) << std::endl;
-
+        get_out() << "**** WARNING: VariableMetricSVDSelection::vecH_orthogonal_to_modelSVD(............): leading_SVD failed" << std::endl;
     }
-    lam *= scale;
-    if (norm2(lam) < max(1e-10, 1e-6 * std::sqrt(aggregate.dual_norm_squared()) / function_factor)) {
+    if (lam.dim() == 0) {
       //"nothing left" after orthogonalization, no contribution here
-      vecH.init(dim, 0, 0.);
       Uspace = vecH;
       lambda.init(0, 1, 0.);
       return 0;
     }
-    Real lmaxbound = relprec * lam(0);
-    //Real lmaxbound=1e-6*lam(0);
-    Integer cnt = 1;
-    Integer maxdir = lam.dim();
-    while ((cnt < maxdir) && (lam(cnt) > lmaxbound))
-      cnt++;
-    if (cnt < lam.dim()) {
-      lam.reduce_length(cnt);
-      tmpmat.delete_cols(Range(cnt, tmpmat.coldim() - 1));
-    }
-    lam.sqrt();         // now lam == Sigma
-    lam.inv();
-    tmpmat.scale_cols(lam);  //now modelbasis <- Q*Sigma^{-1} 
-
-    genmult(bundlediff, tmpmat, vecH);  // vecH <- P = V * Q*Sigma^{-1}
 
 
     //---- compute the eigenvalue approximations
@@ -1048,7 +1012,7 @@ namespace ConicBundle {
       if (cb_out(2)) {
         get_out() << "\n orthlam0.dim=" << lam.dim();
         if (lam.dim() > 0)
-          get_out() << " max(lam0)=" << max(lam) << " sum(lam0)=" << sum(lam) << " avg(vecHSq)=" << sum(lam) / lam.dim();
+          get_out() << " max(lam0)=" << max(lam) << " sum(lam0)=" << sum(lam) << " avg(vecHSq)=" << sum(lam) / Real(lam.dim());
         genmult(Vspace, vecH, tmpmat, 1., 0., 1);
         get_out() << " orthogonality=" << norm2(tmpmat) << std::endl;
 
@@ -1185,48 +1149,15 @@ namespace ConicBundle {
 
     //std::cout<<" maxabsQ="<<max(abs(bundlediff));
 
-    Symmatrix tmpsym;
-    rankadd(tmpmat, tmpsym, 1., 0., 1);
-
-
-    //std::cout<<" norm2(tmpsym-transpose(tmpmat)*tmpmat)="<<norm2(tmpsym-transpose(tmpmat)*tmpmat)<<std::endl;
-
-    Real scale = 1.;
-    for (Integer i = 1; i < tmpsym.rowdim(); i++)
-      scale = max(scale, tmpsym(i, i));
-    tmpsym /= scale;
-
     Matrix lam;
-    int retval = tmpsym.eig(modelbasis, lam, false);
-
-    //std::cout<<" norm2(tmpsym-tmpmat*Diag(lam)*transpose(tmpmat))="<<norm2(tmpsym-tmpmat*Diag(lam)*transpose(tmpmat))<<std::endl;
-
-    if ((min(lam) < -1e-6) || (retval)) {
+    if (leading_SVD(vecH, lam, tmpmat, relprec, max(1e-10, 1e-6 * std::sqrt(aggregate.dual_norm_squared()) / function_factor))) {
       if (cb_out())
-        get_out() << "**** WARNING: VariableMetricSVDSelection::vecH_orthogonal_to_model(............): S.eig failed and returned " << retval << " (order=" << tmpsym.rowdim() << ") and min eigenvalue=" << min(lam) << std::endl;
-
+        get_out() << "**** WARNING: VariableMetricSVDSelection::vecH_orthogonal_to_model(............): leading_SVD failed" << std::endl;
     }
-    lam *= scale;
-    if (norm2(lam) < max(1e-10, 1e-6 * std::sqrt(aggregate.dual_norm_squared()) / function_factor)) {
+    if (lam.dim() == 0) {
       //"nothing left" after orthogonalization, no contribution here
-      vecH.init(dim, 0, 0.);
       return 0;
     }
-    Real lmaxbound = relprec * lam(0);
-    //Real lmaxbound=1e-6*lam(0);
-    Integer cnt = 1;
-    Integer maxdir = lam.dim();
-    while ((cnt < maxdir) && (lam(cnt) > lmaxbound))
-      cnt++;
-    if (cnt < lam.dim()) {
-      lam.reduce_length(cnt);
-      modelbasis.delete_cols(Range(cnt, modelbasis.coldim() - 1));
-    }
-    lam.sqrt();         // now lam == Sigma
-    lam.inv();
-    modelbasis.scale_cols(lam);  //now modelbasis <- Q*Sigma^{-1} 
-
-    genmult(tmpmat, modelbasis, vecH);  // vecH <- P = V * Q*Sigma^{-1}
 
 
     //---- compute the eigenvalue approximations
@@ -1265,7 +1196,7 @@ namespace ConicBundle {
       if (cb_out(2)) {
         get_out() << "\n orthlam0.dim=" << lam.dim();
         if (lam.dim() > 0)
-          get_out() << " max(lam0)=" << max(lam) << " sum(lam0)=" << sum(lam) << " avg(vecHSq)=" << sum(lam) / lam.dim();
+          get_out() << " max(lam0)=" << max(lam) << " sum(lam0)=" << sum(lam) << " avg(vecHSq)=" << sum(lam) / Real(lam.dim());
         genmult(Vspace, vecH, tmpmat, 1., 0., 1);
         get_out() << " orthogonality=" << norm2(tmpmat) << std::endl;
 
@@ -1419,7 +1350,7 @@ namespace ConicBundle {
     if (cb_out(2)) {
       get_out() << "\n bsz=" << bsz << " relprec=" << relprec << " mindiff=" << mindiff << " maxmult=" << maxmult << " tg=" << too_good << " tb=" << too_bad << " tc=" << too_close;
       if (diffvecs.coldim() > 0)
-        get_out() << " avg(norm)=" << sumnorm / diffvecs.coldim();
+        get_out() << " avg(norm)=" << sumnorm / Real(diffvecs.coldim());
     }
 
     //compute (approximate) SVD basis for the difference of minorants and aggr
@@ -1427,28 +1358,11 @@ namespace ConicBundle {
     Matrix barQ;  // mostly Q in singular value decomp. diffvecs = P*Sigma*Q'
     Matrix vecHsq;  //first Sigma, later eigenvalues of H= vecH*vecHsq*vecH'
     if (diffvecs.coldim() > 0) {
-      Symmatrix S;
-      rankadd(diffvecs, S, 1., 0., 1);
-
-      int retval = S.eig(barQ, vecHsq, false);
-      if ((min(vecHsq) < -1e-6) || (retval)) {
+      // vecH <- P, vecHsq <- Sigma^2, barQ <- Q*Sigma = diffvecs'*P
+      if (leading_SVD(vecH, vecHsq, diffvecs, relprec, 0., &barQ)) {
         if (cb_out())
-          get_out() << "**** WARNING: VariableMetricSVDSelection::add_variable_metric(...): S.eig failed and returned " << retval << " (order=" << S.rowdim() << ")" << std::endl;
-      }
-      Real lmaxbound = relprec * vecHsq(0);
-      Integer cnt = 1;
-      Integer maxdir = vecHsq.dim();//   min(vecHsq.dim(),20);
-      while ((cnt < maxdir) && (vecHsq(cnt) > lmaxbound))
-        cnt++;
-      if (cnt < vecHsq.dim()) {
-        vecHsq.reduce_length(cnt);
-        barQ.delete_cols(Range(cnt, barQ.coldim() - 1));
+          get_out() << "**** WARNING: VariableMetricSVDSelection::add_variable_metric(...): leading_SVD failed" << std::endl;
       }
-      vecHsq.sqrt();         // now VecHsq == Sigma
-      vecHsq.inv();
-      barQ.scale_cols(vecHsq);  //now barQ <- Q*Sigma^{-1} 
-
-      genmult(diffvecs, barQ, vecH);  // vecH <- P = V * Q*Sigma^{-1}
 
       //orthogonalize vecH, maybe not that important ...
       /*
@@ -1465,9 +1379,6 @@ namespace ConicBundle {
     if (vecH.coldim() > 0) {
 
       //compute (the square root of) the diagonal for this basis
-      vecHsq.inv();
-      vecHsq %= vecHsq;          //  Sigma^2
-      barQ.scale_cols(vecHsq); // barQ <- Q*Sigma = diffvecs'*P
       barQ.abs();
       vecHsq = maxrows(barQ);
 
@@ -1488,7 +1399,7 @@ namespace ConicBundle {
       if (cb_out(2)) {
         get_out() << "\n modellam0.dim=" << vecHsq.dim();
         if (vecHsq.dim() > 0)
-          get_out() << " max(lam0)=" << max(vecHsq) << " sum(lam0)=" << sum(vecHsq) << " avg(vecHSq)=" << sum(vecHsq) / vecHsq.dim();
+          get_out() << " max(lam0)=" << max(vecHsq) << " sum(lam0)=" << sum(vecHsq) << " avg(vecHSq)=" << sum(vecHsq) / Real(vecHsq.dim());
         get_out() << std::endl;
       }
     }
@@ -1588,7 +1499,7 @@ namespace ConicBundle {
     if (cb_out(2)) {
       get_out() << "\n bsz=" << bsz << " relprec=" << relprec << " mindiff=" << mindiff << " maxmult=" << maxmult << " tg=" << too_good << " tb=" << too_bad << " tc=" << too_close;
       if (multval.dim() > 0)
-        get_out() << " avg(sqrt(multval))=" << sum(multval) / multval.dim();
+        get_out() << " avg(sqrt(multval))=" << sum(multval) / Real(multval.dim());
     }
 
     //compute (approximate) SVD basis for the difference of minorants and aggr
@@ -1596,7 +1507,19 @@ namespace ConicBundle {
 
     Matrix vecHtdiff;
     Matrix vecHsq;
-    if (multval.dim() > 0) {
+    if ((svd_rank > 0) && (multval.dim() > svd_rank + svd_oversampling)) {
+      //the randomized SVD needs the scaled difference vectors explicitly
+      vecHtdiff.init(dim, multval.dim(), 0.);
+      Real dummy;
+      for (Integer i = 0; i < multval.dim(); i++) {
+        aggregate.get_minorant(dummy, vecHtdiff, i, multval(i) / function_factor, true);
+        bundle[unsigned(bundleind(i))].get_minorant(dummy, vecHtdiff, i, -multval(i), true);
+      }
+      if (leading_SVD(vecH, vecHsq, vecHtdiff, relprec, 0.)) {
+        if (cb_out())
+          get_out() << "**** WARNING: VariableMetricSVDSelection::add_variable_metric(...): leading_SVD failed" << std::endl;
+      }
+    } else if (multval.dim() > 0) {
 
       S.newsize(multval.dim()); chk_set_init(S, 1);
       for (Integer i = 0; i < S.rowdim(); i++) {
@@ -1609,7 +1532,7 @@ namespace ConicBundle {
         }
       }
 
-      int retval = S.eig(vecHtdiff, vecHsq, false);
+      int retval = int(S.eig(vecHtdiff, vecHsq, false));
       if ((min(vecHsq) < -1e-6) || (retval)) {
         if (cb_out())
           get_out() << "**** WARNING: VariableMetricSVDSelection::add_variable_metric(...): S.eig failed and returned " << retval << " (order=" << S.rowdim() << ")" << std::endl;
@@ -1623,6 +1546,8 @@ namespace ConicBundle {
         vecHsq.reduce_length(cnt);
         vecHtdiff.delete_cols(Range(cnt, vecHtdiff.coldim() - 1));
       }
+      Real frobsqu = trace(S);
+      svd_quality = (frobsqu > 0.) ? min(1., sum(vecHsq) / frobsqu) : 1.;
       vecHsq.sqrt();
       vecHsq.inv();
       vecHtdiff.scale_cols(vecHsq);
@@ -1708,7 +1633,7 @@ namespace ConicBundle {
       if (cb_out(2)) {
         get_out() << "\n aggrlam0.dim=" << vecHsq.dim();
         if (vecHsq.dim() > 0)
-          get_out() << " max(lam0)=" << max(vecHsq) << " sum(lam0)=" << sum(vecHsq) << " avg(vecHSq)=" << sum(vecHsq) / vecHsq.dim();
+          get_out() << " max(lam0)=" << max(vecHsq) << " sum(lam0)=" << sum(vecHsq) << " avg(vecHSq)=" << sum(vecHsq) / Real(vecHsq.dim());
         get_out() << std::endl;
       }
     }
@@ -1872,26 +1797,17 @@ namespace ConicBundle {
         vecH *= std::sqrt(1. - oldfactor);
         old_lowrankH *= std::sqrt(oldfactor);
         old_lowrankH.concat_right(vecH);
-        Symmatrix S;
-        rankadd(old_lowrankH, S, 1., 0., 1);
-        Matrix P, lam;
-        int retval = S.eig(P, lam, false);
-        if ((min(lam) < -1e-6) || (retval)) {
+        Matrix lam;
+        if (leading_SVD(vecH, lam, old_lowrankH, relprec, 0.)) {
           if (cb_out())
-            get_out() << "**** WARNING: VariableMetricSVDSelection::add_variable_metric(...): S.eig failed for average with previous lowrank representation and returned " << retval << " (order=" << S.rowdim() << ") and minimum eigenvalue = " << min(lam) << std::endl;
-        }
-        Real lmaxbound = relprec * lam(0);
-        Integer cnt = 1;
-        while ((cnt < lam.dim()) && (lam(cnt) > lmaxbound))
-          cnt++;
-        if (cnt < lam.dim()) {
-          lam.reduce_length(cnt);
-          P.delete_cols(Range(cnt, P.coldim() - 1));
+            get_out() << "**** WARNING: VariableMetricSVDSelection::add_variable_metric(...): leading_SVD failed for average with previous lowrank representation" << std::endl;
         }
-        genmult(old_lowrankH, P, vecH);
+        Matrix sigma(lam);
+        sigma.sqrt();
+        vecH.scale_cols(sigma);
 
         if (cb_out(2)) {
-          get_out() << "\n lam1.dim=" << lam.dim() << " max(lam1)=" << max(lam) << " sum(lam1)=" << sum(lam) << " avg(lam1)=" << sum(lam) / lam.dim() << std::endl;
+          get_out() << "\n lam1.dim=" << lam.dim() << " max(lam1)=" << max(lam) << " sum(lam1)=" << sum(lam) << " avg(lam1)=" << sum(lam) / Real(lam.dim()) << std::endl;
         }
       }
 
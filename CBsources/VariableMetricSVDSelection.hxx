@@ -75,6 +75,54 @@ namespace ConicBundle {
     /// experimental candidate that results from an approximate Newton step computaiton based on Vspace, Uspace and lambda (only some routines compute this)
     CH_Matrix_Classes::Matrix candNewton;
 
+    /// if positive, leading_SVD() approximates the SVD of matrices with more than svd_rank+svd_oversampling columns by a randomized range finder of this target rank; if <=0 (default) the SVD is computed via the full eigenvalue decomposition of the Gram matrix
+    CH_Matrix_Classes::Integer svd_rank;
+
+    /// number of additional random directions used by the randomized range finder
+    CH_Matrix_Classes::Integer svd_oversampling;
+
+    /// number of power iterations of the randomized range finder
+    CH_Matrix_Classes::Integer svd_power_iterations;
+
+    /// fraction of the squared Frobenius norm of the matrix that is captured by the singular values returned in the last call to leading_SVD()
+    CH_Matrix_Classes::Real svd_quality;
+
+    //temporary variables of leading_SVD(), global only for memory management purposes
+    CH_Matrix_Classes::Symmatrix svd_gram;
+    CH_Matrix_Classes::Matrix svd_vecs;
+    CH_Matrix_Classes::Matrix svd_range;
+    CH_Matrix_Classes::Matrix svd_test;
+    CH_Matrix_Classes::Matrix svd_B;
+    CH_Matrix_Classes::Indexmatrix svd_piv;
+
+    /// replaces A by an orthonormal basis of its range (via a pivoted QR factorization)
+    void orthonormalize(CH_Matrix_Classes::Matrix& A);
+
+    /** @brief computes the leading left singular vectors P of M and the squares lamsqu of the corresponding singular values in nonincreasing order
+
+        Only the singular values with lamsqu(i)>relbound*lamsqu(0) are
+        kept (at least one). If the Euclidean norm of all lamsqu is below
+        minnorm, P and lamsqu are returned with no columns. If MtP is not
+        null, it is set to transpose(M)*P.
+
+        Depending on svd_rank the decomposition is exact (via the
+        eigenvalue decomposition of transpose(M)*M) or it is
+        approximated by a randomized range finder with
+        svd_power_iterations power iterations. Then the costs are
+        roughly (2*svd_power_iterations+2)*M.rowdim()*M.coldim()*(svd_rank+svd_oversampling)
+        instead of M.rowdim()*M.coldim()^2/2+M.coldim()^3. The
+        svd_oversampling additional directions only improve the
+        accuracy of the range, at most svd_rank of them are returned.
+
+        @return 0 on success, otherwise the value returned by the failing eigenvalue decomposition
+    */
+    int leading_SVD(CH_Matrix_Classes::Matrix& P,
+      CH_Matrix_Classes::Matrix& lamsqu,
+      const CH_Matrix_Classes::Matrix& M,
+      CH_Matrix_Classes::Real relbound,
+      CH_Matrix_Classes::Real minnorm,
+      CH_Matrix_Classes::Matrix* MtP = 0);
+
 
     /// scaling heuristic based on collected minorants relative to the aggregate alone 
     int vecH_by_aggregate(CH_Matrix_Classes::Matrix& vecH,
@@ -161,7 +209,11 @@ namespace ConicBundle {
       VariableMetricSelection(cb, cbincr),
       n_latest_minorants(50),
       selection_method(-1),
-      oldfactor(0.) {
+      oldfactor(0.),
+      svd_rank(0),
+      svd_oversampling(10),
+      svd_power_iterations(2),
+      svd_quality(0.) {
     }
 
     ///  constructor for specifying values for n_latest_minorants and selection_method
@@ -172,7 +224,11 @@ namespace ConicBundle {
       VariableMetricSelection(cb, cbincr),
       n_latest_minorants(in_n_latest_minorants),
       selection_method(in_selection_method),
-      oldfactor(in_oldfactor) {
+      oldfactor(in_oldfactor),
+      svd_rank(0),
+      svd_oversampling(10),
+      svd_power_iterations(2),
+      svd_quality(0.) {
     }
 
     ///for current ongoing experiments with variable metric routines
@@ -203,6 +259,44 @@ namespace ConicBundle {
       selection_method = sm;
     }
 
+    /** @brief switches between exact and randomized singular value decompositions of the collected difference vectors
+
+        For rank>0 the leading singular vectors of matrices with more
+        than rank+oversampling columns are approximated by a randomized
+        range finder with a Gaussian test matrix of rank+oversampling
+        columns followed by power_iterations power iterations. This only
+        pays off if many minorants are stored (see set_n_latest_minorants())
+        and the metric may be restricted to a few leading directions.
+        For rank<=0 (default) the decomposition is exact.
+    */
+    void set_svd_rank(CH_Matrix_Classes::Integer rank,
+      CH_Matrix_Classes::Integer oversampling = 10,
+      CH_Matrix_Classes::Integer power_iterations = 2) {
+      svd_rank = rank;
+      svd_oversampling = (oversampling > 0) ? oversampling : 0;
+      svd_power_iterations = (power_iterations > 0) ? power_iterations : 0;
+    }
+
+    ///returns the target rank of the randomized SVD (<=0 if exact), see set_svd_rank()
+    CH_Matrix_Classes::Integer get_svd_rank() const {
+      return svd_rank;
+    }
+
+    ///returns the oversampling of the randomized SVD, see set_svd_rank()
+    CH_Matrix_Classes::Integer get_svd_oversampling() const {
+      return svd_oversampling;
+    }
+
+    ///returns the number of power iterations of the randomized SVD, see set_svd_rank()
+    CH_Matrix_Classes::Integer get_svd_power_iterations() const {
+      return svd_power_iterations;
+    }
+
+    ///returns the fraction of the squared Frobenius norm captured by the singular values of the last SVD (a measure for the quality of the low rank metric)
+    CH_Matrix_Classes::Real get_svd_quality() const {
+      return svd_quality;
+    }
+
     ///see ConicBundle::VariableMetricSelection::add_variable_metric()
     int add_variable_metric(VariableMetric& H,
       CH_Matrix_Classes::Integer y_id,
@@ -213,9 +307,11 @@ namespace ConicBundle {
       const CH_Matrix_Classes::Indexmatrix* indices,
       VariableMetricBundleData& bundle_data);
 
-    /// clone: the values are only preserved for those contained in the constructor: n_latest_minorants, selection_method and oldfactor
+    /// clone: the values are only preserved for those contained in the constructor: n_latest_minorants, selection_method and oldfactor, and for the parameters of set_svd_rank()
     VariableMetricSelection* clone_VariableMetricSelection() {
-      return new VariableMetricSVDSelection(n_latest_minorants, selection_method, oldfactor, this, 0);
+      VariableMetricSVDSelection* vms = new VariableMetricSVDSelection(n_latest_minorants, selection_method, oldfactor, this, 0);
+      vms->set_svd_rank(svd_rank, svd_oversampling, svd_power_iterations);
+      return vms;
     }
   };
 
@@ -316,7 +316,7 @@ namespace CH_Matrix_Classes {
             Real f = -c2 / a1;
             if (isnan(f)) {
               memarray->free(tmpp); tmpp = 0;
-              return -(i + 1);
+              return int(-(i + 1));
             }
             a1 = a2 + b1 * f;
             b1 = b2;
@@ -334,7 +334,7 @@ namespace CH_Matrix_Classes {
           Real f = -a1 / c2;
           if (isnan(f)) {
             memarray->free(tmpp); tmpp = 0;
-            return -(i + 1);
+            return int(-(i + 1));
           }
           a1 = b1 + f * a2;
           b1 = f * b2;
@@ -349,14 +349,14 @@ namespace CH_Matrix_Classes {
       if (a1 == 0.) {
         if (x1 != 0.) {
           memarray->free(tmpp); tmpp = 0;
-          return -nr;
+          return int(-nr);
         } else
           *xp = 0.;
       } else {
         *xp /= a1;
         if (isnan(*xp)) {
           memarray->free(tmpp); tmpp = 0;
-          return -nr;
+          return int(-nr);
         }
       }
       Real d2 = *xp;
@@ -367,14 +367,14 @@ namespace CH_Matrix_Classes {
       if (r == 0.) {
         if (*xp != 0.) {
           memarray->free(tmpp); tmpp = 0;
-          return -(nr - 1);
+          return int(-(nr - 1));
         } else
           *xp = 0.;
       } else {
         *xp /= r;
         if (isnan(*xp)) {
           memarray->free(tmpp); tmpp = 0;
-          return -(nr - 1);
+          return int(-(nr - 1));
         }
       }
       Real d1 = *xp;
@@ -387,14 +387,14 @@ namespace CH_Matrix_Classes {
         if (r == 0.) {
           if (d0 != 0.) {
             memarray->free(tmpp); tmpp = 0;
-            return -(i + 1);
+            return int(-(i + 1));
           } else
             d0 = 0.;
         } else {
           d0 /= r;
           if (isnan(d0)) {
             memarray->free(tmpp); tmpp = 0;
-            return -(i + 1);
+            return int(-(i + 1));
           }
         }
         *xp = d0;
@@ -0,0 +1,238 @@
+/* ****************************************************************************
+
+    Copyright (C) 2026  ConicBundle contributors
+
+    ConicBundle, Version 1.a.2
+    File:  Matrix/blockop.cxx
+    This file is part of ConciBundle, a C/C++ library for convex optimization.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+
+
+#include <algorithm>
+#include "mymath.hxx"
+#include "blockop.hxx"
+#include "matrix.hxx"
+
+
+
+namespace CH_Matrix_Classes {
+
+  // tile sizes: a block of op(A) of gemm_rowblk x gemm_depthblk doubles
+  // stays in the L2 cache while it is multiplied by gemm_colblk columns;
+  // the symmetric routines and the Cholesky factorization work on
+  // panels of sym_tile columns
+  static const Integer gemm_rowblk = 128;
+  static const Integer gemm_depthblk = 256;
+  static const Integer gemm_colblk = 512;
+  static const Integer sym_tile = 64;
+
+  // C+=alpha*A*B^T for a block that fits into the cache, where the
+  // columns of A (m x k) and B (n x k) are contiguous and short. The
+  // entries of C are accumulated over the full depth k in an 8x4 tile
+  // of registers; the loop over the eight consecutive rows of A is
+  // vectorized and each of its loads is used four times
+
+  static void gemm_kernel(Integer m, Integer n, Integer k, Real alpha,
+    const Real* A, const Real* B, Real* C, Integer ldc) {
+    Integer j = 0;
+    for (; j + 4 <= n; j += 4) {
+      Real* const c0 = C + j * ldc;
+      Real* const c1 = c0 + ldc;
+      Real* const c2 = c1 + ldc;
+      Real* const c3 = c2 + ldc;
+      Integer i = 0;
+      for (; i + 8 <= m; i += 8) {
+        const Real* ap = A + i;
+        const Real* bp = B + j;
+        Real s0[8] = { 0., 0., 0., 0., 0., 0., 0., 0. };
+        Real s1[8] = { 0., 0., 0., 0., 0., 0., 0., 0. };
+        Real s2[8] = { 0., 0., 0., 0., 0., 0., 0., 0. };
+        Real s3[8] = { 0., 0., 0., 0., 0., 0., 0., 0. };
+        for (Integer p = k; --p >= 0; ap += m, bp += n) {
+          const Real y0 = bp[0], y1 = bp[1], y2 = bp[2], y3 = bp[3];
+          for (int r = 0; r < 8; r++) {
+            s0[r] += ap[r] * y0;
+            s1[r] += ap[r] * y1;
+            s2[r] += ap[r] * y2;
+            s3[r] += ap[r] * y3;
+          }
+        }
+        for (int r = 0; r < 8; r++) {
+          c0[i + r] += alpha * s0[r];
+          c1[i + r] += alpha * s1[r];
+          c2[i + r] += alpha * s2[r];
+          c3[i + r] += alpha * s3[r];
+        }
+      }
+      for (; i < m; i++) {
+        const Real* ap = A + i;
+        const Real* bp = B + j;
+        Real s0 = 0., s1 = 0., s2 = 0., s3 = 0.;
+        for (Integer p = k; --p >= 0; ap += m, bp += n) {
+          const Real x = *ap;
+          s0 += x * bp[0]; s1 += x * bp[1]; s2 += x * bp[2]; s3 += x * bp[3];
+        }
+        c0[i] += alpha * s0; c1[i] += alpha * s1; c2[i] += alpha * s2; c3[i] += alpha * s3;
+      }
+    }
+    for (; j < n; j++) {
+      Real* const c0 = C + j * ldc;
+      for (Integer i = 0; i < m; i++) {
+        const Real* ap = A + i;
+        const Real* bp = B + j;
+        Real s = 0.;
+        for (Integer p = k; --p >= 0; ap += m, bp += n)
+          s += (*ap) * (*bp);
+        c0[i] += alpha * s;
+      }
+    }
+  }
+
+  // copies the m x k block X (or the transpose of the k x m block X if
+  // trans) into the column major buffer P with leading dimension m
+
+  static void pack_block(int trans, Integer m, Integer k, const Real* X, Integer ldx, Real* P) {
+    if (trans) {
+      for (Integer i = 0; i < m; i++, X += ldx)
+        mat_xey(k, P + i, m, X, 1);
+    } else {
+      for (Integer p = 0; p < k; p++, X += ldx, P += m)
+        mat_xey(m, P, X);
+    }
+  }
+
+  // the blocks of op(A) and op(B)^T are copied into buffers of the
+  // form required by gemm_kernel; the copy of op(A) is reused for
+  // gemm_colblk columns of C
+
+  void blk_gemm(int atrans, int btrans, Integer m, Integer n, Integer k, Real alpha,
+    const Real* A, Integer lda, const Real* B, Integer ldb, Real* C, Integer ldc) {
+    if ((m <= 0) || (n <= 0) || (k <= 0) || (alpha == 0.))
+      return;
+    Matrix apack(std::min(gemm_depthblk, k) * std::min(gemm_rowblk, m), 1);
+    Matrix bpack(std::min(gemm_depthblk, k) * std::min(gemm_colblk, n), 1);
+    for (Integer pp = 0; pp < k; pp += gemm_depthblk) {
+      const Integer kb = std::min(gemm_depthblk, k - pp);
+      for (Integer jj = 0; jj < n; jj += gemm_colblk) {
+        const Integer nb = std::min(gemm_colblk, n - jj);
+        pack_block(!btrans, nb, kb, (btrans ? B + jj + pp * ldb : B + pp + jj * ldb), ldb, bpack.get_store());
+        for (Integer ii = 0; ii < m; ii += gemm_rowblk) {
+          const Integer mb = std::min(gemm_rowblk, m - ii);
+          pack_block(atrans, mb, kb, (atrans ? A + pp + ii * lda : A + ii + pp * lda), lda, apack.get_store());
+          gemm_kernel(mb, nb, kb, alpha, apack.get_store(), bpack.get_store(), C + ii + jj * ldc, ldc);
+        }
+      }
+    }
+  }
+
+  // the diagonal tiles are computed in full into a local buffer so that
+  // the strict upper triangle of C is never touched
+
+  static void add_lower_tile(Integer nb, const Real* buf, Real* C, Integer ldc) {
+    for (Integer j = 0; j < nb; j++)
+      mat_xpey(nb - j, C + j * (ldc + 1), buf + j * (nb + 1));
+  }
+
+  void blk_syrk(int trans, Integer n, Integer k, Real alpha,
+    const Real* A, Integer lda, Real* C, Integer ldc) {
+    if ((n <= 0) || (k <= 0) || (alpha == 0.))
+      return;
+    Real buf[sym_tile * sym_tile];
+    for (Integer jj = 0; jj < n; jj += sym_tile) {
+      const Integer jb = std::min(sym_tile, n - jj);
+      const Integer mb = n - jj - jb;
+      // op(A) rows jj,...,jj+jb-1 and jj+jb,...,n-1
+      const Real* const aj = trans ? A + jj * lda : A + jj;
+      const Real* const ai = trans ? A + (jj + jb) * lda : A + jj + jb;
+      mat_xea(jb * jb, buf, 0.);
+      blk_gemm(trans, !trans, jb, jb, k, alpha, aj, lda, aj, lda, buf, jb);
+      add_lower_tile(jb, buf, C + jj * (ldc + 1), ldc);
+      blk_gemm(trans, !trans, mb, jb, k, alpha, ai, lda, aj, lda, C + jj + jb + jj * ldc, ldc);
+    }
+  }
+
+  void blk_syr2k(int trans, Integer n, Integer k, Real alpha,
+    const Real* A, Integer lda, const Real* B, Integer ldb, Real* C, Integer ldc) {
+    if ((n <= 0) || (k <= 0) || (alpha == 0.))
+      return;
+    Real buf[sym_tile * sym_tile];
+    for (Integer jj = 0; jj < n; jj += sym_tile) {
+      const Integer jb = std::min(sym_tile, n - jj);
+      const Integer mb = n - jj - jb;
+      const Real* const aj = trans ? A + jj * lda : A + jj;
+      const Real* const ai = trans ? A + (jj + jb) * lda : A + jj + jb;
+      const Real* const bj = trans ? B + jj * ldb : B + jj;
+      const Real* const bi = trans ? B + (jj + jb) * ldb : B + jj + jb;
+      mat_xea(jb * jb, buf, 0.);
+      blk_gemm(trans, !trans, jb, jb, k, alpha, aj, lda, bj, ldb, buf, jb);
+      blk_gemm(trans, !trans, jb, jb, k, alpha, bj, ldb, aj, lda, buf, jb);
+      add_lower_tile(jb, buf, C + jj * (ldc + 1), ldc);
+      Real* const cp = C + jj + jb + jj * ldc;
+      blk_gemm(trans, !trans, mb, jb, k, alpha, ai, lda, bj, ldb, cp, ldc);
+      blk_gemm(trans, !trans, mb, jb, k, alpha, bi, ldb, aj, lda, cp, ldc);
+    }
+  }
+
+  // right looking block Cholesky: factor the diagonal tile column by
+  // column, solve for the panel below it and update the trailing
+  // lower triangle by the rank-sym_tile product of the panel
+
+  int blk_potrf(Integer n, Real* A, Integer lda, Real tol) {
+    for (Integer kk = 0; kk < n; kk += sym_tile) {
+      const Integer kb = std::min(sym_tile, n - kk);
+      Real* const akk = A + kk * (lda + 1);
+      for (Integer j = 0; j < kb; j++) {
+        Real* const cj = akk + j * (lda + 1);
+        if (*cj < tol)
+          return int(kk + j + 1);
+        const Real d = (*cj = ::sqrt(*cj));
+        for (Integer i = 1; i < kb - j; i++)
+          cj[i] /= d;
+        for (Integer l = j + 1; l < kb; l++) {
+          const Real f = cj[l - j];
+          if (f != 0.)
+            mat_xpeya(kb - l, akk + l * (lda + 1), cj + (l - j), -f);
+        }
+      }
+      const Integer mb = n - kk - kb;
+      if (mb == 0)
+        break;
+      Real* const panel = akk + kb;
+      // panel := panel * L_kk^{-T}, in row chunks that stay in cache
+      for (Integer ii = 0; ii < mb; ii += gemm_depthblk) {
+        const Integer ib = std::min(gemm_depthblk, mb - ii);
+        Real* const pp = panel + ii;
+        for (Integer j = 0; j < kb; j++) {
+          Real* const pj = pp + j * lda;
+          const Real* const lj = akk + j;
+          for (Integer l = 0; l < j; l++) {
+            const Real f = lj[l * lda];
+            if (f != 0.)
+              mat_xpeya(ib, pj, pp + l * lda, -f);
+          }
+          const Real d = lj[j * lda];
+          for (Integer i = 0; i < ib; i++)
+            pj[i] /= d;
+        }
+      }
+      blk_syrk(0, mb, kb, -1., panel, lda, panel + kb * lda, lda);
+    }
+    return 0;
+  }
+
+}
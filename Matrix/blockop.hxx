@@ -0,0 +1,94 @@
+/* ****************************************************************************
+
+    Copyright (C) 2026  ConicBundle contributors
+
+    ConicBundle, Version 1.a.2
+    File:  Matrix/blockop.hxx
+    This file is part of ConciBundle, a C/C++ library for convex optimization.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+
+
+#ifndef CH_MATRIX_CLASSES__BLOCKOP_HXX
+#define CH_MATRIX_CLASSES__BLOCKOP_HXX
+
+/**  @file blockop.hxx
+    @brief Header declaring cache blocked level 3 kernels on full column major arrays that are used by Symmatrix for large orders if no BLAS is linked
+    @version 1.0
+    @date 2026-10-18
+    @author ConicBundle contributors
+
+*/
+
+#include "matop.hxx"
+
+namespace CH_Matrix_Classes {
+
+  /**@defgroup blockop Cache blocked kernels (internal)
+
+     The packed lower triangle of Symmatrix is convenient for level 2
+     operations, but its columns have varying length and start at
+     varying offsets, which rules out the tiling needed for cache
+     reuse in level 3 operations. For large orders the routines
+     rankadd(), rank2add(), genmult() and Symmatrix::Chol_factor()
+     therefore copy the lower triangle into a full column major
+     array (see Symmatrix::store_lower() and Symmatrix::init_lower()),
+     run one of the kernels below on tiles that fit into the cache,
+     and copy the result back. Both copies are O(n^2) while the work
+     is O(n^2k) or O(n^3).
+
+     All arrays are column major with leading dimension ld*; for the
+     symmetric routines only the lower triangle including the diagonal
+     is read or written. With WITH_BLAS, rankadd(), rank2add() and
+     genmult() call the corresponding BLAS routines instead.
+  */
+  //@{
+
+  /// rankadd() and rank2add() with transposition and genmult() switch to the blocked kernels if the order is at least this
+  const Integer blockop_minorder = 96;
+  /// ... and if the rank of the update resp. the number of columns of the other factor is at least this
+  const Integer blockop_mindepth = 16;
+  /// the unblocked rankadd() and rank2add() without transposition and Symmatrix::Chol_factor() sweep along contiguous columns and switch only for orders of at least this
+  const Integer blockop_minorder_sweep = 256;
+  /// ... and, for the rank updates, if the rank is at least this
+  const Integer blockop_mindepth_sweep = 32;
+
+  /// C+=alpha*op(A)*op(B) with C of size m x n, op(A) m x k, op(B) k x n; op transposes if atrans/btrans is nonzero
+  void blk_gemm(int atrans, int btrans, Integer m, Integer n, Integer k, Real alpha,
+    const Real* A, Integer lda, const Real* B, Integer ldb, Real* C, Integer ldc);
+
+  /// lower triangle of C (n x n) += alpha*A*A^T for A n x k [or if trans alpha*A^T*A for A k x n]
+  void blk_syrk(int trans, Integer n, Integer k, Real alpha,
+    const Real* A, Integer lda, Real* C, Integer ldc);
+
+  /// lower triangle of C (n x n) += alpha*(A*B^T+B*A^T) for A,B n x k [or if trans alpha*(A^T*B+B^T*A) for A,B k x n]
+  void blk_syr2k(int trans, Integer n, Integer k, Real alpha,
+    const Real* A, Integer lda, const Real* B, Integer ldb, Real* C, Integer ldc);
+
+  /** @brief overwrites the lower triangle of A (n x n) by its Cholesky factor L with LL^T=A
+
+      Like Symmatrix::Chol_factor(Real) it returns 0 on success and
+      k+1 if the k-th pivot (counting from 0) falls below tol; the
+      columns before k hold the factor then.
+  */
+  int blk_potrf(Integer n, Real* A, Integer lda, Real tol);
+
+  //@}
+
+}
+
+#endif
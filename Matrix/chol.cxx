@@ -26,12 +26,49 @@
 #include <stdlib.h>
 #include "mymath.hxx"
 #include "symmat.hxx"
+#include "blockop.hxx"
 
 
 
 namespace CH_Matrix_Classes {
 
+  // for several right hand sides the factor is swept only once; column j
+  // of the packed lower triangle L (rows j,...,nr-1) is contiguous and
+  // stays in cache while it is applied to all columns of x
+
+  static void Chol_Lsolve_block(Integer nr, const Real* m, Real* x, Integer nc) {
+    for (Integer j = 0; j < nr; j++) {
+      const Real* lp = m + j * nr - (j * (j - 1)) / 2;
+      const Real d = *lp++;
+      Real* xbase = x + j;
+      for (Integer k = 0; k < nc; k++, xbase += nr) {
+        const Real f = (*xbase /= d);
+        if (f != 0.)
+          mat_xpeya(nr - j - 1, xbase + 1, lp, -f);
+      }
+    }
+  }
+
+  static void Chol_Ltsolve_block(Integer nr, const Real* m, Real* x, Integer nc) {
+    for (Integer i = nr; --i >= 0;) {
+      const Real* lp = m + i * nr - (i * (i - 1)) / 2;
+      const Real d = *lp++;
+      Real* xbase = x + i;
+      for (Integer k = 0; k < nc; k++, xbase += nr) {
+        *xbase = (*xbase - mat_ip(nr - i - 1, lp, xbase + 1)) / d;
+      }
+    }
+  }
+
   int Symmatrix::Chol_factor(Real tol) {
+    if (nr >= blockop_minorder_sweep) {
+      //blocked on a full copy of the lower triangle
+      Matrix tmp;
+      store_lower(tmp);
+      int status = blk_potrf(nr, tmp.get_store(), nr, tol);
+      init_lower(tmp);
+      return status;
+    }
     for (Integer k = 0; k < nr; k++) {
 
       //---- compute factorization
@@ -46,7 +83,7 @@ namespace CH_Matrix_Classes {
       */
       Real* mp2 = m + nr * k - ((k - 1) * k) / 2;
       if (*mp2 < tol)
-        return k + 1;
+        return int(k + 1);
       Real d = (*mp2 = ::sqrt(*mp2));
       mp2++;
       for (Integer i = nr - k; --i > 0;) {
@@ -95,6 +132,12 @@ namespace CH_Matrix_Classes {
   int Symmatrix::Chol_solve(Matrix& x) const {
     chk_mult(*this, x);
 
+    if (x.coldim() > 1) {
+      Chol_Lsolve_block(nr, m, x.m, x.coldim());
+      Chol_Ltsolve_block(nr, m, x.m, x.coldim());
+      return 0;
+    }
+
     for (Integer k = 0; k < x.coldim(); k++) { //solve for and overwrite column k of x
       Real* xbase = x.m + k * nr;
       //---- solve Lr=xbase
@@ -129,6 +172,10 @@ namespace CH_Matrix_Classes {
   int Symmatrix::Chol_Lsolve(Matrix& x) const {
     chk_mult(*this, x);
 
+    if (x.coldim() > 1) {
+      Chol_Lsolve_block(nr, m, x.m, x.coldim());
+      return 0;
+    }
 
     for (Integer k = 0; k < x.coldim(); k++) { //solve for and overwrite column k of x
       Real* xbase = x.m + k * nr;
@@ -152,6 +199,10 @@ namespace CH_Matrix_Classes {
   int Symmatrix::Chol_Ltsolve(Matrix& x) const {
     chk_mult(*this, x);
 
+    if (x.coldim() > 1) {
+      Chol_Ltsolve_block(nr, m, x.m, x.coldim());
+      return 0;
+    }
 
     for (Integer k = 0; k < x.coldim(); k++) { //solve for and overwrite column k of x
       Real* xbase = x.m + k * nr;
@@ -398,7 +398,9 @@ namespace CH_Matrix_Classes {
     Integer j, k;
     Integer* mp = m;
     for (j = 0; (j < nc); j++) {
-      mat_xey(ip[0], mp, m + j * nr);
+      //the leading rows of the first column stay in place
+      if (j > 0)
+        mat_xey(ip[0], mp, m + j * nr);
       mp += ip[0];
       for (k = 1; k < ind.dim(); k++) {
 #if (CONICBUNDLE_DEBUG>=1)
@@ -1494,12 +1496,8 @@ namespace CH_Matrix_Classes {
   }
 
   std::istream& operator>>(std::istream& in, Indexmatrix& A) {
-    Integer d;
     Integer nr, nc;
-    in >> d;
-    nr = Integer(d + .5);
-    in >> d;
-    nc = Integer(d + .5);
+    in >> nr >> nc;
     A.newsize(nr, nc);
     Integer i, j;
     for (i = 0; i < nr; i++)
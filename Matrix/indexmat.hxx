@@ -251,6 +251,9 @@ namespace CH_Matrix_Classes {
     /// copy constructor, *this=d*A
     inline Indexmatrix(const Indexmatrix& A, Integer d = 1);
 
+    /// move constructor, takes over the storage of A and leaves A as an empty 0x0 matrix
+    inline Indexmatrix(Indexmatrix&& A) noexcept;
+
     /// generate a column vector holding the indices of this #CH_Matrix_Classes::Range
     inline Indexmatrix(const Range&);
 
@@ -271,6 +274,14 @@ namespace CH_Matrix_Classes {
     /// copy a std::vector<#Integer> to a column vector of the same size and content
     inline Indexmatrix(const std::vector<Integer>& vec);
 
+#if (CONICBUNDLE_LONG_INDEX>=1)
+    /// generate a matrix of size nr x nc initializing the elements from the (one dimensional) int array dp with increment incr (only needed if #Integer is not int)
+    inline Indexmatrix(Integer nr, Integer nc, const int* dp, Integer incr = 1);
+
+    /// copy a std::vector<int> to a column vector of the same size and content (only needed if #Integer is not int)
+    inline Indexmatrix(const std::vector<int>& vec);
+#endif
+
     ///
     ~Indexmatrix() {
       memarray->free(m);
@@ -310,6 +321,14 @@ namespace CH_Matrix_Classes {
     /// use std::vector<#Integer> to initialize this to a column vector of the same size and content
     inline Indexmatrix& init(const std::vector<Integer>& vec);
 
+#if (CONICBUNDLE_LONG_INDEX>=1)
+    /// generate a matrix of size nr x nc initializing the elements from the (one dimensional) int array dp with increment incr (only needed if #Integer is not int)
+    inline Indexmatrix& init(Integer nr, Integer nc, const int* dp, Integer incr = 1);
+
+    /// use std::vector<int> to initialize this to a column vector of the same size and content (only needed if #Integer is not int)
+    inline Indexmatrix& init(const std::vector<int>& vec);
+#endif
+
     /** @brief resize the matrix to nr x nc elements but WITHOUT initializing the memory
 
         If initializing the memory externally and CONICBUNDLE_DEBUG is defined, please use
@@ -463,6 +482,12 @@ namespace CH_Matrix_Classes {
     Indexmatrix& enlarge_right(Integer addnc, const Integer* dp, Integer d = 1);
     /// enlarge the matrix by addnr>=0 rows intializing the new rows by the values pointed to by dp times d, returns *this 
     Indexmatrix& enlarge_below(Integer addnr, const Integer* dp, Integer d = 1);
+#if (CONICBUNDLE_LONG_INDEX>=1)
+    /// enlarge the matrix by addnr>=0 rows intializing the new rows by the int values pointed to by dp times d, returns *this (only needed if #Integer is not int)
+    Indexmatrix& enlarge_below(Integer addnr, const int* dp, Integer d = 1) {
+      return enlarge_below(addnr, Indexmatrix(addnr * nc, 1, dp).get_store(), d);
+    }
+#endif
 
 
     /// returns the current address of the internal value array; use cautiously, do not use delete!
@@ -544,6 +569,8 @@ namespace CH_Matrix_Classes {
 
      ///
     inline Indexmatrix& operator=(const Indexmatrix& A);
+    /// move assignment, exchanges the storage with A instead of copying (A is left in a valid but unspecified state)
+    inline Indexmatrix& operator=(Indexmatrix&& A) noexcept;
     ///
     inline Indexmatrix& operator*=(const Indexmatrix& s);
     ///
@@ -620,6 +647,8 @@ namespace CH_Matrix_Classes {
     /// interpret A as a vector and copy it to a std::vector<long> which is also returned 
     friend inline std::vector<long>& assign(std::vector<long>& vec,
       const Indexmatrix& A);
+    /// returns the values of A as an int array for the int interfaces of ConicBundle; this is A.get_store() if #Integer is int, otherwise the values are copied to buffer (the pointer stays valid until buffer or A change)
+    friend inline const int* int_store(const Indexmatrix& A, std::vector<int>& buffer);
 
     //@}
 
@@ -856,6 +885,22 @@ namespace CH_Matrix_Classes {
     return *this;
   }
 
+#if (CONICBUNDLE_LONG_INDEX>=1)
+  inline Indexmatrix& Indexmatrix::init(Integer inr, Integer inc, const int* d, Integer incr) {
+    newsize(inr, inc);
+    for (Integer i = 0; i < nr * nc; i++, d += incr)
+      m[i] = Integer(*d);
+    chk_set_init(*this, 1);
+    return *this;
+  }
+
+  inline Indexmatrix& Indexmatrix::init(const std::vector<int>& vec) {
+    newsize(Integer(vec.size()), 1); chk_set_init(*this, 1);
+    for (Integer i = 0; i < nr; i++) m[i] = Integer(vec[(unsigned long)(i)]);
+    return *this;
+  }
+#endif
+
   inline Indexmatrix::Indexmatrix() {
     init_to_zero();
   }
@@ -865,6 +910,11 @@ namespace CH_Matrix_Classes {
     xeya(A, d);
   }
 
+  inline Indexmatrix::Indexmatrix(Indexmatrix&& A) noexcept :Memarrayuser() {
+    init_to_zero();
+    swap(*this, A);
+  }
+
   inline Indexmatrix::Indexmatrix(Integer inr, Integer inc) {
     init_to_zero();
     newsize(inr, inc);
@@ -890,6 +940,18 @@ namespace CH_Matrix_Classes {
     init(vec);
   }
 
+#if (CONICBUNDLE_LONG_INDEX>=1)
+  inline Indexmatrix::Indexmatrix(Integer inr, Integer inc, const int* d, Integer incr) {
+    init_to_zero();
+    init(inr, inc, d, incr);
+  }
+
+  inline Indexmatrix::Indexmatrix(const std::vector<int>& vec) {
+    init_to_zero();
+    init(vec);
+  }
+#endif
+
   inline Integer& Indexmatrix::operator()(Integer i, Integer j) {
     chk_range(i, j, nr, nc);
     return m[j * nr + i];
@@ -937,6 +999,11 @@ namespace CH_Matrix_Classes {
     return xeya(A);
   }
 
+  inline Indexmatrix& Indexmatrix::operator=(Indexmatrix&& A) noexcept {
+    swap(*this, A);
+    return *this;
+  }
+
   inline Indexmatrix& Indexmatrix::operator*=(const Indexmatrix& A) {
     Indexmatrix C; return xeya(genmult(*this, A, C));
   }
@@ -979,16 +1046,16 @@ namespace CH_Matrix_Classes {
 
 
   inline Indexmatrix operator*(const Indexmatrix& A, const Indexmatrix& B) {
-    Indexmatrix C; return genmult(A, B, C);
+    Indexmatrix C; genmult(A, B, C); return C;
   }
   inline Indexmatrix operator+(const Indexmatrix& A, const Indexmatrix& B) {
-    Indexmatrix C; return xeyapzb(C, A, B, 1, 1);
+    Indexmatrix C; xeyapzb(C, A, B, 1, 1); return C;
   }
   inline Indexmatrix operator-(const Indexmatrix& A, const Indexmatrix& B) {
-    Indexmatrix C; return xeyapzb(C, A, B, 1, -1);
+    Indexmatrix C; xeyapzb(C, A, B, 1, -1); return C;
   }
   inline Indexmatrix operator%(const Indexmatrix& A, const Indexmatrix& B) {
-    Indexmatrix C(A); return C %= B;
+    Indexmatrix C(A); C %= B; return C;
   }
   inline Indexmatrix operator*(const Indexmatrix& A, Integer d) {
     return Indexmatrix(A, d);
@@ -997,22 +1064,22 @@ namespace CH_Matrix_Classes {
     return Indexmatrix(A, d);
   }
   inline Indexmatrix operator/(const Indexmatrix& A, Integer d) {
-    Indexmatrix B(A); return B /= d;
+    Indexmatrix B(A); B /= d; return B;
   }
   inline Indexmatrix operator%(const Indexmatrix& A, Integer d) {
-    Indexmatrix B(A); return B %= d;
+    Indexmatrix B(A); B %= d; return B;
   }
   inline Indexmatrix operator+(const Indexmatrix& A, Integer d) {
-    Indexmatrix B(A); return B += d;
+    Indexmatrix B(A); B += d; return B;
   }
   inline Indexmatrix operator+(Integer d, const Indexmatrix& A) {
-    Indexmatrix B(A); return B += d;
+    Indexmatrix B(A); B += d; return B;
   }
   inline Indexmatrix operator-(const Indexmatrix& A, Integer d) {
-    Indexmatrix B(A); return B -= d;
+    Indexmatrix B(A); B -= d; return B;
   }
   inline Indexmatrix operator-(Integer d, const Indexmatrix& A) {
-    Indexmatrix B(A, -1); return B += d;
+    Indexmatrix B(A, -1); B += d; return B;
   }
 
   inline Indexmatrix triu(const Indexmatrix& A, Integer i = 0) {
@@ -1040,10 +1107,10 @@ namespace CH_Matrix_Classes {
   }
 
   inline Indexmatrix rand(Integer rows, Integer cols, Integer lb, Integer ub, CH_Tools::GB_rand* random_generator = 0) {
-    Indexmatrix A; return A.rand(rows, cols, lb, ub, random_generator);
+    Indexmatrix A; A.rand(rows, cols, lb, ub, random_generator); return A;
   }
   inline Indexmatrix sign(const Indexmatrix& A) {
-    Indexmatrix B(A); return B.sign();
+    Indexmatrix B(A); B.sign(); return B;
   }
 
   inline Indexmatrix operator>(const Indexmatrix& A, const Indexmatrix& B) {
@@ -1100,6 +1167,17 @@ namespace CH_Matrix_Classes {
     return vec;
   }
 
+  inline const int* int_store(const Indexmatrix& A, std::vector<int>& buffer) {
+    chk_init(A);
+#if (CONICBUNDLE_LONG_INDEX>=1)
+    assign(buffer, A);
+    return (buffer.size() == 0) ? 0 : &buffer[0];
+#else
+    (void)buffer;
+    return A.get_store();
+#endif
+  }
+
   //@endcond
 
 }
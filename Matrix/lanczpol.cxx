@@ -27,6 +27,7 @@
 #include <limits>
 #include "mymath.hxx"
 #include "lanczpol.hxx"
+#include "timer_registry.hxx"
 
 
 using namespace CH_Tools;
@@ -101,6 +102,7 @@ namespace CH_Matrix_Classes {
 
   int Lanczpol::compute(const Lanczosmatrix* bigmat, Matrix& eigval, Matrix& eigvec,
     Integer nreig, Integer in_blocksz, Integer maxj) {
+    CH_Tools::ScopedTimer scoped_timer("Lanczpol::compute");
     ncalls++;
 
     //--- check and set input parameters
@@ -121,7 +123,7 @@ namespace CH_Matrix_Classes {
 
     //--- initialize size parameters
 
-    Integer maxnblockmult = min(100, n / blocksz - 1);
+    Integer maxnblockmult = min(Integer(100), n / blocksz - 1);
     if ((choicenbmult < 0) && (choicencheb < 0)) {
       if (n < 300) maxnblockmult = 30; //expect to need this number of Lanczos steps per restart
       else if (n < 1000) maxnblockmult = 50;
@@ -134,10 +136,10 @@ namespace CH_Matrix_Classes {
       } else {
         nchebit = 0;
       }
-      nblockmult = min(10, maxnblockmult);
+      nblockmult = min(Integer(10), maxnblockmult);
     } else {
       if (choicenbmult <= 0)
-        nblockmult = min(10, maxnblockmult);
+        nblockmult = min(Integer(10), maxnblockmult);
       else
         nblockmult = min(choicenbmult, maxnblockmult);
       if (choicencheb < 0) {
@@ -208,7 +210,7 @@ namespace CH_Matrix_Classes {
         time_mult_sum += time_mult;
         nmult += nproposed;
         if (nproposed >= 3) {
-          maxval = sum(d(Range(neigfound, neigfound + nproposed - 1))) / nproposed;
+          maxval = sum(d(Range(neigfound, neigfound + nproposed - 1))) / Real(nproposed);
         } else {
           maxval = d(neigfound + 1);
         }
@@ -499,7 +501,7 @@ namespace CH_Matrix_Classes {
       sectn(X, neigfound, blocksz, C, d, u, v, minval);
       nmult += nproposed;
       if (nproposed >= 3) {
-        maxval = sum(d(Range(neigfound, neigfound + nproposed - 1))) / nproposed;
+        maxval = sum(d(Range(neigfound, neigfound + nproposed - 1))) / Real(nproposed);
       } else {
         maxval = d(neigfound + 1);
       }
@@ -730,7 +732,7 @@ namespace CH_Matrix_Classes {
         if (nblockmult == min(Integer(50), (mymaxj - neigfound) / blocksz - 1)) {
           nchebit = 11;
           if (sbs >= 3)
-            maxval = d(neigfound + max(2, min(blocksz, sbs - 1)));
+            maxval = d(neigfound + max(Integer(2), min(blocksz, sbs - 1)));
           else
             maxval = d(neigfound + 1);
           minval = min(minval, d(neigfound + sbs - 1));
@@ -1956,9 +1958,9 @@ namespace CH_Matrix_Classes {
 #ifndef __unix
     Real coshpolval = cosh(::log(double(1. / (polval - ::sqrt(double(polval * polval - 1))))) / nchebit);
 #else
-    Real coshpolval = cosh(acosh(polval) / nchebit);
+    Real coshpolval = cosh(acosh(polval) / Real(nchebit));
 #endif
-    Real b = (2 * maxval + (coshpolval - 1.) * a) / (coshpolval / nchebit + 1.);
+    Real b = (2 * maxval + (coshpolval - 1.) * a) / (coshpolval / Real(nchebit) + 1.);
 
     Real ru, rv;
     //T0= ru = 1;
@@ -2167,7 +2169,7 @@ namespace CH_Matrix_Classes {
         continue;
       }
       do {
-        if (l_iter == 30) return l + 1;   //at most 30 iterations
+        if (l_iter == 30) return int(l + 1);   //at most 30 iterations
         l_iter++;
         l1 = l + 1;
 
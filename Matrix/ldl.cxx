@@ -56,7 +56,7 @@ namespace CH_Matrix_Classes {
       }
     }
     //compute LDL-factorization (Golub/van Loan, Algorithm 4.1.2)
-    Integer failure = 0;
+    int failure = 0;
     for (Integer j = 0; j < hn; j++) {
       const Real* hmp = hm + (j * (j + 1)) / 2;
       Real* mp = hm;
@@ -59,6 +59,20 @@ namespace CH_Matrix_Classes {
    */
    //@{
 
+#if (CONICBUNDLE_LONG_INDEX>=1)
+#if (LONG_MAX < 9223372036854775807L)
+#error "CONICBUNDLE_LONG_INDEX requires a 64-bit long (LP64 data model)"
+#endif
+
+   /// all integer numbers in calculations and indexing are of this type (64-bit, see CONICBUNDLE_LONG_INDEX)
+  typedef long Integer;
+
+  /// maximal attainable value by an #Integer
+  const Integer max_Integer = LONG_MAX;
+
+  /// minimal attainable value by an #Integer  
+  const Integer min_Integer = LONG_MIN;
+#else
    /// all integer numbers in calculations and indexing are of this type 
   typedef int Integer;
 
@@ -67,6 +81,7 @@ namespace CH_Matrix_Classes {
 
   /// minimal attainable value by an #Integer  
   const Integer min_Integer = INT_MIN;
+#endif
 
 
   /// all real numbers in calculations are of this type 
@@ -1117,10 +1132,10 @@ namespace CH_Matrix_Classes {
      @param d if !=0 points to the starting address of the d array for diangonal weights
      @return \f$sum_{i=0}^{leny} x[i[indy[j]] * y[i] (* d[i[indy[j]])\f$
    */
-  template<class Val>
-  inline Val mat_ip_dense_sparse(const Integer lenx, const Val* x, Integer leny, const Val* yval, const Integer* yind, const Val* d = 0) {
+  template<class Val, class Ind>
+  inline Val mat_ip_dense_sparse(const Integer lenx, const Val* x, Integer leny, const Val* yval, const Ind* yind, const Val* d = 0) {
     Val sum = 0;
-    const Integer* const yend = yind + leny;
+    const Ind* const yend = yind + leny;
     if (d == 0)
       while ((yind != yend) && (*yind < lenx))
         sum += (*(x + *yind++)) * (*yval++);
@@ -1148,13 +1163,13 @@ namespace CH_Matrix_Classes {
      @param d if !=0 points to the starting address of the d array for diangonal weights
      @return \f$ sum_{(i,j)\in J}xval[i] * yval[j] (* d[xind[i]])\f$ where \f$J=\{(i,j)\colon xind[i]=yind[j],i=1,\dots,lenx,j=1,\dots,leny\}\f$
    */
-  template<class Val>
-  inline Val mat_ip_sparse_sparse(const Integer lenx, const Val* xval, const Integer* xind, const Integer leny, const Val* yval, const Integer* yind, const Val* d) {
+  template<class Val, class Ind>
+  inline Val mat_ip_sparse_sparse(const Integer lenx, const Val* xval, const Ind* xind, const Integer leny, const Val* yval, const Ind* yind, const Val* d) {
     if ((lenx <= 0) || (leny <= 0))
       return 0.;
     Val sum = 0;
-    const Integer* const xend = xind + lenx;
-    const Integer* const yend = yind + leny;
+    const Ind* const xend = xind + lenx;
+    const Ind* const yend = yind + leny;
     if (d == 0) {
       do {
         if (*xind == *yind) {
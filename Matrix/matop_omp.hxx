@@ -58,6 +58,20 @@ namespace CH_Matrix_Classes {
    */
    //@{
 
+#if (CONICBUNDLE_LONG_INDEX>=1)
+#if (LONG_MAX < 9223372036854775807L)
+#error "CONICBUNDLE_LONG_INDEX requires a 64-bit long (LP64 data model)"
+#endif
+
+   /// all integer numbers in calculations and indexing are of this type (64-bit, see CONICBUNDLE_LONG_INDEX)
+  typedef long Integer;
+
+  /// maximal attainable value by an #Integer
+  const Integer max_Integer = LONG_MAX;
+
+  /// minimal attainable value by an #Integer  
+  const Integer min_Integer = LONG_MIN;
+#else
    /// all integer numbers in calculations and indexing are of this type 
   typedef int Integer;
 
@@ -66,6 +80,7 @@ namespace CH_Matrix_Classes {
 
   /// minimal attainable value by an #Integer  
   const Integer min_Integer = INT_MIN;
+#endif
 
 
   /// all real numbers in calculations are of this type 
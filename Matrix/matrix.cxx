@@ -108,7 +108,7 @@ namespace CH_Matrix_Classes {
     if (d == -1.) {
       for (Integer i = 0; i < nr * nc; i++) m[i] = Real(-A.m[i]); return *this;
     }
-    for (Integer i = 0; i < nr * nc; i++) m[i] = d * A.m[i];
+    for (Integer i = 0; i < nr * nc; i++) m[i] = d * Real(A.m[i]);
     return *this;
   }
 
@@ -121,9 +121,9 @@ namespace CH_Matrix_Classes {
       return *this;
     }
     if (d == -1.) {
-      for (Integer i = 0; i < nr * nc; i++) m[i] -= A.m[i]; return *this;
+      for (Integer i = 0; i < nr * nc; i++) m[i] -= Real(A.m[i]); return *this;
     }
-    for (Integer i = 0; i < nr * nc; i++) m[i] += d * A.m[i];
+    for (Integer i = 0; i < nr * nc; i++) m[i] += d * Real(A.m[i]);
     return *this;
   }
 
@@ -941,7 +941,7 @@ namespace CH_Matrix_Classes {
   Matrix& Matrix::tril(Integer i) {
     chk_init(*this);
     Integer j;
-    for (j = max(0, i + 1); j < nc; j++) {
+    for (j = max(Integer(0), i + 1); j < nc; j++) {
       mat_xea(min(nr, j - i), m + j * nr, 0.);
     }
     return *this;
@@ -1313,7 +1313,7 @@ namespace CH_Matrix_Classes {
       rgp = &mat_randgen;
     newsize(inr, inc);
     Real* mp = m;
-    for (int i = inr * inc; --i >= 0;)
+    for (Integer i = inr * inc; --i >= 0;)
       (*mp++) = rgp->next();
     chk_set_init(*this, 1);
     return *this;
@@ -1326,19 +1326,19 @@ namespace CH_Matrix_Classes {
     switch (generator_type) {
     case 0: default:
     {
-      for (int i = inr * inc; --i >= 0;)
+      for (Integer i = inr * inc; --i >= 0;)
         (*mp++) = distrib(mat_std_randgen);
       break;
     }
     case 1:
     {
-      for (int i = inr * inc; --i >= 0;)
+      for (Integer i = inr * inc; --i >= 0;)
         (*mp++) = distrib(mat_mt_randgen);
       break;
     }
     case 2:
     {
-      for (int i = inr * inc; --i >= 0;)
+      for (Integer i = inr * inc; --i >= 0;)
         (*mp++) = distrib(mat_mt64_randgen);
       break;
     }
@@ -1518,7 +1518,9 @@ namespace CH_Matrix_Classes {
     Integer j, k;
     Real* mp = m;
     for (j = 0; (j < nc); j++) {
-      mat_xey(ip[0], mp, m + j * nr);
+      //the leading rows of the first column stay in place
+      if (j > 0)
+        mat_xey(ip[0], mp, m + j * nr);
       mp += ip[0];
       for (k = 1; k < ind.dim(); k++) {
 #if (CONICBUNDLE_DEBUG>=1)
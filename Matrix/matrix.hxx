@@ -139,6 +139,8 @@ namespace CH_Matrix_Classes {
     inline Matrix();
     /// copy constructor, *this=d*A
     inline Matrix(const Matrix&, Real d = 1., int atrans = 0);
+    /// move constructor, takes over the storage of A and leaves A as an empty 0x0 matrix
+    inline Matrix(Matrix&& A) noexcept;
     /// generate a column vector holding the elements of this Realrange
     inline Matrix(const Realrange&);
     /** @brief generate a matrix of size nr x nc but WITHOUT initializing the memory
@@ -197,7 +199,7 @@ namespace CH_Matrix_Classes {
     /// use std::vector<#Real> to initialize this to a column vector of the same size and content
     inline Matrix& init(const std::vector<Real>& vec);
     ///initialize to a diagonal nr x nr matrix with constant diagonal value d
-    inline Matrix& init_diag(int nr, Real d = 1.);
+    inline Matrix& init_diag(Integer nr, Real d = 1.);
     ///initialize to a diagonal matrix with diagonal given by vec
     inline Matrix& init_diag(const Matrix& vec, Real d = 1.);
     ///initialize to a diagonal matrix with diagonal given by vec
@@ -446,6 +448,8 @@ namespace CH_Matrix_Classes {
 
      ///
     inline Matrix& operator=(const Matrix& A);
+    /// move assignment, exchanges the storage with A instead of copying (A is left in a valid but unspecified state)
+    inline Matrix& operator=(Matrix&& A) noexcept;
     ///
     inline Matrix& operator*=(const Matrix& s);
     ///
@@ -487,9 +491,15 @@ namespace CH_Matrix_Classes {
     friend Matrix operator%(const Matrix& A, const Matrix& B);
     /// ATTENTION: this is redefined to act componentwise without checking for zeros, C(i,j)=A(i,j)/B(i,j) for all i,j
     friend Matrix operator/(const Matrix& A, const Matrix& B);
-    /// 
+    /** @brief returns a new Matrix equal to A*d
+
+        The operators act eagerly, so x=a*y+b*z creates three temporaries
+        (see memreq_main.cxx). Code that needs this without temporaries
+        calls xeyapzb(x,y,z,a,b), or xpeya() and xbpeya() for x+=a*y
+        and x=a*y+b*x.
+    */
     friend Matrix operator*(const Matrix& A, Real d);
-    /// 
+    /// returns a new Matrix equal to d*A, see operator*(const Matrix&,Real)
     friend Matrix operator*(Real d, const Matrix& A);
     /// ATTENTION: d is NOT checked for 0
     friend Matrix operator/(const Matrix& A, Real d);
@@ -1088,7 +1098,7 @@ namespace CH_Matrix_Classes {
     return *this;
   }
 
-  inline Matrix& Matrix::init_diag(int n, Real d) {
+  inline Matrix& Matrix::init_diag(Integer n, Real d) {
     init(n, n, 0.);
     mat_xea(n, m, n + 1, d);
     return *this;
@@ -1110,7 +1120,7 @@ namespace CH_Matrix_Classes {
     if (d == 1.)
       for (Integer i = 0; i < n; i++) m[i * (n + 1)] = Real(vec.m[i]);
     else
-      for (Integer i = 0; i < n; i++) m[i * (n + 1)] = vec.m[i] * d;
+      for (Integer i = 0; i < n; i++) m[i * (n + 1)] = Real(vec.m[i]) * d;
     return *this;
   }
 
@@ -1124,6 +1134,12 @@ namespace CH_Matrix_Classes {
     xeya(A, d, atrans);
   }
 
+  inline Matrix::Matrix(Matrix&& A) noexcept : Memarrayuser() {
+    init_to_zero();
+    swap(*this, A);
+    A.aux_task = none;
+  }
+
   inline Matrix::Matrix(const Indexmatrix& A, Real d) : Memarrayuser() {
     init_to_zero();
     xeya(A, d);
@@ -1263,6 +1279,13 @@ namespace CH_Matrix_Classes {
     return xeya(A);
   }
 
+  inline Matrix& Matrix::operator=(Matrix&& A) noexcept {
+    swap(*this, A);
+    aux_task = none;
+    A.aux_task = none;
+    return *this;
+  }
+
   inline Matrix& Matrix::operator*=(const Matrix& A) {
     Matrix C; return xeya(genmult(*this, A, C));
   }
@@ -1305,27 +1328,27 @@ namespace CH_Matrix_Classes {
 
   /// returns Matrix equal to A*B
   inline Matrix operator*(const Matrix& A, const Matrix& B) {
-    Matrix C; return genmult(A, B, C);
+    Matrix C; genmult(A, B, C); return C;
   }
 
   /// returns Matrix equal to A+B
   inline Matrix operator+(const Matrix& A, const Matrix& B) {
-    Matrix C; return xeyapzb(C, A, B, 1., 1.);
+    Matrix C; xeyapzb(C, A, B, 1., 1.); return C;
   }
 
   /// returns Matrix equal to A-B
   inline Matrix operator-(const Matrix& A, const Matrix& B) {
-    Matrix C; return xeyapzb(C, A, B, 1., -1.);
+    Matrix C; xeyapzb(C, A, B, 1., -1.); return C;
   }
 
   /// ATTENTION: this is redefined as the Hadamard product, C(i,j)=A(i,j)*B(i,j) for all i,j
   inline Matrix operator%(const Matrix& A, const Matrix& B) {
-    Matrix C(A); return C %= B;
+    Matrix C(A); C %= B; return C;
   }
 
   /// ATTENTION: this is redefined to act componentwise without checking for zeros, C(i,j)=A(i,j)/B(i,j) for all i,j
   inline Matrix operator/(const Matrix& A, const Matrix& B) {
-    Matrix C(A); return C /= B;
+    Matrix C(A); C /= B; return C;
   }
 
   /// returns Matrix equal to A*d
@@ -1345,22 +1368,22 @@ namespace CH_Matrix_Classes {
 
   /// returns (i,j)=A(i,j)+d for all i,j
   inline Matrix operator+(const Matrix& A, Real d) {
-    Matrix B(A); return B += d;
+    Matrix B(A); B += d; return B;
   }
 
   /// returns (i,j)=A(i,j)+d for all i,j
   inline Matrix operator+(Real d, const Matrix& A) {
-    Matrix B(A); return B += d;
+    Matrix B(A); B += d; return B;
   }
 
   /// returns (i,j)=A(i,j)-d for all i,j
   inline Matrix operator-(const Matrix& A, Real d) {
-    Matrix B(A); return B -= d;
+    Matrix B(A); B -= d; return B;
   }
 
   /// returns (i,j)=d-A(i,j) for all i,j
   inline Matrix operator-(Real d, const Matrix& A) {
-    Matrix B(A, -1.); return B += d;
+    Matrix B(A, -1.); B += d; return B;
   }
 
   inline int Matrix::QR_factor(Matrix& Q, Matrix& R, Real tol = 1e-10) const  //*this is unchanged
@@ -1417,47 +1440,47 @@ namespace CH_Matrix_Classes {
 
   /// return a nr x nc matrix with (i,j) assigned a random number uniformly from [0,1] for all i,j
   inline Matrix rand(Integer rows, Integer cols, CH_Tools::GB_rand* random_generator = 0) {
-    Matrix A; return A.rand(rows, cols, random_generator);
+    Matrix A; A.rand(rows, cols, random_generator); return A;
   }
 
   /// returns a matrix with elements (i,j)=1./((*this)(i,j)) for all i,j; ATTENTION: no check for division by zero 
   inline Matrix inv(const Matrix& A) {
-    Matrix B(A); return B.inv();
+    Matrix B(A); B.inv(); return B;
   }
 
   /// returns a matrix with elements (i,j)=sqrt((*this)(i,j)) for all i,j 
   inline Matrix sqrt(const Matrix& A) {
-    Matrix B(A); return B.sqrt();
+    Matrix B(A); B.sqrt(); return B;
   }
 
   /// returns a matrix with elements (i,j)=sqr((*this)(i,j)) for all i,j 
   inline Matrix sqr(const Matrix& A) {
-    Matrix B(A); return B.sqr();
+    Matrix B(A); B.sqr(); return B;
   }
 
   /// returns a matrix with elements (i,j)=sign((*this)(i,j)) for all i,j using ::sign(double,double)
   inline Matrix sign(const Matrix& A, Real tol = 1e-12) {
-    Matrix B(A); return B.sign(tol);
+    Matrix B(A); B.sign(tol); return B;
   }
 
   /// returns a matrix with elements (i,j)=floor((*this)(i,j)) for all i,j 
   inline Matrix floor(const Matrix& A) {
-    Matrix B(A); return B.floor();
+    Matrix B(A); B.floor(); return B;
   }
 
   /// returns a matrix with elements (i,j)=ceil((*this)(i,j)) for all i,j 
   inline Matrix ceil(const Matrix& A) {
-    Matrix B(A); return B.floor();
+    Matrix B(A); B.ceil(); return B;
   }
 
   /// returns a matrix with elements (i,j)=rint((*this)(i,j)) for all i,j 
   inline Matrix rint(const Matrix& A) {
-    Matrix B(A); return B.floor();
+    Matrix B(A); B.rint(); return B;
   }
 
   /// returns a matrix with elements (i,j)=round((*this)(i,j)) for all i,j 
   inline Matrix round(const Matrix& A) {
-    Matrix B(A); return B.floor();
+    Matrix B(A); B.round(); return B;
   }
 
 
@@ -27,7 +27,10 @@
 #include <iomanip>
 #include <stdlib.h>
 #include <random>
+#include <cstring>
 #include "memarray.hxx"
+#include "thread_placement.hxx"
+#include "thread_pool.hxx"
 
 
 using namespace CH_Tools;
@@ -38,6 +41,9 @@ namespace CH_Matrix_Classes {
 
   Memarray* Memarrayuser::memarray = 0;
 
+  long Memarray::first_touch_min_size = 0;
+  int Memarray::first_touch_threads = 0;
+
   // **************************************************************************
   //                                mat_randgen
   // **************************************************************************
@@ -163,6 +169,35 @@ namespace CH_Matrix_Classes {
     return 0;
   }
 
+  //*************************************************************************
+  //                           first_touch
+  //*************************************************************************
+
+  static void memarray_touch_range(char* addr, long size) {
+    std::memset(addr, 0, std::size_t(size));
+  }
+
+  bool Memarray::first_touch(char* addr, long size) {
+    const long page = 4096;
+    long nt = first_touch_threads;
+    if (nt <= 0)
+      nt = CH_Tools::ThreadPlacement::n_processors();
+    if (nt > size / page)
+      nt = size / page;
+    if (nt <= 1)
+      return false;
+
+    //each task gets a range of whole pages, the calling thread the first one;
+    //the workers pin themselves before they touch their range
+    const long chunk = ((size / nt + page - 1) / page) * page;
+    CH_Tools::ThreadPool::run(int(nt), [addr, size, chunk](int t) {
+      long start = long(t) * chunk;
+      if (start < size)
+        memarray_touch_range(addr + start, (start + chunk <= size) ? chunk : size - start);
+    });
+    return true;
+  }
+
   //*************************************************************************
   //                           Constructor
   //*************************************************************************
@@ -170,6 +205,9 @@ namespace CH_Matrix_Classes {
   Memarray::Memarray(long nre, int nrs, int nrbits) {
     memarray_users = 0;
     in_use = 0;
+    n_requests = 0;
+    n_allocs = 0;
+    n_touched = 0;
     max_entries = nre;
     max_sizes = nrs;
     max_addr_entr = (1 << (unsigned long)nrbits);
@@ -224,6 +262,7 @@ namespace CH_Matrix_Classes {
   long Memarray::get(long size, char*& addr) {
     addr = 0;
     if (size <= 0) return 0;
+    n_requests++;
     Entry* ep = 0;
     int si = size_index(size);
 
@@ -255,8 +294,11 @@ namespace CH_Matrix_Classes {
       ep->size = (roundupsize > size) ? roundupsize : size;
       ep->addr = new char[(unsigned long)ep->size];
       if (ep->addr == 0) ep->size = 0; //allocation not successful
+      else if ((first_touch_min_size > 0) && (ep->size >= first_touch_min_size) && (first_touch(ep->addr, ep->size)))
+        n_touched++;
       ep->index = si;
       in_use += (unsigned long)(ep->size);
+      n_allocs++;
 #if (CONICBUNDLE_DEBUG>=70)
       if (materrout) (*materrout) << "DA==  " << std::setw(5) << ep->size << ", block " << long(ep->addr) << std::endl;
 #endif
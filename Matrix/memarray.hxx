@@ -65,6 +65,18 @@ namespace CH_Matrix_Classes {
       (i.e. all are filled with allocated blocks) a new array of Entry items,
       double in size, is allocated and the old information of the old array
       is copied to the first half of the new items.
+
+      On machines with several NUMA nodes the pages of a new block are
+      placed on the node of the thread that writes to them first. By
+      default this is the thread calling get(), so all large matrices
+      (e.g. the bundle, the Lanczos vectors or the Bigmatrix) end up on
+      its node. With set_first_touch() new blocks above a size threshold
+      are set to zero by several threads, each writing a contiguous range
+      of pages, which distributes the block over the nodes of these
+      threads. These are the persistent workers of CH_Tools::ThreadPool,
+      which pin themselves (if switched on, see CH_Tools::ThreadPlacement)
+      before they write to the block, so worker t always touches its
+      pages from the same processor.
   */
   class Memarray {
   private:
@@ -93,6 +105,12 @@ namespace CH_Matrix_Classes {
     unsigned long addr_mask; ///< mask to extract last bits of an address as index for freeing
     unsigned long in_use;    ///< number of #CH_Matrix_Classes::Memarray::Entry items in use (pointing to an allocated block)
     unsigned long memarray_users; ///< number of objects announced as "living" users of this memory manager 
+    unsigned long n_requests; ///< number of calls to get() with positive size
+    unsigned long n_allocs;   ///< number of these calls that had to allocate a new block
+    unsigned long n_touched;  ///< number of new blocks that were touched first in parallel
+
+    static long first_touch_min_size; ///< new blocks of at least this many bytes are touched first in parallel, 0 switches this off
+    static int first_touch_threads;   ///< number of threads for the first touch, 0 uses the number of available processors
 
     Entry first_empty;  ///< its next pointer points to the first free #CH_Matrix_Classes::Memarray::Entry item, that does not yet hold an allocated block 
     Entry* entry_store; ///< points to the allocated array of #CH_Matrix_Classes::Memarray::Entry items
@@ -107,6 +125,8 @@ namespace CH_Matrix_Classes {
     int addr_index(const char* addr);
     /// double number of available #CH_Matrix_Classes::Memarray::Entry items
     int get_more_entries();
+    /// set the new block to zero by several threads, returns true if more than one thread was used
+    bool first_touch(char* addr, long size);
 
   public:
     /// specify inital number of Entry items, the number of 2^i classes, the number of last bits used in finding entries to used adresses
@@ -117,6 +137,37 @@ namespace CH_Matrix_Classes {
     unsigned long get_in_use() const {
       return in_use;
     }
+    /// returns the number of calls to get() with positive size, useful for counting the temporaries generated in a piece of code
+    unsigned long get_n_requests() const {
+      return n_requests;
+    }
+    /// returns the number of calls to get() that could not be served by a free block and allocated a new one
+    unsigned long get_n_allocs() const {
+      return n_allocs;
+    }
+    /// returns the number of new blocks that were touched first in parallel, see set_first_touch()
+    unsigned long get_n_touched() const {
+      return n_touched;
+    }
+    /** @brief new blocks of at least @a min_size bytes are set to zero by @a n_threads threads (0 for the number of available processors) in order to distribute their pages over the NUMA nodes (default 0, i.e., switched off)
+
+        This setting is shared by all Memarray objects. It only
+        pays off for large blocks (megabytes) on machines with several
+        NUMA nodes, because each new block costs waking up the workers
+        and writing the whole block once.
+    */
+    static void set_first_touch(long min_size, int n_threads = 0) {
+      first_touch_min_size = (min_size > 0) ? min_size : 0;
+      first_touch_threads = (n_threads > 0) ? n_threads : 0;
+    }
+    /// returns the size threshold in bytes for the parallel first touch of new blocks (0 if switched off), see set_first_touch()
+    static long get_first_touch_min_size() {
+      return first_touch_min_size;
+    }
+    /// returns the number of threads for the parallel first touch of new blocks (0 for the number of available processors)
+    static int get_first_touch_threads() {
+      return first_touch_threads;
+    }
     /// returns the number of announced "living" users of this Memory manager
     unsigned long get_memarray_users() const {
       return memarray_users;
@@ -166,6 +217,11 @@ namespace CH_Matrix_Classes {
       memarray->increment_memarray_users();
     }
 
+    /// returns the common memory manager (NULL if there is no living user), e.g. for reading its statistics
+    static const Memarray* get_memarray() {
+      return memarray;
+    }
+
     ///the number of users is decremented and the Memarray memory manager is destructed, if the number is zero.
     virtual ~Memarrayuser() {
 #if (CONICBUNDLE_DEBUG>=1)
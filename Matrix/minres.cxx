@@ -165,7 +165,7 @@ namespace CH_Matrix_Classes {
       old_resnorm = resnorm;
       resnorm = std::fabs(eta);
       if ((nmult >= 2) && (nmult < 11)) {
-        avg_reduction = (avg_reduction * (nmult - 2) + resnorm / old_resnorm) / (nmult - 1);
+        avg_reduction = (avg_reduction * Real(nmult - 2) + resnorm / old_resnorm) / Real(nmult - 1);
       }
       if (nmult >= 11) {
         avg_reduction = avg_reduction * 9 / 10. + resnorm / old_resnorm / 10.;
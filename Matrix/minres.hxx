@@ -58,7 +58,7 @@ namespace CH_Matrix_Classes {
     Real avg_reduction; ///<average over the reduction factors
     Real termprec;     ///< absolute precision required in the last call
     Integer nmult;  ///< number of matrix vector multiplications/iterations
-    Integer err;    ///< error code
+    int err;        ///< error code
 
 
     Matrix vecvcurr;    ///< current vector v
@@ -78,7 +78,7 @@ namespace CH_Matrix_Classes {
 
     Real mu = ip(x, y) / Real(nc) / 5.;                //barrier parameter
     Integer iter = 0;
-    Integer failed = 0;
+    int failed = 0;
 
     //--- repeat till gap is small enough
     while ((ip(x, y) > tol * max(1., max(max(x), max(y)))) && (iter < 50)) {
@@ -126,7 +126,7 @@ namespace CH_Matrix_Classes {
 
       x += alpha * dx;
       y += beta * dy;
-      mu = ip(x, y) / nc / 10.;
+      mu = ip(x, y) / Real(nc) / 10.;
       if (min(alpha, beta) > .95) mu /= 10.;
     }
     if (iter >= 50) {
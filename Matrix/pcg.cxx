@@ -94,7 +94,7 @@ namespace CH_Matrix_Classes {
       return err;
     }
     Real rho = ip(r, z);
-    Integer pc_notpd = 0;  //counts if preconditioner seems to not be positive definite
+    int pc_notpd = 0;  //counts if preconditioner seems to not be positive definite
     if (rho <= 1e-10 * n2r) {
       pc_notpd++;
     }
@@ -129,7 +129,7 @@ namespace CH_Matrix_Classes {
       old_resnorm = resnorm;
       resnorm = n2r;
       if ((nmult >= 2) && (nmult < 11)) {
-        avg_reduction = (avg_reduction * (nmult - 2) + resnorm / old_resnorm) / (nmult - 1);
+        avg_reduction = (avg_reduction * Real(nmult - 2) + resnorm / old_resnorm) / Real(nmult - 1);
       }
       if (nmult >= 11) {
         avg_reduction = avg_reduction * 9 / 10. + resnorm / old_resnorm / 10.;
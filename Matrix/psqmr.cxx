@@ -119,7 +119,7 @@ namespace CH_Matrix_Classes {
     Matrix u;
 
     //============ main loop
-    Integer maxmult = max(30, x.dim());
+    Integer maxmult = max(Integer(30), x.dim());
     if (maxit > 0) {
       maxmult = maxit;
     }
@@ -180,7 +180,7 @@ namespace CH_Matrix_Classes {
       resnorm = norm2(res);
       //for the avg_reduction we start once nmult==2, so its initial value is ignored
       if ((nmult >= 2) && (nmult < 11)) {
-        avg_reduction = (avg_reduction * (nmult - 2) + resnorm / old_resnorm) / (nmult - 1);
+        avg_reduction = (avg_reduction * Real(nmult - 2) + resnorm / old_resnorm) / Real(nmult - 1);
       }
       if (nmult >= 11) {
         avg_reduction = avg_reduction * 9 / 10. + resnorm / old_resnorm / 10.;
@@ -57,7 +57,7 @@ namespace CH_Matrix_Classes {
       Real* base = m + j * nr + j;
       Real tau = mat_ip(nr - j, base);
       if (tau < tol) {
-        return j + 1;
+        return int(j + 1);
       }
       Real gamma = *(base);           //beta=x(0)
       Real lam = gamma;
@@ -166,7 +166,7 @@ namespace CH_Matrix_Classes {
       if (nrm < nrmbnd)
         break;
     }
-    return r;
+    return int(r);
   }
 
   int Matrix::QR_factor_relpiv(Indexmatrix& piv, Real tol) {
@@ -219,7 +219,7 @@ namespace CH_Matrix_Classes {
       cp = c.m + r;
       for (j = nc - r; --j >= 0; mp += nr) (*cp++) -= (*mp) * (*mp);
     }
-    return r;
+    return int(r);
   }
 
   int Matrix::QR_factor(Matrix& Q, Indexmatrix& piv, Real tol) {
@@ -234,7 +234,7 @@ namespace CH_Matrix_Classes {
       rowhouse(Q, v, j, j);
       mat_xea(nr - j - 1, m + j * nr + j + 1, 0.);
     }
-    return r;
+    return int(r);
   }
 
   int Matrix::Qt_times(Matrix& A, Integer r) const {
@@ -332,7 +332,7 @@ namespace CH_Matrix_Classes {
       //--- upper triangle is now transposed of intended system
       for (Integer i = 0; i < r; i++) {  //solve for variable row i
         Real d = A(i, i);
-        if (::fabs(d) < tol) return i + 1;
+        if (::fabs(d) < tol) return int(i + 1);
         Real* Xp = X.m + i;
         for (Integer j = 0; j < X.nc; j++, Xp += X.nr) {
           (*Xp) /= d;
@@ -505,7 +505,7 @@ namespace CH_Matrix_Classes {
       }
     }
 
-    return r;
+    return int(r);
 
   }
 
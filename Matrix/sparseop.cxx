@@ -0,0 +1,211 @@
+/* ****************************************************************************
+
+    Copyright (C) 2026  ConicBundle contributors
+
+    ConicBundle, Version 1.a.2
+    File:  Matrix/sparseop.cxx
+    This file is part of ConciBundle, a C/C++ library for convex optimization.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+
+
+#include <algorithm>
+#include <atomic>
+#include "sparseop.hxx"
+#include "thread_placement.hxx"
+#include "thread_pool.hxx"
+
+
+namespace CH_Matrix_Classes {
+
+  // transposition works on square tiles of transpose_blk doubles per
+  // side; spop_symmult sweeps over all nonzeros once for each slice of
+  // symmult_slice rows so that the touched pieces of P and C stay in
+  // the cache
+  static const Integer transpose_blk = 32;
+  static const Integer symmult_slice = 1024;
+
+  // the number of threads for a kernel with the given work, see sparseop_minwork_thread
+
+  static Integer spop_nthreads(double work) {
+    if (work < double(sparseop_minwork_thread))
+      return 1;
+    Integer nt = Integer(CH_Tools::ThreadPlacement::n_processors());
+    if (double(nt) > work / sparseop_minwork_thread + 1.)
+      nt = Integer(work / sparseop_minwork_thread) + 1;
+    return std::max(Integer(1), nt);
+  }
+
+  void spop_transpose(Integer m, Integer n, const Real* A, Integer lda, Real* T) {
+    for (Integer jj = 0; jj < n; jj += transpose_blk) {
+      const Integer jend = std::min(n, jj + transpose_blk);
+      for (Integer ii = 0; ii < m; ii += transpose_blk) {
+        const Integer iend = std::min(m, ii + transpose_blk);
+        for (Integer j = jj; j < jend; j++) {
+          const Real* ap = A + j * lda;
+          Real* tp = T + j;
+          for (Integer i = ii; i < iend; i++)
+            tp[i * n] = ap[i];
+        }
+      }
+    }
+  }
+
+  void spop_addtranspose(Integer m, Integer n, Real alpha, const Real* T, Real* C, Integer ldc) {
+    for (Integer jj = 0; jj < n; jj += transpose_blk) {
+      const Integer jend = std::min(n, jj + transpose_blk);
+      for (Integer ii = 0; ii < m; ii += transpose_blk) {
+        const Integer iend = std::min(m, ii + transpose_blk);
+        for (Integer j = jj; j < jend; j++) {
+          Real* cp = C + j * ldc;
+          const Real* tp = T + j;
+          for (Integer i = ii; i < iend; i++)
+            cp[i] += alpha * tp[i * n];
+        }
+      }
+    }
+  }
+
+  void spop_nzblocks(Integer k, const Integer* info, Integer nblocks, std::vector<Integer>& bounds) {
+    bounds.clear();
+    bounds.push_back(0);
+    if (k <= 0)
+      return;
+    const Integer* start = info + 2 * k;
+    const Integer first = start[0];
+    const double total = double(start[k - 1] + info[2 * k - 1] - first);
+    for (Integer b = 1; b < nblocks; b++) {
+      const Integer target = first + Integer((total * double(b)) / double(nblocks));
+      const Integer r = Integer(std::lower_bound(start, start + k, target) - start);
+      if (r > bounds.back())
+        bounds.push_back(r);
+    }
+    if (k > bounds.back())
+      bounds.push_back(k);
+  }
+
+  // the sparse vectors rbeg,...,rend-1 of spop_gather; buf holds n
+  // doubles if cinc!=1
+
+  static void gather_range(Integer rbeg, Integer rend, Integer k, const Integer* info,
+    const Integer* ind, const Real* val, Integer n, Real alpha, const Real* P,
+    Real* C, Integer cstep, Integer cinc, Real* buf) {
+    const Integer* const cnt = info + k;
+    const Integer* const start = info + 2 * k;
+    for (Integer r = rbeg; r < rend; r++) {
+      const Integer* ip = ind + start[r];
+      const Real* vp = val + start[r];
+      Real* const cp = C + info[r] * cstep;
+      if (n == 1) {
+        Real s = 0.;
+        for (Integer l = cnt[r]; --l >= 0;)
+          s += (*vp++) * P[*ip++];
+        *cp += alpha * s;
+      } else if (cinc == 1) {
+        for (Integer l = cnt[r]; --l >= 0;)
+          mat_xpeya(n, cp, P + (*ip++) * n, alpha * (*vp++));
+      } else {
+        mat_xea(n, buf, 0.);
+        for (Integer l = cnt[r]; --l >= 0;)
+          mat_xpeya(n, buf, P + (*ip++) * n, *vp++);
+        mat_xpeya(n, cp, cinc, buf, 1, alpha);
+      }
+    }
+  }
+
+  void spop_gather(Integer k, const Integer* info, const Integer* ind, const Real* val,
+    Integer n, Real alpha, const Real* P, Real* C, Integer cstep, Integer cinc) {
+    if ((k <= 0) || (n <= 0) || (alpha == 0.))
+      return;
+    const Integer bufdim = ((cinc == 1) || (n == 1)) ? 0 : n;
+    const Integer nthreads = spop_nthreads(double(info[3 * k - 1] + info[2 * k - 1] - info[2 * k]) * double(n));
+    if (nthreads > 1) {
+      std::vector<Integer> bounds;
+      spop_nzblocks(k, info, 4 * nthreads, bounds);
+      const Integer nblocks = Integer(bounds.size()) - 1;
+      //the threads fetch the blocks one after the other
+      std::atomic<Integer> next_block(0);
+      CH_Tools::ThreadPool::run(int(std::min(nthreads, nblocks)), [&](int) {
+        std::vector<Real> buf(size_t(bufdim) + 1);
+        for (Integer b = next_block++; b < nblocks; b = next_block++)
+          gather_range(bounds[size_t(b)], bounds[size_t(b) + 1], k, info, ind, val, n, alpha, P, C, cstep, cinc, buf.data());
+      });
+      return;
+    }
+    std::vector<Real> buf(size_t(bufdim) + 1);
+    gather_range(0, k, k, info, ind, val, n, alpha, P, C, cstep, cinc, buf.data());
+  }
+
+  // spop_symmult restricted to the rows i0,...,i0+len-1 of P and C
+
+  static void symmult_rows(Integer i0, Integer len, Integer k, const Integer* info,
+    const Integer* ind, const Real* val, Integer n, Real alpha, const Real* P, Real* C) {
+    const Integer* const cnt = info + k;
+    const Integer* const start = info + 2 * k;
+    P += i0;
+    C += i0;
+    for (Integer r = 0; r < k; r++) {
+      const Integer* ip = ind + start[r];
+      const Real* vp = val + start[r];
+      const Integer j = info[r];
+      if (j < 0) {
+        //diagonal part
+        for (Integer l = cnt[r]; --l >= 0;) {
+          const Integer i = (*ip++) * n;
+          mat_xpeya(len, C + i, P + i, alpha * (*vp++));
+        }
+        continue;
+      }
+      //offdiagonal indices are relative to the column
+      Real* const cj = C + j * n;
+      const Real* const pj = P + j * n;
+      for (Integer l = cnt[r]; --l >= 0;) {
+        const Integer h = (*ip++) * n;
+        const Real d = alpha * (*vp++);
+        mat_xpeya(len, cj, pj + h, d);
+        mat_xpeya(len, cj + h, pj, d);
+      }
+    }
+  }
+
+  void spop_symmult(Integer k, const Integer* info, const Integer* ind, const Real* val,
+    Integer n, Real alpha, const Real* P, Real* C) {
+    if ((k <= 0) || (n <= 0) || (alpha == 0.))
+      return;
+    Integer slice = symmult_slice;
+    const Integer nthreads = spop_nthreads(double(info[3 * k - 1] + info[2 * k - 1]) * double(n));
+    if (nthreads > 1) {
+      //slices of whole cache lines, at least one per thread
+      Integer w = (n + nthreads - 1) / nthreads;
+      w = ((w + 7) / 8) * 8;
+      slice = std::min(slice, w);
+      const Integer nslices = (n + slice - 1) / slice;
+      //the threads fetch the slices one after the other
+      std::atomic<Integer> next_slice(0);
+      CH_Tools::ThreadPool::run(int(std::min(nthreads, nslices)), [&](int) {
+        for (Integer s = next_slice++; s < nslices; s = next_slice++) {
+          const Integer i0 = s * slice;
+          symmult_rows(i0, std::min(slice, n - i0), k, info, ind, val, n, alpha, P, C);
+        }
+      });
+      return;
+    }
+    for (Integer i0 = 0; i0 < n; i0 += slice)
+      symmult_rows(i0, std::min(slice, n - i0), k, info, ind, val, n, alpha, P, C);
+  }
+
+}
@@ -0,0 +1,115 @@
+/* ****************************************************************************
+
+    Copyright (C) 2026  ConicBundle contributors
+
+    ConicBundle, Version 1.a.2
+    File:  Matrix/sparseop.hxx
+    This file is part of ConciBundle, a C/C++ library for convex optimization.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+
+
+#ifndef CH_MATRIX_CLASSES__SPARSEOP_HXX
+#define CH_MATRIX_CLASSES__SPARSEOP_HXX
+
+/**  @file sparseop.hxx
+    @brief Header declaring the kernels on raw arrays that are used by genmult() for large products of Sparsemat or Sparsesym with a Matrix
+    @version 1.0
+    @date 2026-10-18
+    @author ConicBundle contributors
+
+*/
+
+#include <vector>
+#include "matop.hxx"
+
+namespace CH_Matrix_Classes {
+
+  /**@defgroup sparseop Sparse times dense kernels (internal)
+
+     In the plain genmult() loops of Sparsemat and Sparsesym with a
+     Matrix each nonzero adds a multiple of a row of the dense factor to
+     a row of the result, and both rows are strided by the number of
+     rows in the column major storage. For large products genmult()
+     therefore arranges the operands so that the kernels below only
+     work on contiguous vectors of the dense factor and the result
+     (if needed it copies the dense factor or the result in transposed
+     form, see spop_transpose()). These contiguous loops over the dense
+     columns are vectorized by the compiler.
+
+     If the work is large enough, the kernels are run in parallel on the
+     workers of CH_Tools::ThreadPool, like the other parallel loops of
+     the library (sumop, Memarray first touch). spop_gather() splits the
+     sparse vectors into blocks with about the same number of nonzeros
+     (see spop_nzblocks()) that the threads fetch one after the other,
+     and each thread writes only to the results of its own sparse
+     vectors. In spop_symmult() every nonzero of the symmetric matrix is
+     used for two result vectors, so there the threads fetch slices of
+     the rows of the dense factor and the result instead. The threads
+     only use raw arrays and std::vector buffers, never Memarray.
+  */
+  //@{
+
+  /// genmult() uses the kernels only if the number of nonzeros times the length of the dense vectors is at least this
+  const Integer sparseop_minwork = 16384;
+  /// ... and if the dense vectors have length one (inner products in spop_gather()) or at least this
+  const Integer sparseop_minlen = 16;
+  /// a dense factor (or the result) is copied in transposed form only if the number of nonzeros is at least this times the number of vectors copied
+  const Integer sparseop_mincopy = 2;
+  /// the kernels use more than one thread only if the number of nonzeros times the length of the dense vectors is at least this
+  const Integer sparseop_minwork_thread = 262144;
+
+  /// T (n x m) = A^T for A m x n column major with leading dimension lda
+  void spop_transpose(Integer m, Integer n, const Real* A, Integer lda, Real* T);
+
+  /// C(m x n, column major, leading dimension ldc) += alpha*T^T for T n x m column major
+  void spop_addtranspose(Integer m, Integer n, Real alpha, const Real* T, Real* C, Integer ldc);
+
+  /** @brief splits the k sparse vectors of an info table into at most nblocks consecutive ranges [bounds[b],bounds[b+1]) with about the same number of nonzeros
+
+      The info table is a k x 3 Indexmatrix store like colinfo of
+      Sparsemat (index, number of nonzeros, first position in the index
+      and value arrays) whose vectors follow each other in the index and
+      value arrays. Empty ranges are dropped.
+  */
+  void spop_nzblocks(Integer k, const Integer* info, Integer nblocks, std::vector<Integer>& bounds);
+
+  /** @brief for each sparse vector s_r (r=0,...,k-1) of the k x 3 info table it adds alpha*P*s_r to the n-vector of C starting at C+info(r,0)*cstep with increment cinc
+
+      P is n x m column major, so the dense columns of P selected by the
+      nonzeros of s_r are accumulated, either directly into C if cinc==1
+      or otherwise in a contiguous buffer that is then added to C. Each
+      result vector may only be addressed by one sparse vector.
+  */
+  void spop_gather(Integer k, const Integer* info, const Integer* ind, const Real* val,
+    Integer n, Real alpha, const Real* P, Real* C, Integer cstep, Integer cinc);
+
+  /** @brief C (n x m, column major) += alpha*P*S for P n x m column major and the symmetric S given by the lower triangle column representation of Sparsesym
+
+      The k x 4 info table with ind and val is the colinfo, colindex and
+      colval store of a Sparsesym; an info row with negative index holds
+      the diagonal elements and the offdiagonal row indices are stored
+      relative to the column index.
+  */
+  void spop_symmult(Integer k, const Integer* info, const Integer* ind, const Real* val,
+    Integer n, Real alpha, const Real* P, Real* C);
+
+  //@}
+
+}
+
+#endif
@@ -25,7 +25,9 @@
 
 #include <stdlib.h>
 #include <algorithm>
+#include <mutex>
 #include "sparsmat.hxx"
+#include "sparseop.hxx"
 
 
 using namespace CH_Tools;
@@ -59,6 +61,7 @@ namespace CH_Matrix_Classes {
   }
 
   Integer Sparsemat::find_row(Integer ci) const {
+    need_rowrep();
     if (rowinfo.dim() == 0)
       return -1; //no nonzero columns
     if ((ci < rowinfo(0, 0)) || (ci > rowinfo(rowinfo.rowdim() - 1, 0)))
@@ -84,19 +87,136 @@ namespace CH_Matrix_Classes {
     return ii;
   }
 
+  // ============================================================================
+  //                     row representation on demand
+  // ============================================================================
+
+  void Sparsemat::make_rowrep() const {
+    Integer nz = colval.dim();
+    if (nz == 0) {
+      rowinfo.init(0, 3, Integer(0)); rowindex.init(0, 1, Integer(0)); rowval.init(0, 1, 0.);
+      rowrep_valid.store(true, std::memory_order_release);
+      return;
+    }
+    //count the nonzeros in each row
+    Indexmatrix rowpos(nr, 1, Integer(0));
+    Integer* pp = rowpos.get_store();
+    const Integer* cip = colindex.get_store();
+    for (Integer i = nz; --i >= 0;)
+      pp[*cip++]++;
+    Integer nzrows = 0;
+    for (Integer i = 0; i < nr; i++) {
+      if (pp[i] > 0)
+        nzrows++;
+    }
+    rowinfo.newsize(nzrows, 3); chk_set_init(rowinfo, 1);
+    rowindex.newsize(nz, 1); chk_set_init(rowindex, 1);
+    rowval.newsize(nz, 1); chk_set_init(rowval, 1);
+    //rowpos(i) becomes the next free position of row i
+    Integer* rip = rowinfo.get_store();
+    Integer start = 0;
+    for (Integer i = 0; i < nr; i++) {
+      Integer cnt = pp[i];
+      if (cnt == 0)
+        continue;
+      rip[0] = i;
+      rip[nzrows] = cnt;
+      rip[2 * nzrows] = start;
+      rip++;
+      pp[i] = start;
+      start += cnt;
+    }
+    //the columns are visited in increasing order, so each row is sorted
+    Integer* rindp = rowindex.get_store();
+    Real* rvalp = rowval.get_store();
+    for (Integer j = 0; j < colinfo.rowdim(); j++) {
+      Integer colj = colinfo(j, 0);
+      cip = colindex.get_store() + colinfo(j, 2);
+      const Real* cvp = colval.get_store() + colinfo(j, 2);
+      for (Integer k = colinfo(j, 1); --k >= 0;) {
+        Integer pos = pp[*cip++]++;
+        rindp[pos] = colj;
+        rvalp[pos] = *cvp++;
+      }
+    }
+    rowrep_valid.store(true, std::memory_order_release);
+  }
+
+  void Sparsemat::provide_rowrep() const {
+    //building is rare, so one lock for all matrices suffices
+    static std::mutex rowrep_mutex;
+    std::lock_guard<std::mutex> lock(rowrep_mutex);
+    if (!rowrep_valid.load(std::memory_order_relaxed))
+      make_rowrep();
+  }
+
+  void Sparsemat::drop_rowrep() {
+    //swapping with empty matrices releases the memory
+    Indexmatrix tmpinfo(0, 3, Integer(0));
+    swap(rowinfo, tmpinfo);
+    Indexmatrix tmpindex(0, 1, Integer(0));
+    swap(rowindex, tmpindex);
+    Matrix tmpval(0, 1, 0.);
+    swap(rowval, tmpval);
+    rowrep_valid.store(false, std::memory_order_release);
+  }
+
+  void Sparsemat::set_lazy_rowrep(bool lazy) {
+    lazy_rowrep = lazy;
+    if (lazy)
+      drop_rowrep();
+    else
+      need_rowrep();
+  }
+
+  void Sparsemat::get_csc_offsets(std::vector<std::int64_t>& offsets) const {
+    chk_init(*this);
+    offsets.assign(std::size_t(nc) + 1, 0);
+    for (Integer j = 0; j < colinfo.rowdim(); j++)
+      offsets[std::size_t(colinfo(j, 0)) + 1] = colinfo(j, 1);
+    for (std::size_t j = 1; j < offsets.size(); j++)
+      offsets[j] += offsets[j - 1];
+  }
+
+  void Sparsemat::get_csr_offsets(std::vector<std::int64_t>& offsets) const {
+    chk_init(*this);
+    need_rowrep();
+    offsets.assign(std::size_t(nr) + 1, 0);
+    for (Integer i = 0; i < rowinfo.rowdim(); i++)
+      offsets[std::size_t(rowinfo(i, 0)) + 1] = rowinfo(i, 1);
+    for (std::size_t i = 1; i < offsets.size(); i++)
+      offsets[i] += offsets[i - 1];
+  }
+
+  void Sparsemat::get_memory_usage(std::size_t& colrep_bytes, std::size_t& rowrep_bytes) const {
+    colrep_bytes = sizeof(Integer) * (std::size_t(colinfo.mem_dim) + std::size_t(colindex.mem_dim)) +
+      sizeof(Real) * std::size_t(colval.mem_dim);
+    rowrep_bytes = sizeof(Integer) * (std::size_t(rowinfo.mem_dim) + std::size_t(rowindex.mem_dim)) +
+      sizeof(Real) * std::size_t(rowval.mem_dim);
+  }
 
 
   Sparsemat& Sparsemat::xeya(const Sparsemat& A, Real d) {
     chk_init(A);
+    //a copy keeps the storage mode of A
+    if (&A != this)
+      lazy_rowrep = A.lazy_rowrep;
     if (d == 0.) return init(A.nr, A.nc);
     nr = A.nr;
     nc = A.nc;
     colinfo = A.colinfo;
-    rowinfo = A.rowinfo;
     colindex = A.colindex;
-    rowindex = A.rowindex;
     colval.xeya(A.colval, d);
-    rowval.xeya(A.rowval, d);
+    if (lazy_rowrep) {
+      drop_rowrep();
+    } else if (A.rowrep_valid) {
+      rowinfo = A.rowinfo;
+      rowindex = A.rowindex;
+      rowval.xeya(A.rowval, d);
+      rowrep_valid.store(true, std::memory_order_release);
+    } else {
+      make_rowrep();
+    }
     chk_set_init(*this, 1);
     return *this;
   }
@@ -152,7 +272,7 @@ namespace CH_Matrix_Classes {
       if (*m != 0) {
         I(nz) = i % A.nr;
         J(nz) = i / A.nr;
-        val(nz++) = Real(*m * d);
+        val(nz++) = Real(*m) * d;
       }
     }
     init(A.nr, A.nc, nz, I, J, val);
@@ -188,12 +308,17 @@ namespace CH_Matrix_Classes {
     }
     if (A.nonzeros() == 0) {
       if (Btrans) {
-        A.rowinfo = B.colinfo;
-        A.rowindex = B.colindex;
-        A.rowval.init(B.colval, beta);
+        B.need_rowrep();
         A.colinfo = B.rowinfo;
         A.colindex = B.rowindex;
         A.colval.init(B.rowval, beta);
+        if (A.lazy_rowrep) {
+          A.drop_rowrep();
+        } else {
+          A.rowinfo = B.colinfo;
+          A.rowindex = B.colindex;
+          A.rowval.init(B.colval, beta);
+        }
       } else
         A.init(B, beta);
       return A;
@@ -210,127 +335,141 @@ namespace CH_Matrix_Classes {
     const Indexmatrix* Binf;
     const Indexmatrix* Bind;
     const Matrix* Bval;
-
-    //treat rows first
-    Ainf = &(A.rowinfo);
-    Aind = &(A.rowindex);
-    Aval = &(A.rowval);
-    if (Btrans) {
-      Binf = &(B.colinfo);
-      Bind = &(B.colindex);
-      Bval = &(B.colval);
-    } else {
-      Binf = &(B.rowinfo);
-      Bind = &(B.rowindex);
-      Bval = &(B.rowval);
-    }
-    Integer maxrows = min(Ainf->rowdim() + Binf->rowdim(), nr);
+    Integer maxrows;
     Integer maxnz = min(A.nonzeros() + B.nonzeros(), nr * nc);
-    Integer maxnr = nr;
-    Integer maxnc = nc;
-    inf.newsize(maxrows, 3); chk_set_init(inf, 1);
-    ind.newsize(maxnz, 1); chk_set_init(ind, 1);
-    val.newsize(maxnz, 1); chk_set_init(val, 1);
-    Integer ai = 0;
-    Integer a0 = (*Ainf)(ai, 0);
-    Integer bi = 0;
-    Integer b0 = (*Binf)(bi, 0);
-    Integer infnz = 0;
-    Integer nz = 0;
-    while ((a0 < maxnr) || (b0 < maxnr)) {
-      while (a0 < b0) {
-        inf(infnz, 0) = a0;
-        inf(infnz, 1) = (*Ainf)(ai, 1);
-        inf(infnz, 2) = nz;
-        Integer* indp = ind.get_store() + nz;
-        Real* valp = val.get_store() + nz;
-        nz += inf(infnz, 1);
-        const Integer* endp = ind.get_store() + nz;
-        const Integer* aip = Aind->get_store() + (*Ainf)(ai, 2);
-        const Real* avp = Aval->get_store() + (*Ainf)(ai, 2);
-        for (; indp != endp;) {
-          (*indp++) = (*aip++);
-          (*valp++) = alpha * (*avp++);
-        }
-        ai++;
-        a0 = (ai < (*Ainf).rowdim()) ? (*Ainf)(ai, 0) : maxnr;
-        infnz++;
-        continue;
-      }
-      while (b0 < a0) {
-        inf(infnz, 0) = b0;
-        inf(infnz, 1) = (*Binf)(bi, 1);
-        inf(infnz, 2) = nz;
-        Integer* indp = ind.get_store() + nz;
-        Real* valp = val.get_store() + nz;
-        nz += inf(infnz, 1);
-        const Integer* endp = ind.get_store() + nz;
-        const Integer* bip = Bind->get_store() + (*Binf)(bi, 2);
-        const Real* bvp = Bval->get_store() + (*Binf)(bi, 2);
-        for (; indp != endp;) {
-          (*indp++) = (*bip++);
-          (*valp++) = beta * (*bvp++);
-        }
-        bi++;
-        b0 = (bi < Binf->rowdim()) ? (*Binf)(bi, 0) : maxnr;
-        infnz++;
-        continue;
-      }
-      while ((a0 == b0) && (a0 != maxnr)) {
-        inf(infnz, 0) = a0;
-        inf(infnz, 1) = nz;  //stores the old value of nz temporarily
-        inf(infnz, 2) = nz;
-        Integer* indp = ind.get_store() + nz;
-        Real* valp = val.get_store() + nz;
-        const Integer* bip = Bind->get_store() + (*Binf)(bi, 2);
-        const Real* bvp = Bval->get_store() + (*Binf)(bi, 2);
-        const Integer* bend = bip + (*Binf)(bi, 1);
-        Integer bii = (bip != bend) ? (*bip++) : maxnc;
-        const Integer* aip = Aind->get_store() + (*Ainf)(ai, 2);
-        const Real* avp = Aval->get_store() + (*Ainf)(ai, 2);
-        const Integer* aend = aip + (*Ainf)(ai, 1);
-        Integer aii = (aip != aend) ? (*aip++) : maxnc;
-        while ((aii < maxnc) || (bii < maxnc)) {
-          while (aii < bii) {
-            (*indp++) = aii;
+    Integer maxnr;
+    Integer maxnc;
+    Integer ai;
+    Integer a0;
+    Integer bi;
+    Integer b0;
+    Integer infnz;
+    Integer nz;
+
+    //treat rows first (if lazy and not needed so far, the row representation stays dropped)
+    if (A.rowrep_valid) {
+      if (!Btrans)
+        B.need_rowrep();
+      Ainf = &(A.rowinfo);
+      Aind = &(A.rowindex);
+      Aval = &(A.rowval);
+      if (Btrans) {
+        Binf = &(B.colinfo);
+        Bind = &(B.colindex);
+        Bval = &(B.colval);
+      } else {
+        Binf = &(B.rowinfo);
+        Bind = &(B.rowindex);
+        Bval = &(B.rowval);
+      }
+      maxrows = min(Ainf->rowdim() + Binf->rowdim(), nr);
+      maxnr = nr;
+      maxnc = nc;
+      inf.newsize(maxrows, 3); chk_set_init(inf, 1);
+      ind.newsize(maxnz, 1); chk_set_init(ind, 1);
+      val.newsize(maxnz, 1); chk_set_init(val, 1);
+      ai = 0;
+      a0 = (*Ainf)(ai, 0);
+      bi = 0;
+      b0 = (*Binf)(bi, 0);
+      infnz = 0;
+      nz = 0;
+      while ((a0 < maxnr) || (b0 < maxnr)) {
+        while (a0 < b0) {
+          inf(infnz, 0) = a0;
+          inf(infnz, 1) = (*Ainf)(ai, 1);
+          inf(infnz, 2) = nz;
+          Integer* indp = ind.get_store() + nz;
+          Real* valp = val.get_store() + nz;
+          nz += inf(infnz, 1);
+          const Integer* endp = ind.get_store() + nz;
+          const Integer* aip = Aind->get_store() + (*Ainf)(ai, 2);
+          const Real* avp = Aval->get_store() + (*Ainf)(ai, 2);
+          for (; indp != endp;) {
+            (*indp++) = (*aip++);
             (*valp++) = alpha * (*avp++);
-            aii = (aip != aend) ? (*aip++) : maxnc;
-            nz++;
           }
-          while (bii < aii) {
-            (*indp++) = bii;
+          ai++;
+          a0 = (ai < (*Ainf).rowdim()) ? (*Ainf)(ai, 0) : maxnr;
+          infnz++;
+          continue;
+        }
+        while (b0 < a0) {
+          inf(infnz, 0) = b0;
+          inf(infnz, 1) = (*Binf)(bi, 1);
+          inf(infnz, 2) = nz;
+          Integer* indp = ind.get_store() + nz;
+          Real* valp = val.get_store() + nz;
+          nz += inf(infnz, 1);
+          const Integer* endp = ind.get_store() + nz;
+          const Integer* bip = Bind->get_store() + (*Binf)(bi, 2);
+          const Real* bvp = Bval->get_store() + (*Binf)(bi, 2);
+          for (; indp != endp;) {
+            (*indp++) = (*bip++);
             (*valp++) = beta * (*bvp++);
-            bii = (bip != bend) ? (*bip++) : maxnc;
-            nz++;
           }
-          while ((aii == bii) && (aii != maxnc)) {
-            (*indp++) = aii;
-            (*valp++) = alpha * (*avp++) + beta * (*bvp++);
-            aii = (aip != aend) ? (*aip++) : maxnc;
-            bii = (bip != bend) ? (*bip++) : maxnc;
-            nz++;
+          bi++;
+          b0 = (bi < Binf->rowdim()) ? (*Binf)(bi, 0) : maxnr;
+          infnz++;
+          continue;
+        }
+        while ((a0 == b0) && (a0 != maxnr)) {
+          inf(infnz, 0) = a0;
+          inf(infnz, 1) = nz;  //stores the old value of nz temporarily
+          inf(infnz, 2) = nz;
+          Integer* indp = ind.get_store() + nz;
+          Real* valp = val.get_store() + nz;
+          const Integer* bip = Bind->get_store() + (*Binf)(bi, 2);
+          const Real* bvp = Bval->get_store() + (*Binf)(bi, 2);
+          const Integer* bend = bip + (*Binf)(bi, 1);
+          Integer bii = (bip != bend) ? (*bip++) : maxnc;
+          const Integer* aip = Aind->get_store() + (*Ainf)(ai, 2);
+          const Real* avp = Aval->get_store() + (*Ainf)(ai, 2);
+          const Integer* aend = aip + (*Ainf)(ai, 1);
+          Integer aii = (aip != aend) ? (*aip++) : maxnc;
+          while ((aii < maxnc) || (bii < maxnc)) {
+            while (aii < bii) {
+              (*indp++) = aii;
+              (*valp++) = alpha * (*avp++);
+              aii = (aip != aend) ? (*aip++) : maxnc;
+              nz++;
+            }
+            while (bii < aii) {
+              (*indp++) = bii;
+              (*valp++) = beta * (*bvp++);
+              bii = (bip != bend) ? (*bip++) : maxnc;
+              nz++;
+            }
+            while ((aii == bii) && (aii != maxnc)) {
+              (*indp++) = aii;
+              (*valp++) = alpha * (*avp++) + beta * (*bvp++);
+              aii = (aip != aend) ? (*aip++) : maxnc;
+              bii = (bip != bend) ? (*bip++) : maxnc;
+              nz++;
+            }
           }
+          inf(infnz, 1) = nz - inf(infnz, 1);
+          infnz++;
+          bi++;
+          b0 = (bi < Binf->rowdim()) ? (*Binf)(bi, 0) : maxnr;
+          ai++;
+          a0 = (ai < Ainf->rowdim()) ? (*Ainf)(ai, 0) : maxnr;
         }
-        inf(infnz, 1) = nz - inf(infnz, 1);
-        infnz++;
-        bi++;
-        b0 = (bi < Binf->rowdim()) ? (*Binf)(bi, 0) : maxnr;
-        ai++;
-        a0 = (ai < Ainf->rowdim()) ? (*Ainf)(ai, 0) : maxnr;
       }
+      inf.delete_rows(Range(infnz, inf.rowdim() - 1));
+      A.rowinfo = inf;
+      ind.reduce_length(nz);
+      A.rowindex = ind;
+      val.reduce_length(nz);
+      A.rowval = val;
     }
-    inf.delete_rows(Range(infnz, inf.rowdim() - 1));
-    A.rowinfo = inf;
-    ind.reduce_length(nz);
-    A.rowindex = ind;
-    val.reduce_length(nz);
-    A.rowval = val;
 
     //next treat columns
     Ainf = &(A.colinfo);
     Aind = &(A.colindex);
     Aval = &(A.colval);
     if (Btrans) {
+      B.need_rowrep();
       Binf = &(B.rowinfo);
       Bind = &(B.rowindex);
       Bval = &(B.rowval);
@@ -343,6 +482,8 @@ namespace CH_Matrix_Classes {
     maxnr = nc;
     maxnc = nr;
     inf.newsize(maxrows, 3); chk_set_init(inf, 1);
+    ind.newsize(maxnz, 1); chk_set_init(ind, 1);
+    val.newsize(maxnz, 1); chk_set_init(val, 1);
     ai = 0;
     a0 = (*Ainf)(ai, 0);
     bi = 0;
@@ -481,8 +622,43 @@ namespace CH_Matrix_Classes {
       C.init(nr, nc, 0.);
     }
     if ((alpha == 0.) || (nr == 0) || (nc == 0) || (nm == 0)) return C;
+    if ((double(A.nonzeros()) * double(nc) >= double(sparseop_minwork)) &&
+      ((nc == 1) || (nc >= sparseop_minlen)) && ((atrans) || (A.rowrep_valid))) {
+      //rows of op(A) times the rows of op(B), which are the contiguous columns of B if btrans
+      const Indexmatrix& ainf = atrans ? A.colinfo : A.rowinfo;
+      const Indexmatrix& aind = atrans ? A.colindex : A.rowindex;
+      const Matrix& aval = atrans ? A.colval : A.rowval;
+      if ((btrans) || (nc == 1)) {
+        spop_gather(ainf.rowdim(), ainf.get_store(), aind.get_store(), aval.get_store(),
+          nc, alpha, B.get_store(), C.get_store(), 1, nr);
+        return C;
+      }
+      if (A.nonzeros() >= sparseop_mincopy * nm) {
+        Matrix P(nc, nm);
+        spop_transpose(nm, nc, B.get_store(), nm, P.get_store());
+        spop_gather(ainf.rowdim(), ainf.get_store(), aind.get_store(), aval.get_store(),
+          nc, alpha, P.get_store(), C.get_store(), 1, nr);
+        return C;
+      }
+    }
     if (atrans) {
-      if (nc == 1) {
+      if ((nc == 1) && (!A.rowrep_valid)) {
+        //lazy row representation, use inner products with the columns
+        const Integer* aip = A.colindex.get_store();
+        const Real* avp = A.colval.get_store();
+        Integer i = A.colinfo.rowdim();
+        const Integer* iip = A.colinfo.get_store();
+        const Integer* nzp = iip + i;
+        const Real* bp = B.get_store();
+        Real* cp = C.get_store();
+        for (; --i >= 0;) {
+          Real val = 0.;
+          for (Integer j = (*nzp++); --j >= 0;) {
+            val += *(bp + *aip++) * (*avp++);
+          }
+          *(cp + *iip++) += alpha * val;
+        }
+      } else if (nc == 1) {
         const Integer* aip = A.rowindex.get_store();
         const Real* avp = A.rowval.get_store();
         Integer i = A.rowinfo.rowdim();
@@ -549,6 +725,20 @@ namespace CH_Matrix_Classes {
             *(cp + *aip++) += val * (*avp++);
           }
         }
+      } else if (!A.rowrep_valid) {
+        //lazy row representation, add the rows of B to the rows of C columnwise
+        const Integer* aip = A.colindex.get_store();
+        const Real* avp = A.colval.get_store();
+        Integer i = A.colinfo.rowdim();
+        const Integer* iip = A.colinfo.get_store();
+        const Integer* nzp = iip + i;
+        for (; --i >= 0;) {
+          const Real* bp = btrans ? B.get_store() + (*iip++) * nc : B.get_store() + (*iip++);
+          const Integer binc = btrans ? 1 : nm;
+          for (Integer j = (*nzp++); --j >= 0;) {
+            mat_xpeya(nc, C.get_store() + (*aip++), nr, bp, binc, alpha * (*avp++));
+          }
+        }
       } else if (btrans) {
         const Integer* aip = A.rowindex.get_store();
         const Real* avp = A.rowval.get_store();
@@ -615,7 +805,23 @@ namespace CH_Matrix_Classes {
       mat_xmultea(nr, cp, beta);
     }
     if ((alpha == 0.) || (nr == 0) || (nm == 0) || (nc == 0)) return C;
-    if (atrans) {
+    if ((atrans) && (!A.rowrep_valid)) {
+      //lazy row representation, use inner products with the columns
+      const Integer* aip = A.colindex.get_store();
+      const Real* avp = A.colval.get_store();
+      Integer i = A.colinfo.rowdim();
+      const Integer* iip = A.colinfo.get_store();
+      const Integer* nzp = iip + i;
+      const Real* bp = btrans ? B.get_store() + colB : B.get_store() + colB * B.nr;
+      const Integer binc = btrans ? B.nr : 1;
+      for (; --i >= 0;) {
+        Real val = 0.;
+        for (Integer j = (*nzp++); --j >= 0;) {
+          val += *(bp + binc * (*aip++)) * (*avp++);
+        }
+        *(cp + *iip++) += alpha * val;
+      }
+    } else if (atrans) {
       if (btrans) {
         const Integer* aip = A.rowindex.get_store();
         const Real* avp = A.rowval.get_store();
@@ -738,7 +944,38 @@ namespace CH_Matrix_Classes {
     }
     if ((alpha == 0.) || (nr == 0) || (nm == 0) || (nc == 0))
       return C;
-    if (atrans) {
+    if ((double(B.nonzeros()) * double(nr) >= double(sparseop_minwork)) &&
+      ((nr == 1) || (nr >= sparseop_minlen)) && ((!btrans) || (B.rowrep_valid))) {
+      //each column of op(B) adds columns of op(A), which are contiguous unless atrans, to one column of C
+      const Indexmatrix& binf = btrans ? B.rowinfo : B.colinfo;
+      const Indexmatrix& bind = btrans ? B.rowindex : B.colindex;
+      const Matrix& bval = btrans ? B.rowval : B.colval;
+      if ((!atrans) || (nr == 1)) {
+        spop_gather(binf.rowdim(), binf.get_store(), bind.get_store(), bval.get_store(),
+          nr, alpha, A.get_store(), C.get_store(), nr, 1);
+        return C;
+      }
+      if (B.nonzeros() >= sparseop_mincopy * nm) {
+        Matrix P(nr, nm);
+        spop_transpose(nm, nr, A.get_store(), nm, P.get_store());
+        spop_gather(binf.rowdim(), binf.get_store(), bind.get_store(), bval.get_store(),
+          nr, alpha, P.get_store(), C.get_store(), nr, 1);
+        return C;
+      }
+    }
+    if ((btrans) && (!B.rowrep_valid)) {
+      //lazy row representation, add the columns of op(A) to the columns of C columnwise
+      const Integer* bip = B.colindex.get_store();
+      const Real* bvp = B.colval.get_store();
+      for (Integer i = 0; i < B.colinfo.rowdim(); i++) {
+        Integer ii = B.colinfo(i, 0);
+        const Real* ap = atrans ? A.get_store() + ii : A.get_store() + ii * nr;
+        const Integer ainc = atrans ? nm : 1;
+        for (Integer j = B.colinfo(i, 1); --j >= 0;) {
+          mat_xpeya(nr, C.get_store() + (*bip++) * nr, 1, ap, ainc, alpha * (*bvp++));
+        }
+      }
+    } else if (atrans) {
       if (btrans) { //A^T*B^T
         const Integer* bip = B.rowindex.get_store();
         const Real* bvp = B.rowval.get_store();
@@ -799,6 +1036,7 @@ namespace CH_Matrix_Classes {
     if (atrans) {
       nr = A.nc;
       nm = A.nr;
+      A.need_rowrep();
       ainf = &(A.rowinfo);
       aind = A.rowindex.get_store();
       aval = A.rowval.get_store();
@@ -820,6 +1058,7 @@ namespace CH_Matrix_Classes {
         MEmessage(MatrixError(ME_dim, "genmult: dimensions don't match", MTsparse));;
       }
 #endif
+      B.need_rowrep();
       binf = &(B.rowinfo);
       bind = B.rowindex.get_store();
       bval = B.rowval.get_store();
@@ -940,6 +1179,10 @@ namespace CH_Matrix_Classes {
       colinfo(2) = 0;
       colindex.init(1, 1, ini(0));
       colval.init(1, 1, va(0));
+      if (lazy_rowrep) {
+        drop_rowrep();
+        return *this;
+      }
       rowinfo.newsize(1, 3); chk_set_init(rowinfo, 1);
       rowinfo(0) = ini(0);
       rowinfo(1) = 1;
@@ -949,10 +1192,17 @@ namespace CH_Matrix_Classes {
       return *this;
     }
 
+    //with lazy_rowrep only the column representation is generated
+    const bool rows = !lazy_rowrep;
+    if (!rows)
+      drop_rowrep();
+
     colindex.newsize(nz, 1); chk_set_init(colindex, 1);
     colval.newsize(nz, 1); chk_set_init(colval, 1);
-    rowindex.newsize(nz, 1); chk_set_init(rowindex, 1);
-    rowval.newsize(nz, 1); chk_set_init(rowval, 1);
+    if (rows) {
+      rowindex.newsize(nz, 1); chk_set_init(rowindex, 1);
+      rowval.newsize(nz, 1); chk_set_init(rowval, 1);
+    }
 
     Integer i;
 
@@ -963,11 +1213,13 @@ namespace CH_Matrix_Classes {
     colindex.init(nz, 1, inj.get_store());   //has to be copied, because length of inj unknown
     //values inj*nr+ini might be too big for large nr and nc
     sortindex(colindex, sindc);
-    rowindex.init(nz, 1, ini.get_store());   //has to be copied, because length of ini unknown
-    sortindex(rowindex, sindr);
+    if (rows) {
+      rowindex.init(nz, 1, ini.get_store());   //has to be copied, because length of ini unknown
+      sortindex(rowindex, sindr);
+    }
 
     Integer lastcval = inj(sindc(0));  //holds last column index encountered
-    Integer lastrval = ini(sindr(0));  //holds last row index encountered
+    Integer lastrval = rows ? ini(sindr(0)) : 0;  //holds last row index encountered
     Integer colcnt = 0;                //counts number of columns
     Integer rowcnt = 0;                //counts number of rows
     Integer cntcelems = 1;             //counts number of elements in current column
@@ -988,6 +1240,8 @@ namespace CH_Matrix_Classes {
       } else {
         cntcelems++;
       }
+      if (!rows)
+        continue;
       if (lastrval != ini(sindr(i))) {  //new column starts
         rowindex(rowcnt) = cntrelems;
         //sort indices in this row in increasing colindex order
@@ -1007,12 +1261,14 @@ namespace CH_Matrix_Classes {
     //heapsort(cntcelems,sindp,ini.get_store());
     std::sort(sindp, sindp + cntcelems, mat_less_index<Integer>(ini.get_store()));
     colcnt++;
-    rowindex(rowcnt) = cntrelems;
-    //sort indices in this row in increasing colindex order
-    sindp = sindr.get_store() + i - cntrelems;
-    //heapsort(cntrelems,sindp,inj.get_store());
-    std::sort(sindp, sindp + cntrelems, mat_less_index<Integer>(inj.get_store()));
-    rowcnt++;
+    if (rows) {
+      rowindex(rowcnt) = cntrelems;
+      //sort indices in this row in increasing colindex order
+      sindp = sindr.get_store() + i - cntrelems;
+      //heapsort(cntrelems,sindp,inj.get_store());
+      std::sort(sindp, sindp + cntrelems, mat_less_index<Integer>(inj.get_store()));
+      rowcnt++;
+    }
 
     //--- initialize colinfo, colindex and colval to final values
     colinfo.newsize(colcnt, 3); chk_set_init(colinfo, 1);
@@ -1068,6 +1324,8 @@ namespace CH_Matrix_Classes {
     if (colcnt < colinfo.rowdim()) {
       colinfo.delete_rows(Range(colcnt, colinfo.rowdim() - 1));
     }
+    if (!rows)
+      return *this;
 
     //--- initialize rowinfo, rowindex and rowval to final values
     rowinfo.newsize(rowcnt, 3); chk_set_init(rowinfo, 1);
@@ -1128,6 +1386,7 @@ namespace CH_Matrix_Classes {
   }
 
   void Sparsemat::get_edge_rep(Indexmatrix& I, Indexmatrix& J, Matrix& val) const {
+    need_rowrep();
     I.newsize(rowindex.dim(), 1); chk_set_init(I, 1);
     J.newsize(rowindex.dim(), 1); chk_set_init(J, 1);
     val.newsize(rowindex.dim(), 1); chk_set_init(val, 1);
@@ -1146,6 +1405,7 @@ namespace CH_Matrix_Classes {
   }
 
   int Sparsemat::get_edge(Integer e, Integer& indi, Integer& indj, Real& val) const {
+    need_rowrep();
     if ((e < 0) || (e >= rowinfo.dim()))
       return 1;
     val = rowval(e);//includes initialization and range check for e
@@ -1187,7 +1447,7 @@ namespace CH_Matrix_Classes {
     if ((colinfo.rowdim() == 0) && (A.colinfo.rowdim() == 0)) return 1;
     if (colval.rowdim() < A.colval.rowdim()) return 0;
     if (colinfo.rowdim() < A.colinfo.rowdim()) return 0;
-    if (rowinfo.rowdim() < A.rowinfo.rowdim()) return 0;
+    if ((rowrep_valid) && (A.rowrep_valid) && (rowinfo.rowdim() < A.rowinfo.rowdim())) return 0;
     Integer cind1 = 0;
     Integer cind2 = 0;
     Integer cv1 = colinfo(cind1);
@@ -1246,11 +1506,14 @@ namespace CH_Matrix_Classes {
   Real Sparsemat::operator()(Integer i, Integer j) const {
     chk_init(*this);
     chk_range(i, j, nr, nc);
-    Integer nrows = rowinfo.rowdim();
-    if (nrows == 0) return 0.;
     Integer ncols = colinfo.rowdim();
-    if ((i < rowinfo(0, 0)) || (i > rowinfo(nrows - 1, 0))) return 0.;
+    if (ncols == 0) return 0.;
     if ((j < colinfo(0, 0)) || (j > colinfo(ncols - 1, 0))) return 0.;
+    Integer nrows = ncols + 1;  //without row representation search the column
+    if (rowrep_valid) {
+      nrows = rowinfo.rowdim();
+      if ((i < rowinfo(0, 0)) || (i > rowinfo(nrows - 1, 0))) return 0.;
+    }
     if (nrows <= ncols) {
       Integer li = 0;
       Integer ui = nrows - 1;
@@ -1338,6 +1601,7 @@ namespace CH_Matrix_Classes {
   Integer Sparsemat::row_nonzeros(Integer ri, Integer* fi) const {
     chk_init(*this);
     chk_single_range(ri, nr);
+    need_rowrep();
     if (fi != 0) *fi = -1;
     if (rowinfo.dim() == 0) return 0; //no nonzero rows
     if ((ri < rowinfo(0, 0)) || (ri > rowinfo(rowinfo.rowdim() - 1, 0))) return 0;
@@ -1418,6 +1682,7 @@ namespace CH_Matrix_Classes {
       MEmessage(MatrixError(ME_unspec, "Sparsemat::row(Integer ri): n==0 or m==0", MTsparse));
     }
     chk_range(ri, 0, nr, nc);
+    need_rowrep();
     Sparsemat A;
     A.nr = 1;
     A.nc = nc;
@@ -1525,6 +1790,7 @@ namespace CH_Matrix_Classes {
       MEmessage(MatrixError(ME_unspec, "Sparsemat::rows(const Indexmatrix& ind): ind exceeds range", MTsparse));
     }
 #endif
+    need_rowrep();
     if ((ind.dim() == 0) || (rowinfo.rowdim() == 0)) return Sparsemat(ind.dim(), nc);
     if (ind.dim() == 1) return this->row(ind(0));
     //find nonzero rows and number of nonzeros
@@ -1591,7 +1857,7 @@ namespace CH_Matrix_Classes {
     Indexmatrix delinfo;
     Integer sinddim = sind.dim();
     Integer newnz = nonzeros();
-    {
+    if (rowrep_valid) {
       Integer sindi = 0;
       Integer sindival = sind(sindi);
       Integer i = 0;
@@ -1622,10 +1888,10 @@ namespace CH_Matrix_Classes {
         }
         newnz += nz;
       }
+      rowinfo.delete_rows(delinfo);
+      rowindex.reduce_length(newnz);
+      rowval.reduce_length(newnz);
     }
-    rowinfo.delete_rows(delinfo);
-    rowindex.reduce_length(newnz);
-    rowval.reduce_length(newnz);
 
     //------------ change the column info
     //compute log 2 of sind.dim()
@@ -1768,74 +2034,76 @@ namespace CH_Matrix_Classes {
       for (Integer i = sind.dim(); (i >>= 1) > 0; log2++) {
       }
     }
-    newnz = 0;
-    Integer* nrip = rowindex.get_store();  //new row index pointer
-    Real* nrvp = rowval.get_store();       //new row value pointer
-    Integer* orip = nrip;                  //old ...
-    Real* orvp = nrvp;
-    delinfo.init(0, 0, Integer(0));
-    for (Integer j = 0; j < rowinfo.rowdim(); j++) {
-      Integer nz = rowinfo(j, 1);
-      rowinfo(j, 2) = newnz;
-      Integer sindi = 0;
-      Integer* sindp = sind.get_store();
-      Integer sindival = (*sindp++);
-      if (nz * log2 >= sind.dim()) {
-        //it is more efficient to search for deleted indices going through all indices in sind
-        for (Integer i = nz; --i >= 0;) {
-          Integer indi = (*orip++);
-          while (indi > sindival) {
-            if (++sindi < sinddim) {
-              sindival = (*sindp++);
-            } else {
-              sindival = nc + 1;
+    if (rowrep_valid) {
+      newnz = 0;
+      Integer* nrip = rowindex.get_store();  //new row index pointer
+      Real* nrvp = rowval.get_store();       //new row value pointer
+      Integer* orip = nrip;                  //old ...
+      Real* orvp = nrvp;
+      delinfo.init(0, 0, Integer(0));
+      for (Integer j = 0; j < rowinfo.rowdim(); j++) {
+        Integer nz = rowinfo(j, 1);
+        rowinfo(j, 2) = newnz;
+        Integer sindi = 0;
+        Integer* sindp = sind.get_store();
+        Integer sindival = (*sindp++);
+        if (nz * log2 >= sind.dim()) {
+          //it is more efficient to search for deleted indices going through all indices in sind
+          for (Integer i = nz; --i >= 0;) {
+            Integer indi = (*orip++);
+            while (indi > sindival) {
+              if (++sindi < sinddim) {
+                sindival = (*sindp++);
+              } else {
+                sindival = nc + 1;
+              }
             }
-          }
-          if (sindival == indi) {
-            orvp++;
-            continue;
-          }
-          (*nrip++) = indi - sindi;
-          (*nrvp++) = (*orvp++);
-          newnz++;
-        }
-      } else {
-        //it is more efficient to search in sind, whether the current index appears there 
-        Integer lb = 0;
-        for (Integer i = nz; --i >= 0;) {
-          Integer indi = (*orip++);
-          Integer ub = sind.dim() - 1;
-          while ((lb <= ub) && (indi > sind(lb))) {
-            Integer ii = (lb + ub) / 2;
-            if (sind(ii) < indi) {
-              lb = ii + 1;
+            if (sindival == indi) {
+              orvp++;
               continue;
             }
-            if (sind(ii) > indi) {
-              ub = ii - 1;
+            (*nrip++) = indi - sindi;
+            (*nrvp++) = (*orvp++);
+            newnz++;
+          }
+        } else {
+          //it is more efficient to search in sind, whether the current index appears there 
+          Integer lb = 0;
+          for (Integer i = nz; --i >= 0;) {
+            Integer indi = (*orip++);
+            Integer ub = sind.dim() - 1;
+            while ((lb <= ub) && (indi > sind(lb))) {
+              Integer ii = (lb + ub) / 2;
+              if (sind(ii) < indi) {
+                lb = ii + 1;
+                continue;
+              }
+              if (sind(ii) > indi) {
+                ub = ii - 1;
+                continue;
+              }
+              lb = ii;
+              break;
+            }
+            if ((lb <= ub) && (indi == sind(lb))) { //entry has to be deleted
+              orvp++;
               continue;
             }
-            lb = ii;
-            break;
-          }
-          if ((lb <= ub) && (indi == sind(lb))) { //entry has to be deleted
-            orvp++;
-            continue;
+            (*nrip++) = indi - lb;
+            (*nrvp++) = (*orvp++);
+            newnz++;
           }
-          (*nrip++) = indi - lb;
-          (*nrvp++) = (*orvp++);
-          newnz++;
         }
+        nz = newnz - rowinfo(j, 2);
+        if (nz == 0) {
+          delinfo.concat_below(j);
+        }
+        rowinfo(j, 1) = nz;
       }
-      nz = newnz - rowinfo(j, 2);
-      if (nz == 0) {
-        delinfo.concat_below(j);
-      }
-      rowinfo(j, 1) = nz;
+      rowinfo.delete_rows(delinfo);
+      rowindex.reduce_length(newnz);
+      rowval.reduce_length(newnz);
     }
-    rowinfo.delete_rows(delinfo);
-    rowindex.reduce_length(newnz);
-    rowval.reduce_length(newnz);
 
     nc -= ind.dim();
 
@@ -1854,6 +2122,7 @@ namespace CH_Matrix_Classes {
       MEmessage(MatrixError(ME_unspec, "Sparsemat::insert_row(Integer i,const Sparsemat& v): v is not a vector", MTsparse));
     }
 #endif
+    need_rowrep();
     if ((rowinfo.rowdim() > 0) && (i > rowinfo(rowinfo.rowdim() - 1, 0)) && (v.nonzeros() == 0)) {
       nr++;
       return *this;
@@ -1955,16 +2224,37 @@ namespace CH_Matrix_Classes {
       colinfo(i, 2) += oldnz;
     }
 
-    //row representation
-    infonr = 0;
-    Integer thisi = 0;
-    Integer thisind = nr;
-    if (thisi < rowinfo.rowdim()) thisind = rowinfo(thisi, 0);
-    Integer Ai = 0;
-    Integer Aind = nr;
-    if (Ai < A.rowinfo.rowdim()) Aind = A.rowinfo(Ai, 0);
-    while ((thisind < nr) || (Aind < nr)) {
-      if (thisind < Aind) {
+    //row representation (only if available)
+    if (rowrep_valid) {
+      A.need_rowrep();
+      infonr = 0;
+      Integer thisi = 0;
+      Integer thisind = nr;
+      if (thisi < rowinfo.rowdim()) thisind = rowinfo(thisi, 0);
+      Integer Ai = 0;
+      Integer Aind = nr;
+      if (Ai < A.rowinfo.rowdim()) Aind = A.rowinfo(Ai, 0);
+      while ((thisind < nr) || (Aind < nr)) {
+        if (thisind < Aind) {
+          infonr++;
+          thisi++;
+          if (thisi < rowinfo.rowdim()) {
+            thisind = rowinfo(thisi, 0);
+          } else {
+            thisind = nr;
+          }
+          continue;
+        }
+        if (thisind > Aind) {
+          infonr++;
+          Ai++;
+          if (Ai < A.rowinfo.rowdim()) {
+            Aind = A.rowinfo(Ai, 0);
+          } else {
+            Aind = nr;
+          }
+          continue;
+        }
         infonr++;
         thisi++;
         if (thisi < rowinfo.rowdim()) {
@@ -1972,70 +2262,86 @@ namespace CH_Matrix_Classes {
         } else {
           thisind = nr;
         }
-        continue;
-      }
-      if (thisind > Aind) {
-        infonr++;
         Ai++;
         if (Ai < A.rowinfo.rowdim()) {
           Aind = A.rowinfo(Ai, 0);
         } else {
           Aind = nr;
         }
-        continue;
-      }
-      infonr++;
-      thisi++;
-      if (thisi < rowinfo.rowdim()) {
-        thisind = rowinfo(thisi, 0);
-      } else {
-        thisind = nr;
       }
-      Ai++;
-      if (Ai < A.rowinfo.rowdim()) {
-        Aind = A.rowinfo(Ai, 0);
-      } else {
-        Aind = nr;
-      }
-    }
 
-    int free_oldip = 0;
-    Integer* oldip = rowindex.get_store();
-    if (rowindex.mem_dim < rowindex.dim() + A.rowindex.dim()) {
-      rowindex.mem_dim = Integer(rowindex.memarray->get(rowindex.dim() + A.rowindex.dim(), rowindex.m));
-      if (rowindex.mem_dim < rowindex.dim() + A.rowindex.dim()) {
-        MEmessage(MEmem(rowindex.dim() + A.rowindex.dim(),
-          "Matrix::concat_right(const Matrix&) not enough memory",
-          MTmatrix));
-      }
-      free_oldip = 1;
-    }
-    int free_oldvp = 0;
-    Real* oldvp = rowval.get_store();
-    if (rowval.mem_dim < rowval.dim() + A.rowval.dim()) {
-      rowval.mem_dim = Integer(rowval.memarray->get(rowval.dim() + A.rowval.dim(), rowval.m));
+      int free_oldip = 0;
+      Integer* oldip = rowindex.get_store();
       if (rowindex.mem_dim < rowindex.dim() + A.rowindex.dim()) {
-        MEmessage(MEmem(rowindex.dim() + A.rowindex.dim(),
-          "Matrix::concat_right(const Matrix&) not enough memory",
-          MTmatrix));
-      }
-      free_oldvp = 1;
-    }
-    Indexmatrix tmpinfo(infonr, 3); chk_set_init(tmpinfo, 1);
-    Integer newnz = rowindex.dim() + A.rowindex.dim();
-    rowindex.nc = 1; rowindex.nr = newnz;
-    rowval.nc = 1; rowval.nr = newnz;
-    thisi = rowinfo.rowdim();
-    thisind = -1;
-    if (--thisi >= 0) thisind = rowinfo(thisi, 0);
-    Ai = A.rowinfo.rowdim();
-    Aind = -1;
-    if (--Ai >= 0) Aind = A.rowinfo(Ai, 0);
-    while ((Aind >= 0) || (thisind >= 0)) {
-      if (thisind > Aind) {
-        --infonr;
+        rowindex.mem_dim = Integer(rowindex.memarray->get(rowindex.dim() + A.rowindex.dim(), rowindex.m));
+        if (rowindex.mem_dim < rowindex.dim() + A.rowindex.dim()) {
+          MEmessage(MEmem(rowindex.dim() + A.rowindex.dim(),
+            "Matrix::concat_right(const Matrix&) not enough memory",
+            MTmatrix));
+        }
+        free_oldip = 1;
+      }
+      int free_oldvp = 0;
+      Real* oldvp = rowval.get_store();
+      if (rowval.mem_dim < rowval.dim() + A.rowval.dim()) {
+        rowval.mem_dim = Integer(rowval.memarray->get(rowval.dim() + A.rowval.dim(), rowval.m));
+        if (rowindex.mem_dim < rowindex.dim() + A.rowindex.dim()) {
+          MEmessage(MEmem(rowindex.dim() + A.rowindex.dim(),
+            "Matrix::concat_right(const Matrix&) not enough memory",
+            MTmatrix));
+        }
+        free_oldvp = 1;
+      }
+      Indexmatrix tmpinfo(infonr, 3); chk_set_init(tmpinfo, 1);
+      Integer newnz = rowindex.dim() + A.rowindex.dim();
+      rowindex.nc = 1; rowindex.nr = newnz;
+      rowval.nc = 1; rowval.nr = newnz;
+      thisi = rowinfo.rowdim();
+      thisind = -1;
+      if (--thisi >= 0) thisind = rowinfo(thisi, 0);
+      Ai = A.rowinfo.rowdim();
+      Aind = -1;
+      if (--Ai >= 0) Aind = A.rowinfo(Ai, 0);
+      while ((Aind >= 0) || (thisind >= 0)) {
+        if (thisind > Aind) {
+          --infonr;
+          tmpinfo(infonr, 0) = rowinfo(thisi, 0);
+          tmpinfo(infonr, 1) = rowinfo(thisi, 1);
+          newnz -= rowinfo(thisi, 1);
+          mat_xey(rowinfo(thisi, 1), rowindex.get_store() + newnz + rowinfo(thisi, 1) - 1, -1, oldip + rowinfo(thisi, 2) + rowinfo(thisi, 1) - 1, -1);
+          mat_xey(rowinfo(thisi, 1), rowval.get_store() + newnz + rowinfo(thisi, 1) - 1, -1, oldvp + rowinfo(thisi, 2) + rowinfo(thisi, 1) - 1, -1);
+          tmpinfo(infonr, 2) = newnz;
+          if (--thisi >= 0) {
+            thisind = rowinfo(thisi, 0);
+          } else {
+            thisind = -1;
+          }
+          continue;
+        }
+        if (thisind < Aind) {
+          --infonr;
+          tmpinfo(infonr, 0) = A.rowinfo(Ai, 0);
+          tmpinfo(infonr, 1) = A.rowinfo(Ai, 1);
+          newnz -= A.rowinfo(Ai, 1);
+          mat_xey(A.rowinfo(Ai, 1), rowindex.get_store() + newnz, A.rowindex.get_store() + A.rowinfo(Ai, 2));
+          mat_xpea(A.rowinfo(Ai, 1), rowindex.get_store() + newnz, nc);
+          mat_xey(A.rowinfo(Ai, 1), rowval.get_store() + newnz, A.rowval.get_store() + A.rowinfo(Ai, 2));
+          tmpinfo(infonr, 2) = newnz;
+          if (--Ai >= 0) {
+            Aind = A.rowinfo(Ai, 0);
+          } else {
+            Aind = -1;
+          }
+          continue;
+        }
+        infonr--;
         tmpinfo(infonr, 0) = rowinfo(thisi, 0);
-        tmpinfo(infonr, 1) = rowinfo(thisi, 1);
+        tmpinfo(infonr, 1) = A.rowinfo(Ai, 1);
+        newnz -= A.rowinfo(Ai, 1);
+        mat_xey(A.rowinfo(Ai, 1), rowindex.get_store() + newnz, A.rowindex.get_store() + A.rowinfo(Ai, 2));
+        mat_xpea(A.rowinfo(Ai, 1), rowindex.get_store() + newnz, nc);
+        mat_xey(A.rowinfo(Ai, 1), rowval.get_store() + newnz, A.rowval.get_store() + A.rowinfo(Ai, 2));
+        tmpinfo(infonr, 1) += rowinfo(thisi, 1);
         newnz -= rowinfo(thisi, 1);
         mat_xey(rowinfo(thisi, 1), rowindex.get_store() + newnz + rowinfo(thisi, 1) - 1, -1, oldip + rowinfo(thisi, 2) + rowinfo(thisi, 1) - 1, -1);
         mat_xey(rowinfo(thisi, 1), rowval.get_store() + newnz + rowinfo(thisi, 1) - 1, -1, oldvp + rowinfo(thisi, 2) + rowinfo(thisi, 1) - 1, -1);
@@ -2045,55 +2351,21 @@ namespace CH_Matrix_Classes {
         } else {
           thisind = -1;
         }
-        continue;
-      }
-      if (thisind < Aind) {
-        --infonr;
-        tmpinfo(infonr, 0) = A.rowinfo(Ai, 0);
-        tmpinfo(infonr, 1) = A.rowinfo(Ai, 1);
-        newnz -= A.rowinfo(Ai, 1);
-        mat_xey(A.rowinfo(Ai, 1), rowindex.get_store() + newnz, A.rowindex.get_store() + A.rowinfo(Ai, 2));
-        mat_xpea(A.rowinfo(Ai, 1), rowindex.get_store() + newnz, nc);
-        mat_xey(A.rowinfo(Ai, 1), rowval.get_store() + newnz, A.rowval.get_store() + A.rowinfo(Ai, 2));
-        tmpinfo(infonr, 2) = newnz;
         if (--Ai >= 0) {
           Aind = A.rowinfo(Ai, 0);
         } else {
           Aind = -1;
         }
-        continue;
       }
-      infonr--;
-      tmpinfo(infonr, 0) = rowinfo(thisi, 0);
-      tmpinfo(infonr, 1) = A.rowinfo(Ai, 1);
-      newnz -= A.rowinfo(Ai, 1);
-      mat_xey(A.rowinfo(Ai, 1), rowindex.get_store() + newnz, A.rowindex.get_store() + A.rowinfo(Ai, 2));
-      mat_xpea(A.rowinfo(Ai, 1), rowindex.get_store() + newnz, nc);
-      mat_xey(A.rowinfo(Ai, 1), rowval.get_store() + newnz, A.rowval.get_store() + A.rowinfo(Ai, 2));
-      tmpinfo(infonr, 1) += rowinfo(thisi, 1);
-      newnz -= rowinfo(thisi, 1);
-      mat_xey(rowinfo(thisi, 1), rowindex.get_store() + newnz + rowinfo(thisi, 1) - 1, -1, oldip + rowinfo(thisi, 2) + rowinfo(thisi, 1) - 1, -1);
-      mat_xey(rowinfo(thisi, 1), rowval.get_store() + newnz + rowinfo(thisi, 1) - 1, -1, oldvp + rowinfo(thisi, 2) + rowinfo(thisi, 1) - 1, -1);
-      tmpinfo(infonr, 2) = newnz;
-      if (--thisi >= 0) {
-        thisind = rowinfo(thisi, 0);
-      } else {
-        thisind = -1;
+      swap(tmpinfo, rowinfo);
+
+      if (free_oldip) {
+        rowindex.memarray->free(oldip);
       }
-      if (--Ai >= 0) {
-        Aind = A.rowinfo(Ai, 0);
-      } else {
-        Aind = -1;
+      if (free_oldvp) {
+        rowval.memarray->free(oldvp);
       }
     }
-    swap(tmpinfo, rowinfo);
-
-    if (free_oldip) {
-      rowindex.memarray->free(oldip);
-    }
-    if (free_oldvp) {
-      rowval.memarray->free(oldvp);
-    }
 
     nc += A.nc;
 
@@ -2118,20 +2390,23 @@ namespace CH_Matrix_Classes {
       nr += A.nr;
       return *this;
     }
-    //row representation
-    Integer infonr = rowinfo.rowdim();
-    Integer oldnz = rowindex.dim();
-    rowinfo.concat_below(A.rowinfo);
-    rowval.concat_below(A.rowval);
-    rowindex.concat_below(A.rowindex);
-    for (Integer i = infonr; i < rowinfo.rowdim(); i++) {
-      rowinfo(i, 0) += nr;
-      rowinfo(i, 2) += oldnz;
+    //row representation (only if available)
+    if (rowrep_valid) {
+      A.need_rowrep();
+      Integer infonr = rowinfo.rowdim();
+      Integer oldnz = rowindex.dim();
+      rowinfo.concat_below(A.rowinfo);
+      rowval.concat_below(A.rowval);
+      rowindex.concat_below(A.rowindex);
+      for (Integer i = infonr; i < rowinfo.rowdim(); i++) {
+        rowinfo(i, 0) += nr;
+        rowinfo(i, 2) += oldnz;
+      }
     }
 
     //column representation
     //determin joint number of columns in infonr
-    infonr = 0;
+    Integer infonr = 0;
     Integer thisi = 0;
     Integer thisind = nc;
     if (thisi < colinfo.rowdim()) thisind = colinfo(thisi, 0);
@@ -2279,6 +2554,7 @@ namespace CH_Matrix_Classes {
 
   Sparsemat operator*(const Sparsemat& A, const Sparsemat& B) {
     chk_mult(A, B);
+    A.need_rowrep();
     Sparsemat C;
     C.nr = A.nr;
     C.nc = B.nc;
@@ -2386,6 +2662,7 @@ namespace CH_Matrix_Classes {
     if (precision == 0) precision = 4;
     if (width == 0) width = precision + 6;
     if (screenwidth == 0) screenwidth = 80;
+    need_rowrep();
     out.precision(precision);
     out << "Sparsemat:" << nr << " " << nc << " " << rowindex.dim() << "\n";
     Integer i, j, nz = 0;
@@ -2485,11 +2762,13 @@ namespace CH_Matrix_Classes {
     chk_init(*this);
     chk_init(vec);
 
-    Integer ncnt = 0;
-    for (Integer i = 0; i < rowinfo.rowdim(); i++) {
-      Real d = vec(rowinfo(i, 0));
-      for (Integer j = rowinfo(i, 1); --j >= 0; ncnt++) {
-        rowval(ncnt) *= d;
+    if (rowrep_valid) {
+      Integer ncnt = 0;
+      for (Integer i = 0; i < rowinfo.rowdim(); i++) {
+        Real d = vec(rowinfo(i, 0));
+        for (Integer j = rowinfo(i, 1); --j >= 0; ncnt++) {
+          rowval(ncnt) *= d;
+        }
       }
     }
     {
@@ -2512,7 +2791,7 @@ namespace CH_Matrix_Classes {
         colval(ncnt) *= d;
       }
     }
-    {
+    if (rowrep_valid) {
       for (Integer ncnt = 0; ncnt < rowval.dim(); ncnt++) {
         rowval(ncnt) *= vec(rowindex(ncnt));
       }
@@ -2534,6 +2813,8 @@ namespace CH_Matrix_Classes {
     swap(A.rowindex, B.rowindex);
     swap(A.rowval, B.rowval);
     Real d = A.tol; A.tol = B.tol; B.tol = d;
+    bool b = A.lazy_rowrep; A.lazy_rowrep = B.lazy_rowrep; B.lazy_rowrep = b;
+    b = A.rowrep_valid; A.rowrep_valid = bool(B.rowrep_valid); B.rowrep_valid = b;
 #if (CONICBUNDLE_DEBUG>=1)
     bool bo = A.is_init; A.is_init = B.is_init; B.is_init = bo;
 #endif
@@ -2544,7 +2825,7 @@ namespace CH_Matrix_Classes {
     chk_init(A);
     Integer i;
     Real s = 0.;
-    if (A.rowinfo.rowdim() <= A.colinfo.rowdim()) {
+    if ((A.rowrep_valid) && (A.rowinfo.rowdim() <= A.colinfo.rowdim())) {
       for (i = 0; i < A.rowinfo.rowdim(); i++) {
         Integer rind = A.rowinfo(i, 0);
         if (rind >= A.nc) return s;
@@ -2588,20 +2869,28 @@ namespace CH_Matrix_Classes {
     chk_add(A, B);
     if (&A == &B)
       return mat_ip(A.colval.dim(), A.colval.get_store(), A.colval.get_store());
+    //use the row representations if both are available, the column representations otherwise
+    const bool rows = (A.rowrep_valid) && (B.rowrep_valid);
+    const Indexmatrix& Ainf = rows ? A.rowinfo : A.colinfo;
+    const Indexmatrix& Aind = rows ? A.rowindex : A.colindex;
+    const Matrix& Aval = rows ? A.rowval : A.colval;
+    const Indexmatrix& Binf = rows ? B.rowinfo : B.colinfo;
+    const Indexmatrix& Bind = rows ? B.rowindex : B.colindex;
+    const Matrix& Bval = rows ? B.rowval : B.colval;
     Integer ai = 0, bi = 0;
     Real s = 0.;
-    while ((ai < A.rowinfo.rowdim()) && (bi < B.rowinfo.rowdim())) {
-      if (A.rowinfo(ai, 0) == B.rowinfo(bi, 0)) {
-        Integer aj = A.rowinfo(ai, 2);
-        Integer au = aj + A.rowinfo(ai, 1);
-        Integer bj = B.rowinfo(bi, 2);
-        Integer bu = bj + B.rowinfo(bi, 1);
+    while ((ai < Ainf.rowdim()) && (bi < Binf.rowdim())) {
+      if (Ainf(ai, 0) == Binf(bi, 0)) {
+        Integer aj = Ainf(ai, 2);
+        Integer au = aj + Ainf(ai, 1);
+        Integer bj = Binf(bi, 2);
+        Integer bu = bj + Binf(bi, 1);
         while ((aj < au) && (bj < bu)) {
-          if (A.rowindex(aj) == B.rowindex(bj)) {
-            s += A.rowval(aj) * B.rowval(bj);
+          if (Aind(aj) == Bind(bj)) {
+            s += Aval(aj) * Bval(bj);
             aj++;
             bj++;
-          } else if (A.rowindex(aj) < B.rowindex(bj)) {
+          } else if (Aind(aj) < Bind(bj)) {
             aj++;
           } else {
             bj++;
@@ -2609,7 +2898,7 @@ namespace CH_Matrix_Classes {
         }
         ai++;
         bi++;
-      } else if (A.rowinfo(ai, 0) < B.rowinfo(bi, 0)) {
+      } else if (Ainf(ai, 0) < Binf(bi, 0)) {
         ai++;
       } else {
         bi++;
@@ -2704,6 +2993,7 @@ namespace CH_Matrix_Classes {
     assert((scaling == 0) || (scaling->dim() == A.nc));
     if (A.nonzeros() == 0)
       return Sparsemat(A.nr, 1);
+    A.need_rowrep();
     Indexmatrix indi(A.rowinfo.rowdim(), 1); chk_set_init(indi, 1);
     Indexmatrix indj(indi.dim(), 1, Integer(0));
     Matrix val(indi.dim(), 1); chk_set_init(val, 1);
@@ -2743,6 +3033,14 @@ namespace CH_Matrix_Classes {
   {
     chk_init(A);
     Matrix sc(A.nr, 1, 0.);
+    if (!A.rowrep_valid) {
+      const Integer* aip = A.colindex.get_store();
+      const Real* avp = A.colval.get_store();
+      for (Integer j = A.colval.dim(); --j >= 0;) {
+        sc(*aip++) += *avp++;
+      }
+      return sc;
+    }
     for (Integer j = 0; j < A.rowinfo.rowdim(); j++) {
       sc(A.rowinfo(j, 0)) = mat_sum(A.rowinfo(j, 1), A.rowval.get_store() + A.rowinfo(j, 2));
     }
@@ -2752,21 +3050,27 @@ namespace CH_Matrix_Classes {
   Sparsemat abs(const Sparsemat& A) {
     chk_init(A);
     Sparsemat B(A.nr, A.nc);
-    B.rowinfo = A.rowinfo;
     B.colinfo = A.colinfo;
-    B.rowindex = A.rowindex;
     B.colindex = A.colindex;
-    B.rowval.newsize(A.rowval.dim(), 1); chk_set_init(B.rowval, 1);
     B.colval.newsize(A.colval.dim(), 1); chk_set_init(B.colval, 1);
-    Real* br = B.rowval.get_store();
-    const Real* ar = A.rowval.get_store();
     Real* bc = B.colval.get_store();
     const Real* ac = A.colval.get_store();
-    Integer i = A.rowval.dim();
+    Integer i = A.colval.dim();
     for (; --i >= 0;) {
-      *br++ = abs(*ar++);
       *bc++ = abs(*ac++);
     }
+    if (!A.rowrep_valid) {
+      B.make_rowrep();
+      return B;
+    }
+    B.rowinfo = A.rowinfo;
+    B.rowindex = A.rowindex;
+    B.rowval.newsize(A.rowval.dim(), 1); chk_set_init(B.rowval, 1);
+    Real* br = B.rowval.get_store();
+    const Real* ar = A.rowval.get_store();
+    for (i = A.rowval.dim(); --i >= 0;) {
+      *br++ = abs(*ar++);
+    }
     return B;
   }
 
@@ -2797,6 +3101,7 @@ namespace CH_Matrix_Classes {
 
   std::ostream& operator<<(std::ostream& o, const Sparsemat& A) {
     chk_init(A);
+    A.need_rowrep();
     o << A.nr << " " << A.nc << " " << A.rowval.dim() << "\n";
     Integer i, j, nz = 0;
     for (i = 0; i < A.rowinfo.rowdim(); i++) {
@@ -3242,6 +3547,7 @@ namespace CH_Matrix_Classes {
     }
     if (alpha == 0.) return C;
     if (btrans) {
+      B.need_rowrep();
       const Integer* bip = B.rowindex.get_store();
       const Real* bvp = B.rowval.get_store();
       for (Integer j = 0; j < B.rowinfo.rowdim(); j++) {
@@ -3346,6 +3652,7 @@ namespace CH_Matrix_Classes {
         }
       }
     } else {
+      A.need_rowrep();
       const Integer* aip = A.rowindex.get_store();
       const Real* avp = A.rowval.get_store();
       for (Integer j = 0; j < A.rowinfo.rowdim(); j++) {
@@ -35,6 +35,9 @@
 */
 
 
+#include <atomic>
+#include <cstdint>
+#include <vector>
 #ifndef CH_MATRIX_CLASSES__SYMMAT_HXX
 #include "symmat.hxx"
 #endif
@@ -91,6 +94,29 @@ namespace CH_Matrix_Classes {
     i within colindex[colinfo(k,2)]...colindex[colinfo(k,2)+colinfo(k,1)-1]
     again by binary search.
 
+    For very large matrices that are mainly multiplied with dense
+    matrices the row representation may double the memory for no
+    benefit. After set_lazy_rowrep(true) only the column representation
+    is kept up to date; the row representation is built from it by a
+    counting sort in O(nonzeros+rows) when a routine needs it first
+    (e.g. get_rowinfo(), row(), or a product with a transposed sparse
+    matrix) and it is discarded whenever the matrix is initialized anew.
+    Products with Matrix, sumcols(), operator()(), trace() and ip() use
+    the column representation in this case and never build the row
+    representation. Building it from a const routine is protected by a
+    lock, so several threads may read the same matrix concurrently.
+    The copy constructor, operator=(const Sparsemat&) and xeya() with a
+    Sparsemat argument copy the setting (but not a row representation
+    built on demand), all other routines generating new matrices (e.g.
+    cols(), rows(), sums and products) return matrices with both
+    representations.
+
+    get_csc_offsets() and get_csr_offsets() return the usual compressed
+    offset arrays with 64 bit entries for the index and value arrays
+    get_colindex()/get_colval() and get_rowindex()/get_rowval(), so the
+    storage may be handed to external solvers without copying it.
+    get_memory_usage() reports the memory held by both representations.
+
 
  */
 
@@ -111,10 +137,13 @@ namespace CH_Matrix_Classes {
     Indexmatrix colindex; ///< gives the rowindex of the element at position i, (sorted increasingly per column)
     Matrix colval;        ///< gives the value of the element at position i
 
-    //row by row representation (see column by column)
-    Indexmatrix rowinfo; ///< k by 3, for nonzero rows: index, # nonzeros, first index in colindex/colval
-    Indexmatrix rowindex;///< gives the column index of the element at position i, (sorted increasingly per row)
-    Matrix rowval;       ///< gives the value of the element at position i
+    //row by row representation (see column by column), if lazy_rowrep it is only a cache
+    mutable Indexmatrix rowinfo; ///< k by 3, for nonzero rows: index, # nonzeros, first index in colindex/colval
+    mutable Indexmatrix rowindex;///< gives the column index of the element at position i, (sorted increasingly per row)
+    mutable Matrix rowval;       ///< gives the value of the element at position i
+
+    bool lazy_rowrep;  ///< if true, the row representation is only built on demand (default false)
+    mutable std::atomic<bool> rowrep_valid; ///< true if the row representation is up to date; always true if !lazy_rowrep
 
 
     Real tol;          ///< >0, if abs(value)<tol, then value is taken to be zero
@@ -129,6 +158,18 @@ namespace CH_Matrix_Classes {
     /// given row index i, find the corresponding rowindex of rowinfo or return -1 if the row is empty
     Integer find_row(Integer i) const;
 
+    /// computes the row representation from the column representation; the caller has to ensure exclusive access
+    void make_rowrep() const;
+    /// builds the row representation under a lock unless another thread did so already
+    void provide_rowrep() const;
+    /// makes sure the row representation is up to date; for const routines, thread safe
+    void need_rowrep() const {
+      if (!rowrep_valid.load(std::memory_order_acquire))
+        provide_rowrep();
+    }
+    /// releases the memory of the row representation and marks it invalid (only for lazy_rowrep)
+    void drop_rowrep();
+
   public:
 
     //----------------------------------------------------
@@ -141,8 +182,10 @@ namespace CH_Matrix_Classes {
 
      /// empty matrix
     inline Sparsemat();
-    /// copy constructor, *this=d*A, abs(values)<tol are removed from the support
+    /// copy constructor, *this=d*A, abs(values)<tol are removed from the support; the setting of set_lazy_rowrep() is copied
     inline Sparsemat(const Sparsemat& A, Real d = 1.);
+    /// move constructor, takes over the storage of A and leaves A as an empty 0x0 matrix
+    inline Sparsemat(Sparsemat&& A) noexcept;
     /// initialize to zero-matrix of size nr*nc     
     inline Sparsemat(Integer nr, Integer nc);
     /// initialize to size nr*nc and nz nonzeros so that this(ini[i],inj[i])=val[i] for i=0,..,nz-1; multiple elements are summed up.
@@ -195,6 +238,22 @@ namespace CH_Matrix_Classes {
       tol = t;
     }
 
+    /** @brief if true, only the column representation is stored and the row representation is built on first use (see the class description)
+
+        Switching lazy on discards the row representation, so calling
+        set_lazy_rowrep(true) again releases a row representation
+        built in the meantime. Switching it off builds it.
+    */
+    void set_lazy_rowrep(bool lazy);
+    /// returns true if the row representation is only built on demand
+    bool get_lazy_rowrep() const {
+      return lazy_rowrep;
+    }
+    /// returns true if the row representation is currently available without building it
+    bool has_rowrep() const {
+      return rowrep_valid.load(std::memory_order_acquire);
+    }
+
     //@}
 
     /** @name Conversions from other Matrix Classes (Members)
@@ -317,19 +376,26 @@ namespace CH_Matrix_Classes {
       return colval;
     }
 
-    /// returns information on nonzero rows, k by 3, listing: index, %#nonzeros, first index in rowindex/rowval
+    /// returns information on nonzero rows, k by 3, listing: index, %#nonzeros, first index in rowindex/rowval (builds the row representation if needed)
     const Indexmatrix& get_rowinfo() const {
-      return rowinfo;
+      need_rowrep(); return rowinfo;
     }
-    /// returns the index vector of the row representation holding the column index for each element
+    /// returns the index vector of the row representation holding the column index for each element (builds the row representation if needed)
     const Indexmatrix& get_rowindex() const {
-      return rowindex;
+      need_rowrep(); return rowindex;
     }
-    /// returns the value vector of the row representation holding the value for each element
+    /// returns the value vector of the row representation holding the value for each element (builds the row representation if needed)
     const Matrix& get_rowval() const {
-      return rowval;
+      need_rowrep(); return rowval;
     }
 
+    /// stores the compressed column offsets, column j occupies positions offsets[j],...,offsets[j+1]-1 of get_colindex() and get_colval(); offsets has coldim()+1 entries
+    void get_csc_offsets(std::vector<std::int64_t>& offsets) const;
+    /// stores the compressed row offsets, row i occupies positions offsets[i],...,offsets[i+1]-1 of get_rowindex() and get_rowval(); offsets has rowdim()+1 entries (builds the row representation if needed)
+    void get_csr_offsets(std::vector<std::int64_t>& offsets) const;
+    /// stores the number of bytes currently allocated for the column and the row representation (the latter is 0 if lazy and not built)
+    void get_memory_usage(std::size_t& colrep_bytes, std::size_t& rowrep_bytes) const;
+
     /// stores the nz nonzero values of *this in I,J,val so that this(I(i),J(i))=val(i) for i=0,...,nz-1 and dim(I)=dim(J)=dim(val)=nz (ordered as in row representation)
     void get_edge_rep(Indexmatrix& I, Indexmatrix& J, Matrix& val) const;
     /// stores element i of the get_edge_rep() function (ordered as in row representation); returns 1 if i is out of range, 0 otherwise.
@@ -363,7 +429,7 @@ namespace CH_Matrix_Classes {
      */
      //@{
 
-     ///sets *this=d*A and returns *this
+     ///sets *this=d*A and returns *this; the setting of set_lazy_rowrep() is copied from A
     Sparsemat& xeya(const Sparsemat& A, Real d = 1.);
     ///sets *this=d*A removing abs(values)<tol; returns *this
     Sparsemat& xeya(const Matrix& A, Real d = 1.);
@@ -410,6 +476,8 @@ namespace CH_Matrix_Classes {
 
  ///
     inline Sparsemat& operator=(const Sparsemat& A);
+    /// move assignment, exchanges the storage with A instead of copying (A is left in a valid but unspecified state)
+    inline Sparsemat& operator=(Sparsemat&& A) noexcept;
     ///
     inline Sparsemat& operator+=(const Sparsemat& A);
     ///
@@ -427,7 +495,7 @@ namespace CH_Matrix_Classes {
     ///sets *this=A removing zeros; returns *this
     Sparsemat& operator=(const Indexmatrix& A);
 
-    ///transposes itself (swaps row and column representations, thus cheap)
+    ///transposes itself (swaps row and column representations, thus cheap, but if lazy the row representation is built first)
     Sparsemat& transpose();
 
     //@}
@@ -718,6 +786,8 @@ namespace CH_Matrix_Classes {
     tol = SPARSE_ZERO_TOL;
     colinfo.init(0, 3, Integer(0)); colindex.init(0, 1, Integer(0)); colval.init(0, 1, 0.);
     rowinfo.init(0, 3, Integer(0)); rowindex.init(0, 1, Integer(0)); rowval.init(0, 1, 0.);
+    lazy_rowrep = false;
+    rowrep_valid.store(true, std::memory_order_relaxed);
 #if (CONICBUNDLE_DEBUG>=1)
     is_init = true;
 #endif
@@ -740,6 +810,7 @@ namespace CH_Matrix_Classes {
     chk_range(r, c, -1, -1);
     colinfo.init(0, 3, Integer(0)); colindex.init(0, 1, Integer(0)); colval.init(0, 1, 0.);
     rowinfo.init(0, 3, Integer(0)); rowindex.init(0, 1, Integer(0)); rowval.init(0, 1, 0.);
+    rowrep_valid.store(true, std::memory_order_relaxed);
     nr = r; nc = c;
     chk_set_init(*this, 1);
     return *this;
@@ -752,6 +823,10 @@ namespace CH_Matrix_Classes {
   inline Sparsemat::Sparsemat(const Sparsemat& A, double d) :Memarrayuser() {
     init_to_zero(); xeya(A, d);
   }
+
+  inline Sparsemat::Sparsemat(Sparsemat&& A) noexcept :Memarrayuser() {
+    init_to_zero(); chk_set_init(*this, 1); swap(*this, A);
+  }
   inline Sparsemat::Sparsemat(const Matrix& A, double d) {
     init_to_zero(); xeya(A, d);
   }
@@ -781,7 +856,7 @@ namespace CH_Matrix_Classes {
   }
 
   inline Sparsemat& Sparsemat::transpose() {
-    chk_init(*this); Integer h = nr; nr = nc; nc = h; swap(colinfo, rowinfo);
+    chk_init(*this); need_rowrep(); Integer h = nr; nr = nc; nc = h; swap(colinfo, rowinfo);
     swap(colindex, rowindex); swap(colval, rowval); return *this;
   }
 
@@ -805,6 +880,9 @@ namespace CH_Matrix_Classes {
   inline Sparsemat& Sparsemat::operator=(const Sparsemat& A) {
     return xeya(A);
   }
+  inline Sparsemat& Sparsemat::operator=(Sparsemat&& A) noexcept {
+    swap(*this, A); return *this;
+  }
   inline Sparsemat& Sparsemat::operator+=(const Sparsemat& A) {
     return xbpeya(*this, A, 1., 1.);
   }
@@ -812,10 +890,10 @@ namespace CH_Matrix_Classes {
     return xbpeya(*this, A, -1., 1.);
   }
   inline Sparsemat& Sparsemat::operator*=(Real d) {
-    chk_init(*this); colval *= d; rowval *= d; return *this;
+    chk_init(*this); colval *= d; if (rowrep_valid) rowval *= d; return *this;
   }
   inline Sparsemat& Sparsemat::operator/=(Real d) {
-    chk_init(*this); colval /= d; rowval /= d; return *this;
+    chk_init(*this); colval /= d; if (rowrep_valid) rowval /= d; return *this;
   }
   inline Sparsemat Sparsemat::operator-() const {
     return Sparsemat(*this, -1.);
@@ -825,12 +903,12 @@ namespace CH_Matrix_Classes {
 
   /// returns a Sparsemat equal to A+B
   inline Sparsemat operator+(const Sparsemat& A, const Sparsemat& B) {
-    Sparsemat C(A); return xbpeya(C, B, 1., 1.);
+    Sparsemat C(A); xbpeya(C, B, 1., 1.); return C;
   }
 
   /// returns a Sparsemat equal to A-B
   inline Sparsemat operator-(const Sparsemat& A, const Sparsemat& B) {
-    Sparsemat C(A); return xbpeya(C, B, -1., 1.);
+    Sparsemat C(A); xbpeya(C, B, -1., 1.); return C;
   }
 
   /// returns a Sparsemat equal to A*d
@@ -858,32 +936,32 @@ namespace CH_Matrix_Classes {
 
   /// returns a Matrix equal to A*B
   inline Matrix operator*(const Sparsemat& A, const Matrix& B) {
-    Matrix C; return genmult(A, B, C);
+    Matrix C; genmult(A, B, C); return C;
   }
 
   /// returns a Matrix equal to A*B
   inline Matrix operator*(const Matrix& A, const Sparsemat& B) {
-    Matrix C; return genmult(A, B, C);
+    Matrix C; genmult(A, B, C); return C;
   }
 
   /// returns a Matrix equal to A+B
   inline Matrix operator+(const Sparsemat& A, const Matrix& B) {
-    Matrix C(B); return C.xpeya(A);
+    Matrix C(B); C.xpeya(A); return C;
   }
 
   /// returns a Matrix equal to A+B
   inline Matrix operator+(const Matrix& A, const Sparsemat& B) {
-    Matrix C(A); return C.xpeya(B);
+    Matrix C(A); C.xpeya(B); return C;
   }
 
   /// returns a Matrix equal to A-B
   inline Matrix operator-(const Sparsemat& A, const Matrix& B) {
-    Matrix C(B, -1.); return C.xpeya(A);
+    Matrix C(B, -1.); C.xpeya(A); return C;
   }
 
   /// returns a Matrix equal to A-B
   inline Matrix operator-(const Matrix& A, const Sparsemat& B) {
-    Matrix C(A); return C.xpeya(B, -1.);
+    Matrix C(A); C.xpeya(B, -1.); return C;
   }
 
 
@@ -26,6 +26,7 @@
 #include <stdlib.h>
 #include <algorithm>
 #include "sparssym.hxx"
+#include "sparseop.hxx"
 #include "heapsort.hxx"
 
 
@@ -125,10 +126,10 @@ namespace CH_Matrix_Classes {
     //--- count nonzeros in each column and nonzero columns of symmetrized matrix 
     Indexmatrix tmpcnt(nr + 1, 1, Integer(0));
     for (j = 0; j < nr; j++) {
-      Real d = A(j, j);
+      Real d = Real(A(j, j));
       if (fabs(d) > tol) tmpcnt(0)++;
       for (i = j + 1; i < nr; i++) {
-        Real d = (A(i, j) + A(j, i)) / 2.;
+        Real d = Real(A(i, j) + A(j, i)) / 2.;
         if (fabs(d) > tol) tmpcnt(j + 1)++;
       }
     }
@@ -146,7 +147,7 @@ namespace CH_Matrix_Classes {
       colinfo(nrcol, 0) = -1;
       colinfo(nrcol, 2) = nz;
       for (i = 0; i < nr; i++) {
-        Real d = A(i, i);
+        Real d = Real(A(i, i));
         if (fabs(d) > tol) {
           colindex(nz) = i;
           colval(nz) = in_d * d;
@@ -162,7 +163,7 @@ namespace CH_Matrix_Classes {
       colinfo(nrcol, 0) = j;
       colinfo(nrcol, 2) = nz;
       for (i = j + 1; i < nr; i++) {
-        Real d = (A(i, j) + A(j, i)) / 2.;
+        Real d = Real(A(i, j) + A(j, i)) / 2.;
         if (fabs(d) > tol) {
           colindex(nz) = i - j; //add shift
           colval(nz) = in_d * d;
@@ -457,6 +458,22 @@ namespace CH_Matrix_Classes {
     }
     if ((alpha == 0.) || (nr == 0) || (nc == 0))
       return C;
+    if ((nc >= sparseop_minlen) && (double(A.nonzeros()) * double(nc) >= double(sparseop_minwork)) &&
+      (A.nonzeros() >= sparseop_mincopy * nr)) {
+      //compute C^T=op(B)^T*A with the rows of op(B) as contiguous columns
+      Matrix P;
+      const Real* pp = B.get_store();
+      if (!btrans) {
+        P.newsize(nc, nr);
+        spop_transpose(nr, nc, B.get_store(), nr, P.get_store());
+        pp = P.get_store();
+      }
+      Matrix Ct(nc, nr, 0.);
+      spop_symmult(A.colinfo.rowdim(), A.colinfo.get_store(), A.colindex.get_store(), A.colval.get_store(),
+        nc, alpha, pp, Ct.get_store());
+      spop_addtranspose(nr, nc, 1., Ct.get_store(), C.get_store(), nr);
+      return C;
+    }
     if (btrans) {
       Integer nrcol = A.colinfo.rowdim();
       if ((nrcol == 0) || (nc == 0)) return C;
@@ -602,6 +619,20 @@ namespace CH_Matrix_Classes {
     }
     if ((alpha == 0.) || (nr == 0) || (nc == 0) || (nm == 0))
       return C;
+    if ((nr >= sparseop_minlen) && (double(B.nonzeros()) * double(nr) >= double(sparseop_minwork)) &&
+      ((!atrans) || (B.nonzeros() >= sparseop_mincopy * nm))) {
+      //the columns of op(A) are contiguous unless atrans
+      Matrix P;
+      const Real* pp = A.get_store();
+      if (atrans) {
+        P.newsize(nr, nm);
+        spop_transpose(nm, nr, A.get_store(), nm, P.get_store());
+        pp = P.get_store();
+      }
+      spop_symmult(B.colinfo.rowdim(), B.colinfo.get_store(), B.colindex.get_store(), B.colval.get_store(),
+        nr, alpha, pp, C.get_store());
+      return C;
+    }
     if (atrans) {
       Integer nrcol = B.colinfo.rowdim();
       if ((nrcol == 0) || (nc == 0)) return C;
@@ -1636,6 +1667,7 @@ namespace CH_Matrix_Classes {
         MEmessage(MatrixError(ME_dim, "genmult: dimensions don't match", MTsparse));;
       }
 #endif
+      B.need_rowrep();
       binf = &(B.rowinfo);
       bind = &(B.rowindex);
       bval = &(B.rowval);
@@ -1742,6 +1774,7 @@ namespace CH_Matrix_Classes {
 #if (CONICBUNDLE_DEBUG>=1)
       nm = A.nr;
 #endif
+      A.need_rowrep();
       ainf = &(A.rowinfo);
       aind = &(A.rowindex);
       aval = &(A.rowval);
@@ -1867,6 +1900,7 @@ namespace CH_Matrix_Classes {
     Indexmatrix J(nz, 1); chk_set_init(J, 1);
     Matrix val(nz, 1); chk_set_init(val, 1);
     nz = 0;
+    A.need_rowrep();
     for (Integer i = 0; i < A.rowinfo.rowdim(); i++) {
       Integer ii = A.rowinfo(i, 0);
       for (Integer j = 0; j < A.rowinfo(i, 1); j++) {
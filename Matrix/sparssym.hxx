@@ -151,6 +151,8 @@ namespace CH_Matrix_Classes {
     inline Sparsesym();
     /// copy constructor, *this=d*A
     inline Sparsesym(const Sparsesym& A, Real d = 1.);
+    /// move constructor, takes over the storage of A and leaves A as an empty 0x0 matrix
+    inline Sparsesym(Sparsesym&& A) noexcept;
     /// initialize to zero-matrix of size nr*nr
     inline Sparsesym(Integer nr);
     /// initialize to size nr*nr and nz nonzeros so that this(ini[i],inj[i])=val[i] for i=0,..,nz-1; specify only one of (i,j) and (j,i), multiple elements are summed up.
@@ -389,6 +391,8 @@ namespace CH_Matrix_Classes {
 
      ///
     inline Sparsesym& operator=(const Sparsesym& A);
+    /// move assignment, exchanges the storage with A instead of copying (A is left in a valid but unspecified state)
+    inline Sparsesym& operator=(Sparsesym&& A) noexcept;
     ///
     inline Sparsesym& operator+=(const Sparsesym& v);
     ///
@@ -690,6 +694,9 @@ namespace CH_Matrix_Classes {
   inline Sparsesym::Sparsesym(const Sparsesym& A, Real d) :Memarrayuser() {
     init_to_zero(); xeya(A, d);
   }
+  inline Sparsesym::Sparsesym(Sparsesym&& A) noexcept :Memarrayuser() {
+    init_to_zero(); chk_set_init(*this, 1); swap(*this, A);
+  }
   inline Sparsesym::Sparsesym(const Matrix& A, Real d) {
     init_to_zero(); xeya(A, d);
   }
@@ -724,6 +731,9 @@ namespace CH_Matrix_Classes {
   inline Sparsesym& Sparsesym::operator=(const Sparsesym& A) {
     return xeya(A);
   }
+  inline Sparsesym& Sparsesym::operator=(Sparsesym&& A) noexcept {
+    swap(*this, A); return *this;
+  }
   inline Sparsesym& Sparsesym::operator+=(const Sparsesym& A) {
     Sparsesym B; xeyapzb(B, *this, A); swap(*this, B); return *this;
   }
@@ -751,12 +761,12 @@ namespace CH_Matrix_Classes {
 
   /// returns a Sparsesym that equals A+B
   inline Sparsesym operator+(const Sparsesym& A, const Sparsesym& B) {
-    Sparsesym C; return xeyapzb(C, A, B);
+    Sparsesym C; xeyapzb(C, A, B); return C;
   }
 
   /// returns a Sparsesym that equals A-B
   inline Sparsesym operator-(const Sparsesym& A, const Sparsesym& B) {
-    Sparsesym C; return xeyapzb(C, A, B, 1., -1.);
+    Sparsesym C; xeyapzb(C, A, B, 1., -1.); return C;
   }
 
   /// returns a Sparsesym that equals A*d
@@ -776,32 +786,32 @@ namespace CH_Matrix_Classes {
 
   /// returns a Matrix that equals A*B
   inline Matrix operator*(const Sparsesym& A, const Matrix& B) {
-    Matrix C; return genmult(A, B, C, 1., 0., 0);
+    Matrix C; genmult(A, B, C, 1., 0., 0); return C;
   }
 
   /// returns a Matrix that equals A*B
   inline Matrix operator*(const Matrix& A, const Sparsesym& B) {
-    Matrix C; return genmult(A, B, C, 1., 0., 0);
+    Matrix C; genmult(A, B, C, 1., 0., 0); return C;
   }
 
   /// returns a Matrix that equals A+B
   inline Matrix operator+(const Matrix& A, const Sparsesym& B) {
-    Matrix C(A); return C.xpeya(B);
+    Matrix C(A); C.xpeya(B); return C;
   }
 
   /// returns a Matrix that equals A+B
   inline Matrix operator+(const Sparsesym& A, const Matrix& B) {
-    Matrix C(B); return C.xpeya(A);
+    Matrix C(B); C.xpeya(A); return C;
   }
 
   /// returns a Matrix that equals A-B
   inline Matrix operator-(const Matrix& A, const Sparsesym& B) {
-    Matrix C(A); return C.xpeya(B, -1.);
+    Matrix C(A); C.xpeya(B, -1.); return C;
   }
 
   /// returns a Matrix that equals A-B
   inline Matrix operator-(const Sparsesym& A, const Matrix& B) {
-    Matrix C(B, -1.); return C.xpeya(A);
+    Matrix C(B, -1.); C.xpeya(A); return C;
   }
 
   ///returns the usual inner product of A and B, i.e., the sum of A(i,j)*B(i,j) over all i,j
@@ -817,7 +827,7 @@ namespace CH_Matrix_Classes {
   ///returns a column vector holding the sum over all columns, i.e., A*(1 1 ... 1)^T
   inline Matrix sumcols(const Sparsesym& A)    //=A*(1 1 1 ... 1)^t
   {
-    Matrix s(sumrows(A)); return s.transpose();
+    Matrix s(sumrows(A)); s.transpose(); return s;
   }
 
 
@@ -876,22 +886,22 @@ namespace CH_Matrix_Classes {
 
   /// returns a Symmatrix that equals A+B
   inline Symmatrix operator+(const Sparsesym& A, const Symmatrix& B) {
-    Symmatrix C(B); return C.xpeya(A);
+    Symmatrix C(B); C.xpeya(A); return C;
   }
 
   /// returns a Symmatrix that equals A+B
   inline Symmatrix operator+(const Symmatrix& A, const Sparsesym& B) {
-    Symmatrix C(A); return C.xpeya(B);
+    Symmatrix C(A); C.xpeya(B); return C;
   }
 
   /// returns a Symmatrix that equals A-B
   inline Symmatrix operator-(const Sparsesym& A, const Symmatrix& B) {
-    Symmatrix C(B, -1.); return C.xpeya(A);
+    Symmatrix C(B, -1.); C.xpeya(A); return C;
   }
 
   /// returns a Symmatrix that equals A-B
   inline Symmatrix operator-(const Symmatrix& A, const Sparsesym& B) {
-    Symmatrix C(A); return C.xpeya(B, -1);
+    Symmatrix C(A); C.xpeya(B, -1); return C;
   }
 
   ///returns the usual inner product of A and B, i.e., the sum of A(i,j)*B(i,j) over all i,j
@@ -910,12 +920,12 @@ namespace CH_Matrix_Classes {
 
   /// returns a Matrix that equals A*B
   inline Matrix operator*(const Sparsesym& A, const Sparsemat& B) {
-    Matrix C; return genmult(A, B, C);
+    Matrix C; genmult(A, B, C); return C;
   }
 
   /// returns a Matrix that equals A*B
   inline Matrix operator*(const Sparsemat& A, const Sparsesym& B) {
-    Matrix C; return genmult(A, B, C);
+    Matrix C; genmult(A, B, C); return C;
   }
 
   inline Sparsemat::Sparsemat(const Sparsesym& A, Real d) {
@@ -930,12 +940,12 @@ namespace CH_Matrix_Classes {
 
   /// returns a Matrix that equals A*B
   inline Matrix operator*(const Symmatrix& A, const Sparsemat& B) {
-    Matrix C; return genmult(A, B, C, 1., 0., 0);
+    Matrix C; genmult(A, B, C, 1., 0., 0); return C;
   }
 
   /// returns a Matrix that equals A*B
   inline Matrix operator*(const Sparsemat& A, const Symmatrix& B) {
-    Matrix C; return genmult(A, B, C, 1., 0., 0);
+    Matrix C; genmult(A, B, C, 1., 0., 0); return C;
   }
 
   inline Symmatrix::Symmatrix(const Sparsesym& A, Real d) {
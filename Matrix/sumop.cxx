@@ -0,0 +1,83 @@
+/* ****************************************************************************
+
+    Copyright (C) 2026  ConicBundle contributors
+
+    ConicBundle, Version 1.a.2
+    File:  Matrix/sumop.cxx
+    This file is part of ConciBundle, a C/C++ library for convex optimization.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+
+
+
+#include <algorithm>
+#include "sumop.hxx"
+#include "thread_placement.hxx"
+#include "thread_pool.hxx"
+
+
+namespace CH_Matrix_Classes {
+
+  Integer sumop_nthreads(Real work, Integer nparts) {
+    if ((work < Real(sumop_minwork_thread)) || (nparts <= 1))
+      return 1;
+    Integer nt = Integer(CH_Tools::ThreadPlacement::n_processors());
+    if (Real(nt) > work / sumop_minwork_thread + 1.)
+      nt = Integer(work / sumop_minwork_thread) + 1;
+    return std::max(Integer(1), std::min(nt, nparts));
+  }
+
+  void sumop_xpeya_range(Integer lo, Integer hi, Real* v,
+    Integer k, const Real* const* a, const Real* f) {
+    for (Integer clo = lo; clo < hi; clo += sumop_chunk) {
+      const Integer chi = std::min(hi, clo + sumop_chunk);
+      Integer j = 0;
+      for (; j + 3 < k; j += 4) {
+        const Real* a0 = a[j];
+        const Real* a1 = a[j + 1];
+        const Real* a2 = a[j + 2];
+        const Real* a3 = a[j + 3];
+        const Real f0 = f[j];
+        const Real f1 = f[j + 1];
+        const Real f2 = f[j + 2];
+        const Real f3 = f[j + 3];
+        for (Integer i = clo; i < chi; i++)
+          v[i] += f0 * a0[i] + f1 * a1[i] + f2 * a2[i] + f3 * a3[i];
+      }
+      for (; j < k; j++)
+        mat_xpeya(chi - clo, v + clo, a[j] + clo, f[j]);
+    }
+  }
+
+  void sumop_xpeya(Integer n, Real* v, Integer k, const Real* const* a, const Real* f) {
+    if ((n <= 0) || (k <= 0))
+      return;
+    const Integer nchunks = (n + sumop_chunk - 1) / sumop_chunk;
+    const Integer nt = sumop_nthreads(Real(n) * Real(k), nchunks);
+    if (nt <= 1) {
+      sumop_xpeya_range(0, n, v, k, a, f);
+      return;
+    }
+    //each task adds to a range of whole chunks of the coordinates
+    CH_Tools::ThreadPool::run(int(nt), [=](int t) {
+      Integer lo = std::min(n, ((nchunks * t) / nt) * sumop_chunk);
+      Integer hi = std::min(n, ((nchunks * (t + 1)) / nt) * sumop_chunk);
+      sumop_xpeya_range(lo, hi, v, k, a, f);
+    });
+  }
+
+}
@@ -0,0 +1,78 @@
+/* ****************************************************************************
+
+    Copyright (C) 2026  ConicBundle contributors
+
+    ConicBundle, Version 1.a.2
+    File:  Matrix/sumop.hxx
+    This file is part of ConciBundle, a C/C++ library for convex optimization.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+
+
+#ifndef CH_MATRIX_CLASSES__SUMOP_HXX
+#define CH_MATRIX_CLASSES__SUMOP_HXX
+
+/**  @file sumop.hxx
+    @brief Header declaring the kernels on raw arrays for adding weighted sums of many vectors of the same length, used in the batch aggregation of primal data
+    @version 1.0
+    @date 2026-10-18
+    @author ConicBundle contributors
+
+*/
+
+#include "matop.hxx"
+
+namespace CH_Matrix_Classes {
+
+  /**@defgroup sumop Weighted sums of many vectors (internal)
+
+     When the bundle aggregate is formed, many primal matrices or vectors
+     of the same size are added with different weights to one result.
+     Adding them one after the other sweeps over the whole result once
+     for each of them. sumop_xpeya() instead works on chunks of
+     sumop_chunk coordinates of the result and adds four of the vectors
+     at a time, so each chunk of the result is read and written only
+     once for every four vectors and stays in the cache in between.
+
+     If the total work is large enough, the coordinates are split into
+     ranges of whole chunks that are handled by the workers of
+     CH_Tools::ThreadPool (pinned via CH_Tools::ThreadPlacement if this
+     is switched on). The workers only touch raw arrays, so they do not
+     allocate anything via Memarray.
+  */
+  //@{
+
+  /// the number of coordinates of the result processed together
+  const Integer sumop_chunk = 2048;
+  /// more than one thread is used only if the number of vectors times their length is at least this
+  const Integer sumop_minwork_thread = 1 << 19;
+
+  /// returns the number of threads (at least 1, at most nparts and the number of processors) worth starting for the given amount of work (a Real, because it may exceed the range of Integer)
+  Integer sumop_nthreads(Real work, Integer nparts);
+
+  /// v[i] += sum_j f[j]*a[j][i] for j=0,...,k-1 and i=lo,...,hi-1
+  void sumop_xpeya_range(Integer lo, Integer hi, Real* v,
+    Integer k, const Real* const* a, const Real* f);
+
+  /// v[i] += sum_j f[j]*a[j][i] for j=0,...,k-1 and i=0,...,n-1, threaded for large n*k
+  void sumop_xpeya(Integer n, Real* v, Integer k, const Real* const* a, const Real* f);
+
+  //@}
+
+}
+
+#endif
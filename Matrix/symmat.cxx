@@ -25,6 +25,7 @@
 
 #include <stdlib.h>
 #include "symmat.hxx"
+#include "blockop.hxx"
 
 
 using namespace CH_Tools;
@@ -115,6 +116,27 @@ namespace CH_Matrix_Classes {
 #else
   {
     chk_init(A);
+    if ((alpha != 0.) &&
+      ((trans ? A.coldim() : A.rowdim()) >= (trans ? blockop_minorder : blockop_minorder_sweep)) &&
+      ((trans ? A.rowdim() : A.coldim()) >= (trans ? blockop_mindepth : blockop_mindepth_sweep))) {
+      //blocked on a full copy of the lower triangle
+      const Integer nr = (trans ? A.coldim() : A.rowdim());
+      Matrix tmp;
+      if (beta == 0.) {
+        tmp.init(nr, nr, 0.);
+      } else {
+#if (CONICBUNDLE_DEBUG>=1)
+        chk_init(C);
+        if (C.nr != nr) {
+          MEmessage(MatrixError(ME_dim, "rankadd: dimensions don't match", MTmatrix));;
+        }
+#endif
+        C.store_lower(tmp, beta);
+      }
+      blk_syrk(trans, nr, (trans ? A.rowdim() : A.coldim()), alpha,
+        A.get_store(), A.rowdim(), tmp.get_store(), nr);
+      return C.init_lower(tmp);
+    }
     if (trans) { //A^T*A
       if (beta == 0.) {
         C.init(A.coldim(), 0.);
@@ -320,6 +342,27 @@ namespace CH_Matrix_Classes {
 #else
   {
     chk_add(A, B);
+    if ((alpha != 0.) &&
+      ((trans ? A.coldim() : A.rowdim()) >= (trans ? blockop_minorder : blockop_minorder_sweep)) &&
+      ((trans ? A.rowdim() : A.coldim()) >= (trans ? blockop_mindepth : blockop_mindepth_sweep))) {
+      //blocked on a full copy of the lower triangle
+      const Integer nr = (trans ? A.coldim() : A.rowdim());
+      Matrix tmp;
+      if (beta == 0.) {
+        tmp.init(nr, nr, 0.);
+      } else {
+#if (CONICBUNDLE_DEBUG>=1)
+        chk_init(C);
+        if (C.nr != nr) {
+          MEmessage(MatrixError(ME_dim, "rank2add: dimensions don't match", MTmatrix));;
+        }
+#endif
+        C.store_lower(tmp, beta);
+      }
+      blk_syr2k(trans, nr, (trans ? A.rowdim() : A.coldim()), alpha / 2.,
+        A.get_store(), A.rowdim(), B.get_store(), B.rowdim(), tmp.get_store(), nr);
+      return C.init_lower(tmp);
+    }
     if (trans) { //A^T*B
       if (beta == 0.) {
         C.init(A.coldim(), 0.);
@@ -567,6 +610,13 @@ namespace CH_Matrix_Classes {
       C.init(nr, nc, 0.);
     }
     if (alpha == 0.) return C;
+    if ((nr >= blockop_minorder) && (nc >= blockop_mindepth)) {
+      //blocked on a full copy of A
+      Matrix tmp(A);
+      blk_gemm(0, btrans, nr, nc, nr, alpha, tmp.get_store(), nr,
+        B.get_store(), B.rowdim(), C.get_store(), nr);
+      return C;
+    }
     if ((btrans) && (nc > 1)) {
       /*
         const Real *ap=A.get_store();
@@ -712,6 +762,13 @@ namespace CH_Matrix_Classes {
       C.init(nr, nc, 0.);
     }
     if (alpha == 0.) return C;
+    if ((nc >= blockop_minorder) && (nr >= blockop_mindepth)) {
+      //blocked on a full copy of B
+      Matrix tmp(B);
+      blk_gemm(atrans, 0, nr, nc, nc, alpha, A.get_store(), A.rowdim(),
+        tmp.get_store(), nc, C.get_store(), nr);
+      return C;
+    }
     if (atrans) {
       const Real* bp = B.get_store();
       for (Integer j = 0; j < nc; j++) {
@@ -737,6 +794,43 @@ namespace CH_Matrix_Classes {
   }
 #endif
 
+  Matrix& Symmatrix::store_lower(Matrix& F, Real d) const {
+    chk_init(*this);
+    F.newsize(nr, nr);
+    chk_set_init(F, 1);
+    const Real* mp = m;
+    Real* fp = F.get_store();
+    for (Integer i = 0; i < nr; i++) {
+      mat_xea(i, fp, 0.);
+      fp += i;
+      if (d == 1.)
+        mat_xey(nr - i, fp, mp);
+      else
+        mat_xeya(nr - i, fp, mp, d);
+      fp += nr - i;
+      mp += nr - i;
+    }
+    return F;
+  }
+
+  Symmatrix& Symmatrix::init_lower(const Matrix& A) {
+    chk_init(A);
+#if (CONICBUNDLE_DEBUG>=1)
+    if (A.nr != A.nc)
+      MEmessage(MEdim(A.nr, A.nc, 0, 0, "Symmatrix::init_lower(const Matrix& A) A not square", MTsymmetric));
+#endif
+    newsize(A.nr);
+    Real* mp = m;
+    const Real* ap = A.m;
+    for (Integer i = nr; i > 0; --i) {
+      mat_xey(i, mp, ap);
+      mp += i;
+      ap += nr + 1;
+    }
+    chk_set_init(*this, 1);
+    return *this;
+  }
+
   Symmatrix& Symmatrix::xeya(const Matrix& A, double d) {
     chk_init(A);
 #if (CONICBUNDLE_DEBUG>=1)
@@ -785,9 +879,9 @@ namespace CH_Matrix_Classes {
     for (Integer i = 0; i < nr; i++) {
       Integer* matcp = A.m + i * nr + i;
       Integer* matrp = matcp + nr;
-      (*mp++) = (*matcp++) * d;
+      (*mp++) = Real(*matcp++) * d;
       for (Integer j = i + 1; j < nr; j++, matrp += nr)
-        (*mp++) = ((*matcp++) + (*matrp)) * f;
+        (*mp++) = Real((*matcp++) + (*matrp)) * f;
     }
     chk_set_init(*this, 1);
     return *this;
@@ -800,9 +894,9 @@ namespace CH_Matrix_Classes {
     for (Integer i = 0; i < nr; i++) {
       Integer* matcp = A.m + i * nr + i;
       Integer* matrp = matcp + nr;
-      (*mp++) += (*matcp++) * d;
+      (*mp++) += Real(*matcp++) * d;
       for (Integer j = i + 1; j < nr; j++, matrp += nr)
-        (*mp++) += ((*matcp++) + (*matrp)) * f;
+        (*mp++) += Real((*matcp++) + (*matrp)) * f;
     }
     return *this;
   }
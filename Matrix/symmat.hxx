@@ -100,6 +100,8 @@ namespace CH_Matrix_Classes {
     inline Symmatrix();
     /// copy constructor, *this=d*A
     inline Symmatrix(const Symmatrix& A, double d = 1.);
+    /// move constructor, takes over the storage of A and leaves A as an empty 0x0 matrix
+    inline Symmatrix(Symmatrix&& A) noexcept;
     /** @brief generate a matrix of size nr x nr but WITHOUT initializing the memory
 
         If initializing the memory externally and CONICBUNDLE_DEBUG is defined, please use
@@ -343,6 +345,8 @@ namespace CH_Matrix_Classes {
 
      ///
     inline Symmatrix& operator=(const Symmatrix& A);
+    /// move assignment, exchanges the storage with A instead of copying (A is left in a valid but unspecified state)
+    inline Symmatrix& operator=(Symmatrix&& A) noexcept;
     ///
     inline Symmatrix& operator+=(const Symmatrix& A);
     ///
@@ -443,6 +447,11 @@ namespace CH_Matrix_Classes {
     ///adds to *this(i,j), i<=j the upper triangle of the matrix product d*transpose(A)*B
     Symmatrix& xpetriu_yza(const Sparsemat& A, const Matrix& B, Real d = 1.);
 
+    ///stores d times the lower triangle of *this column by column in the square matrix F and sets the strict upper triangle of F to zero (the full layout of the blocked kernels, see @ref blockop); returns F
+    Matrix& store_lower(Matrix& F, Real d = 1.) const;
+    ///sets *this to the lower triangle of the square matrix A (the strict upper triangle of A is not read) and returns *this
+    Symmatrix& init_lower(const Matrix& A);
+
     ///
     inline Symmatrix& operator=(const Sparsesym& A);
     ///
@@ -828,6 +837,10 @@ namespace CH_Matrix_Classes {
     init_to_zero(); xeya(A, d);
   }
 
+  inline Symmatrix::Symmatrix(Symmatrix&& A) noexcept :Memarrayuser() {
+    init_to_zero(); swap(*this, A);
+  }
+
   inline Symmatrix::Symmatrix(const Matrix& M, double d) {
     init_to_zero(); xeya(M, d);
   }
@@ -934,6 +947,9 @@ namespace CH_Matrix_Classes {
   inline Symmatrix& Symmatrix::operator=(const Symmatrix& A) {
     return xeya(A);
   }
+  inline Symmatrix& Symmatrix::operator=(Symmatrix&& A) noexcept {
+    swap(*this, A); return *this;
+  }
   inline Symmatrix& Symmatrix::operator+=(const Symmatrix& A) {
     return xpeya(A);
   }
@@ -962,7 +978,7 @@ namespace CH_Matrix_Classes {
 
   /// returns a Matrix that equals A*B
   inline Matrix operator*(const Symmatrix& A, const Symmatrix& B) {
-    Matrix C; return genmult(Matrix(A), B, C);
+    Matrix C; genmult(Matrix(A), B, C); return C;
   }
 
   /// returns a Matrix that equals A%B (where % is overloaded as elementwise multiplication)
@@ -972,42 +988,42 @@ namespace CH_Matrix_Classes {
 
   /// returns a Matrix that equals A+B
   inline Symmatrix operator+(const Symmatrix& A, const Symmatrix& B) {
-    Symmatrix C(A); return C.xpeya(B);
+    Symmatrix C(A); C.xpeya(B); return C;
   }
 
   /// returns a Matrix that equals A-B
   inline Symmatrix operator-(const Symmatrix& A, const Symmatrix& B) {
-    Symmatrix C(A); return C.xpeya(B, -1.);
+    Symmatrix C(A); C.xpeya(B, -1.); return C;
   }
 
   /// returns a Matrix that equals A*B
   inline Matrix operator*(const Symmatrix& A, const Matrix& B) {
-    Matrix C; return genmult(A, B, C);
+    Matrix C; genmult(A, B, C); return C;
   }
 
   /// returns a Matrix that equals A*B
   inline Matrix operator*(const Matrix& A, const Symmatrix& B) {
-    Matrix C; return genmult(A, B, C);
+    Matrix C; genmult(A, B, C); return C;
   }
 
   /// returns a Matrix that equals A+B
   inline Matrix operator+(const Symmatrix& A, const Matrix& B) {
-    Matrix C(A); return C.xpeya(B);
+    Matrix C(A); C.xpeya(B); return C;
   }
 
   /// returns a Matrix that equals A+B
   inline Matrix operator+(const Matrix& A, const Symmatrix& B) {
-    Matrix C(A); return C.xpeya(B);
+    Matrix C(A); C.xpeya(B); return C;
   }
 
   /// returns a Matrix that equals A-B
   inline Matrix operator-(const Symmatrix& A, const Matrix& B) {
-    Matrix C(A); return C.xpeya(B, -1);
+    Matrix C(A); C.xpeya(B, -1); return C;
   }
 
   /// returns a Matrix that equals A-B
   inline Matrix operator-(const Matrix& A, const Symmatrix& B) {
-    Matrix C(A); return C.xpeya(B, -1);
+    Matrix C(A); C.xpeya(B, -1); return C;
   }
 
   /// returns a Symmatrix that equals A*d
@@ -1027,22 +1043,22 @@ namespace CH_Matrix_Classes {
 
   /// returns a Symmatrix that equals A+d (d is added to each element)
   inline Symmatrix operator+(const Symmatrix& A, Real d) {
-    Symmatrix B(A); return B += d;
+    Symmatrix B(A); B += d; return B;
   }
 
   /// returns a Symmatrix that equals A+d (d is added to each element)
   inline Symmatrix operator+(Real d, const Symmatrix& A) {
-    Symmatrix B(A); return B += d;
+    Symmatrix B(A); B += d; return B;
   }
 
   /// returns a Symmatrix that equals A-d (d is subtracted from each element)
   inline Symmatrix operator-(const Symmatrix& A, Real d) {
-    Symmatrix B(A); return B -= d;
+    Symmatrix B(A); B -= d; return B;
   }
 
   /// returns a Symmatrix that equals d-A (each element subtracted from d)
   inline Symmatrix operator-(Real d, const Symmatrix& A) {
-    Symmatrix B(A, -1.); return B += d;
+    Symmatrix B(A, -1.); B += d; return B;
   }
 
 
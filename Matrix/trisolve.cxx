@@ -64,7 +64,7 @@ namespace CH_Matrix_Classes {
         while ((j < X.nc) && (::fabs(*xp) < tol)) {
           *xp = 0.; j++; xp += X.nr;
         }
-        if (j < X.nc) return i + 1;
+        if (j < X.nc) return int(i + 1);
         continue;
       }
       xp = X.m + i;
@@ -107,7 +107,7 @@ namespace CH_Matrix_Classes {
         while ((j < X.nc) && (::fabs(*xp) < tol)) {
           *xp = 0.; j++; xp += X.nr;
         }
-        if (j < X.nc) return i + 1;
+        if (j < X.nc) return int(i + 1);
         continue;
       }
       xp = X.m + i;
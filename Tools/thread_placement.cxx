@@ -0,0 +1,114 @@
+/* ****************************************************************************
+
+    Copyright (C) 2026  ConicBundle contributors
+
+    ConicBundle, Version 1.a.2
+    File:  Tools/thread_placement.cxx
+    This file is part of ConciBundle, a C/C++ library for convex optimization.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+
+#include <thread>
+#include "thread_placement.hxx"
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace CH_Tools {
+
+  std::atomic<bool> ThreadPlacement::pinning(false);
+
+  // *************************************************************************
+  //                              n_processors
+  // *************************************************************************
+
+  int ThreadPlacement::n_processors() {
+#if defined(__linux__)
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &mask) == 0) {
+      int n = CPU_COUNT(&mask);
+      if (n > 0)
+        return n;
+    }
+#endif
+    int n = int(std::thread::hardware_concurrency());
+    return (n > 0) ? n : 1;
+  }
+
+  // *************************************************************************
+  //                                pin_self
+  // *************************************************************************
+
+  int ThreadPlacement::pin_self(int index) {
+#if defined(__linux__)
+    //the processors the thread could run on before it was pinned first
+    thread_local bool have_mask = false;
+    thread_local cpu_set_t mask;
+    thread_local int pinned = -1;
+    if (!have_mask) {
+      CPU_ZERO(&mask);
+      if (sched_getaffinity(0, sizeof(cpu_set_t), &mask) != 0)
+        return 2;
+      have_mask = true;
+    }
+
+    if (!get_pinning()) {
+      if (pinned >= 0) {
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &mask) != 0)
+          return 2;
+        pinned = -1;
+      }
+      return 1;
+    }
+
+    int n = CPU_COUNT(&mask);
+    if (n <= 0)
+      return 2;
+    index %= n;
+    if (index < 0)
+      index += n;
+    if (index == pinned)
+      return 0;
+
+    //find the processor number index among them
+    int cpu = 0;
+    for (int i = index; cpu < CPU_SETSIZE; cpu++) {
+      if (CPU_ISSET(cpu, &mask)) {
+        if (i == 0)
+          break;
+        i--;
+      }
+    }
+    if (cpu == CPU_SETSIZE)
+      return 2;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set) != 0)
+      return 2;
+    pinned = index;
+    return 0;
+#else
+    (void)index;
+    return get_pinning() ? 2 : 1;
+#endif
+  }
+
+}
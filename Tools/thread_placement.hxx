@@ -0,0 +1,108 @@
+/* ****************************************************************************
+
+    Copyright (C) 2026  ConicBundle contributors
+
+    ConicBundle, Version 1.a.2
+    File:  Tools/thread_placement.hxx
+    This file is part of ConciBundle, a C/C++ library for convex optimization.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+
+
+#ifndef CH_TOOLS__THREAD_PLACEMENT_HXX
+#define CH_TOOLS__THREAD_PLACEMENT_HXX
+
+/**  @file thread_placement.hxx
+    @brief Header declaring the class CH_Tools::ThreadPlacement for pinning the worker threads started by the library to processors
+    @version 1.0
+    @date 2026-10-18
+    @author ConicBundle contributors
+
+*/
+
+#include <atomic>
+
+namespace CH_Tools {
+
+  /**@defgroup ThreadPlacement ThreadPlacement (pinning of worker threads)
+
+     The library splits larger work into blocks and runs these on the
+     persistent worker threads of CH_Tools::ThreadPool (e.g. the triangle
+     separation, the argument transformation of
+     AffineFunctionTransformation and the parallel first touch of large
+     blocks in CH_Matrix_Classes::Memarray). Before it starts on a block,
+     worker number t (t=1,2,...) calls ThreadPlacement::pin_self(), which,
+     if pinning is switched on, restricts it to the t-th processor
+     (cyclically) among those it could originally run on. The thread
+     calling ThreadPool::run() does the block of number 0 and is never
+     pinned.
+
+     Because each worker pins itself before it touches any memory, the
+     pages written first by a worker are allocated on its own node. On
+     machines with several NUMA nodes this keeps worker t on the node
+     where it touched its memory first (see
+     CH_Matrix_Classes::Memarray::set_first_touch()). Threads of OpenMP
+     (WITH_OMP) are placed by the OpenMP runtime, e.g. via OMP_PROC_BIND
+     and OMP_PLACES.
+
+     Pinning is only supported on Linux; elsewhere pin_self() does nothing.
+     It is switched off by default.
+  */
+  //@{
+
+  /** @brief global switch and routine for pinning the worker threads of the library, see @ref ThreadPlacement
+
+      All routines are static, the setting is shared by all solvers of the process.
+  */
+  class ThreadPlacement {
+  private:
+    static std::atomic<bool> pinning; ///< if true, pin() pins the threads
+
+  public:
+    /// switch the pinning of worker threads on or off (default off)
+    static void set_pinning(bool on) {
+      pinning.store(on, std::memory_order_relaxed);
+    }
+
+    /// returns true if worker threads are pinned
+    static bool get_pinning() {
+      return pinning.load(std::memory_order_relaxed);
+    }
+
+    /// returns the number of processors the calling thread may run on (at least 1)
+    static int n_processors();
+
+    /** @brief if pinning is switched on, restrict the calling thread to the processor number @a index (modulo their number) among those it could run on before its first call
+
+        If pinning is switched off and the calling thread was pinned by an
+        earlier call, its original processor set is restored. Calling it
+        again with the same @a index is cheap, so a worker may call it
+        before each block of work.
+
+        @return
+          - 0 if the thread is pinned
+          - 1 if pinning is switched off
+          - 2 if pinning is not supported or failed
+    */
+    static int pin_self(int index);
+  };
+
+  //@}
+
+}
+
+#endif
@@ -0,0 +1,140 @@
+/* ****************************************************************************
+
+    Copyright (C) 2026  ConicBundle contributors
+
+    ConicBundle, Version 1.a.2
+    File:  Tools/thread_pool.cxx
+    This file is part of ConciBundle, a C/C++ library for convex optimization.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "thread_pool.hxx"
+#include "thread_placement.hxx"
+#include "timer_registry.hxx"
+
+namespace CH_Tools {
+
+  // the state shared by run() and the workers; a job is published by
+  // increasing job_id, worker w takes part in it if w<n_active
+  struct ThreadPoolData {
+    std::mutex dispatch;               ///< held by the thread using the workers in run()
+    std::mutex m;                      ///< protects the following
+    std::condition_variable work_cv;   ///< signals a new job to the workers
+    std::condition_variable done_cv;   ///< signals the end of the job to run()
+    std::vector<std::thread> workers;  ///< worker w+1 is workers[w]
+    const std::function<void(int)>* task = 0;
+    int n_tasks = 0;                   ///< number of tasks of the job
+    int n_active = 0;                  ///< number of participants including the calling thread
+    unsigned long job_id = 0;          ///< number of the current job
+    int pending = 0;                   ///< workers still busy with the current job
+    std::vector<const char*> timer_path; ///< the running timers of the calling thread, see TimerRegistry::get_current_path()
+  };
+
+  // never deleted, so that the pool may still be used during the
+  // destruction of static objects; the waiting workers end with the process
+  static ThreadPoolData& threadpool_data() {
+    static ThreadPoolData* d = new ThreadPoolData;
+    return *d;
+  }
+
+  // participant p of np does the tasks p, p+np, p+2np, ...
+  static void threadpool_tasks(int p, int np, int n_tasks, const std::function<void(int)>& task) {
+    for (int t = p; t < n_tasks; t += np)
+      task(t);
+  }
+
+  static void threadpool_worker(ThreadPoolData* d, int w, unsigned long seen) {
+    for (;;) {
+      const std::function<void(int)>* task;
+      const std::vector<const char*>* timer_path;
+      int n_tasks, np;
+      {
+        std::unique_lock<std::mutex> lock(d->m);
+        d->work_cv.wait(lock, [d, seen] { return d->job_id != seen; });
+        seen = d->job_id;
+        if (w >= d->n_active)
+          continue;
+        task = d->task;
+        n_tasks = d->n_tasks;
+        np = d->n_active;
+        timer_path = &d->timer_path;
+      }
+      ThreadPlacement::pin_self(w);
+      {
+        //timers of the tasks are attached below those running in the calling thread
+        ScopedTimerPath scoped_path(*timer_path);
+        threadpool_tasks(w, np, n_tasks, *task);
+      }
+      {
+        std::lock_guard<std::mutex> lock(d->m);
+        if (--d->pending == 0)
+          d->done_cv.notify_one();
+      }
+    }
+  }
+
+  // *************************************************************************
+  //                                  run
+  // *************************************************************************
+
+  int ThreadPool::run(int n_tasks, const std::function<void(int)>& task) {
+    if (n_tasks <= 0)
+      return 1;
+    ThreadPoolData& d = threadpool_data();
+    std::unique_lock<std::mutex> dispatch(d.dispatch, std::try_to_lock);
+    if ((n_tasks == 1) || (!dispatch.owns_lock())) {
+      threadpool_tasks(0, 1, n_tasks, task);
+      return 1;
+    }
+
+    const int np = (n_tasks - 1 < max_workers) ? n_tasks : max_workers + 1;
+    {
+      std::lock_guard<std::mutex> lock(d.m);
+      TimerRegistry::get_current_path(d.timer_path);
+      while (int(d.workers.size()) < np - 1)
+        d.workers.push_back(std::thread(threadpool_worker, &d, int(d.workers.size()) + 1, d.job_id));
+      d.task = &task;
+      d.n_tasks = n_tasks;
+      d.n_active = np;
+      d.pending = np - 1;
+      d.job_id++;
+    }
+    d.work_cv.notify_all();
+
+    threadpool_tasks(0, np, n_tasks, task);
+
+    std::unique_lock<std::mutex> lock(d.m);
+    d.done_cv.wait(lock, [&d] { return d.pending == 0; });
+    d.task = 0;
+    return 0;
+  }
+
+  // *************************************************************************
+  //                                n_workers
+  // *************************************************************************
+
+  int ThreadPool::n_workers() {
+    ThreadPoolData& d = threadpool_data();
+    std::lock_guard<std::mutex> lock(d.m);
+    return int(d.workers.size());
+  }
+
+}
@@ -0,0 +1,94 @@
+/* ****************************************************************************
+
+    Copyright (C) 2026  ConicBundle contributors
+
+    ConicBundle, Version 1.a.2
+    File:  Tools/thread_pool.hxx
+    This file is part of ConciBundle, a C/C++ library for convex optimization.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+
+
+#ifndef CH_TOOLS__THREAD_POOL_HXX
+#define CH_TOOLS__THREAD_POOL_HXX
+
+/**  @file thread_pool.hxx
+    @brief Header declaring the class CH_Tools::ThreadPool, the persistent worker threads shared by all parallel loops of the library
+    @version 1.0
+    @date 2026-10-19
+    @author ConicBundle contributors
+
+*/
+
+#include <functional>
+
+namespace CH_Tools {
+
+  /**@defgroup ThreadPool ThreadPool (persistent worker threads)
+
+     All parallel loops of the library (first touch in
+     CH_Matrix_Classes::Memarray, the kernels of sumop and sparseop, the
+     argument transformation of AffineFunctionTransformation, the triangle
+     separation, the batch aggregation of minorants and primal data) split
+     their work into n tasks numbered 0,...,n-1 and hand them to
+     ThreadPool::run(). Task 0 is done by the calling thread, task t>0 by
+     worker number t. The workers are started when first needed and are
+     then kept waiting for the next call, so a call only costs a wake up
+     and no thread creation.
+
+     Before it starts on its task a worker calls
+     ThreadPlacement::pin_self() with its number, so with pinning switched
+     on worker t always runs on the same processor and touches its memory
+     from there, see @ref ThreadPlacement. The timers of its tasks are
+     attached below the timers running in the calling thread, see
+     @ref TimerRegistry.
+
+     Only one thread at a time can use the workers. If they are in use
+     (by another thread, or because run() is called from within a task),
+     run() simply does all tasks in the calling thread. The tasks must
+     therefore not depend on running concurrently. As
+     CH_Matrix_Classes::Memarray is not thread safe, the tasks must not
+     create or resize any matrices.
+  */
+  //@{
+
+  /** @brief runs loops of independent tasks on persistent worker threads, see @ref ThreadPool
+
+      All routines are static, the workers are shared by all solvers of the process.
+  */
+  class ThreadPool {
+  public:
+    /// at most this many workers are started, for more tasks each worker does several of them
+    static const int max_workers = 256;
+
+    /** @brief calls task(t) for t=0,...,n_tasks-1, task 0 in the calling thread and the others on the workers; returns after all tasks are done
+
+        @return
+          - 0 if the tasks were run in parallel
+          - 1 if all tasks were run by the calling thread (n_tasks<=1 or the workers are in use)
+    */
+    static int run(int n_tasks, const std::function<void(int)>& task);
+
+    /// returns the number of worker threads started so far
+    static int n_workers();
+  };
+
+  //@}
+
+}
+
+#endif
@@ -0,0 +1,245 @@
+/* ****************************************************************************
+
+    Copyright (C) 2026  ConicBundle contributors
+
+    ConicBundle, Version 1.a.2
+    File:  Tools/timer_registry.cxx
+    This file is part of ConciBundle, a C/C++ library for convex optimization.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include "timer_registry.hxx"
+
+namespace CH_Tools {
+
+  /// a node of the timer tree of one thread
+  class TimerNode {
+  public:
+    const char* name;      ///< points to a string with static storage duration
+    TimerNode* parent;     ///< 0 for the root
+    unsigned long calls;   ///< number of times the timer was started
+    long long nanosecs;    ///< total time
+    long long count;       ///< sum of the counts
+    std::vector<std::unique_ptr<TimerNode> > children; ///< in order of first use
+
+    TimerNode(const char* n = 0, TimerNode* p = 0) :name(n), parent(p), calls(0), nanosecs(0), count(0) {
+    }
+
+    /// returns the child with this name, creates it if it does not exist yet
+    TimerNode* child(const char* n) {
+      for (std::size_t i = 0; i < children.size(); i++) {
+        TimerNode* c = children[i].get();
+        if ((c->name == n) || (std::strcmp(c->name, n) == 0))
+          return c;
+      }
+      children.push_back(std::unique_ptr<TimerNode>(new TimerNode(n, this)));
+      return children.back().get();
+    }
+
+    /// adds the values of src and its subtree
+    void merge(const TimerNode& src) {
+      calls += src.calls;
+      nanosecs += src.nanosecs;
+      count += src.count;
+      for (std::size_t i = 0; i < src.children.size(); i++)
+        child(src.children[i]->name)->merge(*src.children[i]);
+    }
+
+    /// sets all values in the subtree to zero but keeps the nodes (running timers may point to them)
+    void zero() {
+      calls = 0;
+      nanosecs = 0;
+      count = 0;
+      for (std::size_t i = 0; i < children.size(); i++)
+        children[i]->zero();
+    }
+
+    /// returns true if this node or a node of its subtree holds nonzero values
+    bool used() const {
+      if ((calls > 0) || (count != 0))
+        return true;
+      for (std::size_t i = 0; i < children.size(); i++)
+        if (children[i]->used())
+          return true;
+      return false;
+    }
+
+    /// appends the used nodes of the subtree in depth first order
+    void flatten(std::vector<TimerEntry>& entries, int depth) const {
+      for (std::size_t i = 0; i < children.size(); i++) {
+        const TimerNode* c = children[i].get();
+        if (!c->used())
+          continue;
+        TimerEntry e;
+        e.name = c->name;
+        e.depth = depth;
+        e.calls = c->calls;
+        e.seconds = double(c->nanosecs) * 1e-9;
+        e.count = c->count;
+        entries.push_back(e);
+        c->flatten(entries, depth + 1);
+      }
+    }
+  };
+
+  namespace {
+
+    /// the timer tree of one thread together with the node of its innermost running timer
+    struct ThreadTimers {
+      TimerNode root;
+      TimerNode* current;
+      ThreadTimers() :current(&root) {
+      }
+    };
+
+    /// the shared part of the registry
+    struct RegistryData {
+      std::mutex mtx;                    ///< protects live and retired
+      std::vector<ThreadTimers*> live;   ///< trees of running threads
+      TimerNode retired;                 ///< merged trees of finished threads
+    };
+
+    RegistryData& registry_data() {
+      static RegistryData rd;
+      return rd;
+    }
+
+    /// on thread exit the tree of the thread is merged into the retired tree
+    struct ThreadTimersHolder {
+      ThreadTimers* tt;
+      ThreadTimersHolder() :tt(0) {
+      }
+      ~ThreadTimersHolder() {
+        if (tt == 0)
+          return;
+        RegistryData& rd = registry_data();
+        std::lock_guard<std::mutex> lock(rd.mtx);
+        rd.retired.merge(tt->root);
+        rd.live.erase(std::find(rd.live.begin(), rd.live.end(), tt));
+        delete tt;
+      }
+    };
+
+    thread_local ThreadTimersHolder thread_timers;
+
+    ThreadTimers& get_thread_timers() {
+      if (thread_timers.tt == 0) {
+        RegistryData& rd = registry_data();
+        std::lock_guard<std::mutex> lock(rd.mtx);
+        thread_timers.tt = new ThreadTimers;
+        rd.live.push_back(thread_timers.tt);
+      }
+      return *thread_timers.tt;
+    }
+
+  }
+
+  std::atomic<bool> TimerRegistry::enabled(false);
+
+  TimerNode* TimerRegistry::enter(const char* name) {
+    ThreadTimers& tt = get_thread_timers();
+    tt.current = tt.current->child(name);
+    return tt.current;
+  }
+
+  void TimerRegistry::leave(TimerNode* node, long long nanosecs) {
+    node->calls++;
+    node->nanosecs += nanosecs;
+    get_thread_timers().current = node->parent;
+  }
+
+  TimerNode* TimerRegistry::enter_path(const std::vector<const char*>& path) {
+    ThreadTimers& tt = get_thread_timers();
+    TimerNode* prev = tt.current;
+    TimerNode* node = &tt.root;
+    for (std::size_t i = 0; i < path.size(); i++)
+      node = node->child(path[i]);
+    tt.current = node;
+    return prev;
+  }
+
+  void TimerRegistry::leave_path(TimerNode* node) {
+    get_thread_timers().current = node;
+  }
+
+  void TimerRegistry::get_current_path(std::vector<const char*>& path) {
+    path.clear();
+    if (!is_enabled())
+      return;
+    for (const TimerNode* node = get_thread_timers().current; node->parent; node = node->parent)
+      path.push_back(node->name);
+    std::reverse(path.begin(), path.end());
+  }
+
+  void TimerRegistry::add_count(const char* name, long long n) {
+    if (!is_enabled())
+      return;
+    ThreadTimers& tt = get_thread_timers();
+    tt.current->child(name)->count += n;
+  }
+
+  void TimerRegistry::reset() {
+    RegistryData& rd = registry_data();
+    std::lock_guard<std::mutex> lock(rd.mtx);
+    rd.retired.children.clear();
+    for (std::size_t i = 0; i < rd.live.size(); i++)
+      rd.live[i]->root.zero();
+  }
+
+  void TimerRegistry::get_entries(std::vector<TimerEntry>& entries) {
+    entries.clear();
+    TimerNode total;
+    {
+      RegistryData& rd = registry_data();
+      std::lock_guard<std::mutex> lock(rd.mtx);
+      total.merge(rd.retired);
+      for (std::size_t i = 0; i < rd.live.size(); i++)
+        total.merge(rd.live[i]->root);
+    }
+    total.flatten(entries, 0);
+  }
+
+  std::ostream& TimerRegistry::print(std::ostream& out) {
+    std::vector<TimerEntry> entries;
+    get_entries(entries);
+    std::ios_base::fmtflags old_flags = out.flags();
+    std::streamsize old_prec = out.precision();
+    out << std::left << std::setw(56) << "timer" << std::right;
+    out << std::setw(10) << "calls" << std::setw(14) << "seconds" << std::setw(14) << "count" << "\n";
+    out << std::fixed << std::setprecision(6);
+    for (std::size_t i = 0; i < entries.size(); i++) {
+      const TimerEntry& e = entries[i];
+      std::string name(std::size_t(2 * e.depth), ' ');
+      name += e.name;
+      out << std::left << std::setw(56) << name << std::right;
+      if (e.calls > 0)
+        out << std::setw(10) << e.calls << std::setw(14) << e.seconds;
+      else
+        out << std::setw(24) << "";
+      out << std::setw(14) << e.count << "\n";
+    }
+    out.flags(old_flags);
+    out.precision(old_prec);
+    return out;
+  }
+
+}
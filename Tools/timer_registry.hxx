@@ -0,0 +1,193 @@
+/* ****************************************************************************
+
+    Copyright (C) 2026  ConicBundle contributors
+
+    ConicBundle, Version 1.a.2
+    File:  Tools/timer_registry.hxx
+    This file is part of ConciBundle, a C/C++ library for convex optimization.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+
+
+#ifndef CH_TOOLS__TIMER_REGISTRY_HXX
+#define CH_TOOLS__TIMER_REGISTRY_HXX
+
+/**  @file timer_registry.hxx
+    @brief Header declaring the classes CH_Tools::TimerRegistry, CH_Tools::ScopedTimer and CH_Tools::ScopedTimerPath for collecting hierarchical timing and counting statistics
+    @version 1.0
+    @date 2026-10-18
+    @author ConicBundle contributors
+
+*/
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace CH_Tools {
+
+  /**@defgroup TimerRegistry TimerRegistry (hierarchical timers and counters)
+
+     A CH_Tools::ScopedTimer measures the wall clock time (by the monotonic
+     std::chrono::steady_clock) from its construction to its destruction
+     and adds it to the node of the global CH_Tools::TimerRegistry that
+     has the timer's name and is a child of the node of the innermost
+     timer running in the same thread. Thus the nodes form a tree that
+     follows the call structure, e.g., solver, the tree of function
+     models, the oracles, the quadratic subproblem, the KKT systems
+     and the Lanczos method. Counters (see TimerRegistry::add_count())
+     are attached to the same tree.
+
+     Each thread accumulates into a tree of its own without any locking;
+     on thread exit it is merged into the registry. The workers of
+     CH_Tools::ThreadPool attach their timers below the path of the
+     timers running in the thread that called ThreadPool::run() (see
+     ScopedTimerPath), so the work of the tasks appears at the same
+     place in the merged tree as if it had been done by the caller. get_entries() and
+     print() merge the trees of all threads. reset(), get_entries()
+     and print() should only be called while no timed computation is
+     running in other threads.
+
+     Timing is switched off by default; in this case a ScopedTimer
+     only costs the check of an atomic flag.
+  */
+  //@{
+
+  /// one node of the timer tree as returned by TimerRegistry::get_entries()
+  struct TimerEntry {
+    std::string name;    ///< name of the timer or counter
+    int depth;           ///< depth in the tree, the outermost timers have depth 0
+    unsigned long calls; ///< number of times the timer was started
+    double seconds;      ///< total wall clock time in seconds
+    long long count;     ///< sum of the values added by TimerRegistry::add_count()
+  };
+
+  class TimerNode;
+
+  /** @brief global registry of the hierarchical timers and counters, see @ref TimerRegistry
+
+      All routines are static, the registry is shared by all solvers of the process.
+   */
+  class TimerRegistry {
+  private:
+    static std::atomic<bool> enabled; ///< if false, timers and counters do nothing
+
+    friend class ScopedTimer;
+    /// makes the child @a name of the current node of this thread the current node and returns it
+    static TimerNode* enter(const char* name);
+    /// adds the time to @a node and makes its parent the current node of this thread
+    static void leave(TimerNode* node, long long nanosecs);
+
+    friend class ScopedTimerPath;
+    /// makes the node at the end of @a path (starting at the root) the current node of this thread and returns the previous one
+    static TimerNode* enter_path(const std::vector<const char*>& path);
+    /// makes @a node the current node of this thread
+    static void leave_path(TimerNode* node);
+
+  public:
+    /// switch the collection of timing and counting data on or off (default off)
+    static void set_enabled(bool on) {
+      enabled.store(on, std::memory_order_relaxed);
+    }
+
+    /// returns true if timing and counting data is collected
+    static bool is_enabled() {
+      return enabled.load(std::memory_order_relaxed);
+    }
+
+    /** @brief if enabled, adds @a n to the counter @a name, which is a child of the node of the innermost running timer of this thread
+
+        @a name must point to a string with static storage duration (e.g. a string literal)
+    */
+    static void add_count(const char* name, long long n = 1);
+
+    /// stores the names of the running timers of this thread from the outermost to the innermost (empty if disabled)
+    static void get_current_path(std::vector<const char*>& path);
+
+    /// sets all times and counts to zero
+    static void reset();
+
+    /// stores the nodes of the tree merged over all threads in depth first order
+    static void get_entries(std::vector<TimerEntry>& entries);
+
+    /// prints the tree merged over all threads as an indented table
+    static std::ostream& print(std::ostream& out);
+  };
+
+  /** @brief adds the wall clock time between its construction and destruction to the node @a name of the TimerRegistry
+
+      @a name must point to a string with static storage duration (e.g. a string literal)
+  */
+  class ScopedTimer {
+  private:
+    TimerNode* node;  ///< 0 if the registry was disabled on construction
+    std::chrono::steady_clock::time_point start; ///< time of construction
+
+    ScopedTimer(const ScopedTimer&);            ///< not available
+    ScopedTimer& operator=(const ScopedTimer&); ///< not available
+
+  public:
+    /// starts the timer if the registry is enabled
+    explicit ScopedTimer(const char* name) :node(0) {
+      if (TimerRegistry::is_enabled()) {
+        node = TimerRegistry::enter(name);
+        start = std::chrono::steady_clock::now();
+      }
+    }
+
+    /// stops the timer and adds the time to its node
+    ~ScopedTimer() {
+      if (node)
+        TimerRegistry::leave(node, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+  };
+
+  /** @brief while it exists, the timers and counters of this thread are attached below the node given by the path of timer names
+
+      The path is typically obtained by TimerRegistry::get_current_path()
+      in another thread; ThreadPool uses this so that the timers of a task
+      done by a worker appear below the timers running in the thread that
+      handed out the task. The nodes of the path are not timed themselves.
+  */
+  class ScopedTimerPath {
+  private:
+    TimerNode* prev;  ///< the current node before construction, 0 if nothing was changed
+
+    ScopedTimerPath(const ScopedTimerPath&);            ///< not available
+    ScopedTimerPath& operator=(const ScopedTimerPath&); ///< not available
+
+  public:
+    /// makes the node at the end of @a path the current node of this thread if @a path is not empty
+    explicit ScopedTimerPath(const std::vector<const char*>& path) :prev(0) {
+      if (!path.empty())
+        prev = TimerRegistry::enter_path(path);
+    }
+
+    /// restores the previous current node
+    ~ScopedTimerPath() {
+      if (prev)
+        TimerRegistry::leave_path(prev);
+    }
+  };
+
+  //@}
+
+}
+
+#endif
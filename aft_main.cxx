@@ -0,0 +1,313 @@
+/* ****************************************************************************
+
+    Copyright (C) 2026  ConicBundle contributors
+
+    ConicBundle, Version 1.a.2
+    File:  aft_main.cxx
+    This file is part of ConciBundle, a C/C++ library for convex optimization.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+/* Checks of the blockwise evaluation of support functions while an
+   AffineFunctionTransformation computes their argument.
+
+   For a random arg_trafo with empty rows and an offset, the argument
+   computed blockwise has to match genmult(), and the results of
+   NNCBoxSupportBlockEvaluator, BoxBlockEvaluator and
+   SOCSupportBlockEvaluator have to match the plain evaluation of
+   NNCBoxSupportFunction, of the box formula of BoxModel and of
+   SOCSupportFunction in this argument; for 1 and 3 threads the results
+   have to coincide exactly. An evaluator that refuses the blocks must
+   leave the argument correct. Finally a MatrixCBSolver minimizing an
+   NNCBoxSupportFunction behind an AFT (evaluated blockwise) has to reach
+   the value of the same problem with the oracle hidden behind a plain
+   MatrixFunctionOracle (evaluated as before), and in the blockwise
+   case NNCBoxSupportFunction::evaluate() must not be called at all.
+   The program prints one line per check and returns the number of
+   failed checks.
+*/
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include "NNCBoxSupportFunction.hxx"
+#include "SOCSupportFunction.hxx"
+#include "BoxModel.hxx"
+#include "MatrixCBSolver.hxx"
+#include "gb_rand.hxx"
+
+using namespace std;
+using namespace CH_Matrix_Classes;
+using namespace ConicBundle;
+
+static int n_failed = 0;
+
+static void check(bool ok, const char* what) {
+  cout << ((ok) ? " ok     " : " FAILED ") << what << endl;
+  if (!ok)
+    n_failed++;
+}
+
+// a random m x n matrix with about nz_per_row nonzeros in every row but each seventh
+static Sparsemat* random_trafo(Integer m, Integer n, Integer nz_per_row, CH_Tools::GB_rand& rg) {
+  Integer nz = 0;
+  for (Integer i = 0; i < m; i++)
+    if (i % 7 != 3)
+      nz += nz_per_row;
+  Indexmatrix I(nz, 1);
+  Indexmatrix J(nz, 1);
+  Matrix V(nz, 1);
+  Integer h = 0;
+  for (Integer i = 0; i < m; i++) {
+    if (i % 7 == 3)
+      continue;
+    for (Integer k = 0; k < nz_per_row; k++, h++) {
+      I(h) = i;
+      J(h) = Integer(rg.unif_long(n));
+      V(h) = 2. * rg.next() - 1.;
+    }
+  }
+  return new Sparsemat(m, n, nz, I, J, V);
+}
+
+// the coefficients of a minorant with dimension dim as a dense vector
+static Matrix dense_coeffs(Minorant* mnrt, Integer dim) {
+  Matrix x(dim, 1, 0.);
+  int n;
+  const double* coeffs;
+  const int* indices;
+  mnrt->get_coeffs(n, coeffs, indices);
+  for (int i = 0; i < n; i++)
+    x(indices ? Integer(indices[i]) : Integer(i)) += coeffs[i];
+  return x;
+}
+
+static bool close(Real a, Real b) {
+  return std::fabs(a - b) <= 1e-12 * (std::fabs(a) + std::fabs(b) + 1.);
+}
+
+// compares the blockwise evaluations with the plain ones for nt threads and
+// returns the transformed argument and the three values for comparing thread numbers
+static void compare_blocks(Integer nt, Matrix& out, Matrix& vals) {
+  CH_Tools::GB_rand rg(5);
+  const Integer m = 21000;
+  const Integer n = 400;
+  Sparsemat* A = random_trafo(m, n, 8, rg);
+  Matrix* offset = new Matrix(m, 1);
+  for (Integer i = 0; i < m; i++)
+    (*offset)(i) = rg.next() - 0.5;
+  Matrix y(n, 1);
+  for (Integer j = 0; j < n; j++)
+    y(j) = 2. * rg.next() - 1.;
+  Matrix z(*offset);
+  genmult(*A, y, z, 1., 1.);
+  AffineFunctionTransformation aft(1., 0., 0, offset, A);
+  aft.set_n_threads(nt);
+  char what[200];
+  vals.init(3, 1, 0.);
+
+  //NNC box with mostly zero maximizer (sparse minorant) and with bounds -1,1 (dense)
+  for (int dense = 0; dense < 2; dense++) {
+    Matrix lb(m, 1, (dense) ? -1. : 0.);
+    Matrix ub(m, 1, 0.);
+    for (Integer i = 0; i < m; i++)
+      ub(i) = ((dense) || (i % 3 == 0)) ? 1. : 0.;
+    NNCBoxSupportFunction fun(lb, ub);
+    NNCBoxSupportBlockEvaluator ev;
+    ev.set_function(&fun);
+    Real offs;
+    const Matrix& ty = aft.transform_argument(out, offs, y, &ev);
+    Real val;
+    std::vector<Minorant*> mnrts;
+    bool ok = (&ty == &out) && (ev.get_result(out, val, mnrts) == 0) && (mnrts.size() == 1);
+    ok = ok && (norm2(out - z) <= 1e-12 * (norm2(z) + 1.));
+    Real refval;
+    std::vector<Minorant*> refmnrts;
+    PrimalExtender* pe = 0;
+    ok = ok && (fun.evaluate(out, 1e-10, refval, refmnrts, pe) == 0) && (refmnrts.size() == 1);
+    ok = ok && close(val, refval) && equal(dense_coeffs(mnrts[0], m), dense_coeffs(refmnrts[0], m));
+    int nmnrt;
+    const double* coeffs;
+    const int* indices;
+    mnrts[0]->get_coeffs(nmnrt, coeffs, indices);
+    ok = ok && ((indices != 0) == (dense == 0));
+    snprintf(what, sizeof(what), "NNCBoxSupportBlockEvaluator, %s maximizer, %ld threads", (dense) ? "dense" : "sparse", long(nt));
+    check(ok, what);
+    if (dense)
+      vals(0) = val;
+    for (unsigned int i = 0; i < mnrts.size(); i++)
+      delete mnrts[i];
+    for (unsigned int i = 0; i < refmnrts.size(); i++)
+      delete refmnrts[i];
+  }
+
+  //box as evaluated by BoxModel, switches are counted against a previous maximizer
+  {
+    Matrix lb(m, 1, 0.);
+    Matrix ub(m, 1, 0.);
+    for (Integer i = 0; i < m; i++) {
+      lb(i) = (i % 4 == 0) ? -1. : 0.;
+      ub(i) = (i % 5 == 0) ? 2. : 0.;
+    }
+    BoxOracle bo(lb, ub);
+    Matrix oldbox(m, 1, 0.);
+    Matrix oldsw(m, 1, 0.);
+    for (Integer i = 0; i < m; i++) {
+      oldbox(i) = (i % 2) ? lb(i) : ub(i);
+      oldsw(i) = Real(i % 3);
+    }
+    BoxBlockEvaluator ev;
+    ev.set_data(&bo, &oldbox, &oldsw);
+    Real offs;
+    aft.transform_argument(out, offs, y, &ev);
+    Real val;
+    Integer nz;
+    Matrix box;
+    Matrix sw;
+    std::vector<int> ind;
+    bool ok = (ev.get_result(out, val, nz, box, sw, ind) == 0);
+    Real refval = 0.;
+    Matrix refbox(m, 1);
+    Matrix refsw(m, 1);
+    std::vector<int> refind;
+    for (Integer i = 0; i < m; i++) {
+      refbox(i) = (out(i) < 0) ? lb(i) : ub(i);
+      refval += refbox(i) * out(i);
+      refsw(i) = .9 * oldsw(i) + ((oldbox(i) != refbox(i)) ? 1. : 0.);
+      if (refbox(i) != 0.)
+        refind.push_back(int(i));
+    }
+    ok = ok && close(val, refval) && equal(box, refbox) && equal(sw, refsw);
+    ok = ok && (nz == Integer(refind.size())) && (2 * nz <= m) && (ind == refind);
+    snprintf(what, sizeof(what), "BoxBlockEvaluator, %ld threads", long(nt));
+    check(ok, what);
+    vals(1) = val;
+  }
+
+  //second order cone
+  {
+    SOCSupportFunction fun(m);
+    SOCSupportBlockEvaluator ev;
+    ev.set_function(&fun);
+    Real offs;
+    aft.transform_argument(out, offs, y, &ev);
+    Real val;
+    Matrix x;
+    bool ok = (ev.get_result(out, val, x) == 0);
+    Real refval;
+    Matrix refx;
+    SOCPrimalExtender* pe = 0;
+    ok = ok && (fun.evaluate(out, 1e-10, refval, refx, pe) == 0);
+    ok = ok && close(val, refval) && (norm2(x - refx) <= 1e-12);
+    snprintf(what, sizeof(what), "SOCSupportBlockEvaluator, %ld threads", long(nt));
+    check(ok, what);
+    vals(2) = val;
+  }
+
+  //an evaluator that does not match the dimension is not called
+  {
+    NNCBoxSupportFunction fun(Matrix(m + 1, 1, 0.), Matrix(m + 1, 1, 1.));
+    NNCBoxSupportBlockEvaluator ev;
+    ev.set_function(&fun);
+    Real offs;
+    Matrix out2;
+    aft.transform_argument(out2, offs, y, &ev);
+    Real val;
+    std::vector<Minorant*> mnrts;
+    bool ok = (ev.get_result(out2, val, mnrts) != 0) && (mnrts.size() == 0) && (norm2(out2 - z) <= 1e-12 * (norm2(z) + 1.));
+    snprintf(what, sizeof(what), "refused blocks leave the argument intact, %ld threads", long(nt));
+    check(ok, what);
+  }
+}
+
+/// counts the calls to NNCBoxSupportFunction::evaluate()
+class CountedNNCBox : public NNCBoxSupportFunction {
+public:
+  int n_calls;
+
+  CountedNNCBox(const Matrix& lb, const Matrix& ub) : NNCBoxSupportFunction(lb, ub), n_calls(0) {
+  }
+
+  int evaluate(const Matrix& y, Real relprec, Real& objective_value,
+    std::vector<Minorant*>& minorants, PrimalExtender*& pe) {
+    n_calls++;
+    return NNCBoxSupportFunction::evaluate(y, relprec, objective_value, minorants, pe);
+  }
+};
+
+/// hides an NNCBoxSupportFunction so that NNCModel calls it as usual
+class HiddenNNCBox : public MatrixFunctionOracle {
+  NNCBoxSupportFunction& fun;
+public:
+  HiddenNNCBox(NNCBoxSupportFunction& f) : fun(f) {
+  }
+
+  int evaluate(const Matrix& y, Real relprec, Real& objective_value,
+    std::vector<Minorant*>& minorants, PrimalExtender*& pe) {
+    return fun.evaluate(y, relprec, objective_value, minorants, pe);
+  }
+};
+
+// minimizes c'y+sum_i max(0,(Ay+b)_i) over -1<=y<=1 with or without blockwise
+// evaluation and returns the number of calls to NNCBoxSupportFunction::evaluate()
+static Real solve(bool blockwise, int& n_calls) {
+  CH_Tools::GB_rand rg(7);
+  const Integer m = 12000;
+  const Integer n = 60;
+  Sparsemat* A = random_trafo(m, n, 10, rg);
+  Matrix* offset = new Matrix(m, 1);
+  for (Integer i = 0; i < m; i++)
+    (*offset)(i) = rg.next() - 0.5;
+  Matrix costs(n, 1);
+  for (Integer j = 0; j < n; j++)
+    costs(j) = 400. * (rg.next() - 0.5);
+  CountedNNCBox fun(Matrix(m, 1, 0.), Matrix(m, 1, 1.));
+  HiddenNNCBox hidden(fun);
+  AffineFunctionTransformation* aft = new AffineFunctionTransformation(1., 0., 0, offset, A);
+  MatrixCBSolver solver;
+  Matrix lb(n, 1, -1.);
+  Matrix ub(n, 1, 1.);
+  solver.init_problem(int(n), &lb, &ub, 0, &costs);
+  if (blockwise)
+    solver.add_function(fun, 1., ObjectiveFunction, aft);
+  else
+    solver.add_function(hidden, 1., ObjectiveFunction, aft);
+  solver.set_term_relprec(1e-8);
+  int err = solver.solve();
+  n_calls = fun.n_calls;
+  if ((err) || (solver.termination_code() != 1))
+    return CB_plus_infinity;
+  return solver.get_objval();
+}
+
+int main() {
+  Matrix out1, out3, vals1, vals3;
+  compare_blocks(1, out1, vals1);
+  compare_blocks(3, out3, vals3);
+  check(equal(out1, out3) && equal(vals1, vals3), "the results for 1 and 3 threads coincide");
+
+  int n0, n1;
+  Real v0 = solve(false, n0);
+  Real v1 = solve(true, n1);
+  char what[200];
+  snprintf(what, sizeof(what), "MatrixCBSolver with AFT, value %.10f evaluated blockwise, %.10f as before", v1, v0);
+  check((v0 < CB_plus_infinity) && (std::fabs(v0 - v1) <= 1e-6 * (std::fabs(v0) + 1.)), what);
+  snprintf(what, sizeof(what), "MatrixCBSolver with AFT calls the oracle %d times blockwise (expected 0), %d times as before", n1, n0);
+  check((n1 == 0) && (n0 > 0), what);
+
+  cout << n_failed << " checks failed" << endl;
+  return n_failed;
+}
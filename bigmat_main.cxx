@@ -0,0 +1,134 @@
+/* ****************************************************************************
+
+    Copyright (C) 2026  ConicBundle contributors
+
+    ConicBundle, Version 1.a.2
+    File:  bigmat_main.cxx
+    This file is part of ConciBundle, a C/C++ library for convex optimization.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+/* Checks of matrices with more than 2^31 elements (LONGINDEX=1 only).
+
+   A Sparsemat and a Sparsesym of order 70000 have more than 2^31
+   elements but only a few nonzeros, so their element access by (i,j)
+   and by the index of the stacked columns, their transposition and
+   their products with vectors are checked in every run. With the
+   argument "dense" a Matrix of order 46341 and a Symmatrix of order
+   65536 are allocated in addition (about 17 GB each, one after the
+   other), and the entries beyond index 2^31 and the sums over all
+   entries are checked.
+
+   In the default build Integer is an int and the checks are skipped.
+   The program prints one line per check and returns the number of
+   failed checks.
+
+   usage: t_bigmat [dense]
+*/
+
+#include <climits>
+#include <cstring>
+#include <iostream>
+#include "sparsmat.hxx"
+#include "sparssym.hxx"
+#include "symmat.hxx"
+
+using namespace std;
+using namespace CH_Matrix_Classes;
+
+static int n_failed = 0;
+
+#if (CONICBUNDLE_LONG_INDEX==1)
+
+static void check(bool ok, const char* what) {
+  cout << ((ok) ? " ok     " : " FAILED ") << what << endl;
+  if (!ok)
+    n_failed++;
+}
+
+static void check_sparse() {
+  const Integer n = 70000;
+  const Integer nz = 4;
+  Indexmatrix I(nz, 1);
+  Indexmatrix J(nz, 1);
+  Matrix V(nz, 1);
+  I(0) = n - 1; J(0) = n - 1; V(0) = 1.;
+  I(1) = 0;     J(1) = n - 1; V(1) = 2.;
+  I(2) = n - 2; J(2) = 3;     V(2) = 3.;
+  I(3) = 5;     J(3) = n - 2; V(3) = 4.;
+
+  Sparsemat A(n, n, nz, I, J, V);
+  check((Real(A.rowdim()) * Real(A.coldim()) > Real(INT_MAX)) && (A.nonzeros() == nz), "Sparsemat beyond 2^31 elements");
+  check((A(n - 1, n - 1) == 1.) && (A(0, n - 1) == 2.) && (A(n - 2, 3) == 3.) && (A(6, n - 2) == 0.), "Sparsemat element (i,j)");
+  check((A(n * n - 1) == 1.) && (A(n * (n - 1)) == 2.) && (A(n * (n - 2) + 5) == 4.), "Sparsemat element of the stacked columns");
+  Sparsemat At = transpose(A);
+  check((At(n - 1, 0) == 2.) && (At(3, n - 2) == 3.) && (At(n * 5 + n - 2) == 4.), "transposed Sparsemat");
+
+  Matrix x(n, 1, 1.);
+  Matrix y;
+  genmult(A, x, y);
+  check((y(n - 1) == 1.) && (y(0) == 2.) && (y(n - 2) == 3.) && (y(5) == 4.) && (sum(y) == 10.), "Sparsemat times vector");
+  genmult(A, x, y, 1., 0., 1);
+  check((y(n - 1) == 3.) && (y(3) == 3.) && (y(n - 2) == 4.) && (sum(y) == 10.), "transposed Sparsemat times vector");
+
+  Sparsesym S(n, nz, I, J, V);
+  check((S.rowdim() * (S.rowdim() + 1) / 2 > Integer(INT_MAX)) && (S.nonzeros() == nz), "Sparsesym beyond 2^31 elements");
+  check((S(n - 1, n - 1) == 1.) && (S(n - 1, 0) == 2.) && (S(3, n - 2) == 3.) && (S(n - 2, 5) == 4.), "Sparsesym element (i,j)");
+  check((S(n * n - 1) == 1.) && (S(n * (n - 1)) == 2.) && (S(n - 1) == 2.), "Sparsesym element of the stacked columns");
+  check((trace(S) == 1.) && (sum(S) == 1. + 2. * (2. + 3. + 4.)), "Sparsesym trace() and sum()");
+  genmult(S, x, y, 1., 0., 0);
+  check((y(n - 1) == 3.) && (y(0) == 2.) && (y(3) == 3.) && (sum(y) == 19.), "Sparsesym times vector");
+}
+
+static void check_dense() {
+  {
+    const Integer n = 46341;
+    Matrix A(n, n, 1.);
+    A(n - 1, n - 1) = 2.;
+    A(n - 1, 0) = 3.;
+    check(A.dim() > Integer(INT_MAX), "Matrix beyond 2^31 elements");
+    check((A(A.dim() - 1) == 2.) && (A(n - 1) == 3.) && (A(n - 2, n - 1) == 1.), "Matrix element beyond index 2^31");
+    check(sum(A) == Real(A.dim()) + 3., "Matrix sum()");
+  }
+  {
+    const Integer n = 65536;
+    Symmatrix S(n, 1.);
+    S(n - 1, n - 1) = 2.;
+    S(n - 1, n - 2) = 3.;
+    check(n * (n + 1) / 2 > Integer(INT_MAX), "Symmatrix beyond 2^31 elements");
+    check((S(n - 2, n - 1) == 3.) && (S(n * n - 1) == 2.) && (S(n - 1, 0) == 1.), "Symmatrix element beyond index 2^31");
+    check((trace(S) == Real(n) + 1.) && (sum(S) == Real(n) * Real(n) + 1. + 4.), "Symmatrix trace() and sum()");
+  }
+}
+
+#endif
+
+int main(int argc, char** argv) {
+#if (CONICBUNDLE_LONG_INDEX==1)
+  check_sparse();
+  if ((argc > 1) && (strcmp(argv[1], "dense") == 0))
+    check_dense();
+  else
+    cout << " dense checks skipped, run t_bigmat dense (needs about 18 GB)" << endl;
+#else
+  (void)argc;
+  (void)argv;
+  cout << " Integer is an int, build with LONGINDEX=1 for the checks beyond 2^31 elements" << endl;
+#endif
+
+  cout << n_failed << " checks failed" << endl;
+  return n_failed;
+}
@@ -10,7 +10,8 @@ adapt = {"matrix.hxx": ["Matrix"], "indexmat.hxx": ["Indexmatrix"], "sparsmat.hx
          "SparseCoeffmatMatrix.hxx": ["SparseCoeffmatMatrix"], "gb_rand.hxx": ["GB_rand"], "Coeffmat.hxx": ["CoeffmatInfo"],
          "MatrixCBSolver.hxx": ["PrimalMatrix<:PrimalData", "MatrixCBSolver"],
          "PSCPrimal.hxx": ["BlockPSCPrimal<:PSCPrimal<:PrimalData", "DensePSCPrimal<:PSCPrimal",
-                           "GramSparsePSCPrimal<:PSCPrimal", "SparsePSCPrimal<:PSCPrimal"],
+                           "GramSparsePSCPrimal<:PSCPrimal", "LowRankSparsePSCPrimal<:PSCPrimal",
+                           "SparsePSCPrimal<:PSCPrimal"],
          "AFTModification.hxx": ["AFTModification<:OracleModification"],
          "GroundsetModification.hxx": ["GroundsetModification<:OracleModification"],
          "NNCBoxSupportModification.hxx": ["NNCBoxSupportModification<:OracleModification"],
@@ -64,6 +65,7 @@ adapt = {"matrix.hxx": ["Matrix"], "indexmat.hxx": ["Indexmatrix"], "sparsmat.hx
          "QPIterativeKKTHAeqSolver.hxx": ["QPIterativeKKTHAeqSolver<:QPIterativeKKTSolver<:QPKKTSolverObject"],
          "QPIterativeKKTHASolver.hxx": ["QPIterativeKKTHASolver<:QPIterativeKKTSolver<:QPKKTSolverObject"],
          "QPKKTSolverComparison.hxx": ["QPKKTSolverComparison<:QPKKTSOlverObject"],
+         "QPKKTSolverAutoSelect.hxx": ["QPKKTSolverAutoSelect<:QPKKTSolverObject"],
          "SumBundleHandler.hxx": ["SumBundleHandler"],
          "QPConeModelBlock.hxx": ["QPConeModelBlock<:QPModelBlock<:QPModelBlockObject"],
          "QPSumModelBlock.hxx": ["QPSumModelBlock<:QPModelBlock"],
@@ -80,7 +82,7 @@ adapt = {"matrix.hxx": ["Matrix"], "indexmat.hxx": ["Indexmatrix"], "sparsmat.hx
 paramexpr = re.compile(r"(const\s+)?([A-Za-z_:\d]++)\s*([&*])?\s*([A-Za-z_\d]*)(?:\s*=\s*(.*))?")
 nativetypes = {"void": "Nothing", "int": "Integer", "float": "Real", "double": "Real", "char": "UInt8", "long": "Integer",
                "short": "Integer", "Integer": "Integer", "Real": "Real", "bool": "Bool", "cb_subgextp": "Ptr{Cvoid}",
-               "cb_functionp": "Ptr{Cvoid}"}
+               "cb_functionp": "Ptr{Cvoid}", "cb_sparse_functionp": "Ptr{Cvoid}"}
 enums = {"FunctionTask": "CBFunctionTask", "ModelUpdate": "CBModelUpdate", "Mode": "CBMode", "SumBundle::Mode": "CBMode"}
 nativeenums = nativetypes | enums
 ignorefuncs = {"set_init", "get_init", "get_mtype", "operator[]", "clone_primal_data"}
@@ -126,7 +128,7 @@ f_total.write("""function cb_destroy!(obj, rest...)
 end
 
 """)#include("cb_classes.jl")\n')
-f_total_c.write('#include "cb_cinterface.h"\n')
+f_total_c.write('#include <cstring>\n#include <cassert>\n#include <limits>\n#include "cb_cinterface.h"\n')
 for fn in adapt:
     f_total_c.write(f'#include "{fn}"\n')
 f_total_c.write("""using namespace CH_Matrix_Classes;
@@ -151,6 +153,13 @@ end
 
 Base.convert(::Type{<:StdVector}, vec::AbstractVector) = StdVector(vec)
 
+""")
+# CH_Matrix_Classes::Integer is a long in a LONGINDEX=1 build (see ../include/CBconfig.hxx)
+with open("../include/CBconfig.hxx", "r") as file:
+    long_index = re.search(r"#define\s+CONICBUNDLE_LONG_INDEX\s+1\b", file.read()) is not None
+f_classes.write(f"""# the Integer type of the library the bindings were generated for, check with cb_check_integer_size()
+const CBInteger = {'Clong' if long_index else 'Cint'}
+
 """)
 f_doc.write("""
 ```@meta
@@ -383,12 +392,12 @@ cb_destroy!(obj::{juliatype}) = @ccall libcb.{nameprefix}destroy(obj.data::Ptr{{
                         if returntype in nativetypes:
                             julia_end += r"Ptr{"
                     if returntype == "Integer":
-                        julia_end += "Cint"
+                        julia_end += "CBInteger"
                     elif returntype == "Real":
                         julia_end += "Cdouble"
                     elif returntype == "bool":
                         julia_end += "Bool" # warning is printed above, as this might be wrong
-                    elif returntype in {"cb_subgextp", "cb_functionp"}:
+                    elif returntype in {"cb_subgextp", "cb_functionp", "cb_sparse_functionp"}:
                         julia_end += "Ptr{Cvoid}"
                     elif returntype in nativetypes:
                         julia_end += f"C{returntype}"
@@ -504,7 +513,7 @@ cb_destroy!(obj::{juliatype}) = @ccall libcb.{nameprefix}destroy(obj.data::Ptr{{
                                 functionparams.append(f"Integer {paramname}_from, Integer {paramname}_to, Integer {paramname}_step = 1")
                                 functionbodyparams.append(f"Range({paramname}_from, {paramname}_to, {paramname}_step)")
                                 julia_parameters.append(f"{paramname}::AbstractRange{{<:Integer}}")
-                                julia_bodyparameters.append(f"first({paramname})::Cint, last({paramname})::Cint, step({paramname})::Cint")
+                                julia_bodyparameters.append(f"first({paramname})::CBInteger, last({paramname})::CBInteger, step({paramname})::CBInteger")
                                 continue
                             elif paramtype == "Realrange":
                                 assert paramref != "*"
@@ -555,7 +564,7 @@ cb_destroy!(obj::{juliatype}) = @ccall libcb.{nameprefix}destroy(obj.data::Ptr{{
                                     # in principle StridedVector, but it is enough if the stride interface is supported (may be
                                     # views)
                                     if paramtype == "Integer":
-                                        julia_parameter = f"{paramname}::Union{{<:AbstractVector{{Cint}},Nothing}}"
+                                        julia_parameter = f"{paramname}::Union{{<:AbstractVector{{CBInteger}},Nothing}}"
                                     elif paramtype == "Real":
                                         julia_parameter = f"{paramname}::Union{{<:AbstractVector{{Cdouble}},Nothing}}"
                                     else:
@@ -564,7 +573,9 @@ cb_destroy!(obj::{juliatype}) = @ccall libcb.{nameprefix}destroy(obj.data::Ptr{{
                                 elif paramref == "&":
                                     # these should be return values
                                     if paramtype == "Integer":
-                                        jt = "Int"
+                                        jt = "CBInteger"
+                                    elif paramtype == "int":
+                                        jt = "Cint"
                                     elif paramtype == "Real":
                                         jt = "Float64"
                                     else:
@@ -579,11 +590,13 @@ cb_destroy!(obj::{juliatype}) = @ccall libcb.{nameprefix}destroy(obj.data::Ptr{{
                                     julia_parameter = f"{paramname}::{nativeenums[paramtype]}"
                                 if paramref:
                                     julia_bodyparameter += r"Ptr{"
-                                if paramtype == "Integer" or paramtype in enums:
+                                if paramtype == "Integer":
+                                    julia_bodyparameter += "CBInteger"
+                                elif paramtype in enums:
                                     julia_bodyparameter += "Cint"
                                 elif paramtype == "Real":
                                     julia_bodyparameter += "Cdouble"
-                                elif paramtype in {"cb_subgextp", "cb_functionp"}:
+                                elif paramtype in {"cb_subgextp", "cb_functionp", "cb_sparse_functionp"}:
                                     julia_bodyparameter += "Ptr{Cvoid}"
                                 else:
                                     julia_bodyparameter += f"C{paramtype.rsplit('::', 1)[-1]}"
@@ -592,7 +605,8 @@ cb_destroy!(obj::{juliatype}) = @ccall libcb.{nameprefix}destroy(obj.data::Ptr{{
                                 if paramref == "*":
                                     if i < len(parameters) -1 and parameters[i+1].strip().startswith(("Integer inc", "int inc")):
                                         julia_skipparam = 2
-                                        julia_bodyparameter += f", stride({paramname}, 1)::Cint"
+                                        inctype = "CBInteger" if parameters[i+1].strip().startswith("Integer") else "Cint"
+                                        julia_bodyparameter += f", stride({paramname}, 1)::{inctype}"
                                     elif julia_body[0] == "(":
                                         julia_body = f"(LinearAlgebra.chkstride1({paramname}); {julia_body[1:]}"
                                     else:
@@ -710,6 +724,171 @@ cb_destroy!(obj::{juliatype}) = @ccall libcb.{nameprefix}destroy(obj.data::Ptr{{
             f_curclass_c.close()
             f_curclass_jl.close()
 
+# Julia wrappers of the hand written bulk array routines of cb_bulk.cpp
+f_bulk_jl = open("../../ConicBundle.jl/src/cppinterface/cb_bulk.jl", "w+")
+f_total.write('include("cb_bulk.jl")\n')
+f_bulk_jl.write(r'''# Bulk array routines, see cb_bulk.cpp. All indices and offsets are 0-based as in C++ and of
+# type CBInteger, the Integer type of the library (Int64 in a LONGINDEX=1 build, otherwise Cint).
+# Routines copying into a buffer return the number of entries required; if this exceeds
+# length(buf) nothing is copied. A negative value signals that the data is not available.
+# The constructing routines throw an ArgumentError if the library rejects the input, e.g.
+# indices out of range or start arrays that are not nondecreasing.
+
+@doc raw"""
+    cb_sparsemat_csr(nr, nc, rowstart, colind, val)
+
+Create a `CBSparsemat` of size `nr`x`nc` in one call from compressed row storage; row `i` holds
+the entries `rowstart[i+1]+1:rowstart[i+2]` of `colind` and `val`.
+"""
+function cb_sparsemat_csr(nr::Integer, nc::Integer, rowstart::AbstractVector{CBInteger}, colind::AbstractVector{CBInteger},
+    val::AbstractVector{Cdouble})
+    LinearAlgebra.chkstride1(rowstart, colind, val)
+    length(rowstart) == nr + 1 || throw(DimensionMismatch("rowstart must have nr+1 entries"))
+    min(length(colind), length(val)) >= rowstart[end] || throw(DimensionMismatch("colind and val must have rowstart[end] entries"))
+    GC.@preserve rowstart colind val begin
+        ptr = @ccall libcb.cb_sparsemat_new_csr(nr::CBInteger, nc::CBInteger, rowstart::Ptr{CBInteger}, colind::Ptr{CBInteger},
+            val::Ptr{Cdouble})::Ptr{Cvoid}
+        ptr == C_NULL && throw(ArgumentError("rowstart is not nondecreasing or a column index is out of range"))
+        return CBSparsemat(ptr)
+    end
+end
+
+@doc raw"""
+    cb_sparsemat_csc(nr, nc, colstart, rowind, val)
+
+Create a `CBSparsemat` of size `nr`x`nc` in one call from compressed column storage; column `j`
+holds the entries `colstart[j+1]+1:colstart[j+2]` of `rowind` and `val`.
+"""
+function cb_sparsemat_csc(nr::Integer, nc::Integer, colstart::AbstractVector{CBInteger}, rowind::AbstractVector{CBInteger},
+    val::AbstractVector{Cdouble})
+    LinearAlgebra.chkstride1(colstart, rowind, val)
+    length(colstart) == nc + 1 || throw(DimensionMismatch("colstart must have nc+1 entries"))
+    min(length(rowind), length(val)) >= colstart[end] || throw(DimensionMismatch("rowind and val must have colstart[end] entries"))
+    GC.@preserve colstart rowind val begin
+        ptr = @ccall libcb.cb_sparsemat_new_csc(nr::CBInteger, nc::CBInteger, colstart::Ptr{CBInteger}, rowind::Ptr{CBInteger},
+            val::Ptr{Cdouble})::Ptr{Cvoid}
+        ptr == C_NULL && throw(ArgumentError("colstart is not nondecreasing or a row index is out of range"))
+        return CBSparsemat(ptr)
+    end
+end
+
+@doc raw"""
+    cb_sparsecoeffmatmatrix_coo(blockdims, ncols, blocks, cols, ind_i, ind_j, val)
+
+Create a `CBSparseCoeffmatMatrix` of sparse symmetric blocks in one call; entry `k` contributes
+`val[k]` to element `(ind_i[k],ind_j[k])` of block `blocks[k]` in column `cols[k]`. For each
+block only one of `(i,j)` and `(j,i)` should be given, multiple entries are summed up.
+"""
+function cb_sparsecoeffmatmatrix_coo(blockdims::AbstractVector{CBInteger}, ncols::Integer, blocks::AbstractVector{CBInteger},
+    cols::AbstractVector{CBInteger}, ind_i::AbstractVector{CBInteger}, ind_j::AbstractVector{CBInteger}, val::AbstractVector{Cdouble})
+    LinearAlgebra.chkstride1(blockdims, blocks, cols, ind_i, ind_j, val)
+    nz = length(val)
+    length(blocks) == length(cols) == length(ind_i) == length(ind_j) == nz ||
+        throw(DimensionMismatch("blocks, cols, ind_i, ind_j and val must have the same length"))
+    GC.@preserve blockdims blocks cols ind_i ind_j val begin
+        ptr = @ccall libcb.cb_sparsecoeffmatmatrix_new_coo(length(blockdims)::CBInteger,
+            blockdims::Ptr{CBInteger}, ncols::CBInteger, nz::CBInteger, blocks::Ptr{CBInteger}, cols::Ptr{CBInteger}, ind_i::Ptr{CBInteger},
+            ind_j::Ptr{CBInteger}, val::Ptr{Cdouble})::Ptr{Cvoid}
+        ptr == C_NULL && throw(ArgumentError("a block dimension is negative or a block, column or element index is out of range"))
+        return CBSparseCoeffmatMatrix(ptr)
+    end
+end
+
+@doc raw"""
+    cb_minorants_csr(offsets, start, indices, coeffs; offset_at_origin=true)
+
+Create `length(offsets)` minorants in one call; minorant `k` has offset `offsets[k]` and the
+coefficients `coeffs[start[k]+1:start[k+1]]`. If `indices` is not `nothing` these are the
+corresponding sparse indices, otherwise the coefficients are dense. The minorants must be
+released by [`cb_destroy!`](@ref) unless they are handed over to the solver.
+"""
+function cb_minorants_csr(offsets::AbstractVector{Cdouble}, start::AbstractVector{CBInteger},
+    indices::Union{<:AbstractVector{CBInteger},Nothing}, coeffs::AbstractVector{Cdouble}; offset_at_origin::Bool=true)
+    LinearAlgebra.chkstride1(offsets, start, coeffs)
+    isnothing(indices) || LinearAlgebra.chkstride1(indices)
+    n = length(offsets)
+    length(start) == n + 1 || throw(DimensionMismatch("start must have length(offsets)+1 entries"))
+    length(coeffs) >= start[end] && (isnothing(indices) || length(indices) >= start[end]) ||
+        throw(DimensionMismatch("coeffs and indices must have start[end] entries"))
+    out = Vector{Ptr{Cvoid}}(undef, n)
+    GC.@preserve offsets start indices coeffs out begin
+        err = @ccall libcb.cb_minorants_new_csr(n::CBInteger, offset_at_origin::Cint, offsets::Ptr{Cdouble}, start::Ptr{CBInteger},
+            (isnothing(indices) ? C_NULL : pointer(indices))::Ptr{CBInteger}, coeffs::Ptr{Cdouble}, out::Ptr{Ptr{Cvoid}})::Cint
+        err == 0 || throw(ArgumentError("start is not nondecreasing or the indices of a minorant are not strictly increasing"))
+    end
+    return CBMinorant.(out)
+end
+
+@doc raw"""
+    cb_set_model_minorants_csr!(self, function_, function_value, offsets, start, indices, coeffs; offset_at_origin=true)
+
+Hand the minorants described as in [`cb_minorants_csr`](@ref) to the cutting model of `function_`
+in one call (see `MatrixCBSolver::set_model_minorants()`); `function_value` is the value of the
+function in the point of the next call to `cb_set_new_center_point!`. Returns 0 on success and 1
+without changing the model if the input is invalid.
+"""
+function cb_set_model_minorants_csr!(self::CBMatrixCBSolver, function_::CBFunctionObject, function_value::Real,
+    offsets::AbstractVector{Cdouble}, start::AbstractVector{CBInteger}, indices::Union{<:AbstractVector{CBInteger},Nothing},
+    coeffs::AbstractVector{Cdouble}; offset_at_origin::Bool=true)
+    LinearAlgebra.chkstride1(offsets, start, coeffs)
+    isnothing(indices) || LinearAlgebra.chkstride1(indices)
+    n = length(offsets)
+    length(start) == n + 1 || throw(DimensionMismatch("start must have length(offsets)+1 entries"))
+    length(coeffs) >= start[end] && (isnothing(indices) || length(indices) >= start[end]) ||
+        throw(DimensionMismatch("coeffs and indices must have start[end] entries"))
+    GC.@preserve offsets start indices coeffs begin
+        return @ccall libcb.cb_matrixcbsolver_set_model_minorants_csr(self.data::Ptr{Cvoid}, function_.data::Ptr{Cvoid},
+            function_value::Cdouble, n::CBInteger, offset_at_origin::Cint, offsets::Ptr{Cdouble}, start::Ptr{CBInteger},
+            (isnothing(indices) ? C_NULL : pointer(indices))::Ptr{CBInteger}, coeffs::Ptr{Cdouble})::Cint
+    end
+end
+
+''')
+bulk_getters = [("cb_get_array!", "cb_matrix_get_array", "CBMatrix", "", "Cdouble", "the entries of the matrix (columnwise)"),
+                ("cb_get_array!", "cb_indexmatrix_get_array", "CBIndexmatrix", "", "CBInteger", "the entries of the matrix (columnwise)"),
+                ("cb_get_array!", "cb_symmatrix_get_array", "CBSymmatrix", "", "Cdouble", "the full symmetric matrix (columnwise)"),
+                ("cb_get_center_array!", "cb_matrixcbsolver_get_center_array", "CBMatrixCBSolver", "", "Cdouble", "the center of stability"),
+                ("cb_get_candidate_array!", "cb_matrixcbsolver_get_candidate_array", "CBMatrixCBSolver", "", "Cdouble", "the last candidate"),
+                ("cb_get_subgradient_array!", "cb_matrixcbsolver_get_subgradient_array", "CBMatrixCBSolver", "", "Cdouble", "the aggregate subgradient"),
+                ("cb_get_approximate_slacks_array!", "cb_matrixcbsolver_get_approximate_slacks_array", "CBMatrixCBSolver", "", "Cdouble", "the approximate slacks"),
+                ("cb_get_approximate_primal_array!", "cb_matrixcbsolver_get_approximate_primal_array", "CBMatrixCBSolver", "function_", "Cdouble", "the aggregate primal of `function_` (`PrimalMatrix` or `DensePSCPrimal`)"),
+                ("cb_get_center_primal_array!", "cb_matrixcbsolver_get_center_primal_array", "CBMatrixCBSolver", "function_", "Cdouble", "the primal of `function_` in the center (`PrimalMatrix` or `DensePSCPrimal`)"),
+                ("cb_get_candidate_primal_array!", "cb_matrixcbsolver_get_candidate_primal_array", "CBMatrixCBSolver", "function_", "Cdouble", "the primal of `function_` in the candidate (`PrimalMatrix` or `DensePSCPrimal`)")]
+for jname, cname, jtype, funparam, eltype, what in bulk_getters:
+    jparams = f"self::{jtype}" + (f", {funparam}::CBFunctionObject" if funparam else "") + f", buf::AbstractVector{{{eltype}}}"
+    cparams = "self.data::Ptr{Cvoid}" + (f", {funparam}.data::Ptr{{Cvoid}}" if funparam else "") + f", buf::Ptr{{{eltype}}}, length(buf)::CBInteger"
+    f_bulk_jl.write(f'''@doc raw"""
+    {jname}({jparams})
+
+Copy {what} into `buf` and return the number of entries required.
+"""
+function {jname}({jparams})
+    LinearAlgebra.chkstride1(buf)
+    GC.@preserve buf begin
+        return Int(@ccall libcb.{cname}({cparams})::CBInteger)
+    end
+end
+
+''')
+    julia_functions.add(f"{jname}({', '.join('::' + p.split('::', 1)[1] for p in jparams.split(', '))})")
+f_bulk_jl.write(r'''@doc raw"""
+    cb_check_integer_size()
+
+Throw an error if the library uses another Integer type than `CBInteger`, i.e., if it was built
+with a different setting of LONGINDEX than the one the bindings were generated for.
+"""
+function cb_check_integer_size()
+    n = @ccall libcb.cb_integer_size()::Cint
+    n == sizeof(CBInteger) ||
+        error("libcb uses $(8*n)-bit Integer but the bindings were generated for $(8*sizeof(CBInteger))-bit")
+    return nothing
+end
+
+''')
+f_bulk_jl.close()
+julia_functions |= {"cb_sparsemat_csr", "cb_sparsemat_csc", "cb_sparsecoeffmatmatrix_coo", "cb_minorants_csr",
+                    "cb_set_model_minorants_csr!", "cb_check_integer_size", "CBInteger"}
+
 julia_functions |= {"CBModelUpdate", "cbmu_new_subgradient", "cbmu_descent_step", "cbmu_null_step",
                     "CBMode", "cbm_root", "cbm_child", "cbm_inactive", "cbm_unavailable"}
 f_classes.write(r'''const CBCoeffmatVector = StdVector{<:CBCoeffmat}
@@ -759,5 +938,7 @@ f_total.write("export " + ",\n    ".join(julia_functions_notype))
 f_doc.write("\n".join(julia_functions) + "\n```")
 f_doc.close()
 f_total.close()
+# hand written bulk array routines, see cb_bulk.cpp
+f_total_c.write('#include "cb_bulk.cpp"\n')
 f_total_c.write("\n}")
 f_total_c.close()
\ No newline at end of file
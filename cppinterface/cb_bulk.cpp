@@ -0,0 +1,278 @@
+// Bulk array routines that are not generated from the class headers.
+//
+// They allow to set up sparse data in one call from compressed arrays and
+// to copy results directly into caller allocated buffers, so that no
+// intermediate Matrix objects have to be created and destroyed per call.
+// Routines copying into a buffer return the number of entries required;
+// if this exceeds the given capacity nothing is copied. A negative value
+// signals that the requested data is not available.
+
+static Integer cb_bulk_copy(const Real* from, Integer n, Real* buf, Integer size) {
+  if ((n <= size) && (n > 0))
+    std::memcpy(buf, from, size_t(n) * sizeof(Real));
+  return n;
+}
+
+// the size of Integer in bytes, 8 if the library was built with LONGINDEX=1
+dll int cb_integer_size() {
+  return int(sizeof(Integer));
+}
+
+// Checks the compressed storage start[0],...,start[n] (nondecreasing,
+// start[0]>=0) and that the indices ind[start[0]],...,ind[start[n]-1]
+// lie in 0,...,dim-1. Returns 0 if the data is valid.
+static int cb_bulk_check_compressed(Integer n, Integer dim, const Integer* start, const Integer* ind) {
+  if ((n < 0) || (dim < 0) || (start == 0) || (start[0] < 0))
+    return 1;
+  for (Integer i = 0; i < n; i++)
+    if (start[i + 1] < start[i])
+      return 1;
+  if ((start[n] > start[0]) && (ind == 0))
+    return 1;
+  for (Integer k = start[0]; k < start[n]; k++)
+    if ((ind[k] < 0) || (ind[k] >= dim))
+      return 1;
+  return 0;
+}
+
+// Returns NULL if rowstart is not nondecreasing or a column index is
+// not in 0,...,nc-1.
+dll Sparsemat* cb_sparsemat_new_csr(Integer nr, Integer nc, const Integer* rowstart, const Integer* colind, const Real* val) {
+  if (cb_bulk_check_compressed(nr, nc, rowstart, colind))
+    return 0;
+  Integer nz = rowstart[nr] - rowstart[0];
+  if ((nz > 0) && (val == 0))
+    return 0;
+  Indexmatrix ind_i(nz, 1, Integer(0));
+  for (Integer i = 0; i < nr; i++)
+    for (Integer k = rowstart[i]; k < rowstart[i + 1]; k++)
+      ind_i(k - rowstart[0]) = i;
+  return new Sparsemat(nr, nc, nz, ind_i.get_store(), colind + rowstart[0], val + rowstart[0]);
+}
+
+// Returns NULL if colstart is not nondecreasing or a row index is
+// not in 0,...,nr-1.
+dll Sparsemat* cb_sparsemat_new_csc(Integer nr, Integer nc, const Integer* colstart, const Integer* rowind, const Real* val) {
+  if (cb_bulk_check_compressed(nc, nr, colstart, rowind))
+    return 0;
+  Integer nz = colstart[nc] - colstart[0];
+  if ((nz > 0) && (val == 0))
+    return 0;
+  Indexmatrix ind_j(nz, 1, Integer(0));
+  for (Integer j = 0; j < nc; j++)
+    for (Integer k = colstart[j]; k < colstart[j + 1]; k++)
+      ind_j(k - colstart[0]) = j;
+  return new Sparsemat(nr, nc, nz, rowind + colstart[0], ind_j.get_store(), val + colstart[0]);
+}
+
+// Entry k contributes val[k] to element (ind_i[k],ind_j[k]) of block
+// blocks[k] in column cols[k]; for each block only one of (i,j) and (j,i)
+// should be given, multiple entries are summed up. Returns NULL if a
+// block dimension is negative or a block, column or element index is
+// out of range.
+dll SparseCoeffmatMatrix* cb_sparsecoeffmatmatrix_new_coo(Integer nblocks, const Integer* blockdims, Integer ncols, Integer nz, const Integer* blocks, const Integer* cols, const Integer* ind_i, const Integer* ind_j, const Real* val) {
+  if ((nblocks < 0) || (ncols < 0) || ((nblocks > 0) && (blockdims == 0)))
+    return 0;
+  for (Integer b = 0; b < nblocks; b++)
+    if (blockdims[b] < 0)
+      return 0;
+  if ((nz > 0) && ((blocks == 0) || (cols == 0) || (ind_i == 0) || (ind_j == 0) || (val == 0)))
+    return 0;
+  for (Integer k = 0; k < nz; k++) {
+    if ((blocks[k] < 0) || (blocks[k] >= nblocks) || (cols[k] < 0) || (cols[k] >= ncols))
+      return 0;
+    Integer bdim = blockdims[blocks[k]];
+    if ((ind_i[k] < 0) || (ind_i[k] >= bdim) || (ind_j[k] < 0) || (ind_j[k] >= bdim))
+      return 0;
+  }
+  Indexmatrix bdim(nblocks, 1, blockdims);
+  SparseCoeffmatMatrix* scm = new SparseCoeffmatMatrix(bdim, ncols);
+  if (nz <= 0)
+    return scm;
+  Indexmatrix key(nz, 1);
+  for (Integer k = 0; k < nz; k++)
+    key(k) = blocks[k] * ncols + cols[k];
+  Indexmatrix sind;
+  sortindex(key, sind);
+  Indexmatrix si(nz, 1);
+  Indexmatrix sj(nz, 1);
+  Matrix sv(nz, 1);
+  Integer k = 0;
+  while (k < nz) {
+    Integer bk = key(sind(k));
+    Integer cnt = 0;
+    do {
+      Integer ind = sind(k);
+      si(cnt) = ind_i[ind];
+      sj(cnt) = ind_j[ind];
+      sv(cnt) = val[ind];
+      cnt++;
+      k++;
+    } while ((k < nz) && (key(sind(k)) == bk));
+    Sparsesym S;
+    S.init(bdim(bk / ncols), cnt, si.get_store(), sj.get_store(), sv.get_store());
+    scm->set(bk / ncols, bk % ncols, new CMsymsparse(S));
+  }
+  return scm;
+}
+
+// Checks the input of cb_bulk_minorants(): start must be nondecreasing and
+// the indices of each minorant strictly increasing nonnegative int values.
+// Returns 0 if the data is valid.
+static int cb_bulk_check_minorants(Integer n, const double* offsets, const Integer* start, const Integer* indices, const double* coeffs) {
+  if ((n < 0) || ((n > 0) && ((offsets == 0) || (start == 0))))
+    return 1;
+  if (n == 0)
+    return 0;
+  if (start[0] < 0)
+    return 1;
+  for (Integer k = 0; k < n; k++)
+    if (start[k + 1] < start[k])
+      return 1;
+  if ((start[n] > start[0]) && (coeffs == 0))
+    return 1;
+  if (indices) {
+    for (Integer k = 0; k < n; k++) {
+      for (Integer i = start[k]; i < start[k + 1]; i++) {
+        if (indices[i] < 0)
+          return 1;
+#if (CONICBUNDLE_LONG_INDEX>=1)
+        if (indices[i] > Integer(std::numeric_limits<int>::max()))
+          return 1;
+#endif
+        if ((i > start[k]) && (indices[i] <= indices[i - 1]))
+          return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+// Creates n minorants; minorant k uses offsets[k] and the coefficients
+// coeffs[start[k]],...,coeffs[start[k+1]-1]. If indices is not null these
+// are the corresponding sparse indices, otherwise the coefficients are dense.
+static void cb_bulk_minorants(Integer n, int offset_at_origin, const double* offsets, const Integer* start, const Integer* indices, const double* coeffs, Minorant** out) {
+  std::vector<int> ind;
+  for (Integer k = 0; k < n; k++) {
+    const int* ip = 0;
+    if (indices) {
+#if (CONICBUNDLE_LONG_INDEX>=1)
+      ind.assign(indices + start[k], indices + start[k + 1]);
+      ip = ind.data();
+#else
+      ip = indices + start[k];
+#endif
+    }
+    out[k] = new Minorant(offset_at_origin, offsets[k], int(start[k + 1] - start[k]), coeffs + start[k], ip);
+  }
+}
+
+// The minorants of cb_bulk_minorants() are stored in out[0],...,out[n-1]
+// and are owned by the caller (or by the routine they are handed over to).
+// Returns 0 on success and 1 (with nothing created) on invalid input.
+dll int cb_minorants_new_csr(Integer n, int offset_at_origin, const double* offsets, const Integer* start, const Integer* indices, const double* coeffs, Minorant** out) {
+  if (cb_bulk_check_minorants(n, offsets, start, indices, coeffs) || ((n > 0) && (out == 0)))
+    return 1;
+  cb_bulk_minorants(n, offset_at_origin, offsets, start, indices, coeffs, out);
+  return 0;
+}
+
+// Hands the n minorants of cb_bulk_minorants() to the cutting model of
+// function_ in one call, see MatrixCBSolver::set_model_minorants();
+// function_value is the value of the function in the point of the next
+// call to set_new_center_point(). Returns 0 on success and 1 (with the
+// model unchanged) on invalid input.
+dll int cb_matrixcbsolver_set_model_minorants_csr(MatrixCBSolver* self, const FunctionObject* function_, double function_value, Integer n, int offset_at_origin, const double* offsets, const Integer* start, const Integer* indices, const double* coeffs) {
+  if ((function_ == 0) || cb_bulk_check_minorants(n, offsets, start, indices, coeffs))
+    return 1;
+  std::vector<Minorant*> mnrts(size_t(n), (Minorant*)0);
+  cb_bulk_minorants(n, offset_at_origin, offsets, start, indices, coeffs, mnrts.data());
+  return self->set_model_minorants(*function_, function_value, mnrts);
+}
+
+dll void cb_minorants_destroy(Integer n, Minorant** mnrts) {
+  for (Integer k = 0; k < n; k++) {
+    delete mnrts[k];
+    mnrts[k] = 0;
+  }
+}
+
+dll Integer cb_matrix_get_array(const Matrix* self, Real* buf, Integer size) {
+  return cb_bulk_copy(self->get_store(), self->dim(), buf, size);
+}
+
+dll Integer cb_indexmatrix_get_array(const Indexmatrix* self, Integer* buf, Integer size) {
+  Integer n = self->dim();
+  if ((n <= size) && (n > 0))
+    std::memcpy(buf, self->get_store(), size_t(n) * sizeof(Integer));
+  return n;
+}
+
+// the full symmetric matrix is stored columnwise; returns -1 if
+// its number of entries exceeds the range of Integer
+dll Integer cb_symmatrix_get_array(const Symmatrix* self, Real* buf, Integer size) {
+  size_t n = size_t(self->rowdim());
+  size_t nn = n * n;
+  if (nn > size_t(std::numeric_limits<Integer>::max()))
+    return -1;
+  if ((size >= 0) && (nn <= size_t(size))) {
+    for (size_t j = 0; j < n; j++)
+      for (size_t i = j; i < n; i++)
+        buf[j * n + i] = buf[i * n + j] = (*self)(Integer(i), Integer(j));
+  }
+  return Integer(nn);
+}
+
+dll Integer cb_matrixcbsolver_get_center_array(const MatrixCBSolver* self, Real* buf, Integer size) {
+  Matrix tmp;
+  if (self->get_center(tmp))
+    return -1;
+  return cb_bulk_copy(tmp.get_store(), tmp.dim(), buf, size);
+}
+
+dll Integer cb_matrixcbsolver_get_candidate_array(const MatrixCBSolver* self, Real* buf, Integer size) {
+  Matrix tmp;
+  if (self->get_candidate(tmp))
+    return -1;
+  return cb_bulk_copy(tmp.get_store(), tmp.dim(), buf, size);
+}
+
+dll Integer cb_matrixcbsolver_get_subgradient_array(const MatrixCBSolver* self, Real* buf, Integer size) {
+  Matrix tmp;
+  if (self->get_subgradient(tmp))
+    return -1;
+  return cb_bulk_copy(tmp.get_store(), tmp.dim(), buf, size);
+}
+
+dll Integer cb_matrixcbsolver_get_approximate_slacks_array(const MatrixCBSolver* self, Real* buf, Integer size) {
+  Matrix tmp;
+  if (self->get_approximate_slacks(tmp))
+    return -1;
+  return cb_bulk_copy(tmp.get_store(), tmp.dim(), buf, size);
+}
+
+// copies PrimalMatrix data columnwise and DensePSCPrimal data as full
+// symmetric matrix, other primal types are not supported
+static Integer cb_bulk_primal_copy(const PrimalData* pd, Real* buf, Integer size) {
+  if (pd == 0)
+    return -1;
+  const PrimalMatrix* pm = dynamic_cast<const PrimalMatrix*>(pd);
+  if (pm)
+    return cb_bulk_copy(pm->get_store(), pm->dim(), buf, size);
+  const DensePSCPrimal* dp = dynamic_cast<const DensePSCPrimal*>(pd);
+  if (dp)
+    return cb_symmatrix_get_array(dp, buf, size);
+  return -1;
+}
+
+dll Integer cb_matrixcbsolver_get_approximate_primal_array(const MatrixCBSolver* self, const FunctionObject* function_, Real* buf, Integer size) {
+  return cb_bulk_primal_copy(self->get_approximate_primal(*function_), buf, size);
+}
+
+dll Integer cb_matrixcbsolver_get_center_primal_array(const MatrixCBSolver* self, const FunctionObject* function_, Real* buf, Integer size) {
+  return cb_bulk_primal_copy(self->get_center_primal(*function_), buf, size);
+}
+
+dll Integer cb_matrixcbsolver_get_candidate_primal_array(const MatrixCBSolver* self, const FunctionObject* function_, Real* buf, Integer size) {
+  return cb_bulk_primal_copy(self->get_candidate_primal(*function_), buf, size);
+}
@@ -1,3 +1,6 @@
+#include <cstring>
+#include <cassert>
+#include <limits>
 #include "cb_cinterface.h"
 #include "matrix.hxx"
 #include "indexmat.hxx"
@@ -68,6 +71,7 @@
 #include "QPIterativeKKTHAeqSolver.hxx"
 #include "QPIterativeKKTHASolver.hxx"
 #include "QPKKTSolverComparison.hxx"
+#include "QPKKTSolverAutoSelect.hxx"
 #include "SumBundleHandler.hxx"
 #include "QPConeModelBlock.hxx"
 #include "QPSumModelBlock.hxx"
@@ -110,6 +114,7 @@ extern "C" {
 #include "cb_blockpscprimal.cpp"
 #include "cb_densepscprimal.cpp"
 #include "cb_gramsparsepscprimal.cpp"
+#include "cb_lowranksparsepscprimal.cpp"
 #include "cb_sparsepscprimal.cpp"
 #include "cb_aftmodification.cpp"
 #include "cb_groundsetmodification.cpp"
@@ -168,6 +173,7 @@ extern "C" {
 #include "cb_qpiterativekkthaeqsolver.cpp"
 #include "cb_qpiterativekkthasolver.cpp"
 #include "cb_qpkktsolvercomparison.cpp"
+#include "cb_qpkktsolverautoselect.cpp"
 #include "cb_sumbundlehandler.cpp"
 #include "cb_qpconemodelblock.cpp"
 #include "cb_qpsummodelblock.cpp"
@@ -182,5 +188,6 @@ extern "C" {
 #include "cb_bundleterminator.cpp"
 #include "cb_clock.cpp"
 #include "cb_microseconds.cpp"
+#include "cb_bulk.cpp"
 
 }
\ No newline at end of file
@@ -0,0 +1,63 @@
+dll void cb_lowranksparsepscprimal_destroy(LowRankSparsePSCPrimal* self) {
+  delete self;
+}
+
+dll LowRankSparsePSCPrimal* cb_lowranksparsepscprimal_new(const Sparsesym* sps, Integer in_maxrank = 20, double factor = 1.) {
+  return new LowRankSparsePSCPrimal(*sps, in_maxrank, factor);
+}
+
+dll LowRankSparsePSCPrimal* cb_lowranksparsepscprimal_new2(const LowRankSparsePSCPrimal* pr, double factor = 1.) {
+  return new LowRankSparsePSCPrimal(*pr, factor);
+}
+
+dll LowRankSparsePSCPrimal* cb_lowranksparsepscprimal_assign(LowRankSparsePSCPrimal* self, const Sparsesym* sdp) {
+  return &(*self = *sdp);
+}
+
+dll LowRankSparsePSCPrimal* cb_lowranksparsepscprimal_assign2(LowRankSparsePSCPrimal* self, const LowRankSparsePSCPrimal* sdp) {
+  return &(*self = *sdp);
+}
+
+dll const Matrix* cb_lowranksparsepscprimal_get_lowrank_vecs(const LowRankSparsePSCPrimal* self) {
+  return &self->get_lowrank_vecs();
+}
+
+dll const Matrix* cb_lowranksparsepscprimal_get_lowrank_eigs(const LowRankSparsePSCPrimal* self) {
+  return &self->get_lowrank_eigs();
+}
+
+dll Integer cb_lowranksparsepscprimal_get_maxrank(const LowRankSparsePSCPrimal* self) {
+  return self->get_maxrank();
+}
+
+dll void cb_lowranksparsepscprimal_set_maxrank(LowRankSparsePSCPrimal* self, Integer mr) {
+  self->set_maxrank(mr);
+}
+
+dll int cb_lowranksparsepscprimal_compress(LowRankSparsePSCPrimal* self, Integer rank) {
+  return self->compress(rank);
+}
+
+dll int cb_lowranksparsepscprimal_assign_gram_matrix(LowRankSparsePSCPrimal* self, const Matrix* P) {
+  return self->assign_Gram_matrix(*P);
+}
+
+dll int cb_lowranksparsepscprimal_aggregate_primal_data(LowRankSparsePSCPrimal* self, const PrimalData* it, double factor = 1.) {
+  return self->aggregate_primal_data(*it, factor);
+}
+
+dll int cb_lowranksparsepscprimal_aggregate_gram_matrix(LowRankSparsePSCPrimal* self, const Matrix* P, double factor = 1.) {
+  return self->aggregate_Gram_matrix(*P, factor);
+}
+
+dll int cb_lowranksparsepscprimal_scale_primal_data(LowRankSparsePSCPrimal* self, double factor) {
+  return self->scale_primal_data(factor);
+}
+
+dll int cb_lowranksparsepscprimal_primal_ip(const LowRankSparsePSCPrimal* self, Real* value, const SparseCoeffmatMatrix* A, Integer column) {
+  return self->primal_ip(*value, *A, column);
+}
+
+dll int cb_lowranksparsepscprimal_gram_ip(const LowRankSparsePSCPrimal* self, Real* value, const Matrix* P) {
+  return self->Gram_ip(*value, *P);
+}
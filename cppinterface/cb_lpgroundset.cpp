@@ -7,7 +7,7 @@ dll void cb_lpgroundset_clear(LPGroundset* self, Integer indim = 0, Integer in_g
 }
 
 dll LPGroundset* cb_lpgroundset_new() {
-  return new LPGroundset(0);
+  return new LPGroundset();
 }
 
 dll LPGroundset* cb_lpgroundset_new2(Integer dim, const Matrix* lbyp = 0, const Matrix* ubyp = 0, const Sparsemat* Gp = 0, const Matrix* rhslbp = 0, const Matrix* rhsubp = 0, const Matrix* start_val = 0, const Matrix* costs = 0, const Real offset = 0., Integer in_groundset_id = 0) {
@@ -30,6 +30,14 @@ dll int cb_lpgroundset_set_qpsolver(LPGroundset* self, QPSolverParametersObject*
   return self->set_qpsolver(qpparams, qpsolver);
 }
 
+dll int cb_lpgroundset_set_auto_select_kktsolver(LPGroundset* self, int auto_select) {
+  return self->set_auto_select_KKTsolver((bool)auto_select);
+}
+
+dll void cb_lpgroundset_set_auto_select_qpsolver(LPGroundset* self, int asq) {
+  self->set_auto_select_qpsolver((bool)asq);
+}
+
 dll int cb_lpgroundset_constrained(const LPGroundset* self) {
   return self->constrained();
 }
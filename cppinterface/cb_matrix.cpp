@@ -58,7 +58,7 @@ dll Matrix* cb_matrix_init8(Matrix* self, Integer nr, Integer nc, const Real* dp
   return &self->init(nr, nc, dp, incr, d);
 }
 
-dll Matrix* cb_matrix_init_diag(Matrix* self, int nr, Real d = 1.) {
+dll Matrix* cb_matrix_init_diag(Matrix* self, Integer nr, Real d = 1.) {
   return &self->init_diag(nr, d);
 }
 
@@ -214,6 +214,14 @@ dll int cb_matrixcbsolver_set_qp_solver(MatrixCBSolver* self, QPSolverParameters
   return self->set_qp_solver(qpparams, newqpsolver);
 }
 
+dll int cb_matrixcbsolver_set_auto_select_qpsolver(MatrixCBSolver* self, int auto_select) {
+  return self->set_auto_select_qpsolver((bool)auto_select);
+}
+
+dll int cb_matrixcbsolver_set_auto_select_kktsolver(MatrixCBSolver* self, int auto_select) {
+  return self->set_auto_select_kktsolver((bool)auto_select);
+}
+
 dll int cb_matrixcbsolver_get_dim(const MatrixCBSolver* self) {
   return self->get_dim();
 }
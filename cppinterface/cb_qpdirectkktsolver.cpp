@@ -22,3 +22,15 @@ dll int cb_qpdirectkktsolver_qpsolve_kktsystem(QPDirectKKTSolver* self, Matrix*
   return self->QPsolve_KKTsystem(*solx, *soly, *primalrhs, *dualrhs, rhsmu, rhscorr, prec, params);
 }
 
+
+dll int cb_qpdirectkktsolver_qpsolve_kktsystem_block(QPDirectKKTSolver* self, Matrix* solx, Matrix* soly, const Matrix* primalrhs, const Matrix* dualrhs, const Matrix* rhsmu, const Matrix* rhscorr, Integer stepcol, Real prec, QPSolverParameters* params) {
+  return self->QPsolve_KKTsystem_block(*solx, *soly, *primalrhs, *dualrhs, *rhsmu, *rhscorr, stepcol, prec, params);
+}
+
+dll int cb_qpdirectkktsolver_qpcombine_kktsystem_block(QPDirectKKTSolver* self, Matrix* solx, Matrix* soly, const Matrix* coeff, Real rhsmu, Real rhscorr) {
+  return self->QPcombine_KKTsystem_block(*solx, *soly, *coeff, rhsmu, rhscorr);
+}
+
+dll int cb_qpdirectkktsolver_qpsupports_block_solve(const QPDirectKKTSolver* self) {
+  return self->QPsupports_block_solve();
+}
@@ -0,0 +1,44 @@
+dll void cb_qpkktsolverautoselect_destroy(QPKKTSolverAutoSelect* self) {
+  delete self;
+}
+
+dll void cb_qpkktsolverautoselect_clear(QPKKTSolverAutoSelect* self) {
+  self->clear();
+}
+
+dll QPKKTSolverAutoSelect* cb_qpkktsolverautoselect_new(int cbinc = -1) {
+  return new QPKKTSolverAutoSelect(0, cbinc);
+}
+
+dll int cb_qpkktsolverautoselect_add_solver(QPKKTSolverAutoSelect* self, QPKKTSolverObject* solver, const char* name) {
+  return self->add_solver(solver, name);
+}
+
+dll int cb_qpkktsolverautoselect_add_default_solvers(QPKKTSolverAutoSelect* self) {
+  return self->add_default_solvers();
+}
+
+dll int cb_qpkktsolverautoselect_qpinit_kktdata(QPKKTSolverAutoSelect* self, QPSolverProxObject* Hp, QPModelBlockObject* model, const Sparsemat* A, const Indexmatrix* eq_indices) {
+  return self->QPinit_KKTdata(Hp, model, A, eq_indices);
+}
+
+dll int cb_qpkktsolverautoselect_qpinit_kktsystem(QPKKTSolverAutoSelect* self, const Matrix* KKTdiagx, const Matrix* KKTdiagy, Real Hfactor, Real prec, QPSolverParameters* params) {
+  return self->QPinit_KKTsystem(*KKTdiagx, *KKTdiagy, Hfactor, prec, params);
+}
+
+dll int cb_qpkktsolverautoselect_qpsolve_kktsystem(QPKKTSolverAutoSelect* self, Matrix* solx, Matrix* soly, const Matrix* primalrhs, const Matrix* dualrhs, Real rhsmu, Real rhscorr, Real prec, QPSolverParameters* params) {
+  return self->QPsolve_KKTsystem(*solx, *soly, *primalrhs, *dualrhs, rhsmu, rhscorr, prec, params);
+}
+
+dll Real cb_qpkktsolverautoselect_qpget_blockh_norm(QPKKTSolverAutoSelect* self) {
+  return self->QPget_blockH_norm();
+}
+
+dll Real cb_qpkktsolverautoselect_qpget_blocka_norm(QPKKTSolverAutoSelect* self) {
+  return self->QPget_blockA_norm();
+}
+
+dll void cb_qpkktsolverautoselect_print_statistics(const QPKKTSolverAutoSelect* self, int printlevel = 0) {
+  self->print_statistics(std::cout, printlevel);
+}
+
@@ -18,6 +18,22 @@ dll int cb_qpkktsubspacehprecond_precondm1(QPKKTSubspaceHPrecond* self, Matrix*
   return self->precondM1(*vec);
 }
 
+dll void cb_qpkktsubspacehprecond_set_sketch_rank(QPKKTSubspaceHPrecond* self, Integer rank) {
+  self->set_sketch_rank(rank);
+}
+
+dll int cb_qpkktsubspacehprecond_set_sketch_reuse_tol(QPKKTSubspaceHPrecond* self, Real tol) {
+  return self->set_sketch_reuse_tol(tol);
+}
+
+dll Integer cb_qpkktsubspacehprecond_get_sketch_ngen(const QPKKTSubspaceHPrecond* self) {
+  return self->get_sketch_ngen();
+}
+
+dll Integer cb_qpkktsubspacehprecond_get_sketch_nreuse(const QPKKTSubspaceHPrecond* self) {
+  return self->get_sketch_nreuse();
+}
+
 dll int cb_qpkktsubspacehprecond_set_subspace(QPKKTSubspaceHPrecond* self, const Matrix* insubspace) {
   return self->set_subspace(*insubspace);
 }
@@ -66,6 +66,18 @@ dll int cb_qpsolverparameters_qpget_use_socqp(const QPSolverParameters* self) {
   return self->QPget_use_socqp();
 }
 
+dll int cb_qpsolverparameters_qpget_use_inexact_kkt(const QPSolverParameters* self) {
+  return self->QPget_use_inexact_KKT();
+}
+
+dll Real cb_qpsolverparameters_qpget_inexact_eta_min(const QPSolverParameters* self) {
+  return self->QPget_inexact_eta_min();
+}
+
+dll Real cb_qpsolverparameters_qpget_inexact_eta_max(const QPSolverParameters* self) {
+  return self->QPget_inexact_eta_max();
+}
+
 dll int cb_qpsolverparameters_qpset_min_objective_relprec(QPSolverParameters* self, Real eps) {
   return self->QPset_min_objective_relprec(eps);
 }
@@ -118,6 +130,14 @@ dll int cb_qpsolverparameters_qpset_use_socqp(QPSolverParameters* self, int s) {
   return self->QPset_use_socqp((bool)s);
 }
 
+dll int cb_qpsolverparameters_qpset_use_inexact_kkt(QPSolverParameters* self, int inexact) {
+  return self->QPset_use_inexact_KKT((bool)inexact);
+}
+
+dll int cb_qpsolverparameters_qpset_inexact_eta_bounds(QPSolverParameters* self, Real eta_min, Real eta_max) {
+  return self->QPset_inexact_eta_bounds(eta_min, eta_max);
+}
+
 dll int cb_qpsolverparameters_qpset_allow_uqpsolver(QPSolverParameters* self, int allow) {
   return self->QPset_allow_UQPSolver((bool)allow);
 }
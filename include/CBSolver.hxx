@@ -187,6 +187,17 @@ namespace ConicBundle {
     /// multiply/scale *this with a nonnegative myfactor
     virtual int scale_primal_data(double myfactor) = 0;
 
+    /** @brief add factors[i]*(*primals[i]) to this for all i (null entries are skipped); returns 0 on success and otherwise the number of failed aggregations
+
+       The default implementation calls aggregate_primal_data() for each
+       of them. Derived classes with large data may override this in order
+       to add all of them in one pass over *this (as done, e.g., by
+       PrimalDVector, PrimalMatrix and the PSCPrimal classes) and
+       should fall back to the default if they encounter incompatible
+       types or sizes. The primals must be different from this.
+    */
+    virtual int aggregate_primal_data_batch(const std::vector<const PrimalData*>& primals, const DVector& factors);
+
   };
 
   /** @brief Interface for extending PrimalData, e.g., in Lagrangian relaxation of column generation approaches
@@ -439,6 +450,15 @@ namespace ConicBundle {
     /// resorts (and deletes) coefficients so that afterwards it has n_elements and the new coeff(i) has the previous value of coeff(map_to_old_coeff(i))
     virtual int reassign_coeffs(int n_elements, const int* map_to_old_coeffs);
 
+    /** @brief deletes the coefficients with the n_del indices listed in strictly increasing order in del_indices and shifts the following coefficients down accordingly
+
+        This has the same effect as reassign_coeffs() with a strictly
+        increasing map, but the work is proportional to the number of
+        coefficients stored behind the first deleted index and
+        sparse minorants remain sparse.
+    */
+    virtual int delete_coeffs(int n_del, const int* del_indices);
+
     /// if the minorant is generated by PrimalData and this should be aggregated along, insert a heap object of it here (see PrimalData)
     virtual void set_primal(PrimalData*);
 
@@ -454,6 +474,13 @@ namespace ConicBundle {
     ///adds factor*minorant to this and does this also for the primal if it is availabe
     virtual int aggregate(const Minorant& minorant, double factor = 1.);
 
+    /** @brief adds factors[i]*minorants[i] for all i to this and does this also for the primal if it is available; this has the same effect as calling aggregate() for each of them, but the coefficients are accumulated in one pass over this (threaded for large dimensions), which is much faster for many minorants
+
+       The primal data is aggregated by one call to PrimalData::aggregate_primal_data_batch().
+       The minorants must be different from this.
+    */
+    virtual int aggregate_batch(const std::vector<const Minorant*>& minorants, const DVector& factors);
+
     ///returns the number of minorants aggregated in this one, value 1 thus means not aggregated
     virtual int number_aggregated() const;
 
@@ -690,6 +717,9 @@ namespace ConicBundle {
       return 0;
     }
 
+    /// if all are PrimalDVectors of the same dimension, add them in one (for large data threaded) pass over *this, otherwise see PrimalData::aggregate_primal_data_batch()
+    int aggregate_primal_data_batch(const std::vector<const PrimalData*>& primals, const DVector& factors);
+
     /// multiply/scale *this with a nonnegative myfactor
     virtual int scale_primal_data(double myfactor) {
       if (myfactor != 1.) {
@@ -2,6 +2,7 @@
 #define __CBCONFIG_HXX__
 
 #define CONICBUNDLE_DEBUG 0
+#define CONICBUNDLE_LONG_INDEX 0
 
 #endif
 
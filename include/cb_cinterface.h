@@ -68,7 +68,10 @@
    is differentiable) to the solver.
 
    The #cb_functionp representations have to be added to the solver
-   using the routine  cb_add_function().
+   using the routine  cb_add_function(). If the subgradients are sparse
+   and the dimension is large, use functions of type #cb_sparse_functionp
+   and add them by cb_add_sparse_function() instead; these return only
+   the nonzeros of the subgradients.
 
    Once all functions are added, the optimization process can be
    started. If you know a good starting point then set it with
@@ -287,6 +290,70 @@ extern "C" {
     );
 
 
+  /* *****************************************************************
+   *                      sparse_function
+   * ***************************************************************** */
+
+   /**@brief Variant of #cb_functionp that returns the subgradients in sparse form
+
+    The meaning of all parameters not listed below is the same as
+    for #cb_functionp. Instead of a dense array of length max_subg * m
+    the subgradients are returned by their nonzeros only. Their
+    coefficients and indices are stored one subgradient after the
+    other in the arrays @a subg_coeffs and @a subg_indices. These
+    arrays are owned by the solver and reused in all calls, so no
+    dense storage of size m is allocated in the evaluation.
+
+    If the capacity @a *nnz passed in is not sufficient, set @a *nnz
+    to the number of nonzeros required and return without filling the
+    arrays. The solver then enlarges its buffers and calls the
+    function once more with the same arguments.
+
+    @param[out] subg_nnz
+        (pointer to int array of length @a max_subg, memory already provided by caller)
+        store for each epsilon subgradient the number of its nonzeros
+
+    @param[out] subg_indices
+        (pointer to int array of length @a *nnz, memory already provided by caller)
+        the indices of the nonzeros of subgradient 1, then of subgradient 2 and so on.
+        Indices in ascending order per subgradient are processed fastest.
+
+    @param[out] subg_coeffs
+        (pointer to double array of length @a *nnz, memory already provided by caller)
+        the coefficients corresponding to @a subg_indices
+
+    @param[in,out] nnz
+        (pointer to an int of the caller)
+        - on input: the capacity of @a subg_indices and @a subg_coeffs
+        - on output: the total number of nonzeros of all returned subgradients;
+          if this exceeds the capacity, the arrays are not read and the call is repeated
+          with sufficient capacity
+
+    @return
+        -  0,  all correct
+        -  !=0, failure. This does not necessarily terminate the bundle method.
+                  Termination is forced only if no new subgradient is returned.
+   */
+
+  typedef int (*cb_sparse_functionp)( /* input: */
+    void* function_key, /* supplied by the user */
+    double* arg, /* argument/Lagrange multipliers */
+    double relprec, /* relative precision requirement */
+    int max_subg, /* at most max_subg eps-subgradients */
+
+    /* output: */  /*memory provided by caller */
+
+    double* objective_value, /* see cb_functionp */
+    int* n_subgrads, /* number of epsilon subgrads returned */
+    double* subg_values, /* for each eps subgradient the value at argument */
+    int* subg_nnz, /* for each eps subgradient the number of nonzeros */
+    int* subg_indices, /* indices of the nonzeros, subgradient by subgradient */
+    double* subg_coeffs, /* values of the nonzeros, subgradient by subgradient */
+    int* nnz, /* in: capacity of subg_indices/subg_coeffs, out: nonzeros used */
+    double* primal /* pointer to array, may be NULL, see cb_functionp */
+    );
+
+
   /* *****************************************************************
    *                      subgradient_extension
    * ***************************************************************** */
@@ -535,6 +602,47 @@ extern "C" {
     cb_affinefunctiontransformationp aft);
 
 
+  /* *****************************************************************
+   *                     cb_add_sparse_function
+   * ***************************************************************** */
+
+   /** @brief Adds a function returning sparse subgradients, see #cb_sparse_functionp; otherwise the same as cb_add_function().
+
+      The minorants are generated directly in sparse form from the
+      nonzeros returned by @a f, the buffers passed to @a f are
+      owned by the solver and reused in all calls.
+
+      @param[in] p  (cb_problemp)
+          pointer to the problem to which the function should be added
+
+      @param[in] function_key  (void *)
+          The value of the funciton_key must UNIQUELY identify the function
+
+      @param[in] f  (cb_sparse_functionp)
+          The pointer to the function
+
+      @param[in] se  (cb_subgextp)
+          may be NULL, see cb_add_function()
+
+      @param[in] primaldim  (int)
+          may be zero, see cb_add_function()
+
+       @return
+          - 0 on success
+          - != 0 otherwise
+
+   */
+
+  dll int cb_add_sparse_function(cb_problemp p,
+    void* function_key,
+    cb_sparse_functionp f,
+    cb_subgextp se,
+    int primaldim,
+    double fun_factor,
+    int fun_task,
+    cb_affinefunctiontransformationp aft);
+
+
   /* *****************************************************************
    *                     set_lower_bound
    * ***************************************************************** */
@@ -1686,6 +1794,54 @@ extern "C" {
 
   dll void cb_set_print_level(cb_problemp p, int pril);
 
+  /* *****************************************************************
+   *                   cb_set_timing
+   * ***************************************************************** */
+
+   /** @brief Switches the collection of hierarchical timing and counting
+       statistics on (1) or off (0, the default).
+
+       The timers are nested along the calls from the solver through the
+       models of the functions down to the oracles, the quadratic
+       subproblem solver, its KKT systems and the Lanczos method.
+       The statistics are shared by all problems of the process.
+
+      @param[in] p  (cb_problemp)
+          pointer to the problem
+
+      @param[in] on (0 or 1)
+
+   */
+
+  dll void cb_set_timing(cb_problemp p, int on);
+
+  /* *****************************************************************
+   *                   cb_print_timing
+   * ***************************************************************** */
+
+   /** @brief Outputs the tree of timers and counters collected
+       since the last call to cb_reset_timing(), see cb_set_timing().
+
+      @param[in] p  (cb_problemp)
+          pointer to the problem
+
+   */
+
+  dll void cb_print_timing(cb_problemp p);
+
+  /* *****************************************************************
+   *                   cb_reset_timing
+   * ***************************************************************** */
+
+   /** @brief Sets all timers and counters to zero, see cb_set_timing().
+
+      @param[in] p  (cb_problemp)
+          pointer to the problem
+
+   */
+
+  dll void cb_reset_timing(cb_problemp p);
+
 
 
 
@@ -25,11 +25,11 @@
 #include <iostream>
 #include <fstream>
 #include <set>
-#include <queue>
 #include "CMsingleton.hxx"
 #include "CMsymsparse.hxx"
 #include "MatrixCBSolver.hxx"
 #include "PSCAffineFunction.hxx"
+#include "TriangleSeparator.hxx"
 
 using namespace CH_Matrix_Classes;
 using namespace ConicBundle;
@@ -79,41 +79,6 @@ public:
   { ii=i; jj=std::abs(j); kk=std::abs(k); signj=(j<0?-1:1); signk=(k<0?-1:1); }
 };
 
-//*****************************************************************************
-//                                TriangleViolation
-//*****************************************************************************
-
-/** @brief in order to find the most violated triangles by a priority queue this stores a triangle together with its violation and allows sorting according to the violation (-1. is still ok, the more negative the more violated)
- */ 
-class TriangleViolation
-{
-private:
-  /// the triangle
-  Triangle triangle;
-  /// the violation of the triangle inequality, more negative is more violated
-  Real violation;
-public:
-  TriangleViolation(Integer ii,Integer jj,Integer kk,Integer signj,Integer signk,Real viol):
-    triangle(ii,jj,kk,signj,signk),violation(viol)
-  {}
-
-  TriangleViolation(const TriangleViolation& Tr):
-    triangle(Tr.triangle),violation(Tr.violation)
-  {}
-
-  bool operator<(const TriangleViolation& Tr) const
-  {
-    return (violation<Tr.violation);
-  }
-
-  const Triangle& get_triangle() const
-  { return triangle; }
-
-  Real get_violation() const
-  {return violation;}
-};
-
-
 //*****************************************************************************
 //                               added_triangles
 //*****************************************************************************
@@ -138,89 +103,42 @@ typedef std::set<Triangle> AddedTriangles;
 
 int update_triangle_constraints(MatrixCBSolver& solver,PSCAffineFunction& mc,AddedTriangles& added_triangles,const Indexmatrix* fixed_indices,Integer nnodes,const GramSparsePSCPrimal* primalX,Real& violation)
 {
-  //-- get and form an approximation of the primal matrix X
-  Symmatrix X(*primalX);
-  rankadd(primalX->get_grammatrix(),X,1.,1.);
-
   //-- find the n most violated triangle inequalities
-  std::size_t at_most_n_violated=std::size_t(max(nnodes,10));
-  Real violation_threshold=-1-1e-3;
-  
-  std::priority_queue<TriangleViolation> most_violated;
-  for(Integer i=0;i<nnodes;i++){
-    for(Integer j=i+1;j<nnodes;j++){
-      Real xij=X(i,j);
-      for(Integer k=j+1;k<nnodes;k++){
-	Real xik=X(i,k);
-	Real xjk=X(j,k);
-	int signj=1;
-	int signk=1;
-	Real viol=xij+xik+xjk;
-	Real v=xij-xik-xjk;
-	if (v<viol){
-	  viol=v;
-	  signk=-1;
-	}
-	v=-xij+xik-xjk;
-	if (v<viol){
-	  viol=v;
-	  signj=-1;
-	  signk=1;
-	}
-	v=-xij-xik+xjk;
-	if (v<viol){
-	  viol=v;
-	  signj=-1;
-	  signk=-1;
-	}
-	if (viol<violation_threshold){
-	  if (most_violated.size()==at_most_n_violated){
-	    most_violated.pop();
-	  }
-	  most_violated.push(TriangleViolation(i,j,k,signj,signk,viol));
-	  if (most_violated.size()==at_most_n_violated){
-	    violation_threshold=most_violated.top().get_violation();
-	  }
-	}
-      }  // end k
-    } // end j
-  } // end i
-
-  //-- build the coefficient matrices for those that are not yet included
-  Indexmatrix indi(3,1,Integer(0));  //row indices for sparse representation
-  Indexmatrix indj(3,1,Integer(0));  //col indices for sparse representation
-  Matrix val(3,1,1.);                //values for sparse representation
-  Sparsesym A;                       //sparse symmetric matrix representation
-  CoeffmatVector tr_ineqs;           //collects the ineqs coefficient matrices
-  tr_ineqs.reserve(most_violated.size());
+  TriangleSeparator separator;
+  if (separator.separate(*primalX,nnodes,max(nnodes,Integer(10)))){
+    cout<<"**** ERROR in separator.separate(...)"<<endl;
+    return 1;
+  }
+
+  //-- select those that are not yet included, least violated first
+  Indexmatrix selected(separator.get_n_triangles(),1);
+  selected.init(0,1,Integer(0));
   Real sumviol=0.;     //for computing the average violation of added ineqs
-  
-  while(most_violated.size()>0){
+  for(Integer t=separator.get_n_triangles();--t>=0;){
+    Integer i,j,k,signj,signk;
+    Real lhs;
+    separator.get_triangle(t,i,j,k,signj,signk,lhs);
+    Triangle tr(i,j,k,signj,signk);
     //check whether the inequality is new
-    if (added_triangles.find(most_violated.top().get_triangle())==added_triangles.end()){
-      //it is new, form and append it multiplied by -1 for nonneg. multipiers
-      violation=-1.-most_violated.top().get_violation(); //the last is the most violated one
+    if (added_triangles.find(tr)==added_triangles.end()){
+      //it is new, it will be appended multiplied by -1 for nonneg. multipiers
+      violation=-1.-lhs; //the last is the most violated one
       sumviol+=violation;
-      added_triangles.insert(most_violated.top().get_triangle());
-      Integer i,j,k,signj,signk;
-      most_violated.top().get_triangle().get_ijk(i,j,k,signj,signk);
-      indi(0)=i; indj(0)=j; val(0)=.5*signj;
-      indi(1)=i; indj(1)=k; val(1)=.5*signk;
-      indi(2)=j; indj(2)=k; val(2)=.5*signj*signk;
-      Sparsesym A(nnodes,3,indi,indj,val);
-      tr_ineqs.push_back(new CMsymsparse(A));
+      added_triangles.insert(tr);
+      selected.concat_below(t);
     }
-    most_violated.pop();
   }
 
   //-- add the coefficient matrices (the primal constraints) to the problem
-  Integer ncols(Integer(tr_ineqs.size()));
+  Integer ncols(selected.rowdim());
   if (ncols>0){
-    std::cout<<" nnew="<<ncols<<" maxviol="<<violation<<" avgviol="<<sumviol/ncols<<std::endl;
+    std::cout<<" nnew="<<ncols<<" maxviol="<<violation<<" avgviol="<<sumviol/Real(ncols)<<std::endl;
     //form the row of the coefficient matrix that has to be appended
-    indi.init(ncols,1,Integer(0));
-    indj.init(Range(0,ncols-1));
-    SparseCoeffmatMatrix scm(mc.get_opAt().blockdim(),ncols,&indi,&indj,&tr_ineqs);
+    SparseCoeffmatMatrix scm;
+    if (separator.get_coeffmats(scm,mc.get_opAt().blockdim(),0,&selected)){
+      cout<<"**** ERROR in separator.get_coeffmats(...)"<<endl;
+      return 1;
+    }
     //form the modification info for the PSCAffineFunction mc
     PSCAffineModification funmod(solver.get_dim(),mc.get_opAt().blockdim(),&solver); 
     funmod.add_append_vars(ncols,&scm);
@@ -231,7 +149,7 @@ int update_triangle_constraints(MatrixCBSolver& solver,PSCAffineFunction& mc,Add
     //append the new Lagrange mulitpliers for <=1. constraints 
     Matrix lower_bounds(ncols,1,0.);
     Matrix costs(ncols,1,1.);
-    if (solver.append_variables(ncols,&lower_bounds,0,0,0,&costs,&modmap)){
+    if (solver.append_variables(int(ncols),&lower_bounds,0,0,0,&costs,&modmap)){
       cout<<"**** ERROR in solver.append_variables(...)"<<endl;
       return 1;
     }
@@ -314,7 +232,7 @@ int GW_rounding(const GramSparsePSCPrimal* primalX,const Sparsesym& L,Matrix& be
   }
   //--- try Goemans Williamson rounding
   Matrix rand_dir;
-  Integer n_tries=max(L.rowdim()/10,10);
+  Integer n_tries=max(L.rowdim()/10,Integer(10));
   for (Integer r=0;r<n_tries;r++){
     rand_dir.rand_normal(Gram_mat.coldim(),1);
     genmult(Gram_mat,rand_dir,cut);
@@ -403,7 +321,7 @@ int main(int argc,char **argv)
   Matrix lb(nnodes,1,CB_minus_infinity);
   Matrix ub(nnodes,1,CB_plus_infinity);
   Matrix rhs(nnodes,1,1.);
-  cbsolver.init_problem(nnodes,&lb,&ub,0,&rhs);
+  cbsolver.init_problem(int(nnodes),&lb,&ub,0,&rhs);
   cbsolver.add_function(mc,Real(nnodes),ObjectiveFunction,0,true); 
    
   //---- call the solver
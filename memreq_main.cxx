@@ -0,0 +1,152 @@
+/* ****************************************************************************
+
+    Copyright (C) 2026  ConicBundle contributors
+
+    ConicBundle, Version 1.a.2
+    File:  memreq_main.cxx
+    This file is part of ConciBundle, a C/C++ library for convex optimization.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+/* Counts the temporaries of typical Matrix expressions.
+
+   The number of storage requests to the Memarray shared by all
+   matrices (Memarray::get_n_requests()) is recorded for the operator
+   form x=a*y+b*z, for the fused routines xeyapzb(), xeya() and xpeya(),
+   and for copies, moves and returning a Matrix from a function. The
+   operators act eagerly, so x=a*y+b*z needs three requests, while the
+   fused routines need none once x has the right size; moving a Matrix
+   needs none and returning one from a function adds no copy. The counts are checked, the
+   times of reps evaluations on vectors of length n are only reported.
+   The program prints one line per check and returns the number of
+   failed checks.
+
+   usage: t_memreq [n [reps]]
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+#include "matrix.hxx"
+#include "clock.hxx"
+
+using namespace std;
+using namespace CH_Matrix_Classes;
+
+static int n_failed = 0;
+
+static void check(bool ok, const char* what) {
+  cout << ((ok) ? " ok     " : " FAILED ") << what << endl;
+  if (!ok)
+    n_failed++;
+}
+
+static unsigned long n_requests() {
+  return Memarrayuser::get_memarray()->get_n_requests();
+}
+
+// prints the number of requests and the time per evaluation and checks the number
+static void report(const char* what, unsigned long requests, unsigned long expected, CH_Tools::Microseconds t, int reps) {
+  char line[200];
+  snprintf(line, sizeof(line), "%-32s %2lu requests (expected %lu), %10.1f us per evaluation", what, requests, expected, double(t) * 1e6 / reps);
+  check(requests == expected, line);
+}
+
+static Matrix scaled_copy(const Matrix& y, Real a) {
+  Matrix x(y.rowdim(), y.coldim());
+  x.xeya(y, a);
+  return x;
+}
+
+int main(int argc, char** argv) {
+  const Integer n = (argc > 1) ? Integer(atol(argv[1])) : 1000000;
+  const int reps = (argc > 2) ? atoi(argv[2]) : 20;
+  if ((n <= 0) || (reps <= 0)) {
+    cout << "usage: t_memreq [n [reps]]" << endl;
+    return 1;
+  }
+  const Real a = 2.;
+  const Real b = -.5;
+  Matrix y(n, 1, 1.);
+  Matrix z(n, 1, 3.);
+  Matrix x(n, 1, 0.);
+  CH_Tools::Clock clock;
+
+  //x=a*y+b*z by operators: a*y, b*z and their sum
+  unsigned long r0 = n_requests();
+  CH_Tools::Microseconds t0 = clock.time();
+  for (int r = 0; r < reps; r++)
+    x = a * y + b * z;
+  report("x=a*y+b*z", (n_requests() - r0) / unsigned(reps), 3, clock.time() - t0, reps);
+  bool ok = (x(0) == 0.5) && (x(n - 1) == 0.5);
+
+  //the same fused into one loop
+  x.init(n, 1, 0.);
+  r0 = n_requests();
+  t0 = clock.time();
+  for (int r = 0; r < reps; r++)
+    xeyapzb(x, y, z, a, b);
+  report("xeyapzb(x,y,z,a,b)", (n_requests() - r0) / unsigned(reps), 0, clock.time() - t0, reps);
+  ok = ok && (x(0) == 0.5) && (x(n - 1) == 0.5);
+
+  //in two passes without temporaries
+  r0 = n_requests();
+  t0 = clock.time();
+  for (int r = 0; r < reps; r++) {
+    x.xeya(y, a);
+    x.xpeya(z, b);
+  }
+  report("x.xeya(y,a); x.xpeya(z,b)", (n_requests() - r0) / unsigned(reps), 0, clock.time() - t0, reps);
+  ok = ok && (x(0) == 0.5) && (x(n - 1) == 0.5);
+  check(ok, "all forms compute a*y+b*z");
+
+  //x+=a*y by operators and fused
+  r0 = n_requests();
+  t0 = clock.time();
+  for (int r = 0; r < reps; r++)
+    x += a * y;
+  report("x+=a*y", (n_requests() - r0) / unsigned(reps), 1, clock.time() - t0, reps);
+  r0 = n_requests();
+  t0 = clock.time();
+  for (int r = 0; r < reps; r++)
+    x.xpeya(y, a);
+  report("x.xpeya(y,a)", (n_requests() - r0) / unsigned(reps), 0, clock.time() - t0, reps);
+
+  //copies, moves and return values
+  r0 = n_requests();
+  t0 = clock.time();
+  for (int r = 0; r < reps; r++) {
+    Matrix c(y);
+    swap(x, c);
+  }
+  report("Matrix c(y)", (n_requests() - r0) / unsigned(reps), 1, clock.time() - t0, reps);
+  r0 = n_requests();
+  t0 = clock.time();
+  for (int r = 0; r < reps; r++) {
+    Matrix w(std::move(x));
+    x = std::move(w);
+  }
+  report("move construction and assignment", (n_requests() - r0) / unsigned(reps), 0, clock.time() - t0, reps);
+  r0 = n_requests();
+  t0 = clock.time();
+  for (int r = 0; r < reps; r++)
+    x = scaled_copy(y, a);
+  report("x=function returning a Matrix", (n_requests() - r0) / unsigned(reps), 1, clock.time() - t0, reps);
+
+  cout << n_failed << " checks failed" << endl;
+  return n_failed;
+}
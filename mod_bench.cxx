@@ -0,0 +1,254 @@
+/* ****************************************************************************
+
+    Copyright (C) 2026  ConicBundle contributors
+
+    ConicBundle, Version 1.a.2
+    File:  mod_bench.cxx
+    This file is part of ConciBundle, a C/C++ library for convex optimization.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+/* Benchmark for the cost of adding and removing variables on the fly.
+
+   The oracle is the Lagrangian relaxation of Ax<=b over the box [0,1]^N,
+
+      f(y) = max { (c-A^Ty)^Tx : x in [0,1]^N },
+
+   and in each round a few random sparse rows are appended to A (together
+   with their Lagrange multipliers in the solver) and every second round
+   the last rows are deleted again. The bundle minorants are extended
+   for the new rows by the MinorantExtender of the oracle. The time spent
+   in append_variables() and delete_variables() including the execution
+   of the modifications in the solver is reported separately from the
+   time spent in solve(); the first should mainly depend on the size of
+   the change and the size of the bundle, not on the number of rows
+   already present.
+
+   If numa is 1, large new blocks of the memory manager are touched
+   first in parallel and the worker threads are pinned (see
+   Memarray::set_first_touch() and CH_Tools::ThreadPlacement), which
+   is intended for comparing the times on machines with several NUMA
+   nodes; the number of blocks touched in parallel is reported at the end.
+
+   usage: mod_bench [rounds [n_append [n_box [numa]]]]
+*/
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include "MatrixCBSolver.hxx"
+#include "thread_placement.hxx"
+
+using namespace CH_Matrix_Classes;
+using namespace ConicBundle;
+using namespace std;
+
+//*****************************************************************************
+//                              BoxLagrangeOracle
+//*****************************************************************************
+
+class BoxLagrangeOracle;
+
+/// extends a minorant generated by x for the new rows by -a_i^Tx
+class BoxLagrangeExtender : public MinorantExtender {
+private:
+  const BoxLagrangeOracle* oracle;
+public:
+  BoxLagrangeExtender(const BoxLagrangeOracle* o) :oracle(o) {
+  }
+  int extend(Minorant& minorant, int n_coords, const int* indices);
+};
+
+/// the Lagrangian relaxation of Ax<=b for x in the box [0,1]^N
+class BoxLagrangeOracle : public MatrixFunctionOracle {
+private:
+  Matrix c;                 ///< cost vector
+  Indexmatrix rowstart;     ///< row i has the entries rowstart(i) to rowstart(i+1)-1
+  Indexmatrix colind;       ///< column indices of the row entries
+  Matrix val;               ///< values of the row entries
+  CH_Tools::GB_rand rg;     ///< for generating the data
+
+public:
+  BoxLagrangeOracle(Integer n) :c(n, 1, 0.), rowstart(1, 1, Integer(0)), rg(1) {
+    colind.init(0, 1, Integer(0));
+    val.init(0, 1, 0.);
+    for (Integer j = 0; j < n; j++)
+      c(j) = rg.next() - .5;
+  }
+
+  Integer nrows() const {
+    return rowstart.dim() - 1;
+  }
+
+  /// appends rows with nz random entries and returns their right hand sides
+  void append_rows(Integer nr, Integer nz, Matrix& rhs) {
+    rhs.init(nr, 1, 0.);
+    for (Integer i = 0; i < nr; i++) {
+      for (Integer k = 0; k < nz; k++) {
+        colind.concat_below(Integer(rg.unif_long(c.dim())));
+        val.concat_below(rg.next());
+      }
+      rowstart.concat_below(colind.dim());
+      rhs(i) = .05 * Real(nz);
+    }
+  }
+
+  /// deletes the last nr rows
+  void delete_rows(Integer nr) {
+    Integer nz = rowstart(nrows() - nr);
+    rowstart.reduce_length(nrows() - nr + 1);
+    colind.reduce_length(nz);
+    val.reduce_length(nz);
+  }
+
+  /// returns a_i^Tx
+  Real row_ip(Integer i, const Matrix& x) const {
+    Real d = 0.;
+    for (Integer k = rowstart(i); k < rowstart(i + 1); k++)
+      d += val(k) * x(colind(k));
+    return d;
+  }
+
+  int evaluate(const Matrix& y, double, double& objective_value,
+    std::vector<Minorant*>& minorants, PrimalExtender*&) {
+    //reduced costs
+    Matrix rc(c);
+    for (Integer i = 0; i < nrows(); i++) {
+      for (Integer k = rowstart(i); k < rowstart(i + 1); k++)
+        rc(colind(k)) -= y(i) * val(k);
+    }
+    PrimalMatrix x(c.dim(), 1, 0.);
+    Real offset = 0.;
+    objective_value = 0.;
+    for (Integer j = 0; j < c.dim(); j++) {
+      if (rc(j) > 0.) {
+        x(j) = 1.;
+        offset += c(j);
+        objective_value += rc(j);
+      }
+    }
+    Minorant* mnrt = new Minorant(true, offset, 0, 0, 0, 1., x.clone_primal_data());
+    for (Integer i = 0; i < nrows(); i++) {
+      Real d = row_ip(i, x);
+      if (d != 0.)
+        mnrt->add_coeff(int(i), -d);
+    }
+    minorants.push_back(mnrt);
+    return 0;
+  }
+
+  int apply_modification(const OracleModification&, const Matrix*, const Matrix*,
+    bool& discard_objective_in_center, bool& discard_model,
+    bool& discard_aggregates, MinorantExtender*& minorant_extender) {
+    discard_objective_in_center = true;
+    discard_model = false;
+    discard_aggregates = false;
+    minorant_extender = new BoxLagrangeExtender(this);
+    return 0;
+  }
+};
+
+int BoxLagrangeExtender::extend(Minorant& minorant, int n_coords, const int* indices) {
+  const PrimalMatrix* x = dynamic_cast<const PrimalMatrix*>(minorant.get_primal());
+  if (x == 0)
+    return 1;
+  for (int k = 0; k < n_coords; k++) {
+    Real d = oracle->row_ip(indices[k], *x);
+    if ((d != 0.) && (minorant.add_coeff(indices[k], -d)))
+      return 1;
+  }
+  return 0;
+}
+
+//*****************************************************************************
+//                                   main
+//*****************************************************************************
+
+int main(int argc, char** argv) {
+  Integer rounds = (argc > 1) ? atoi(argv[1]) : 1000;
+  Integer n_append = (argc > 2) ? atoi(argv[2]) : 5;
+  Integer n_box = (argc > 3) ? atoi(argv[3]) : 2000;
+  bool numa = (argc > 4) ? (atoi(argv[4]) != 0) : false;
+  Integer n_delete = n_append / 2;
+
+  if (numa) {
+    Memarray::set_first_touch(1L << 20);
+    CH_Tools::ThreadPlacement::set_pinning(true);
+  }
+
+  BoxLagrangeOracle oracle(n_box);
+  MatrixCBSolver solver;
+  Matrix rhs;
+  oracle.append_rows(n_append, 5, rhs);
+  Matrix lb(n_append, 1, 0.);
+  solver.init_problem(n_append, &lb, 0, 0, &rhs);
+  solver.add_function(oracle, 1., ObjectiveFunction, 0, true);
+  solver.set_max_bundlesize(10, &oracle);
+  solver.set_term_relprec(1e-8);
+
+  if (solver.solve(5)) {
+    cout << "**** ERROR: initial solver.solve() failed" << endl;
+    return 1;
+  }
+
+  CH_Tools::Clock clock;
+  CH_Tools::Microseconds modtime(0);
+  CH_Tools::Microseconds solvetime(0);
+  CH_Tools::Microseconds checkpoint = clock.time();
+  for (Integer r = 1; r <= rounds; r++) {
+    oracle.append_rows(n_append, 5, rhs);
+    CH_Tools::Microseconds start = clock.time();
+    if (solver.append_variables(n_append, &lb, 0, 0, 0, &rhs)) {
+      cout << "**** ERROR: solver.append_variables(...) failed in round " << r << endl;
+      return 1;
+    }
+    if ((r % 2) == 0) {
+      Integer dim = solver.get_dim();
+      Indexmatrix delind(Range(dim - n_delete, dim - 1));
+      Indexmatrix map_to_old;
+      if (solver.delete_variables(delind, map_to_old)) {
+        cout << "**** ERROR: solver.delete_variables(...) failed in round " << r << endl;
+        return 1;
+      }
+      oracle.delete_rows(n_delete);
+    }
+    //get_dim() executes the pending modifications
+    solver.get_dim();
+    modtime += clock.time() - start;
+    start = clock.time();
+    if (solver.solve(5)) {
+      cout << "**** ERROR: solver.solve() failed in round " << r << endl;
+      return 1;
+    }
+    solvetime += clock.time() - start;
+    if ((r % (rounds / 10 > 0 ? rounds / 10 : 1)) == 0) {
+      cout << " round " << setw(5) << r << " dim " << setw(6) << solver.get_dim();
+      cout << " objval " << setw(12) << solver.get_objval();
+      cout << " descent steps " << setw(6) << solver.get_n_descent_steps();
+      cout << " termination " << solver.termination_code();
+      cout << " modification time " << modtime;
+      cout << " solve time " << solvetime;
+      cout << " last rounds " << clock.time() - checkpoint << endl;
+      checkpoint = clock.time();
+    }
+  }
+  if (numa) {
+    cout << " blocks touched in parallel " << Memarrayuser::get_memarray()->get_n_touched();
+    cout << " of " << Memarrayuser::get_memarray()->get_n_allocs() << " allocated" << endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,149 @@
+/* ****************************************************************************
+
+    Copyright (C) 2026  ConicBundle contributors
+
+    ConicBundle, Version 1.a.2
+    File:  spmat_main.cxx
+    This file is part of ConciBundle, a C/C++ library for convex optimization.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+/* Checks of the storage modes of Sparsemat.
+
+   A random sparse matrix is stored once with both representations
+   (eager) and once with the row representation built on demand (lazy,
+   see Sparsemat::set_lazy_rowrep()). All results computed with the lazy
+   copy must agree with those of the eager one, copies must keep the
+   mode, and the lazy matrix may hold its rows only after a routine
+   needed them. The program prints one line per check and returns the
+   number of failed checks.
+*/
+
+#include <iostream>
+#include <vector>
+#include "sparsmat.hxx"
+#include "matrix.hxx"
+#include "gb_rand.hxx"
+
+using namespace std;
+using namespace CH_Matrix_Classes;
+
+static int n_failed = 0;
+
+static void check(bool ok, const char* what) {
+  cout << ((ok) ? " ok     " : " FAILED ") << what << endl;
+  if (!ok)
+    n_failed++;
+}
+
+static bool same_rowrep(const Sparsemat& A, const Sparsemat& B) {
+  return (equal(A.get_rowinfo(), B.get_rowinfo())) &&
+    (equal(A.get_rowindex(), B.get_rowindex())) &&
+    (norm2(A.get_rowval() - B.get_rowval()) == 0.);
+}
+
+static Real diff(const Sparsemat& A, const Sparsemat& B) {
+  return norm2(Matrix(A) - Matrix(B));
+}
+
+int main() {
+  CH_Tools::GB_rand rg(1);
+  const Integer nr = 300;
+  const Integer nc = 200;
+  const Integer nz = 3000;
+  Indexmatrix I(nz, 1);
+  Indexmatrix J(nz, 1);
+  Matrix V(nz, 1);
+  for (Integer k = 0; k < nz; k++) {
+    I(k) = Integer(rg.unif_long(nr));
+    J(k) = Integer(rg.unif_long(nc));
+    V(k) = rg.next() - .5;
+  }
+
+  Sparsemat E(nr, nc, nz, I, J, V);
+  Sparsemat L;
+  L.set_lazy_rowrep(true);
+  L.init(nr, nc, nz, I, J, V);
+
+  std::size_t colbytes, rowbytes;
+  L.get_memory_usage(colbytes, rowbytes);
+  check((L.get_lazy_rowrep()) && (!L.has_rowrep()) && (rowbytes == 0) && (colbytes > 0), "lazy init holds only the columns");
+  E.get_memory_usage(colbytes, rowbytes);
+  check((!E.get_lazy_rowrep()) && (E.has_rowrep()) && (rowbytes > 0), "eager init holds both representations");
+
+  //products with dense matrices use the columns
+  Matrix x(nc, 3);
+  Matrix y(nr, 3);
+  for (Integer i = 0; i < x.dim(); i++)
+    x(i) = rg.next();
+  for (Integer i = 0; i < y.dim(); i++)
+    y(i) = rg.next();
+  Matrix ex, lx, ey, ly;
+  genmult(E, x, ex);
+  genmult(L, x, lx);
+  genmult(E, y, ey, 1., 0., 1);
+  genmult(L, y, ly, 1., 0., 1);
+  check((norm2(ex - lx) < 1e-12) && (norm2(ey - ly) < 1e-12), "A*x and A^T*y agree");
+  check((norm2(sumcols(E) - sumcols(L)) < 1e-12) && (std::fabs(ip(E, E) - ip(L, L)) < 1e-10), "sumcols() and ip() agree");
+  check(!L.has_rowrep(), "dense products do not build the rows");
+
+  //copies keep the mode
+  Sparsemat C(L);
+  check((C.get_lazy_rowrep()) && (!C.has_rowrep()) && (diff(C, E) == 0.), "copy constructor keeps lazy");
+  Sparsemat D;
+  D.xeya(L, 2.);
+  check((D.get_lazy_rowrep()) && (!D.has_rowrep()) && (diff(D, 2. * Matrix(E)) < 1e-12), "xeya() keeps lazy");
+  D = E;
+  check((!D.get_lazy_rowrep()) && (D.has_rowrep()), "assigning an eager matrix makes it eager");
+  D = L;
+  check((D.get_lazy_rowrep()) && (!D.has_rowrep()), "assigning a lazy matrix makes it lazy");
+
+  //the rows are built on demand and agree with the eager ones
+  std::vector<std::int64_t> eoff, loff;
+  E.get_csr_offsets(eoff);
+  L.get_csr_offsets(loff);
+  check((L.has_rowrep()) && (eoff == loff) && (same_rowrep(E, L)), "rows built on demand agree");
+  E.get_csc_offsets(eoff);
+  L.get_csc_offsets(loff);
+  check((eoff == loff) && (eoff.back() == E.nonzeros()), "column offsets agree");
+
+  //sparse products and modifications keep the built rows in sync
+  Matrix ES, LS;
+  genmult(E, E, ES, 1., 0., 1);
+  genmult(L, L, LS, 1., 0., 1);
+  check(norm2(ES - LS) < 1e-12, "A^T*A agrees");
+  E *= 3.;
+  L *= 3.;
+  Indexmatrix del(Range(10, 40));
+  E.delete_rows(del);
+  L.delete_rows(del);
+  E.delete_cols(del);
+  L.delete_cols(del);
+  Sparsemat F(E);
+  E.concat_below(F);
+  L.concat_below(F);
+  check((L.has_rowrep()) && (diff(E, L) == 0.) && (same_rowrep(E, L)), "scaling, deletions and concat_below() agree");
+
+  //switching lazy on again releases the rows
+  L.set_lazy_rowrep(true);
+  L.get_memory_usage(colbytes, rowbytes);
+  check((!L.has_rowrep()) && (rowbytes == 0) && (diff(E, L) == 0.), "set_lazy_rowrep(true) releases the rows");
+  L.set_lazy_rowrep(false);
+  check((L.has_rowrep()) && (same_rowrep(E, L)), "set_lazy_rowrep(false) builds the rows");
+
+  cout << n_failed << " checks failed" << endl;
+  return n_failed;
+}
@@ -0,0 +1,270 @@
+/* ****************************************************************************
+
+    Copyright (C) 2026  ConicBundle contributors
+
+    ConicBundle, Version 1.a.2
+    File:  state_main.cxx
+    This file is part of ConciBundle, a C/C++ library for convex optimization.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+/* Checks of MatrixCBSolver::save_state() and load_state().
+
+   A solver is stopped after a few steps, its state is saved and loaded
+   into a second solver that is set up for the same problem. Loading has
+   to restore the center and its value without calling the oracle of a
+   function given by a MatrixFunctionOracle, also if a SumBundle is used.
+   The models of a PSCAffineFunction and of a BoxOracle are not stored;
+   loading calls the PSC oracle exactly once and recomputes the box
+   model, so the value of the PSC function in the center may change
+   within the precision of its eigenvalue computation. Where the uninterrupted run converges, resuming the second
+   solver has to reach its optimal value, otherwise (with the SumBundle
+   and with the box function this takes too many steps or stops early
+   with the step limits of the bundle method) resuming must not increase
+   the value of the center. A truncated snapshot has to be rejected.
+   The program prints one line per check and returns the number of
+   failed checks.
+*/
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include "CMsingleton.hxx"
+#include "CMsymsparse.hxx"
+#include "MatrixCBSolver.hxx"
+#include "PSCAffineFunction.hxx"
+#include "BoxOracle.hxx"
+#include "gb_rand.hxx"
+
+using namespace std;
+using namespace CH_Matrix_Classes;
+using namespace ConicBundle;
+
+static int n_failed = 0;
+
+static void check(bool ok, const char* what) {
+  cout << ((ok) ? " ok     " : " FAILED ") << what << endl;
+  if (!ok)
+    n_failed++;
+}
+
+/// f(y)=||y-c||_1+max_i (b_i+a_i^Ty) with |a_ij|<1, so f is bounded below; counts its evaluations
+class PiecewiseLinear : public MatrixFunctionOracle {
+  Matrix A;  ///< the columns are the a_i
+  Matrix b;
+  Matrix c;
+public:
+  int n_calls;
+
+  PiecewiseLinear(Integer dim, Integer npieces, CH_Tools::GB_rand& rg) :
+    A(dim, npieces), b(npieces, 1), c(dim, 1), n_calls(0) {
+    for (Integer i = 0; i < A.dim(); i++)
+      A(i) = 1.8 * rg.next() - 0.9;
+    for (Integer i = 0; i < npieces; i++)
+      b(i) = rg.next();
+    for (Integer i = 0; i < dim; i++)
+      c(i) = 2. * rg.next() - 1.;
+  }
+
+  int evaluate(const Matrix& y, Real, Real& objective_value,
+    std::vector<Minorant*>& minorants, PrimalExtender*&) {
+    n_calls++;
+    Matrix v(b);
+    genmult(A, y, v, 1., 1., 1);
+    Integer imax;
+    Real maxval = max(v, &imax);
+    Matrix subg(A.col(imax));
+    objective_value = maxval;
+    for (Integer j = 0; j < y.dim(); j++) {
+      Real d = y(j) - c(j);
+      objective_value += std::fabs(d);
+      subg(j) += (d >= 0.) ? 1. : -1.;
+    }
+    minorants.push_back(new Minorant(false, objective_value, int(subg.dim()), subg.get_store()));
+    return 0;
+  }
+};
+
+/// the max-cut eigenvalue function of a random graph; counts its evaluations
+class CountedPSC : public PSCAffineFunction {
+public:
+  int n_calls;
+
+  CountedPSC(const SparseCoeffmatMatrix& C, const SparseCoeffmatMatrix& opAt) :
+    PSCAffineFunction(C, opAt), n_calls(0) {
+  }
+
+  int evaluate(const Matrix& current_point, const Matrix& bundlevecs,
+    const double relprec, const double Ritz_bound,
+    Matrix& Ritz_vectors, Matrix& Ritz_values,
+    PSCPrimalExtender*& primal_extender) {
+    n_calls++;
+    return PSCAffineFunction::evaluate(current_point, bundlevecs, relprec, Ritz_bound, Ritz_vectors, Ritz_values, primal_extender);
+  }
+};
+
+/// the kinds of functions added besides the MatrixFunctionOracle
+enum { with_psc = 1, with_box = 2 };
+
+/// the functions of one problem instance, each solver gets its own copy
+struct Problem {
+  Integer dim;
+  PiecewiseLinear pwl;
+  CountedPSC* psc;
+  BoxOracle* box;
+
+  Problem(Integer n, int kind) : dim(n), pwl(n, 2 * n, rg()), psc(0), box(0) {
+    if (kind == 0)
+      return;
+    CH_Tools::GB_rand& r = rg();
+    Indexmatrix I(2 * n, 1);
+    Indexmatrix J(2 * n, 1);
+    Matrix V(2 * n, 1, 0.25);
+    for (Integer h = 0; h < 2 * n; h++) {
+      I(h) = Integer(r.unif_long(n));
+      J(h) = (I(h) + 1 + Integer(r.unif_long(n - 1))) % n;
+    }
+    Sparsesym L(n, 2 * n, I, J, V);
+    Indexmatrix Xdim(1, 1, n);
+    SparseCoeffmatMatrix C(Xdim, 1);
+    C.set(0, 0, new CMsymsparse(L));
+    SparseCoeffmatMatrix opAt(Xdim, n);
+    for (Integer i = 0; i < n; i++)
+      opAt.set(0, i, new CMsingleton(n, i, i, -1.));
+    if (kind & with_psc)
+      psc = new CountedPSC(C, opAt);
+    if (kind & with_box)
+      box = new BoxOracle(Matrix(n, 1, -0.5), Matrix(n, 1, 0.5));
+  }
+
+  ~Problem() {
+    delete psc;
+    delete box;
+  }
+
+  // the same random data for every instance
+  static CH_Tools::GB_rand& rg() {
+    static CH_Tools::GB_rand r;
+    return r;
+  }
+
+  static Problem* make(Integer n, int kind) {
+    rg().init(17);
+    return new Problem(n, kind);
+  }
+
+  int setup(MatrixCBSolver& solver, bool sumbundle) {
+    Matrix costs(dim, 1, (psc) ? 1. : 0.);
+    int err = solver.init_problem(int(dim), 0, 0, 0, &costs);
+    err = err || solver.add_function(pwl);
+    if (psc)
+      err = err || solver.add_function(*psc, Real(dim));
+    if (box)
+      err = err || solver.add_function(*box);
+    err = err || solver.set_sumbundle(sumbundle);
+    solver.set_term_relprec(1e-5);
+    return err;
+  }
+
+  int n_calls() const {
+    return pwl.n_calls + ((psc) ? psc->n_calls : 0);
+  }
+};
+
+// stops after a few steps, saves, loads into a new solver and resumes
+static void save_load_resume(const char* name, int kind, bool sumbundle, bool converges) {
+  const Integer n = 12;
+  char what[200];
+
+  //uninterrupted reference run
+  Real refval = 0.;
+  if (converges) {
+    Problem* ref = Problem::make(n, kind);
+    MatrixCBSolver refsolver;
+    bool ok = (ref->setup(refsolver, sumbundle) == 0) && (refsolver.solve() == 0) && (refsolver.termination_code() == 1);
+    refval = refsolver.get_objval();
+    snprintf(what, sizeof(what), "%s: uninterrupted run, value %.8f", name, refval);
+    check(ok, what);
+    delete ref;
+  }
+
+  //interrupted run
+  Problem* p1 = Problem::make(n, kind);
+  MatrixCBSolver solver1;
+  bool ok = (p1->setup(solver1, sumbundle) == 0) && (solver1.solve(15) == 0) && (solver1.termination_code() == 0);
+  std::stringstream state;
+  ok = ok && (solver1.save_state(state) == 0);
+  snprintf(what, sizeof(what), "%s: save_state after 15 steps", name);
+  check(ok, what);
+  Real val1 = solver1.get_objval();
+  Matrix center1;
+  solver1.get_center(center1);
+
+  //restore into a new solver
+  Problem* p2 = Problem::make(n, kind);
+  MatrixCBSolver solver2;
+  ok = (p2->setup(solver2, sumbundle) == 0) && (solver2.load_state(state) == 0);
+  Matrix center2;
+  solver2.get_center(center2);
+  //the value of a PSC function is recomputed from scratch, the saved one is
+  //only accurate up to the precision requested by the bundle method then
+  Real tol = (p2->psc) ? 1e-3 * (std::fabs(val1) + 1.) : 0.;
+  ok = ok && (std::fabs(solver2.get_objval() - val1) <= tol) && (equal(center1, center2));
+  snprintf(what, sizeof(what), "%s: load_state restores the center and its value", name);
+  check(ok, what);
+  snprintf(what, sizeof(what), "%s: load_state calls the MatrixFunctionOracle %d times (expected 0)", name, p2->pwl.n_calls);
+  check(p2->pwl.n_calls == 0, what);
+  if (p2->psc) {
+    snprintf(what, sizeof(what), "%s: load_state calls the PSC oracle %d times (expected 1)", name, p2->psc->n_calls);
+    check(p2->psc->n_calls == 1, what);
+  }
+
+  //resume
+  if (converges) {
+    ok = (solver2.solve() == 0) && (solver2.termination_code() == 1);
+    ok = ok && (std::fabs(solver2.get_objval() - refval) <= 1e-5 * (std::fabs(refval) + 1.));
+  } else {
+    ok = (solver2.solve(100) == 0) && (solver2.get_objval() <= val1);
+  }
+  snprintf(what, sizeof(what), "%s: resumed run, value %.8f after %d more evaluations", name, solver2.get_objval(), p2->n_calls());
+  check(ok, what);
+
+  //a truncated snapshot is rejected without evaluating the functions
+  std::string s = state.str();
+  std::stringstream truncated(s.substr(0, s.size() / 2));
+  Problem* p3 = Problem::make(n, kind);
+  MatrixCBSolver solver3;
+  solver3.set_out(0);
+  ok = (p3->setup(solver3, sumbundle) == 0) && (solver3.load_state(truncated) != 0) && (p3->n_calls() == 0);
+  snprintf(what, sizeof(what), "%s: a truncated snapshot is rejected", name);
+  check(ok, what);
+
+  delete p1;
+  delete p2;
+  delete p3;
+}
+
+int main() {
+  save_load_resume("MatrixFunctionOracle", 0, false, true);
+  save_load_resume("MatrixFunctionOracle with SumBundle", 0, true, false);
+  save_load_resume("with PSC function", with_psc, false, true);
+  save_load_resume("with PSC function and SumBundle", with_psc, true, false);
+  save_load_resume("with box function", with_box, false, false);
+
+  cout << n_failed << " checks failed" << endl;
+  return n_failed;
+}
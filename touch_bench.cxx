@@ -0,0 +1,102 @@
+/* ****************************************************************************
+
+    Copyright (C) 2026  ConicBundle contributors
+
+    ConicBundle, Version 1.a.2
+    File:  touch_bench.cxx
+    This file is part of ConciBundle, a C/C++ library for convex optimization.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+/* Benchmark for the parallel first touch of Memarray blocks and the
+   pinning of the worker threads.
+
+   A vector of mbytes megabytes is allocated (and, if first_touch is 1,
+   touched first in parallel by nthreads tasks of CH_Tools::ThreadPool,
+   see Memarray::set_first_touch()). Then the same nthreads tasks sweep
+   reps times over the vector, task t over the same range of pages it
+   touched first, and x+=0.5*x is computed there. With pinning (pin 1)
+   worker t runs on the same processor in the first touch and in all
+   sweeps, so on a machine with several NUMA nodes it finds its pages
+   on its own node. The times of the allocation (including the first
+   touch) and of the sweeps are reported; compare the four combinations
+   of first_touch and pin on the machine of interest.
+
+   usage: touch_bench [mbytes [nthreads [first_touch [pin [reps]]]]]
+*/
+
+#include <cstdlib>
+#include <iostream>
+#include "matrix.hxx"
+#include "clock.hxx"
+#include "thread_placement.hxx"
+#include "thread_pool.hxx"
+
+using namespace CH_Matrix_Classes;
+using namespace std;
+
+int main(int argc, char** argv) {
+  long mbytes = (argc > 1) ? atol(argv[1]) : 512;
+  int nt = (argc > 2) ? atoi(argv[2]) : CH_Tools::ThreadPlacement::n_processors();
+  bool first_touch = (argc > 3) ? (atoi(argv[3]) != 0) : true;
+  bool pin = (argc > 4) ? (atoi(argv[4]) != 0) : true;
+  int reps = (argc > 5) ? atoi(argv[5]) : 20;
+  if ((mbytes <= 0) || (nt <= 0) || (reps <= 0)) {
+    cout << "usage: touch_bench [mbytes [nthreads [first_touch [pin [reps]]]]]" << endl;
+    return 1;
+  }
+
+  if (first_touch)
+    Memarray::set_first_touch(1L << 20, nt);
+  CH_Tools::ThreadPlacement::set_pinning(pin);
+
+  //start and place the workers before measuring
+  CH_Tools::ThreadPool::run(nt, [](int) {});
+
+  const Integer n = Integer((mbytes << 20) / long(sizeof(Real)));
+  CH_Tools::Clock clock;
+  CH_Tools::Microseconds start = clock.time();
+  Matrix x(n, 1, 1.);
+  CH_Tools::Microseconds alloctime = clock.time() - start;
+
+  //the same ranges of whole pages as in Memarray::first_touch()
+  const long page = 4096;
+  const long size = long(n) * long(sizeof(Real));
+  const long chunk = ((size / nt + page - 1) / page) * page;
+  Real* xp = x.get_store();
+  start = clock.time();
+  for (int r = 0; r < reps; r++) {
+    CH_Tools::ThreadPool::run(nt, [xp, size, chunk](int t) {
+      long lo = (long(t) * chunk) / long(sizeof(Real));
+      long hi = (long(t + 1) * chunk) / long(sizeof(Real));
+      if (hi > size / long(sizeof(Real)))
+        hi = size / long(sizeof(Real));
+      for (long i = lo; i < hi; i++)
+        xp[i] += 0.5 * xp[i];
+    });
+  }
+  CH_Tools::Microseconds sweeptime = clock.time() - start;
+
+  cout << " mbytes " << mbytes << " threads " << nt;
+  cout << " first_touch " << first_touch << " pin " << pin;
+  cout << " blocks touched in parallel " << Memarrayuser::get_memarray()->get_n_touched();
+  cout << " allocation time " << alloctime;
+  cout << " sweep time " << sweeptime;
+  cout << " GB/s " << (2. * double(size) * reps) / (1e9 * double(sweeptime)) << endl;
+  cout << " check " << x(n - 1) << endl;
+
+  return 0;
+}
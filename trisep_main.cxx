@@ -0,0 +1,199 @@
+/* ****************************************************************************
+
+    Copyright (C) 2026  ConicBundle contributors
+
+    ConicBundle, Version 1.a.2
+    File:  trisep_main.cxx
+    This file is part of ConciBundle, a C/C++ library for convex optimization.
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+***************************************************************************** */
+
+/* Checks of TriangleSeparator::separate() against the plain O(n^3)
+   enumeration of all triangle inequalities.
+
+   X = G*G^T + S is formed explicitly from entries that are multiples of
+   1/2, so all left hand sides are exact and many of them tie, also with
+   the threshold of the heaps of the separator. For tile sizes 8, 16 and
+   256 and for 1 and 3 threads the triangles returned must coincide with
+   the max_n best ones of the enumeration in value, order and signs,
+   where ties are ordered by the indices. A matrix whose triangles all
+   have the same left hand side pins the tie breaking at the cut off,
+   and left hand sides equal to -1-min_violation must not be returned.
+   The program prints one line per check and returns the number of
+   failed checks.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <vector>
+#include "TriangleSeparator.hxx"
+#include "gb_rand.hxx"
+
+using namespace std;
+using namespace CH_Matrix_Classes;
+using namespace ConicBundle;
+
+static int n_failed = 0;
+
+static void check(bool ok, const char* what) {
+  cout << ((ok) ? " ok     " : " FAILED ") << what << endl;
+  if (!ok)
+    n_failed++;
+}
+
+/// a triangle with signed j and k as returned by TriangleSeparator
+struct Triangle {
+  Real lhs;
+  Integer i, j, k;
+  bool operator<(const Triangle& t) const {
+    if (lhs != t.lhs) return (lhs < t.lhs);
+    if (i != t.i) return (i < t.i);
+    if (j != t.j) return (j < t.j);
+    return (k < t.k);
+  }
+  bool operator==(const Triangle& t) const {
+    return (lhs == t.lhs) && (i == t.i) && (j == t.j) && (k == t.k);
+  }
+};
+
+// the max_n best triangles with lhs < -1-min_violation; for each i<j<k
+// the first minimal of the sign patterns (1,1),(1,-1),(-1,1),(-1,-1)
+static void enumerate(const Matrix& G, const Sparsesym* S, Integer n, Integer max_n, Real min_violation, vector<Triangle>& tri) {
+  Matrix X(n, n, 0.);
+  for (Integer i = 0; i < n; i++)
+    for (Integer j = 0; j < n; j++) {
+      Real sum = 0.;
+      for (Integer l = 0; l < G.coldim(); l++)
+        sum += G(i, l) * G(j, l);
+      X(i, j) = sum + ((S) ? (*S)(i, j) : 0.);
+    }
+  const Integer signs[4][2] = { {1, 1}, {1, -1}, {-1, 1}, {-1, -1} };
+  tri.clear();
+  for (Integer i = 0; i < n; i++)
+    for (Integer j = i + 1; j < n; j++)
+      for (Integer k = j + 1; k < n; k++) {
+        Triangle best;
+        for (int p = 0; p < 4; p++) {
+          const Integer sj = signs[p][0];
+          const Integer sk = signs[p][1];
+          Real lhs = Real(sj) * X(i, j) + Real(sk) * X(i, k) + Real(sj * sk) * X(j, k);
+          if ((p == 0) || (lhs < best.lhs)) {
+            best.lhs = lhs;
+            best.i = i;
+            best.j = sj * j;
+            best.k = sk * k;
+          }
+        }
+        if (best.lhs < -1. - min_violation)
+          tri.push_back(best);
+      }
+  sort(tri.begin(), tri.end());
+  if (Integer(tri.size()) > max_n)
+    tri.resize(size_t(max_n));
+}
+
+// compares the separator with the enumeration for all tile sizes and thread numbers
+static void compare(const char* name, const Matrix& G, const Sparsesym* S, Integer n, Integer max_n, Real min_violation) {
+  vector<Triangle> ref;
+  enumerate(G, S, n, max_n, min_violation, ref);
+  const Integer tiles[3] = { 8, 16, 256 };
+  const Integer threads[2] = { 1, 3 };
+  for (int ti = 0; ti < 3; ti++)
+    for (int th = 0; th < 2; th++) {
+      TriangleSeparator sep;
+      sep.set_chunk_size(tiles[ti]);
+      sep.set_n_threads(threads[th]);
+      bool ok = (sep.separate(G, S, n, max_n, min_violation) == 0) && (sep.get_n_triangles() == Integer(ref.size()));
+      for (Integer t = 0; (ok) && (t < sep.get_n_triangles()); t++) {
+        Triangle tr;
+        Integer j, k, sj, sk;
+        sep.get_triangle(t, tr.i, j, k, sj, sk, tr.lhs);
+        tr.j = sj * j;
+        tr.k = sk * k;
+        ok = (tr == ref[size_t(t)]);
+      }
+      char what[200];
+      snprintf(what, sizeof(what), "%s: %ld triangles, tile %ld, %ld threads", name, long(ref.size()), long(tiles[ti]), long(threads[th]));
+      check(ok, what);
+    }
+}
+
+int main() {
+  CH_Tools::GB_rand rg(1);
+
+  //Gram factor and sparse part with entries in {-1,-1/2,0,1/2,1}
+  const Integer n = 45;
+  Matrix G(n, 2, 0.);
+  for (Integer h = 0; h < G.dim(); h++)
+    G(h) = Real(rg.unif_long(5) - 2) / 2.;
+  const Integer nz = 150;
+  Indexmatrix I(nz, 1);
+  Indexmatrix J(nz, 1);
+  Matrix V(nz, 1);
+  for (Integer h = 0; h < nz; h++) {
+    I(h) = Integer(rg.unif_long(n));
+    J(h) = Integer(rg.unif_long(n));
+    V(h) = Real(rg.unif_long(5) - 2) / 2.;
+  }
+  Sparsesym S(n, nz, I, J, V);
+
+  compare("Gram+sparse, all violated", G, &S, n, n * n * n, 0.);
+  compare("Gram+sparse, best 40", G, &S, n, 40, 0.);
+  compare("Gram+sparse, best 7", G, &S, n, 7, 0.);
+  compare("Gram only, best 30", G, 0, n, 30, 0.);
+  compare("leading 37 nodes, best 25", G, &S, 37, 25, 0.5);
+
+  //all triangles have lhs -3, the cut off is decided by the indices alone
+  const Integer m = 40;
+  Matrix G0(m, 1, 0.);
+  Indexmatrix I0(m * (m - 1) / 2, 1);
+  Indexmatrix J0(m * (m - 1) / 2, 1);
+  Integer h = 0;
+  for (Integer i = 0; i < m; i++)
+    for (Integer j = i + 1; j < m; j++, h++) {
+      I0(h) = i;
+      J0(h) = j;
+    }
+  Sparsesym S0(m, h, I0, J0, Matrix(h, 1, -1.));
+  compare("all tied, best 25", G0, &S0, m, 25, 0.);
+  {
+    TriangleSeparator sep;
+    sep.set_chunk_size(8);
+    sep.set_n_threads(3);
+    sep.separate(G0, &S0, m, 3, 0.);
+    Integer i, j, k, sj, sk;
+    Real lhs;
+    bool ok = (sep.get_n_triangles() == 3);
+    for (Integer t = 0; (ok) && (t < 3); t++)
+      ok = (sep.get_triangle(t, i, j, k, sj, sk, lhs) == 0) && (lhs == -3.) && (i == 0) && (j == 1) && (k == 2 + t) && (sj == 1) && (sk == 1);
+    check(ok, "all tied: the smallest indices win at the cut off");
+  }
+
+  //all triangles have lhs exactly -1-min_violation and none is returned
+  Sparsesym S1(m, h, I0, J0, Matrix(h, 1, -0.5));
+  {
+    TriangleSeparator sep;
+    sep.set_chunk_size(16);
+    sep.set_n_threads(3);
+    sep.separate(G0, &S1, m, 10, 0.5);
+    check(sep.get_n_triangles() == 0, "lhs equal to -1-min_violation is not violated");
+  }
+
+  cout << n_failed << " checks failed" << endl;
+  return n_failed;
+}